@@ -172,7 +172,7 @@ protected:
 	float										volume;					/**< Volume */
 
 #if WITH_EDITOR
-	COnAudioBankUpdated::DelegateType_t*		audioBankUpdatedHandle;	/**< Handle of delegate of updated audio bank */
+	CDelegateHandle								audioBankUpdatedHandle;	/**< Handle of delegate of updated audio bank */
 #endif // WITH_EDITOR
 
 private:
@@ -204,9 +204,9 @@ private:
 
 	bool										bMuted;						/**< Is audio source muted */
 	uint32										alHandle;					/**< OpenAL of sound source */
-	COnAudioDeviceMuted::DelegateType_t*		audioDeviceMutedHandle;		/**< Handle of delegate of muted device */
-	COnAudioBufferDestroyed::DelegateType_t*	audioBufferDestroyedHandle;	/**< Handle of delegate of destroyed audio buffer */
-	COnAudioBufferUpdated::DelegateType_t*		audioBufferUpdatedHandle;	/**< Handle of delegate of updated audio buffer */
+	CDelegateHandle								audioDeviceMutedHandle;		/**< Handle of delegate of muted device */
+	CDelegateHandle								audioBufferDestroyedHandle;	/**< Handle of delegate of destroyed audio buffer */
+	CDelegateHandle								audioBufferUpdatedHandle;	/**< Handle of delegate of updated audio buffer */
 };
 
 #endif // !AUDIOSOURCE_H
\ No newline at end of file
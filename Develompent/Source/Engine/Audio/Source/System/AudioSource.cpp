@@ -6,12 +6,6 @@ CAudioSource::CAudioSource()
 	: bMuted( false )
 	, alHandle( 0 )
 	, volume( 100.f )
-#if WITH_EDITOR
-	, audioBankUpdatedHandle( nullptr )
-#endif // WITH_EDITOR
-	, audioDeviceMutedHandle( nullptr )
-	, audioBufferDestroyedHandle( nullptr )
-	, audioBufferUpdatedHandle( nullptr )
 {
 	alGenSources( 1, &alHandle );
 
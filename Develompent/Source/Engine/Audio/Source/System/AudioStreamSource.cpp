@@ -402,7 +402,7 @@ void CAudioStreamSource::SetAudioBank( const TAssetHandle<CAudioBank>& InAudioBa
 		}
 		else
 		{
-			audioBankUpdatedHandle = nullptr;
+			audioBankUpdatedHandle.Reset();
 		}
 
 		// Subscribe to new event delegate
@@ -38,6 +38,7 @@ public:
 	 */
 	FORCEINLINE void AddElement( const TType& InElement )
 	{
+		CScopedMemoryTag		memoryTag( GetMemoryTag() );
 		data.push_back( InElement );
 	}
 
@@ -76,6 +77,7 @@ public:
 
 		if ( InArchive.IsLoading() )
 		{
+			CScopedMemoryTag		memoryTag( GetMemoryTag() );
 			data.resize( sizeData );
 		}
 		InArchive.SerializeCompressed( data.data(), sizeof( TType ) * sizeData, compressionFlags );
@@ -88,6 +90,7 @@ public:
 	 */
 	FORCEINLINE void Resize( uint32 InNewSize )
 	{
+		CScopedMemoryTag		memoryTag( GetMemoryTag() );
 		data.resize( InNewSize );
 	}
 
@@ -99,6 +102,7 @@ public:
 	 */
 	FORCEINLINE void SetElements( const TType* InData, uint32 InSize )
 	{
+		CScopedMemoryTag		memoryTag( GetMemoryTag() );
 		data.resize( InSize );
 		memcpy( data.data(), InData, sizeof( TType ) * InSize );
 	}
@@ -178,11 +182,22 @@ public:
 	 */
 	FORCEINLINE CBulkData<TType>& operator=( const std::vector<TType>& InOther )
 	{
+		CScopedMemoryTag		memoryTag( GetMemoryTag() );
 		data = InOther;
 		return *this;
 	}
 
 private:
+	/**
+	 * Get memory tag for allocations of bulk data
+	 * @return Return current memory tag of the thread (e.g. tag of loading asset), if it isn't set return MT_BulkData
+	 */
+	static FORCEINLINE EMemoryTag GetMemoryTag()
+	{
+		EMemoryTag		currentTag = appGetMemoryTag();
+		return currentTag != MT_Default ? currentTag : MT_BulkData;
+	}
+
 	ECompressionFlags				compressionFlags;		/**< Compression flags (see ECompressionFlags) */
 	std::vector< TType >			data;					/**< Array data */
 };
@@ -0,0 +1,222 @@
+/**
+ * @file
+ * @addtogroup Core Core
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef CHUNKEDCOMMANDBUFFER_H
+#define CHUNKEDCOMMANDBUFFER_H
+
+#include "Core.h"
+#include "Misc/Types.h"
+#include "System/ThreadingBase.h"
+
+/**
+ * @ingroup Core
+ * @brief Statistics of chunked command buffer
+ */
+struct SCommandBufferStats
+{
+	uint64		lastFrameBytes;				/**< Number of bytes written in the last frame */
+	uint64		peakFrameBytes;				/**< Max number of bytes written in one frame */
+	uint64		totalBytes;					/**< Number of bytes written since start */
+	uint64		peakOccupancy;				/**< Max number of written but not read bytes */
+	uint64		allocatedBytes;				/**< Number of bytes allocated for chunks */
+	uint32		numChunks;					/**< Number of allocated chunks */
+	uint32		numStalls;					/**< Number of writer stalls since start */
+	double		lastFrameStallSeconds;		/**< Time the writer was stalled in the last frame */
+	double		totalStallSeconds;			/**< Time the writer was stalled since start */
+};
+
+/**
+ * @ingroup Core
+ * @brief A command buffer for use with two threads: a reading thread and a writing thread
+ *
+ * Data is written to a list of chunks, when current chunk is full the writer links a new one from the pool,
+ * so the buffer grows during bursts instead of blocking the writer. The reader returns fully read chunks to the pool.
+ * Reader doesn't take any locks, writers are serialized by critical section.
+ * Writer is stalled only when all chunks is in use and the buffer reached its max size
+ */
+class CChunkedCommandBuffer
+{
+public:
+	/**
+	 * @brief Constructor
+	 *
+	 * @param InChunkSize	Size of one chunk
+	 * @param InMaxSize		Max size of all chunks, when it is reached the writer waits the reader
+	 * @param InAlignment	Alignment of each allocation unit (in bytes)
+	 */
+	CChunkedCommandBuffer( uint32 InChunkSize, uint32 InMaxSize, uint32 InAlignment = 1 );
+
+	/**
+	 * @brief Destructor
+	 */
+	~CChunkedCommandBuffer();
+
+	/**
+	 * @brief A reference to an allocated memory in the command buffer
+	 * Upon destruction of the context, the memory is committed as written
+	 */
+	class CAllocationContext
+	{
+	public:
+		/**
+		 * @brief Constructor
+		 * Allocates memory from the command buffer, allocation is never split between chunks
+		 *
+		 * @param InCommandBuffer	The command buffer to allocate from
+		 * @param InAllocationSize	The size of the allocation to make
+		 */
+		CAllocationContext( CChunkedCommandBuffer& InCommandBuffer, uint32 InAllocationSize );
+
+		/**
+		 * @brief Destructor
+		 * Commits the allocated memory
+		 */
+		~CAllocationContext();
+
+		/**
+		 * @brief Commits the allocated memory
+		 */
+		void Commit();
+
+		/**
+		 * @brief Get pointer to allocated memory
+		 * @return Return pointer to allocated memory
+		 */
+		FORCEINLINE void* GetAllocation() const
+		{
+			return allocationStart;
+		}
+
+		/**
+		 * @brief Get allocated size
+		 * @return Return allocated size
+		 */
+		FORCEINLINE uint32 GetAllocatedSize() const
+		{
+			return allocationSize;
+		}
+
+	private:
+		CChunkedCommandBuffer&		commandBuffer;		/**< Reference to command buffer */
+		byte*						allocationStart;	/**< Pointer to start allocation data */
+		uint32						allocationSize;		/**< Size of allocation */
+	};
+
+	/**
+	 * @brief Gets a pointer to a contiguous block of memory to read from the buffer
+	 *
+	 * @param OutReadPointer	Output pointer to the data
+	 * @param OutReadSize		Output size of the data
+	 * @return Return TRUE if there is any data to read, else returning FALSE
+	 */
+	bool BeginRead( void*& OutReadPointer, uint32& OutReadSize );
+
+	/**
+	 * @brief Frees the first InReadSize bytes available for reading via BeginRead to the writing thread
+	 * @param InReadSize	The number of bytes to free
+	 */
+	void FinishRead( uint32 InReadSize );
+
+	/**
+	 * @brief Waits for data to be available for reading
+	 * @param InWaitTime	Time in milliseconds to wait before returning
+	 */
+	void WaitForRead( uint32 InWaitTime = ( uint32 )-1 );
+
+	/**
+	 * @brief Mark end of the frame for statistics
+	 * @note Must be called once per frame from writing thread
+	 */
+	void EndFrame();
+
+	/**
+	 * @brief Get statistics
+	 * @return Return statistics of command buffer
+	 */
+	SCommandBufferStats GetStats() const;
+
+	/**
+	 * @brief Is read buffer empty
+	 * @return Return TRUE if all written data was read, else returning FALSE
+	 */
+	FORCEINLINE bool IsReadBufferEmpty() const
+	{
+		return readChunk->readOffset == ( uint32 )readChunk->writeOffset && !readChunk->next;
+	}
+
+private:
+	/**
+	 * @brief Chunk of command buffer
+	 */
+	struct SChunk
+	{
+		SChunk* volatile	next;			/**< Next chunk, after it is set the writer never writes to this chunk */
+		byte*				data;			/**< Data of chunk */
+		uint32				size;			/**< Size of chunk */
+		volatile int32		writeOffset;	/**< Offset of the next byte to be written */
+		uint32				readOffset;		/**< Offset of the next byte to be read */
+	};
+
+	/**
+	 * @brief Allocate new chunk
+	 *
+	 * @param InSize	Size of chunk
+	 * @return Return allocated chunk
+	 */
+	SChunk* AllocateChunk( uint32 InSize );
+
+	/**
+	 * @brief Free chunk
+	 * @param InChunk	Chunk
+	 */
+	void FreeChunk( SChunk* InChunk );
+
+	/**
+	 * @brief Link a new chunk after current write chunk
+	 * @note Must be called only by writer in critical section
+	 *
+	 * @param InMinSize		Min size of chunk
+	 */
+	void LinkChunk( uint32 InMinSize );
+
+	/**
+	 * @brief Take a chunk from the pool
+	 * @note Must be called only by writer in critical section
+	 *
+	 * @return Return chunk from the pool, if pool is empty returns NULL
+	 */
+	SChunk* PopFreeChunk();
+
+	/**
+	 * @brief Return fully read chunk to the pool
+	 * @note Must be called only by reader
+	 *
+	 * @param InChunk	Chunk
+	 */
+	void RecycleChunk( SChunk* InChunk );
+
+	uint32					chunkSize;					/**< Size of one chunk */
+	uint32					maxSize;					/**< Max size of all chunks */
+	uint32					alignment;					/**< Alignment of each allocation unit (in bytes) */
+	SChunk*					writeChunk;					/**< Chunk for writing, owned by writer */
+	SChunk*					readChunk;					/**< Chunk for reading, owned by reader */
+	SChunk*					freeChunks;					/**< Pool of chunks, owned by writer */
+	SChunk* volatile		recycledChunks;				/**< Chunks returned by reader, writer moves them to the pool */
+	bool					isWriting;					/**< TRUE if there is an CAllocationContext outstanding for this command buffer */
+	volatile int64			allocatedBytes;				/**< Number of bytes allocated for chunks */
+	volatile int32			numChunks;					/**< Number of allocated chunks */
+	volatile int64			readBytes;					/**< Number of bytes read since start */
+	uint64					writtenBytes;				/**< Number of bytes written since start */
+	uint64					frameBytes;					/**< Number of bytes written in the current frame */
+	double					frameStallSeconds;			/**< Time the writer was stalled in the current frame */
+	SCommandBufferStats		stats;						/**< Statistics */
+	CCriticalSection		criticalSection;			/**< Critical section for writers */
+	class CEvent*			dataWrittenEvent;			/**< The event used to signal the reader thread when the command buffer has data to read */
+};
+
+#endif // !CHUNKEDCOMMANDBUFFER_H
\ No newline at end of file
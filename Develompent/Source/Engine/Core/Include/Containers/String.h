@@ -39,6 +39,30 @@ public:
 	 */
 	static std::wstring			Format( const tchar* InFormat, va_list InArguments );
 
+	/**
+	 * @brief Getting a formatted string into caller-provided buffer
+	 * @note If the result does not fit in the buffer it will be truncated. The buffer is always null terminated
+	 *
+	 * @param[out] OutBuffer Destination buffer
+	 * @param[in] InBufferSize Size of destination buffer in characters
+	 * @param[in] InFormat Format of string
+	 * @param[in] ... Other arguments string
+	 * @return Return number of characters written (not including null terminating character)
+	 */
+	static int32				FormatBuffer( tchar* OutBuffer, uint32 InBufferSize, const tchar* InFormat, ... );
+
+	/**
+	 * @brief Getting a formatted string into caller-provided buffer
+	 * @note If the result does not fit in the buffer it will be truncated. The buffer is always null terminated
+	 *
+	 * @param[out] OutBuffer Destination buffer
+	 * @param[in] InBufferSize Size of destination buffer in characters
+	 * @param[in] InFormat Format of string
+	 * @param[in] InArguments Other arguments string
+	 * @return Return number of characters written (not including null terminating character)
+	 */
+	static int32				FormatBuffer( tchar* OutBuffer, uint32 InBufferSize, const tchar* InFormat, va_list InArguments );
+
 	/**
 	 * @brief Convert string to upper case
 	 * 
@@ -55,6 +55,11 @@
 	#define FRAME_CAPTURE_MARKERS	!SHIPPING_BUILD
 #endif // !FRAME_CAPTURE_MARKERS
 
+// Enable or disable tracking of memory allocations by tags. It is opt-in, because it adds interlocked operations to each allocation and free
+#ifndef TRACK_MEMORY
+	#define TRACK_MEMORY			0
+#endif // !TRACK_MEMORY
+
 // Is instancing allowed? 
 #ifndef USE_INSTANCING
 	#define USE_INSTANCING			1
@@ -50,6 +50,15 @@ enum ELifeEnginePackageVersion
 	VER_AssetName_V3						= 18,					/**< Moved asset name to CAsset */
 	VER_AssetOnlyEditor						= 19,					/**< Added field 'bOnlyEditor' to asset */
 	VER_CName								= 20,					/**< Added CName for IDs in string view */
+	VER_StableHashes						= 21,					/**< Changed appMemFastHash to word-at-a-time hash, saved hashes of vertex factories are converted on load */
+	VER_TextureMips							= 22,					/**< Added mip chain to CTexture2D */
+	VER_TextureCompression					= 23,					/**< Added compression settings to CTexture2D */
+	VER_TextureStreaming					= 24,					/**< Mips of CTexture2D are stored separately for streaming */
+	VER_StaticMeshVertexFormat				= 25,					/**< Added vertex format to CStaticMesh */
+	VER_StaticMeshIndex16					= 26,					/**< CStaticMesh stores 16-bit indeces if vertex count allows */
+	VER_StaticMeshLODs						= 27,					/**< Added LODs to CStaticMesh */
+	VER_StaticMeshOccluders					= 28,					/**< Added occluder flag to CStaticMesh */
+	VER_MaterialMasked						= 29,					/**< Added masked flag to CMaterial */
 
 	//
 	// New versions can be added here
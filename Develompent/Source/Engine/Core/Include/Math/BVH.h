@@ -0,0 +1,295 @@
+/**
+ * @file
+ * @addtogroup Core Core
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef BVH_H
+#define BVH_H
+
+#include <vector>
+#include <utility>
+#include <float.h>
+
+#include "Math/Math.h"
+#include "Math/Box.h"
+
+/**
+ * @ingroup Core
+ * @brief Max number of items in leaf of BVH
+ */
+#define BVH_MAX_LEAF_ITEMS		4
+
+/**
+ * @ingroup Core
+ * @brief Max depth of BVH, items are split by median, so depth is not more than log2 of number of items
+ */
+#define BVH_MAX_DEPTH			64
+
+/**
+ * @ingroup Core
+ * @brief Bounding volume hierarchy of items with axis aligned bound boxes
+ *
+ * Items are split by median of their centers along the longest axis, so tree is balanced. Nodes are stored
+ * in one array, children of node are placed next to each other and after their parent. When items move,
+ * tree is refitted without rebuild. Ray casts visit the nearest child first and skip nodes farther than closest hit
+ */
+class CBVH
+{
+public:
+	/**
+	 * @brief Build BVH
+	 * @note Invalid boxes are never hit by rays
+	 * 
+	 * @param InBoxes		Array of bound boxes of items, index of item is index in this array
+	 * @param InNumBoxes	Number of items
+	 */
+	void Build( const CBox* InBoxes, uint32 InNumBoxes );
+
+	/**
+	 * @brief Refit bound boxes of nodes after items have moved
+	 * @note Number of items must be the same as in Build
+	 * 
+	 * @param InBoxes		Array of new bound boxes of items
+	 */
+	void Refit( const CBox* InBoxes );
+
+	/**
+	 * @brief Clear BVH
+	 */
+	FORCEINLINE void Clear()
+	{
+		nodes.clear();
+		items.clear();
+	}
+
+	/**
+	 * @brief Is empty BVH
+	 * @return Return TRUE if BVH doesn't contain items
+	 */
+	FORCEINLINE bool IsEmpty() const
+	{
+		return nodes.empty();
+	}
+
+	/**
+	 * @brief Get number of nodes
+	 * @return Return number of nodes
+	 */
+	FORCEINLINE uint32 GetNumNodes() const
+	{
+		return nodes.size();
+	}
+
+	/**
+	 * @brief Get number of items
+	 * @return Return number of items
+	 */
+	FORCEINLINE uint32 GetNumItems() const
+	{
+		return items.size();
+	}
+
+	/**
+	 * @brief Cast ray through BVH
+	 * 
+	 * @param InOrigin			Origin of ray
+	 * @param InDirection		Direction of ray, it may be not normalized
+	 * @param InOutDistance		Max distance of ray in lengths of InDirection, on output the distance of the closest hit
+	 * @param InTestItemFunc	Function of exact test of item: bool( uint32 InItemIndex, float& InOutDistance ), returns TRUE and decreases distance if item is hit closer
+	 * @return Return TRUE if any item is hit
+	 */
+	template<typename TTestItemFunc>
+	bool RayCast( const Vector& InOrigin, const Vector& InDirection, float& InOutDistance, TTestItemFunc InTestItemFunc ) const
+	{
+		if ( nodes.empty() )
+		{
+			return false;
+		}
+
+		const Vector	invDirection( 1.f / InDirection.x, 1.f / InDirection.y, 1.f / InDirection.z );
+		uint32			stackNodes[ BVH_MAX_DEPTH * 2 ];
+		float			stackDistances[ BVH_MAX_DEPTH * 2 ];
+		uint32			stackSize = 0;
+		float			entryDistance = 0.f;
+		bool			bHit = false;
+		if ( !RayBoxIntersect( InOrigin, invDirection, nodes[ 0 ].boundMin, nodes[ 0 ].boundMax, InOutDistance, entryDistance ) )
+		{
+			return false;
+		}
+
+		stackNodes[ stackSize ]		= 0;
+		stackDistances[ stackSize ]	= entryDistance;
+		++stackSize;
+		while ( stackSize > 0 )
+		{
+			--stackSize;
+
+			// Closest hit may be found after node was pushed
+			if ( stackDistances[ stackSize ] > InOutDistance )
+			{
+				continue;
+			}
+
+			const SNode&	node = nodes[ stackNodes[ stackSize ] ];
+			if ( node.numItems > 0 )
+			{
+				for ( uint32 index = node.firstChildOrItem, count = node.firstChildOrItem + node.numItems; index < count; ++index )
+				{
+					bHit |= InTestItemFunc( items[ index ], InOutDistance );
+				}
+				continue;
+			}
+
+			// Push far child first, so near child is visited first
+			uint32			nearChild = node.firstChildOrItem;
+			uint32			farChild = node.firstChildOrItem + 1;
+			float			nearDistance = 0.f;
+			float			farDistance = 0.f;
+			bool			bNearHit = RayBoxIntersect( InOrigin, invDirection, nodes[ nearChild ].boundMin, nodes[ nearChild ].boundMax, InOutDistance, nearDistance );
+			bool			bFarHit = RayBoxIntersect( InOrigin, invDirection, nodes[ farChild ].boundMin, nodes[ farChild ].boundMax, InOutDistance, farDistance );
+			if ( bNearHit && bFarHit && farDistance < nearDistance )
+			{
+				std::swap( nearChild, farChild );
+				std::swap( nearDistance, farDistance );
+			}
+			else if ( !bNearHit )
+			{
+				std::swap( nearChild, farChild );
+				std::swap( nearDistance, farDistance );
+				std::swap( bNearHit, bFarHit );
+			}
+
+			if ( bFarHit )
+			{
+				stackNodes[ stackSize ]		= farChild;
+				stackDistances[ stackSize ]	= farDistance;
+				++stackSize;
+			}
+			if ( bNearHit )
+			{
+				stackNodes[ stackSize ]		= nearChild;
+				stackDistances[ stackSize ]	= nearDistance;
+				++stackSize;
+			}
+		}
+
+		return bHit;
+	}
+
+	/**
+	 * @brief Intersect ray with axis aligned box
+	 * 
+	 * @param InOrigin			Origin of ray
+	 * @param InInvDirection	Inverse direction of ray (1 / direction)
+	 * @param InBoxMin			Min of box
+	 * @param InBoxMax			Max of box
+	 * @param InMaxDistance		Max distance of ray
+	 * @param OutDistance		Output distance of entry into box, it is 0 if origin is inside of box
+	 * @return Return TRUE if ray hits box
+	 */
+	static FORCEINLINE bool RayBoxIntersect( const Vector& InOrigin, const Vector& InInvDirection, const Vector& InBoxMin, const Vector& InBoxMax, float InMaxDistance, float& OutDistance )
+	{
+		float		minDistance = 0.f;
+		float		maxDistance = InMaxDistance;
+		for ( uint32 axis = 0; axis < 3; ++axis )
+		{
+			float	distance0 = ( InBoxMin[ axis ] - InOrigin[ axis ] ) * InInvDirection[ axis ];
+			float	distance1 = ( InBoxMax[ axis ] - InOrigin[ axis ] ) * InInvDirection[ axis ];
+			if ( distance0 > distance1 )
+			{
+				std::swap( distance0, distance1 );
+			}
+
+			// Comparisons are written so NaN (origin on plane of parallel slab) doesn't reject box
+			minDistance = distance0 > minDistance ? distance0 : minDistance;
+			maxDistance = distance1 < maxDistance ? distance1 : maxDistance;
+			if ( minDistance > maxDistance )
+			{
+				return false;
+			}
+		}
+
+		OutDistance = minDistance;
+		return true;
+	}
+
+	/**
+	 * @brief Intersect ray with triangle
+	 * @note Both sides of triangle are hit
+	 * 
+	 * @param InOrigin			Origin of ray
+	 * @param InDirection		Direction of ray
+	 * @param InVertex0			First vertex of triangle
+	 * @param InVertex1			Second vertex of triangle
+	 * @param InVertex2			Third vertex of triangle
+	 * @param OutDistance		Output distance of hit in lengths of InDirection
+	 * @return Return TRUE if ray hits triangle
+	 */
+	static FORCEINLINE bool RayTriangleIntersect( const Vector& InOrigin, const Vector& InDirection, const Vector& InVertex0, const Vector& InVertex1, const Vector& InVertex2, float& OutDistance )
+	{
+		const Vector	edge1		= InVertex1 - InVertex0;
+		const Vector	edge2		= InVertex2 - InVertex0;
+		const Vector	p			= SMath::CrossVector( InDirection, edge2 );
+		const float		determinant	= SMath::DotVector( edge1, p );
+		if ( SMath::Abs( determinant ) < 1e-12f )
+		{
+			return false;
+		}
+
+		const float		invDeterminant	= 1.f / determinant;
+		const Vector	t				= InOrigin - InVertex0;
+		const float		u				= SMath::DotVector( t, p ) * invDeterminant;
+		if ( u < 0.f || u > 1.f )
+		{
+			return false;
+		}
+
+		const Vector	q				= SMath::CrossVector( t, edge1 );
+		const float		v				= SMath::DotVector( InDirection, q ) * invDeterminant;
+		if ( v < 0.f || u + v > 1.f )
+		{
+			return false;
+		}
+
+		OutDistance = SMath::DotVector( edge2, q ) * invDeterminant;
+		return OutDistance >= 0.f;
+	}
+
+private:
+	/**
+	 * @brief Node of BVH
+	 */
+	struct SNode
+	{
+		Vector		boundMin;				/**< Min of bound box */
+		uint32		firstChildOrItem;		/**< Index of first child for inner node, or offset of first item for leaf */
+		Vector		boundMax;				/**< Max of bound box */
+		uint32		numItems;				/**< Number of items in leaf, 0 for inner node */
+	};
+
+	/**
+	 * @brief Build node and its children
+	 * 
+	 * @param InNodeIndex	Index of node
+	 * @param InFirstItem	Offset of first item of node
+	 * @param InNumItems	Number of items of node
+	 * @param InDepth		Depth of node
+	 */
+	void BuildNode( uint32 InNodeIndex, uint32 InFirstItem, uint32 InNumItems, uint32 InDepth );
+
+	/**
+	 * @brief Calculate bound box of items of leaf
+	 * @param InOutNode		Leaf node
+	 */
+	void CalcLeafBounds( SNode& InOutNode ) const;
+
+	std::vector<SNode>		nodes;			/**< Nodes, the first is root */
+	std::vector<uint32>		items;			/**< Indices of items, leaves refer to ranges of this array */
+	std::vector<Vector>		boxMins;		/**< Min of bound boxes of items, invalid boxes are empty */
+	std::vector<Vector>		boxMaxs;		/**< Max of bound boxes of items, invalid boxes are empty */
+};
+
+#endif // !BVH_H
\ No newline at end of file
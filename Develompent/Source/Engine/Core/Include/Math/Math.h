@@ -13,6 +13,7 @@
 #include <gtx/quaternion.hpp>
 #include <gtc/type_ptr.hpp>
 #include <gtx/transform.hpp>
+#include <gtc/packing.hpp>
 
 #include "Math/Axis.h"
 #include "System/Archive.h"
@@ -469,6 +470,18 @@ struct SMath
 		return result;
 	}
 
+	/**
+	 * @brief Dot vector
+	 *
+	 * @param InVectorA		Vector A
+	 * @param InVectorB		Vector B
+	 * @return Return dot product of vectors
+	 */
+	static FORCEINLINE float DotVector( const Vector& InVectorA, const Vector& InVectorB )
+	{
+		return glm::dot( InVectorA, InVectorB );
+	}
+
 	/**
 	 * @brief Pow
 	 * 
@@ -533,6 +546,16 @@ struct SMath
 		return atanf( InA );
 	}
 
+	/**
+	 * @brief ACos
+	 * @param InA		Value whose arc cosine is computed, in the interval [-1,+1]
+	 * @return Principal arc cosine of InA, in the interval [0,pi] radians
+	 */
+	static FORCEINLINE float ACos( float InA )
+	{
+		return acosf( InA );
+	}
+
 	/**
 	 * @brief Sqrt
 	 * @param InA		Value whose square root is computed
@@ -589,6 +612,28 @@ struct SMath
 		return glm::distance( InVectorA, InVectorB );
 	}
 
+	/**
+	 * @brief Convert float to half precision float
+	 *
+	 * @param InValue	Value
+	 * @return Return bits of half precision float
+	 */
+	static FORCEINLINE uint16 FloatToHalf( float InValue )
+	{
+		return glm::packHalf1x16( InValue );
+	}
+
+	/**
+	 * @brief Convert half precision float to float
+	 *
+	 * @param InValue	Bits of half precision float
+	 * @return Return float value
+	 */
+	static FORCEINLINE float HalfToFloat( uint16 InValue )
+	{
+		return glm::unpackHalf1x16( InValue );
+	}
+
 	static const Vector				vectorZero;			/**< Zero 3D vector */
 	static const Vector				vectorOne;			/**< One 3D vector */
 	static const Quaternion			quaternionZero;		/**< Quaternion zero */
@@ -0,0 +1,363 @@
+/**
+ * @file
+ * @addtogroup Core Core
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef INLINEFUNCTION_H
+#define INLINEFUNCTION_H
+
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "Core.h"
+#include "Misc/Types.h"
+
+/**
+ * @ingroup Core
+ * @brief Default size in bytes of inline storage in TInlineFunction
+ * @note It is enough for std::bind of member function with 'this' and placeholders, and for lambdas with few captures
+ */
+#define INLINE_FUNCTION_DEFAULT_SIZE		48
+
+/**
+ * @ingroup Core
+ * @brief Alignment of inline storage in TInlineFunction
+ */
+#define INLINE_FUNCTION_ALIGNMENT			16
+
+/**
+ * @ingroup Core
+ * @brief Callable wrapper with small buffer of inline storage
+ *
+ * Works like std::function, but callables which fit in TInlineSize bytes are stored inside object without heap allocation.
+ * Bigger callables are allocated in the heap
+ */
+template< typename TSignature, uint32 TInlineSize = INLINE_FUNCTION_DEFAULT_SIZE >
+class TInlineFunction;
+
+/**
+ * @ingroup Core
+ * @brief Callable wrapper with small buffer of inline storage
+ */
+template< typename TReturnType, typename... TParamTypes, uint32 TInlineSize >
+class TInlineFunction< TReturnType( TParamTypes... ), TInlineSize >
+{
+public:
+	/**
+	 * @brief Constructor
+	 */
+	FORCEINLINE TInlineFunction()
+		: invokeFn( nullptr )
+		, manageFn( nullptr )
+	{}
+
+	/**
+	 * @brief Constructor
+	 */
+	FORCEINLINE TInlineFunction( std::nullptr_t )
+		: invokeFn( nullptr )
+		, manageFn( nullptr )
+	{}
+
+	/**
+	 * @brief Constructor
+	 * @param InFunctor		Callable object (function pointer, lambda, result of std::bind, etc)
+	 */
+	template< typename TFunctor, typename = typename std::enable_if< !std::is_same< typename std::decay< TFunctor >::type, TInlineFunction >::value >::type >
+	FORCEINLINE TInlineFunction( TFunctor&& InFunctor )
+		: invokeFn( nullptr )
+		, manageFn( nullptr )
+	{
+		Construct( std::forward< TFunctor >( InFunctor ) );
+	}
+
+	/**
+	 * @brief Copy constructor
+	 * @param InOther	Other function
+	 */
+	FORCEINLINE TInlineFunction( const TInlineFunction& InOther )
+		: invokeFn( nullptr )
+		, manageFn( nullptr )
+	{
+		CopyFrom( InOther );
+	}
+
+	/**
+	 * @brief Move constructor
+	 * @param InOther	Other function
+	 */
+	FORCEINLINE TInlineFunction( TInlineFunction&& InOther )
+		: invokeFn( nullptr )
+		, manageFn( nullptr )
+	{
+		MoveFrom( InOther );
+	}
+
+	/**
+	 * @brief Destructor
+	 */
+	FORCEINLINE ~TInlineFunction()
+	{
+		Reset();
+	}
+
+	/**
+	 * @brief Reset function
+	 */
+	FORCEINLINE void Reset()
+	{
+		if ( manageFn )
+		{
+			manageFn( MO_Destroy, storage, nullptr );
+		}
+
+		invokeFn	= nullptr;
+		manageFn	= nullptr;
+	}
+
+	/**
+	 * @brief Is bound callable
+	 * @return Return TRUE if callable is bound, otherwise returns FALSE
+	 */
+	FORCEINLINE bool IsBound() const
+	{
+		return invokeFn != nullptr;
+	}
+
+	/**
+	 * @brief Call function
+	 *
+	 * @param InParams	Params for call
+	 * @return Return result of call
+	 */
+	FORCEINLINE TReturnType operator()( TParamTypes... InParams ) const
+	{
+		check( invokeFn );
+		return invokeFn( storage, std::forward< TParamTypes >( InParams )... );
+	}
+
+	/**
+	 * @brief Is bound callable
+	 */
+	FORCEINLINE explicit operator bool() const
+	{
+		return IsBound();
+	}
+
+	/**
+	 * @brief Copy operator
+	 */
+	FORCEINLINE TInlineFunction& operator=( const TInlineFunction& InOther )
+	{
+		if ( this != &InOther )
+		{
+			Reset();
+			CopyFrom( InOther );
+		}
+		return *this;
+	}
+
+	/**
+	 * @brief Move operator
+	 */
+	FORCEINLINE TInlineFunction& operator=( TInlineFunction&& InOther )
+	{
+		if ( this != &InOther )
+		{
+			Reset();
+			MoveFrom( InOther );
+		}
+		return *this;
+	}
+
+	/**
+	 * @brief Reset operator
+	 */
+	FORCEINLINE TInlineFunction& operator=( std::nullptr_t )
+	{
+		Reset();
+		return *this;
+	}
+
+private:
+	/**
+	 * @brief Enumeration of operations with stored callable
+	 */
+	enum EManageOperation
+	{
+		MO_Copy,		/**< Copy callable from source storage to destination storage */
+		MO_Move,		/**< Move callable from source storage to destination storage and destroy source */
+		MO_Destroy		/**< Destroy callable in destination storage */
+	};
+
+	/**
+	 * @brief Typedef of pointer to function for invoke stored callable
+	 */
+	typedef TReturnType( *InvokeFn_t )( void* InStorage, TParamTypes&&... InParams );
+
+	/**
+	 * @brief Typedef of pointer to function for manage stored callable
+	 */
+	typedef void( *ManageFn_t )( EManageOperation InOperation, void* InDestStorage, void* InSrcStorage );
+
+	/**
+	 * @brief Is callable fit in inline storage
+	 */
+	template< typename TFunctor >
+	struct TIsInline
+	{
+		static const bool value = sizeof( TFunctor ) <= TInlineSize && alignof( TFunctor ) <= INLINE_FUNCTION_ALIGNMENT && std::is_nothrow_move_constructible< TFunctor >::value;
+	};
+
+	/**
+	 * @brief Operations for callable in inline storage
+	 */
+	template< typename TFunctor >
+	struct TInlineOps
+	{
+		static TReturnType Invoke( void* InStorage, TParamTypes&&... InParams )
+		{
+			if constexpr ( std::is_void< TReturnType >::value )
+			{
+				std::invoke( *( TFunctor* )InStorage, std::forward< TParamTypes >( InParams )... );
+			}
+			else
+			{
+				return std::invoke( *( TFunctor* )InStorage, std::forward< TParamTypes >( InParams )... );
+			}
+		}
+
+		static void Manage( EManageOperation InOperation, void* InDestStorage, void* InSrcStorage )
+		{
+			switch ( InOperation )
+			{
+			case MO_Copy:
+				new( InDestStorage ) TFunctor( *( const TFunctor* )InSrcStorage );
+				break;
+
+			case MO_Move:
+				new( InDestStorage ) TFunctor( std::move( *( TFunctor* )InSrcStorage ) );
+				( ( TFunctor* )InSrcStorage )->~TFunctor();
+				break;
+
+			case MO_Destroy:
+				( ( TFunctor* )InDestStorage )->~TFunctor();
+				break;
+			}
+		}
+	};
+
+	/**
+	 * @brief Operations for callable in the heap, inline storage keeps only pointer to it
+	 */
+	template< typename TFunctor >
+	struct THeapOps
+	{
+		static TReturnType Invoke( void* InStorage, TParamTypes&&... InParams )
+		{
+			if constexpr ( std::is_void< TReturnType >::value )
+			{
+				std::invoke( **( TFunctor** )InStorage, std::forward< TParamTypes >( InParams )... );
+			}
+			else
+			{
+				return std::invoke( **( TFunctor** )InStorage, std::forward< TParamTypes >( InParams )... );
+			}
+		}
+
+		static void Manage( EManageOperation InOperation, void* InDestStorage, void* InSrcStorage )
+		{
+			switch ( InOperation )
+			{
+			case MO_Copy:
+				*( TFunctor** )InDestStorage = new TFunctor( **( const TFunctor** )InSrcStorage );
+				break;
+
+			case MO_Move:
+				*( TFunctor** )InDestStorage = *( TFunctor** )InSrcStorage;
+				*( TFunctor** )InSrcStorage = nullptr;
+				break;
+
+			case MO_Destroy:
+				delete *( TFunctor** )InDestStorage;
+				break;
+			}
+		}
+	};
+
+	/**
+	 * @brief Construct callable in storage
+	 * @param InFunctor		Callable object
+	 */
+	template< typename TFunctor >
+	FORCEINLINE void Construct( TFunctor&& InFunctor )
+	{
+		typedef typename std::decay< TFunctor >::type		Functor_t;
+		static_assert( sizeof( Functor_t* ) <= TInlineSize, "Inline storage must fit at least pointer" );
+
+		// Null function pointer is same as empty function
+		if constexpr ( std::is_pointer< Functor_t >::value || std::is_member_pointer< Functor_t >::value )
+		{
+			if ( !InFunctor )
+			{
+				return;
+			}
+		}
+
+		if constexpr ( TIsInline< Functor_t >::value )
+		{
+			new( storage ) Functor_t( std::forward< TFunctor >( InFunctor ) );
+			invokeFn	= &TInlineOps< Functor_t >::Invoke;
+			manageFn	= &TInlineOps< Functor_t >::Manage;
+		}
+		else
+		{
+			*( Functor_t** )storage = new Functor_t( std::forward< TFunctor >( InFunctor ) );
+			invokeFn	= &THeapOps< Functor_t >::Invoke;
+			manageFn	= &THeapOps< Functor_t >::Manage;
+		}
+	}
+
+	/**
+	 * @brief Copy callable from other function
+	 * @param InOther	Other function
+	 */
+	FORCEINLINE void CopyFrom( const TInlineFunction& InOther )
+	{
+		if ( InOther.manageFn )
+		{
+			InOther.manageFn( MO_Copy, storage, InOther.storage );
+		}
+
+		invokeFn	= InOther.invokeFn;
+		manageFn	= InOther.manageFn;
+	}
+
+	/**
+	 * @brief Move callable from other function
+	 * @param InOther	Other function
+	 */
+	FORCEINLINE void MoveFrom( TInlineFunction& InOther )
+	{
+		if ( InOther.manageFn )
+		{
+			InOther.manageFn( MO_Move, storage, InOther.storage );
+		}
+
+		invokeFn			= InOther.invokeFn;
+		manageFn			= InOther.manageFn;
+		InOther.invokeFn	= nullptr;
+		InOther.manageFn	= nullptr;
+	}
+
+	alignas( INLINE_FUNCTION_ALIGNMENT ) mutable byte	storage[ TInlineSize ];		/**< Inline storage of callable */
+	InvokeFn_t											invokeFn;					/**< Pointer to function for invoke callable */
+	ManageFn_t											manageFn;					/**< Pointer to function for manage callable */
+};
+
+#endif // !INLINEFUNCTION_H
\ No newline at end of file
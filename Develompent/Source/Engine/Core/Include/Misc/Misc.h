@@ -131,6 +131,7 @@ std::wstring appUserName();
 /**
  * @ingroup Core
  * Calculate hash from name
+ * @note String is hashed in UTF-16, so result isn't depend from size of wchar_t on the platform
  *
  * @param[in] InName Name
  * @param[in] InHash Start hash
@@ -138,7 +139,44 @@ std::wstring appUserName();
  */
 FORCEINLINE uint64 appCalcHash( const std::wstring& InName, uint64 InHash = 0 )
 {
-	return appMemFastHash( InName.data(), ( uint64 )InName.size() * sizeof( std::wstring::value_type ), InHash );		// TODO BG yehor.pohuliaka - Need change to one format without dependency from platform
+	if constexpr ( sizeof( std::wstring::value_type ) == sizeof( char16_t ) )
+	{
+		return appMemFastHash( InName.data(), ( uint64 )InName.size() * sizeof( char16_t ), InHash );
+	}
+	else
+	{
+		std::u16string		utf16Name;
+		utf16Name.reserve( InName.size() );
+		for ( uint32 index = 0, count = ( uint32 )InName.size(); index < count; ++index )
+		{
+			uint32		codePoint = ( uint32 )InName[ index ];
+			if ( codePoint >= 0x10000 )
+			{
+				codePoint -= 0x10000;
+				utf16Name.push_back( ( char16_t )( 0xD800 + ( codePoint >> 10 ) ) );
+				utf16Name.push_back( ( char16_t )( 0xDC00 + ( codePoint & 0x3FF ) ) );
+			}
+			else
+			{
+				utf16Name.push_back( ( char16_t )codePoint );
+			}
+		}
+		return appMemFastHash( utf16Name.data(), ( uint64 )utf16Name.size() * sizeof( char16_t ), InHash );
+	}
+}
+
+/**
+ * @ingroup Core
+ * Calculate hash from name by legacy hashing function
+ * @warning It is only for convert hashes saved in old packages (before VER_StableHashes), don't use it for new code
+ *
+ * @param[in] InName Name
+ * @param[in] InHash Start hash
+ * @return Return hash
+ */
+FORCEINLINE uint64 appCalcHashLegacy( const std::wstring& InName, uint64 InHash = 0 )
+{
+	return appMemFastHashLegacy( InName.data(), ( uint64 )InName.size() * sizeof( std::wstring::value_type ), InHash );
 }
 
 /**
@@ -0,0 +1,89 @@
+/**
+ * @file
+ * @addtogroup Core Core
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef RADIXSORT_H
+#define RADIXSORT_H
+
+#include <utility>
+
+#include "Misc/Types.h"
+#include "System/MemoryBase.h"
+#include "Core.h"
+
+/**
+ * @ingroup Core
+ * @brief Stable LSD radix sort of elements by 64 bit key
+ *
+ * Sorts by 8 bit digits, histograms of all digits are calculated in one pass over the array.
+ * Passes where all keys have the same digit are skipped, so keys with few significant bits are sorted quickly
+ *
+ * @param InOutArray	Array of elements to sort
+ * @param InTempArray	Temporary array with size not less than InCount
+ * @param InCount		Number of elements
+ * @param InKeyFunc		Function returning 64 bit key of element
+ */
+template< typename TType, typename TKeyFunc >
+void appRadixSort64( TType* InOutArray, TType* InTempArray, uint32 InCount, TKeyFunc InKeyFunc )
+{
+	if ( InCount <= 1 )
+	{
+		return;
+	}
+
+	// Calculate histograms of all digits
+	uint32		histograms[ 8 ][ 256 ];
+	appMemzero( histograms, sizeof( histograms ) );
+	for ( uint32 index = 0; index < InCount; ++index )
+	{
+		uint64		key = InKeyFunc( InOutArray[ index ] );
+		for ( uint32 digit = 0; digit < 8; ++digit )
+		{
+			++histograms[ digit ][ ( key >> ( digit * 8 ) ) & 0xFF ];
+		}
+	}
+
+	TType*		src = InOutArray;
+	TType*		dest = InTempArray;
+	for ( uint32 digit = 0; digit < 8; ++digit )
+	{
+		uint32*		histogram = histograms[ digit ];
+		uint32		shift = digit * 8;
+
+		// If all keys have the same digit this pass doesn't change order
+		if ( histogram[ ( InKeyFunc( src[ 0 ] ) >> shift ) & 0xFF ] == InCount )
+		{
+			continue;
+		}
+
+		// Convert histogram to offsets
+		uint32		offset = 0;
+		for ( uint32 bucket = 0; bucket < 256; ++bucket )
+		{
+			uint32		count = histogram[ bucket ];
+			histogram[ bucket ] = offset;
+			offset += count;
+		}
+
+		for ( uint32 index = 0; index < InCount; ++index )
+		{
+			dest[ histogram[ ( InKeyFunc( src[ index ] ) >> shift ) & 0xFF ]++ ] = std::move( src[ index ] );
+		}
+		std::swap( src, dest );
+	}
+
+	// If result is in temporary array, move it back
+	if ( src != InOutArray )
+	{
+		for ( uint32 index = 0; index < InCount; ++index )
+		{
+			InOutArray[ index ] = std::move( src[ index ] );
+		}
+	}
+}
+
+#endif // !RADIXSORT_H
\ No newline at end of file
@@ -9,16 +9,88 @@
 #ifndef DELEGATE_H
 #define DELEGATE_H
 
-#include <functional>
-#include <list>
+#include <vector>
 
 #include "Core.h"
 #include "Misc/Object.h"
+#include "Misc/InlineFunction.h"
 #include "ThreadingBase.h"
 
+/**
+ * @ingroup Core
+ * Handle of delegate in multicast delegate, it is used for remove delegate
+ */
+class CDelegateHandle
+{
+public:
+	/**
+	 * Constructor
+	 */
+	FORCEINLINE CDelegateHandle()
+		: id( 0 )
+	{}
+
+	/**
+	 * Is valid handle
+	 * @return Return TRUE if handle is valid, otherwise returns FALSE
+	 */
+	FORCEINLINE bool IsValid() const
+	{
+		return id != 0;
+	}
+
+	/**
+	 * Reset handle
+	 */
+	FORCEINLINE void Reset()
+	{
+		id = 0;
+	}
+
+	/**
+	 * Operator ==
+	 */
+	FORCEINLINE bool operator==( const CDelegateHandle& InOther ) const
+	{
+		return id == InOther.id;
+	}
+
+	/**
+	 * Operator !=
+	 */
+	FORCEINLINE bool operator!=( const CDelegateHandle& InOther ) const
+	{
+		return id != InOther.id;
+	}
+
+private:
+	template< typename... TParamTypes >
+	friend class TMulticastDelegate;
+
+	/**
+	 * Constructor
+	 * @param InId	ID of delegate
+	 */
+	FORCEINLINE explicit CDelegateHandle( uint64 InId )
+		: id( InId )
+	{}
+
+	/**
+	 * Generate new unique ID for delegate
+	 * @return Return new unique ID
+	 */
+	static uint64 GenerateNewId();
+
+	uint64		id;		/**< Unique ID of delegate */
+};
+
 /**
  * @ingroup Core
  * Multicast delegate
+ * 
+ * Delegates are stored in contiguous array with inline storage of callables, so Add in most cases
+ * doesn't allocate memory and Broadcast doesn't walk linked list.
+ * It is allowed to Add and Remove delegates while broadcasting, added delegates will be called from the next Broadcast
  */
 template< typename... TParamTypes >
 class TMulticastDelegate
@@ -27,40 +99,112 @@ public:
 	/**
 	 * Typedef of delegate type
 	 */
-	typedef std::function<void( TParamTypes... )>		DelegateType_t;
+	typedef TInlineFunction<void( TParamTypes... )>		DelegateType_t;
+
+	/**
+	 * Constructor
+	 */
+	FORCEINLINE TMulticastDelegate()
+		: broadcastDepth( 0 )
+		, bNeedCompact( false )
+	{}
 
 	/**
 	 * Add delegate
+	 * 
 	 * @param InDelegate	Delegate
+	 * @return Return handle of delegate for remove it
 	 */
-	FORCEINLINE DelegateType_t* Add( const DelegateType_t& InDelegate )
+	FORCEINLINE CDelegateHandle Add( const DelegateType_t& InDelegate )
 	{
-		CScopeLock		scopeLock( criticalSection );
-		delegates.push_back( InDelegate );
-		return &delegates.back();
+		CScopeLock			scopeLock( criticalSection );
+		CDelegateHandle		handle( CDelegateHandle::GenerateNewId() );
+		
+		// While broadcasting we can't change array of delegates, so we add it after broadcast
+		if ( broadcastDepth > 0 )
+		{
+			pendingDelegates.push_back( SDelegateEntry( handle.id, InDelegate ) );
+		}
+		else
+		{
+			delegates.push_back( SDelegateEntry( handle.id, InDelegate ) );
+		}
+		return handle;
 	}
 
 	/**
 	 * Remove delegate
-	 * @param InDelegate		Delegate
+	 * @param InHandle		Handle of delegate. After remove it will be reset
 	 */
-	FORCEINLINE void Remove( DelegateType_t*& InDelegate )
+	FORCEINLINE void Remove( CDelegateHandle& InHandle )
 	{
-		if ( !InDelegate )
+		if ( !InHandle.IsValid() )
 		{
 			return;
 		}
 
 		CScopeLock		scopeLock( criticalSection );
-		for ( auto itDelegate = delegates.begin(), itDelegateEnd = delegates.end(); itDelegate != itDelegateEnd; ++itDelegate )
+		for ( uint32 index = 0, count = delegates.size(); index < count; ++index )
 		{
-			if ( &( *itDelegate ) == InDelegate )
+			SDelegateEntry&		entry = delegates[ index ];
+			if ( entry.id == InHandle.id )
 			{
-				delegates.erase( itDelegate );
-				InDelegate = nullptr;
+				// While broadcasting we only mark delegate as removed, because it may be executing now
+				if ( broadcastDepth > 0 )
+				{
+					entry.id		= 0;
+					bNeedCompact	= true;
+				}
+				else
+				{
+					delegates.erase( delegates.begin() + index );
+				}
+
+				InHandle.Reset();
 				return;
 			}
 		}
+
+		for ( uint32 index = 0, count = pendingDelegates.size(); index < count; ++index )
+		{
+			if ( pendingDelegates[ index ].id == InHandle.id )
+			{
+				pendingDelegates.erase( pendingDelegates.begin() + index );
+				InHandle.Reset();
+				return;
+			}
+		}
+	}
+
+	/**
+	 * Remove all delegates
+	 */
+	FORCEINLINE void RemoveAll()
+	{
+		CScopeLock		scopeLock( criticalSection );
+		pendingDelegates.clear();
+		if ( broadcastDepth > 0 )
+		{
+			for ( uint32 index = 0, count = delegates.size(); index < count; ++index )
+			{
+				delegates[ index ].id = 0;
+			}
+			bNeedCompact = true;
+		}
+		else
+		{
+			delegates.clear();
+		}
+	}
+
+	/**
+	 * Is bound any delegate
+	 * @return Return TRUE if bound at least one delegate, otherwise returns FALSE
+	 */
+	FORCEINLINE bool IsBound() const
+	{
+		CScopeLock		scopeLock( criticalSection );
+		return !delegates.empty() || !pendingDelegates.empty();
 	}
 
 	/**
@@ -70,16 +214,82 @@ public:
 	FORCEINLINE void Broadcast( TParamTypes... InParams ) const
 	{
 		// Call delegates
-		CScopeLock		scopeLock( criticalSection );	
-		for ( auto itDelegate = delegates.begin(), itDelegateEnd = delegates.end(); itDelegate != itDelegateEnd; ++itDelegate )
+		CScopeLock		scopeLock( criticalSection );
+		++broadcastDepth;
+		for ( uint32 index = 0, count = delegates.size(); index < count; ++index )
+		{
+			const SDelegateEntry&		entry = delegates[ index ];
+			if ( entry.id != 0 )
+			{
+				entry.function( InParams... );
+			}
+		}
+		--broadcastDepth;
+
+		// Apply changes which were made while broadcasting
+		if ( broadcastDepth == 0 && ( bNeedCompact || !pendingDelegates.empty() ) )
 		{
-			( *itDelegate )( InParams... );
+			FlushPendingChanges();
 		}
 	}
 
 private:
-	std::list< DelegateType_t >		delegates;				/**< List of delegates */
-	mutable CCriticalSection		criticalSection;		/**< Critical section for thread safe broadcast */
+	/**
+	 * Entry of delegate
+	 */
+	struct SDelegateEntry
+	{
+		/**
+		 * Constructor
+		 * 
+		 * @param InId			ID of delegate
+		 * @param InFunction	Delegate
+		 */
+		FORCEINLINE SDelegateEntry( uint64 InId, const DelegateType_t& InFunction )
+			: id( InId )
+			, function( InFunction )
+		{}
+
+		uint64				id;				/**< ID of delegate, if zero delegate is removed */
+		DelegateType_t		function;		/**< Delegate */
+	};
+
+	/**
+	 * Remove delegates marked as removed and add pending delegates
+	 */
+	void FlushPendingChanges() const
+	{
+		if ( bNeedCompact )
+		{
+			uint32		numAlive = 0;
+			for ( uint32 index = 0, count = delegates.size(); index < count; ++index )
+			{
+				if ( delegates[ index ].id != 0 )
+				{
+					if ( numAlive != index )
+					{
+						delegates[ numAlive ] = std::move( delegates[ index ] );
+					}
+					++numAlive;
+				}
+			}
+
+			delegates.erase( delegates.begin() + numAlive, delegates.end() );
+			bNeedCompact = false;
+		}
+
+		for ( uint32 index = 0, count = pendingDelegates.size(); index < count; ++index )
+		{
+			delegates.push_back( std::move( pendingDelegates[ index ] ) );
+		}
+		pendingDelegates.clear();
+	}
+
+	mutable std::vector< SDelegateEntry >		delegates;				/**< Array of delegates */
+	mutable std::vector< SDelegateEntry >		pendingDelegates;		/**< Array of delegates added while broadcasting */
+	mutable uint32								broadcastDepth;			/**< Depth of recursive broadcasts */
+	mutable bool								bNeedCompact;			/**< Is need remove delegates marked as removed */
+	mutable CCriticalSection					criticalSection;		/**< Critical section for thread safe broadcast */
 };
 
 /**
@@ -93,7 +303,7 @@ public:
 	/**
 	 * Typedef of delegate type
 	 */
-	typedef std::function<void( TParamTypes... )>		DelegateType_t;
+	typedef TInlineFunction<void( TParamTypes... )>		DelegateType_t;
 	
 	/**
 	 * Bind delegate
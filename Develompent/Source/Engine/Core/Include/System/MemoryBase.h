@@ -9,8 +9,17 @@
 #ifndef MEMORYBASE_H
 #define MEMORYBASE_H
 
+#include <string.h>
+
+#include "../LEBuild.h"
 #include "../CoreDefines.h"
 
+/**
+ * @ingroup Core
+ * @brief Default alignment of memory allocated by appMalloc
+ */
+#define MEMORY_DEFAULT_ALIGNMENT		16
+
 #ifndef DEFINED_appMemzero
 	/**
 	 * @ingroup Core
@@ -22,10 +31,140 @@
 	#define appMemzero( InDest, InCount )		memset( InDest, 0, InCount )
 #endif
 
+/**
+ * @ingroup Core
+ * @brief Prime numbers of memory hashing function (see appMemFastHash)
+ */
+#define MEMORY_HASH_PRIME1		0x9E3779B185EBCA87ULL
+#define MEMORY_HASH_PRIME2		0xC2B2AE3D27D4EB4FULL
+#define MEMORY_HASH_PRIME3		0x165667B19E3779F9ULL
+#define MEMORY_HASH_PRIME4		0x85EBCA77C2B2AE63ULL
+#define MEMORY_HASH_PRIME5		0x27D4EB2F165667C5ULL
+
+/**
+ * @ingroup Core
+ * @brief Size of block which processed by one step in long input path of appMemFastHash
+ */
+#define MEMORY_HASH_BLOCK_SIZE	32
+
+/**
+ * @ingroup Core
+ * @brief Rotate left 64 bit value
+ *
+ * @param InValue	Value
+ * @param InShift	Number of bits to rotate
+ * @return Return rotated value
+ */
+FORCEINLINE uint64 appRotateLeft64( uint64 InValue, uint32 InShift )
+{
+	return ( InValue << InShift ) | ( InValue >> ( 64 - InShift ) );
+}
+
+/**
+ * @ingroup Core
+ * @brief Read unaligned 64 bit value from memory
+ * @note All supported platforms are little-endian, so hashes are same on all of them
+ *
+ * @param InData	Pointer to data
+ * @return Return read value
+ */
+FORCEINLINE uint64 appMemRead64( const byte* InData )
+{
+	uint64		value;
+	memcpy( &value, InData, sizeof( uint64 ) );
+	return value;
+}
+
+/**
+ * @ingroup Core
+ * @brief Read unaligned 32 bit value from memory
+ * @note All supported platforms are little-endian, so hashes are same on all of them
+ *
+ * @param InData	Pointer to data
+ * @return Return read value
+ */
+FORCEINLINE uint32 appMemRead32( const byte* InData )
+{
+	uint32		value;
+	memcpy( &value, InData, sizeof( uint32 ) );
+	return value;
+}
+
+/**
+ * @ingroup Core
+ * @brief Mix one 64 bit word to accumulator of memory hashing function
+ *
+ * @param InAccumulator		Accumulator
+ * @param InInput			Input word
+ * @return Return new value of accumulator
+ */
+FORCEINLINE uint64 appMemHashRound( uint64 InAccumulator, uint64 InInput )
+{
+	InAccumulator += InInput * MEMORY_HASH_PRIME2;
+	InAccumulator = appRotateLeft64( InAccumulator, 31 );
+	return InAccumulator * MEMORY_HASH_PRIME1;
+}
+
+/**
+ * @ingroup Core
+ * @brief Process tail of data (less than MEMORY_HASH_BLOCK_SIZE bytes) and finalize hash
+ *
+ * @param InHash		Current hash
+ * @param InData		Pointer to tail of data
+ * @param InLength		Length of tail
+ * @return Return final hash
+ */
+FORCEINLINE uint64 appMemHashFinalize( uint64 InHash, const byte* InData, uint64 InLength )
+{
+	for ( ; InLength >= 8; InData += 8, InLength -= 8 )
+	{
+		InHash ^= appMemHashRound( 0, appMemRead64( InData ) );
+		InHash = appRotateLeft64( InHash, 27 ) * MEMORY_HASH_PRIME1 + MEMORY_HASH_PRIME4;
+	}
+
+	if ( InLength >= 4 )
+	{
+		InHash ^= ( uint64 )appMemRead32( InData ) * MEMORY_HASH_PRIME1;
+		InHash = appRotateLeft64( InHash, 23 ) * MEMORY_HASH_PRIME2 + MEMORY_HASH_PRIME3;
+		InData += 4;
+		InLength -= 4;
+	}
+
+	for ( ; InLength > 0; ++InData, --InLength )
+	{
+		InHash ^= *InData * MEMORY_HASH_PRIME5;
+		InHash = appRotateLeft64( InHash, 11 ) * MEMORY_HASH_PRIME1;
+	}
+
+	// Avalanche
+	InHash ^= InHash >> 33;
+	InHash *= MEMORY_HASH_PRIME2;
+	InHash ^= InHash >> 29;
+	InHash *= MEMORY_HASH_PRIME3;
+	InHash ^= InHash >> 32;
+	return InHash;
+}
+
+/**
+ * @ingroup Core
+ * @brief Long input path of appMemFastHash, processes data by blocks of MEMORY_HASH_BLOCK_SIZE bytes
+ * @warning Don't call it directly, use appMemFastHash
+ *
+ * @param[in] InData Pointer to data for which is considered hash
+ * @param[in] InLength Length of data, must be not less than MEMORY_HASH_BLOCK_SIZE
+ * @param[in] InHash Start hash
+ * @return Return calculated hash
+ */
+uint64 appMemFastHashLong( const void* InData, uint64 InLength, uint64 InHash );
+
 /**
  * @ingroup Core
  * @brief Fast memory hashing function that doesn't require a table lookup for each element
  *
+ * It is 64 bit non-cryptographic hash (XXH64 algorithm) which processes 32 bytes per step in four independent lanes,
+ * so the compiler is able to keep them in vector registers. Result is same on all supported platforms and
+ * is allowed to be saved into packages
+ *
  * @param[in] InData Pointer to data for which is considered hash
  * @param[in] InLength Length of data
  * @param[in] InHash Start hash
@@ -33,13 +172,13 @@
  */
 FORCEINLINE uint64 appMemFastHash( const void* InData, uint64 InLength, uint64 InHash = 0 )
 {
-	byte*		data = ( byte* )InData;
-	for ( uint64 index = 0; index < InLength; ++index )
+	if ( InLength >= MEMORY_HASH_BLOCK_SIZE )
 	{
-		InHash = data[ index ] + ( InHash << 6 ) + ( InHash << 16 ) - InHash;
+		return appMemFastHashLong( InData, InLength, InHash );
 	}
 
-	return InHash;
+	// Short input path, most of hashed keys (pointers, IDs, small structs) is going here
+	return appMemHashFinalize( InHash + MEMORY_HASH_PRIME5 + InLength, ( const byte* )InData, InLength );
 }
 
 /**
@@ -56,4 +195,185 @@ FORCEINLINE uint64 appMemFastHash( const TType& InValue, uint64 InHash = 0 )
 	return appMemFastHash( &InValue, sizeof( InValue ), InHash);
 }
 
+/**
+ * @ingroup Core
+ * @brief Legacy byte-at-a-time memory hashing function
+ * @warning It is only for convert hashes saved in old packages (before VER_StableHashes), don't use it for new code
+ *
+ * @param[in] InData Pointer to data for which is considered hash
+ * @param[in] InLength Length of data
+ * @param[in] InHash Start hash
+ * @return Return calculated hash
+ */
+FORCEINLINE uint64 appMemFastHashLegacy( const void* InData, uint64 InLength, uint64 InHash = 0 )
+{
+	byte*		data = ( byte* )InData;
+	for ( uint64 index = 0; index < InLength; ++index )
+	{
+		InHash = data[ index ] + ( InHash << 6 ) + ( InHash << 16 ) - InHash;
+	}
+
+	return InHash;
+}
+
+/**
+ * @ingroup Core
+ * @brief Enumeration of memory tags
+ * 
+ * Every allocation through appMalloc (and global operator new) is marked by memory tag,
+ * this is allow to see how much memory is used by each subsystem (see 'memreport' console command)
+ */
+enum EMemoryTag
+{
+	MT_Default,				/**< Untagged memory */
+	MT_Names,				/**< Global name table */
+	MT_Texture2D,			/**< Texture 2D assets */
+	MT_Material,			/**< Material assets */
+	MT_Script,				/**< Script assets */
+	MT_StaticMesh,			/**< Static mesh assets */
+	MT_AudioBank,			/**< Audio bank assets */
+	MT_PhysicsMaterial,		/**< Physics material assets */
+	MT_BulkData,			/**< Bulk data not owned by assets */
+	MT_RenderCommands,		/**< Rendering command queue */
+	MT_Count				/**< Count memory tags */
+};
+
+/**
+ * @ingroup Core
+ * @brief Memory statistics of one tag
+ */
+struct SMemoryTagStats
+{
+	int64		currentBytes;			/**< Currently allocated bytes */
+	int64		peakBytes;				/**< High-water mark of allocated bytes */
+	int64		numAllocations;			/**< Number of live allocations */
+	int64		totalAllocations;		/**< Total number of allocations since start */
+};
+
+/**
+ * @ingroup Core
+ * @brief Allocate memory
+ * 
+ * @param InSize		Size of memory in bytes
+ * @param InTag			Memory tag
+ * @param InAlignment	Alignment of memory, must be power of two
+ * @return Return pointer to allocated memory, if failed returns NULL
+ */
+void* appMalloc( uint64 InSize, EMemoryTag InTag, uint32 InAlignment = MEMORY_DEFAULT_ALIGNMENT );
+
+/**
+ * @ingroup Core
+ * @brief Allocate memory with current memory tag of the thread (see CScopedMemoryTag)
+ *
+ * @param InSize		Size of memory in bytes
+ * @param InAlignment	Alignment of memory, must be power of two
+ * @return Return pointer to allocated memory, if failed returns NULL
+ */
+void* appMalloc( uint64 InSize, uint32 InAlignment = MEMORY_DEFAULT_ALIGNMENT );
+
+/**
+ * @ingroup Core
+ * @brief Reallocate memory
+ * @note Memory tag of the original allocation is kept
+ * 
+ * @param InPtr			Pointer to memory allocated by appMalloc, may be NULL
+ * @param InNewSize		New size of memory in bytes
+ * @param InAlignment	Alignment of memory, must be power of two
+ * @return Return pointer to reallocated memory, if failed returns NULL and original memory isn't freed
+ */
+void* appRealloc( void* InPtr, uint64 InNewSize, uint32 InAlignment = MEMORY_DEFAULT_ALIGNMENT );
+
+/**
+ * @ingroup Core
+ * @brief Free memory allocated by appMalloc
+ * 
+ * @param InPtr		Pointer to memory, may be NULL
+ */
+void appFree( void* InPtr );
+
+/**
+ * @ingroup Core
+ * @brief Get size of memory allocated by appMalloc
+ *
+ * @param InPtr		Pointer to memory
+ * @return Return size of memory in bytes which was requested on allocate
+ */
+uint64 appGetAllocationSize( void* InPtr );
+
+/**
+ * @ingroup Core
+ * @brief Get current memory tag of the thread
+ * @return Return current memory tag of the thread
+ */
+EMemoryTag appGetMemoryTag();
+
+/**
+ * @ingroup Core
+ * @brief Set current memory tag of the thread
+ * 
+ * @param InTag		New memory tag
+ * @return Return previous memory tag of the thread
+ */
+EMemoryTag appSetMemoryTag( EMemoryTag InTag );
+
+/**
+ * @ingroup Core
+ * @brief Get name of memory tag
+ * 
+ * @param InTag		Memory tag
+ * @return Return name of memory tag
+ */
+const tchar* appGetMemoryTagName( EMemoryTag InTag );
+
+/**
+ * @ingroup Core
+ * @brief Get memory statistics of tag
+ * @note If TRACK_MEMORY is disabled all statistics is zero
+ * 
+ * @param InTag		Memory tag
+ * @return Return memory statistics of tag
+ */
+SMemoryTagStats appGetMemoryTagStats( EMemoryTag InTag );
+
+/**
+ * @ingroup Core
+ * @brief Get number of allocations in the last frame
+ * @return Return number of allocations in the last frame
+ */
+uint64 appGetMemoryFrameAllocations();
+
+/**
+ * @ingroup Core
+ * @brief Mark end of the frame for memory statistics
+ * @note Must be called once per frame from game thread
+ */
+void appMemoryEndFrame();
+
+/**
+ * @ingroup Core
+ * @brief Scoped memory tag, all allocations with default tag in this scope is marked by it
+ */
+class CScopedMemoryTag
+{
+public:
+	/**
+	 * @brief Constructor
+	 * @param InTag		Memory tag
+	 */
+	FORCEINLINE CScopedMemoryTag( EMemoryTag InTag )
+		: prevTag( appSetMemoryTag( InTag ) )
+	{}
+
+	/**
+	 * @brief Destructor
+	 */
+	FORCEINLINE ~CScopedMemoryTag()
+	{
+		appSetMemoryTag( prevTag );
+	}
+
+private:
+	EMemoryTag		prevTag;		/**< Previous memory tag of the thread */
+};
+
 #endif // !MEMORYBASE_H
\ No newline at end of file
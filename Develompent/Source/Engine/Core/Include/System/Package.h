@@ -111,6 +111,30 @@ FORCEINLINE std::wstring ConvertAssetTypeToText( EAssetType InAssetType )
 	}
 }
 
+/**
+ * @ingroup Core
+ * Get memory tag for asset type
+ *
+ * @param InAssetType	Asset type
+ * @return Return memory tag which used for allocations of asset
+ */
+FORCEINLINE EMemoryTag appGetAssetMemoryTag( EAssetType InAssetType )
+{
+	switch ( InAssetType )
+	{
+	case AT_Texture2D:			return MT_Texture2D;
+	case AT_Material:			return MT_Material;
+	case AT_Script:				return MT_Script;
+	case AT_StaticMesh:			return MT_StaticMesh;
+	case AT_AudioBank:			return MT_AudioBank;
+	case AT_PhysicsMaterial:	return MT_PhysicsMaterial;
+
+	case AT_Unknown:
+	default:
+		return MT_Default;
+	}
+}
+
 /**
  * @ingroup Core
  * Struct reference to asset
@@ -569,6 +593,18 @@ public:
 	}
 #endif // WITH_EDITOR
 
+	/**
+	 * Get number of live assets
+	 *
+	 * @param InType	Asset type
+	 * @return Return number of live assets with type InType
+	 */
+	static FORCEINLINE uint32 GetNumAssets( EAssetType InType )
+	{
+		check( InType >= AT_FirstType && InType < AT_Count );
+		return ( uint32 )numAssets[ InType ];
+	}
+
 	/**
 	 * Get dependent assets
 	 * @param OutDependentAssets	Output set of dependent assets
@@ -596,6 +632,7 @@ private:
 	CGuid							guid;				/**< GUID of asset */
 	EAssetType						type;				/**< Asset type */
 	mutable TAssetHandle<CAsset>	handle;				/**< Handle to this asset */
+	static volatile int32			numAssets[ AT_Count ];		/**< Number of live assets by type */
 
 #if WITH_EDITOR
 	std::wstring					sourceFile;			/**< Path to source file */
@@ -1576,7 +1613,7 @@ private:
 		 */
 		FORCEINLINE uint64 GetTypeHash() const
 		{
-			return appMemFastHash( ( const void* ) path.c_str(), path.size() );
+			return appCalcHash( path );
 		}
 
 		/**
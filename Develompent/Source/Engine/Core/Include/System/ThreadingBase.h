@@ -73,6 +73,17 @@ extern FORCEINLINE int32 appInterlockedDecrement( volatile int32* InValue );
  */
 extern FORCEINLINE int32 appInterlockedAdd( volatile int32* InValue, int32 InAmount );
 
+/**
+ * @ingroup Core
+ * Atomically adds the amount to the value pointed to and returns the old
+ * value to the caller
+ *
+ * @param InValue	Value
+ * @param InAmount	Amount
+ * @return Return the old value to the caller
+ */
+extern FORCEINLINE int64 appInterlockedAdd64( volatile int64* InValue, int64 InAmount );
+
 /**
  * @ingroup Core
  * Atomically swaps two values returning the original value to the caller
@@ -0,0 +1,277 @@
+#include "Containers/ChunkedCommandBuffer.h"
+#include "System/ThreadingBase.h"
+#include "System/MemoryBase.h"
+#include "Misc/Template.h"
+#include "Misc/Misc.h"
+
+CChunkedCommandBuffer::CChunkedCommandBuffer( uint32 InChunkSize, uint32 InMaxSize, uint32 InAlignment /* = 1 */ )
+	: chunkSize( Align( InChunkSize, InAlignment ) )
+	, maxSize( InMaxSize )
+	, alignment( InAlignment )
+	, freeChunks( nullptr )
+	, recycledChunks( nullptr )
+	, isWriting( false )
+	, allocatedBytes( 0 )
+	, numChunks( 0 )
+	, readBytes( 0 )
+	, writtenBytes( 0 )
+	, frameBytes( 0 )
+	, frameStallSeconds( 0.0 )
+	, dataWrittenEvent( nullptr )
+{
+	// Writer can't be stalled when only one chunk is allocated, because reader never returns the last chunk
+	check( maxSize >= chunkSize * 2 );
+	appMemzero( &stats, sizeof( SCommandBufferStats ) );
+	writeChunk = readChunk = AllocateChunk( chunkSize );
+}
+
+CChunkedCommandBuffer::~CChunkedCommandBuffer()
+{
+	SChunk*		lists[] = { readChunk, freeChunks, recycledChunks };
+	for ( uint32 index = 0; index < ARRAY_COUNT( lists ); ++index )
+	{
+		SChunk*		chunk = lists[ index ];
+		while ( chunk )
+		{
+			SChunk*		nextChunk = chunk->next;
+			FreeChunk( chunk );
+			chunk = nextChunk;
+		}
+	}
+
+	if ( dataWrittenEvent )
+	{
+		GSynchronizeFactory->Destroy( dataWrittenEvent );
+	}
+}
+
+CChunkedCommandBuffer::SChunk* CChunkedCommandBuffer::AllocateChunk( uint32 InSize )
+{
+	// Header and data of chunk are allocated by one block
+	byte*		memory	= ( byte* )appMalloc( Align( sizeof( SChunk ), MEMORY_DEFAULT_ALIGNMENT ) + InSize, MT_RenderCommands, Max<uint32>( alignment, MEMORY_DEFAULT_ALIGNMENT ) );
+	SChunk*		chunk	= ( SChunk* )memory;
+	chunk->next			= nullptr;
+	chunk->data			= memory + Align( sizeof( SChunk ), MEMORY_DEFAULT_ALIGNMENT );
+	chunk->size			= InSize;
+	chunk->writeOffset	= 0;
+	chunk->readOffset	= 0;
+
+	appInterlockedAdd64( &allocatedBytes, InSize );
+	appInterlockedIncrement( &numChunks );
+	return chunk;
+}
+
+void CChunkedCommandBuffer::FreeChunk( SChunk* InChunk )
+{
+	appInterlockedAdd64( &allocatedBytes, -( int64 )InChunk->size );
+	appInterlockedDecrement( &numChunks );
+	appFree( InChunk );
+}
+
+CChunkedCommandBuffer::SChunk* CChunkedCommandBuffer::PopFreeChunk()
+{
+	// Move chunks returned by reader to the pool
+	if ( !freeChunks && recycledChunks )
+	{
+		SChunk*		chunks = nullptr;
+		do
+		{
+			chunks = recycledChunks;
+		}
+		while ( appInterlockedCompareExchangePointer( ( void** )&recycledChunks, nullptr, chunks ) != chunks );
+		freeChunks = chunks;
+	}
+
+	SChunk*		chunk = freeChunks;
+	if ( chunk )
+	{
+		freeChunks			= chunk->next;
+		chunk->next			= nullptr;
+		chunk->writeOffset	= 0;
+		chunk->readOffset	= 0;
+	}
+	return chunk;
+}
+
+void CChunkedCommandBuffer::RecycleChunk( SChunk* InChunk )
+{
+	// Chunks bigger than default are allocated for big allocations only, so they aren't pooled
+	if ( InChunk->size != chunkSize )
+	{
+		FreeChunk( InChunk );
+		return;
+	}
+
+	SChunk*		chunks = nullptr;
+	do
+	{
+		chunks			= recycledChunks;
+		InChunk->next	= chunks;
+	}
+	while ( appInterlockedCompareExchangePointer( ( void** )&recycledChunks, InChunk, chunks ) != chunks );
+}
+
+void CChunkedCommandBuffer::LinkChunk( uint32 InMinSize )
+{
+	SChunk*		newChunk = nullptr;
+	if ( InMinSize <= chunkSize )
+	{
+		newChunk = PopFreeChunk();
+
+		// If pool is empty and the buffer reached its max size, wait until reader returns any chunk
+		if ( !newChunk && ( uint64 )allocatedBytes + chunkSize > maxSize )
+		{
+			const double		startStallTime = appSeconds();
+			while ( !recycledChunks && ( uint64 )allocatedBytes + chunkSize > maxSize )
+			{
+				appSleep( 0.f );
+			}
+
+			const double		stallSeconds = appSeconds() - startStallTime;
+			frameStallSeconds			+= stallSeconds;
+			stats.totalStallSeconds		+= stallSeconds;
+			++stats.numStalls;
+			newChunk = PopFreeChunk();
+		}
+	}
+
+	if ( !newChunk )
+	{
+		newChunk = AllocateChunk( Max( chunkSize, InMinSize ) );
+	}
+
+	// Publish the new chunk to reader, after this the writer never writes to the current chunk
+	appInterlockedCompareExchangePointer( ( void** )&writeChunk->next, newChunk, nullptr );
+	writeChunk = newChunk;
+}
+
+CChunkedCommandBuffer::CAllocationContext::CAllocationContext( CChunkedCommandBuffer& InCommandBuffer, uint32 InAllocationSize )
+	: commandBuffer( InCommandBuffer )
+{
+	commandBuffer.criticalSection.Lock();
+
+	// Only allow a single CAllocationContext at a time for the command buffer
+	check( !commandBuffer.isWriting );
+	commandBuffer.isWriting = true;
+
+	// If the allocation doesn't fit in the current chunk, continue in a new one
+	allocationSize = Align( InAllocationSize, commandBuffer.alignment );
+	if ( ( uint32 )commandBuffer.writeChunk->writeOffset + allocationSize > commandBuffer.writeChunk->size )
+	{
+		commandBuffer.LinkChunk( allocationSize );
+	}
+	allocationStart = commandBuffer.writeChunk->data + commandBuffer.writeChunk->writeOffset;
+}
+
+CChunkedCommandBuffer::CAllocationContext::~CAllocationContext()
+{
+	Commit();
+}
+
+void CChunkedCommandBuffer::CAllocationContext::Commit()
+{
+	if ( allocationStart )
+	{
+		// Advance the write offset, it is a full memory barrier, so reader sees the written data
+		SChunk*		chunk = commandBuffer.writeChunk;
+		appInterlockedExchange( &chunk->writeOffset, chunk->writeOffset + allocationSize );
+
+		// Update statistics
+		commandBuffer.writtenBytes	+= allocationSize;
+		commandBuffer.frameBytes	+= allocationSize;
+		commandBuffer.stats.peakOccupancy = Max<uint64>( commandBuffer.stats.peakOccupancy, commandBuffer.writtenBytes - commandBuffer.readBytes );
+
+		// Reset the isWriting flag to allow other CAllocationContexts to be created for the command buffer
+		commandBuffer.isWriting = false;
+		commandBuffer.criticalSection.Unlock();
+
+		// Clear the allocation pointer, to signal that it has been committed
+		allocationStart = nullptr;
+
+		// Lazily create the data-written event. It can't be done in the CChunkedCommandBuffer constructor because GSynchronizeFactory may not
+		// be initialized at that point
+		if ( !commandBuffer.dataWrittenEvent )
+		{
+			commandBuffer.dataWrittenEvent = GSynchronizeFactory->CreateSynchEvent();
+			checkMsg( commandBuffer.dataWrittenEvent, TEXT( "Failed to create data-write event for CChunkedCommandBuffer" ) );
+		}
+
+		// Trigger the data-written event to wake the reader thread
+		commandBuffer.dataWrittenEvent->Trigger();
+	}
+}
+
+bool CChunkedCommandBuffer::BeginRead( void*& OutReadPointer, uint32& OutReadSize )
+{
+	while ( true )
+	{
+		// Make a snapshot of a recent value of write offset
+		uint32		writeOffset = readChunk->writeOffset;
+		if ( readChunk->readOffset < writeOffset )
+		{
+			OutReadPointer	= readChunk->data + readChunk->readOffset;
+			OutReadSize		= writeOffset - readChunk->readOffset;
+			return true;
+		}
+
+		// If the writer didn't link a next chunk, there is no data to read
+		SChunk*		nextChunk = readChunk->next;
+		if ( !nextChunk )
+		{
+			return false;
+		}
+
+		// Writer commits all data of the chunk before it links the next one, so check it again
+		if ( readChunk->readOffset < ( uint32 )readChunk->writeOffset )
+		{
+			continue;
+		}
+
+		// Chunk is fully read, move to the next one and return this to the writer
+		SChunk*		oldChunk = readChunk;
+		readChunk = nextChunk;
+		RecycleChunk( oldChunk );
+	}
+}
+
+void CChunkedCommandBuffer::FinishRead( uint32 InReadSize )
+{
+	const uint32		alignedReadSize = Align( InReadSize, alignment );
+	readChunk->readOffset += alignedReadSize;
+	appInterlockedAdd64( &readBytes, alignedReadSize );
+}
+
+void CChunkedCommandBuffer::WaitForRead( uint32 InWaitTime /* = ( uint32 )-1 */ )
+{
+	// If the buffer is empty, wait for the data-written event to be triggered
+	if ( IsReadBufferEmpty() )
+	{
+		if ( dataWrittenEvent )
+		{
+			dataWrittenEvent->Wait( InWaitTime );
+		}
+		else
+		{
+			appSleep( 0.001f );
+		}
+	}
+}
+
+void CChunkedCommandBuffer::EndFrame()
+{
+	CScopeLock		scopeLock( criticalSection );
+	stats.lastFrameBytes		= frameBytes;
+	stats.peakFrameBytes		= Max( stats.peakFrameBytes, frameBytes );
+	stats.lastFrameStallSeconds	= frameStallSeconds;
+	frameBytes					= 0;
+	frameStallSeconds			= 0.0;
+}
+
+SCommandBufferStats CChunkedCommandBuffer::GetStats() const
+{
+	SCommandBufferStats		result = stats;
+	result.totalBytes		= writtenBytes;
+	result.allocatedBytes	= allocatedBytes;
+	result.numChunks		= numChunks;
+	return result;
+}
\ No newline at end of file
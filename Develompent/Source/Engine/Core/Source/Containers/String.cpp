@@ -22,9 +22,26 @@ std::wstring CString::Format( const tchar* InFormat, ... )
  */
 std::wstring CString::Format( const tchar* InFormat, va_list InArguments )
 {
-	int32           bufferSize = 1024;
+	// Most of strings is fit to buffer on the stack, in this case we avoid the temporary heap allocation
+	tchar			stackBuffer[ STRING_TLS_BUFFER_SIZE ];
+	int				result = -1;
+	{
+		va_list		arguments;
+		va_copy( arguments, InArguments );
+		result = appGetVarArgs( stackBuffer, STRING_TLS_BUFFER_SIZE, STRING_TLS_BUFFER_SIZE - 1, InFormat, arguments );
+		va_end( arguments );
+	}
+
+	if ( result >= 0 && result < STRING_TLS_BUFFER_SIZE )
+	{
+		stackBuffer[ result ] = 0;
+		return std::wstring( stackBuffer, result );
+	}
+
+	// Otherwise grow heap buffer until the string fit
+	int32           bufferSize = STRING_TLS_BUFFER_SIZE * 2;
 	tchar*			buffer = nullptr;
-	int             result = -1;
+	result = -1;
 
 	while ( result == -1 )
 	{
@@ -32,7 +49,11 @@ std::wstring CString::Format( const tchar* InFormat, va_list InArguments )
 		buffer = ( tchar* )malloc( bufferSize * sizeof( tchar ) );
 
 		// Get formated string with args
-		result = appGetVarArgs( buffer, bufferSize, bufferSize - 1, InFormat, InArguments );
+		va_list		arguments;
+		va_copy( arguments, InArguments );
+		result = appGetVarArgs( buffer, bufferSize, bufferSize - 1, InFormat, arguments );
+		va_end( arguments );
+
 		if ( result >= bufferSize )
 		{
 			result = -1;
@@ -42,7 +63,39 @@ std::wstring CString::Format( const tchar* InFormat, va_list InArguments )
 	}
 	buffer[ result ] = 0;
 
-	std::wstring		formatedString = buffer;
+	std::wstring		formatedString( buffer, result );
 	free( buffer );
 	return formatedString;
+}
+
+/**
+ * Getting a formatted string into caller-provided buffer
+ */
+int32 CString::FormatBuffer( tchar* OutBuffer, uint32 InBufferSize, const tchar* InFormat, ... )
+{
+	va_list			arguments;
+	va_start( arguments, InFormat );
+
+	int32			result = FormatBuffer( OutBuffer, InBufferSize, InFormat, arguments );
+
+	va_end( arguments );
+	return result;
+}
+
+/**
+ * Getting a formatted string into caller-provided buffer
+ */
+int32 CString::FormatBuffer( tchar* OutBuffer, uint32 InBufferSize, const tchar* InFormat, va_list InArguments )
+{
+	check( OutBuffer && InBufferSize > 0 );
+
+	int32		result = appGetVarArgs( OutBuffer, InBufferSize, InBufferSize - 1, InFormat, InArguments );
+	if ( result < 0 || result >= ( int32 )InBufferSize )
+	{
+		// String is truncated
+		result = InBufferSize - 1;
+	}
+
+	OutBuffer[ result ] = 0;
+	return result;
 }
\ No newline at end of file
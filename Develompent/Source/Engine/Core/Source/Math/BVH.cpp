@@ -0,0 +1,113 @@
+#include <algorithm>
+
+#include "Misc/Template.h"
+#include "Math/BVH.h"
+
+void CBVH::Build( const CBox* InBoxes, uint32 InNumBoxes )
+{
+	Clear();
+	if ( InNumBoxes == 0 )
+	{
+		return;
+	}
+
+	items.resize( InNumBoxes );
+	for ( uint32 index = 0; index < InNumBoxes; ++index )
+	{
+		items[ index ] = index;
+	}
+
+	// Each split makes two nodes, so tree has less than two nodes per item
+	nodes.reserve( InNumBoxes * 2 );
+	nodes.resize( 1 );
+	Refit( InBoxes );		// Fill bounds of items
+	BuildNode( 0, 0, InNumBoxes, 0 );
+}
+
+void CBVH::BuildNode( uint32 InNodeIndex, uint32 InFirstItem, uint32 InNumItems, uint32 InDepth )
+{
+	// Bound box of centers of items
+	Vector		centerMin( FLT_MAX, FLT_MAX, FLT_MAX );
+	Vector		centerMax( -FLT_MAX, -FLT_MAX, -FLT_MAX );
+	for ( uint32 index = InFirstItem, count = InFirstItem + InNumItems; index < count; ++index )
+	{
+		const Vector	center = ( boxMins[ items[ index ] ] + boxMaxs[ items[ index ] ] ) * 0.5f;
+		centerMin = Vector( Min( centerMin.x, center.x ), Min( centerMin.y, center.y ), Min( centerMin.z, center.z ) );
+		centerMax = Vector( Max( centerMax.x, center.x ), Max( centerMax.y, center.y ), Max( centerMax.z, center.z ) );
+	}
+
+	if ( InNumItems <= BVH_MAX_LEAF_ITEMS || InDepth + 1 >= BVH_MAX_DEPTH )
+	{
+		SNode&		node = nodes[ InNodeIndex ];
+		node.firstChildOrItem	= InFirstItem;
+		node.numItems			= InNumItems;
+		CalcLeafBounds( node );
+		return;
+	}
+
+	// Split by median of centers along the longest axis
+	const Vector	extent	= centerMax - centerMin;
+	const uint32	axis	= extent.x >= extent.y && extent.x >= extent.z ? 0 : ( extent.y >= extent.z ? 1 : 2 );
+	const uint32	half	= InNumItems / 2;
+	std::nth_element( items.begin() + InFirstItem, items.begin() + InFirstItem + half, items.begin() + InFirstItem + InNumItems, [&]( uint32 InA, uint32 InB )
+					  {
+						  return boxMins[ InA ][ axis ] + boxMaxs[ InA ][ axis ] < boxMins[ InB ][ axis ] + boxMaxs[ InB ][ axis ];
+					  } );
+
+	const uint32	firstChild = nodes.size();
+	nodes.resize( firstChild + 2 );
+	nodes[ InNodeIndex ].firstChildOrItem	= firstChild;
+	nodes[ InNodeIndex ].numItems			= 0;
+	BuildNode( firstChild, InFirstItem, half, InDepth + 1 );
+	BuildNode( firstChild + 1, InFirstItem + half, InNumItems - half, InDepth + 1 );
+
+	SNode&			node		= nodes[ InNodeIndex ];
+	const SNode&	leftChild	= nodes[ firstChild ];
+	const SNode&	rightChild	= nodes[ firstChild + 1 ];
+	node.boundMin = Vector( Min( leftChild.boundMin.x, rightChild.boundMin.x ), Min( leftChild.boundMin.y, rightChild.boundMin.y ), Min( leftChild.boundMin.z, rightChild.boundMin.z ) );
+	node.boundMax = Vector( Max( leftChild.boundMax.x, rightChild.boundMax.x ), Max( leftChild.boundMax.y, rightChild.boundMax.y ), Max( leftChild.boundMax.z, rightChild.boundMax.z ) );
+}
+
+void CBVH::CalcLeafBounds( SNode& InOutNode ) const
+{
+	InOutNode.boundMin = Vector( FLT_MAX, FLT_MAX, FLT_MAX );
+	InOutNode.boundMax = Vector( -FLT_MAX, -FLT_MAX, -FLT_MAX );
+	for ( uint32 index = InOutNode.firstChildOrItem, count = InOutNode.firstChildOrItem + InOutNode.numItems; index < count; ++index )
+	{
+		const Vector&	boxMin = boxMins[ items[ index ] ];
+		const Vector&	boxMax = boxMaxs[ items[ index ] ];
+		InOutNode.boundMin = Vector( Min( InOutNode.boundMin.x, boxMin.x ), Min( InOutNode.boundMin.y, boxMin.y ), Min( InOutNode.boundMin.z, boxMin.z ) );
+		InOutNode.boundMax = Vector( Max( InOutNode.boundMax.x, boxMax.x ), Max( InOutNode.boundMax.y, boxMax.y ), Max( InOutNode.boundMax.z, boxMax.z ) );
+	}
+}
+
+void CBVH::Refit( const CBox* InBoxes )
+{
+	const uint32	numItems = items.size();
+	boxMins.resize( numItems );
+	boxMaxs.resize( numItems );
+	for ( uint32 index = 0; index < numItems; ++index )
+	{
+		// Empty box is never hit, because its min is greater than max
+		const CBox&		box = InBoxes[ index ];
+		boxMins[ index ] = box.IsValid() ? box.GetMin() : Vector( FLT_MAX, FLT_MAX, FLT_MAX );
+		boxMaxs[ index ] = box.IsValid() ? box.GetMax() : Vector( -FLT_MAX, -FLT_MAX, -FLT_MAX );
+	}
+
+	// Children are always placed after parent, so nodes are refitted from the end
+	for ( int32 nodeIndex = ( int32 )nodes.size() - 1; nodeIndex >= 0; --nodeIndex )
+	{
+		SNode&		node = nodes[ nodeIndex ];
+		if ( node.numItems > 0 )
+		{
+			CalcLeafBounds( node );
+		}
+		else if ( node.firstChildOrItem > 0 )
+		{
+			const SNode&	leftChild	= nodes[ node.firstChildOrItem ];
+			const SNode&	rightChild	= nodes[ node.firstChildOrItem + 1 ];
+			node.boundMin = Vector( Min( leftChild.boundMin.x, rightChild.boundMin.x ), Min( leftChild.boundMin.y, rightChild.boundMin.y ), Min( leftChild.boundMin.z, rightChild.boundMin.z ) );
+			node.boundMax = Vector( Max( leftChild.boundMax.x, rightChild.boundMax.x ), Max( leftChild.boundMax.y, rightChild.boundMax.y ), Max( leftChild.boundMax.z, rightChild.boundMax.z ) );
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,10 @@
+#include "System/Delegate.h"
+
+/**
+ * Generate new unique ID for delegate
+ */
+uint64 CDelegateHandle::GenerateNewId()
+{
+	static volatile int64		nextId = 0;
+	return appInterlockedAdd64( &nextId, 1 ) + 1;
+}
\ No newline at end of file
@@ -0,0 +1,412 @@
+#include <stdlib.h>
+#include <string.h>
+#include <new>
+
+#include "Core.h"
+#include "System/MemoryBase.h"
+#include "System/ThreadingBase.h"
+
+/**
+ * @ingroup Core
+ * @brief Magic number for check what memory is allocated by appMalloc
+ */
+#define MEMORY_HEADER_MAGIC		0x1EA1
+
+/**
+ * @ingroup Core
+ * @brief Header of allocation, it is placed right before pointer returned by appMalloc
+ */
+struct SAllocationHeader
+{
+	uint64		size;			/**< Requested size of memory */
+	uint32		offset;			/**< Offset from begin of system allocation to user pointer */
+	uint16		tag;			/**< Memory tag (see EMemoryTag) */
+	uint16		magic;			/**< Magic number (see MEMORY_HEADER_MAGIC) */
+};
+static_assert( sizeof( SAllocationHeader ) == MEMORY_DEFAULT_ALIGNMENT, "Size of SAllocationHeader must be equal to default alignment" );
+
+//
+// GLOBALS
+//
+
+/**
+ * @ingroup Core
+ * @brief Current memory tag of the thread
+ */
+static thread_local EMemoryTag		GThreadMemoryTag = MT_Default;
+
+#if TRACK_MEMORY
+/**
+ * @ingroup Core
+ * @brief Memory statistics of each tag
+ * @note It is POD and zero initialized before any dynamic initialization, so it safe to use from global constructors
+ */
+static SMemoryTagStats				GMemoryTagStats[ MT_Count ];
+
+/**
+ * @ingroup Core
+ * @brief Number of allocations in the current frame
+ */
+static volatile int64				GMemoryFrameAllocations = 0;
+
+/**
+ * @ingroup Core
+ * @brief Number of allocations in the last frame
+ */
+static int64						GMemoryLastFrameAllocations = 0;
+
+/**
+ * @ingroup Core
+ * @brief Update memory statistics of tag on allocate
+ *
+ * @param InTag		Memory tag
+ * @param InSize	Size of allocation
+ */
+static FORCEINLINE void MemoryTrackAlloc( EMemoryTag InTag, uint64 InSize )
+{
+	SMemoryTagStats&	stats = GMemoryTagStats[ InTag ];
+	int64				newBytes = appInterlockedAdd64( &stats.currentBytes, ( int64 )InSize ) + ( int64 )InSize;
+	appInterlockedAdd64( &stats.numAllocations, 1 );
+	appInterlockedAdd64( &stats.totalAllocations, 1 );
+	appInterlockedAdd64( &GMemoryFrameAllocations, 1 );
+
+	// Update high-water mark
+	int64				peakBytes = stats.peakBytes;
+	while ( newBytes > peakBytes )
+	{
+		int64		prevPeakBytes = appInterlockedCompareExchange64( &stats.peakBytes, newBytes, peakBytes );
+		if ( prevPeakBytes == peakBytes )
+		{
+			break;
+		}
+		peakBytes = prevPeakBytes;
+	}
+}
+
+/**
+ * @ingroup Core
+ * @brief Update memory statistics of tag on free
+ *
+ * @param InTag		Memory tag
+ * @param InSize	Size of allocation
+ */
+static FORCEINLINE void MemoryTrackFree( EMemoryTag InTag, uint64 InSize )
+{
+	SMemoryTagStats&	stats = GMemoryTagStats[ InTag ];
+	appInterlockedAdd64( &stats.currentBytes, -( int64 )InSize );
+	appInterlockedAdd64( &stats.numAllocations, -1 );
+}
+#endif // TRACK_MEMORY
+
+/**
+ * @ingroup Core
+ * @brief Get allocation header
+ *
+ * @param InPtr		Pointer to memory allocated by appMalloc
+ * @return Return allocation header
+ */
+static FORCEINLINE SAllocationHeader* GetAllocationHeader( void* InPtr )
+{
+	SAllocationHeader*		header = ( SAllocationHeader* )InPtr - 1;
+	checkMsg( header->magic == MEMORY_HEADER_MAGIC, TEXT( "Memory 0x%p not allocated by appMalloc" ), InPtr );
+	return header;
+}
+
+/**
+ * Long input path of appMemFastHash
+ */
+uint64 appMemFastHashLong( const void* InData, uint64 InLength, uint64 InHash )
+{
+	check( InLength >= MEMORY_HASH_BLOCK_SIZE );
+	const byte*		data	= ( const byte* )InData;
+	const byte*		dataEnd	= data + InLength - MEMORY_HASH_BLOCK_SIZE;
+
+	// Four independent lanes, each one consumes 8 bytes per step
+	uint64			lane1	= InHash + MEMORY_HASH_PRIME1 + MEMORY_HASH_PRIME2;
+	uint64			lane2	= InHash + MEMORY_HASH_PRIME2;
+	uint64			lane3	= InHash;
+	uint64			lane4	= InHash - MEMORY_HASH_PRIME1;
+	for ( ; data <= dataEnd; data += MEMORY_HASH_BLOCK_SIZE )
+	{
+		lane1 = appMemHashRound( lane1, appMemRead64( data ) );
+		lane2 = appMemHashRound( lane2, appMemRead64( data + 8 ) );
+		lane3 = appMemHashRound( lane3, appMemRead64( data + 16 ) );
+		lane4 = appMemHashRound( lane4, appMemRead64( data + 24 ) );
+	}
+
+	// Merge lanes
+	uint64			hash	= appRotateLeft64( lane1, 1 ) + appRotateLeft64( lane2, 7 ) + appRotateLeft64( lane3, 12 ) + appRotateLeft64( lane4, 18 );
+	hash = ( hash ^ appMemHashRound( 0, lane1 ) ) * MEMORY_HASH_PRIME1 + MEMORY_HASH_PRIME4;
+	hash = ( hash ^ appMemHashRound( 0, lane2 ) ) * MEMORY_HASH_PRIME1 + MEMORY_HASH_PRIME4;
+	hash = ( hash ^ appMemHashRound( 0, lane3 ) ) * MEMORY_HASH_PRIME1 + MEMORY_HASH_PRIME4;
+	hash = ( hash ^ appMemHashRound( 0, lane4 ) ) * MEMORY_HASH_PRIME1 + MEMORY_HASH_PRIME4;
+
+	hash += InLength;
+	return appMemHashFinalize( hash, data, InLength % MEMORY_HASH_BLOCK_SIZE );
+}
+
+/**
+ * Allocate memory
+ */
+void* appMalloc( uint64 InSize, EMemoryTag InTag, uint32 InAlignment /* = MEMORY_DEFAULT_ALIGNMENT */ )
+{
+	check( InTag >= 0 && InTag < MT_Count );
+	checkMsg( InAlignment > 0 && !( InAlignment & ( InAlignment - 1 ) ), TEXT( "Alignment must be power of two" ) );
+	InAlignment = Max<uint32>( InAlignment, MEMORY_DEFAULT_ALIGNMENT );
+
+	byte*		rawPtr = ( byte* )malloc( InSize + sizeof( SAllocationHeader ) + InAlignment - 1 );
+	if ( !rawPtr )
+	{
+		return nullptr;
+	}
+
+	byte*		userPtr = ( byte* )( ( ( uintptr_t )rawPtr + sizeof( SAllocationHeader ) + InAlignment - 1 ) & ~( ( uintptr_t )InAlignment - 1 ) );
+	SAllocationHeader*		header = ( SAllocationHeader* )userPtr - 1;
+	header->size	= InSize;
+	header->offset	= ( uint32 )( userPtr - rawPtr );
+	header->tag		= ( uint16 )InTag;
+	header->magic	= MEMORY_HEADER_MAGIC;
+
+#if TRACK_MEMORY
+	MemoryTrackAlloc( InTag, InSize );
+#endif // TRACK_MEMORY
+	return userPtr;
+}
+
+/**
+ * Allocate memory with current memory tag of the thread
+ */
+void* appMalloc( uint64 InSize, uint32 InAlignment /* = MEMORY_DEFAULT_ALIGNMENT */ )
+{
+	return appMalloc( InSize, GThreadMemoryTag, InAlignment );
+}
+
+/**
+ * Reallocate memory
+ */
+void* appRealloc( void* InPtr, uint64 InNewSize, uint32 InAlignment /* = MEMORY_DEFAULT_ALIGNMENT */ )
+{
+	if ( !InPtr )
+	{
+		return appMalloc( InNewSize, InAlignment );
+	}
+
+	SAllocationHeader*		header = GetAllocationHeader( InPtr );
+	void*					newPtr = appMalloc( InNewSize, ( EMemoryTag )header->tag, InAlignment );
+	if ( newPtr )
+	{
+		memcpy( newPtr, InPtr, Min( header->size, InNewSize ) );
+		appFree( InPtr );
+	}
+	return newPtr;
+}
+
+/**
+ * Free memory
+ */
+void appFree( void* InPtr )
+{
+	if ( !InPtr )
+	{
+		return;
+	}
+
+	SAllocationHeader*		header = GetAllocationHeader( InPtr );
+#if TRACK_MEMORY
+	MemoryTrackFree( ( EMemoryTag )header->tag, header->size );
+#endif // TRACK_MEMORY
+
+	header->magic = 0;
+	free( ( byte* )InPtr - header->offset );
+}
+
+/**
+ * Get size of memory allocated by appMalloc
+ */
+uint64 appGetAllocationSize( void* InPtr )
+{
+	return InPtr ? GetAllocationHeader( InPtr )->size : 0;
+}
+
+/**
+ * Get current memory tag of the thread
+ */
+EMemoryTag appGetMemoryTag()
+{
+	return GThreadMemoryTag;
+}
+
+/**
+ * Set current memory tag of the thread
+ */
+EMemoryTag appSetMemoryTag( EMemoryTag InTag )
+{
+	check( InTag >= 0 && InTag < MT_Count );
+	EMemoryTag		prevTag = GThreadMemoryTag;
+	GThreadMemoryTag = InTag;
+	return prevTag;
+}
+
+/**
+ * Get name of memory tag
+ */
+const tchar* appGetMemoryTagName( EMemoryTag InTag )
+{
+	switch ( InTag )
+	{
+	case MT_Default:			return TEXT( "Default" );
+	case MT_Names:				return TEXT( "Names" );
+	case MT_Texture2D:			return TEXT( "Texture2D" );
+	case MT_Material:			return TEXT( "Material" );
+	case MT_Script:				return TEXT( "Script" );
+	case MT_StaticMesh:			return TEXT( "StaticMesh" );
+	case MT_AudioBank:			return TEXT( "AudioBank" );
+	case MT_PhysicsMaterial:	return TEXT( "PhysicsMaterial" );
+	case MT_BulkData:			return TEXT( "BulkData" );
+	case MT_RenderCommands:		return TEXT( "RenderCommands" );
+	default:
+		checkMsg( false, TEXT( "Unknown memory tag 0x%X" ), InTag );
+		return TEXT( "Unknown" );
+	}
+}
+
+/**
+ * Get memory statistics of tag
+ */
+SMemoryTagStats appGetMemoryTagStats( EMemoryTag InTag )
+{
+	check( InTag >= 0 && InTag < MT_Count );
+#if TRACK_MEMORY
+	return GMemoryTagStats[ InTag ];
+#else
+	SMemoryTagStats		stats;
+	appMemzero( &stats, sizeof( SMemoryTagStats ) );
+	return stats;
+#endif // TRACK_MEMORY
+}
+
+/**
+ * Get number of allocations in the last frame
+ */
+uint64 appGetMemoryFrameAllocations()
+{
+#if TRACK_MEMORY
+	return GMemoryLastFrameAllocations;
+#else
+	return 0;
+#endif // TRACK_MEMORY
+}
+
+/**
+ * Mark end of the frame for memory statistics
+ */
+void appMemoryEndFrame()
+{
+#if TRACK_MEMORY
+	GMemoryLastFrameAllocations = appInterlockedExchange64( &GMemoryFrameAllocations, 0 );
+#endif // TRACK_MEMORY
+}
+
+//
+// Global operators new/delete, route all allocations through appMalloc/appFree
+//
+
+void* operator new( size_t InSize )
+{
+	void*	ptr = appMalloc( InSize );
+	if ( !ptr )
+	{
+		throw std::bad_alloc();
+	}
+	return ptr;
+}
+
+void* operator new[]( size_t InSize )
+{
+	void*	ptr = appMalloc( InSize );
+	if ( !ptr )
+	{
+		throw std::bad_alloc();
+	}
+	return ptr;
+}
+
+void* operator new( size_t InSize, const std::nothrow_t& ) noexcept
+{
+	return appMalloc( InSize );
+}
+
+void* operator new[]( size_t InSize, const std::nothrow_t& ) noexcept
+{
+	return appMalloc( InSize );
+}
+
+void* operator new( size_t InSize, std::align_val_t InAlignment )
+{
+	void*	ptr = appMalloc( InSize, ( uint32 )InAlignment );
+	if ( !ptr )
+	{
+		throw std::bad_alloc();
+	}
+	return ptr;
+}
+
+void* operator new[]( size_t InSize, std::align_val_t InAlignment )
+{
+	void*	ptr = appMalloc( InSize, ( uint32 )InAlignment );
+	if ( !ptr )
+	{
+		throw std::bad_alloc();
+	}
+	return ptr;
+}
+
+void operator delete( void* InPtr ) noexcept
+{
+	appFree( InPtr );
+}
+
+void operator delete[]( void* InPtr ) noexcept
+{
+	appFree( InPtr );
+}
+
+void operator delete( void* InPtr, size_t ) noexcept
+{
+	appFree( InPtr );
+}
+
+void operator delete[]( void* InPtr, size_t ) noexcept
+{
+	appFree( InPtr );
+}
+
+void operator delete( void* InPtr, const std::nothrow_t& ) noexcept
+{
+	appFree( InPtr );
+}
+
+void operator delete[]( void* InPtr, const std::nothrow_t& ) noexcept
+{
+	appFree( InPtr );
+}
+
+void operator delete( void* InPtr, std::align_val_t ) noexcept
+{
+	appFree( InPtr );
+}
+
+void operator delete[]( void* InPtr, std::align_val_t ) noexcept
+{
+	appFree( InPtr );
+}
+
+void operator delete( void* InPtr, size_t, std::align_val_t ) noexcept
+{
+	appFree( InPtr );
+}
+
+void operator delete[]( void* InPtr, size_t, std::align_val_t ) noexcept
+{
+	appFree( InPtr );
+}
\ No newline at end of file
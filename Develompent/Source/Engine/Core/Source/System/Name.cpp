@@ -12,6 +12,7 @@ static std::vector<CName::SNameEntry>& GetGlobalNameTable()
 
 static FORCEINLINE void AllocateNameEntry( const std::wstring& InName, uint32 InHash )
 {
+	CScopedMemoryTag		memoryTag( MT_Names );
 	GetGlobalNameTable().push_back( CName::SNameEntry( InName, InHash ) );
 }
 
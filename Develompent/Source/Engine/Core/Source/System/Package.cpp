@@ -22,6 +22,8 @@
 // ASSET
 //
 
+volatile int32 CAsset::numAssets[ AT_Count ];
+
 CAsset::CAsset( EAssetType InType ) 
 	: bDirty( true )		// by default package is dirty because not serialized package from HDD
 	, package( nullptr )
@@ -31,10 +33,14 @@ CAsset::CAsset( EAssetType InType )
 #if WITH_EDITOR
 	, bOnlyEditor( false )
 #endif // WITH_EDITOR
-{}
+{
+	appInterlockedIncrement( &numAssets[ type ] );
+}
 
 CAsset::~CAsset()
-{}
+{
+	appInterlockedDecrement( &numAssets[ type ] );
+}
 
 void CAsset::Serialize( class CArchive& InArchive )
 {
@@ -498,6 +504,9 @@ TAssetHandle<CAsset> CPackage::LoadAsset( CArchive& InArchive, const CGuid& InAs
 		return nullptr;
 	}
 
+	// All allocations while loading asset is marked by memory tag of the asset type
+	CScopedMemoryTag		memoryTag( appGetAssetMemoryTag( InAssetInfo.type ) );
+
 	// Is already valid asset
 	bool		bValidAsset = InAssetInfo.data;
 
@@ -47,6 +47,15 @@ public:
 		staticMeshComponent->SetStaticMesh( InStaticMesh );
 	}
 
+	/**
+	 * @brief Get static mesh component
+	 * @return Return pointer to static mesh component
+	 */
+	FORCEINLINE TRefCountPtr< CStaticMeshComponent > GetStaticMeshComponent() const
+	{
+		return staticMeshComponent;
+	}
+
 #if WITH_EDITOR
 	/**
 	 * @brief Spawn asset actor
@@ -9,7 +9,10 @@
 #ifndef PRIMITIVECOMPONENT_H
 #define PRIMITIVECOMPONENT_H
 
+#include <vector>
+
 #include "Math/Box.h"
+#include "System/Package.h"
 #include "System/PhysicsBodySetup.h"
 #include "System/PhysicsBodyInstance.h"
 #include "Components/SceneComponent.h"
@@ -61,6 +64,47 @@ public:
 	 */
 	virtual void AddToDrawList( const class CSceneView& InSceneView );
 
+	/**
+	 * @brief Get materials used by primitive
+	 * @note Used by texture streaming for find textures of visible primitives
+	 *
+	 * @param OutMaterials	Output array of materials, materials are added to the end of array
+	 */
+	virtual void GetUsedMaterials( std::vector< TAssetHandle<class CMaterial> >& OutMaterials ) const;
+
+	/**
+	 * @brief Calculate bound box in world space
+	 * @note It doesn't change primitive, so it may be called from game thread while rendering thread builds view
+	 * @return Return bound box in world space, it is invalid if primitive is empty
+	 */
+	virtual CBox CalcBounds() const;
+
+	/**
+	 * @brief Update bound box in world space
+	 * @note Called by scene before visibility tests, so primitive must not calculate bound box in AddToDrawList
+	 */
+	virtual void UpdateBounds();
+
+	/**
+	 * @brief Adds occluder meshes of primitive to occlusion buffer
+	 * @note Called by scene for primitives in view frustum before occlusion test
+	 *
+	 * @param InOcclusionBuffer		Occlusion buffer
+	 */
+	virtual void AddToOcclusionBuffer( class COcclusionBuffer& InOcclusionBuffer ) const;
+
+	/**
+	 * @brief Cast ray against primitive
+	 * @note By default tests bound box from CalcBounds, primitives with CPU geometry test their triangles.
+	 * It doesn't use bound box updated by rendering thread, so it may be called from game thread
+	 *
+	 * @param InOrigin			Origin of ray in world space
+	 * @param InDirection		Direction of ray in world space, it may be not normalized
+	 * @param InOutDistance		Max distance of ray in lengths of InDirection, on output the distance of hit
+	 * @return Return TRUE if primitive is hit closer than InOutDistance
+	 */
+	virtual bool RayCast( const Vector& InOrigin, const Vector& InDirection, float& InOutDistance ) const;
+
 	/**
 	 * @brief Called when the owning Actor is spawned
 	 */
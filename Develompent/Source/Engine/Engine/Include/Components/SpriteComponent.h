@@ -45,6 +45,18 @@ public:
 	 */
 	virtual void AddToDrawList( const class CSceneView& InSceneView ) override;
 
+	/**
+	 * @brief Get materials used by primitive
+	 * @param OutMaterials	Output array of materials, materials are added to the end of array
+	 */
+	virtual void GetUsedMaterials( std::vector< TAssetHandle<CMaterial> >& OutMaterials ) const override;
+
+	/**
+	 * @brief Calculate bound box in world space
+	 * @return Return bound box in world space
+	 */
+	virtual CBox CalcBounds() const override;
+
 	/**
 	 * @brief Serialize component
 	 * @param[in] InArchive Archive for serialize
@@ -14,6 +14,12 @@
 #include "Render/Material.h"
 #include "Render/Scene.h"
 
+/**
+ * @ingroup Engine
+ * @brief Max number of views for which static mesh component keeps selected LOD
+ */
+#define STATICMESH_LOD_MAX_VIEWS		4
+
  /**
   * @ingroup Engine
   * @brief Component for work with static mesh
@@ -46,6 +52,35 @@ public:
 	 */
 	virtual void AddToDrawList( const class CSceneView& InSceneView ) override;
 
+	/**
+	 * @brief Get materials used by primitive
+	 * @param OutMaterials	Output array of materials, materials are added to the end of array
+	 */
+	virtual void GetUsedMaterials( std::vector< TAssetHandle<CMaterial> >& OutMaterials ) const override;
+
+	/**
+	 * @brief Calculate bound box in world space
+	 * @return Return bound box in world space, it is invalid if static mesh isn't set
+	 */
+	virtual CBox CalcBounds() const override;
+
+	/**
+	 * @brief Adds occluder of static mesh to occlusion buffer
+	 * @param InOcclusionBuffer		Occlusion buffer
+	 */
+	virtual void AddToOcclusionBuffer( class COcclusionBuffer& InOcclusionBuffer ) const override;
+
+	/**
+	 * @brief Cast ray against triangles of static mesh
+	 * @note If static mesh hasn't verteces on CPU (in game) bound box is tested
+	 *
+	 * @param InOrigin			Origin of ray in world space
+	 * @param InDirection		Direction of ray in world space, it may be not normalized
+	 * @param InOutDistance		Max distance of ray in lengths of InDirection, on output the distance of hit
+	 * @return Return TRUE if primitive is hit closer than InOutDistance
+	 */
+	virtual bool RayCast( const Vector& InOrigin, const Vector& InDirection, float& InOutDistance ) const override;
+
     /**
      * @brief Set material
      *
@@ -105,7 +140,46 @@ public:
         return material.IsValid() ? material : staticMeshRef->GetMaterial( InIndex );
     }
 
+	/**
+	 * @brief Get last LOD of view
+	 * 
+	 * @param InViewKey		Key of view (see CSceneView::GetViewKey)
+	 * @return Return LOD selected in the last AddToDrawList for this view, it doesn't include LOD bias. If the view isn't known returns 0
+	 */
+	FORCEINLINE uint32 GetLastLOD( uint32 InViewKey ) const
+	{
+		uint32		index = FindViewLOD( InViewKey );
+		return index != INDEX_NONE ? viewLODs[ index ].lodIndex : 0;
+	}
+
 private:
+	/**
+	 * @brief LOD selected in the last frame of view
+	 */
+	struct SViewLOD
+	{
+		uint32		viewKey;		/**< Key of view, 0 if slot is free */
+		uint32		lodIndex;		/**< LOD selected in the last frame of view */
+	};
+
+	/**
+	 * @brief Find slot of view in viewLODs
+	 * 
+	 * @param InViewKey		Key of view
+	 * @return Return index of slot, if view isn't found or key is 0 returns INDEX_NONE
+	 */
+	FORCEINLINE uint32 FindViewLOD( uint32 InViewKey ) const
+	{
+		for ( uint32 index = 0; InViewKey != 0 && index < STATICMESH_LOD_MAX_VIEWS; ++index )
+		{
+			if ( viewLODs[ index ].viewKey == InViewKey )
+			{
+				return index;
+			}
+		}
+		return INDEX_NONE;
+	}
+
 	/**
 	 * @brief Adds a draw policy link in SDGs
 	 */
@@ -116,9 +190,23 @@ private:
 	 */
 	virtual void UnlinkDrawList() override;
 
+	/**
+	 * @brief Select LOD by projected size of bound sphere
+	 * @note LOD is changed only if screen size crossed the threshold of LOD by STATICMESH_LOD_HYSTERESIS, so it doesn't flicker on the border.
+	 * Last LOD is kept for each view separately, so views don't switch LODs of each other. Views without key always select LOD by screen size only
+	 * 
+	 * @param InSceneView		Current view of scene
+	 * @param InTransformMatrix	Transform matrix of component
+	 * @param InStaticMesh		Static mesh
+	 * @return Return selected LOD
+	 */
+	uint32 SelectLOD( const class CSceneView& InSceneView, const Matrix& InTransformMatrix, const TSharedPtr<CStaticMesh>& InStaticMesh );
+
 	TAssetHandle<CStaticMesh>								staticMesh;						/**< Static mesh */
 	std::vector< TAssetHandle<CMaterial> >					overrideMaterials;				/**< Override materials */
 	TSharedPtr<CStaticMesh::SElementDrawingPolicyLink>		elementDrawingPolicyLink;		/**< Element drawing policy link of current static mesh */
+	SViewLOD												viewLODs[ STATICMESH_LOD_MAX_VIEWS ];	/**< LODs selected in the last AddToDrawList of each view */
+	uint32													nextViewLOD;					/**< Slot in viewLODs for new view when all slots are busy */
 };
 
 #endif // !STATICMESHCOMPONENT_H
@@ -0,0 +1,169 @@
+/**
+ * @file
+ * @addtogroup Engine Engine
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef TILEMAPCOMPONENT_H
+#define TILEMAPCOMPONENT_H
+
+#include <vector>
+
+#include "Components/PrimitiveComponent.h"
+#include "Render/Scene.h"
+#include "Render/TileMap.h"
+#include "Render/Material.h"
+
+#if ENABLE_HITPROXY
+#include "Render/SceneHitProxyRendering.h"
+#endif // ENABLE_HITPROXY
+
+/**
+ * @ingroup Engine
+ * @brief Component for render tile map
+ *
+ * Tiles are stored in chunks of TILEMAP_CHUNK_SIZE x TILEMAP_CHUNK_SIZE tiles of one layer with prebuilt geometry.
+ * Each chunk is culled by frustum separately and is drawn by one draw call per material
+ */
+class CTileMapComponent : public CPrimitiveComponent
+{
+	DECLARE_CLASS( CTileMapComponent, CPrimitiveComponent )
+
+public:
+	/**
+	 * @brief Constructor
+	 */
+	CTileMapComponent();
+
+	/**
+	 * @brief Serialize component
+	 * @param InArchive		Archive for serialize
+	 */
+	virtual void Serialize( class CArchive& InArchive ) override;
+
+	/**
+	 * @brief Adds mesh batches of visible chunks for draw in scene
+	 *
+	 * @param InSceneView	Current view of scene
+	 */
+	virtual void AddToDrawList( const class CSceneView& InSceneView ) override;
+
+	/**
+	 * @brief Get materials used by primitive
+	 * @param OutMaterials	Output array of materials, materials are added to the end of array
+	 */
+	virtual void GetUsedMaterials( std::vector< TAssetHandle<CMaterial> >& OutMaterials ) const override;
+
+	/**
+	 * @brief Calculate bound box in world space
+	 * @return Return bound box in world space, it is invalid if tile map is empty
+	 */
+	virtual CBox CalcBounds() const override;
+
+	/**
+	 * @brief Update bound box in world space and bound boxes of chunks
+	 */
+	virtual void UpdateBounds() override;
+
+	/**
+	 * @brief Set tiles
+	 * Tiles are split into chunks and geometry of chunks is built
+	 *
+	 * @param InTiles		Array of tiles
+	 * @param InMaterials	Array of materials, tiles refer to them by STileMapTile::materialIndex
+	 * @param InTileSize	Size of tile in tile map
+	 */
+	void SetTiles( const std::vector< STileMapTile >& InTiles, const std::vector< TAssetHandle<CMaterial> >& InMaterials, const Vector2D& InTileSize );
+
+	/**
+	 * @brief Get materials
+	 * @return Return array of materials
+	 */
+	FORCEINLINE const std::vector< TAssetHandle<CMaterial> >& GetMaterials() const
+	{
+		return materials;
+	}
+
+	/**
+	 * @brief Get number of chunks
+	 * @return Return number of chunks
+	 */
+	FORCEINLINE uint32 GetNumChunks() const
+	{
+		return chunks.size();
+	}
+
+	/**
+	 * @brief Get number of tiles
+	 * @return Return number of tiles in all chunks
+	 */
+	FORCEINLINE uint32 GetNumTiles() const
+	{
+		return numTiles;
+	}
+
+private:
+	/**
+	 * @brief Typedef of drawing policy link
+	 */
+	typedef CMeshDrawList<CMeshDrawingPolicy>::SDrawingPolicyLink					DrawingPolicyLink_t;
+
+	/**
+	 * @brief Typedef of reference on drawing policy link in scene
+	 */
+	typedef CMeshDrawList<CMeshDrawingPolicy>::DrawingPolicyLinkRef_t				DrawingPolicyLinkRef_t;
+
+#if ENABLE_HITPROXY
+	/**
+	 * @brief Typedef of hit proxy drawing policy link
+	 */
+	typedef CMeshDrawList<CHitProxyDrawingPolicy, false>::SDrawingPolicyLink			HitProxyDrawingPolicyLink_t;
+
+	/**
+	 * @brief Typedef of reference on hit proxy drawing policy link in scene
+	 */
+	typedef CMeshDrawList<CHitProxyDrawingPolicy, false>::DrawingPolicyLinkRef_t		HitProxyDrawingPolicyLinkRef_t;
+#endif // ENABLE_HITPROXY
+
+	/**
+	 * @brief Drawing policy links of chunk
+	 */
+	struct SChunkDrawingPolicyLink
+	{
+		std::vector<DrawingPolicyLinkRef_t>				drawingPolicyLinks;				/**< Array of references to drawing policy link in scene, one per surface */
+		std::vector<const SMeshBatch*>					meshBatchLinks;					/**< Array of references to mesh batch in drawing policy link */
+
+#if ENABLE_HITPROXY
+		std::vector<HitProxyDrawingPolicyLinkRef_t>		hitProxyDrawingPolicyLinks;		/**< Array of references to hit proxy drawing policy link in scene */
+#endif // ENABLE_HITPROXY
+	};
+
+	/**
+	 * @brief Calculate bound box of chunk in world space
+	 *
+	 * @param InTransformMatrix		Transform matrix from local to world space
+	 * @param InChunkIndex			Index of chunk
+	 * @return Return bound box of chunk in world space, it is invalid if chunk is empty
+	 */
+	CBox CalcChunkBounds( const Matrix& InTransformMatrix, uint32 InChunkIndex ) const;
+
+	/**
+	 * @brief Adds a draw policy links of all chunks in SDGs
+	 */
+	virtual void LinkDrawList() override;
+
+	/**
+	 * @brief Removes a draw policy links of all chunks from SDGs
+	 */
+	virtual void UnlinkDrawList() override;
+
+	std::vector< TAssetHandle<CMaterial> >		materials;					/**< Array of materials */
+	std::vector< TileMapChunkRef_t >			chunks;						/**< Array of chunks */
+	std::vector< SChunkDrawingPolicyLink >		chunkDrawingPolicyLinks;	/**< Drawing policy links of each chunk */
+	std::vector< CBox >							chunkBoundBoxes;			/**< Bound boxes of each chunk in world space, they are updated in UpdateBounds */
+	uint32										numTiles;					/**< Number of tiles in all chunks */
+};
+
+#endif // !TILEMAPCOMPONENT_H
\ No newline at end of file
@@ -12,6 +12,7 @@
 #include <string>
 #include <vector>
 
+#include "LEBuild.h"
 #include "Misc/PhysicsTypes.h"
 
  /**
@@ -88,6 +89,15 @@ extern bool						GIsCookEditorContent;
 extern bool						GAllowDebugShaderDump;
 #endif // WITH_EDITOR
 
+#if FRAME_CAPTURE_MARKERS
+/**
+ * @ingroup Engine
+ * @brief Is need emit draw events to RHI
+ * @note It enabled when GPU debugger is attached or with command line param '-emitdrawevents'
+ */
+extern bool						GEmitDrawEvents;
+#endif // FRAME_CAPTURE_MARKERS
+
 /**
  * @ingroup Engine
  * @brief Full screen movie player
@@ -100,4 +110,10 @@ extern class CFullScreenMovieSupport*		GFullScreenMovie;
  */
 extern class CConsoleSystem					GConsoleSystem;
 
+/**
+ * @ingroup Engine
+ * @brief Texture streaming manager
+ */
+extern class CTextureStreamingManager*		GTextureStreamingManager;
+
 #endif // !ENGINEGLOBALS_H
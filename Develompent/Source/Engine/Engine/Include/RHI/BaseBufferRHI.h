@@ -13,6 +13,24 @@
 #include "Misc/RefCounted.h"
 #include "TypesRHI.h"
 
+/**
+ * @ingroup Engine
+ * @brief Size of shader constant buffer
+ */
+#define MAX_GLOBAL_CONSTANT_BUFFER_SIZE			4096
+
+/**
+ * @ingroup Engine
+ * @brief Size of constant buffer ring in each device context
+ */
+#define RHI_CONSTANTBUFFER_RING_SIZE			( 2 * 1024 * 1024 )
+
+/**
+ * @ingroup Engine
+ * @brief Alignment of allocations in constant buffer ring, offset and size of bound range must be multiple of 16 constants
+ */
+#define RHI_CONSTANTBUFFER_RING_ALIGNMENT		256
+
 /**
  * @ingroup Engine
  * @brief Enumeration of resource usage flags for vertex and index buffers
@@ -115,7 +133,10 @@ public:
 	 * @param[in] InStride Stride of struct
 	 * @param[in] InSize Size of buffer
 	 */
-	CBaseIndexBufferRHI( uint32 InUsage, uint32 InStride, uint32 InSize )
+	CBaseIndexBufferRHI( uint32 InUsage, uint32 InStride, uint32 InSize ) :
+		usage( InUsage ),
+		stride( InStride ),
+		size( InSize )
 	{}
 
 	/**
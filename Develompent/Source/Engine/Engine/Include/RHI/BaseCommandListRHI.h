@@ -0,0 +1,55 @@
+/**
+ * @file
+ * @addtogroup Engine Engine
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef BASECOMMANDLISTRHI_H
+#define BASECOMMANDLISTRHI_H
+
+#include "RHI/BaseResourceRHI.h"
+
+/**
+ * @ingroup Engine
+ * @brief Base class of command list RHI
+ *
+ * Command list owns a device context for recording draws. Deferred command list can be recorded on any thread
+ * and its commands are played back on the immediate context by CBaseRHI::ExecuteCommandList.
+ * Not deferred command list records directly to the immediate context, so it must be recorded on the rendering thread in playback order
+ */
+class CBaseCommandListRHI : public CBaseResourceRHI
+{
+public:
+	/**
+	 * @brief Constructor
+	 * @param InDeviceContext	Device context for recording
+	 */
+	CBaseCommandListRHI( class CBaseDeviceContextRHI* InDeviceContext )
+		: deviceContext( InDeviceContext )
+	{}
+
+	/**
+	 * @brief Is deferred command list
+	 * @return Return TRUE if commands are recorded for playback later, else returning FALSE if commands are executed directly
+	 */
+	virtual bool IsDeferred() const
+	{
+		return false;
+	}
+
+	/**
+	 * @brief Get device context for recording
+	 * @return Return device context for recording
+	 */
+	FORCEINLINE class CBaseDeviceContextRHI* GetDeviceContext() const
+	{
+		return deviceContext;
+	}
+
+protected:
+	class CBaseDeviceContextRHI*		deviceContext;		/**< Device context for recording */
+};
+
+#endif // !BASECOMMANDLISTRHI_H
\ No newline at end of file
@@ -9,11 +9,16 @@
 #ifndef BASEDEVICECONTEXTRHI_H
 #define BASEDEVICECONTEXTRHI_H
 
+#include "Misc/EngineGlobals.h"
 #include "RHI/BaseRHI.h"
+#include "RHI/StateCacheRHI.h"
 
 /**
  * @ingroup Engine
  * @brief Base class for work with device context RHI
+ *
+ * Device context shadows bound state and constants, so its Set* methods drop redundant calls before they reach RHI.
+ * RHI must call InvalidateStateCache() when it changes state behind the context (e.g. on begin drawing viewport)
  */
 class CBaseDeviceContextRHI : public CBaseResourceRHI
 {
@@ -41,6 +46,205 @@ public:
 	 * @param[in] InStencilValue Clear the stencil buffer with this value
 	 */
 	virtual void				ClearDepthStencil( SurfaceRHIParamRef_t InSurface, bool InIsClearDepth = true, bool InIsClearStencil = true, float InDepthValue = 1.f, uint8 InStencilValue = 0 ) {}
+
+	/**
+	 * @brief Set bound shader state
+	 * @param InBoundShaderState	Bound shader state
+	 */
+	FORCEINLINE void SetBoundShaderState( BoundShaderStateRHIParamRef_t InBoundShaderState )
+	{
+		if ( UpdateCachedState( stateCache.boundShaderState, InBoundShaderState, SCT_BoundShaderState ) )
+		{
+			GRHI->SetBoundShaderState( this, InBoundShaderState );
+		}
+	}
+
+	/**
+	 * @brief Set rasterizer state
+	 * @param InNewState	New rasterizer state
+	 */
+	FORCEINLINE void SetRasterizerState( RasterizerStateRHIParamRef_t InNewState )
+	{
+		if ( UpdateCachedState( stateCache.rasterizerState, InNewState, SCT_RasterizerState ) )
+		{
+			GRHI->SetRasterizerState( this, InNewState );
+		}
+	}
+
+	/**
+	 * @brief Set depth state
+	 * @param InNewState	New depth state
+	 */
+	FORCEINLINE void SetDepthState( DepthStateRHIParamRef_t InNewState )
+	{
+		if ( UpdateCachedState( stateCache.depthState, InNewState, SCT_DepthState ) )
+		{
+			GRHI->SetDepthState( this, InNewState );
+		}
+	}
+
+	/**
+	 * @brief Set blend state
+	 * @param InNewState	New blend state
+	 */
+	FORCEINLINE void SetBlendState( BlendStateRHIParamRef_t InNewState )
+	{
+		if ( UpdateCachedState( stateCache.blendState, InNewState, SCT_BlendState ) )
+		{
+			GRHI->SetBlendState( this, InNewState );
+		}
+	}
+
+	/**
+	 * @brief Set stencil state
+	 * @param InNewState	New stencil state
+	 */
+	FORCEINLINE void SetStencilState( StencilStateRHIParamRef_t InNewState )
+	{
+		if ( UpdateCachedState( stateCache.stencilState, InNewState, SCT_StencilState ) )
+		{
+			GRHI->SetStencilState( this, InNewState );
+		}
+	}
+
+	/**
+	 * @brief Set sampler state of pixel shader
+	 *
+	 * @param InNewState	New sampler state
+	 * @param InStateIndex	Slot for bind sampler
+	 */
+	FORCEINLINE void SetSamplerState( SamplerStateRHIParamRef_t InNewState, uint32 InStateIndex )
+	{
+		if ( InStateIndex >= STATECACHE_MAX_SLOTS || UpdateCachedState( stateCache.samplerStates[ InStateIndex ], InNewState, SCT_SamplerState ) )
+		{
+			GRHI->SetSamplerState( this, nullptr, InNewState, InStateIndex );
+		}
+	}
+
+	/**
+	 * @brief Set texture of pixel shader
+	 *
+	 * @param InTexture			Texture
+	 * @param InTextureIndex	Slot for bind texture
+	 */
+	FORCEINLINE void SetTextureParameter( TextureRHIParamRef_t InTexture, uint32 InTextureIndex )
+	{
+		if ( InTextureIndex >= STATECACHE_MAX_SLOTS || UpdateCachedState( stateCache.textures[ InTextureIndex ], InTexture, SCT_Texture ) )
+		{
+			GRHI->SetTextureParameter( this, nullptr, InTexture, InTextureIndex );
+		}
+	}
+
+	/**
+	 * @brief Set vertex shader parameter
+	 *
+	 * @param InBufferIndex		Buffer index
+	 * @param InBaseIndex		Offset in bytes to begin parameter
+	 * @param InNumBytes		Number bytes of parameter
+	 * @param InNewValue		New value
+	 */
+	FORCEINLINE void SetVertexShaderParameter( uint32 InBufferIndex, uint32 InBaseIndex, uint32 InNumBytes, const void* InNewValue )
+	{
+		if ( InBufferIndex >= STATECACHE_MAX_CONSTANT_BUFFERS || UpdateCachedConstants( stateCache.vertexShaderConstants[ InBufferIndex ], InBaseIndex, InNumBytes, InNewValue, SCT_VertexShaderConstants ) )
+		{
+			GRHI->SetVertexShaderParameter( this, InBufferIndex, InBaseIndex, InNumBytes, InNewValue );
+		}
+	}
+
+	/**
+	 * @brief Set pixel shader parameter
+	 *
+	 * @param InBufferIndex		Buffer index
+	 * @param InBaseIndex		Offset in bytes to begin parameter
+	 * @param InNumBytes		Number bytes of parameter
+	 * @param InNewValue		New value
+	 */
+	FORCEINLINE void SetPixelShaderParameter( uint32 InBufferIndex, uint32 InBaseIndex, uint32 InNumBytes, const void* InNewValue )
+	{
+		if ( InBufferIndex >= STATECACHE_MAX_CONSTANT_BUFFERS || UpdateCachedConstants( stateCache.pixelShaderConstants[ InBufferIndex ], InBaseIndex, InNumBytes, InNewValue, SCT_PixelShaderConstants ) )
+		{
+			GRHI->SetPixelShaderParameter( this, InBufferIndex, InBaseIndex, InNumBytes, InNewValue );
+		}
+	}
+
+	/**
+	 * @brief Invalidate state cache
+	 * @note After this all next Set* calls go to RHI
+	 */
+	FORCEINLINE void InvalidateStateCache()
+	{
+		stateCache.Invalidate();
+	}
+
+#if !SHIPPING_BUILD
+	/**
+	 * @brief Get statistics of state cache
+	 * @return Return statistics of state cache
+	 */
+	FORCEINLINE SStateCacheStatsRHI& GetStateCacheStats()
+	{
+		return stateCacheStats;
+	}
+#endif // !SHIPPING_BUILD
+
+private:
+	/**
+	 * @brief Update shadowed state
+	 *
+	 * @param InOutCachedState	Shadowed state
+	 * @param InNewState		New state
+	 * @param InType			State kind
+	 * @return Return TRUE if need set state to RHI, else returning FALSE
+	 */
+	template< typename TRHIRefType, typename TRHIParamRefType >
+	FORCEINLINE bool UpdateCachedState( TCachedStateRHI< TRHIRefType >& InOutCachedState, TRHIParamRefType InNewState, EStateCacheTypeRHI InType )
+	{
+		const bool		bNeedSet = InOutCachedState.Update( InNewState );
+#if !SHIPPING_BUILD
+		if ( bNeedSet )
+		{
+			++stateCacheStats.numIssued[ InType ];
+		}
+		else
+		{
+			++stateCacheStats.numFiltered[ InType ];
+		}
+#endif // !SHIPPING_BUILD
+		return bNeedSet;
+	}
+
+	/**
+	 * @brief Update shadowed constants
+	 *
+	 * @param InOutShadow		Shadow copy of constant buffer
+	 * @param InBaseIndex		Offset in bytes to begin parameter
+	 * @param InNumBytes		Number bytes of parameter
+	 * @param InNewValue		New value
+	 * @param InType			State kind
+	 * @return Return TRUE if need set constants to RHI, else returning FALSE
+	 */
+	FORCEINLINE bool UpdateCachedConstants( CConstantBufferShadowRHI& InOutShadow, uint32 InBaseIndex, uint32 InNumBytes, const void* InNewValue, EStateCacheTypeRHI InType )
+	{
+		const bool		bNeedSet = InOutShadow.Update( InBaseIndex, InNumBytes, InNewValue );
+#if !SHIPPING_BUILD
+		if ( bNeedSet )
+		{
+			++stateCacheStats.numIssued[ InType ];
+		}
+		else
+		{
+			++stateCacheStats.numFiltered[ InType ];
+			stateCacheStats.numFilteredConstantBytes += InNumBytes;
+		}
+#endif // !SHIPPING_BUILD
+		return bNeedSet;
+	}
+
+	SStateCacheRHI				stateCache;				/**< State which bound in context */
+
+#if !SHIPPING_BUILD
+	SStateCacheStatsRHI			stateCacheStats;		/**< Statistics of state cache */
+#endif // !SHIPPING_BUILD
 };
 
 #endif // !BASEDEVICECONTEXTRHI_H
@@ -17,6 +17,7 @@
 #include "RHI/BaseSurfaceRHI.h"
 #include "RHI/BaseBufferRHI.h"
 #include "RHI/BaseStateRHI.h"
+#include "RHI/BaseCommandListRHI.h"
 
 /**
  * @ingroup Engine
@@ -182,9 +183,10 @@ public:
 	 * @param[in] InHullShader Hull shader
 	 * @param[in] InDomainShader Domain shader
 	 * @param[in] InGeometryShader Geometry shader
+	 * @param[out] OutIsCreated If not NULL, set to TRUE if bound shader state was created by this call and to FALSE if it was found in history
 	 * @return Pointer to bound shader state
 	 */
-	virtual BoundShaderStateRHIRef_t				CreateBoundShaderState( const tchar* InBoundShaderStateName, VertexDeclarationRHIRef_t InVertexDeclaration, VertexShaderRHIRef_t InVertexShader, PixelShaderRHIRef_t InPixelShader, HullShaderRHIRef_t InHullShader = nullptr, DomainShaderRHIRef_t InDomainShader = nullptr, GeometryShaderRHIRef_t InGeometryShader = nullptr ) { return nullptr; }
+	virtual BoundShaderStateRHIRef_t				CreateBoundShaderState( const tchar* InBoundShaderStateName, VertexDeclarationRHIRef_t InVertexDeclaration, VertexShaderRHIRef_t InVertexShader, PixelShaderRHIRef_t InPixelShader, HullShaderRHIRef_t InHullShader = nullptr, DomainShaderRHIRef_t InDomainShader = nullptr, GeometryShaderRHIRef_t InGeometryShader = nullptr, bool* OutIsCreated = nullptr ) { return nullptr; }
 
 	/**
 	 * @brief Create rasterizer state
@@ -271,6 +273,40 @@ public:
 	 */
 	virtual void								EndDrawingViewport( class CBaseDeviceContextRHI* InDeviceContext, class CBaseViewportRHI* InViewport, bool InIsPresent, bool InLockToVsync ) {}
 
+	/**
+	 * @brief Create command list
+	 * @note Command list can be reused, it is recorded between BeginCommandList and EndCommandList
+	 * 
+	 * @return Return command list, if RHI not support command lists returns NULL
+	 */
+	virtual CommandListRHIRef_t					CreateCommandList() { return nullptr; }
+
+	/**
+	 * @brief Begin recording of command list
+	 * @note Must be called on the rendering thread. Command list inherits current state of immediate context (render targets, viewport, states and view parameters)
+	 * 
+	 * @param[in] InImmediateContext Immediate device context
+	 * @param[in] InCommandList Command list
+	 */
+	virtual void								BeginCommandList( class CBaseDeviceContextRHI* InImmediateContext, CommandListRHIParamRef_t InCommandList ) {}
+
+	/**
+	 * @brief End recording of command list
+	 * @note Must be called on the thread which recorded the command list
+	 * 
+	 * @param[in] InCommandList Command list
+	 */
+	virtual void								EndCommandList( CommandListRHIParamRef_t InCommandList ) {}
+
+	/**
+	 * @brief Execute recorded command list on immediate context
+	 * @note Must be called on the rendering thread. State of immediate context isn't changed by command list
+	 * 
+	 * @param[in] InImmediateContext Immediate device context
+	 * @param[in] InCommandList Command list
+	 */
+	virtual void								ExecuteCommandList( class CBaseDeviceContextRHI* InImmediateContext, CommandListRHIParamRef_t InCommandList ) {}
+
 #if WITH_EDITOR
 	/**
 	 * @brief Compile shader
@@ -581,6 +617,16 @@ public:
 	 */
 	virtual void CopyToResolveTarget( class CBaseDeviceContextRHI* InDeviceContext, SurfaceRHIParamRef_t InSourceSurface, const SResolveParams& InResolveParams ) {}
 
+	/**
+	 * @brief Copies mips which are shared by two textures
+	 * @note Textures must have the same pixel format and full mip chains down to the same smallest mip, so the last mips of both textures have the same size
+	 *
+	 * @param InDeviceContext		Device context
+	 * @param InDestTexture			Destination texture
+	 * @param InSourceTexture		Source texture
+	 */
+	virtual void CopySharedMips( class CBaseDeviceContextRHI* InDeviceContext, Texture2DRHIParamRef_t InDestTexture, Texture2DRHIParamRef_t InSourceTexture ) {}
+
 	/**
 	 * @brief Draw primitive
 	 * 
@@ -622,6 +668,12 @@ public:
 	 */
 	virtual const tchar*						GetRHIName() const				{ return TEXT( "NullRHI" ); }
 
+	/**
+	 * @brief Is null RHI
+	 * @return Return true if RHI doesn't render anything (see CNullRHI), else false
+	 */
+	virtual bool								IsNullRHI() const				{ return false; }
+
 	/**
 	 * @brief Get device context
 	 * @return Pointer to device context
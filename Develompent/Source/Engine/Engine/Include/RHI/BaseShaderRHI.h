@@ -48,6 +48,9 @@ enum EVertexElementType
 	VET_UByte4,			/**< Vector of 4 unsigned bytes */
 	VET_UByte4N,		/**< Vector of 4 unsigned bytes normalized */
 	VET_Color,			/**< Color type */
+	VET_Half2,			/**< Vector of 2 half precision floats */
+	VET_Half4,			/**< Vector of 4 half precision floats */
+	VET_UDec4N,			/**< Vector of 3 unsigned 10 bit and 1 unsigned 2 bit values normalized */
 	VET_Max
 };
 
@@ -0,0 +1,258 @@
+/**
+ * @file
+ * @addtogroup Engine Engine
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef STATECACHERHI_H
+#define STATECACHERHI_H
+
+#include <vector>
+
+#include "Core.h"
+#include "Misc/Types.h"
+#include "RHI/TypesRHI.h"
+#include "RHI/BaseShaderRHI.h"
+#include "RHI/BaseStateRHI.h"
+#include "RHI/BaseSurfaceRHI.h"
+
+/**
+ * @ingroup Engine
+ * @brief Max number of texture and sampler slots which shadowed by state cache, slots above it always go to RHI
+ */
+#define STATECACHE_MAX_SLOTS				16
+
+/**
+ * @ingroup Engine
+ * @brief Max number of constant buffers which shadowed by state cache, buffers above it always go to RHI
+ */
+#define STATECACHE_MAX_CONSTANT_BUFFERS		4
+
+/**
+ * @ingroup Engine
+ * @brief Enumeration of state kinds which filtered by state cache
+ */
+enum EStateCacheTypeRHI
+{
+	SCT_BoundShaderState,		/**< Bound shader state */
+	SCT_RasterizerState,		/**< Rasterizer state */
+	SCT_DepthState,				/**< Depth state */
+	SCT_BlendState,				/**< Blend state */
+	SCT_StencilState,			/**< Stencil state */
+	SCT_SamplerState,			/**< Sampler state */
+	SCT_Texture,				/**< Texture */
+	SCT_VertexShaderConstants,	/**< Vertex shader constants */
+	SCT_PixelShaderConstants,	/**< Pixel shader constants */
+	SCT_Num						/**< Number of state kinds */
+};
+
+/**
+ * @ingroup Engine
+ * @brief Convert state kind to text
+ *
+ * @param InType	State kind
+ * @return Return state kind in text format
+ */
+FORCEINLINE const tchar* StateCacheTypeToText( EStateCacheTypeRHI InType )
+{
+	switch ( InType )
+	{
+	case SCT_BoundShaderState:			return TEXT( "BoundShaderState" );
+	case SCT_RasterizerState:			return TEXT( "RasterizerState" );
+	case SCT_DepthState:				return TEXT( "DepthState" );
+	case SCT_BlendState:				return TEXT( "BlendState" );
+	case SCT_StencilState:				return TEXT( "StencilState" );
+	case SCT_SamplerState:				return TEXT( "SamplerState" );
+	case SCT_Texture:					return TEXT( "Texture" );
+	case SCT_VertexShaderConstants:		return TEXT( "VertexShaderConstants" );
+	case SCT_PixelShaderConstants:		return TEXT( "PixelShaderConstants" );
+	default:							return TEXT( "Unknown" );
+	}
+}
+
+#if !SHIPPING_BUILD
+/**
+ * @ingroup Engine
+ * @brief Statistics of state cache
+ */
+struct SStateCacheStatsRHI
+{
+	/**
+	 * @brief Constructor
+	 */
+	FORCEINLINE SStateCacheStatsRHI()
+	{
+		Reset();
+	}
+
+	/**
+	 * @brief Reset statistics
+	 */
+	FORCEINLINE void Reset()
+	{
+		appMemzero( this, sizeof( SStateCacheStatsRHI ) );
+	}
+
+	/**
+	 * @brief Append statistics of other device context
+	 * @param InOther	Other statistics
+	 */
+	FORCEINLINE void Append( const SStateCacheStatsRHI& InOther )
+	{
+		for ( uint32 index = 0; index < SCT_Num; ++index )
+		{
+			numIssued[ index ]		+= InOther.numIssued[ index ];
+			numFiltered[ index ]	+= InOther.numFiltered[ index ];
+		}
+		numFilteredConstantBytes += InOther.numFilteredConstantBytes;
+	}
+
+	uint32		numIssued[ SCT_Num ];			/**< Number of calls which went to RHI */
+	uint32		numFiltered[ SCT_Num ];			/**< Number of redundant calls which was dropped */
+	uint64		numFilteredConstantBytes;		/**< Number of constant bytes which wasn't copied to RHI */
+};
+#endif // !SHIPPING_BUILD
+
+/**
+ * @ingroup Engine
+ * @brief Shadowed state in the state cache
+ *
+ * Holds reference to the state, so it can't be destroyed and another one allocated at the same address while it is bound
+ */
+template< typename TRHIRefType >
+struct TCachedStateRHI
+{
+	/**
+	 * @brief Constructor
+	 */
+	FORCEINLINE TCachedStateRHI()
+		: bValid( false )
+	{}
+
+	/**
+	 * @brief Update shadowed state
+	 *
+	 * @param InNewState	New state
+	 * @return Return TRUE if state is changed and need to set it to RHI, else returning FALSE
+	 */
+	template< typename TRHIParamRefType >
+	FORCEINLINE bool Update( TRHIParamRefType InNewState )
+	{
+		if ( bValid && state.GetPtr() == InNewState )
+		{
+			return false;
+		}
+
+		state	= InNewState;
+		bValid	= true;
+		return true;
+	}
+
+	/**
+	 * @brief Invalidate shadowed state
+	 */
+	FORCEINLINE void Invalidate()
+	{
+		state	= nullptr;
+		bValid	= false;
+	}
+
+	TRHIRefType		state;		/**< Current state */
+	bool			bValid;		/**< Is state known */
+};
+
+/**
+ * @ingroup Engine
+ * @brief Shadow copy of constant buffer contents
+ */
+class CConstantBufferShadowRHI
+{
+public:
+	/**
+	 * @brief Update shadow copy
+	 *
+	 * @param InBaseIndex	Offset in bytes to begin parameter
+	 * @param InNumBytes	Number bytes of parameter
+	 * @param InNewValue	New value
+	 * @return Return TRUE if contents is changed and need to set it to RHI, else returning FALSE
+	 */
+	FORCEINLINE bool Update( uint32 InBaseIndex, uint32 InNumBytes, const void* InNewValue )
+	{
+		const uint32		endIndex = InBaseIndex + InNumBytes;
+		if ( endIndex > data.size() )
+		{
+			data.resize( endIndex, 0 );
+			validBytes.resize( endIndex, 0 );
+		}
+
+		// Write is redundant only when all bytes of range are known and equal to new value
+		if ( memchr( validBytes.data() + InBaseIndex, 0, InNumBytes ) == nullptr && memcmp( data.data() + InBaseIndex, InNewValue, InNumBytes ) == 0 )
+		{
+			return false;
+		}
+
+		memcpy( data.data() + InBaseIndex, InNewValue, InNumBytes );
+		memset( validBytes.data() + InBaseIndex, 1, InNumBytes );
+		return true;
+	}
+
+	/**
+	 * @brief Invalidate shadow copy
+	 * @note Memory of shadow copy isn't released
+	 */
+	FORCEINLINE void Invalidate()
+	{
+		if ( !validBytes.empty() )
+		{
+			memset( validBytes.data(), 0, validBytes.size() );
+		}
+	}
+
+private:
+	std::vector< byte >		data;			/**< Shadow copy of constant buffer */
+	std::vector< byte >		validBytes;		/**< Flags of known bytes (non zero if byte is known) */
+};
+
+/**
+ * @ingroup Engine
+ * @brief State which bound in device context, it is used for drop redundant calls to RHI
+ */
+struct SStateCacheRHI
+{
+	/**
+	 * @brief Invalidate all shadowed state
+	 */
+	FORCEINLINE void Invalidate()
+	{
+		boundShaderState.Invalidate();
+		rasterizerState.Invalidate();
+		depthState.Invalidate();
+		blendState.Invalidate();
+		stencilState.Invalidate();
+		for ( uint32 index = 0; index < STATECACHE_MAX_SLOTS; ++index )
+		{
+			samplerStates[ index ].Invalidate();
+			textures[ index ].Invalidate();
+		}
+
+		for ( uint32 index = 0; index < STATECACHE_MAX_CONSTANT_BUFFERS; ++index )
+		{
+			vertexShaderConstants[ index ].Invalidate();
+			pixelShaderConstants[ index ].Invalidate();
+		}
+	}
+
+	TCachedStateRHI< BoundShaderStateRHIRef_t >		boundShaderState;										/**< Bound shader state */
+	TCachedStateRHI< RasterizerStateRHIRef_t >		rasterizerState;										/**< Rasterizer state */
+	TCachedStateRHI< DepthStateRHIRef_t >			depthState;												/**< Depth state */
+	TCachedStateRHI< BlendStateRHIRef_t >			blendState;												/**< Blend state */
+	TCachedStateRHI< StencilStateRHIRef_t >			stencilState;											/**< Stencil state */
+	TCachedStateRHI< SamplerStateRHIRef_t >			samplerStates[ STATECACHE_MAX_SLOTS ];					/**< Sampler states of pixel shader */
+	TCachedStateRHI< TextureRHIRef_t >				textures[ STATECACHE_MAX_SLOTS ];						/**< Textures of pixel shader */
+	CConstantBufferShadowRHI						vertexShaderConstants[ STATECACHE_MAX_CONSTANT_BUFFERS ];	/**< Constants of vertex shader */
+	CConstantBufferShadowRHI						pixelShaderConstants[ STATECACHE_MAX_CONSTANT_BUFFERS ];	/**< Constants of pixel shader */
+};
+
+#endif // !STATECACHERHI_H
\ No newline at end of file
@@ -239,4 +239,16 @@ typedef TRefCountPtr< class CBaseStencilStateRHI >		StencilStateRHIRef_t;
  */
 typedef class CBaseStencilStateRHI*						StencilStateRHIParamRef_t;
 
+/**
+ * @ingroup Engine Engine
+ * Reference to command list
+ */
+typedef TRefCountPtr< class CBaseCommandListRHI >		CommandListRHIRef_t;
+
+/**
+ * @ingroup Engine Engine
+ * Pointer to command list
+ */
+typedef class CBaseCommandListRHI*						CommandListRHIParamRef_t;
+
 #endif // !TYPESRHI_H
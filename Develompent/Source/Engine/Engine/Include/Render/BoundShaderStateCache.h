@@ -10,6 +10,7 @@
 #define BOUNDSHADERSTATECACHE_H
 
 #include <unordered_map>
+#include "System/ThreadingBase.h"
 #include "RHI/TypesRHI.h"
 
 /**
@@ -71,6 +72,7 @@ private:
 /**
  * @ingroup Engine
  * @brief A list of the most recently used bound shader states.
+ * @note All methods is thread safe, because bound shader states can be created while recording command lists on rendering worker threads
  */
 class CBoundShaderStateHistory
 {
@@ -83,6 +85,7 @@ public:
 	 */
 	FORCEINLINE void Add( const CBoundShaderStateKey& InKey, BoundShaderStateRHIParamRef_t InBoundShaderState )
 	{
+		CScopeLock		scopeLock( criticalSection );
 		boundShaderStateMap[ InKey ] = InBoundShaderState;
 	}
 
@@ -94,6 +97,7 @@ public:
 	 */
 	FORCEINLINE BoundShaderStateRHIRef_t Find( const CBoundShaderStateKey& InKey ) const
 	{
+		CScopeLock	scopeLock( criticalSection );
 		auto		itBoundShaderState = boundShaderStateMap.find( InKey );
 		if ( itBoundShaderState == boundShaderStateMap.end() )
 		{
@@ -110,6 +114,7 @@ public:
 	 */
 	FORCEINLINE void Remove( const CBoundShaderStateKey& InKey )
 	{
+		CScopeLock		scopeLock( criticalSection );
 		boundShaderStateMap.erase( InKey );
 	}
 
@@ -118,9 +123,21 @@ public:
 	 */
 	FORCEINLINE void RemoveAll()
 	{
+		CScopeLock		scopeLock( criticalSection );
 		boundShaderStateMap.clear();
 	}
 
+	/**
+	 * @brief Get critical section of history
+	 * @note Lock it for find and add bound shader state as one operation
+	 * 
+	 * @return Return critical section of history
+	 */
+	FORCEINLINE CCriticalSection& GetCriticalSection() const
+	{
+		return criticalSection;
+	}
+
 private:
 	/**
 	 * @brief key hasher for using CBoundShaderStateKey in std::unordered_map
@@ -136,7 +153,45 @@ private:
 		}
 	};
 
-	std::unordered_map< CBoundShaderStateKey, BoundShaderStateRHIParamRef_t, SBoundShaderStateKeyHasher >			boundShaderStateMap;
+	std::unordered_map< CBoundShaderStateKey, BoundShaderStateRHIParamRef_t, SBoundShaderStateKeyHasher >			boundShaderStateMap;	/**< Map of bound shader states */
+	mutable CCriticalSection																								criticalSection;		/**< Critical section */
 };
 
+/**
+ * @ingroup Engine
+ * @brief Statistics of bound shader states
+ */
+struct SBoundShaderStateStats
+{
+	/**
+	 * @brief Constructor
+	 */
+	FORCEINLINE SBoundShaderStateStats()
+	{
+		Reset();
+	}
+
+	/**
+	 * @brief Reset statistics
+	 */
+	FORCEINLINE void Reset()
+	{
+		numWarmedUp				= 0;
+		numNotResolved			= 0;
+		numFirstUseCreations	= 0;
+	}
+
+	volatile int32		numWarmedUp;			/**< Number of bound shader states created by warmup at map load */
+	volatile int32		numNotResolved;			/**< Number of items of shader cache skipped by warmup, because shaders or vertex declarations not found */
+	volatile int32		numFirstUseCreations;	/**< Number of bound shader states created by mesh drawing policies on first use, the target is zero */
+};
+
+#if !SHIPPING_BUILD
+/**
+ * @ingroup Engine
+ * @brief Statistics of bound shader states since the last map load (see 'bssstats' console command)
+ */
+extern SBoundShaderStateStats		GBoundShaderStateStats;
+#endif // !SHIPPING_BUILD
+
 #endif // !BOUNDSHADERSTATECACHE_H
\ No newline at end of file
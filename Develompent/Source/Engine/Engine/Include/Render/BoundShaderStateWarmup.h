@@ -0,0 +1,82 @@
+/**
+ * @file
+ * @addtogroup Engine Engine
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef BOUNDSHADERSTATEWARMUP_H
+#define BOUNDSHADERSTATEWARMUP_H
+
+#include <string>
+#include <vector>
+
+#include "Render/Shaders/ShaderCache.h"
+#include "RHI/TypesRHI.h"
+
+/**
+ * @ingroup Engine
+ * @brief Warmup of bound shader states used by cooked map
+ *
+ * Cooker records combinations of vertex factory type and shaders used by each map into the shader cache. At map load they
+ * are created on background thread, so mesh drawing policies find them in history of bound shader states and don't hitch
+ * on first draw. Created bound shader states are held until the next map is loaded, because history doesn't hold references
+ */
+class CBoundShaderStateWarmup
+{
+public:
+	/**
+	 * @brief Constructor
+	 */
+	CBoundShaderStateWarmup();
+
+	/**
+	 * @brief Start warmup of bound shader states used by cooked map
+	 * @note Must be called from game thread after map is loaded. Bound shader states of the previous map are released
+	 *
+	 * @param InMapName		Name of cooked map
+	 */
+	void Start( const std::wstring& InMapName );
+
+	/**
+	 * @brief Wait while warmup is finished
+	 * @note Must be called from game thread
+	 */
+	void Wait();
+
+	/**
+	 * @brief Stop warmup and release all bound shader states
+	 * @note Need call before destroy RHI
+	 */
+	void Shutdown();
+
+private:
+	friend class CBoundShaderStateWarmupThread;
+
+	/**
+	 * @brief Wait while rendering command which starts warmup thread is executed
+	 */
+	void WaitStart();
+
+	/**
+	 * @brief Create bound shader states of all items
+	 * @note Called from warmup thread
+	 */
+	void WarmupItems();
+
+	std::wstring											mapName;				/**< Name of the current map */
+	std::vector< CShaderCache::SBoundShaderStateItem >		items;					/**< Items of shader cache for warmup */
+	std::vector< BoundShaderStateRHIRef_t >					boundShaderStates;		/**< Bound shader states created by warmup */
+	class CRunnableThread*									thread;					/**< Warmup thread */
+	class CBoundShaderStateWarmupThread*					runnable;				/**< Runnable object of warmup thread */
+	volatile bool											bStartPending;			/**< Is rendering command which starts warmup thread not executed yet */
+};
+
+/**
+ * @ingroup Engine
+ * @brief Global warmup of bound shader states
+ */
+extern CBoundShaderStateWarmup		GBoundShaderStateWarmup;
+
+#endif // !BOUNDSHADERSTATEWARMUP_H
\ No newline at end of file
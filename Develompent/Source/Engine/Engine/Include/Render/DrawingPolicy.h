@@ -14,6 +14,78 @@
 #include "Render/VertexFactory/VertexFactory.h"
 #include "Core.h"
 
+/**
+ * @ingroup Engine
+ * @brief Render state which set by last drawing policy in the draw list
+ * 
+ * Draw lists are sorted by state, so neighboring drawing policies often have same shaders, material and vertex factory.
+ * This cache is used for skip redundant state changes between them
+ */
+struct SDrawingPolicyStateCache
+{
+	/**
+	 * @brief Constructor
+	 */
+	FORCEINLINE SDrawingPolicyStateCache()
+		: vertexFactory( nullptr )
+		, rasterizerState( nullptr )
+		, boundShaderState( nullptr )
+		, shaderParametersHash( INVALID_HASH )
+	{}
+
+	class CVertexFactory*				vertexFactory;				/**< Vertex factory */
+	RasterizerStateRHIParamRef_t		rasterizerState;			/**< Rasterizer state */
+	BoundShaderStateRHIParamRef_t		boundShaderState;			/**< Bound shader state */
+	uint64								shaderParametersHash;		/**< Hash of shader parameters (material, vertex factory and shaders) */
+};
+
+#if !SHIPPING_BUILD
+/**
+ * @ingroup Engine
+ * @brief Statistics of state changes in draw lists for one view
+ */
+struct SDrawListStats
+{
+	/**
+	 * @brief Constructor
+	 */
+	FORCEINLINE SDrawListStats()
+	{
+		Reset();
+	}
+
+	/**
+	 * @brief Reset statistics
+	 */
+	FORCEINLINE void Reset()
+	{
+		numDrawingPolicies				= 0;
+		numSorts						= 0;
+		numVertexFactoryChanges			= 0;
+		numRasterizerStateChanges		= 0;
+		numBoundShaderStateChanges		= 0;
+		numShaderParametersChanges		= 0;
+		numSortedInstances				= 0;
+		numDepthPrepassDrawingPolicies	= 0;
+	}
+
+	uint32		numDrawingPolicies;				/**< Number of drawn drawing policies */
+	uint32		numSorts;						/**< Number of sorts of draw lists */
+	uint32		numVertexFactoryChanges;		/**< Number of vertex factory changes */
+	uint32		numRasterizerStateChanges;		/**< Number of rasterizer state changes */
+	uint32		numBoundShaderStateChanges;		/**< Number of bound shader state changes */
+	uint32		numShaderParametersChanges;		/**< Number of shader parameters changes */
+	uint32		numSortedInstances;				/**< Number of mesh instances sorted front to back */
+	uint32		numDepthPrepassDrawingPolicies;	/**< Number of drawn drawing policies in depth pre-pass */
+};
+
+/**
+ * @ingroup Engine
+ * @brief Statistics of draw lists, it is updated in rendering thread (see 'drawliststats' console command)
+ */
+extern SDrawListStats		GDrawListStats;
+#endif // !SHIPPING_BUILD
+
 /**
  * @ingroup Engine
  * The base mesh drawing policy.  Subclasses are used to draw meshes with type-specific context variables.
@@ -59,6 +131,22 @@ public:
 	 */
 	virtual void SetShaderParameters( class CBaseDeviceContextRHI* InDeviceContextRHI );
 
+	/**
+	 * Set render state for drawing, skip state which already set by previous drawing policy
+	 *
+	 * @param[in] InDeviceContextRHI RHI device context
+	 * @param[in,out] InOutStateCache State which set by previous drawing policy
+	 */
+	virtual void SetRenderState( class CBaseDeviceContextRHI* InDeviceContextRHI, SDrawingPolicyStateCache& InOutStateCache );
+
+	/**
+	 * Set shader parameters, skip it if they already set by previous drawing policy
+	 *
+	 * @param[in] InDeviceContextRHI RHI device context
+	 * @param[in,out] InOutStateCache State which set by previous drawing policy
+	 */
+	virtual void SetShaderParameters( class CBaseDeviceContextRHI* InDeviceContextRHI, SDrawingPolicyStateCache& InOutStateCache );
+
 	/**
 	 * @brief Get bound shader state
 	 * @return Return bound shader state of current drawing policy
@@ -111,6 +199,15 @@ public:
 		return vertexFactory;
 	}
 
+	/**
+	 * @brief Get material
+	 * @return Return material
+	 */
+	FORCEINLINE const TAssetHandle<CMaterial>& GetMaterial() const
+	{
+		return material;
+	}
+
 	/**
 	 * @brief Get depth bias
 	 * @return Return depth bias
@@ -0,0 +1,173 @@
+/**
+ * @file
+ * @addtogroup Engine Engine
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef LIGHTCLUSTERING_H
+#define LIGHTCLUSTERING_H
+
+#include <vector>
+
+#include "Math/Math.h"
+
+/**
+ * @ingroup Engine
+ * @brief Number of clusters by X (columns of screen tiles)
+ * @note Must be multiple of 4
+ */
+#define LIGHTCLUSTER_GRID_SIZE_X		16
+
+/**
+ * @ingroup Engine
+ * @brief Number of clusters by Y (rows of screen tiles)
+ */
+#define LIGHTCLUSTER_GRID_SIZE_Y		9
+
+/**
+ * @ingroup Engine
+ * @brief Number of clusters by depth (slices)
+ */
+#define LIGHTCLUSTER_GRID_SIZE_Z		24
+
+/**
+ * @ingroup Engine
+ * @brief Number of clusters in grid
+ */
+#define LIGHTCLUSTER_NUM_CLUSTERS		( LIGHTCLUSTER_GRID_SIZE_X * LIGHTCLUSTER_GRID_SIZE_Y * LIGHTCLUSTER_GRID_SIZE_Z )
+
+/**
+ * @ingroup Engine
+ * @brief Cluster of view frustum
+ */
+struct SLightCluster
+{
+	uint32		firstLight;		/**< Offset of first light in array of light indices */
+	uint32		numLights;		/**< Number of lights in cluster */
+};
+
+/**
+ * @ingroup Engine
+ * @brief Grid of clusters of view frustum with lists of lights affecting each cluster
+ *
+ * The view frustum is split into LIGHTCLUSTER_GRID_SIZE_X x LIGHTCLUSTER_GRID_SIZE_Y screen tiles and
+ * LIGHTCLUSTER_GRID_SIZE_Z depth slices. Slices are exponential for perspective projection and cover only
+ * the depth range occupied by lights. Bounds of clusters are separable by axes, so light spheres are tested
+ * against four columns of tiles at once
+ */
+class CLightClusterGrid
+{
+public:
+	/**
+	 * @brief Constructor
+	 */
+	CLightClusterGrid();
+
+	/**
+	 * @brief Build grid
+	 * Lights out of view frustum are culled, rest of them are binned into clusters
+	 *
+	 * @param InSceneView		Scene view
+	 * @param InLightSpheres	Array of bound spheres of lights in world space (xyz - position, w - radius)
+	 * @param InNumLights		Number of lights
+	 */
+	void Build( const class CSceneView& InSceneView, const Vector4D* InLightSpheres, uint32 InNumLights );
+
+	/**
+	 * @brief Clear grid
+	 */
+	void Clear();
+
+	/**
+	 * @brief Get cluster
+	 *
+	 * @param InX		Column of tile, 0 is left side of screen
+	 * @param InY		Row of tile, 0 is bottom side of screen
+	 * @param InZ		Depth slice, 0 is nearest to camera
+	 * @return Return cluster
+	 */
+	FORCEINLINE const SLightCluster& GetCluster( uint32 InX, uint32 InY, uint32 InZ ) const
+	{
+		check( InX < LIGHTCLUSTER_GRID_SIZE_X && InY < LIGHTCLUSTER_GRID_SIZE_Y && InZ < LIGHTCLUSTER_GRID_SIZE_Z );
+		return clusters[ ( InZ * LIGHTCLUSTER_GRID_SIZE_Y + InY ) * LIGHTCLUSTER_GRID_SIZE_X + InX ];
+	}
+
+	/**
+	 * @brief Get array of light indices
+	 * Clusters refer to ranges of this array, each value is index of light in array passed to Build
+	 *
+	 * @return Return array of light indices
+	 */
+	FORCEINLINE const std::vector<uint32>& GetLightIndices() const
+	{
+		return lightIndices;
+	}
+
+	/**
+	 * @brief Get visible lights
+	 * @return Return array of indices of lights which affect at least one cluster, in order of array passed to Build
+	 */
+	FORCEINLINE const std::vector<uint32>& GetVisibleLights() const
+	{
+		return visibleLights;
+	}
+
+	/**
+	 * @brief Get number of clusters with at least one light
+	 * @return Return number of occupied clusters
+	 */
+	FORCEINLINE uint32 GetNumOccupiedClusters() const
+	{
+		return numOccupiedClusters;
+	}
+
+	/**
+	 * @brief Get depth of near side of slice in view space
+	 *
+	 * @param InZ	Depth slice, LIGHTCLUSTER_GRID_SIZE_Z returns far side of last slice
+	 * @return Return depth of near side of slice
+	 */
+	FORCEINLINE float GetSliceDepth( uint32 InZ ) const
+	{
+		check( InZ <= LIGHTCLUSTER_GRID_SIZE_Z );
+		return sliceDepths[ InZ ];
+	}
+
+private:
+	/**
+	 * @brief Calculate bounds of tiles in each slice
+	 *
+	 * @param InInvProjectionMatrix		Inverse projection matrix
+	 * @param InIsPerspective			Is perspective projection
+	 * @param InNearDepth				Depth of near side of first slice
+	 * @param InFarDepth				Depth of far side of last slice
+	 */
+	void BuildSlices( const Matrix& InInvProjectionMatrix, bool InIsPerspective, float InNearDepth, float InFarDepth );
+
+	/**
+	 * @brief Get slice by depth in view space
+	 *
+	 * @param InDepth		Depth in view space
+	 * @return Return index of slice, it is clamped to the grid
+	 */
+	uint32 GetSliceByDepth( float InDepth ) const;
+
+	bool										bIsPerspective;				/**< Is slices are exponential */
+	float										sliceScale;					/**< Scale of depth (logarithm of depth for perspective) to index of slice */
+	float										sliceBias;					/**< Bias of depth (logarithm of depth for perspective) to index of slice */
+	float										sliceDepths[ LIGHTCLUSTER_GRID_SIZE_Z + 1 ];									/**< Depth of sides of slices */
+	float										columnMin[ LIGHTCLUSTER_GRID_SIZE_Z * LIGHTCLUSTER_GRID_SIZE_X ];				/**< Min X of columns in view space in each slice */
+	float										columnMax[ LIGHTCLUSTER_GRID_SIZE_Z * LIGHTCLUSTER_GRID_SIZE_X ];				/**< Max X of columns in view space in each slice */
+	float										rowMin[ LIGHTCLUSTER_GRID_SIZE_Z * LIGHTCLUSTER_GRID_SIZE_Y ];					/**< Min Y of rows in view space in each slice */
+	float										rowMax[ LIGHTCLUSTER_GRID_SIZE_Z * LIGHTCLUSTER_GRID_SIZE_Y ];					/**< Max Y of rows in view space in each slice */
+	std::vector<SLightCluster>					clusters;					/**< Clusters */
+	std::vector<uint32>							lightIndices;				/**< Indices of lights in clusters */
+	std::vector<uint32>							visibleLights;				/**< Indices of visible lights */
+	std::vector<Vector4D>						viewLights;					/**< Lights in view space (xy - position, z - depth, w - radius), they are kept between builds for avoid allocations */
+	std::vector<uint64>							clusterLightPairs;			/**< Pairs of cluster (high bits) and light (low bits), they are kept between builds for avoid allocations */
+	uint32										numOccupiedClusters;		/**< Number of clusters with lights */
+};
+
+#endif // !LIGHTCLUSTERING_H
\ No newline at end of file
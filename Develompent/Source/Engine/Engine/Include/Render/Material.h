@@ -163,6 +163,21 @@ public:
 		isWireframe = InIsWireframe;
 	}
 
+	/**
+	 * Set masked mode
+	 * 
+	 * @param[in] InIsMasked Enable masked mode
+	 */
+	FORCEINLINE void SetMasked( bool InIsMasked )
+	{
+		if ( isMasked != InIsMasked )
+		{
+			MarkDirty();
+		}
+
+		isMasked = InIsMasked;
+	}
+
 	/**
 	 * Set use material on static meshes
 	 * 
@@ -236,6 +251,14 @@ public:
 		return usage;
 	}
 
+	/**
+	 * Get hashes of vertex factory types which material is used with
+	 * @note Debug vertex factories isn't included
+	 * 
+	 * @param[out] OutVertexFactoryHashes Output array of vertex factory hashes
+	 */
+	void GetUsedVertexFactoryHashes( std::vector< uint64 >& OutVertexFactoryHashes ) const;
+
 	/**
 	 * Get shader
 	 *
@@ -293,6 +316,33 @@ public:
 	 */
 	bool GetVectorParameterValue( const CName& InParameterName, Vector4D& OutValue ) const;
 
+	/**
+	 * Get all scalar parameters
+	 * @return Return map of scalar parameters
+	 */
+	FORCEINLINE const std::unordered_map<CName, float, CName::SHashFunction>& GetScalarParameters() const
+	{
+		return scalarParameters;
+	}
+
+	/**
+	 * Get all vector parameters
+	 * @return Return map of vector parameters
+	 */
+	FORCEINLINE const std::unordered_map<CName, Vector4D, CName::SHashFunction>& GetVectorParameters() const
+	{
+		return vectorParameters;
+	}
+
+	/**
+	 * Get all texture parameters
+	 * @return Return map of texture parameters
+	 */
+	FORCEINLINE const std::unordered_map<CName, TAssetHandle<CTexture2D>, CName::SHashFunction>& GetTextureParameters() const
+	{
+		return textureParameters;
+	}
+
 	/**
 	 * Get dependent assets
 	 * @param OutDependentAssets	Output set of dependent assets
@@ -324,6 +374,17 @@ public:
 		return isWireframe;
 	}
 
+	/**
+	 * Is enabled masked mode
+	 * Pixels of masked material are discarded by alpha of diffuse texture, so it can't be drawn in depth pre-pass
+	 * 
+	 * @return Return true if masked mode enabled, else return false
+	 */
+	FORCEINLINE bool IsMasked() const
+	{
+		return isMasked;
+	}
+
 	const static CName		diffuseTextureParamName;		/**< Name of Diffuse texture parameter */
 	const static CName		normalTextureParamName;			/**< Name of Normal texture parameter */
 	const static CName		metallicTextureParamName;		/**< Name of Metallic texture parameter */
@@ -352,6 +413,7 @@ private:
 	bool																			isNeedUpdateShaderMap;	/**< Is need update shader map */
 	bool																			isTwoSided;				/**< Is two sided material */
 	bool																			isWireframe;			/**< Is wireframe material */
+	bool																			isMasked;				/**< Is masked material */
 	uint32																			usage;					/**< Usage flags (see EMaterialUsage) */
 	MeshShaderMap_t																	shaderMap;				/**< Shader map for material */
 	std::unordered_map<CName, float, CName::SHashFunction>							scalarParameters;		/**< Array scalar parameters */
@@ -0,0 +1,220 @@
+/**
+ * @file
+ * @addtogroup Engine Engine
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef OCCLUSIONCULLING_H
+#define OCCLUSIONCULLING_H
+
+#include <vector>
+
+#include "Math/Math.h"
+#include "Math/Box.h"
+#include "Render/ParallelCommandLists.h"
+
+/**
+ * @ingroup Engine
+ * @brief Width of occlusion depth buffer
+ * @note Must be multiple of OCCLUSION_TILE_SIZE
+ */
+#define OCCLUSION_BUFFER_SIZE_X			256
+
+/**
+ * @ingroup Engine
+ * @brief Height of occlusion depth buffer
+ * @note Must be multiple of OCCLUSION_TILE_SIZE
+ */
+#define OCCLUSION_BUFFER_SIZE_Y			128
+
+/**
+ * @ingroup Engine
+ * @brief Size of tile in hierarchical Z buffer
+ * @note Must be multiple of 4
+ */
+#define OCCLUSION_TILE_SIZE				8
+
+/**
+ * @ingroup Engine
+ * @brief Max number of bands of occlusion buffer, each one is rasterized by own thread
+ */
+#define OCCLUSION_MAX_BANDS				( MAX_RENDERING_WORKER_THREADS + 1 )
+
+/**
+ * @ingroup Engine
+ * @brief Statistics of occlusion culling
+ */
+struct SOcclusionStats
+{
+	/**
+	 * @brief Constructor
+	 */
+	FORCEINLINE SOcclusionStats()
+	{
+		Reset();
+	}
+
+	/**
+	 * @brief Reset statistics
+	 */
+	FORCEINLINE void Reset()
+	{
+		numOccluders			= 0;
+		numOccluderTriangles	= 0;
+		numRasterizedTriangles	= 0;
+		numTested				= 0;
+		numCulled				= 0;
+		rasterizeTime			= 0.0;
+	}
+
+	uint32		numOccluders;				/**< Number of added occluders */
+	uint32		numOccluderTriangles;		/**< Number of triangles in added occluders */
+	uint32		numRasterizedTriangles;		/**< Number of triangles after culling by near plane and screen */
+	uint32		numTested;					/**< Number of tested bound boxes */
+	uint32		numCulled;					/**< Number of occluded bound boxes */
+	double		rasterizeTime;				/**< Time of transform and rasterize occluders in seconds */
+};
+
+#if !SHIPPING_BUILD
+/**
+ * @ingroup Engine
+ * @brief Statistics of occlusion culling of the last built view, it is updated in rendering thread (see 'occlusionstats' console command)
+ */
+extern SOcclusionStats		GOcclusionStats;
+#endif // !SHIPPING_BUILD
+
+/**
+ * @ingroup Engine
+ * @brief Software occlusion buffer
+ *
+ * Occluder meshes are rasterized on CPU into low resolution depth buffer, four pixels at once by SSE. The buffer is
+ * split into horizontal bands which are rasterized in parallel by the rendering worker threads (see ParallelFor). After that hierarchical Z buffer
+ * is built with the farthest depth of each tile, so most of bound boxes are tested by a few tiles only.
+ * The test is conservative: triangles crossing the near plane aren't rasterized and boxes crossing it are always visible
+ */
+class COcclusionBuffer
+{
+public:
+	/**
+	 * @brief Constructor
+	 */
+	COcclusionBuffer();
+
+	/**
+	 * @brief Begin new frame of occlusion buffer
+	 * @param InSceneView	Scene view
+	 */
+	void Begin( const class CSceneView& InSceneView );
+
+	/**
+	 * @brief Add occluder mesh
+	 * @note Arrays of occluder must be valid until Rasterize is called
+	 *
+	 * @param InVerteces		Array of verteces in local space
+	 * @param InIndeces			Array of indeces, each three indeces are triangle
+	 * @param InNumIndeces		Number of indeces
+	 * @param InLocalToWorld	Transform matrix from local to world space
+	 */
+	void AddOccluder( const Vector* InVerteces, const uint32* InIndeces, uint32 InNumIndeces, const Matrix& InLocalToWorld );
+
+	/**
+	 * @brief Rasterize added occluders and build hierarchical Z buffer
+	 */
+	void Rasterize();
+
+	/**
+	 * @brief Is bound box visible
+	 * @note Must be called after Rasterize
+	 *
+	 * @param InBox		Bound box in world space
+	 * @return Return FALSE if box is fully occluded, else returning TRUE
+	 */
+	bool IsVisible( const CBox& InBox );
+
+	/**
+	 * @brief Is occlusion buffer contains occluders
+	 * @return Return TRUE if at least one triangle is rasterized
+	 */
+	FORCEINLINE bool HasOccluders() const
+	{
+		return stats.numRasterizedTriangles > 0;
+	}
+
+	/**
+	 * @brief Get depth of pixel
+	 *
+	 * @param InX	Column of pixel, 0 is left side of screen
+	 * @param InY	Row of pixel, 0 is bottom side of screen
+	 * @return Return depth of pixel in normalized device coordinates, 1 is far plane
+	 */
+	FORCEINLINE float GetDepth( uint32 InX, uint32 InY ) const
+	{
+		check( InX < OCCLUSION_BUFFER_SIZE_X && InY < OCCLUSION_BUFFER_SIZE_Y );
+		return depthBuffer[ InY * OCCLUSION_BUFFER_SIZE_X + InX ];
+	}
+
+	/**
+	 * @brief Get statistics
+	 * @return Return statistics of the current frame
+	 */
+	FORCEINLINE const SOcclusionStats& GetStats() const
+	{
+		return stats;
+	}
+
+private:
+	/**
+	 * @brief Occluder mesh
+	 */
+	struct SOccluder
+	{
+		const Vector*		verteces;			/**< Array of verteces */
+		const uint32*		indeces;			/**< Array of indeces */
+		uint32				numIndeces;			/**< Number of indeces */
+		Matrix				localToClip;		/**< Transform matrix from local to clip space */
+	};
+
+	/**
+	 * @brief Triangle after setup
+	 */
+	struct STriangle
+	{
+		float		edgeA[ 3 ];			/**< Coefficients of X of edge functions */
+		float		edgeB[ 3 ];			/**< Coefficients of Y of edge functions */
+		float		edgeC[ 3 ];			/**< Constants of edge functions */
+		float		depthA;				/**< Coefficient of X of depth plane */
+		float		depthB;				/**< Coefficient of Y of depth plane */
+		float		depthC;				/**< Constant of depth plane */
+		int32		minX;				/**< Min column of pixels */
+		int32		maxX;				/**< Max column of pixels */
+		int32		minY;				/**< Min row of pixels */
+		int32		maxY;				/**< Max row of pixels */
+	};
+
+	/**
+	 * @brief Transform occluders and setup their triangles, triangles are binned into bands
+	 */
+	void SetupTriangles();
+
+	/**
+	 * @brief Rasterize triangles of band and build hierarchical Z buffer for it
+	 * @param InBandIndex	Index of band
+	 */
+	void RasterizeBand( uint32 InBandIndex );
+
+
+	Matrix									viewProjectionMatrix;		/**< View * Projection matrix of the current frame */
+	std::vector<float>						depthBuffer;				/**< Depth buffer in normalized device coordinates */
+	std::vector<float>						hiZBuffer;					/**< The farthest depth of each tile */
+	std::vector<SOccluder>					occluders;					/**< Occluders of the current frame */
+	std::vector<Vector4D>					clipVerteces;				/**< Verteces of occluder in clip space, they are kept between frames for avoid allocations */
+	std::vector<STriangle>					triangles;					/**< Triangles of the current frame, they are kept between frames for avoid allocations */
+	std::vector<uint32>						bandTriangles[ OCCLUSION_MAX_BANDS ];		/**< Indices of triangles overlapped each band */
+	uint32									numBands;					/**< Number of bands */
+	uint32									bandMinY[ OCCLUSION_MAX_BANDS + 1 ];		/**< First row of pixels of each band, the last element is height of buffer */
+	SOcclusionStats							stats;						/**< Statistics of the current frame */
+};
+
+#endif // !OCCLUSIONCULLING_H
\ No newline at end of file
@@ -0,0 +1,182 @@
+/**
+ * @file
+ * @addtogroup Engine Engine
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef PARALLELCOMMANDLISTS_H
+#define PARALLELCOMMANDLISTS_H
+
+#include <vector>
+#include <functional>
+
+#include "Math/Color.h"
+#include "RHI/TypesRHI.h"
+#include "Render/RenderingThread.h"
+
+/**
+ * @ingroup Engine
+ * @brief Max number of rendering worker threads
+ */
+#define MAX_RENDERING_WORKER_THREADS		4
+
+/**
+ * @ingroup Engine
+ * Number of rendering worker threads. It is zero when rendering isn't threaded
+ */
+extern uint32			GNumRenderingWorkerThreads;
+
+/**
+ * @ingroup Engine
+ * IDs of rendering worker threads
+ */
+extern uint32			GRenderingWorkerThreadIds[ MAX_RENDERING_WORKER_THREADS ];
+
+/**
+ * @ingroup Engine
+ * Whether the rendering thread records draws to deferred command lists now
+ */
+extern bool				GIsRecordingCommandLists;
+
+/**
+ * @ingroup Engine
+ * Is current thread is render or rendering worker
+ *
+ * @return True if called from the rendering thread or from the rendering worker thread
+ */
+FORCEINLINE bool IsInParallelRenderingThread()
+{
+	if ( IsInRenderingThread() )
+	{
+		return true;
+	}
+
+	const uint32		threadId = appGetCurrentThreadId();
+	for ( uint32 index = 0; index < GNumRenderingWorkerThreads; ++index )
+	{
+		if ( GRenderingWorkerThreadIds[ index ] == threadId )
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * @ingroup Engine
+ * @brief Set of command lists which recorded in parallel and executed in order of adding
+ *
+ * Each task records own draws to own command list on the rendering worker thread, after that all command lists
+ * are executed on the immediate context in order of adding. When command lists aren't supported by RHI or rendering isn't threaded,
+ * tasks are recorded directly to the immediate context one by one
+ *
+ * <code>
+ *	CParallelCommandListSet		commandListSet( immediateContext );
+ *	commandListSet.Add( TEXT( "Static meshes" ), DEC_STATIC_MESH, [&]( CBaseDeviceContextRHI* InDeviceContext )
+ *	{
+ *		staticMeshDrawList.Draw( InDeviceContext, sceneView );
+ *	} );
+ *	commandListSet.Dispatch();
+ * </code>
+ */
+class CParallelCommandListSet
+{
+public:
+	/**
+	 * @brief Function of task for recording draws
+	 */
+	typedef std::function< void( class CBaseDeviceContextRHI* InDeviceContext ) >		TaskFunction_t;
+
+	/**
+	 * @brief Constructor
+	 * @param InImmediateContext	Immediate device context
+	 */
+	CParallelCommandListSet( class CBaseDeviceContextRHI* InImmediateContext );
+
+	/**
+	 * @brief Add task for recording draws
+	 *
+	 * @param InName				Name of draw event
+	 * @param InColor				Color of draw event
+	 * @param InFunction			Function of task
+	 * @param InIsAllowParallel		Is allowed to record on the rendering worker thread. If FALSE, the task is recorded on the rendering thread
+	 */
+	FORCEINLINE void Add( const tchar* InName, const CColor& InColor, const TaskFunction_t& InFunction, bool InIsAllowParallel = true )
+	{
+		tasks.push_back( STask{ InName, InColor, InFunction, InIsAllowParallel, nullptr } );
+	}
+
+	/**
+	 * @brief Record all tasks and execute them on the immediate context
+	 * @note Must be called from the rendering thread
+	 */
+	void Dispatch();
+
+	/**
+	 * @brief Is parallel recording available
+	 * @return Return TRUE if tasks will be recorded in parallel, else returning FALSE
+	 */
+	static bool IsAvailable();
+
+private:
+	/**
+	 * @brief Task for recording draws
+	 */
+	struct STask
+	{
+		const tchar*			name;				/**< Name of draw event */
+		CColor					color;				/**< Color of draw event */
+		TaskFunction_t			function;			/**< Function of task */
+		bool					bAllowParallel;		/**< Is allowed to record on the rendering worker thread */
+		CommandListRHIRef_t		commandList;		/**< Command list for recording */
+	};
+
+	/**
+	 * @brief Record and execute all tasks one by one on the immediate context
+	 */
+	void DispatchSerial();
+
+	/**
+	 * @brief Record task to own command list
+	 * @param InTask	Task
+	 */
+	static void RecordTask( STask& InTask );
+
+	class CBaseDeviceContextRHI*		immediateContext;		/**< Immediate device context */
+	std::vector< STask >				tasks;					/**< Tasks */
+	std::vector< uint32 >				parallelTasks;			/**< Indices of tasks which recorded on the rendering worker threads */
+};
+
+/**
+ * @ingroup Engine
+ * @brief Function of parallel job, it is called for each index of job
+ */
+typedef std::function< void( uint32 InIndex ) >		ParallelForFunction_t;
+
+/**
+ * @ingroup Engine
+ * Call function for each index in range [0, InNum) on the rendering worker threads and the calling thread
+ * @note When called not from the rendering thread or rendering isn't threaded, indices are processed one by one on the calling thread
+ *
+ * @param InNum			Number of indices
+ * @param InFunction	Function which is called for each index
+ */
+extern void ParallelFor( uint32 InNum, const ParallelForFunction_t& InFunction );
+
+/**
+ * @ingroup Engine
+ * Starts the rendering worker threads
+ * @note Called from StartRenderingThread
+ */
+extern void StartRenderingWorkerThreads();
+
+/**
+ * @ingroup Engine
+ * Stops the rendering worker threads
+ * @note Called from StopRenderingThread
+ */
+extern void StopRenderingWorkerThreads();
+
+#endif // !PARALLELCOMMANDLISTS_H
\ No newline at end of file
@@ -9,7 +9,7 @@
 #ifndef RENDERINGTHREAD_H
 #define RENDERINGTHREAD_H
 
-#include "Containers/RingBuffer.h"
+#include "Containers/ChunkedCommandBuffer.h"
 #include "System/ThreadingBase.h"
 
 /**
@@ -29,7 +29,7 @@ extern uint32			GRenderingThreadId;
  * @ingroup Engine
  * The rendering command queue
  */
-extern CRingBuffer		GRenderCommandBuffer;
+extern CChunkedCommandBuffer		GRenderCommandBuffer;
 
 /**
  * @ingroup Engine
@@ -88,9 +88,9 @@ public:
 	 * Overrload operator of new
 	 * 
 	 * @param[in] InSize Size
-	 * @param[in] InAllocation Allocation context in ring buffer
+	 * @param[in] InAllocation Allocation context in command buffer
 	 */
-	FORCEINLINE void* operator new( size_t InSize, const CRingBuffer::AllocationContext& InAllocation )
+	FORCEINLINE void* operator new( size_t InSize, const CChunkedCommandBuffer::CAllocationContext& InAllocation )
 	{
 		return InAllocation.GetAllocation();
 	}
@@ -99,54 +99,12 @@ public:
 	 * Overrload operator of delete
 	 * 
 	 * @param[in] InPtr Pointer to data
-	 * @param[in] InAllocation Allocation context in ring buffer
+	 * @param[in] InAllocation Allocation context in command buffer
 	 */
-	FORCEINLINE void operator delete( void* InPtr, const CRingBuffer::AllocationContext& InAllocation )
+	FORCEINLINE void operator delete( void* InPtr, const CChunkedCommandBuffer::CAllocationContext& InAllocation )
 	{}
 };
 
-/**
- * @ingroup Engine
- * A rendering command that simply consumes space in the rendering command queue
- */
-class CSkipRenderCommand : public CRenderCommand
-{
-public:
-	/**
-	 * Constructor
-	 * 
-	 * @param[in] InNumSkipBytes Number skip bytes
-	 */
-	CSkipRenderCommand( uint32 InNumSkipBytes );
-
-	/**
-	 * Execute render command
-	 * @return Return size of render command
-	 */
-	virtual uint32 Execute() override;
-
-	/**
-	 * Get size of render command
-	 * @return Return size of render command
-	 */
-	virtual uint32 GetSize() const override;
-
-	/**
-	 * Get TCHAR describe command
-	 * @return return describe command in TCHAR format
-	 */
-	virtual const tchar* DescribeCommand() const override;
-
-	/**
-	 * Get ANSI describe command
-	 * @return return describe command in ANSI format
-	 */
-	virtual const char* DescribeCommandChar() const override;
-
-private:
-	uint32			numSkipBytes;			/**< Number skip bytes */
-};
-
 //
 // Macros for using render commands.
 //
@@ -162,18 +120,7 @@ private:
 	{ \
 		if ( GIsThreadedRendering && !IsInRenderingThread() ) \
 		{ \
-			CRingBuffer::AllocationContext			allocationContext( GRenderCommandBuffer, sizeof( InTypeName ) ); \
-			if ( allocationContext.GetAllocatedSize() < sizeof( InTypeName ) ) \
-			{ \
-				check( allocationContext.GetAllocatedSize() >= sizeof( CSkipRenderCommand ) ); \
-				new( allocationContext ) CSkipRenderCommand( allocationContext.GetAllocatedSize() ); \
-				allocationContext.Commit(); \
-				new( CRingBuffer::AllocationContext( GRenderCommandBuffer, sizeof(InTypeName) ) ) InTypeName InParam; \
-			} \
-			else \
-			{ \
-				new( allocationContext ) InTypeName InParam; \
-			} \
+			new( CChunkedCommandBuffer::CAllocationContext( GRenderCommandBuffer, sizeof( InTypeName ) ) ) InTypeName InParam; \
 		} \
 		else \
 		{ \
@@ -12,18 +12,24 @@
 #include <vector>
 #include <set>
 #include <list>
+#include <unordered_map>
 
+#include "Misc/RadixSort.h"
 #include "Math/Math.h"
 #include "Math/Color.h"
+#include "Math/BVH.h"
 #include "Render/CameraTypes.h"
 #include "Render/Material.h"
 #include "Render/SceneRendering.h"
+#include "Render/ParallelCommandLists.h"
 #include "Render/SceneHitProxyRendering.h"
+#include "Render/SceneDepthRendering.h"
 #include "Render/Frustum.h"
 #include "Render/HitProxies.h"
 #include "Render/BatchedSimpleElements.h"
 #include "Render/RenderingThread.h"
 #include "Render/DynamicMeshBuilder.h"
+#include "Render/OcclusionCulling.h"
 #include "Components/CameraComponent.h"
 #include "Components/PrimitiveComponent.h"
 #include "Components/LightComponent.h"
@@ -75,8 +81,9 @@ public:
 	 * @param InSizeY					Size of viewport by Y
 	 * @param InBackgroundColor			Background color
 	 * @param InShowFlags				Show flags
+	 * @param InViewKey					Unique key of view between frames (see CViewportClient::GetViewKey). If 0, primitives don't keep state for this view
 	 */
-	CSceneView( const Vector& InPosition, const Matrix& InProjectionMatrix, const Matrix& InViewMatrix, float InSizeX, float InSizeY, const CColor& InBackgroundColor, ShowFlags_t InShowFlags );
+	CSceneView( const Vector& InPosition, const Matrix& InProjectionMatrix, const Matrix& InViewMatrix, float InSizeX, float InSizeY, const CColor& InBackgroundColor, ShowFlags_t InShowFlags, uint32 InViewKey = 0 );
 
 	/**
 	 * Screen to world space
@@ -188,6 +195,15 @@ public:
 		return position;
 	}
 
+	/**
+	 * Get view key
+	 * @return Return unique key of view between frames, if 0 the view is transient
+	 */
+	FORCEINLINE uint32 GetViewKey() const
+	{
+		return viewKey;
+	}
+
 private:
 	Matrix			viewMatrix;							/**< View matrix */
 	Matrix			projectionMatrix;					/**< Projection matrix */
@@ -199,6 +215,7 @@ private:
 	ShowFlags_t		showFlags;							/**< Show flags for the view */
 	float			sizeX;								/**< Size X of viewport */
 	float			sizeY;								/**< Size Y of viewport */
+	uint32			viewKey;							/**< Unique key of view between frames */
 };
 
 /**
@@ -372,6 +389,7 @@ public:
 
 		mutable MeshBatchList_t					meshBatchList;			/**< Mesh batch list */
 		mutable TDrawingPolicyType				drawingPolicy;			/**< Drawing policy */
+		mutable CDepthOnlyDrawingPolicy			depthOnlyDrawingPolicy;	/**< Drawing policy of depth pre-pass, it is initialized on first draw in depth pre-pass */
 
 #if WITH_EDITOR
 		CColor									wireframeColor;			/**< Wireframe color */
@@ -435,6 +453,13 @@ public:
 	 */
 	typedef std::unordered_set< DrawingPolicyLinkRef_t, SDrawingPolicyKeyFunc, SDrawingPolicyEqualFunc >		MapDrawData_t;
 
+	/**
+	 * @brief Constructor
+	 */
+	FORCEINLINE CMeshDrawList()
+		: bNeedSort( false )
+	{}
+
 	/**
 	 * @brief Add item
 	 * 
@@ -452,6 +477,7 @@ public:
 		if ( it == meshes.end() )
 		{
 			it = meshes.insert( InDrawingPolicyLink ).first;
+			bNeedSort = true;
 		}
 
 		// Return drawing policy link in SDG
@@ -469,6 +495,7 @@ public:
 		if ( InDrawingPolicyLink->GetRefCount() <= 2 )
 		{
 			meshes.erase( InDrawingPolicyLink );
+			bNeedSort = true;
 		}
 
 		InDrawingPolicyLink = nullptr;
@@ -507,7 +534,7 @@ public:
 	 */
 	FORCEINLINE void Draw( class CBaseDeviceContextRHI* InDeviceContext, const CSceneView& InSceneView )
 	{
-		check( IsInRenderingThread() );
+		check( IsInParallelRenderingThread() );
 
 		// Wireframe drawing available only with editor
 #if WITH_EDITOR
@@ -515,10 +542,17 @@ public:
 		bool													bWireframe = InAllowWireframe && ( InSceneView.GetShowFlags() & SHOW_Wireframe );
 #endif // WITH_EDITOR
 
-		for ( MapDrawData_t::const_iterator it = meshes.begin(), itEnd = meshes.end(); it != itEnd; ++it )
+		// Sort drawing policies by state if draw list is changed
+		if ( bNeedSort )
+		{
+			SortDrawingPolicies();
+		}
+
+		SDrawingPolicyStateCache		stateCache;
+		for ( uint32 index = 0, count = ( uint32 )sortedDrawingPolicies.size(); index < count; ++index )
 		{
 			bool						bIsInitedRenderState	= false;
-			DrawingPolicyLinkRef_t		drawingPolicyLink		= *it;
+			SDrawingPolicyLink*			drawingPolicyLink		= sortedDrawingPolicies[ index ].drawingPolicyLink;
 			CMeshDrawingPolicy*			drawingPolicy			= nullptr;
 
 #if WITH_EDITOR
@@ -548,12 +582,15 @@ public:
 					continue;
 				}
 
-				// If we not initialized render state - do it!
+				// If we not initialized render state - do it! State which is same with previous drawing policy will be skipped
 				if ( !bIsInitedRenderState )
 				{					
-					drawingPolicy->SetRenderState( InDeviceContext );
-					drawingPolicy->SetShaderParameters( InDeviceContext );
+					drawingPolicy->SetRenderState( InDeviceContext, stateCache );
+					drawingPolicy->SetShaderParameters( InDeviceContext, stateCache );
 					bIsInitedRenderState = true;
+#if !SHIPPING_BUILD
+					appInterlockedIncrement( ( int32* )&GDrawListStats.numDrawingPolicies );
+#endif // !SHIPPING_BUILD
 				}
 
 				// Draw mesh batch
@@ -562,7 +599,217 @@ public:
 		}
 	}
 
+	/**
+	 * @brief Draw list only into depth buffer
+	 * @note Meshes with masked or wireframe materials and meshes without position only vertex stream are skipped
+	 *
+	 * @param[in] InDeviceContext Device context
+	 * @param InSceneView Current view of scene
+	 */
+	FORCEINLINE void DrawDepthOnly( class CBaseDeviceContextRHI* InDeviceContext, const CSceneView& InSceneView )
+	{
+		check( IsInParallelRenderingThread() );
+
+		// Sort drawing policies by state if draw list is changed
+		if ( bNeedSort )
+		{
+			SortDrawingPolicies();
+		}
+
+		SDrawingPolicyStateCache		stateCache;
+		for ( uint32 index = 0, count = ( uint32 )sortedDrawingPolicies.size(); index < count; ++index )
+		{
+			bool						bIsInitedRenderState	= false;
+			SDrawingPolicyLink*			drawingPolicyLink		= sortedDrawingPolicies[ index ].drawingPolicyLink;
+			CDepthOnlyDrawingPolicy&	drawingPolicy			= drawingPolicyLink->depthOnlyDrawingPolicy;
+
+			// Vertex factory and material of drawing policy link aren't changed, so depth only drawing policy is initialized once
+			if ( drawingPolicy.GetVertexFactory() != drawingPolicyLink->drawingPolicy.GetVertexFactory() )
+			{
+				drawingPolicy.Init( drawingPolicyLink->drawingPolicy.GetVertexFactory(), drawingPolicyLink->drawingPolicy.GetMaterial(), drawingPolicyLink->drawingPolicy.GetDepthBias() );
+			}
+
+			// If drawing policy is not valid - skip meshes
+			if ( !drawingPolicy.IsValid() )
+			{
+				continue;
+			}
+
+			// Draw all mesh batches
+			for ( MeshBatchList_t::const_iterator itMeshBatch = drawingPolicyLink->meshBatchList.begin(), itMeshBatchEnd = drawingPolicyLink->meshBatchList.end(); itMeshBatch != itMeshBatchEnd; ++itMeshBatch )
+			{
+				// If in mesh batch not exist instance - continue to next step
+				if ( itMeshBatch->numInstances <= 0 )
+				{
+					continue;
+				}
+
+				// If we not initialized render state - do it! State which is same with previous drawing policy will be skipped
+				if ( !bIsInitedRenderState )
+				{
+					drawingPolicy.SetRenderState( InDeviceContext, stateCache );
+					drawingPolicy.SetShaderParameters( InDeviceContext, stateCache );
+					bIsInitedRenderState = true;
+#if !SHIPPING_BUILD
+					appInterlockedIncrement( ( int32* )&GDrawListStats.numDepthPrepassDrawingPolicies );
+#endif // !SHIPPING_BUILD
+				}
+
+				// Draw mesh batch
+				drawingPolicy.Draw( InDeviceContext, *itMeshBatch, InSceneView );
+			}
+		}
+	}
+
+	/**
+	 * @brief Sort instances of each mesh batch front to back
+	 * 
+	 * Order of drawing policies isn't changed (they are sorted by state), but inside of mesh batch near instances
+	 * are drawn first, so pixels of far instances behind them are rejected by depth test before pixel shader
+	 *
+	 * @param InViewPosition	Position of view in world space
+	 */
+	void SortInstances( const Vector& InViewPosition )
+	{
+		for ( MapDrawData_t::const_iterator it = meshes.begin(), itEnd = meshes.end(); it != itEnd; ++it )
+		{
+			DrawingPolicyLinkRef_t		drawingPolicyLink = *it;
+			for ( MeshBatchList_t::const_iterator itMeshBatch = drawingPolicyLink->meshBatchList.begin(), itMeshBatchEnd = drawingPolicyLink->meshBatchList.end(); itMeshBatch != itMeshBatchEnd; ++itMeshBatch )
+			{
+				if ( itMeshBatch->instances.size() > 1 )
+				{
+					SortMeshInstances( *itMeshBatch, InViewPosition );
+				}
+			}
+		}
+	}
+
 private:
+	/**
+	 * @brief Element of sorted array of mesh instances
+	 */
+	struct SSortedMeshInstance
+	{
+		uint64					sortKey;				/**< Sort key (see SortMeshInstances) */
+		uint32					index;					/**< Index of instance in mesh batch */
+	};
+
+	/**
+	 * @brief Sort instances of mesh batch front to back
+	 * 
+	 * Sort key is bits of squared distance from view to origin of instance. Distance isn't negative,
+	 * so order of its bits as unsigned integer is same as order of floats, and only low 32 bits of key are sorted
+	 * 
+	 * @param InMeshBatch		Mesh batch
+	 * @param InViewPosition	Position of view in world space
+	 */
+	void SortMeshInstances( const SMeshBatch& InMeshBatch, const Vector& InViewPosition )
+	{
+		const uint32		numInstances = ( uint32 )InMeshBatch.instances.size();
+		sortedMeshInstances.resize( numInstances );
+		tempSortedMeshInstances.resize( numInstances );
+		for ( uint32 index = 0; index < numInstances; ++index )
+		{
+			const Vector		delta = Vector( InMeshBatch.instances[ index ].transformMatrix[ 3 ] ) - InViewPosition;
+			const float			distanceSquared = SMath::DotVector( delta, delta );
+			uint32				distanceBits = 0;
+			memcpy( &distanceBits, &distanceSquared, sizeof( float ) );
+
+			sortedMeshInstances[ index ].sortKey	= distanceBits;
+			sortedMeshInstances[ index ].index		= index;
+		}
+		appRadixSort64( sortedMeshInstances.data(), tempSortedMeshInstances.data(), numInstances, []( const SSortedMeshInstance& InElement ) { return InElement.sortKey; } );
+
+		// Reorder instances, old array is kept for next sort for avoid allocations
+		tempMeshInstances.clear();
+		tempMeshInstances.reserve( numInstances );
+		for ( uint32 index = 0; index < numInstances; ++index )
+		{
+			tempMeshInstances.push_back( InMeshBatch.instances[ sortedMeshInstances[ index ].index ] );
+		}
+		InMeshBatch.instances.swap( tempMeshInstances );
+
+#if !SHIPPING_BUILD
+		appInterlockedAdd( ( int32* )&GDrawListStats.numSortedInstances, numInstances );
+#endif // !SHIPPING_BUILD
+	}
+
+	/**
+	 * @brief Element of sorted array of drawing policies
+	 */
+	struct SSortedDrawingPolicy
+	{
+		uint64					sortKey;				/**< Sort key (see SortDrawingPolicies) */
+		SDrawingPolicyLink*		drawingPolicyLink;		/**< Drawing policy link, it is owned by meshes */
+	};
+
+	/**
+	 * @brief Get dense ID of state object for sort key
+	 * 
+	 * @param InOutIDs		Map of state objects to IDs
+	 * @param InObject		State object
+	 * @return Return ID of state object
+	 */
+	static FORCEINLINE uint64 GetSortKeyID( std::unordered_map<const void*, uint64>& InOutIDs, const void* InObject )
+	{
+		auto		itID = InOutIDs.find( InObject );
+		if ( itID == InOutIDs.end() )
+		{
+			itID = InOutIDs.insert( std::make_pair( InObject, ( uint64 )InOutIDs.size() ) ).first;
+		}
+		return itID->second;
+	}
+
+	/**
+	 * @brief Sort drawing policies by state
+	 * 
+	 * Each drawing policy gets 64 bit sort key: [bound shader state : 22 bits][material : 21 bits][vertex factory : 21 bits].
+	 * Fields are dense IDs of state objects, so after radix sort drawing policies with the same shaders, material and vertex factory
+	 * are placed next to each other, and most of state changes are skipped in Draw
+	 */
+	void SortDrawingPolicies()
+	{
+		check( IsInParallelRenderingThread() );
+		std::unordered_map<const void*, uint64>		boundShaderStateIDs;
+		std::unordered_map<const void*, uint64>		materialIDs;
+		std::unordered_map<const void*, uint64>		vertexFactoryIDs;
+
+		sortedDrawingPolicies.clear();
+		sortedDrawingPolicies.reserve( meshes.size() );
+		for ( MapDrawData_t::const_iterator it = meshes.begin(), itEnd = meshes.end(); it != itEnd; ++it )
+		{
+			SDrawingPolicyLink*		drawingPolicyLink = it->GetPtr();
+			TDrawingPolicyType&		drawingPolicy = drawingPolicyLink->drawingPolicy;
+
+			// Invalid drawing policies are skipped in Draw, so place them to the end
+			SSortedDrawingPolicy	sortedDrawingPolicy;
+			sortedDrawingPolicy.drawingPolicyLink	= drawingPolicyLink;
+			sortedDrawingPolicy.sortKey				= ( uint64 )-1;
+			if ( drawingPolicy.IsValid() )
+			{
+				uint64		boundShaderStateID	= GetSortKeyID( boundShaderStateIDs, drawingPolicy.GetBoundShaderState().GetPtr() );
+				uint64		materialID			= GetSortKeyID( materialIDs, drawingPolicy.GetMaterial().ToSharedPtr().Get() );
+				uint64		vertexFactoryID		= GetSortKeyID( vertexFactoryIDs, drawingPolicy.GetVertexFactory().GetPtr() );
+				sortedDrawingPolicy.sortKey		= ( Min<uint64>( boundShaderStateID, 0x3FFFFF ) << 42 ) | ( Min<uint64>( materialID, 0x1FFFFF ) << 21 ) | Min<uint64>( vertexFactoryID, 0x1FFFFF );
+			}
+			sortedDrawingPolicies.push_back( sortedDrawingPolicy );
+		}
+
+		tempSortedDrawingPolicies.resize( sortedDrawingPolicies.size() );
+		appRadixSort64( sortedDrawingPolicies.data(), tempSortedDrawingPolicies.data(), ( uint32 )sortedDrawingPolicies.size(), []( const SSortedDrawingPolicy& InElement ) { return InElement.sortKey; } );
+		bNeedSort = false;
+
+#if !SHIPPING_BUILD
+		appInterlockedIncrement( ( int32* )&GDrawListStats.numSorts );
+#endif // !SHIPPING_BUILD
+	}
+
+	bool									bNeedSort;						/**< Is need sort drawing policies before draw. State of drawing policy isn't changed after link, so it is set only by adding or removing items */
+	std::vector<SSortedDrawingPolicy>		sortedDrawingPolicies;			/**< Drawing policies sorted by state */
+	std::vector<SSortedDrawingPolicy>		tempSortedDrawingPolicies;		/**< Temporary array for radix sort */
+	std::vector<SSortedMeshInstance>		sortedMeshInstances;			/**< Sorted instances of mesh batch, it is kept between sorts for avoid allocations */
+	std::vector<SSortedMeshInstance>		tempSortedMeshInstances;		/**< Temporary array for radix sort of instances */
+	std::vector<SMeshInstance>				tempMeshInstances;				/**< Temporary array for reorder instances */
 	MapDrawData_t		meshes;						/**< Map of meshes sorted by materials for draw */
 };
 
@@ -769,6 +1016,24 @@ struct SSceneDepthGroup
 #endif // ENABLE_HITPROXY
 };
 
+/**
+ * @ingroup Engine
+ * @brief Result of ray cast against scene
+ */
+struct SRayCastResult
+{
+	/**
+	 * @brief Constructor
+	 */
+	FORCEINLINE SRayCastResult()
+		: primitive( nullptr )
+		, distance( 0.f )
+	{}
+
+	class CPrimitiveComponent*		primitive;		/**< Hit primitive */
+	float							distance;		/**< Distance of hit in lengths of direction of ray */
+};
+
 /**
  * @ingroup Engine
  * @brief Base implementation of the scene manager
@@ -825,6 +1090,17 @@ public:
 	 * @brief Clear all instances from scene frame
 	 */
 	virtual void ClearView() {}
+
+	/**
+	 * @brief Cast ray against primitives of scene
+	 * 
+	 * @param InOrigin		Origin of ray in world space
+	 * @param InDirection	Direction of ray in world space
+	 * @param OutResult		Output result of the closest hit
+	 * @param InMaxDistance	Max distance of ray in lengths of InDirection
+	 * @return Return TRUE if any primitive is hit
+	 */
+	virtual bool RayCast( const Vector& InOrigin, const Vector& InDirection, SRayCastResult& OutResult, float InMaxDistance = FLT_MAX ) const { return false; }
 };
 
 /**
@@ -834,6 +1110,11 @@ public:
 class CScene : public CBaseScene
 {
 public:
+	/**
+	 * @brief Constructor
+	 */
+	CScene();
+
 	/**
 	 * @brief Destructor
 	 */
@@ -884,6 +1165,19 @@ public:
 	 */
 	virtual void ClearView() override;
 
+	/**
+	 * @brief Cast ray against primitives of scene
+	 * @note Bound boxes of primitives are calculated by CPrimitiveComponent::CalcBounds, so it doesn't wait for rendering thread which updates them while building view.
+	 * BVH of primitives is rebuilt after adding or removing primitives, else it is refitted. Must be called from game thread
+	 *
+	 * @param InOrigin		Origin of ray in world space
+	 * @param InDirection	Direction of ray in world space
+	 * @param OutResult		Output result of the closest hit
+	 * @param InMaxDistance	Max distance of ray in lengths of InDirection
+	 * @return Return TRUE if any primitive is hit
+	 */
+	virtual bool RayCast( const Vector& InOrigin, const Vector& InDirection, SRayCastResult& OutResult, float InMaxDistance = FLT_MAX ) const override;
+
 	/**
 	 * @brief Get depth group
 	 * 
@@ -917,6 +1211,15 @@ public:
 		return frame.visibleLights;
 	}
 
+	/**
+	 * @brief Get statistics of occlusion culling on the current frame
+	 * @return Return statistics of occlusion culling
+	 */
+	FORCEINLINE const SOcclusionStats& GetOcclusionStats() const
+	{
+		return frame.occlusionBuffer.GetStats();
+	}
+
 private:
 	/**
 	 * @brief One frame of the scene
@@ -925,11 +1228,17 @@ private:
 	{
 		SSceneDepthGroup					SDGs[SDG_Max];		/**< Scene depth groups */
 		std::list<LightComponentRef_t>		visibleLights;		/**< List of visible lights */
+		std::vector<CPrimitiveComponent*>	frustumPrimitives;	/**< Primitives in view frustum, they are tested by occlusion buffer */
+		COcclusionBuffer					occlusionBuffer;	/**< Software occlusion buffer */
 	};
 	
 	SSceneFrame								frame;				/**< Scene frame */
 	std::list<PrimitiveComponentRef_t>		primitives;			/**< List of primitives on scene */
 	std::list<LightComponentRef_t>			lights;				/**< List of lights on scene */
+	mutable std::vector<CPrimitiveComponent*>	pickPrimitives;	/**< Primitives in BVH for ray casts, items of BVH are indices in this array */
+	mutable std::vector<CBox>				pickBoxes;			/**< Bound boxes of primitives in BVH, they are kept between ray casts for avoid allocations */
+	mutable CBVH							pickBVH;			/**< BVH of primitives for ray casts */
+	mutable bool							bDirtyPickBVH;		/**< Is need rebuild BVH of primitives */
 };
 
 //
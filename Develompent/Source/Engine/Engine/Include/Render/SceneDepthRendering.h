@@ -0,0 +1,64 @@
+/**
+ * @file
+ * @addtogroup Engine Engine
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef SCENEDEPTHRENDERING_H
+#define SCENEDEPTHRENDERING_H
+
+#include "DrawingPolicy.h"
+#include "Render/Shaders/DepthOnlyShader.h"
+
+/**
+ * @ingroup Engine
+ * Draw policy of depth only pass
+ * 
+ * Meshes are drawn with position only vertex declaration and without pixel shader, so base pass
+ * after this shades only visible pixels. Drawing policy is valid only for opaque not masked materials
+ * and vertex factories with position only stream
+ */
+class CDepthOnlyDrawingPolicy : public CMeshDrawingPolicy
+{
+public:
+	/**
+	 * Initialize mesh drawing policy
+	 *
+	 * @param InVertexFactory	Vertex factory
+	 * @param InMaterial		Material
+	 * @param InDepthBias		Depth bias
+	 */
+	FORCEINLINE void Init( class CVertexFactory* InVertexFactory, const TAssetHandle<CMaterial>& InMaterial, float InDepthBias = 0.f )
+	{
+		InitInternal( InVertexFactory, InMaterial, InDepthBias );
+
+		// Override shaders for depth only rendering. Depth only shader is compiled only for vertex factories with position only vertex declaration
+		vertexShader	= InVertexFactory->GetPositionOnlyDeclaration() ? GShaderManager->FindInstance<CDepthOnlyVertexShader>( InVertexFactory->GetType()->GetHash() ) : nullptr;
+		pixelShader		= nullptr;
+	}
+
+	/**
+	 * Set shader parameters
+	 *
+	 * @param[in] InDeviceContextRHI RHI device context
+	 */
+	virtual void SetShaderParameters( class CBaseDeviceContextRHI* InDeviceContextRHI ) override;
+
+	/**
+	 * @brief Get bound shader state
+	 * @return Return bound shader state of current drawing policy
+	 */
+	virtual BoundShaderStateRHIRef_t GetBoundShaderState() const override;
+
+	/**
+	 * @brief Is valid drawing policy
+	 * @return Return TRUE if drawing policy is valid, else return FALSE
+	 */
+	virtual bool IsValid() const override;
+
+	using CMeshDrawingPolicy::SetShaderParameters;
+};
+
+#endif // !SCENEDEPTHRENDERING_H
\ No newline at end of file
@@ -87,6 +87,13 @@ public:
 	 */
 	void ClearGBufferTargets( class CBaseDeviceContextRHI* InDeviceContextRHI ) const;
 
+	/**
+	 * @brief Begin rendering depth pre-pass
+	 * @note Only scene depth is bound, color targets are unbound
+	 * @param InDeviceContextRHI	Device context RHI
+	 */
+	void BeginRenderingDepthPrepass( class CBaseDeviceContextRHI* InDeviceContextRHI ) const;
+
 	/**
 	 * @brief Resolve light pass depth
 	 */
@@ -16,6 +16,7 @@
 #include "Render/DrawingPolicy.h"
 #include "RHI/BaseViewportRHI.h"
 #include "RHI/TypesRHI.h"
+#include "RHI/StaticStatesRHI.h"
 #include "LEBuild.h"
 
 #if ENABLE_HITPROXY
@@ -75,6 +76,11 @@ public:
 	 */
 	virtual RasterizerStateRHIRef_t GetRasterizerState() const
 	{
+		if ( depthBias == 0.f )
+		{
+			return TStaticRasterizerStateRHI<FM_Wireframe, CM_None>::GetRHI();
+		}
+
 		if ( !rasterizerState )
 		{
 			const SRasterizerStateInitializerRHI		initializer =
@@ -170,6 +176,13 @@ private:
 	 */
 	bool RenderSDG( class CBaseDeviceContextRHI* InDeviceContext, uint32 InSDGIndex );
 
+	/**
+	 * Render depth pre-pass of world static meshes
+	 * 
+	 * @param InDeviceContext	RHI device context
+	 */
+	void RenderDepthPrepass( class CBaseDeviceContextRHI* InDeviceContext );
+
 	/**
 	 * Render lights
 	 * 
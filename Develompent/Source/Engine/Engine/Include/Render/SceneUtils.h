@@ -12,9 +12,11 @@
 #include "LEBuild.h"
 #include "Math/Math.h"
 #include "Math/Color.h"
+#include "Containers/String.h"
 #include "Misc/EngineGlobals.h"
 #include "RHI/BaseRHI.h"
 #include "RHI/BaseDeviceContextRHI.h"
+#include "Render/ParallelCommandLists.h"
 
 // Colors that are defined for a particular mesh type
 // Each event type will be displayed using the defined color
@@ -98,6 +100,12 @@
 #define DEC_DYNAMICELEMENTS		CColor( 238,	153,	26,		255 )
 
 #if FRAME_CAPTURE_MARKERS
+/**
+ * @ingroup Engine
+ * @brief Size in characters of buffer on the stack for formatted draw event names
+ */
+#define DRAW_EVENT_NAME_SIZE		256
+
 /**
  * @ingroup Engine
  * @brief Class for scoped draw event
@@ -112,8 +120,41 @@ public:
 	 * @param InStatId Name event
 	 */
 	FORCEINLINE CScopedDrawEvent( const CColor& InColor, const tchar* InStatId )
+		: bStarted( false )
 	{
-		GRHI->BeginDrawEvent( GRHI->GetImmediateContext(), InColor, InStatId );
+		if ( GEmitDrawEvents )
+		{
+			Start( InColor, InStatId );
+		}
+	}
+
+	/**
+	 * @brief Tag of constructor with formatted name
+	 */
+	struct SFormatted {};
+
+	/**
+	 * @brief Constructor with formatted name
+	 * @note Name is formatted only when draw events is emitted (see GEmitDrawEvents) in buffer on the stack, so this not allocate memory
+	 * 
+	 * @param InTag Tag of constructor with formatted name
+	 * @param InColor Color of event
+	 * @param InFormat Format of event name
+	 * @param ... Other arguments of name
+	 */
+	CScopedDrawEvent( SFormatted InTag, const CColor& InColor, const tchar* InFormat, ... )
+		: bStarted( false )
+	{
+		if ( GEmitDrawEvents )
+		{
+			tchar		name[ DRAW_EVENT_NAME_SIZE ];
+			va_list		arguments;
+			va_start( arguments, InFormat );
+			CString::FormatBuffer( name, DRAW_EVENT_NAME_SIZE, InFormat, arguments );
+			va_end( arguments );
+
+			Start( InColor, name );
+		}
 	}
 
 	/**
@@ -121,14 +162,34 @@ public:
 	 */
 	FORCEINLINE ~CScopedDrawEvent()
 	{
-		GRHI->EndDrawEvent( GRHI->GetImmediateContext() );
+		if ( bStarted )
+		{
+			GRHI->EndDrawEvent( GRHI->GetImmediateContext() );
+		}
 	}
 
-protected:
 	/**
-	 * @brief Constructor
+	 * @brief Start draw event
+	 * 
+	 * @param InColor Color of event
+	 * @param InStatId Name event
 	 */
-	CScopedDrawEvent() {}
+	FORCEINLINE void Start( const CColor& InColor, const tchar* InStatId )
+	{
+		check( !bStarted );
+
+		// Draw events go to the immediate context, so they are skipped while draws are recorded to command lists
+		if ( !IsInRenderingThread() || GIsRecordingCommandLists )
+		{
+			return;
+		}
+
+		GRHI->BeginDrawEvent( GRHI->GetImmediateContext(), InColor, InStatId );
+		bStarted = true;
+	}
+
+private:
+	bool		bStarted;		/**< Is started draw event */
 };
 
 /**
@@ -140,8 +201,21 @@ protected:
  * @param InStatID Stat id
  */
 #define SCOPED_DRAW_EVENT( InEventName, InColor, InStatID )		CScopedDrawEvent event_##InEventName( InColor, InStatID )
+
+/**
+ * @ingroup Engine
+ * @brief Macro for declare scroped draw event with formatted name
+ * @note Name is formatted only when draw events is emitted (see GEmitDrawEvents)
+ * 
+ * @param InEventName Event name
+ * @param InColor Color of event
+ * @param InFormat Format of stat id
+ * @param ... Other arguments of stat id
+ */
+#define SCOPED_DRAW_EVENTF( InEventName, InColor, InFormat, ... )		CScopedDrawEvent event_##InEventName( CScopedDrawEvent::SFormatted(), InColor, InFormat, ##__VA_ARGS__ )
 #else
 #define SCOPED_DRAW_EVENT( InEventName, InColor, InStatID )
+#define SCOPED_DRAW_EVENTF( InEventName, InColor, InFormat, ... )
 #endif // FRAME_CAPTURE_MARKERS
 
 #endif // !SCENEUTILS_H
\ No newline at end of file
@@ -0,0 +1,87 @@
+/**
+ * @file
+ * @addtogroup Engine Engine
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef DEPTHONLYSHADER_H
+#define DEPTHONLYSHADER_H
+
+#include "Shader.h"
+#include "ShaderManager.h"
+
+/**
+ * @ingroup Engine
+ * @brief Class of depth only vertex shader
+ * 
+ * It is compiled with POSITION_ONLY, so vertex factory reads only position of vertex.
+ * Depth only pass doesn't have pixel shader
+ */
+class CDepthOnlyVertexShader : public CShader
+{
+	DECLARE_SHADER_TYPE( CDepthOnlyVertexShader )
+
+public:
+	/**
+	 * @brief Construct a new CDepthOnlyVertexShader object
+	 */
+	CDepthOnlyVertexShader();
+
+	/**
+	 * @brief Destructor of a CDepthOnlyVertexShader object
+	 */
+	virtual ~CDepthOnlyVertexShader();
+
+#if WITH_EDITOR
+	/**
+	 * @brief Is need compile shader for platform
+	 *
+	 * @param InShaderPlatform Shader platform
+	 * @param InVFMetaType Vertex factory meta type. If him is nullptr - return general check
+	 * @return Return true if need compile shader, else returning false
+	 */
+	static bool ShouldCache( EShaderPlatform InShaderPlatform, class CVertexFactoryMetaType* InVFMetaType = nullptr );
+
+	/**
+	 * @brief Modify compilation environment
+	 *
+	 * @param InShaderPlatform Shader platform
+	 * @param InEnvironment Shader compiler environment
+	 */
+	static void ModifyCompilationEnvironment( EShaderPlatform InShaderPlatform, SShaderCompilerEnvironment& InEnvironment );
+#endif // WITH_EDITOR
+
+	/**
+	 * @brief Initialize shader
+	 * @param[in] InShaderCacheItem Cache of shader
+	 */
+	virtual void Init( const CShaderCache::SShaderCacheItem& InShaderCacheItem ) override;
+
+	/**
+	 * @brief Set the constant shader parameters
+	 *
+	 * @param InDeviceContextRHI Device context
+	 * @param InVertexFactory Vertex factory
+	 * @param InMaterialResource Material
+	 */
+	virtual void SetConstantParameters( class CBaseDeviceContextRHI* InDeviceContextRHI, const class CVertexFactory* InVertexFactory, const TSharedPtr<class CMaterial>& InMaterialResource ) const override;
+
+	/**
+	 * @brief Set the l2w transform shader
+	 *
+	 * @param InDeviceContextRHI RHI device context
+	 * @param InMesh Mesh data
+	 * @param InVertexFactory Vertex factory
+	 * @param InView Scene view
+	 * @param InNumInstances Number instances
+	 * @param InStartInstanceID ID of first instance
+	 */
+	virtual void SetMesh( class CBaseDeviceContextRHI* InDeviceContextRHI, const struct SMeshBatch& InMesh, const class CVertexFactory* InVertexFactory, const class CSceneView* InView, uint32 InNumInstances = 1, uint32 InStartInstanceID = 0 ) const override;
+
+private:
+	class CVertexFactoryShaderParameters*	vertexFactoryParameters;	/**< Vertex factory shader parameters */
+};
+
+#endif // !DEPTHONLYSHADER_H
\ No newline at end of file
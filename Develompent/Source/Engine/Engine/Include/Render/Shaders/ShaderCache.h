@@ -13,6 +13,7 @@
 #include <vector>
 #include <unordered_map>
 #include <unordered_set>
+#include <algorithm>
 
 #include "Containers/BulkData.h"
 #include "System/Archive.h"
@@ -126,6 +127,40 @@ public:
 		CShaderParameterMap			parameterMap;		/**< Parameter map */
 	};
 
+	/**
+	 * @brief Struct of bound shader state used by cooked map
+	 * @note Shaders and vertex declaration are resolved by names and vertex factory type at map load
+	 */
+	struct SBoundShaderStateItem
+	{
+		/**
+		 * @brief Overload operator '=='
+		 * @return Return true if items are equal
+		 */
+		FORCEINLINE bool operator==( const SBoundShaderStateItem& InRight ) const
+		{
+			return vertexFactoryHash == InRight.vertexFactoryHash && bPositionOnly == InRight.bPositionOnly && vertexShaderName == InRight.vertexShaderName && pixelShaderName == InRight.pixelShaderName;
+		}
+
+		/**
+		 * @brief Overload operator << for serialize
+		 */
+		FORCEINLINE friend CArchive& operator<<( CArchive& InAr, SBoundShaderStateItem& InItem )
+		{
+			return InAr << InItem.vertexFactoryHash << InItem.vertexShaderName << InItem.pixelShaderName << InItem.bPositionOnly;
+		}
+
+		uint64						vertexFactoryHash;	/**< Vertex factory hash */
+		std::wstring				vertexShaderName;	/**< Name of class vertex shader */
+		std::wstring				pixelShaderName;	/**< Name of class pixel shader, empty for depth only pass */
+		bool						bPositionOnly;		/**< Is used vertex declaration with position only */
+	};
+
+	/**
+	 * @brief Typedef of map of bound shader states by cooked map names
+	 */
+	typedef std::unordered_map< std::wstring, std::vector< SBoundShaderStateItem > >		BoundShaderStateMap_t;
+
 	/**
 	 * @brief Serialize
 	 * @param[in] InArchive Archive
@@ -142,6 +177,30 @@ public:
 		itemsMap[ InShaderCacheItem.vertexFactoryHash ].insert( InShaderCacheItem.name );
 	}
 
+	/**
+	 * @brief Add bound shader state used by cooked map
+	 * 
+	 * @param InMapName		Name of cooked map
+	 * @param InItem		Bound shader state item
+	 */
+	FORCEINLINE void										AddBoundShaderState( const std::wstring& InMapName, const SBoundShaderStateItem& InItem )
+	{
+		std::vector< SBoundShaderStateItem >&		mapItems = boundShaderStates[ InMapName ];
+		if ( std::find( mapItems.begin(), mapItems.end(), InItem ) == mapItems.end() )
+		{
+			mapItems.push_back( InItem );
+		}
+	}
+
+	/**
+	 * @brief Get bound shader states of cooked maps
+	 * @return Return const reference to map of bound shader states by cooked map names
+	 */
+	FORCEINLINE const BoundShaderStateMap_t&				GetBoundShaderStates() const
+	{
+		return boundShaderStates;
+	}
+
 	/**
 	 * @brief Get array of items shader cache
 	 * @return Return const reference to array of items shader cache
@@ -178,6 +237,7 @@ public:
 private:
 	std::vector< SShaderCacheItem >											items;		/**< Array of items shader cache */
 	std::unordered_map< uint64, std::unordered_set< std::wstring > >		itemsMap;	/**< Map of items separated by vertex factory. Need for check on exist in cache */
+	BoundShaderStateMap_t													boundShaderStates;	/**< Bound shader states used by cooked maps */
 };
 
 #endif // !SHADERCACHE_H
@@ -15,6 +15,7 @@
 #include "Misc/Misc.h"
 #include "Misc/EngineGlobals.h"
 #include "RHI/BaseRHI.h"
+#include "RHI/BaseDeviceContextRHI.h"
 #include "Shader.h"
 #include "ShaderCache.h"
 
@@ -228,8 +229,7 @@ FORCEINLINE void SetVertexShaderValue( class CBaseDeviceContextRHI* InDeviceCont
 
     if ( numBytesToSet > 0 )
     {
-        GRHI->SetVertexShaderParameter(
-                    InDeviceContextRHI,
+        InDeviceContextRHI->SetVertexShaderParameter(
                     InParameter.GetBufferIndex(),
                     InParameter.GetBaseIndex() + InElementIndex * alignedTypeSize,
                     ( uint32 )numBytesToSet,
@@ -269,8 +269,7 @@ FORCEINLINE void SetPixelShaderValue( class CBaseDeviceContextRHI* InDeviceConte
 
     if ( numBytesToSet > 0 )
     {
-        GRHI->SetPixelShaderParameter(
-                    InDeviceContextRHI,
+        InDeviceContextRHI->SetPixelShaderParameter(
                     InParameter.GetBufferIndex(),
                     InParameter.GetBaseIndex() + InElementIndex * alignedTypeSize,
                     ( uint32 )numBytesToSet,
@@ -291,7 +290,7 @@ FORCEINLINE void SetTextureParameter( class CBaseDeviceContextRHI* InDeviceConte
 	if ( InParameter.IsBound() )
 	{
 		check( InElementIndex < InParameter.GetNumResources() );
-        GRHI->SetTextureParameter( InDeviceContextRHI, nullptr, InTextureRHI, InParameter.GetBaseIndex() + InElementIndex );
+        InDeviceContextRHI->SetTextureParameter( InTextureRHI, InParameter.GetBaseIndex() + InElementIndex );
 	}
 }
 
@@ -308,7 +307,7 @@ FORCEINLINE void SetSamplerStateParameter( class CBaseDeviceContextRHI* InDevice
 	if ( InParameter.IsBound() )
 	{
         check( InElementIndex < InParameter.GetNumResources() );
-        GRHI->SetSamplerState( InDeviceContextRHI, nullptr, InSamplerStateRHI, InParameter.GetSamplerIndex() + InElementIndex );
+        InDeviceContextRHI->SetSamplerState( InSamplerStateRHI, InParameter.GetSamplerIndex() + InElementIndex );
 	}
 }
 
@@ -539,6 +538,23 @@ public:
         return ( TShaderClass* )FindInstance( TShaderClass::staticType.GetName(), TVertexFactoryClass::staticType.GetHash() );
     }
 
+    /**
+     * @brief Find bound shader states used by cooked map
+     *
+     * @param InMapName Name of cooked map
+     * @return Return pointer to array of bound shader states, if map not found return nullptr
+     */
+    FORCEINLINE const std::vector< CShaderCache::SBoundShaderStateItem >*     FindBoundShaderStates( const std::wstring& InMapName ) const
+    {
+        auto        itBoundShaderStates = boundShaderStates.find( InMapName );
+        if ( itBoundShaderStates == boundShaderStates.end() )
+        {
+            return nullptr;
+        }
+
+        return &itBoundShaderStates->second;
+    }
+
     /**
      * Find shader type by name
      *
@@ -640,7 +656,8 @@ private:
      */
     bool                                                    LoadShaders( const tchar* InPathShaderCache );
 
-    MeshShaderMap_t            shaders;            /**< Map of loaded shaders */
+    MeshShaderMap_t                             shaders;                /**< Map of loaded shaders */
+    CShaderCache::BoundShaderStateMap_t         boundShaderStates;      /**< Bound shader states used by cooked maps */
 };
 
 //
@@ -675,4 +692,3 @@ FORCEINLINE CArchive& operator<<( CArchive& InArchive, const CShaderMetaType*& I
 }
 
 #endif // !TESTSHADER_H
-
@@ -16,6 +16,8 @@
 #include "RenderResource.h"
 #include "Containers/BulkData.h"
 #include "Misc/SharedPointer.h"
+#include "Math/Box.h"
+#include "Math/BVH.h"
 #include "System/Package.h"
 #include "Render/Material.h"
 #include "Render/VertexFactory/StaticMeshVertexFactory.h"
@@ -35,6 +37,18 @@ struct SStaticMeshSurface
 	uint32			numPrimitives;			/**< Number primitives in the surface */
 };
 
+/**
+ * @ingroup Engine
+ * Level of detail in static mesh
+ * 
+ * LOD uses vertex buffer of the mesh, its indeces are stored after indeces of previous LODs
+ */
+struct SStaticMeshLOD
+{
+	float								screenSize;		/**< Max screen size when LOD is used, it is ratio of diameter of projected bound sphere to height of screen */
+	std::vector< SStaticMeshSurface >	surfaces;		/**< Array surfaces in LOD */
+};
+
 /**
  * @ingroup Engine
  * @brief Implementation for static mesh
@@ -80,6 +94,7 @@ public:
 		bool											bDirty;					/**< Is dirty this element */
 		std::vector<DrawingPolicyLinkRef_t>				drawingPolicyLinks;		/**< Array of reference to drawing policy link in scene */
 		std::vector<const SMeshBatch*>					meshBatchLinks;			/**< Array of references to mesh batch in drawing policy link */
+		std::vector<uint32>								lodMeshBatchLinks;		/**< Offset in meshBatchLinks of first mesh batch in each LOD, the last element is number of mesh batch links */
 		uint64											overrideHash;			/**< Hash of overrided segments (custom materials) */
 
 #if ENABLE_HITPROXY
@@ -111,8 +126,9 @@ public:
 	 * @param[in] InIndeces Array mesh indeces
 	 * @param[in] InSurfaces Array surfaces in mesh
 	 * @param[in] InMaterials Array materials in mesh
+	 * @param[in] InLODs Array of LODs after LOD 0, their surfaces refer to InIndeces
 	 */
-	void SetData( const std::vector< SStaticMeshVertexType >& InVerteces, const std::vector< uint32 >& InIndeces, const std::vector< SStaticMeshSurface >& InSurfaces, const std::vector< TAssetHandle<CMaterial> >& InMaterials );
+	void SetData( const std::vector< SStaticMeshVertexType >& InVerteces, const std::vector< uint32 >& InIndeces, const std::vector< SStaticMeshSurface >& InSurfaces, const std::vector< TAssetHandle<CMaterial> >& InMaterials, const std::vector< SStaticMeshLOD >& InLODs = std::vector< SStaticMeshLOD >() );
 
 	/**
 	 * Set material
@@ -122,6 +138,84 @@ public:
 	 */
 	void SetMaterial( uint32 InMaterialIndex, const TAssetHandle<CMaterial>& InNewMaterial );
 
+	/**
+	 * @brief Set format of verteces in vertex buffer
+	 * @param InVertexFormat	Vertex format
+	 */
+	void SetVertexFormat( EStaticMeshVertexFormat InVertexFormat );
+
+	/**
+	 * @brief Get format of verteces in vertex buffer
+	 * @return Return format of verteces in vertex buffer
+	 */
+	FORCEINLINE EStaticMeshVertexFormat GetVertexFormat() const
+	{
+		return vertexFormat;
+	}
+
+	/**
+	 * @brief Calculate precision loss of verteces in current vertex format
+	 * @note Need array of verteces, in game it is removed after creating vertex buffer
+	 * 
+	 * @return Return precision loss of verteces
+	 */
+	SStaticMeshVertexPrecision CalcVertexPrecision() const;
+
+	/**
+	 * @brief Set is mesh used as occluder in software occlusion culling
+	 * @note Need array of verteces, in game it is removed after creating vertex buffer
+	 * 
+	 * @param InIsOccluder	Is mesh occluder
+	 */
+	void SetOccluder( bool InIsOccluder );
+
+	/**
+	 * @brief Is mesh used as occluder in software occlusion culling
+	 * @return Return TRUE if mesh is occluder, else returning FALSE
+	 */
+	FORCEINLINE bool IsOccluder() const
+	{
+		return bOccluder;
+	}
+
+	/**
+	 * @brief Get verteces of occluder
+	 * @return Return positions of verteces used by the coarsest LOD, it is empty if mesh isn't occluder
+	 */
+	FORCEINLINE const std::vector< Vector >& GetOccluderVerteces() const
+	{
+		return occluderVerteces;
+	}
+
+	/**
+	 * @brief Get indeces of occluder
+	 * @return Return indeces of triangles of the coarsest LOD, they refer to GetOccluderVerteces
+	 */
+	FORCEINLINE const std::vector< uint32 >& GetOccluderIndeces() const
+	{
+		return occluderIndeces;
+	}
+
+	/**
+	 * @brief Cast ray against triangles of LOD 0
+	 * @note Need array of verteces, in game it is removed after creating vertex buffer. BVH of triangles is built on the first call
+	 * 
+	 * @param InOrigin			Origin of ray in local space
+	 * @param InDirection		Direction of ray in local space, it may be not normalized
+	 * @param InOutDistance		Max distance of ray in lengths of InDirection, on output the distance of the closest hit
+	 * @return Return TRUE if any triangle is hit closer than InOutDistance, FALSE if not hit or mesh hasn't verteces on CPU
+	 */
+	bool RayCast( const Vector& InOrigin, const Vector& InDirection, float& InOutDistance ) const;
+
+	/**
+	 * @brief Has mesh verteces on CPU for ray casts
+	 * @return Return TRUE if RayCast tests triangles
+	 */
+	FORCEINLINE bool CanRayCastTriangles() const
+	{
+		return verteces.Num() > 0 && GetNumIndeces() > 0;
+	}
+
 	/**
 	 * Get vertex factory
 	 * @return Return vertex factory
@@ -149,6 +243,72 @@ public:
 		return surfaces;
 	}
 
+	/**
+	 * @brief Get number of LODs
+	 * @return Return number of LODs, LOD 0 is surfaces of the mesh
+	 */
+	FORCEINLINE uint32 GetNumLODs() const
+	{
+		return lods.size() + 1;
+	}
+
+	/**
+	 * @brief Get surfaces of LOD
+	 * 
+	 * @param InLODIndex	LOD index
+	 * @return Return array surfaces of LOD
+	 */
+	FORCEINLINE const std::vector< SStaticMeshSurface >& GetLODSurfaces( uint32 InLODIndex ) const
+	{
+		check( InLODIndex < GetNumLODs() );
+		return InLODIndex == 0 ? surfaces : lods[ InLODIndex - 1 ].surfaces;
+	}
+
+	/**
+	 * @brief Get screen size of LOD
+	 * 
+	 * @param InLODIndex	LOD index
+	 * @return Return max screen size when LOD is used
+	 */
+	FORCEINLINE float GetLODScreenSize( uint32 InLODIndex ) const
+	{
+		check( InLODIndex < GetNumLODs() );
+		return InLODIndex == 0 ? 1.f : lods[ InLODIndex - 1 ].screenSize;
+	}
+
+	/**
+	 * @brief Get LOD by screen size
+	 * 
+	 * @param InScreenSize	Ratio of diameter of projected bound sphere to height of screen
+	 * @return Return the coarsest LOD which screen size isn't less than InScreenSize
+	 */
+	FORCEINLINE uint32 GetLODByScreenSize( float InScreenSize ) const
+	{
+		uint32		lodIndex = 0;
+		while ( lodIndex < lods.size() && InScreenSize <= lods[ lodIndex ].screenSize )
+		{
+			++lodIndex;
+		}
+		return lodIndex;
+	}
+
+	/**
+	 * @brief Get number of primitives in LOD
+	 * 
+	 * @param InLODIndex	LOD index
+	 * @return Return number of primitives in all surfaces of LOD
+	 */
+	uint32 GetNumPrimitives( uint32 InLODIndex = 0 ) const;
+
+	/**
+	 * @brief Get bound box
+	 * @return Return bound box of mesh in local space
+	 */
+	FORCEINLINE const CBox& GetBoundBox() const
+	{
+		return boundbox;
+	}
+
 	/**
 	 * Get materials
 	 * @return Return array materials
@@ -211,12 +371,32 @@ public:
 	}
 
 	/**
-	 * @brief Get array of indeces
-	 * @return Return array of indeces
+	 * @brief Get number of indeces
+	 * @return Return number of indeces
+	 */
+	FORCEINLINE uint32 GetNumIndeces() const
+	{
+		return indexStride == sizeof( uint16 ) ? indeces16.Num() : indeces.Num();
+	}
+
+	/**
+	 * @brief Get index
+	 * 
+	 * @param InIndex	Index in array of indeces
+	 * @return Return value of index
 	 */
-	FORCEINLINE const CBulkData<uint32>& GetIndeces() const
+	FORCEINLINE uint32 GetIndex( uint32 InIndex ) const
 	{
-		return indeces;
+		return indexStride == sizeof( uint16 ) ? indeces16.GetElement( InIndex ) : indeces.GetElement( InIndex );
+	}
+
+	/**
+	 * @brief Get size of one index
+	 * @return Return size of one index in bytes, it is sizeof( uint16 ) if all indeces fit into 16 bit, else sizeof( uint32 )
+	 */
+	FORCEINLINE uint32 GetIndexStride() const
+	{
+		return indexStride;
 	}
 
 	/**
@@ -326,6 +506,31 @@ private:
 	 */
 	TSharedPtr<SElementDrawingPolicyLink> MakeDrawingPolicyLink( SSceneDepthGroup& InSDG, uint64 InOverrideHash = 0, std::vector< TAssetHandle<CMaterial> >* InOverrideMaterials = nullptr );
 
+	/**
+	 * @brief Set indeces
+	 * @note Indeces are stored in 16 bit if all of them fit into it
+	 * 
+	 * @param InIndeces			Indeces
+	 * @param InNumIndeces		Number of indeces
+	 */
+	void SetIndeces( const uint32* InIndeces, uint32 InNumIndeces );
+
+	/**
+	 * @brief Calculate bound box by verteces
+	 */
+	void CalcBoundBox();
+
+	/**
+	 * @brief Build occluder from the coarsest LOD
+	 * @note Occluder is kept on CPU, so it is built before verteces are removed in game
+	 */
+	void BuildOccluder();
+
+	/**
+	 * @brief Build BVH of triangles of LOD 0 for ray casts
+	 */
+	void BuildPickBVH() const;
+
 	/**
 	 * @brief Mark dirty all element drawing polices
 	 */
@@ -339,13 +544,24 @@ private:
 	}
 
 	TRefCountPtr< CStaticMeshVertexFactory >	vertexFactory;				/**< Vertex factory */
+	EStaticMeshVertexFormat						vertexFormat;				/**< Format of verteces in vertex buffer */
 	std::vector< TAssetHandle<CMaterial> >		materials;					/**< Array materials in mesh */
 	std::vector< SStaticMeshSurface >			surfaces;					/**< Array surfaces in mesh */
+	std::vector< SStaticMeshLOD >				lods;						/**< Array of LODs after LOD 0 */
+	CBox										boundbox;					/**< Bound box in local space */
 	CBulkData< SStaticMeshVertexType >			verteces;					/**< Array verteces to create RHI vertex buffer */
-	CBulkData< uint32 >							indeces;					/**< Array indeces to create RHI index buffer */
+	CBulkData< uint32 >							indeces;					/**< Array 32-bit indeces to create RHI index buffer, it is used if indexStride is sizeof( uint32 ) */
+	CBulkData< uint16 >							indeces16;					/**< Array 16-bit indeces to create RHI index buffer, it is used if indexStride is sizeof( uint16 ) */
+	uint32										indexStride;				/**< Size of one index in bytes */
 	VertexBufferRHIRef_t						vertexBufferRHI;			/**< RHI vertex buffer */
 	IndexBufferRHIRef_t							indexBufferRHI;				/**< RHI index buffer */
 	ElementDrawingPolicyMap_t					elementDrawingPolicyMap;	/**< Map of adds a drawing policy link to SDGs */
+	bool										bOccluder;					/**< Is mesh used as occluder */
+	std::vector< Vector >						occluderVerteces;			/**< Positions of verteces of occluder */
+	std::vector< uint32 >						occluderIndeces;			/**< Indeces of occluder */
+	mutable std::vector< Vector >				pickTriangles;				/**< Positions of verteces of triangles of LOD 0, three per triangle, items of BVH are indices of triangles */
+	mutable CBVH								pickBVH;					/**< BVH of triangles of LOD 0 for ray casts */
+	mutable bool								bDirtyPickBVH;				/**< Is need rebuild BVH of triangles */
 };
 
 //
@@ -364,6 +580,21 @@ FORCEINLINE CArchive& operator<<( CArchive& InArchive, const SStaticMeshSurface&
 	return InArchive;
 }
 
+FORCEINLINE CArchive& operator<<( CArchive& InArchive, SStaticMeshLOD& InValue )
+{
+	InArchive << InValue.screenSize;
+	InArchive << InValue.surfaces;
+	return InArchive;
+}
+
+FORCEINLINE CArchive& operator<<( CArchive& InArchive, const SStaticMeshLOD& InValue )
+{
+	check( InArchive.IsSaving() );
+	InArchive << InValue.screenSize;
+	InArchive << InValue.surfaces;
+	return InArchive;
+}
+
 FORCEINLINE CArchive& operator<<( CArchive& InArchive, TAssetHandle<CStaticMesh>& InValue )
 {
 	TAssetHandle<CAsset>	asset = InValue;
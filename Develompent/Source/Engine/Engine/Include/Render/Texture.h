@@ -19,6 +19,21 @@
 #include "RHI/BaseStateRHI.h"
 #include "RHI/TypesRHI.h"
 
+/**
+ * @ingroup Engine
+ * @brief Enumeration of texture compression settings
+ */
+enum ETextureCompression
+{
+	TC_None,		/**< Without compression, texture stored in PF_A8R8G8B8 */
+	TC_Default,		/**< BC1 for opaque textures and BC3 for textures with alpha */
+	TC_BC1,			/**< BC1, RGB without alpha (4 bits per texel) */
+	TC_BC3,			/**< BC3, RGBA (8 bits per texel) */
+	TC_BC5,			/**< BC5, only RG channels (8 bits per texel). Used for normal maps */
+	TC_BC7,			/**< BC7, RGBA in high quality (8 bits per texel) */
+	TC_Max			/**< Number of compression settings */
+};
+
 /**
  * @ingroup Engine
  * @brief Implementation for 2D textures
@@ -49,9 +64,19 @@ public:
 	 * @param[in] InPixelFormat Pixel format
 	 * @param[in] InSizeX Width
 	 * @param[in] InSizeY Height
-	 * @param[in] InData Data
+	 * @param[in] InData Data of all mips, they are placed one after another from the top mip
+	 * @param[in] InNumMips Number of mips in data
 	 */
-	void SetData( EPixelFormat InPixelFormat, uint32 InSizeX, uint32 InSizeY, const std::vector< byte >& InData );
+	void SetData( EPixelFormat InPixelFormat, uint32 InSizeX, uint32 InSizeY, const std::vector< byte >& InData, uint32 InNumMips = 1 );
+
+	/**
+	 * Change resident mips of streaming texture
+	 * @note This is only called by the rendering thread. RHI texture is recreated with new mip chain, shared mips are copied on GPU
+	 *
+	 * @param InFirstMip	New first resident mip
+	 * @param InData		Data of added mips from InFirstMip to current first resident mip. If mips are dropped it isn't used
+	 */
+	void StreamMips( uint32 InFirstMip, const byte* InData = nullptr );
 
 	/**
 	 * Set address mod for U coord
@@ -95,6 +120,21 @@ public:
 		samplerFilter = InSamplerFilter;
 	}
 
+	/**
+	 * Set compression settings
+	 * @note Texture data isn't recompressed, new settings is applied on next import
+	 *
+	 * @param InCompression		Compression settings
+	 */
+	FORCEINLINE void SetCompression( ETextureCompression InCompression )
+	{
+		if ( compression != InCompression )
+		{
+			MarkDirty();
+		}
+		compression = InCompression;
+	}
+
 	/**
 	 * Get RHI texture 2D
 	 * @return Return pointer to RHI texture 2D
@@ -131,6 +171,63 @@ public:
 		return sizeY;
 	}
 
+	/**
+	 * Get number of mips
+	 * @return Return number of mips
+	 */
+	FORCEINLINE uint32 GetNumMips() const
+	{
+		return numMips;
+	}
+
+	/**
+	 * Get first resident mip
+	 * @return Return index of first mip which is loaded to RHI texture
+	 */
+	FORCEINLINE uint32 GetFirstResidentMip() const
+	{
+		return firstResidentMip;
+	}
+
+	/**
+	 * Get number of resident mips
+	 * @return Return number of mips which are loaded to RHI texture
+	 */
+	FORCEINLINE uint32 GetNumResidentMips() const
+	{
+		return numMips - firstResidentMip;
+	}
+
+	/**
+	 * Is texture streamable
+	 * @return Return TRUE if mips of texture can be loaded from package on demand
+	 */
+	FORCEINLINE bool IsStreamable() const
+	{
+		return !mipOffsets.empty();
+	}
+
+	/**
+	 * Get path to package for streaming mips
+	 * @return Return path to package
+	 */
+	FORCEINLINE const std::wstring& GetStreamingFilename() const
+	{
+		return streamingFilename;
+	}
+
+	/**
+	 * Get offset of mip in package
+	 *
+	 * @param InMipIndex	Mip index
+	 * @return Return offset of mip data in package
+	 */
+	FORCEINLINE uint32 GetMipOffset( uint32 InMipIndex ) const
+	{
+		check( InMipIndex < mipOffsets.size() );
+		return mipOffsets[ InMipIndex ];
+	}
+
 	/**
 	 * Get address mod for U coord
 	 * @return Return address mode for U coord
@@ -158,6 +255,15 @@ public:
 		return samplerFilter;
 	}
 
+	/**
+	 * Get compression settings
+	 * @return Return compression settings
+	 */
+	FORCEINLINE ETextureCompression GetCompression() const
+	{
+		return compression;
+	}
+
 	/**
 	 * Get sampler state initializer for RHI
 	 * @return Return sampler state initializer
@@ -189,20 +295,47 @@ protected:
 	virtual void ReleaseRHI() override;
 
 private:
+	friend class CTextureStreamingManager;
+
+	/**
+	 * Serialize mips, each mip is stored separately for loading them on demand
+	 * @param InArchive		Archive
+	 */
+	void SerializeMips( class CArchive& InArchive );
+
 	uint32						sizeX;				/**< Width of texture */
 	uint32						sizeY;				/**< Height of texture */
+	uint32						numMips;			/**< Number of mips */
+	uint32						firstResidentMip;	/**< First resident mip, data contains mips from it */
 	CBulkData<byte>				data;				/**< Data used when loading texture */
+	std::wstring				streamingFilename;	/**< Path to package for streaming mips */
+	std::vector< uint32 >		mipOffsets;			/**< Offsets of mips in package, empty if texture isn't streamable */
+	uint32						streamingIndex;		/**< Index of texture in texture streaming manager */
 	EPixelFormat				pixelFormat;		/**< Pixel format of texture */
 	Texture2DRHIRef_t			texture;			/**< Reference to RHI texture */
 	ESamplerAddressMode			addressU;			/**< Address mode for U coord */
 	ESamplerAddressMode			addressV;			/**< Address mode for V coord */
 	ESamplerFilter				samplerFilter;		/**< Sampler filter */
+	ETextureCompression			compression;		/**< Compression settings */
 };
 
 //
 // Serialization
 //
 
+FORCEINLINE CArchive& operator<<( CArchive& InArchive, ETextureCompression& InValue )
+{
+	InArchive.Serialize( &InValue, sizeof( InValue ) );
+	return InArchive;
+}
+
+FORCEINLINE CArchive& operator<<( CArchive& InArchive, const ETextureCompression& InValue )
+{
+	check( InArchive.IsSaving() );
+	InArchive.Serialize( ( void* ) &InValue, sizeof( InValue ) );
+	return InArchive;
+}
+
 FORCEINLINE CArchive& operator<<( CArchive& InArchive, TAssetHandle<CTexture2D>& InValue )
 {
 	TAssetHandle<CAsset>	asset = InValue;
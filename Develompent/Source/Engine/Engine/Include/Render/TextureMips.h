@@ -0,0 +1,72 @@
+/**
+ * @file
+ * @addtogroup Engine Engine
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef TEXTUREMIPS_H
+#define TEXTUREMIPS_H
+
+#include <vector>
+
+#include "Misc/Types.h"
+#include "Misc/Template.h"
+#include "RHI/BaseSurfaceRHI.h"
+
+/**
+ * @ingroup Engine
+ * @brief Calculate size of mip
+ *
+ * @param InSize		Size of top mip
+ * @param InMipIndex	Mip index
+ * @return Return size of mip, it isn't less than 1
+ */
+FORCEINLINE uint32 CalcMipSize( uint32 InSize, uint32 InMipIndex )
+{
+	return Max<uint32>( InSize >> InMipIndex, 1 );
+}
+
+/**
+ * @ingroup Engine
+ * @brief Calculate number of mips in full mip chain
+ *
+ * @param InSizeX	Width of top mip
+ * @param InSizeY	Height of top mip
+ * @return Return number of mips down to 1x1
+ */
+uint32 CalcNumMips( uint32 InSizeX, uint32 InSizeY );
+
+/**
+ * @ingroup Engine
+ * @brief Calculate size in bytes of mip chain
+ * @note Mips are placed one after another from the top mip, size of each mip is rounded up to whole blocks of pixel format
+ *
+ * @param InPixelFormat		Pixel format
+ * @param InSizeX			Width of top mip
+ * @param InSizeY			Height of top mip
+ * @param InNumMips			Number of mips
+ * @return Return size in bytes of mip chain
+ */
+uint32 CalcMipChainSize( EPixelFormat InPixelFormat, uint32 InSizeX, uint32 InSizeY, uint32 InNumMips );
+
+/**
+ * @ingroup Engine
+ * @brief Generate full mip chain from the top mip
+ *
+ * Each mip is downsampled by 2x2 box filter from the previous one. Texels are filtered in linear space and in float precision
+ * for all mip chain, so colors don't darken and don't lose precision on each step.
+ * Supported only PF_A8R8G8B8, for other formats only the top mip is copied
+ *
+ * @param InPixelFormat		Pixel format
+ * @param InSizeX			Width of top mip
+ * @param InSizeY			Height of top mip
+ * @param InData			Data of top mip
+ * @param OutData			Output data of mip chain
+ * @param InIsSRGB			Is color channels stored in sRGB space. If TRUE, they are converted to linear space before filtering
+ * @return Return number of mips in OutData
+ */
+uint32 GenerateMipChain( EPixelFormat InPixelFormat, uint32 InSizeX, uint32 InSizeY, const byte* InData, std::vector< byte >& OutData, bool InIsSRGB = true );
+
+#endif // !TEXTUREMIPS_H
\ No newline at end of file
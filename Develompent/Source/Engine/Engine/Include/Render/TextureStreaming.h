@@ -0,0 +1,254 @@
+/**
+ * @file
+ * @addtogroup Engine Engine
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef TEXTURESTREAMING_H
+#define TEXTURESTREAMING_H
+
+#include <vector>
+
+#include "Misc/RefCounted.h"
+#include "Misc/RefCountPtr.h"
+#include "System/ThreadingBase.h"
+#include "Render/Texture.h"
+
+/**
+ * @ingroup Engine
+ * @brief Statistics of texture streaming
+ */
+struct STextureStreamingStats
+{
+	/**
+	 * @brief Constructor
+	 */
+	FORCEINLINE STextureStreamingStats()
+	{
+		appMemzero( this, sizeof( STextureStreamingStats ) );
+	}
+
+	uint32		numTextures;			/**< Number of streaming textures */
+	uint32		numResidentMips;		/**< Number of resident mips of all streaming textures */
+	uint32		numRequestedMips;		/**< Number of mips which are wanted by visible primitives */
+	uint32		numPendingRequests;		/**< Number of requests in flight */
+	uint32		mipBias;				/**< Number of mips dropped from each texture to fit into budget */
+	uint64		residentSize;			/**< Size in bytes of resident mips */
+	uint64		requestedSize;			/**< Size in bytes of mips which are wanted by visible primitives */
+	uint64		budgetSize;				/**< Size in bytes of memory budget */
+	uint32		numStreamedIn;			/**< Total number of textures which got more mips */
+	uint32		numStreamedOut;			/**< Total number of textures which dropped mips */
+	uint64		totalLoadedSize;		/**< Total size in bytes of loaded mips */
+};
+
+/**
+ * @ingroup Engine
+ * @brief Request of loading mips of a texture from package
+ */
+class CTextureMipsRequest : public CRefCounted
+{
+public:
+	/**
+	 * @brief Constructor
+	 */
+	CTextureMipsRequest()
+		: pixelFormat( PF_Unknown )
+		, sizeX( 0 )
+		, sizeY( 0 )
+		, firstMip( 0 )
+		, numMips( 0 )
+		, bCompleted( false )
+		, bCanceled( false )
+		, bFailed( false )
+	{}
+
+	/**
+	 * @brief Load mips from package
+	 * @note Called by the streaming thread
+	 */
+	void Load();
+
+	std::wstring			filename;		/**< Path to package */
+	std::vector< uint32 >	mipOffsets;		/**< Offsets of loading mips in package */
+	EPixelFormat			pixelFormat;	/**< Pixel format of texture */
+	uint32					sizeX;			/**< Width of first loading mip */
+	uint32					sizeY;			/**< Height of first loading mip */
+	uint32					firstMip;		/**< Index of first loading mip */
+	uint32					numMips;		/**< Number of loading mips */
+	std::vector< byte >		data;			/**< Loaded data of mips */
+	volatile bool			bCompleted;		/**< Is request completed */
+	volatile bool			bCanceled;		/**< Is request canceled, e.g. texture is released */
+	volatile bool			bFailed;		/**< Is loading failed */
+};
+
+/**
+ * @ingroup Engine
+ * @brief Reference to request of loading mips
+ */
+typedef TRefCountPtr< CTextureMipsRequest >			TextureMipsRequestRef_t;
+
+/**
+ * @ingroup Engine
+ * @brief Texture streaming manager
+ *
+ * Keeps resident only mips of textures which are needed by visible primitives. Each frame CScene::BuildView reports projected
+ * screen size of visible primitives, from it the manager calculates wanted mips of their textures. Higher mips are loaded
+ * asynchronously from package by the streaming thread, unused mips are dropped after delay. If wanted mips don't fit
+ * into memory budget, the same number of top mips is dropped from all textures until they are fit.
+ * All methods except Init, Shutdown and Tick are called only by the rendering thread
+ */
+class CTextureStreamingManager
+{
+public:
+	/**
+	 * @brief Constructor
+	 */
+	CTextureStreamingManager();
+
+	/**
+	 * @brief Destructor
+	 */
+	~CTextureStreamingManager();
+
+	/**
+	 * @brief Initialize texture streaming
+	 * Reads settings from section 'Engine.TextureStreaming' of engine config and starts the streaming thread
+	 */
+	void Init();
+
+	/**
+	 * @brief Shutdown texture streaming
+	 */
+	void Shutdown();
+
+	/**
+	 * @brief Update streaming
+	 * @note Called by the game thread, updating is enqueued to the rendering thread
+	 *
+	 * @param InDeltaSeconds	The time since the last tick
+	 */
+	void Tick( float InDeltaSeconds );
+
+	/**
+	 * @brief Add texture to streaming
+	 * @param InTexture		Texture
+	 */
+	void AddTexture( CTexture2D* InTexture );
+
+	/**
+	 * @brief Remove texture from streaming
+	 * @param InTexture		Texture
+	 */
+	void RemoveTexture( CTexture2D* InTexture );
+
+	/**
+	 * @brief Add visible primitive
+	 * Updates wanted mips of textures used by the primitive
+	 *
+	 * @param InPrimitive		Primitive
+	 * @param InSceneView		Scene view
+	 */
+	void AddVisiblePrimitive( class CPrimitiveComponent* InPrimitive, const class CSceneView& InSceneView );
+
+	/**
+	 * @brief Get first mip which will be resident after loading texture
+	 *
+	 * @param InSizeX		Width of texture
+	 * @param InSizeY		Height of texture
+	 * @param InNumMips		Number of mips
+	 * @return Return index of first mip. If streaming is disabled returns 0
+	 */
+	uint32 GetFirstLoadedMip( uint32 InSizeX, uint32 InSizeY, uint32 InNumMips ) const;
+
+	/**
+	 * @brief Is enabled texture streaming
+	 * @return Return TRUE if texture streaming is enabled, else returning FALSE
+	 */
+	FORCEINLINE bool IsEnabled() const
+	{
+		return bEnabled;
+	}
+
+#if !SHIPPING_BUILD
+	/**
+	 * @brief Get statistics
+	 * @return Return statistics of texture streaming
+	 */
+	FORCEINLINE const STextureStreamingStats& GetStats() const
+	{
+		return stats;
+	}
+#endif // !SHIPPING_BUILD
+
+private:
+	/**
+	 * @brief Streaming state of a texture
+	 */
+	struct STextureState
+	{
+		CTexture2D*					texture;			/**< Texture */
+		uint32						wantedMips;			/**< Number of mips wanted by visible primitives in the current frame */
+		uint32						lastWantedMips;		/**< Number of mips wanted by visible primitives in the last frames */
+		float						lastSeenTime;		/**< Time since lastWantedMips was updated */
+		TextureMipsRequestRef_t		request;			/**< Pending request of loading mips */
+	};
+
+	/**
+	 * @brief Update streaming
+	 * @note Called by the rendering thread
+	 *
+	 * @param InDeltaSeconds	The time since the last update
+	 */
+	void UpdateStreaming( float InDeltaSeconds );
+
+	/**
+	 * @brief Finish completed request of loading mips
+	 * @param InState	State of texture
+	 */
+	void FinishRequest( STextureState& InState );
+
+	/**
+	 * @brief Push request to the streaming thread
+	 * @param InRequest		Request
+	 */
+	void PushRequest( CTextureMipsRequest* InRequest );
+
+	/**
+	 * @brief Pop request from queue
+	 * @note Called by the streaming thread
+	 *
+	 * @return Return request, if queue is empty returns NULL
+	 */
+	TextureMipsRequestRef_t PopRequest();
+
+	/**
+	 * @brief Calculate size of resident mips of texture
+	 *
+	 * @param InTexture		Texture
+	 * @param InNumMips		Number of resident mips
+	 * @return Return size in bytes
+	 */
+	static uint32 CalcResidentSize( const CTexture2D* InTexture, uint32 InNumMips );
+
+	friend class CTextureStreamingThread;
+
+	bool											bEnabled;				/**< Is texture streaming enabled */
+	uint64											budgetSize;				/**< Memory budget in bytes for streaming textures */
+	uint32											minResidentMipSize;		/**< Mips with this size and lower are always resident */
+	float											dropDelay;				/**< Delay in seconds before drop mips of not visible textures */
+	std::vector< STextureState >					textures;				/**< Streaming textures */
+	std::vector< TAssetHandle<class CMaterial> >	usedMaterials;			/**< Temporary array of materials used by primitive */
+	std::vector< TextureMipsRequestRef_t >			queue;					/**< Queue of requests for the streaming thread */
+	CCriticalSection								queueCriticalSection;	/**< Critical section of queue */
+	class CEvent*									queueEvent;				/**< Event of new request in queue */
+	class CRunnableThread*							thread;					/**< Streaming thread */
+	class CTextureStreamingThread*					threadRunnable;			/**< Runnable object of streaming thread */
+
+#if !SHIPPING_BUILD
+	STextureStreamingStats							stats;					/**< Statistics */
+#endif // !SHIPPING_BUILD
+};
+
+#endif // !TEXTURESTREAMING_H
\ No newline at end of file
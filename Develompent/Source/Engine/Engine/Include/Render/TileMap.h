@@ -0,0 +1,178 @@
+/**
+ * @file
+ * @addtogroup Engine Engine
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef TILEMAP_H
+#define TILEMAP_H
+
+#include <vector>
+
+#include "RenderResource.h"
+#include "Math/Box.h"
+#include "Math/Rect.h"
+#include "Misc/RefCounted.h"
+#include "Misc/RefCountPtr.h"
+#include "Containers/BulkData.h"
+#include "Render/VertexFactory/SpriteVertexFactory.h"
+#include "RHI/BaseBufferRHI.h"
+#include "RHI/TypesRHI.h"
+
+/**
+ * @ingroup Engine
+ * @brief Number of tiles by each axis in one chunk of tile map
+ */
+#define TILEMAP_CHUNK_SIZE			16
+
+/**
+ * @ingroup Engine
+ * @brief Reference to chunk of tile map
+ */
+typedef TRefCountPtr< class CTileMapChunk >				TileMapChunkRef_t;
+
+/**
+ * @ingroup Engine
+ * @brief Tile in tile map
+ */
+struct STileMapTile
+{
+	uint32			x;					/**< Coord by X in tiles */
+	uint32			y;					/**< Coord by Y in tiles */
+	uint32			layer;				/**< Layer of tile, it is coord by Z */
+	uint32			materialIndex;		/**< Index of material in tile map */
+	Vector2D		size;				/**< Size of tile */
+	RectFloat_t		textureRect;		/**< Texture rect */
+};
+
+/**
+ * @ingroup Engine
+ * @brief Surface in chunk of tile map, all tiles of the surface use one material
+ */
+struct STileMapSurface
+{
+	uint32			materialIndex;		/**< Index of material in tile map */
+	uint32			firstIndex;			/**< First index */
+	uint32			numPrimitives;		/**< Number primitives in the surface */
+};
+
+/**
+ * @ingroup Engine
+ * @brief Chunk of tile map
+ *
+ * Contains prebuilt geometry of up to TILEMAP_CHUNK_SIZE x TILEMAP_CHUNK_SIZE tiles of one layer. Verteces have final
+ * positions and texture coords of tiles, so chunk is drawn by sprite vertex factory with default parameters in one draw call per material
+ */
+class CTileMapChunk : public CRenderResource, public CRefCounted
+{
+public:
+	/**
+	 * @brief Constructor
+	 */
+	CTileMapChunk();
+
+	/**
+	 * @brief Serialize
+	 * @param InArchive		Archive
+	 */
+	void Serialize( class CArchive& InArchive );
+
+	/**
+	 * @brief Build geometry of chunk from tiles
+	 *
+	 * @param InTiles		Tiles of chunk
+	 * @param InTileSize	Size of tile in tile map
+	 */
+	void SetTiles( const std::vector< STileMapTile >& InTiles, const Vector2D& InTileSize );
+
+	/**
+	 * @brief Get surfaces
+	 * @return Return array of surfaces
+	 */
+	FORCEINLINE const std::vector< STileMapSurface >& GetSurfaces() const
+	{
+		return surfaces;
+	}
+
+	/**
+	 * @brief Get bound box in local space of tile map
+	 * @return Return bound box of chunk
+	 */
+	FORCEINLINE const CBox& GetBoundBox() const
+	{
+		return boundbox;
+	}
+
+	/**
+	 * @brief Get number of tiles
+	 * @return Return number of tiles in chunk
+	 */
+	FORCEINLINE uint32 GetNumTiles() const
+	{
+		return numTiles;
+	}
+
+	/**
+	 * @brief Get vertex factory
+	 * @return Return vertex factory
+	 */
+	FORCEINLINE TRefCountPtr< CSpriteVertexFactory > GetVertexFactory() const
+	{
+		return vertexFactory;
+	}
+
+	/**
+	 * @brief Get RHI index buffer
+	 * @return Return RHI index buffer, if not created return nullptr
+	 */
+	FORCEINLINE IndexBufferRHIRef_t GetIndexBufferRHI() const
+	{
+		return indexBufferRHI;
+	}
+
+protected:
+	/**
+	 * @brief Initializes the RHI resources used by this resource.
+	 * Called when the resource is initialized.
+	 * This is only called by the rendering thread.
+	 */
+	virtual void InitRHI() override;
+
+	/**
+	 * @brief Releases the RHI resources used by this resource.
+	 * Called when the resource is released.
+	 * This is only called by the rendering thread.
+	 */
+	virtual void ReleaseRHI() override;
+
+private:
+	TRefCountPtr< CSpriteVertexFactory >		vertexFactory;		/**< Vertex factory */
+	CBulkData< SSpriteVertexType >				verteces;			/**< Array verteces to create RHI vertex buffer */
+	CBulkData< uint16 >							indeces;			/**< Array indeces to create RHI index buffer */
+	std::vector< STileMapSurface >				surfaces;			/**< Array surfaces in chunk */
+	CBox										boundbox;			/**< Bound box in local space of tile map */
+	uint32										numTiles;			/**< Number of tiles */
+	VertexBufferRHIRef_t						vertexBufferRHI;	/**< RHI vertex buffer */
+	IndexBufferRHIRef_t							indexBufferRHI;		/**< RHI index buffer */
+};
+
+//
+// Serialization
+//
+
+FORCEINLINE CArchive& operator<<( CArchive& InArchive, STileMapSurface& InValue )
+{
+	InArchive.Serialize( &InValue, sizeof( STileMapSurface ) );
+	return InArchive;
+}
+
+FORCEINLINE CArchive& operator<<( CArchive& InArchive, const STileMapSurface& InValue )
+{
+	check( InArchive.IsSaving() );
+	InArchive.Serialize( ( void* ) &InValue, sizeof( STileMapSurface ) );
+	return InArchive;
+}
+
+#endif // !TILEMAP_H
\ No newline at end of file
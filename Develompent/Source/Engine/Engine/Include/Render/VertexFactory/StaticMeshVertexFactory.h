@@ -38,6 +38,86 @@ struct SStaticMeshVertexType
 	}
 };
 
+/**
+ * @ingroup Engine
+ * Formats of static mesh verteces in vertex buffer
+ */
+enum EStaticMeshVertexFormat
+{
+	SMVF_Float,			/**< Full precision SStaticMeshVertexType, 72 bytes */
+	SMVF_Packed,		/**< SStaticMeshPackedVertexType with float position, 24 bytes */
+	SMVF_PackedHalf,	/**< SStaticMeshPackedHalfVertexType with half position, 20 bytes */
+	SMVF_Max
+};
+
+/**
+ * @ingroup Engine
+ * Packed vertex type for static mesh with float position
+ * @note Normal and tangent are stored in 10:10:10:2, sign of binormal is stored in W of tangent. Binormal is restored in shader
+ */
+struct SStaticMeshPackedVertexType
+{
+	Vector		position;			/**< Position vertex */
+	uint32		normal;				/**< Normal in 10:10:10:2 */
+	uint32		tangent;			/**< Tangent in 10:10:10:2, W is sign of binormal */
+	uint16		texCoord[ 2 ];		/**< Texture coords in half precision */
+};
+
+/**
+ * @ingroup Engine
+ * Packed vertex type for static mesh with half position
+ * @note Suitable for small meshes placed near origin, precision of position is 11 bits of mantissa
+ */
+struct SStaticMeshPackedHalfVertexType
+{
+	uint16		position[ 4 ];		/**< Position vertex in half precision, W is 1 */
+	uint32		normal;				/**< Normal in 10:10:10:2 */
+	uint32		tangent;			/**< Tangent in 10:10:10:2, W is sign of binormal */
+	uint16		texCoord[ 2 ];		/**< Texture coords in half precision */
+};
+
+/**
+ * @ingroup Engine
+ * Precision loss of packed static mesh verteces
+ */
+struct SStaticMeshVertexPrecision
+{
+	float		maxPositionError;		/**< Max error of position */
+	float		maxNormalError;			/**< Max error of normal direction in degrees */
+	float		maxTangentError;		/**< Max error of tangent direction in degrees */
+	float		maxTexCoordError;		/**< Max error of texture coords */
+};
+
+/**
+ * @ingroup Engine
+ * Get size of vertex in format
+ *
+ * @param InVertexFormat	Vertex format
+ * @return Return size of vertex in bytes
+ */
+uint32 GetStaticMeshVertexStride( EStaticMeshVertexFormat InVertexFormat );
+
+/**
+ * @ingroup Engine
+ * Convert static mesh vertex format to text
+ *
+ * @param InVertexFormat	Vertex format
+ * @return Return name of vertex format
+ */
+const tchar* StaticMeshVertexFormatToText( EStaticMeshVertexFormat InVertexFormat );
+
+/**
+ * @ingroup Engine
+ * Pack static mesh verteces to vertex format
+ *
+ * @param InVertexFormat	Vertex format
+ * @param InVerteces		Verteces in full precision
+ * @param InNumVerteces		Number of verteces
+ * @param OutData			Output data, must be InNumVerteces * GetStaticMeshVertexStride( InVertexFormat ) bytes
+ * @param OutPrecision		Output precision loss of packed verteces, may be NULL
+ */
+void PackStaticMeshVerteces( EStaticMeshVertexFormat InVertexFormat, const SStaticMeshVertexType* InVerteces, uint32 InNumVerteces, byte* OutData, SStaticMeshVertexPrecision* OutPrecision = nullptr );
+
 /**
  * @ingroup Engine
  * The static mesh vertex declaration resource type
@@ -47,15 +127,34 @@ class CStaticMeshVertexDeclaration : public CRenderResource
 public:
 	/**
 	 * @brief Get vertex declaration RHI
+	 *
+	 * @param InVertexFormat	Vertex format
 	 * @return Return vertex declaration RHI
 	 */
-	FORCEINLINE VertexDeclarationRHIRef_t GetVertexDeclarationRHI()
+	FORCEINLINE VertexDeclarationRHIRef_t GetVertexDeclarationRHI( EStaticMeshVertexFormat InVertexFormat = SMVF_Float )
+	{
+		check( InVertexFormat < SMVF_Max );
+		if ( !vertexDeclarationRHI[ InVertexFormat ] )
+		{
+			InitRHI();
+		}
+		return vertexDeclarationRHI[ InVertexFormat ];
+	}
+
+	/**
+	 * @brief Get vertex declaration RHI with position only
+	 *
+	 * @param InVertexFormat	Vertex format
+	 * @return Return vertex declaration RHI with position only
+	 */
+	FORCEINLINE VertexDeclarationRHIRef_t GetPositionOnlyVertexDeclarationRHI( EStaticMeshVertexFormat InVertexFormat = SMVF_Float )
 	{
-		if ( !vertexDeclarationRHI )
+		check( InVertexFormat < SMVF_Max );
+		if ( !positionOnlyVertexDeclarationRHI[ InVertexFormat ] )
 		{
 			InitRHI();
 		}
-		return vertexDeclarationRHI;
+		return positionOnlyVertexDeclarationRHI[ InVertexFormat ];
 	}
 
 protected:
@@ -74,7 +173,8 @@ protected:
 	virtual void ReleaseRHI() override;
 
 private:
-	VertexDeclarationRHIRef_t		vertexDeclarationRHI;		/**< Vertex declaration RHI */
+	VertexDeclarationRHIRef_t		vertexDeclarationRHI[ SMVF_Max ];				/**< Vertex declaration RHI for each vertex format */
+	VertexDeclarationRHIRef_t		positionOnlyVertexDeclarationRHI[ SMVF_Max ];	/**< Vertex declaration RHI with position only for each vertex format */
 };
 
 /**
@@ -97,6 +197,14 @@ public:
 		SSS_Main = 0		/**< Main vertex buffer */
 	};
 
+	/**
+	 * @brief Constructor
+	 * @param InVertexFormat	Format of verteces in vertex buffer
+	 */
+	CStaticMeshVertexFactory( EStaticMeshVertexFormat InVertexFormat = SMVF_Float )
+		: vertexFormat( InVertexFormat )
+	{}
+
 	/**
 	 * @brief Initializes the RHI resources used by this resource.
 	 * Called when the resource is initialized.
@@ -117,6 +225,53 @@ public:
 	 * @return Return instance of vertex factory shader parameters
 	 */
 	static CVertexFactoryShaderParameters* ConstructShaderParameters( EShaderFrequency InShaderFrequency );
+
+	/**
+	 * @brief Get format of verteces
+	 * @return Return format of verteces in vertex buffer
+	 */
+	FORCEINLINE EStaticMeshVertexFormat GetVertexFormat() const
+	{
+		return vertexFormat;
+	}
+
+protected:
+	EStaticMeshVertexFormat		vertexFormat;		/**< Format of verteces in vertex buffer */
+};
+
+/**
+ * @ingroup Engine
+ * Vertex factory for render static meshes with packed verteces (SMVF_Packed and SMVF_PackedHalf)
+ * @note Both packed formats are expanded to the same shader input by input assembler
+ */
+class CStaticMeshPackedVertexFactory : public CStaticMeshVertexFactory
+{
+	DECLARE_VERTEX_FACTORY_TYPE( CStaticMeshPackedVertexFactory )
+
+public:
+	/**
+	 * @brief Constructor
+	 * @param InVertexFormat	Format of verteces in vertex buffer
+	 */
+	CStaticMeshPackedVertexFactory( EStaticMeshVertexFormat InVertexFormat = SMVF_Packed )
+		: CStaticMeshVertexFactory( InVertexFormat )
+	{
+		check( InVertexFormat == SMVF_Packed || InVertexFormat == SMVF_PackedHalf );
+	}
+
+	/**
+	 * @brief Get type hash
+	 * @return Return hash of vertex factory
+	 */
+	virtual uint64 GetTypeHash() const override;
+
+	/**
+	 * @brief Construct vertex factory shader parameters
+	 *
+	 * @param InShaderFrequency Shader frequency
+	 * @return Return instance of vertex factory shader parameters
+	 */
+	static CVertexFactoryShaderParameters* ConstructShaderParameters( EShaderFrequency InShaderFrequency );
 };
 
 //
@@ -14,8 +14,10 @@
 #include <unordered_map>
 
 #include "LEBuild.h"
+#include "Misc/Misc.h"
 #include "Misc/RefCounted.h"
 #include "Misc/RefCountPtr.h"
+#include "System/ThreadingBase.h"
 #include "Render/RenderResource.h"
 #include "Render/Shaders/Shader.h"
 #include "RHI/BaseShaderRHI.h"
@@ -152,6 +154,27 @@ public:
 			return itType->second;
 		}
 
+		/**
+		 * Convert hash of vertex factory saved in old packages (before VER_StableHashes) to current hash
+		 *
+		 * @param[in] InLegacyHash Hash calculated by legacy hashing function
+		 * @param[in] InIsHash32 Is legacy hash saved as uint32 (before VER_HashUInt64)
+		 * @return Return current hash of vertex factory. If vertex factory not found returns InLegacyHash
+		 */
+		FORCEINLINE uint64 ConvertLegacyHash( uint64 InLegacyHash, bool InIsHash32 ) const
+		{
+			for ( auto itType = vertexFactoryMetaTypes.begin(), itTypeEnd = vertexFactoryMetaTypes.end(); itType != itTypeEnd; ++itType )
+			{
+				uint64		legacyHash = appCalcHashLegacy( itType->second->GetName() );
+				if ( InIsHash32 ? ( uint32 )legacyHash == ( uint32 )InLegacyHash : legacyHash == InLegacyHash )
+				{
+					return itType->first;
+				}
+			}
+
+			return InLegacyHash;
+		}
+
 		/**
 		 * Get number registered types
 		 * @return Return number registered vertex factory meta types
@@ -460,6 +483,25 @@ public:
 	 */
 	void InitDeclaration( const VertexDeclarationRHIParamRef_t InDeclaration );
 
+	/**
+	 * Get RHI vertex declaration with position only
+	 * It is used in depth only passes, vertex factory without it returns nullptr
+	 * 
+	 * @return Return RHI vertex declaration with position only
+	 */
+	FORCEINLINE VertexDeclarationRHIRef_t GetPositionOnlyDeclaration() const
+	{
+		return positionOnlyDeclaration;
+	}
+
+	/**
+	 * Initializes the vertex declaration with position only
+	 *
+	 * @warning Need call in InitRHI() method
+	 * @param InDeclaration		Vertex declaration RHI
+	 */
+	void InitPositionOnlyDeclaration( const VertexDeclarationRHIParamRef_t InDeclaration );
+
 protected:
 	/**
 	 * @brief Releases the RHI resources used by this resource.
@@ -471,6 +513,74 @@ protected:
 private:
 	std::vector< SVertexStream >	streams;					/**< Array vertex streams */
 	VertexDeclarationRHIRef_t		declaration;				/**< Vertex declaration */
+	VertexDeclarationRHIRef_t		positionOnlyDeclaration;	/**< Vertex declaration with position only */
+};
+
+/**
+ * @ingroup Engine
+ * @brief Registry of vertex declarations initialized by vertex factories
+ * 
+ * Shader cache stores bound shader states by vertex factory types, because vertex declarations are created at runtime.
+ * This registry is used for resolve them when bound shader states are created at map load.
+ * Vertex declaration is held while at least one initialized vertex factory uses it
+ * @note All methods is thread safe
+ */
+class CVertexDeclarationRegistry
+{
+public:
+	/**
+	 * @brief Add vertex declaration
+	 * @note Each call must be paired with call of Remove
+	 * 
+	 * @param InVertexFactoryHash	Vertex factory hash
+	 * @param InIsPositionOnly		Is vertex declaration with position only
+	 * @param InDeclaration			Vertex declaration RHI
+	 */
+	void Add( uint64 InVertexFactoryHash, bool InIsPositionOnly, VertexDeclarationRHIParamRef_t InDeclaration );
+
+	/**
+	 * @brief Remove vertex declaration
+	 * @note Vertex declaration is removed from registry when the last vertex factory which added it removes it
+	 * 
+	 * @param InVertexFactoryHash	Vertex factory hash
+	 * @param InIsPositionOnly		Is vertex declaration with position only
+	 * @param InDeclaration			Vertex declaration RHI
+	 */
+	void Remove( uint64 InVertexFactoryHash, bool InIsPositionOnly, VertexDeclarationRHIParamRef_t InDeclaration );
+
+	/**
+	 * @brief Get vertex declarations of vertex factory type
+	 * 
+	 * @param InVertexFactoryHash	Vertex factory hash
+	 * @param InIsPositionOnly		Is vertex declaration with position only
+	 * @param OutDeclarations		Output array of vertex declarations
+	 */
+	void Get( uint64 InVertexFactoryHash, bool InIsPositionOnly, std::vector< VertexDeclarationRHIRef_t >& OutDeclarations ) const;
+
+	/**
+	 * @brief Remove all vertex declarations
+	 * @note Need call before destroy RHI
+	 */
+	void RemoveAll();
+
+private:
+	/**
+	 * @brief Vertex declaration in registry
+	 */
+	struct SRegisteredDeclaration
+	{
+		VertexDeclarationRHIRef_t		declaration;	/**< Vertex declaration RHI */
+		uint32							numUsers;		/**< Number of vertex factories which use it */
+	};
+
+	std::unordered_map< uint64, std::vector< SRegisteredDeclaration > >		declarations[ 2 ];		/**< Vertex declarations by vertex factory types, index 1 is position only declarations */
+	mutable CCriticalSection													criticalSection;		/**< Critical section */
 };
 
+/**
+ * @ingroup Engine
+ * @brief Global registry of vertex declarations
+ */
+extern CVertexDeclarationRegistry		GVertexDeclarationRegistry;
+
 #endif // !VERTEXFACTORY_H
\ No newline at end of file
@@ -44,6 +44,7 @@ public:
 	 */
 	CViewportClient()
 		: viewport( nullptr )
+		, viewKey( AllocateViewKey() )
 	{}
 
 	/**
@@ -79,8 +80,24 @@ public:
 		return viewport;
 	}
 
+	/**
+	 * @brief Get view key
+	 * @return Return unique key of views of this client, it is used by primitives to keep state between frames for each view
+	 */
+	FORCEINLINE uint32 GetViewKey() const
+	{
+		return viewKey;
+	}
+
+	/**
+	 * @brief Allocate new unique view key
+	 * @return Return new view key, it never is 0
+	 */
+	static uint32 AllocateViewKey();
+
 private:
-	class CViewport* viewport;		/**< Owner viewport */
+	class CViewport*	viewport;		/**< Owner viewport */
+	uint32				viewKey;		/**< Unique key of views of this client */
 };
 
 /**
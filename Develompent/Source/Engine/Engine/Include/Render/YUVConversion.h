@@ -0,0 +1,42 @@
+/**
+ * @file
+ * @addtogroup Engine Engine
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef YUVCONVERSION_H
+#define YUVCONVERSION_H
+
+#include "Misc/Types.h"
+
+/**
+ * @ingroup Engine
+ * @brief Planes of YUV420 image
+ */
+struct SYUV420Planes
+{
+	const byte*		y;				/**< Luma plane, full resolution */
+	const byte*		u;				/**< Cb plane, half resolution by both axes */
+	const byte*		v;				/**< Cr plane, half resolution by both axes */
+	uint32			yStride;		/**< Bytes between rows of luma plane */
+	uint32			uvStride;		/**< Bytes between rows of chroma planes */
+};
+
+/**
+ * @ingroup Engine
+ * @brief Convert YUV420 planes into interleaved YUVA texels with 8 bit per channel
+ *
+ * Chroma is upsampled by duplication of samples, alpha is 255. Texels are laid out as PF_A8R8G8B8 with Y in red channel,
+ * U in green and V in blue, conversion to RGB is done by shader. Sixteen pixels are converted at once by SSE2
+ *
+ * @param InPlanes		Planes of YUV420 image
+ * @param InSizeX		Width of image
+ * @param InSizeY		Height of image
+ * @param OutData		Output texels
+ * @param InPitch		Bytes between rows of output texels
+ */
+void ConvertYUV420ToYUVA( const SYUV420Planes& InPlanes, uint32 InSizeX, uint32 InSizeY, byte* OutData, uint32 InPitch );
+
+#endif // !YUVCONVERSION_H
\ No newline at end of file
@@ -52,6 +52,70 @@ public:
 	 * @param InArguments		Command arguments
 	 */
 	static void CmdHelp( const std::vector<std::wstring>& InArguments );
+
+	/**
+	 * @brief Command 'MemReport'
+	 * Print memory statistics by tags. With argument '-csv' also dump it to CSV file in logs directory
+	 *
+	 * @param InArguments		Command arguments
+	 */
+	static void CmdMemReport( const std::vector<std::wstring>& InArguments );
+
+	/**
+	 * @brief Command 'DrawListStats'
+	 * Print statistics of state changes in draw lists for the last rendered view
+	 *
+	 * @param InArguments		Command arguments
+	 */
+	static void CmdDrawListStats( const std::vector<std::wstring>& InArguments );
+
+	/**
+	 * @brief Command 'NullRHIStats'
+	 * Print statistics of calls to null RHI
+	 *
+	 * @param InArguments		Command arguments
+	 */
+	static void CmdNullRHIStats( const std::vector<std::wstring>& InArguments );
+
+	/**
+	 * @brief Command 'StateCacheStats'
+	 * Print statistics of calls issued to RHI and filtered by state cache of immediate context for the last rendered view
+	 *
+	 * @param InArguments		Command arguments
+	 */
+	static void CmdStateCacheStats( const std::vector<std::wstring>& InArguments );
+
+	/**
+	 * @brief Command 'RenderCmdStats'
+	 * Print statistics of rendering command buffer
+	 *
+	 * @param InArguments		Command arguments
+	 */
+	static void CmdRenderCmdStats( const std::vector<std::wstring>& InArguments );
+
+	/**
+	 * @brief Command 'TextureStreamingStats'
+	 * Print statistics of texture streaming
+	 *
+	 * @param InArguments		Command arguments
+	 */
+	static void CmdTextureStreamingStats( const std::vector<std::wstring>& InArguments );
+
+	/**
+	 * @brief Command 'OcclusionStats'
+	 * Print statistics of software occlusion culling for the last built view
+	 *
+	 * @param InArguments		Command arguments
+	 */
+	static void CmdOcclusionStats( const std::vector<std::wstring>& InArguments );
+
+	/**
+	 * @brief Command 'BSSStats'
+	 * Print statistics of bound shader states since the last map load
+	 *
+	 * @param InArguments		Command arguments
+	 */
+	static void CmdBSSStats( const std::vector<std::wstring>& InArguments );
 };
 
 #endif // !CONSOLESYSTEM_H
\ No newline at end of file
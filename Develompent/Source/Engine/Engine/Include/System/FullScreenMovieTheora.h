@@ -26,6 +26,36 @@
 #include "RHI/BaseSurfaceRHI.h"
 #include "RHI/TypesRHI.h"
 
+/**
+ * @ingroup Engine
+ * @brief Number of decoded frames which decoder thread may prepare ahead
+ */
+#define THEORA_NUM_DECODED_FRAMES		2
+
+/**
+ * @ingroup Engine
+ * @brief Decoded frame of Theora movie in YUV420
+ * @note Buffer of Theora decoder is overwritten by next decoded frame, so planes are copied into own memory
+ */
+struct STheoraDecodedFrame
+{
+	/**
+	 * @brief Constructor
+	 */
+	FORCEINLINE STheoraDecodedFrame()
+		: yStride( 0 )
+		, uvStride( 0 )
+		, time( 0.0 )
+	{}
+
+	std::vector<byte>		y;				/**< Luma plane */
+	std::vector<byte>		u;				/**< Cb plane */
+	std::vector<byte>		v;				/**< Cr plane */
+	uint32					yStride;		/**< Bytes between rows of luma plane */
+	uint32					uvStride;		/**< Bytes between rows of chroma planes */
+	double					time;			/**< Presentation time of frame in seconds since begin of playback */
+};
+
 /**
  * @ingroup Engine
  * @brief Class of pixel shader for render Theora movie
@@ -76,10 +106,11 @@ public:
 
 	/**
 	 * @brief Copy data frame to texture
+	 * Frame is converted into dynamic texture of the frame, its old content is discarded
 	 * 
-	 * @param InYUVBuffer	YUV Buffer
+	 * @param InFrame	Decoded frame
 	 */
-	void CopyFrameToTexture( yuv_buffer* InYUVBuffer );
+	void CopyFrameToTexture( const STheoraDecodedFrame& InFrame );
 
 	/**
 	 * @brief Get viewport
@@ -121,6 +152,7 @@ class CFullScreenMovieTheora : public CFullScreenMovieSupport
 {
 public:
 	friend CTheoraMovieRenderClient;
+	friend class CTheoraDecoderThread;
 
 	/**
 	 * @brief Constructor
@@ -249,10 +281,31 @@ private:
 	bool PumpMovie();
 
 	/**
-	 * @brief Decodes current frame from Theora to YUV 
+	 * @brief Take the next decoded frame and upload it to texture when its time has come
 	 */
 	void DecodeVideoFrame();
 
+	/**
+	 * @brief Decode next frame from Theora to YUV into free slot of decoded frames (called from decoder thread)
+	 * @return Return TRUE if frame is decoded, FALSE if end of stream is reached
+	 */
+	bool DecodeNextFrame();
+
+	/**
+	 * @brief Decode frames ahead until all slots are filled or end of stream is reached (called from decoder thread)
+	 */
+	void DecodeFrames();
+
+	/**
+	 * @brief Start decoder thread
+	 */
+	void StartDecoderThread();
+
+	/**
+	 * @brief Stop decoder thread
+	 */
+	void StopDecoderThread();
+
 	/**
 	 * @brief Stop current movie and proceed to the next startup movie (cleaning up any memory it can)
 	 * @param InIsPlayNext	Whether we should proceed to the next startup movie
@@ -278,6 +331,13 @@ private:
 	theora_state					theoraState;			/**< Theora state */
 	theora_comment					theoraComment;			/**< Theora comment */
 	yuv_buffer						yuvFrame;				/**< YUV frame */
+	STheoraDecodedFrame				decodedFrames[ THEORA_NUM_DECODED_FRAMES ];		/**< Ring of decoded frames, filled by decoder thread and consumed by rendering thread */
+	uint32							readFrameIndex;			/**< Index of the next decoded frame for upload (used by rendering thread) */
+	uint32							writeFrameIndex;		/**< Index of the next free slot for decode (used by decoder thread) */
+	volatile int32					numDecodedFrames;		/**< Number of decoded frames which aren't uploaded yet */
+	volatile int32					bEndOfStream;			/**< Is decoder thread reached end of stream, it is set by interlocked exchange */
+	class CTheoraDecoderThread*		decoderRunnable;		/**< Runnable object of decoder thread */
+	class CRunnableThread*			decoderThread;			/**< Decoder thread */
 	uint32							frameWidth;				/**< Frame width */
 	uint32							frameHeight;			/**< Frame height */
 	float							frameRate;				/**< Frame rate */
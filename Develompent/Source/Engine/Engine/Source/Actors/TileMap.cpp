@@ -0,0 +1,18 @@
+#include "Actors/TileMap.h"
+
+IMPLEMENT_CLASS( ATileMap )
+
+ATileMap::ATileMap()
+{
+    tileMapComponent    = CreateComponent< CTileMapComponent >( TEXT( "TileMapComponent0" ) );
+}
+
+ATileMap::~ATileMap()
+{}
+
+#if WITH_EDITOR
+std::wstring ATileMap::GetActorIcon() const
+{
+    return TEXT( "Engine/Editor/Icons/CB_Map.png" );
+}
+#endif // WITH_EDITOR
\ No newline at end of file
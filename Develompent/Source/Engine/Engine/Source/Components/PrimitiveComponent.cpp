@@ -3,6 +3,8 @@
 #include "System/World.h"
 #include "Actors/Actor.h"
 #include "Render/Scene.h"
+#include "Render/Material.h"
+#include "Math/BVH.h"
 
 IMPLEMENT_CLASS( CPrimitiveComponent )
 
@@ -70,6 +72,40 @@ void CPrimitiveComponent::UnlinkDrawList()
 void CPrimitiveComponent::AddToDrawList( const class CSceneView& InSceneView )
 {}
 
+void CPrimitiveComponent::GetUsedMaterials( std::vector< TAssetHandle<CMaterial> >& OutMaterials ) const
+{}
+
+CBox CPrimitiveComponent::CalcBounds() const
+{
+	return CBox();
+}
+
+void CPrimitiveComponent::UpdateBounds()
+{
+	boundbox = CalcBounds();
+}
+
+void CPrimitiveComponent::AddToOcclusionBuffer( class COcclusionBuffer& InOcclusionBuffer ) const
+{}
+
+bool CPrimitiveComponent::RayCast( const Vector& InOrigin, const Vector& InDirection, float& InOutDistance ) const
+{
+	const CBox		box = CalcBounds();
+	if ( !box.IsValid() )
+	{
+		return false;
+	}
+
+	float		distance = 0.f;
+	if ( !CBVH::RayBoxIntersect( InOrigin, Vector( 1.f / InDirection.x, 1.f / InDirection.y, 1.f / InDirection.z ), box.GetMin(), box.GetMax(), InOutDistance, distance ) )
+	{
+		return false;
+	}
+
+	InOutDistance = distance;
+	return true;
+}
+
 void CPrimitiveComponent::InitPrimitivePhysics()
 {
 	if ( bodySetup )
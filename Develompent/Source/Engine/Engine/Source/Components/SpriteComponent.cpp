@@ -170,6 +170,15 @@ void CSpriteComponent::UnlinkDrawList()
 	meshBatchLinks.clear();
 }
 
+void CSpriteComponent::GetUsedMaterials( std::vector< TAssetHandle<CMaterial> >& OutMaterials ) const
+{
+	TAssetHandle<CMaterial>		material = sprite ? sprite->GetMaterial() : nullptr;
+	if ( material.IsAssetValid() )
+	{
+		OutMaterials.push_back( material );
+	}
+}
+
 void CSpriteComponent::AddToDrawList( const class CSceneView& InSceneView )
 {
 	// If primitive is empty - exit from method
@@ -217,7 +226,9 @@ void CSpriteComponent::AddToDrawList( const class CSceneView& InSceneView )
 		instanceMesh.bSelected		= owner ? owner->IsSelected() : false;
 #endif // WITH_EDITOR
 	}
+}
 
-    // Update AABB
-    boundbox = CBox::BuildAABB( GetComponentLocation(), Vector( GetSpriteSize(), 1.f ) );
+CBox CSpriteComponent::CalcBounds() const
+{
+	return CBox::BuildAABB( GetComponentLocation(), Vector( GetSpriteSize(), 1.f ) );
 }
@@ -1,12 +1,34 @@
+#include <float.h>
+#include <math.h>
+
 #include "Actors/Actor.h"
 #include "Components/StaticMeshComponent.h"
+#include "Misc/Template.h"
 #include "Render/Scene.h"
 #include "Render/SceneUtils.h"
+#include "Render/OcclusionCulling.h"
+#include "System/ConVar.h"
+
+//
+// Definitions
+//
+
+/* Relative change of screen size around LOD threshold, which is needed for switch LOD */
+#define STATICMESH_LOD_HYSTERESIS		0.1f
+
+/**
+ * @ingroup Engine
+ * @brief CVar bias of selected static mesh LOD
+ */
+CConVar		CVarRStaticMeshLODBias( TEXT( "r.staticMeshLODBias" ), TEXT( "0" ), CVT_Int, TEXT( "Bias of selected static mesh LOD. Positive values select coarser LODs, negative select finer" ) );
 
 IMPLEMENT_CLASS( CStaticMeshComponent )
 
 CStaticMeshComponent::CStaticMeshComponent()
-{}
+	: nextViewLOD( 0 )
+{
+	appMemzero( viewLODs, sizeof( viewLODs ) );
+}
 
 CStaticMeshComponent::~CStaticMeshComponent()
 {}
@@ -55,6 +77,79 @@ void CStaticMeshComponent::UnlinkDrawList()
 	}
 }
 
+void CStaticMeshComponent::GetUsedMaterials( std::vector< TAssetHandle<CMaterial> >& OutMaterials ) const
+{
+	for ( uint32 index = 0, count = overrideMaterials.size(); index < count; ++index )
+	{
+		TAssetHandle<CMaterial>		material = GetMaterial( index );
+		if ( material.IsAssetValid() )
+		{
+			OutMaterials.push_back( material );
+		}
+	}
+}
+
+CBox CStaticMeshComponent::CalcBounds() const
+{
+	TSharedPtr<CStaticMesh>		staticMeshRef = staticMesh.ToSharedPtr();
+	if ( !staticMeshRef || !staticMeshRef->GetBoundBox().IsValid() )
+	{
+		return CBox();
+	}
+
+	// Calculate AABB of mesh in world space
+	const Matrix		transformMatrix = GetComponentTransform().ToMatrix();
+	const Vector&		localMin		= staticMeshRef->GetBoundBox().GetMin();
+	const Vector&		localMax		= staticMeshRef->GetBoundBox().GetMax();
+	Vector				boundMin( FLT_MAX, FLT_MAX, FLT_MAX );
+	Vector				boundMax( -FLT_MAX, -FLT_MAX, -FLT_MAX );
+	for ( uint32 corner = 0; corner < 8; ++corner )
+	{
+		Vector4D	position = transformMatrix * Vector4D( corner & 1 ? localMax.x : localMin.x, corner & 2 ? localMax.y : localMin.y, corner & 4 ? localMax.z : localMin.z, 1.f );
+		boundMin	= Vector( Min( boundMin.x, position.x ), Min( boundMin.y, position.y ), Min( boundMin.z, position.z ) );
+		boundMax	= Vector( Max( boundMax.x, position.x ), Max( boundMax.y, position.y ), Max( boundMax.z, position.z ) );
+	}
+	return CBox( boundMin, boundMax );
+}
+
+void CStaticMeshComponent::AddToOcclusionBuffer( class COcclusionBuffer& InOcclusionBuffer ) const
+{
+	TSharedPtr<CStaticMesh>		staticMeshRef = staticMesh.ToSharedPtr();
+	if ( !staticMeshRef || !staticMeshRef->IsOccluder() )
+	{
+		return;
+	}
+
+	const std::vector<Vector>&		occluderVerteces	= staticMeshRef->GetOccluderVerteces();
+	const std::vector<uint32>&		occluderIndeces		= staticMeshRef->GetOccluderIndeces();
+	if ( !occluderIndeces.empty() )
+	{
+		InOcclusionBuffer.AddOccluder( occluderVerteces.data(), occluderIndeces.data(), occluderIndeces.size(), GetComponentTransform().ToMatrix() );
+	}
+}
+
+bool CStaticMeshComponent::RayCast( const Vector& InOrigin, const Vector& InDirection, float& InOutDistance ) const
+{
+	TSharedPtr<CStaticMesh>		staticMeshRef = staticMesh.ToSharedPtr();
+	if ( !staticMeshRef || !staticMeshRef->CanRayCastTriangles() )
+	{
+		return Super::RayCast( InOrigin, InDirection, InOutDistance );
+	}
+
+	// Reject by bound box before transform the ray
+	float		boxDistance = InOutDistance;
+	if ( !Super::RayCast( InOrigin, InDirection, boxDistance ) )
+	{
+		return false;
+	}
+
+	// Direction isn't normalized after transform into local space, so distance of hit is the same in both spaces
+	const Matrix		worldToLocal	= SMath::InverseMatrix( GetComponentTransform().ToMatrix() );
+	const Vector		localOrigin		= Vector( worldToLocal * Vector4D( InOrigin, 1.f ) );
+	const Vector		localDirection	= Vector( worldToLocal * Vector4D( InDirection, 0.f ) );
+	return staticMeshRef->RayCast( localOrigin, localDirection, InOutDistance );
+}
+
 void CStaticMeshComponent::AddToDrawList( const class CSceneView& InSceneView )
 {
 	// If primitive is empty - exit from method
@@ -77,9 +172,22 @@ void CStaticMeshComponent::AddToDrawList( const class CSceneView& InSceneView )
 
 	AActor*		owner = GetOwner();
 
-	// Add to mesh batch new instance
-	const Matrix				transformationMatrix = GetComponentTransform().ToMatrix();
-	for ( uint32 index = 0, count = elementDrawingPolicyLink->meshBatchLinks.size(); index < count; ++index )
+	// Select LOD and apply bias to it
+	const Matrix				transformationMatrix	= GetComponentTransform().ToMatrix();
+	const std::vector<uint32>&	lodMeshBatchLinks		= elementDrawingPolicyLink->lodMeshBatchLinks;
+	const int32					maxLOD					= ( int32 )lodMeshBatchLinks.size() - 2;
+	uint32						lodIndex				= 0;
+	if ( maxLOD > 0 )
+	{
+		TSharedPtr<CStaticMesh>		staticMeshRef = staticMesh.ToSharedPtr();
+		if ( staticMeshRef )
+		{
+			lodIndex = Clamp<int32>( ( int32 )SelectLOD( InSceneView, transformationMatrix, staticMeshRef ) + CVarRStaticMeshLODBias.GetValueInt(), 0, maxLOD );
+		}
+	}
+
+	// Add to mesh batches of LOD new instance
+	for ( uint32 index = lodMeshBatchLinks[ lodIndex ], count = lodMeshBatchLinks[ lodIndex + 1 ]; index < count; ++index )
 	{
 		const SMeshBatch*		meshBatch = elementDrawingPolicyLink->meshBatchLinks[ index ];
 		++meshBatch->numInstances;
@@ -94,3 +202,53 @@ void CStaticMeshComponent::AddToDrawList( const class CSceneView& InSceneView )
 										} );
 	}
 }
+
+uint32 CStaticMeshComponent::SelectLOD( const class CSceneView& InSceneView, const Matrix& InTransformMatrix, const TSharedPtr<CStaticMesh>& InStaticMesh )
+{
+	const CBox&		localBox = InStaticMesh->GetBoundBox();
+	if ( !localBox.IsValid() )
+	{
+		return 0;
+	}
+
+	// Bound sphere in world space, radius is scaled by the largest axis
+	const Vector		center		= Vector( InTransformMatrix * Vector4D( ( localBox.GetMin() + localBox.GetMax() ) * 0.5f, 1.f ) );
+	const float			maxScale	= Max( SMath::LengthVector( Vector( InTransformMatrix[ 0 ] ) ), Max( SMath::LengthVector( Vector( InTransformMatrix[ 1 ] ) ), SMath::LengthVector( Vector( InTransformMatrix[ 2 ] ) ) ) );
+	const float			radius		= SMath::LengthVector( localBox.GetMax() - localBox.GetMin() ) * 0.5f * maxScale;
+
+	// Ratio of projected diameter to height of screen, for orthographic projection W is 1
+	const float			w			= Max( InSceneView.WorldToScreen( center ).w, 0.0001f );
+	const float			screenSize	= radius * fabsf( InSceneView.GetProjectionMatrix()[ 1 ][ 1 ] ) / w;
+
+	// If LOD of the view isn't known, select it only by screen size and remember it for the next frame
+	const uint32		maxLOD		= InStaticMesh->GetNumLODs() - 1;
+	const uint32		viewKey		= InSceneView.GetViewKey();
+	const uint32		viewIndex	= FindViewLOD( viewKey );
+	if ( viewIndex == INDEX_NONE )
+	{
+		const uint32	lodIndex = Min( InStaticMesh->GetLODByScreenSize( screenSize ), maxLOD );
+		if ( viewKey != 0 )
+		{
+			viewLODs[ nextViewLOD ].viewKey		= viewKey;
+			viewLODs[ nextViewLOD ].lodIndex	= lodIndex;
+			nextViewLOD							= ( nextViewLOD + 1 ) % STATICMESH_LOD_MAX_VIEWS;
+		}
+		return lodIndex;
+	}
+
+	// Go to coarser LOD only when screen size is less than threshold by hysteresis, and to finer one when it is more than threshold by hysteresis
+	uint32&				lodIndex	= viewLODs[ viewIndex ].lodIndex;
+	const uint32		coarserLOD	= InStaticMesh->GetLODByScreenSize( screenSize * ( 1.f + STATICMESH_LOD_HYSTERESIS ) );
+	const uint32		finerLOD	= InStaticMesh->GetLODByScreenSize( screenSize * ( 1.f - STATICMESH_LOD_HYSTERESIS ) );
+	if ( coarserLOD > lodIndex )
+	{
+		lodIndex = coarserLOD;
+	}
+	else if ( finerLOD < lodIndex )
+	{
+		lodIndex = finerLOD;
+	}
+
+	lodIndex = Min( lodIndex, maxLOD );
+	return lodIndex;
+}
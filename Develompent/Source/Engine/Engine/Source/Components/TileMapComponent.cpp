@@ -0,0 +1,270 @@
+#include <float.h>
+#include <map>
+#include <tuple>
+
+#include "Actors/Actor.h"
+#include "Components/TileMapComponent.h"
+#include "Misc/Template.h"
+#include "System/Archive.h"
+#include "Render/Scene.h"
+#include "Render/SceneUtils.h"
+
+IMPLEMENT_CLASS( CTileMapComponent )
+
+CTileMapComponent::CTileMapComponent()
+	: numTiles( 0 )
+{}
+
+void CTileMapComponent::Serialize( class CArchive& InArchive )
+{
+	Super::Serialize( InArchive );
+	InArchive << materials;
+	InArchive << numTiles;
+
+	uint32		numChunks = chunks.size();
+	InArchive << numChunks;
+
+	if ( InArchive.IsLoading() )
+	{
+		// Release old chunks, component can be loaded again
+		for ( uint32 index = 0, count = chunks.size(); index < count; ++index )
+		{
+			BeginReleaseResource( chunks[ index ] );
+		}
+
+		chunks.resize( numChunks );
+		for ( uint32 index = 0; index < numChunks; ++index )
+		{
+			chunks[ index ] = new CTileMapChunk();
+		}
+		bIsDirtyDrawingPolicyLink = true;
+	}
+
+	for ( uint32 index = 0; index < numChunks; ++index )
+	{
+		chunks[ index ]->Serialize( InArchive );
+		if ( InArchive.IsLoading() )
+		{
+			BeginInitResource( chunks[ index ] );
+		}
+	}
+}
+
+void CTileMapComponent::SetTiles( const std::vector< STileMapTile >& InTiles, const std::vector< TAssetHandle<CMaterial> >& InMaterials, const Vector2D& InTileSize )
+{
+	// Split tiles into chunks. Each chunk contains tiles of one layer only, so verteces of chunk always fit into 16-bit indeces
+	typedef std::tuple< uint32, uint32, uint32 >	ChunkKey_t;
+	std::map< ChunkKey_t, std::vector< STileMapTile > >		chunkTiles;
+	for ( uint32 index = 0, count = InTiles.size(); index < count; ++index )
+	{
+		const STileMapTile&		tile = InTiles[ index ];
+		check( tile.materialIndex < InMaterials.size() );
+		chunkTiles[ ChunkKey_t( tile.layer, tile.y / TILEMAP_CHUNK_SIZE, tile.x / TILEMAP_CHUNK_SIZE ) ].push_back( tile );
+	}
+
+	// Release old chunks and build new
+	for ( uint32 index = 0, count = chunks.size(); index < count; ++index )
+	{
+		BeginReleaseResource( chunks[ index ] );
+	}
+
+	chunks.clear();
+	materials	= InMaterials;
+	numTiles	= InTiles.size();
+	for ( auto it = chunkTiles.begin(), itEnd = chunkTiles.end(); it != itEnd; ++it )
+	{
+		TileMapChunkRef_t		chunk = new CTileMapChunk();
+		chunk->SetTiles( it->second, InTileSize );
+		BeginInitResource( chunk );
+		chunks.push_back( chunk );
+	}
+
+	bIsDirtyDrawingPolicyLink = true;
+}
+
+void CTileMapComponent::LinkDrawList()
+{
+	check( scene );
+
+	// If the primitive already added to scene - remove all draw policy links
+	if ( !chunkDrawingPolicyLinks.empty() )
+	{
+		UnlinkDrawList();
+	}
+
+	// Add to scene draw policy links of each surface in chunks
+	SSceneDepthGroup&		SDG = scene->GetSDG( SDG_World );
+	chunkDrawingPolicyLinks.resize( chunks.size() );
+	for ( uint32 chunkIndex = 0, numChunks = chunks.size(); chunkIndex < numChunks; ++chunkIndex )
+	{
+		TileMapChunkRef_t						chunk				= chunks[ chunkIndex ];
+		SChunkDrawingPolicyLink&				chunkLink			= chunkDrawingPolicyLinks[ chunkIndex ];
+		const std::vector< STileMapSurface >&	surfaces			= chunk->GetSurfaces();
+
+		for ( uint32 surfaceIndex = 0, numSurfaces = surfaces.size(); surfaceIndex < numSurfaces; ++surfaceIndex )
+		{
+			const STileMapSurface&		surface = surfaces[ surfaceIndex ];
+			TAssetHandle<CMaterial>		material = materials[ surface.materialIndex ];
+
+			// Generate mesh batch of surface
+			SMeshBatch					meshBatch;
+			meshBatch.baseVertexIndex	= 0;
+			meshBatch.firstIndex		= surface.firstIndex;
+			meshBatch.numPrimitives		= surface.numPrimitives;
+			meshBatch.indexBufferRHI	= chunk->GetIndexBufferRHI();
+			meshBatch.primitiveType		= PT_TriangleList;
+
+			// Make and add to scene new draw policy link
+			const SMeshBatch*			meshBatchLink = nullptr;
+			chunkLink.drawingPolicyLinks.push_back( ::MakeDrawingPolicyLink<DrawingPolicyLink_t>( chunk->GetVertexFactory(), material, meshBatch, meshBatchLink, SDG.spriteDrawList, DEC_SPRITE ) );
+			chunkLink.meshBatchLinks.push_back( meshBatchLink );
+
+			// Make and add to scene new hit proxy draw policy link
+#if ENABLE_HITPROXY
+			chunkLink.hitProxyDrawingPolicyLinks.push_back( ::MakeDrawingPolicyLink<HitProxyDrawingPolicyLink_t>( chunk->GetVertexFactory(), material, meshBatch, meshBatchLink, SDG.hitProxyLayers[ HPL_World ].hitProxyDrawList, DEC_SPRITE ) );
+			chunkLink.meshBatchLinks.push_back( meshBatchLink );
+#endif // ENABLE_HITPROXY
+		}
+	}
+}
+
+void CTileMapComponent::UnlinkDrawList()
+{
+	check( scene );
+	SSceneDepthGroup&		SDGWorld = scene->GetSDG( SDG_World );
+
+	// Remove all draw policy links of chunks
+	for ( uint32 chunkIndex = 0, numChunks = chunkDrawingPolicyLinks.size(); chunkIndex < numChunks; ++chunkIndex )
+	{
+		SChunkDrawingPolicyLink&		chunkLink = chunkDrawingPolicyLinks[ chunkIndex ];
+		for ( uint32 index = 0, count = chunkLink.drawingPolicyLinks.size(); index < count; ++index )
+		{
+			SDGWorld.spriteDrawList.RemoveItem( chunkLink.drawingPolicyLinks[ index ] );
+		}
+
+#if ENABLE_HITPROXY
+		for ( uint32 index = 0, count = chunkLink.hitProxyDrawingPolicyLinks.size(); index < count; ++index )
+		{
+			SDGWorld.hitProxyLayers[ HPL_World ].hitProxyDrawList.RemoveItem( chunkLink.hitProxyDrawingPolicyLinks[ index ] );
+		}
+#endif // ENABLE_HITPROXY
+	}
+
+	chunkDrawingPolicyLinks.clear();
+}
+
+void CTileMapComponent::GetUsedMaterials( std::vector< TAssetHandle<CMaterial> >& OutMaterials ) const
+{
+	for ( uint32 index = 0, count = materials.size(); index < count; ++index )
+	{
+		if ( materials[ index ].IsAssetValid() )
+		{
+			OutMaterials.push_back( materials[ index ] );
+		}
+	}
+}
+
+void CTileMapComponent::AddToDrawList( const class CSceneView& InSceneView )
+{
+	// If primitive is empty - exit from method
+	if ( !bIsDirtyDrawingPolicyLink && chunkDrawingPolicyLinks.empty() )
+	{
+		return;
+	}
+
+	// If drawing policy link is dirty - we update it
+	if ( bIsDirtyDrawingPolicyLink )
+	{
+		bIsDirtyDrawingPolicyLink = false;
+		LinkDrawList();
+	}
+
+	AActor*				owner				= GetOwner();
+	const Matrix&		transformMatrix		= GetComponentTransform().ToMatrix();
+	const CFrustum&		frustum				= InSceneView.GetFrustum();
+	for ( uint32 chunkIndex = 0, numChunks = chunks.size(); chunkIndex < numChunks; ++chunkIndex )
+	{
+		// If chunk isn't visible - skip it
+		const CBox&		chunkBox = chunkBoundBoxes[ chunkIndex ];
+		if ( !chunkBox.IsValid() || !frustum.IsIn( chunkBox ) )
+		{
+			continue;
+		}
+
+		// Add to mesh batches of chunk new instance
+		const std::vector<const SMeshBatch*>&		meshBatchLinks = chunkDrawingPolicyLinks[ chunkIndex ].meshBatchLinks;
+		for ( uint32 index = 0, count = meshBatchLinks.size(); index < count; ++index )
+		{
+			const SMeshBatch*		meshBatch = meshBatchLinks[ index ];
+			++meshBatch->numInstances;
+			meshBatch->instances.push_back( SMeshInstance{ transformMatrix
+#if ENABLE_HITPROXY
+											, owner ? owner->GetHitProxyId() : CHitProxyId()
+#endif // ENABLE_HITPROXY
+
+#if WITH_EDITOR
+											, owner ? owner->IsSelected() : false
+#endif // WITH_EDITOR
+											} );
+		}
+	}
+}
+
+CBox CTileMapComponent::CalcChunkBounds( const Matrix& InTransformMatrix, uint32 InChunkIndex ) const
+{
+	// Calculate AABB of chunk in world space
+	const CBox&		localBox	= chunks[ InChunkIndex ]->GetBoundBox();
+	if ( !localBox.IsValid() )
+	{
+		return CBox();
+	}
+
+	const Vector&	localMin	= localBox.GetMin();
+	const Vector&	localMax	= localBox.GetMax();
+	Vector			chunkMin( FLT_MAX, FLT_MAX, FLT_MAX );
+	Vector			chunkMax( -FLT_MAX, -FLT_MAX, -FLT_MAX );
+	for ( uint32 corner = 0; corner < 8; ++corner )
+	{
+		Vector4D	position = InTransformMatrix * Vector4D( corner & 1 ? localMax.x : localMin.x, corner & 2 ? localMax.y : localMin.y, corner & 4 ? localMax.z : localMin.z, 1.f );
+		chunkMin	= Vector( Min( chunkMin.x, position.x ), Min( chunkMin.y, position.y ), Min( chunkMin.z, position.z ) );
+		chunkMax	= Vector( Max( chunkMax.x, position.x ), Max( chunkMax.y, position.y ), Max( chunkMax.z, position.z ) );
+	}
+	return CBox( chunkMin, chunkMax );
+}
+
+CBox CTileMapComponent::CalcBounds() const
+{
+	const Matrix		transformMatrix		= GetComponentTransform().ToMatrix();
+	Vector				boundMin( FLT_MAX, FLT_MAX, FLT_MAX );
+	Vector				boundMax( -FLT_MAX, -FLT_MAX, -FLT_MAX );
+	for ( uint32 chunkIndex = 0, numChunks = chunks.size(); chunkIndex < numChunks; ++chunkIndex )
+	{
+		const CBox		chunkBox = CalcChunkBounds( transformMatrix, chunkIndex );
+		if ( chunkBox.IsValid() )
+		{
+			boundMin = Vector( Min( boundMin.x, chunkBox.GetMin().x ), Min( boundMin.y, chunkBox.GetMin().y ), Min( boundMin.z, chunkBox.GetMin().z ) );
+			boundMax = Vector( Max( boundMax.x, chunkBox.GetMax().x ), Max( boundMax.y, chunkBox.GetMax().y ), Max( boundMax.z, chunkBox.GetMax().z ) );
+		}
+	}
+	return numTiles > 0 ? CBox( boundMin, boundMax ) : CBox();
+}
+
+void CTileMapComponent::UpdateBounds()
+{
+	const Matrix		transformMatrix		= GetComponentTransform().ToMatrix();
+	Vector				boundMin( FLT_MAX, FLT_MAX, FLT_MAX );
+	Vector				boundMax( -FLT_MAX, -FLT_MAX, -FLT_MAX );
+
+	chunkBoundBoxes.resize( chunks.size() );
+	for ( uint32 chunkIndex = 0, numChunks = chunks.size(); chunkIndex < numChunks; ++chunkIndex )
+	{
+		const CBox&		chunkBox = chunkBoundBoxes[ chunkIndex ] = CalcChunkBounds( transformMatrix, chunkIndex );
+		if ( chunkBox.IsValid() )
+		{
+			boundMin = Vector( Min( boundMin.x, chunkBox.GetMin().x ), Min( boundMin.y, chunkBox.GetMin().y ), Min( boundMin.z, chunkBox.GetMin().z ) );
+			boundMax = Vector( Max( boundMax.x, chunkBox.GetMax().x ), Max( boundMax.y, chunkBox.GetMax().y ), Max( boundMax.z, chunkBox.GetMax().z ) );
+		}
+	}
+
+	boundbox = numTiles > 0 ? CBox( boundMin, boundMax ) : CBox();
+}
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include "System/World.h"
 #include "System/CameraManager.h"
 #include "System/ConsoleSystem.h"
+#include "Render/TextureStreaming.h"
 
 // -------------
 // GLOBALS
@@ -25,5 +26,10 @@ bool														GIsCookEditorContent = false;
 bool														GAllowDebugShaderDump = false;
 #endif // WITH_EDITOR
 
+#if FRAME_CAPTURE_MARKERS
+bool														GEmitDrawEvents = false;
+#endif // FRAME_CAPTURE_MARKERS
+
 class CFullScreenMovieSupport*								GFullScreenMovie = nullptr;
 CConsoleSystem												GConsoleSystem;
+CTextureStreamingManager*									GTextureStreamingManager = new CTextureStreamingManager();
@@ -10,7 +10,7 @@ void CBatchedSimpleElements::Draw( class CBaseDeviceContextRHI* InDeviceContext,
 	CSimpleElementVertexShader*			vertexShader	= GShaderManager->FindInstance< CSimpleElementVertexShader, CSimpleElementVertexFactory >();
 	CSimpleElementPixelShader*			pixelShader		= GShaderManager->FindInstance< CSimpleElementPixelShader, CSimpleElementVertexFactory >();
 
-	GRHI->SetBoundShaderState( InDeviceContext, GRHI->CreateBoundShaderState( TEXT( "SimpleElementBoundShaderState" ), GSimpleElementVertexDeclaration.GetVertexDeclarationRHI(), vertexShader->GetVertexShader(), pixelShader->GetPixelShader() ) );
+	InDeviceContext->SetBoundShaderState( GRHI->CreateBoundShaderState( TEXT( "SimpleElementBoundShaderState" ), GSimpleElementVertexDeclaration.GetVertexDeclarationRHI(), vertexShader->GetVertexShader(), pixelShader->GetPixelShader() ) );
 	
 	// Draw lines
 	if ( !lineVerteces.empty() )
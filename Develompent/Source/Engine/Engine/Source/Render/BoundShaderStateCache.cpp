@@ -1,6 +1,11 @@
 #include "Render/BoundShaderStateCache.h"
 #include "RHI/BaseShaderRHI.h"
 
+#if !SHIPPING_BUILD
+/* Statistics of bound shader states since the last map load */
+SBoundShaderStateStats		GBoundShaderStateStats;
+#endif // !SHIPPING_BUILD
+
 /**
  * Constructor
  */
@@ -0,0 +1,198 @@
+#include "Misc/Misc.h"
+#include "Misc/CoreGlobals.h"
+#include "Misc/EngineGlobals.h"
+#include "Logger/LoggerMacros.h"
+#include "System/ThreadingBase.h"
+#include "RHI/BaseRHI.h"
+#include "RHI/BaseShaderRHI.h"
+#include "Render/RenderingThread.h"
+#include "Render/BoundShaderStateCache.h"
+#include "Render/BoundShaderStateWarmup.h"
+#include "Render/Shaders/ShaderManager.h"
+#include "Render/VertexFactory/VertexFactory.h"
+
+//
+// GLOBALS
+//
+CBoundShaderStateWarmup		GBoundShaderStateWarmup;
+
+/**
+ * @ingroup Engine
+ * @brief Runnable object of warmup thread
+ */
+class CBoundShaderStateWarmupThread : public CRunnable
+{
+public:
+	/**
+	 * @brief Constructor
+	 * @param InWarmup	Warmup of bound shader states
+	 */
+	CBoundShaderStateWarmupThread( CBoundShaderStateWarmup* InWarmup )
+		: bStopping( false )
+		, warmup( InWarmup )
+	{}
+
+	/**
+	 * @brief Initialize
+	 * @return True if initialization was successful, false otherwise
+	 */
+	virtual bool Init() override
+	{
+		return true;
+	}
+
+	/**
+	 * @brief Run
+	 * @return The exit code of the runnable object
+	 */
+	virtual uint32 Run() override
+	{
+		warmup->WarmupItems();
+		return 0;
+	}
+
+	/**
+	 * @brief Stop
+	 */
+	virtual void Stop() override
+	{
+		bStopping = true;
+	}
+
+	/**
+	 * @brief Exit
+	 */
+	virtual void Exit() override
+	{}
+
+	volatile bool					bStopping;		/**< Is thread stopping */
+	CBoundShaderStateWarmup*		warmup;			/**< Warmup of bound shader states */
+};
+
+CBoundShaderStateWarmup::CBoundShaderStateWarmup()
+	: thread( nullptr )
+	, runnable( nullptr )
+	, bStartPending( false )
+{}
+
+void CBoundShaderStateWarmup::Start( const std::wstring& InMapName )
+{
+	check( IsInGameThread() );
+	Wait();
+
+	mapName = InMapName;
+	boundShaderStates.clear();
+#if !SHIPPING_BUILD
+	GBoundShaderStateStats.Reset();
+#endif // !SHIPPING_BUILD
+
+	const std::vector< CShaderCache::SBoundShaderStateItem >*		mapItems = GShaderManager->FindBoundShaderStates( InMapName );
+	if ( !mapItems || mapItems->empty() )
+	{
+		items.clear();
+		return;
+	}
+	items = *mapItems;
+
+	// Vertex factories of loaded map register their declarations in rendering thread,
+	// so warmup thread is started by rendering command after all of them are initialized
+	bStartPending = true;
+	UNIQUE_RENDER_COMMAND_ONEPARAMETER( CStartBoundShaderStateWarmupCommand, CBoundShaderStateWarmup*, warmup, this,
+		{
+			warmup->runnable		= new CBoundShaderStateWarmupThread( warmup );
+			warmup->thread			= GThreadFactory->CreateThread( warmup->runnable, TEXT( "BoundShaderStateWarmupThread" ), 0, 0, 0, TP_BelowNormal );
+			warmup->bStartPending	= false;
+			check( warmup->thread );
+		} );
+}
+
+void CBoundShaderStateWarmup::WaitStart()
+{
+	if ( bStartPending )
+	{
+		FlushRenderingCommands();
+	}
+}
+
+void CBoundShaderStateWarmup::Wait()
+{
+	WaitStart();
+	if ( !thread )
+	{
+		return;
+	}
+
+	thread->WaitForCompletion();
+	thread->Kill();
+	GThreadFactory->Destroy( thread );
+	delete runnable;
+
+	thread		= nullptr;
+	runnable	= nullptr;
+}
+
+void CBoundShaderStateWarmup::Shutdown()
+{
+	WaitStart();
+	if ( runnable )
+	{
+		runnable->Stop();
+	}
+
+	Wait();
+	items.clear();
+	boundShaderStates.clear();
+}
+
+void CBoundShaderStateWarmup::WarmupItems()
+{
+	double										startTime = appSeconds();
+	uint32										numWarmedUp = 0;
+	std::vector< VertexDeclarationRHIRef_t >	declarations;
+	for ( uint32 index = 0, count = ( uint32 )items.size(); index < count && !runnable->bStopping; ++index )
+	{
+		const CShaderCache::SBoundShaderStateItem&		item			= items[ index ];
+		CShader*										vertexShader	= GShaderManager->FindInstance( item.vertexShaderName, item.vertexFactoryHash );
+		CShader*										pixelShader		= !item.pixelShaderName.empty() ? GShaderManager->FindInstance( item.pixelShaderName, item.vertexFactoryHash ) : nullptr;
+
+		// Vertex factory type may be not used by loaded meshes, in this case it hasn't vertex declarations
+		declarations.clear();
+		GVertexDeclarationRegistry.Get( item.vertexFactoryHash, item.bPositionOnly, declarations );
+		if ( !vertexShader || ( !item.pixelShaderName.empty() && !pixelShader ) || declarations.empty() )
+		{
+#if !SHIPPING_BUILD
+			appInterlockedIncrement( &GBoundShaderStateStats.numNotResolved );
+#endif // !SHIPPING_BUILD
+			continue;
+		}
+
+		PixelShaderRHIRef_t		pixelShaderRHI;
+		if ( pixelShader )
+		{
+			pixelShaderRHI = pixelShader->GetPixelShader();
+		}
+
+		for ( uint32 indexDeclaration = 0, countDeclarations = ( uint32 )declarations.size(); indexDeclaration < countDeclarations; ++indexDeclaration )
+		{
+			bool							bCreated = false;
+			BoundShaderStateRHIRef_t		boundShaderState = GRHI->CreateBoundShaderState(
+				item.vertexShaderName.c_str(),
+				declarations[ indexDeclaration ],
+				vertexShader->GetVertexShader(),
+				pixelShaderRHI,
+				nullptr, nullptr, nullptr,
+				&bCreated );
+
+			if ( bCreated )
+			{
+				++numWarmedUp;
+			}
+			boundShaderStates.push_back( boundShaderState );
+		}
+	}
+
+#if !SHIPPING_BUILD
+	GBoundShaderStateStats.numWarmedUp = numWarmedUp;
+#endif // !SHIPPING_BUILD
+	LE_LOG( LT_Log, LC_Shader, TEXT( "Warmed up %i bound shader states for map '%s' in %.2f ms" ), numWarmedUp, mapName.c_str(), ( appSeconds() - startTime ) * 1000.0 );
+}
\ No newline at end of file
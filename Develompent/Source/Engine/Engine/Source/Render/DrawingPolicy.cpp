@@ -8,6 +8,11 @@
 #include "Render/SceneUtils.h"
 #include "Render/Scene.h"
 #include "Render/DrawingPolicy.h"
+#include "Render/BoundShaderStateCache.h"
+
+#if !SHIPPING_BUILD
+SDrawListStats		GDrawListStats;
+#endif // !SHIPPING_BUILD
 
 CMeshDrawingPolicy::CMeshDrawingPolicy()
 	: bInit( false )
@@ -44,8 +49,8 @@ void CMeshDrawingPolicy::SetRenderState( class CBaseDeviceContextRHI* InDeviceCo
 	check( bInit );
 
 	vertexFactory->Set( InDeviceContextRHI );
-	GRHI->SetRasterizerState( InDeviceContextRHI, GetRasterizerState() );
-	GRHI->SetBoundShaderState( InDeviceContextRHI, GetBoundShaderState() );
+	InDeviceContextRHI->SetRasterizerState( GetRasterizerState() );
+	InDeviceContextRHI->SetBoundShaderState( GetBoundShaderState() );
 }
 
 void CMeshDrawingPolicy::SetShaderParameters( class CBaseDeviceContextRHI* InDeviceContextRHI )
@@ -66,10 +71,61 @@ void CMeshDrawingPolicy::SetShaderParameters( class CBaseDeviceContextRHI* InDev
 	pixelShader->SetConstantParameters( InDeviceContextRHI, vertexFactory, materialRef );
 }
 
+void CMeshDrawingPolicy::SetRenderState( class CBaseDeviceContextRHI* InDeviceContextRHI, SDrawingPolicyStateCache& InOutStateCache )
+{
+	check( bInit );
+
+	if ( InOutStateCache.vertexFactory != vertexFactory.GetPtr() )
+	{
+		vertexFactory->Set( InDeviceContextRHI );
+		InOutStateCache.vertexFactory = vertexFactory.GetPtr();
+#if !SHIPPING_BUILD
+		appInterlockedIncrement( ( int32* )&GDrawListStats.numVertexFactoryChanges );
+#endif // !SHIPPING_BUILD
+	}
+
+	RasterizerStateRHIRef_t			newRasterizerState = GetRasterizerState();
+	if ( InOutStateCache.rasterizerState != newRasterizerState.GetPtr() )
+	{
+		InDeviceContextRHI->SetRasterizerState( newRasterizerState );
+		InOutStateCache.rasterizerState = newRasterizerState.GetPtr();
+#if !SHIPPING_BUILD
+		appInterlockedIncrement( ( int32* )&GDrawListStats.numRasterizerStateChanges );
+#endif // !SHIPPING_BUILD
+	}
+
+	BoundShaderStateRHIRef_t		newBoundShaderState = GetBoundShaderState();
+	if ( InOutStateCache.boundShaderState != newBoundShaderState.GetPtr() )
+	{
+		InDeviceContextRHI->SetBoundShaderState( newBoundShaderState );
+		InOutStateCache.boundShaderState = newBoundShaderState.GetPtr();
+#if !SHIPPING_BUILD
+		appInterlockedIncrement( ( int32* )&GDrawListStats.numBoundShaderStateChanges );
+#endif // !SHIPPING_BUILD
+	}
+}
+
+void CMeshDrawingPolicy::SetShaderParameters( class CBaseDeviceContextRHI* InDeviceContextRHI, SDrawingPolicyStateCache& InOutStateCache )
+{
+	check( bInit );
+
+	// Constant parameters depend only on material, vertex factory and shaders, also drawing policy can add own data in type hash (e.g. wireframe color)
+	uint64		shaderParametersHash = appMemFastHash( vertexFactory.GetPtr(), GetTypeHash() );
+	shaderParametersHash = appMemFastHash( vertexShader, shaderParametersHash );
+	shaderParametersHash = appMemFastHash( pixelShader, shaderParametersHash );
+	if ( InOutStateCache.shaderParametersHash != shaderParametersHash )
+	{
+		SetShaderParameters( InDeviceContextRHI );
+		InOutStateCache.shaderParametersHash = shaderParametersHash;
+#if !SHIPPING_BUILD
+		appInterlockedIncrement( ( int32* )&GDrawListStats.numShaderParametersChanges );
+#endif // !SHIPPING_BUILD
+	}
+}
+
 void CMeshDrawingPolicy::Draw( class CBaseDeviceContextRHI* InDeviceContextRHI, const struct SMeshBatch& InMeshBatch, const class CSceneView& InSceneView )
 {
-	TSharedPtr<CMaterial>		materialRef = material.ToSharedPtr();
-	SCOPED_DRAW_EVENT( EventDraw, DEC_MATERIAL, CString::Format( TEXT( "Material %s" ), materialRef ? materialRef->GetAssetName().c_str() : TEXT( "Unloaded" ) ).c_str());
+	SCOPED_DRAW_EVENTF( EventDraw, DEC_MATERIAL, TEXT( "Material %s" ), material.IsAssetValid() ? material.ToSharedPtr()->GetAssetName().c_str() : TEXT( "Unloaded" ) );
 
 	// If vertex factory not support instancig - draw without it
 	if ( !vertexFactory->SupportsInstancing() )
@@ -122,11 +178,22 @@ BoundShaderStateRHIRef_t CMeshDrawingPolicy::GetBoundShaderState() const
 		TSharedPtr<CMaterial>		materialRef = material.ToSharedPtr();
 		check( materialRef && vertexFactory && vertexShader && pixelShader );
 		
+		bool		bCreated = false;
 		boundShaderState = GRHI->CreateBoundShaderState(
 			materialRef->GetAssetName().c_str(),
 			vertexFactory->GetDeclaration(),
 			vertexShader->GetVertexShader(),
-			pixelShader->GetPixelShader() );
+			pixelShader->GetPixelShader(),
+			nullptr, nullptr, nullptr,
+			&bCreated );
+
+#if !SHIPPING_BUILD
+		// Bound shader state isn't warmed up at map load, so it's created while rendering
+		if ( bCreated )
+		{
+			appInterlockedIncrement( &GBoundShaderStateStats.numFirstUseCreations );
+		}
+#endif // !SHIPPING_BUILD
 	}
 
 	return boundShaderState;
@@ -135,10 +202,23 @@ BoundShaderStateRHIRef_t CMeshDrawingPolicy::GetBoundShaderState() const
 RasterizerStateRHIRef_t CMeshDrawingPolicy::GetRasterizerState() const
 {
 	TSharedPtr<CMaterial>		materialRef = material.ToSharedPtr();
+	const bool					bWireframe	= materialRef->IsWireframe();
+	const bool					bTwoSided	= materialRef->IsTwoSided();
+
+	// Without depth bias use static rasterizer states, so drawing policies share them and redundant sets are filtered by device context
+	if ( depthBias == 0.f )
+	{
+		if ( bWireframe )
+		{
+			return bTwoSided ? TStaticRasterizerStateRHI<FM_Wireframe, CM_None>::GetRHI() : TStaticRasterizerStateRHI<FM_Wireframe, CM_CW>::GetRHI();
+		}
+		return bTwoSided ? TStaticRasterizerStateRHI<FM_Solid, CM_None>::GetRHI() : TStaticRasterizerStateRHI<FM_Solid, CM_CW>::GetRHI();
+	}
+
 	const SRasterizerStateInitializerRHI		initializer =
 	{
-		materialRef->IsWireframe() ? FM_Wireframe : FM_Solid,
-		materialRef->IsTwoSided() ? CM_None : CM_CW,
+		bWireframe ? FM_Wireframe : FM_Solid,
+		bTwoSided ? CM_None : CM_CW,
 		depthBias,
 		0.f,
 		true
@@ -73,6 +73,6 @@ CSceneView* CGameViewportClient::CalcSceneView( CViewport* InViewport, const SCa
 	Vector		axisUp				= InCameraView.rotation * SMath::vectorUp;
 	Matrix		viewMatrix			= glm::lookAt( InCameraView.location, InCameraView.location + targetDirection, axisUp );
 
-	CSceneView*		sceneView = new CSceneView( InCameraView.location, projectionMatrix, viewMatrix, InViewport->GetSizeX(), InViewport->GetSizeY(), CColor::black, SHOW_DefaultGame );
+	CSceneView*		sceneView = new CSceneView( InCameraView.location, projectionMatrix, viewMatrix, InViewport->GetSizeX(), InViewport->GetSizeY(), CColor::black, SHOW_DefaultGame, GetViewKey() );
 	return sceneView;
 }
\ No newline at end of file
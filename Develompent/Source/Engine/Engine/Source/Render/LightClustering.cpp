@@ -0,0 +1,250 @@
+#include <float.h>
+#include <math.h>
+#include <xmmintrin.h>
+
+#include "Misc/Template.h"
+#include "Render/Scene.h"
+#include "Render/LightClustering.h"
+
+static_assert( LIGHTCLUSTER_GRID_SIZE_X % 4 == 0, "Number of columns must be multiple of 4" );
+
+CLightClusterGrid::CLightClusterGrid()
+	: bIsPerspective( false )
+	, sliceScale( 0.f )
+	, sliceBias( 0.f )
+	, numOccupiedClusters( 0 )
+{
+	clusters.resize( LIGHTCLUSTER_NUM_CLUSTERS );
+	Clear();
+}
+
+void CLightClusterGrid::Clear()
+{
+	appMemzero( clusters.data(), sizeof( SLightCluster ) * clusters.size() );
+	appMemzero( sliceDepths, sizeof( sliceDepths ) );
+	lightIndices.clear();
+	visibleLights.clear();
+	numOccupiedClusters = 0;
+}
+
+void CLightClusterGrid::Build( const class CSceneView& InSceneView, const Vector4D* InLightSpheres, uint32 InNumLights )
+{
+	Clear();
+	if ( InNumLights == 0 )
+	{
+		return;
+	}
+
+	const Matrix&		projectionMatrix		= InSceneView.GetProjectionMatrix();
+	const Matrix&		viewMatrix				= InSceneView.GetViewMatrix();
+	const Matrix		invProjectionMatrix		= SMath::InverseMatrix( projectionMatrix );
+	const CFrustum&		frustum					= InSceneView.GetFrustum();
+
+	// Depth range of view frustum, camera looks along -Z in view space
+	const Vector4D		viewNearPoint			= invProjectionMatrix * Vector4D( 0.f, 0.f, -1.f, 1.f );
+	const Vector4D		viewFarPoint			= invProjectionMatrix * Vector4D( 0.f, 0.f, 1.f, 1.f );
+	const float			viewNearDepth			= -viewNearPoint.z / viewNearPoint.w;
+	const float			viewFarDepth			= -viewFarPoint.z / viewFarPoint.w;
+
+	// Cull lights by frustum and transform them to view space. Depth range of clusters is fit to visible lights,
+	// so slices aren't wasted on empty space when far plane is very far
+	float				nearDepth				= FLT_MAX;
+	float				farDepth				= -FLT_MAX;
+	viewLights.resize( InNumLights );
+	for ( uint32 index = 0; index < InNumLights; ++index )
+	{
+		const Vector4D&		sphere		= InLightSpheres[ index ];
+		Vector4D&			viewLight	= viewLights[ index ];
+		if ( sphere.w <= 0.f || !frustum.IsIn( Vector( sphere ), sphere.w ) )
+		{
+			viewLight.w = -1.f;
+			continue;
+		}
+
+		const Vector4D		position	= viewMatrix * Vector4D( sphere.x, sphere.y, sphere.z, 1.f );
+		viewLight	= Vector4D( position.x, position.y, -position.z, sphere.w );
+		nearDepth	= Min( nearDepth, viewLight.z - viewLight.w );
+		farDepth	= Max( farDepth, viewLight.z + viewLight.w );
+	}
+
+	nearDepth	= Max( nearDepth, viewNearDepth );
+	farDepth	= Min( farDepth, viewFarDepth );
+	if ( nearDepth >= farDepth )
+	{
+		return;
+	}
+
+	BuildSlices( invProjectionMatrix, projectionMatrix[ 2 ][ 3 ] != 0.f, nearDepth, farDepth );
+
+	// Test each light against clusters of slices overlapped by it. Distance from sphere to box of cluster is separable
+	// by axes: X depends only on column, Y only on row and Z only on slice, so four columns are tested at once
+	const __m128		zero = _mm_setzero_ps();
+	__m128				columnDistancesSq[ LIGHTCLUSTER_GRID_SIZE_X / 4 ];
+	clusterLightPairs.clear();
+	for ( uint32 index = 0; index < InNumLights; ++index )
+	{
+		const Vector4D&		viewLight	= viewLights[ index ];
+		if ( viewLight.w < 0.f )
+		{
+			continue;
+		}
+
+		const float			radiusSq	= viewLight.w * viewLight.w;
+		const uint32		firstSlice	= GetSliceByDepth( viewLight.z - viewLight.w );
+		const uint32		lastSlice	= GetSliceByDepth( viewLight.z + viewLight.w );
+		const __m128		lightX		= _mm_set1_ps( viewLight.x );
+		const uint32		numPairs	= clusterLightPairs.size();
+		for ( uint32 slice = firstSlice; slice <= lastSlice; ++slice )
+		{
+			const float		distanceZ		= Max( sliceDepths[ slice ] - viewLight.z, Max( viewLight.z - sliceDepths[ slice + 1 ], 0.f ) );
+			const float		sliceRemainSq	= radiusSq - distanceZ * distanceZ;
+			if ( sliceRemainSq < 0.f )
+			{
+				continue;
+			}
+
+			const float*	sliceColumnMin	= &columnMin[ slice * LIGHTCLUSTER_GRID_SIZE_X ];
+			const float*	sliceColumnMax	= &columnMax[ slice * LIGHTCLUSTER_GRID_SIZE_X ];
+			for ( uint32 column = 0; column < LIGHTCLUSTER_GRID_SIZE_X / 4; ++column )
+			{
+				__m128		distance = _mm_max_ps( _mm_max_ps( _mm_sub_ps( _mm_loadu_ps( sliceColumnMin + column * 4 ), lightX ), _mm_sub_ps( lightX, _mm_loadu_ps( sliceColumnMax + column * 4 ) ) ), zero );
+				columnDistancesSq[ column ] = _mm_mul_ps( distance, distance );
+			}
+
+			for ( uint32 row = 0; row < LIGHTCLUSTER_GRID_SIZE_Y; ++row )
+			{
+				const uint32	rowIndex		= slice * LIGHTCLUSTER_GRID_SIZE_Y + row;
+				const float		distanceY		= Max( rowMin[ rowIndex ] - viewLight.y, Max( viewLight.y - rowMax[ rowIndex ], 0.f ) );
+				const float		rowRemainSq		= sliceRemainSq - distanceY * distanceY;
+				if ( rowRemainSq < 0.f )
+				{
+					continue;
+				}
+
+				const __m128	remainSq		= _mm_set1_ps( rowRemainSq );
+				const uint64	baseCluster		= rowIndex * LIGHTCLUSTER_GRID_SIZE_X;
+				for ( uint32 column = 0; column < LIGHTCLUSTER_GRID_SIZE_X / 4; ++column )
+				{
+					const uint32	mask = _mm_movemask_ps( _mm_cmple_ps( columnDistancesSq[ column ], remainSq ) );
+					for ( uint32 bit = 0; mask >> bit; ++bit )
+					{
+						if ( mask & ( 1 << bit ) )
+						{
+							clusterLightPairs.push_back( ( ( baseCluster + column * 4 + bit ) << 32 ) | index );
+						}
+					}
+				}
+			}
+		}
+
+		if ( clusterLightPairs.size() > numPairs )
+		{
+			visibleLights.push_back( index );
+		}
+	}
+
+	// Make lists of lights in clusters by counting sort, pairs are in order of lights so lists are sorted too
+	for ( uint32 index = 0, count = clusterLightPairs.size(); index < count; ++index )
+	{
+		++clusters[ clusterLightPairs[ index ] >> 32 ].numLights;
+	}
+
+	uint32		offset = 0;
+	for ( uint32 index = 0; index < LIGHTCLUSTER_NUM_CLUSTERS; ++index )
+	{
+		SLightCluster&		cluster = clusters[ index ];
+		numOccupiedClusters	+= cluster.numLights > 0 ? 1 : 0;
+		cluster.firstLight	= offset;
+		offset				+= cluster.numLights;
+		cluster.numLights	= 0;
+	}
+
+	lightIndices.resize( clusterLightPairs.size() );
+	for ( uint32 index = 0, count = clusterLightPairs.size(); index < count; ++index )
+	{
+		const uint64		pair	= clusterLightPairs[ index ];
+		SLightCluster&		cluster = clusters[ pair >> 32 ];
+		lightIndices[ cluster.firstLight + cluster.numLights++ ] = ( uint32 )pair;
+	}
+}
+
+void CLightClusterGrid::BuildSlices( const Matrix& InInvProjectionMatrix, bool InIsPerspective, float InNearDepth, float InFarDepth )
+{
+	// Slices are exponential for perspective projection, so clusters are close to cubes on all depths
+	bIsPerspective = InIsPerspective;
+	if ( bIsPerspective )
+	{
+		sliceScale	= LIGHTCLUSTER_GRID_SIZE_Z / logf( InFarDepth / InNearDepth );
+		sliceBias	= -logf( InNearDepth ) * sliceScale;
+	}
+	else
+	{
+		sliceScale	= LIGHTCLUSTER_GRID_SIZE_Z / ( InFarDepth - InNearDepth );
+		sliceBias	= -InNearDepth * sliceScale;
+	}
+
+	for ( uint32 slice = 0; slice <= LIGHTCLUSTER_GRID_SIZE_Z; ++slice )
+	{
+		const float		alpha = slice / ( float )LIGHTCLUSTER_GRID_SIZE_Z;
+		sliceDepths[ slice ] = bIsPerspective ? InNearDepth * powf( InFarDepth / InNearDepth, alpha ) : InNearDepth + ( InFarDepth - InNearDepth ) * alpha;
+	}
+	sliceDepths[ LIGHTCLUSTER_GRID_SIZE_Z ] = InFarDepth;
+
+	// Sides of tiles are lines in view space, so X of column side and Y of row side are linear functions of depth
+	auto		getSide = [&]( const Vector4D& InNearPoint, const Vector4D& InFarPoint, uint32 InAxis, float& OutValue, float& OutSlope )
+	{
+		const Vector4D		nearPoint	= InInvProjectionMatrix * InNearPoint;
+		const Vector4D		farPoint	= InInvProjectionMatrix * InFarPoint;
+		const float			nearDepth	= -nearPoint.z / nearPoint.w;
+		const float			farDepth	= -farPoint.z / farPoint.w;
+		OutSlope	= ( farPoint[ InAxis ] / farPoint.w - nearPoint[ InAxis ] / nearPoint.w ) / ( farDepth - nearDepth );
+		OutValue	= nearPoint[ InAxis ] / nearPoint.w - OutSlope * nearDepth;
+	};
+
+	float		columnSides[ LIGHTCLUSTER_GRID_SIZE_X + 1 ];
+	float		columnSlopes[ LIGHTCLUSTER_GRID_SIZE_X + 1 ];
+	for ( uint32 side = 0; side <= LIGHTCLUSTER_GRID_SIZE_X; ++side )
+	{
+		const float		x = -1.f + 2.f * side / LIGHTCLUSTER_GRID_SIZE_X;
+		getSide( Vector4D( x, 0.f, -1.f, 1.f ), Vector4D( x, 0.f, 1.f, 1.f ), 0, columnSides[ side ], columnSlopes[ side ] );
+	}
+
+	float		rowSides[ LIGHTCLUSTER_GRID_SIZE_Y + 1 ];
+	float		rowSlopes[ LIGHTCLUSTER_GRID_SIZE_Y + 1 ];
+	for ( uint32 side = 0; side <= LIGHTCLUSTER_GRID_SIZE_Y; ++side )
+	{
+		const float		y = -1.f + 2.f * side / LIGHTCLUSTER_GRID_SIZE_Y;
+		getSide( Vector4D( 0.f, y, -1.f, 1.f ), Vector4D( 0.f, y, 1.f, 1.f ), 1, rowSides[ side ], rowSlopes[ side ] );
+	}
+
+	// Bounds of columns and rows in each slice are taken on both depths of slice
+	for ( uint32 slice = 0; slice < LIGHTCLUSTER_GRID_SIZE_Z; ++slice )
+	{
+		const float		nearDepth	= sliceDepths[ slice ];
+		const float		farDepth	= sliceDepths[ slice + 1 ];
+		for ( uint32 column = 0; column < LIGHTCLUSTER_GRID_SIZE_X; ++column )
+		{
+			const uint32	index = slice * LIGHTCLUSTER_GRID_SIZE_X + column;
+			columnMin[ index ] = Min( columnSides[ column ] + columnSlopes[ column ] * nearDepth, columnSides[ column ] + columnSlopes[ column ] * farDepth );
+			columnMax[ index ] = Max( columnSides[ column + 1 ] + columnSlopes[ column + 1 ] * nearDepth, columnSides[ column + 1 ] + columnSlopes[ column + 1 ] * farDepth );
+		}
+
+		for ( uint32 row = 0; row < LIGHTCLUSTER_GRID_SIZE_Y; ++row )
+		{
+			const uint32	index = slice * LIGHTCLUSTER_GRID_SIZE_Y + row;
+			rowMin[ index ] = Min( rowSides[ row ] + rowSlopes[ row ] * nearDepth, rowSides[ row ] + rowSlopes[ row ] * farDepth );
+			rowMax[ index ] = Max( rowSides[ row + 1 ] + rowSlopes[ row + 1 ] * nearDepth, rowSides[ row + 1 ] + rowSlopes[ row + 1 ] * farDepth );
+		}
+	}
+}
+
+uint32 CLightClusterGrid::GetSliceByDepth( float InDepth ) const
+{
+	if ( InDepth <= sliceDepths[ 0 ] )
+	{
+		return 0;
+	}
+
+	const float		slice = ( bIsPerspective ? logf( InDepth ) : InDepth ) * sliceScale + sliceBias;
+	return slice < LIGHTCLUSTER_GRID_SIZE_Z ? Max<int32>( ( int32 )slice, 0 ) : LIGHTCLUSTER_GRID_SIZE_Z - 1;
+}
\ No newline at end of file
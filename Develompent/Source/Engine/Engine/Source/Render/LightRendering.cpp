@@ -93,12 +93,12 @@ public:
 		switch ( InPassType )
 		{
 		case PT_Base:
-			GRHI->SetDepthState( InDeviceContextRHI, TStaticDepthStateRHI<false, CF_Always>::GetRHI() );
-			GRHI->SetBlendState( InDeviceContextRHI, TStaticBlendStateRHI<BO_Add, BF_One, BF_One>::GetRHI() );
+			InDeviceContextRHI->SetDepthState( TStaticDepthStateRHI<false, CF_Always>::GetRHI() );
+			InDeviceContextRHI->SetBlendState( TStaticBlendStateRHI<BO_Add, BF_One, BF_One>::GetRHI() );
 			break;
 
 		case PT_Stencil:
-			GRHI->SetDepthState( InDeviceContextRHI, TStaticDepthStateRHI<false, CF_LessEqual>::GetRHI() );
+			InDeviceContextRHI->SetDepthState( TStaticDepthStateRHI<false, CF_LessEqual>::GetRHI() );
 			break;
 
 		default:
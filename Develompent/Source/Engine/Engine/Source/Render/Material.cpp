@@ -20,6 +20,7 @@ CMaterial::CMaterial() :
 	isNeedUpdateShaderMap( true ),
 	isTwoSided( false ),
 	isWireframe( false ),
+	isMasked( false ),
 	usage( MU_AllMeshes )
 {}
 
@@ -46,6 +47,16 @@ void CMaterial::Serialize( class CArchive& InArchive )
 	InArchive << isWireframe;
 	InArchive << usage;
 
+	// Old materials may have holes in diffuse texture, so they are masked
+	if ( InArchive.Ver() >= VER_MaterialMasked )
+	{
+		InArchive << isMasked;
+	}
+	else if ( InArchive.IsLoading() )
+	{
+		isMasked = true;
+	}
+
 	if ( InArchive.Ver() < VER_RemovedShadersTypeFromMaterial )
 	{
 		class CShaderMetaType*		shadersType[ SF_NumDrawFrequencies ];
@@ -90,6 +101,20 @@ void CMaterial::Serialize( class CArchive& InArchive )
 	}
 }
 
+void CMaterial::GetUsedVertexFactoryHashes( std::vector< uint64 >& OutVertexFactoryHashes ) const
+{
+	if ( usage & MU_StaticMesh )
+	{
+		OutVertexFactoryHashes.push_back( CStaticMeshVertexFactory::staticType.GetHash() );
+		OutVertexFactoryHashes.push_back( CStaticMeshPackedVertexFactory::staticType.GetHash() );
+	}
+
+	if ( usage & MU_Sprite )
+	{
+		OutVertexFactoryHashes.push_back( CSpriteVertexFactory::staticType.GetHash() );
+	}
+}
+
 CShader* CMaterial::GetShader( uint64 InVertexFactoryHash, EShaderFrequency InShaderFrequency )
 {
 	check( InShaderFrequency < SF_NumDrawFrequencies );
@@ -115,14 +140,18 @@ void CMaterial::CacheShaderMap()
 
 	// If material usage for render static mesh
 	{
-		const uint64			vertexFactoryHash = CStaticMeshVertexFactory::staticType.GetHash();
-		if ( usage & MU_StaticMesh )
-		{	
-			shaderMap[ vertexFactoryHash ] = GetMeshShaders( vertexFactoryHash );
-		}
-		else
+		const uint64			vertexFactoryHashes[] = { CStaticMeshVertexFactory::staticType.GetHash(), CStaticMeshPackedVertexFactory::staticType.GetHash() };
+		for ( uint32 index = 0; index < ARRAY_COUNT( vertexFactoryHashes ); ++index )
 		{
-			shaderMap.erase( vertexFactoryHash );
+			const uint64		vertexFactoryHash = vertexFactoryHashes[ index ];
+			if ( usage & MU_StaticMesh )
+			{
+				shaderMap[ vertexFactoryHash ] = GetMeshShaders( vertexFactoryHash );
+			}
+			else
+			{
+				shaderMap.erase( vertexFactoryHash );
+			}
 		}
 	}
 
@@ -0,0 +1,356 @@
+#include <float.h>
+#include <math.h>
+#include <algorithm>
+#include <xmmintrin.h>
+
+#include "Misc/Misc.h"
+#include "Misc/CoreGlobals.h"
+#include "Misc/Template.h"
+#include "Render/Scene.h"
+#include "Render/OcclusionCulling.h"
+
+//
+// Definitions
+//
+
+/* Min W of verteces in clip space, triangles and boxes closer to camera are crossing the near plane */
+#define OCCLUSION_MIN_W					0.0001f
+
+/* Max distance of verteces from the buffer in pixels, farther triangles lose precision of edge functions and aren't rasterized */
+#define OCCLUSION_GUARD_BAND			65536.f
+
+/* Number of tiles by each axis */
+#define OCCLUSION_NUM_TILES_X			( OCCLUSION_BUFFER_SIZE_X / OCCLUSION_TILE_SIZE )
+#define OCCLUSION_NUM_TILES_Y			( OCCLUSION_BUFFER_SIZE_Y / OCCLUSION_TILE_SIZE )
+
+static_assert( OCCLUSION_BUFFER_SIZE_X % OCCLUSION_TILE_SIZE == 0 && OCCLUSION_BUFFER_SIZE_Y % OCCLUSION_TILE_SIZE == 0, "Size of occlusion buffer must be multiple of tile size" );
+static_assert( OCCLUSION_TILE_SIZE % 4 == 0, "Size of tile must be multiple of 4" );
+static_assert( OCCLUSION_NUM_TILES_Y >= OCCLUSION_MAX_BANDS, "Each band must contain at least one row of tiles" );
+
+//
+// Globals
+//
+
+#if !SHIPPING_BUILD
+/* Statistics of occlusion culling of the last built view */
+SOcclusionStats		GOcclusionStats;
+#endif // !SHIPPING_BUILD
+
+COcclusionBuffer::COcclusionBuffer()
+	: viewProjectionMatrix( SMath::matrixIdentity )
+	, numBands( 1 )
+{
+	depthBuffer.resize( OCCLUSION_BUFFER_SIZE_X * OCCLUSION_BUFFER_SIZE_Y, 1.f );
+	hiZBuffer.resize( OCCLUSION_NUM_TILES_X * OCCLUSION_NUM_TILES_Y, 1.f );
+	bandMinY[ 0 ] = 0;
+	bandMinY[ 1 ] = OCCLUSION_BUFFER_SIZE_Y;
+}
+
+void COcclusionBuffer::Begin( const class CSceneView& InSceneView )
+{
+	viewProjectionMatrix = InSceneView.GetViewProjectionMatrix();
+	occluders.clear();
+	stats.Reset();
+}
+
+void COcclusionBuffer::AddOccluder( const Vector* InVerteces, const uint32* InIndeces, uint32 InNumIndeces, const Matrix& InLocalToWorld )
+{
+	check( InVerteces && InIndeces );
+	if ( InNumIndeces < 3 )
+	{
+		return;
+	}
+
+	occluders.push_back( SOccluder{ InVerteces, InIndeces, InNumIndeces, viewProjectionMatrix * InLocalToWorld } );
+	++stats.numOccluders;
+	stats.numOccluderTriangles += InNumIndeces / 3;
+}
+
+void COcclusionBuffer::Rasterize()
+{
+	const double		startTime = appSeconds();
+
+	// Each thread rasterizes own band, bands are aligned to rows of tiles for build hierarchical Z buffer without synchronization
+	numBands = Min<uint32>( GNumRenderingWorkerThreads + 1, OCCLUSION_MAX_BANDS );
+	for ( uint32 index = 0; index <= numBands; ++index )
+	{
+		bandMinY[ index ] = OCCLUSION_NUM_TILES_Y * index / numBands * OCCLUSION_TILE_SIZE;
+	}
+
+	SetupTriangles();
+	if ( stats.numRasterizedTriangles == 0 )
+	{
+		stats.rasterizeTime = appSeconds() - startTime;
+		return;
+	}
+
+	ParallelFor( numBands, [this]( uint32 InBandIndex )
+	{
+		RasterizeBand( InBandIndex );
+	} );
+
+	stats.rasterizeTime = appSeconds() - startTime;
+}
+
+void COcclusionBuffer::SetupTriangles()
+{
+	triangles.clear();
+	for ( uint32 index = 0; index < numBands; ++index )
+	{
+		bandTriangles[ index ].clear();
+	}
+
+	for ( uint32 occluderIndex = 0, numOccluders = occluders.size(); occluderIndex < numOccluders; ++occluderIndex )
+	{
+		// Transform verteces used by occluder to clip space
+		const SOccluder&	occluder	= occluders[ occluderIndex ];
+		uint32				numVerteces	= 0;
+		for ( uint32 index = 0; index < occluder.numIndeces; ++index )
+		{
+			numVerteces = Max( numVerteces, occluder.indeces[ index ] + 1 );
+		}
+
+		clipVerteces.resize( numVerteces );
+		for ( uint32 index = 0; index < numVerteces; ++index )
+		{
+			clipVerteces[ index ] = occluder.localToClip * Vector4D( occluder.verteces[ index ], 1.f );
+		}
+
+		for ( uint32 index = 0; index + 2 < occluder.numIndeces; index += 3 )
+		{
+			// Triangles crossing the near plane aren't rasterized, so occluders never hide more than they really cover
+			float		x[ 3 ], y[ 3 ], z[ 3 ];
+			bool		bRejected = false;
+			for ( uint32 corner = 0; corner < 3 && !bRejected; ++corner )
+			{
+				const Vector4D&		position = clipVerteces[ occluder.indeces[ index + corner ] ];
+				if ( position.w < OCCLUSION_MIN_W || position.z < -position.w )
+				{
+					bRejected = true;
+					break;
+				}
+
+				const float			invW = 1.f / position.w;
+				x[ corner ] = ( position.x * invW * 0.5f + 0.5f ) * OCCLUSION_BUFFER_SIZE_X;
+				y[ corner ] = ( position.y * invW * 0.5f + 0.5f ) * OCCLUSION_BUFFER_SIZE_Y;
+				z[ corner ] = position.z * invW;
+				bRejected = fabsf( x[ corner ] ) > OCCLUSION_GUARD_BAND || fabsf( y[ corner ] ) > OCCLUSION_GUARD_BAND;
+			}
+
+			if ( bRejected )
+			{
+				continue;
+			}
+
+			// Bounds of pixels which centers can be covered by triangle
+			const int32		minX = Max<int32>( ( int32 )ceilf( Min( x[ 0 ], Min( x[ 1 ], x[ 2 ] ) ) - 0.5f ), 0 );
+			const int32		maxX = Min<int32>( ( int32 )floorf( Max( x[ 0 ], Max( x[ 1 ], x[ 2 ] ) ) - 0.5f ), OCCLUSION_BUFFER_SIZE_X - 1 );
+			const int32		minY = Max<int32>( ( int32 )ceilf( Min( y[ 0 ], Min( y[ 1 ], y[ 2 ] ) ) - 0.5f ), 0 );
+			const int32		maxY = Min<int32>( ( int32 )floorf( Max( y[ 0 ], Max( y[ 1 ], y[ 2 ] ) ) - 0.5f ), OCCLUSION_BUFFER_SIZE_Y - 1 );
+			if ( minX > maxX || minY > maxY )
+			{
+				continue;
+			}
+
+			// Both sides of triangles are rasterized, clockwise triangles are flipped so inside of triangle is positive for all edges
+			float			area = ( x[ 1 ] - x[ 0 ] ) * ( y[ 2 ] - y[ 0 ] ) - ( y[ 1 ] - y[ 0 ] ) * ( x[ 2 ] - x[ 0 ] );
+			if ( fabsf( area ) < FLT_EPSILON )
+			{
+				continue;
+			}
+			else if ( area < 0.f )
+			{
+				Swap( x[ 1 ], x[ 2 ] );
+				Swap( y[ 1 ], y[ 2 ] );
+				Swap( z[ 1 ], z[ 2 ] );
+				area = -area;
+			}
+
+			STriangle		triangle;
+			for ( uint32 edge = 0; edge < 3; ++edge )
+			{
+				const uint32	next = ( edge + 1 ) % 3;
+				triangle.edgeA[ edge ] = y[ edge ] - y[ next ];
+				triangle.edgeB[ edge ] = x[ next ] - x[ edge ];
+				triangle.edgeC[ edge ] = x[ edge ] * y[ next ] - y[ edge ] * x[ next ];
+			}
+
+			// Depth in normalized device coordinates is linear in screen space
+			const float		invArea	= 1.f / area;
+			triangle.depthA	= ( ( z[ 1 ] - z[ 0 ] ) * ( y[ 2 ] - y[ 0 ] ) - ( z[ 2 ] - z[ 0 ] ) * ( y[ 1 ] - y[ 0 ] ) ) * invArea;
+			triangle.depthB	= ( ( z[ 2 ] - z[ 0 ] ) * ( x[ 1 ] - x[ 0 ] ) - ( z[ 1 ] - z[ 0 ] ) * ( x[ 2 ] - x[ 0 ] ) ) * invArea;
+			triangle.depthC	= z[ 0 ] - triangle.depthA * x[ 0 ] - triangle.depthB * y[ 0 ];
+			triangle.minX	= minX;
+			triangle.maxX	= maxX;
+			triangle.minY	= minY;
+			triangle.maxY	= maxY;
+
+			// Bin triangle into bands overlapped by it
+			const uint32	triangleIndex = triangles.size();
+			triangles.push_back( triangle );
+			for ( uint32 bandIndex = 0; bandIndex < numBands; ++bandIndex )
+			{
+				if ( minY < ( int32 )bandMinY[ bandIndex + 1 ] && maxY >= ( int32 )bandMinY[ bandIndex ] )
+				{
+					bandTriangles[ bandIndex ].push_back( triangleIndex );
+				}
+			}
+		}
+	}
+
+	stats.numRasterizedTriangles = triangles.size();
+}
+
+void COcclusionBuffer::RasterizeBand( uint32 InBandIndex )
+{
+	check( InBandIndex < numBands );
+	const int32					bandMin			= bandMinY[ InBandIndex ];
+	const int32					bandMax			= bandMinY[ InBandIndex + 1 ] - 1;
+	const std::vector<uint32>&	bandTriangleIds	= bandTriangles[ InBandIndex ];
+
+	// Clear band
+	std::fill( depthBuffer.begin() + bandMin * OCCLUSION_BUFFER_SIZE_X, depthBuffer.begin() + ( bandMax + 1 ) * OCCLUSION_BUFFER_SIZE_X, 1.f );
+
+	// Rasterize triangles by four pixels, pixels inside all edges keep min depth
+	const __m128		offsets		= _mm_set_ps( 3.5f, 2.5f, 1.5f, 0.5f );
+	const __m128		zero		= _mm_setzero_ps();
+	for ( uint32 index = 0, count = bandTriangleIds.size(); index < count; ++index )
+	{
+		const STriangle&	triangle	= triangles[ bandTriangleIds[ index ] ];
+		const int32			startX		= triangle.minX & ~3;
+		const int32			startY		= Max( triangle.minY, bandMin );
+		const int32			endY		= Min( triangle.maxY, bandMax );
+
+		const __m128		edgeStep0	= _mm_set1_ps( triangle.edgeA[ 0 ] * 4.f );
+		const __m128		edgeStep1	= _mm_set1_ps( triangle.edgeA[ 1 ] * 4.f );
+		const __m128		edgeStep2	= _mm_set1_ps( triangle.edgeA[ 2 ] * 4.f );
+		const __m128		depthStep	= _mm_set1_ps( triangle.depthA * 4.f );
+		const __m128		columnX		= _mm_add_ps( _mm_set1_ps( ( float )startX ), offsets );
+		const __m128		edgeX0		= _mm_mul_ps( _mm_set1_ps( triangle.edgeA[ 0 ] ), columnX );
+		const __m128		edgeX1		= _mm_mul_ps( _mm_set1_ps( triangle.edgeA[ 1 ] ), columnX );
+		const __m128		edgeX2		= _mm_mul_ps( _mm_set1_ps( triangle.edgeA[ 2 ] ), columnX );
+		const __m128		depthX		= _mm_mul_ps( _mm_set1_ps( triangle.depthA ), columnX );
+
+		for ( int32 y = startY; y <= endY; ++y )
+		{
+			const float		pixelY	= y + 0.5f;
+			__m128			edge0	= _mm_add_ps( edgeX0, _mm_set1_ps( triangle.edgeB[ 0 ] * pixelY + triangle.edgeC[ 0 ] ) );
+			__m128			edge1	= _mm_add_ps( edgeX1, _mm_set1_ps( triangle.edgeB[ 1 ] * pixelY + triangle.edgeC[ 1 ] ) );
+			__m128			edge2	= _mm_add_ps( edgeX2, _mm_set1_ps( triangle.edgeB[ 2 ] * pixelY + triangle.edgeC[ 2 ] ) );
+			__m128			depth	= _mm_add_ps( depthX, _mm_set1_ps( triangle.depthB * pixelY + triangle.depthC ) );
+			float*			row		= &depthBuffer[ y * OCCLUSION_BUFFER_SIZE_X ];
+
+			for ( int32 x = startX; x <= triangle.maxX; x += 4 )
+			{
+				const __m128	mask = _mm_and_ps( _mm_and_ps( _mm_cmpge_ps( edge0, zero ), _mm_cmpge_ps( edge1, zero ) ), _mm_cmpge_ps( edge2, zero ) );
+				if ( _mm_movemask_ps( mask ) )
+				{
+					const __m128	oldDepth = _mm_loadu_ps( row + x );
+					_mm_storeu_ps( row + x, _mm_or_ps( _mm_and_ps( mask, _mm_min_ps( oldDepth, depth ) ), _mm_andnot_ps( mask, oldDepth ) ) );
+				}
+
+				edge0	= _mm_add_ps( edge0, edgeStep0 );
+				edge1	= _mm_add_ps( edge1, edgeStep1 );
+				edge2	= _mm_add_ps( edge2, edgeStep2 );
+				depth	= _mm_add_ps( depth, depthStep );
+			}
+		}
+	}
+
+	// Build hierarchical Z buffer for tiles of band
+	for ( int32 tileY = bandMin / OCCLUSION_TILE_SIZE, endTileY = ( bandMax + 1 ) / OCCLUSION_TILE_SIZE; tileY < endTileY; ++tileY )
+	{
+		for ( uint32 tileX = 0; tileX < OCCLUSION_NUM_TILES_X; ++tileX )
+		{
+			__m128		maxDepth = _mm_set1_ps( -FLT_MAX );
+			for ( uint32 y = 0; y < OCCLUSION_TILE_SIZE; ++y )
+			{
+				const float*	row = &depthBuffer[ ( tileY * OCCLUSION_TILE_SIZE + y ) * OCCLUSION_BUFFER_SIZE_X + tileX * OCCLUSION_TILE_SIZE ];
+				for ( uint32 x = 0; x < OCCLUSION_TILE_SIZE; x += 4 )
+				{
+					maxDepth = _mm_max_ps( maxDepth, _mm_loadu_ps( row + x ) );
+				}
+			}
+
+			maxDepth = _mm_max_ps( maxDepth, _mm_shuffle_ps( maxDepth, maxDepth, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+			maxDepth = _mm_max_ps( maxDepth, _mm_shuffle_ps( maxDepth, maxDepth, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+			_mm_store_ss( &hiZBuffer[ tileY * OCCLUSION_NUM_TILES_X + tileX ], maxDepth );
+		}
+	}
+}
+
+bool COcclusionBuffer::IsVisible( const CBox& InBox )
+{
+	++stats.numTested;
+	if ( !HasOccluders() || !InBox.IsValid() )
+	{
+		return true;
+	}
+
+	// Project corners of box to screen, boxes crossing the near plane are always visible
+	const Vector&		boxMin		= InBox.GetMin();
+	const Vector&		boxMax		= InBox.GetMax();
+	float				minX		= FLT_MAX;
+	float				maxX		= -FLT_MAX;
+	float				minY		= FLT_MAX;
+	float				maxY		= -FLT_MAX;
+	float				minZ		= FLT_MAX;
+	for ( uint32 corner = 0; corner < 8; ++corner )
+	{
+		const Vector4D		position = viewProjectionMatrix * Vector4D( corner & 1 ? boxMax.x : boxMin.x, corner & 2 ? boxMax.y : boxMin.y, corner & 4 ? boxMax.z : boxMin.z, 1.f );
+		if ( position.w < OCCLUSION_MIN_W || position.z < -position.w )
+		{
+			return true;
+		}
+
+		const float			invW	= 1.f / position.w;
+		const float			x		= ( position.x * invW * 0.5f + 0.5f ) * OCCLUSION_BUFFER_SIZE_X;
+		const float			y		= ( position.y * invW * 0.5f + 0.5f ) * OCCLUSION_BUFFER_SIZE_Y;
+		minX	= Min( minX, x );
+		maxX	= Max( maxX, x );
+		minY	= Min( minY, y );
+		maxY	= Max( maxY, y );
+		minZ	= Min( minZ, position.z * invW );
+	}
+
+	// Pixels overlapped by rect of box, boxes out of screen are left to frustum culling
+	const int32		startX	= Max<int32>( ( int32 )floorf( Clamp( minX, -1.f, ( float )OCCLUSION_BUFFER_SIZE_X ) ), 0 );
+	const int32		endX	= Min<int32>( ( int32 )floorf( Clamp( maxX, -1.f, ( float )OCCLUSION_BUFFER_SIZE_X ) ), OCCLUSION_BUFFER_SIZE_X - 1 );
+	const int32		startY	= Max<int32>( ( int32 )floorf( Clamp( minY, -1.f, ( float )OCCLUSION_BUFFER_SIZE_Y ) ), 0 );
+	const int32		endY	= Min<int32>( ( int32 )floorf( Clamp( maxY, -1.f, ( float )OCCLUSION_BUFFER_SIZE_Y ) ), OCCLUSION_BUFFER_SIZE_Y - 1 );
+	if ( startX > endX || startY > endY )
+	{
+		return true;
+	}
+
+	// Tiles which farthest depth is closer than box are fully occluding, other ones are tested by pixels
+	for ( int32 tileY = startY / OCCLUSION_TILE_SIZE, endTileY = endY / OCCLUSION_TILE_SIZE; tileY <= endTileY; ++tileY )
+	{
+		for ( int32 tileX = startX / OCCLUSION_TILE_SIZE, endTileX = endX / OCCLUSION_TILE_SIZE; tileX <= endTileX; ++tileX )
+		{
+			if ( hiZBuffer[ tileY * OCCLUSION_NUM_TILES_X + tileX ] < minZ )
+			{
+				continue;
+			}
+
+			const int32		pixelStartX	= Max( startX, tileX * OCCLUSION_TILE_SIZE );
+			const int32		pixelEndX	= Min( endX, tileX * OCCLUSION_TILE_SIZE + OCCLUSION_TILE_SIZE - 1 );
+			const int32		pixelStartY	= Max( startY, tileY * OCCLUSION_TILE_SIZE );
+			const int32		pixelEndY	= Min( endY, tileY * OCCLUSION_TILE_SIZE + OCCLUSION_TILE_SIZE - 1 );
+			for ( int32 y = pixelStartY; y <= pixelEndY; ++y )
+			{
+				const float*	row = &depthBuffer[ y * OCCLUSION_BUFFER_SIZE_X ];
+				for ( int32 x = pixelStartX; x <= pixelEndX; ++x )
+				{
+					if ( row[ x ] >= minZ )
+					{
+						return true;
+					}
+				}
+			}
+		}
+	}
+
+	++stats.numCulled;
+	return false;
+}
\ No newline at end of file
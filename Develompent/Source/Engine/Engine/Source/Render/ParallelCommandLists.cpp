@@ -0,0 +1,378 @@
+#include "Misc/Misc.h"
+#include "Misc/EngineGlobals.h"
+#include "RHI/BaseRHI.h"
+#include "RHI/BaseDeviceContextRHI.h"
+#include "Logger/BaseLogger.h"
+#include "Logger/LoggerMacros.h"
+#include "Render/ParallelCommandLists.h"
+#include "Render/SceneUtils.h"
+
+//
+// Definitions
+//
+
+/* Value of next task index when there is no job. Workers which woke up late are incremented it and see that all tasks are taken */
+#define NO_PARALLEL_JOB		0x40000000
+
+//
+// Globals
+//
+
+/* Number of rendering worker threads */
+uint32			GNumRenderingWorkerThreads = 0;
+
+/* IDs of rendering worker threads */
+uint32			GRenderingWorkerThreadIds[ MAX_RENDERING_WORKER_THREADS ];
+
+/* Whether the rendering thread records draws to deferred command lists now */
+bool			GIsRecordingCommandLists = false;
+
+/* Current job of the rendering worker threads */
+static struct SParallelJob
+{
+	const ParallelForFunction_t*	function;		/**< Function of job */
+	int32						numTasks;			/**< Number of parallel tasks */
+	volatile int32				nextTask;			/**< Index of next not taken task */
+	volatile int32				numCompleted;		/**< Number of recorded tasks */
+	CEvent*						doneEvent;			/**< Event of recorded all tasks */
+} GParallelJob = { nullptr, 0, NO_PARALLEL_JOB, 0, nullptr };
+
+/* Pool of command lists, they are reused between frames */
+static std::vector< CommandListRHIRef_t >		GCommandListPool;
+
+/**
+ * @ingroup Engine
+ * Execute tasks of current job while there are not taken tasks
+ * @note Called from the rendering thread and from the rendering worker threads
+ */
+static void ExecuteParallelTasks()
+{
+	while ( true )
+	{
+		// Take next task, it is a full memory barrier, so after it the job is visible
+		const int32		taskIndex = appInterlockedIncrement( &GParallelJob.nextTask ) - 1;
+		if ( taskIndex >= GParallelJob.numTasks )
+		{
+			break;
+		}
+
+		( *GParallelJob.function )( taskIndex );
+
+		// The last executed task wakes up the rendering thread
+		if ( appInterlockedIncrement( &GParallelJob.numCompleted ) == GParallelJob.numTasks )
+		{
+			GParallelJob.doneEvent->Trigger();
+		}
+	}
+}
+
+/**
+ * @ingroup Engine
+ * @brief The rendering worker thread runnable object
+ */
+class CRenderingWorkerThread : public CRunnable
+{
+public:
+	/**
+	 * @brief Constructor
+	 */
+	CRenderingWorkerThread()
+		: bStopping( false )
+		, workEvent( nullptr )
+	{}
+
+	/**
+	 * @brief Initialize
+	 * @return True if initialization was successful, false otherwise
+	 */
+	virtual bool Init() override
+	{
+		return true;
+	}
+
+	/**
+	 * @brief Run
+	 * @return The exit code of the runnable object
+	 */
+	virtual uint32 Run() override
+	{
+		while ( true )
+		{
+			workEvent->Wait();
+			if ( bStopping )
+			{
+				break;
+			}
+
+			ExecuteParallelTasks();
+		}
+		return 0;
+	}
+
+	/**
+	 * @brief Stop
+	 */
+	virtual void Stop() override
+	{
+		bStopping = true;
+		workEvent->Trigger();
+	}
+
+	/**
+	 * @brief Exit
+	 */
+	virtual void Exit() override
+	{}
+
+	/**
+	 * @brief Wake up the thread for recording tasks of current job
+	 */
+	FORCEINLINE void WakeUp()
+	{
+		workEvent->Trigger();
+	}
+
+	volatile bool		bStopping;		/**< Is thread stopping */
+	CEvent*				workEvent;		/**< Event of new job */
+};
+
+/* Rendering worker threads */
+static CRunnableThread*				GRenderingWorkerThreads[ MAX_RENDERING_WORKER_THREADS ];
+static CRenderingWorkerThread*		GRenderingWorkerThreadRunnables[ MAX_RENDERING_WORKER_THREADS ];
+
+/**
+ * @ingroup Engine
+ * Publish job to the rendering worker threads
+ * @note Must be called from the rendering thread
+ *
+ * @param InNumTasks	Number of tasks
+ * @param InFunction	Function of job, it must be valid until FinishParallelJob is called
+ */
+static void BeginParallelJob( uint32 InNumTasks, const ParallelForFunction_t& InFunction )
+{
+	check( IsInRenderingThread() && !GParallelJob.function );
+	if ( !GParallelJob.doneEvent )
+	{
+		GParallelJob.doneEvent = GSynchronizeFactory->CreateSynchEvent( false, TEXT( "ParallelJobDone" ) );
+		check( GParallelJob.doneEvent );
+	}
+
+	GParallelJob.function		= &InFunction;
+	GParallelJob.numTasks		= InNumTasks;
+	GParallelJob.numCompleted	= 0;
+	appInterlockedExchange( &GParallelJob.nextTask, 0 );
+
+	for ( uint32 index = 0, count = Min<uint32>( GNumRenderingWorkerThreads, InNumTasks ); index < count; ++index )
+	{
+		GRenderingWorkerThreadRunnables[ index ]->WakeUp();
+	}
+}
+
+/**
+ * @ingroup Engine
+ * Help the rendering worker threads with current job and wait for its completion
+ * @note Must be called from the rendering thread
+ */
+static void FinishParallelJob()
+{
+	check( IsInRenderingThread() && GParallelJob.function );
+	ExecuteParallelTasks();
+	while ( GParallelJob.numCompleted < GParallelJob.numTasks )
+	{
+		GParallelJob.doneEvent->Wait();
+	}
+
+	// Workers which woke up late must not take tasks of this job
+	appInterlockedExchange( &GParallelJob.nextTask, NO_PARALLEL_JOB );
+	GParallelJob.function = nullptr;
+}
+
+void ParallelFor( uint32 InNum, const ParallelForFunction_t& InFunction )
+{
+	// The job is shared by all rendering worker threads, so only the rendering thread publishes it and jobs aren't nested
+	if ( InNum < 2 || GNumRenderingWorkerThreads == 0 || !IsInRenderingThread() || GParallelJob.function )
+	{
+		for ( uint32 index = 0; index < InNum; ++index )
+		{
+			InFunction( index );
+		}
+		return;
+	}
+
+	BeginParallelJob( InNum, InFunction );
+	FinishParallelJob();
+}
+
+CParallelCommandListSet::CParallelCommandListSet( class CBaseDeviceContextRHI* InImmediateContext )
+	: immediateContext( InImmediateContext )
+{}
+
+bool CParallelCommandListSet::IsAvailable()
+{
+	if ( GNumRenderingWorkerThreads == 0 )
+	{
+		return false;
+	}
+
+	// RHI without deferred command lists records directly to the immediate context, so it can't record in parallel
+	if ( GCommandListPool.empty() )
+	{
+		CommandListRHIRef_t		commandList = GRHI->CreateCommandList();
+		if ( !commandList || !commandList->IsDeferred() )
+		{
+			return false;
+		}
+		GCommandListPool.push_back( commandList );
+	}
+	return true;
+}
+
+void CParallelCommandListSet::DispatchSerial()
+{
+	for ( uint32 index = 0, count = tasks.size(); index < count; ++index )
+	{
+		STask&		task = tasks[ index ];
+		SCOPED_DRAW_EVENT( EventTask, task.color, task.name );
+		task.function( immediateContext );
+	}
+	tasks.clear();
+}
+
+void CParallelCommandListSet::RecordTask( STask& InTask )
+{
+	InTask.function( InTask.commandList->GetDeviceContext() );
+	GRHI->EndCommandList( InTask.commandList );
+}
+
+void CParallelCommandListSet::Dispatch()
+{
+	check( IsInRenderingThread() );
+	if ( tasks.size() < 2 || !IsAvailable() )
+	{
+		DispatchSerial();
+		return;
+	}
+
+	// Grow the pool of command lists
+	while ( GCommandListPool.size() < tasks.size() )
+	{
+		CommandListRHIRef_t		commandList = GRHI->CreateCommandList();
+		if ( !commandList )
+		{
+			DispatchSerial();
+			return;
+		}
+		GCommandListPool.push_back( commandList );
+	}
+
+	// Take command lists from the pool and inherit state of the immediate context
+	for ( uint32 index = 0, count = tasks.size(); index < count; ++index )
+	{
+		STask&		task = tasks[ index ];
+		task.commandList = GCommandListPool[ index ];
+		GRHI->BeginCommandList( immediateContext, task.commandList );
+		if ( task.bAllowParallel )
+		{
+			parallelTasks.push_back( index );
+		}
+	}
+
+	// Publish job to the rendering worker threads
+	const ParallelForFunction_t		recordFunction = [this]( uint32 InIndex )
+	{
+		RecordTask( tasks[ parallelTasks[ InIndex ] ] );
+	};
+
+	if ( !parallelTasks.empty() )
+	{
+		BeginParallelJob( parallelTasks.size(), recordFunction );
+	}
+
+	// Tasks which not allowed to record in parallel are recorded on the rendering thread, after that it helps the workers
+	GIsRecordingCommandLists = true;
+	for ( uint32 index = 0, count = tasks.size(); index < count; ++index )
+	{
+		if ( !tasks[ index ].bAllowParallel )
+		{
+			RecordTask( tasks[ index ] );
+		}
+	}
+
+	if ( !parallelTasks.empty() )
+	{
+		FinishParallelJob();
+	}
+	GIsRecordingCommandLists = false;
+
+	// Execute command lists in order of adding
+	for ( uint32 index = 0, count = tasks.size(); index < count; ++index )
+	{
+		STask&		task = tasks[ index ];
+		{
+			SCOPED_DRAW_EVENT( EventTask, task.color, task.name );
+			GRHI->ExecuteCommandList( immediateContext, task.commandList );
+		}
+
+#if !SHIPPING_BUILD
+		SStateCacheStatsRHI&		stateCacheStats = task.commandList->GetDeviceContext()->GetStateCacheStats();
+		immediateContext->GetStateCacheStats().Append( stateCacheStats );
+		stateCacheStats.Reset();
+#endif // !SHIPPING_BUILD
+	}
+
+	tasks.clear();
+	parallelTasks.clear();
+}
+
+void StartRenderingWorkerThreads()
+{
+	check( GNumRenderingWorkerThreads == 0 );
+
+	// Game thread and rendering thread keep own cores
+	const uint32		numProcessors = appGetNumberOfProcessors();
+	const uint32		numWorkers = numProcessors > 2 ? Min<uint32>( numProcessors - 2, MAX_RENDERING_WORKER_THREADS ) : 0;
+	for ( uint32 index = 0; index < numWorkers; ++index )
+	{
+		CRenderingWorkerThread*		runnable = new CRenderingWorkerThread();
+		runnable->workEvent = GSynchronizeFactory->CreateSynchEvent( false );
+		check( runnable->workEvent );
+
+		CRunnableThread*			thread = GThreadFactory->CreateThread( runnable, TEXT( "RenderingWorkerThread" ), 0, 0, 0, TP_AboveNormal );
+		check( thread );
+
+		GRenderingWorkerThreadRunnables[ index ]	= runnable;
+		GRenderingWorkerThreads[ index ]			= thread;
+		GRenderingWorkerThreadIds[ index ]			= thread->GetThreadID();
+	}
+
+	GNumRenderingWorkerThreads = numWorkers;
+	LE_LOG( LT_Log, LC_Init, TEXT( "Started %i rendering worker threads" ), numWorkers );
+}
+
+void StopRenderingWorkerThreads()
+{
+	for ( uint32 index = 0; index < GNumRenderingWorkerThreads; ++index )
+	{
+		CRenderingWorkerThread*		runnable	= GRenderingWorkerThreadRunnables[ index ];
+		CRunnableThread*			thread		= GRenderingWorkerThreads[ index ];
+		runnable->Stop();
+		thread->WaitForCompletion();
+		thread->Kill();
+
+		GThreadFactory->Destroy( thread );
+		GSynchronizeFactory->Destroy( runnable->workEvent );
+		delete runnable;
+
+		GRenderingWorkerThreadRunnables[ index ]	= nullptr;
+		GRenderingWorkerThreads[ index ]			= nullptr;
+		GRenderingWorkerThreadIds[ index ]			= 0;
+	}
+	GNumRenderingWorkerThreads = 0;
+
+	if ( GParallelJob.doneEvent )
+	{
+		GSynchronizeFactory->Destroy( GParallelJob.doneEvent );
+		GParallelJob.doneEvent = nullptr;
+	}
+	GCommandListPool.clear();
+}
\ No newline at end of file
@@ -27,7 +27,7 @@ SPixelFormatInfo		GPixelFormats[ PF_Max ] =
 	{ TEXT( "BC2" ),					4,			4,			1,			16,			4,				0,				0,				0,				PF_BC2						},
 	{ TEXT( "BC3" ),					4,			4,			1,			16,			4,				0,				0,				0,				PF_BC3						},
 	{ TEXT( "BC5" ),					4,			4,			1,			16,			2,				0,				0,				0,				PF_BC5						},
-	{ TEXT( "BC6H" ),					1,			1,			1,			16,			3,				0,				0,				0,				PF_BC6H						},
+	{ TEXT( "BC6H" ),					4,			4,			1,			16,			3,				0,				0,				0,				PF_BC6H						},
 	{ TEXT( "BC7" ),					4,			4,			1,			16,			4,				0,				0,				0,				PF_BC7						}
 };
 
@@ -3,14 +3,18 @@
 #include "Logger/BaseLogger.h"
 #include "Logger/LoggerMacros.h"
 #include "Render/RenderingThread.h"
+#include "Render/ParallelCommandLists.h"
 #include "System/TickableObject.h"
 
 //
 // Definitions
 //
 
-/* The size of the rendering command buffer, in bytes. */
-#define RENDERING_COMMAND_BUFFER_SIZE			( 1024 * 1024 )
+/* The size of one chunk of the rendering command buffer, in bytes. */
+#define RENDERING_COMMAND_CHUNK_SIZE			( 256 * 1024 )
+
+/* The max size of the rendering command buffer, in bytes. When it is reached game thread waits rendering thread */
+#define RENDERING_COMMAND_BUFFER_MAX_SIZE		( 64 * 1024 * 1024 )
 
 //
 // Globals
@@ -23,7 +27,7 @@ bool			GIsThreadedRendering = false;
 uint32			GRenderingThreadId = 0;
 
 /* The rendering command queue */
-CRingBuffer		GRenderCommandBuffer( RENDERING_COMMAND_BUFFER_SIZE, 16 );
+CChunkedCommandBuffer		GRenderCommandBuffer( RENDERING_COMMAND_CHUNK_SIZE, RENDERING_COMMAND_BUFFER_MAX_SIZE, 16 );
 
 /* Event of finished rendering frame */
 CEvent*			GRenderFrameFinished = nullptr;
@@ -52,30 +56,6 @@ void TickRenderingTickables()
 	lastTickTime = currentTime;
 }
 
-CSkipRenderCommand::CSkipRenderCommand( uint32 InNumSkipBytes ) :
-	numSkipBytes( InNumSkipBytes )
-{}
-
-uint32 CSkipRenderCommand::Execute()
-{
-	return numSkipBytes;
-}
-
-uint32 CSkipRenderCommand::GetSize() const
-{
-	return numSkipBytes;
-}
-
-const tchar* CSkipRenderCommand::DescribeCommand() const
-{
-	return TEXT( "CSkipRenderCommand" );
-}
-
-const char* CSkipRenderCommand::DescribeCommandChar() const
-{
-	return "CSkipRenderCommand";
-}
-
 bool CRenderingThread::Init()
 {
 	// Acquire rendering context ownership on the current thread
@@ -145,6 +125,9 @@ void StartRenderingThread()
 		GRenderingThread = GThreadFactory->CreateThread( GRenderingThreadRunnable, TEXT( "RenderingThread" ), 0, 0, stackSize, TP_Realtime );
 		GRenderFrameFinished = GSynchronizeFactory->CreateSynchEvent( false, TEXT( "RenderFrameFinished" ) );
 		check( GRenderingThread && GRenderFrameFinished );
+
+		// Create the rendering worker threads for recording command lists in parallel
+		StartRenderingWorkerThreads();
 	}
 }
 
@@ -172,6 +155,9 @@ void StopRenderingThread()
 			// Wait for the rendering thread to return.
 			GRenderingThread->WaitForCompletion();
 
+			// Stop the rendering worker threads, they are idle because the rendering thread is finished
+			StopRenderingWorkerThreads();
+
 			// We must kill the thread here, so that it correctly frees up the rendering thread handle
 			// without this we get thread leaks when the device is lost TTP 14738, TTP 22274
 			GRenderingThread->Kill();
@@ -1,7 +1,31 @@
+#include <math.h>
+
 #include "Math/Math.h"
+#include "Misc/Template.h"
 #include "Render/SceneRenderTargets.h"
 #include "Render/Scene.h"
+#include "Render/TextureStreaming.h"
+#include "Misc/EngineGlobals.h"
 #include "System/ConVar.h"
+#include "Components/PointLightComponent.h"
+
+/**
+ * @ingroup Engine
+ * @brief CVar enable/disable culling of lights by view frustum
+ */
+CConVar		CVarRLightCulling( TEXT( "r.lightCulling" ), TEXT( "1" ), CVT_Bool, TEXT( "Enable/Disable culling of lights by view frustum" ) );
+
+/**
+ * @ingroup Engine
+ * @brief CVar enable/disable software occlusion culling of primitives
+ */
+CConVar		CVarROcclusionCulling( TEXT( "r.occlusionCulling" ), TEXT( "1" ), CVT_Bool, TEXT( "Enable/Disable software occlusion culling of primitives by static meshes marked as occluders" ) );
+
+/**
+ * @ingroup Engine
+ * @brief CVar enable/disable front to back sorting of opaque instances
+ */
+CConVar		CVarRSortOpaque( TEXT( "r.sortOpaque" ), TEXT( "1" ), CVT_Bool, TEXT( "Enable/Disable front to back sorting of instances in world draw lists" ) );
 
 #if WITH_EDITOR
 /**
@@ -19,7 +43,7 @@ CConVar		CVarRWireframe( TEXT( "r.wireframe" ), TEXT( "0" ), CVT_Bool, TEXT( "En
 CConVar		CVarRLight( TEXT( "r.light" ), TEXT( "1" ), CVT_Bool, TEXT( "Enable/Disable light pass" ) );
 #endif // WITH_EDITOR
 
-CSceneView::CSceneView( const Vector& InPosition, const Matrix& InProjectionMatrix, const Matrix& InViewMatrix, float InSizeX, float InSizeY, const CColor& InBackgroundColor, ShowFlags_t InShowFlags )
+CSceneView::CSceneView( const Vector& InPosition, const Matrix& InProjectionMatrix, const Matrix& InViewMatrix, float InSizeX, float InSizeY, const CColor& InBackgroundColor, ShowFlags_t InShowFlags, uint32 InViewKey /* = 0 */ )
 	: viewMatrix( InViewMatrix )
 	, projectionMatrix( InProjectionMatrix )
 	, viewProjectionMatrix( InProjectionMatrix * InViewMatrix )
@@ -29,6 +53,7 @@ CSceneView::CSceneView( const Vector& InPosition, const Matrix& InProjectionMatr
 	, showFlags( InShowFlags )
 	, sizeX( InSizeX )
 	, sizeY( InSizeY )
+	, viewKey( InViewKey )
 {
 #if WITH_EDITOR
 	if ( CVarRWireframe.GetValueBool() )
@@ -94,6 +119,10 @@ void CSceneView::ScreenToWorld( const Vector2D& InScreenPoint, Vector& OutWorldO
 }
 
 
+CScene::CScene()
+	: bDirtyPickBVH( true )
+{}
+
 CScene::~CScene()
 {
 	Clear();
@@ -117,6 +146,7 @@ void CScene::AddPrimitive( class CPrimitiveComponent* InPrimitive )
 	InPrimitive->scene = this;
 	InPrimitive->LinkDrawList();
 	primitives.push_back( InPrimitive );
+	bDirtyPickBVH = true;
 }
 
 void CScene::RemovePrimitive( class CPrimitiveComponent* InPrimitive )
@@ -128,6 +158,7 @@ void CScene::RemovePrimitive( class CPrimitiveComponent* InPrimitive )
 			InPrimitive->UnlinkDrawList();
 			InPrimitive->scene = nullptr;
 			primitives.erase( it );
+			bDirtyPickBVH = true;
 			return;
 		}
 	}
@@ -182,25 +213,140 @@ void CScene::Clear()
 
 	primitives.clear();
 	lights.clear();
+	bDirtyPickBVH = true;
+}
+
+bool CScene::RayCast( const Vector& InOrigin, const Vector& InDirection, SRayCastResult& OutResult, float InMaxDistance /* = FLT_MAX */ ) const
+{
+	// Set of primitives is changed only by adding or removing, moved primitives just refit the BVH
+	if ( bDirtyPickBVH )
+	{
+		pickPrimitives.clear();
+		pickPrimitives.reserve( primitives.size() );
+		for ( auto it = primitives.begin(), itEnd = primitives.end(); it != itEnd; ++it )
+		{
+			pickPrimitives.push_back( *it );
+		}
+	}
+
+	pickBoxes.resize( pickPrimitives.size() );
+	for ( uint32 index = 0, count = pickPrimitives.size(); index < count; ++index )
+	{
+		pickBoxes[ index ] = pickPrimitives[ index ]->CalcBounds();
+	}
+
+	if ( bDirtyPickBVH )
+	{
+		pickBVH.Build( pickBoxes.data(), pickBoxes.size() );
+		bDirtyPickBVH = false;
+	}
+	else
+	{
+		pickBVH.Refit( pickBoxes.data() );
+	}
+
+	// Boxes of primitives are tested by BVH, primitives test their geometry
+	float		distance	= InMaxDistance;
+	bool		bHit		= pickBVH.RayCast( InOrigin, InDirection, distance, [&]( uint32 InPrimitiveIndex, float& InOutDistance ) -> bool
+										   {
+											   CPrimitiveComponent*		primitiveComponent = pickPrimitives[ InPrimitiveIndex ];
+											   if ( !primitiveComponent->IsVisibility() || !primitiveComponent->RayCast( InOrigin, InDirection, InOutDistance ) )
+											   {
+												   return false;
+											   }
+
+											   OutResult.primitive = primitiveComponent;
+											   return true;
+										   } );
+	if ( bHit )
+	{
+		OutResult.distance = distance;
+	}
+	return bHit;
 }
 
 void CScene::BuildView( const CSceneView& InSceneView )
 {
-	// Add to SDGs visible primitives
+	// Cull primitives by view frustum, occluders of primitives in it are rasterized into occlusion buffer
+	const bool		bOcclusionCulling = CVarROcclusionCulling.GetValueBool();
+	if ( bOcclusionCulling )
+	{
+		frame.occlusionBuffer.Begin( InSceneView );
+	}
+
 	for ( auto it = primitives.begin(), itEnd = primitives.end(); it != itEnd; ++it )
 	{
 		CPrimitiveComponent*		primitiveComponent = *it;
-		if ( primitiveComponent->IsVisibility() && InSceneView.GetFrustum().IsIn( primitiveComponent->GetBoundBox() ) )
+		if ( !primitiveComponent->IsVisibility() )
+		{
+			continue;
+		}
+
+		primitiveComponent->UpdateBounds();
+		if ( InSceneView.GetFrustum().IsIn( primitiveComponent->GetBoundBox() ) )
+		{
+			frame.frustumPrimitives.push_back( primitiveComponent );
+			if ( bOcclusionCulling )
+			{
+				primitiveComponent->AddToOcclusionBuffer( frame.occlusionBuffer );
+			}
+		}
+	}
+
+	if ( bOcclusionCulling )
+	{
+		frame.occlusionBuffer.Rasterize();
+	}
+
+	// Add to SDGs visible primitives
+	for ( uint32 index = 0, count = frame.frustumPrimitives.size(); index < count; ++index )
+	{
+		CPrimitiveComponent*		primitiveComponent = frame.frustumPrimitives[ index ];
+		if ( !bOcclusionCulling || frame.occlusionBuffer.IsVisible( primitiveComponent->GetBoundBox() ) )
 		{
 			primitiveComponent->AddToDrawList( InSceneView );
+			GTextureStreamingManager->AddVisiblePrimitive( primitiveComponent, InSceneView );
 		}
 	}
 
-	// Add to scene frame visible lights
+#if !SHIPPING_BUILD
+	GOcclusionStats = bOcclusionCulling ? frame.occlusionBuffer.GetStats() : SOcclusionStats();
+#endif // !SHIPPING_BUILD
+
+	// Sort instances of world front to back, so hidden pixels of far instances are rejected by depth test before pixel shader
+	if ( CVarRSortOpaque.GetValueBool() )
+	{
+		SSceneDepthGroup&		worldSDG = frame.SDGs[ SDG_World ];
+		const Vector&			viewPosition = InSceneView.GetPosition();
+		worldSDG.staticMeshDrawList.SortInstances( viewPosition );
+		worldSDG.spriteDrawList.SortInstances( viewPosition );
+		worldSDG.dynamicMeshElements.SortInstances( viewPosition );
+	}
+
+	// Add to scene frame visible lights. Point lights are bounded by sphere, so they are culled by frustum.
+	// Other lights don't have bounds and always are visible
+	const bool		bLightCulling	= CVarRLightCulling.GetValueBool();
+	const CFrustum&	frustum			= InSceneView.GetFrustum();
 	for ( auto it = lights.begin(), itEnd = lights.end(); it != itEnd; ++it )
 	{
 		CLightComponent*		lightComponent = *it;
-		if ( lightComponent->IsEnabled() )
+		if ( !lightComponent->IsEnabled() )
+		{
+			continue;
+		}
+
+		if ( !bLightCulling || lightComponent->GetLightType() != LT_Point )
+		{
+			frame.visibleLights.push_back( lightComponent );
+			continue;
+		}
+
+		// Radius of light volume is scaled by the largest axis of transform
+		CPointLightComponent*	pointLightComponent = ( CPointLightComponent* )lightComponent;
+		const CTransform		transform			= pointLightComponent->GetComponentTransform();
+		const Vector			scale				= transform.GetScale();
+		const float				radius				= pointLightComponent->GetRadius() * Max( fabsf( scale.x ), Max( fabsf( scale.y ), fabsf( scale.z ) ) );
+		if ( radius > 0.f && frustum.IsIn( transform.GetLocation(), radius ) )
 		{
 			frame.visibleLights.push_back( lightComponent );
 		}
@@ -216,4 +362,5 @@ void CScene::ClearView()
 	}
 
 	frame.visibleLights.clear();
+	frame.frustumPrimitives.clear();
 }
\ No newline at end of file
@@ -0,0 +1,44 @@
+#include "Misc/EngineGlobals.h"
+#include "RHI/BaseRHI.h"
+#include "Render/SceneDepthRendering.h"
+#include "Render/BoundShaderStateCache.h"
+
+void CDepthOnlyDrawingPolicy::SetShaderParameters( class CBaseDeviceContextRHI* InDeviceContextRHI )
+{
+	check( bInit );
+	vertexShader->SetConstantParameters( InDeviceContextRHI, vertexFactory, material.ToSharedPtr() );
+}
+
+BoundShaderStateRHIRef_t CDepthOnlyDrawingPolicy::GetBoundShaderState() const
+{
+	if ( !boundShaderState )
+	{
+		TSharedPtr<CMaterial>		materialRef = material.ToSharedPtr();
+		check( materialRef && vertexFactory && vertexShader );
+
+		bool		bCreated = false;
+		boundShaderState = GRHI->CreateBoundShaderState(
+			materialRef->GetAssetName().c_str(),
+			vertexFactory->GetPositionOnlyDeclaration(),
+			vertexShader->GetVertexShader(),
+			nullptr,
+			nullptr, nullptr, nullptr,
+			&bCreated );
+
+#if !SHIPPING_BUILD
+		if ( bCreated )
+		{
+			appInterlockedIncrement( &GBoundShaderStateStats.numFirstUseCreations );
+		}
+#endif // !SHIPPING_BUILD
+	}
+
+	return boundShaderState;
+}
+
+bool CDepthOnlyDrawingPolicy::IsValid() const
+{
+	// Masked materials discard pixels in base pass and wireframe materials don't cover their triangles, so they mustn't write depth here
+	TSharedPtr<CMaterial>		materialRef = material.ToSharedPtr();
+	return materialRef && !materialRef->IsMasked() && !materialRef->IsWireframe() && vertexFactory && vertexFactory->GetPositionOnlyDeclaration() && vertexShader;
+}
\ No newline at end of file
@@ -22,7 +22,7 @@ void CSceneRenderer::BeginRenderHitProxiesViewTarget( ViewportRHIParamRef_t InVi
 	immediateContext->ClearDepthStencil( GSceneRenderTargets.GetSceneDepthZSurface() );
 
 	GRHI->SetViewParameters( immediateContext, *sceneView );
-	GRHI->SetDepthState( immediateContext, TStaticDepthStateRHI<true>::GetRHI() );
+	immediateContext->SetDepthState( TStaticDepthStateRHI<true>::GetRHI() );
 
 	// Build visible view on scene
 	if ( scene )
@@ -53,7 +53,7 @@ void CSceneRenderer::RenderHitProxies( ViewportRHIParamRef_t InViewportRHI, EHit
 				continue;
 			}
 
-			SCOPED_DRAW_EVENT( EventHitProxiesSDG, DEC_SCENE_ITEMS, CString::Format( TEXT( "SDG %s" ), GetSceneSDGName( ( ESceneDepthGroup )SDGIndex ) ).c_str() );			
+			SCOPED_DRAW_EVENTF( EventHitProxiesSDG, DEC_SCENE_ITEMS, TEXT( "SDG %s" ), GetSceneSDGName( ( ESceneDepthGroup )SDGIndex ) );			
 
 #if WITH_EDITOR
 			// Draw simple elements
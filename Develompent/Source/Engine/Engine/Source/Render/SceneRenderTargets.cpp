@@ -74,6 +74,14 @@ void CSceneRenderTargets::ClearGBufferTargets( class CBaseDeviceContextRHI* InDe
 	InDeviceContextRHI->ClearSurface( renderTargets[SRTT_Emission_GBuffer].GetSurfaceRHI(), CColor::black );
 }
 
+void CSceneRenderTargets::BeginRenderingDepthPrepass( class CBaseDeviceContextRHI* InDeviceContextRHI ) const
+{
+	check( InDeviceContextRHI );
+	GRHI->SetRenderTarget( InDeviceContextRHI, nullptr, renderTargets[SRTT_SceneDepthZ].GetSurfaceRHI() );
+	GRHI->SetMRTRenderTarget( InDeviceContextRHI, nullptr, 1 );
+	GRHI->SetMRTRenderTarget( InDeviceContextRHI, nullptr, 2 );
+}
+
 void CSceneRenderTargets::ResolveLightPassDepth( class CBaseDeviceContextRHI* InDeviceContextRHI ) const
 {
 	check( InDeviceContextRHI );
@@ -18,6 +18,14 @@
 #include "Render/Texture.h"
 #include "Render/VertexFactory/SimpleElementVertexFactory.h"
 #include "Render/SceneRenderTargets.h"
+#include "Render/ParallelCommandLists.h"
+#include "System/ConVar.h"
+
+/**
+ * @ingroup Engine
+ * @brief CVar enable/disable depth pre-pass
+ */
+CConVar		CVarRDepthPrepass( TEXT( "r.depthPrepass" ), TEXT( "0" ), CVT_Bool, TEXT( "Enable/Disable depth pre-pass of world static meshes before base pass" ) );
 
 CSceneRenderer::CSceneRenderer( CSceneView* InSceneView, class CScene* InScene /* = nullptr */ )
 	: scene( InScene )
@@ -29,15 +37,22 @@ void CSceneRenderer::BeginRenderViewTarget( ViewportRHIParamRef_t InViewportRHI
 	CBaseDeviceContextRHI*	immediateContext	= GRHI->GetImmediateContext();
 
 	SCOPED_DRAW_EVENT( EventBeginRenderViewTarget, DEC_SCENE_ITEMS, TEXT( "Begin Render View Target" ) );
+#if !SHIPPING_BUILD
+	GDrawListStats.Reset();
+	immediateContext->GetStateCacheStats().Reset();
+#endif // !SHIPPING_BUILD
+
 	GSceneRenderTargets.Allocate( InViewportRHI->GetWidth(), InViewportRHI->GetHeight() );
 
-	// If SHOW_Lights setted and disabled wireframe mode, we rendering to the GBuffer
 	ShowFlags_t		showFlags = sceneView->GetShowFlags();
-	if ( showFlags & SHOW_Lights 
+	bool			bWireframe = false;
 #if WITH_EDITOR
-		 && !( showFlags & SHOW_Wireframe )
+	bWireframe = ( showFlags & SHOW_Wireframe ) != 0;
 #endif // WITH_EDITOR
-		 )
+
+	// If SHOW_Lights setted and disabled wireframe mode, we rendering to the GBuffer
+	const bool		bGBuffer = ( showFlags & SHOW_Lights ) != 0 && !bWireframe;
+	if ( bGBuffer )
 	{
 		GSceneRenderTargets.BeginRenderingGBuffer( immediateContext );
 		GSceneRenderTargets.ClearGBufferTargets( immediateContext );
@@ -50,15 +65,50 @@ void CSceneRenderer::BeginRenderViewTarget( ViewportRHIParamRef_t InViewportRHI
 	
 	immediateContext->ClearSurface( GSceneRenderTargets.GetSceneColorSurface(), sceneView->GetBackgroundColor() );
 	immediateContext->ClearDepthStencil( GSceneRenderTargets.GetSceneDepthZSurface() );
-	GRHI->SetDepthState( immediateContext, TStaticDepthStateRHI<true>::GetRHI() );
-	GRHI->SetBlendState( immediateContext, TStaticBlendStateRHI<>::GetRHI() );
+	immediateContext->SetDepthState( TStaticDepthStateRHI<true>::GetRHI() );
+	immediateContext->SetBlendState( TStaticBlendStateRHI<>::GetRHI() );
 	GRHI->SetViewParameters( immediateContext, *sceneView );
 
 	// Build visible view on scene
 	if ( scene )
 	{
 		scene->BuildView( *sceneView );
+
+		// Fill scene depth before base pass, after that base pass shades only visible pixels
+		if ( CVarRDepthPrepass.GetValueBool() && !bWireframe && ( showFlags & SHOW_StaticMesh ) )
+		{
+			RenderDepthPrepass( immediateContext );
+			if ( bGBuffer )
+			{
+				GSceneRenderTargets.BeginRenderingGBuffer( immediateContext );
+			}
+			else
+			{
+				GSceneRenderTargets.BeginRenderingSceneColor( immediateContext );
+			}
+		}
+	}
+}
+
+void CSceneRenderer::RenderDepthPrepass( class CBaseDeviceContextRHI* InDeviceContext )
+{
+	SSceneDepthGroup&	SDG = scene->GetSDG( SDG_World );
+	if ( SDG.staticMeshDrawList.GetNum() <= 0 )
+	{
+		return;
 	}
+
+	SCOPED_DRAW_EVENT( EventDepthPrepass, DEC_SCENE_ITEMS, TEXT( "Depth pre-pass" ) );
+	GSceneRenderTargets.BeginRenderingDepthPrepass( InDeviceContext );
+
+	// Depth pre-pass writes the same depth as base pass, so base pass keeps depth test with CF_LessEqual
+	CParallelCommandListSet		commandListSet( InDeviceContext );
+	const CSceneView&			sceneViewRef = *sceneView;
+	commandListSet.Add( TEXT( "Static meshes" ), DEC_STATIC_MESH, [&]( CBaseDeviceContextRHI* InTaskDeviceContext )
+	{
+		SDG.staticMeshDrawList.DrawDepthOnly( InTaskDeviceContext, sceneViewRef );
+	} );
+	commandListSet.Dispatch();
 }
 
 void CSceneRenderer::Render( ViewportRHIParamRef_t InViewportRHI )
@@ -106,8 +156,8 @@ void CSceneRenderer::Render( ViewportRHIParamRef_t InViewportRHI )
 void CSceneRenderer::RenderHighlight( class CBaseDeviceContextRHI* InDeviceContext )
 {
 	SCOPED_DRAW_EVENT( EventUI, DEC_SCENE_ITEMS, TEXT( "Highlight" ) );
-	GRHI->SetDepthState( InDeviceContext, TStaticDepthStateRHI<true>::GetRHI() );
-	GRHI->SetBlendState( InDeviceContext, TStaticBlendStateRHI<>::GetRHI() );
+	InDeviceContext->SetDepthState( TStaticDepthStateRHI<true>::GetRHI() );
+	InDeviceContext->SetBlendState( TStaticBlendStateRHI<>::GetRHI() );
 	
 	RenderSDG( InDeviceContext, SDG_Highlight );
 }
@@ -123,71 +173,86 @@ bool CSceneRenderer::RenderSDG( class CBaseDeviceContextRHI* InDeviceContext, ui
 		return false;
 	}
 
-	SCOPED_DRAW_EVENT( EventSDG, DEC_SCENE_ITEMS, CString::Format( TEXT( "SDG %s" ), GetSceneSDGName( ( ESceneDepthGroup )InSDGIndex ) ).c_str() );
+	SCOPED_DRAW_EVENTF( EventSDG, DEC_SCENE_ITEMS, TEXT( "SDG %s" ), GetSceneSDGName( ( ESceneDepthGroup )InSDGIndex ) );
+
+	// Each draw list is recorded to own command list, command lists are executed in order of adding
+	CParallelCommandListSet		commandListSet( InDeviceContext );
+	const CSceneView&			sceneViewRef = *sceneView;
+	bool						bAllowParallel = true;
 
 #if WITH_EDITOR
+	// Wireframe drawing policies share default wireframe material, so they are recorded on the rendering thread
+	bAllowParallel = !( showFlags & SHOW_Wireframe );
+
 	// Draw simple elements
 	if ( showFlags & SHOW_SimpleElements && !SDG.simpleElements.IsEmpty() )
 	{
-		SCOPED_DRAW_EVENT( EventSimpleElements, DEC_SIMPLEELEMENTS, TEXT( "Simple elements" ) );
-		SDG.simpleElements.Draw( InDeviceContext, *sceneView );
+		commandListSet.Add( TEXT( "Simple elements" ), DEC_SIMPLEELEMENTS, [&]( CBaseDeviceContextRHI* InTaskDeviceContext )
+		{
+			SDG.simpleElements.Draw( InTaskDeviceContext, sceneViewRef );
+		}, bAllowParallel );
 	}
 
 	// Draw gizmos
 	if ( showFlags & SHOW_Gizmo && SDG.gizmoDrawList.GetNum() > 0 )
 	{
-		SCOPED_DRAW_EVENT( EventGizmos, DEC_SPRITE, TEXT( "Gizmos" ) );
-		SDG.gizmoDrawList.Draw( InDeviceContext, *sceneView );
+		commandListSet.Add( TEXT( "Gizmos" ), DEC_SPRITE, [&]( CBaseDeviceContextRHI* InTaskDeviceContext )
+		{
+			SDG.gizmoDrawList.Draw( InTaskDeviceContext, sceneViewRef );
+		}, bAllowParallel );
 	}
 #endif // WITH_EDITOR
 
 	// Draw static meshes
 	if ( showFlags & SHOW_StaticMesh && SDG.staticMeshDrawList.GetNum() > 0 )
 	{
-		SCOPED_DRAW_EVENT( EventStaticMeshes, DEC_STATIC_MESH, TEXT( "Static meshes" ) );
-		SDG.staticMeshDrawList.Draw( InDeviceContext, *sceneView );
+		commandListSet.Add( TEXT( "Static meshes" ), DEC_STATIC_MESH, [&]( CBaseDeviceContextRHI* InTaskDeviceContext )
+		{
+			SDG.staticMeshDrawList.Draw( InTaskDeviceContext, sceneViewRef );
+		}, bAllowParallel );
 	}
 
 	// Draw sprites
 	if ( showFlags & SHOW_Sprite && SDG.spriteDrawList.GetNum() > 0 )
 	{
-		SCOPED_DRAW_EVENT( EventSprites, DEC_SPRITE, TEXT( "Sprites" ) );
-		SDG.spriteDrawList.Draw( InDeviceContext, *sceneView );
+		commandListSet.Add( TEXT( "Sprites" ), DEC_SPRITE, [&]( CBaseDeviceContextRHI* InTaskDeviceContext )
+		{
+			SDG.spriteDrawList.Draw( InTaskDeviceContext, sceneViewRef );
+		}, bAllowParallel );
 	}
 
 	// Draw dynamic meshes
-	if ( showFlags & SHOW_DynamicElements && ( SDG.dynamicMeshElements.GetNum() > 0 ||
-#if WITH_EDITOR
-											   !SDG.dynamicMeshBuilders.empty()
-#else
-											   false
-#endif // WITH_EDITOR
-											   ) )
+	if ( showFlags & SHOW_DynamicElements )
 	{
-		SCOPED_DRAW_EVENT( EventDynamicElements, DEC_DYNAMICELEMENTS, TEXT( "Dynamic elements" ) );
-
 		// Draw dynamic mesh elements
 		if ( SDG.dynamicMeshElements.GetNum() > 0 )
 		{
-			SDG.dynamicMeshElements.Draw( InDeviceContext, *sceneView );
+			commandListSet.Add( TEXT( "Dynamic elements" ), DEC_DYNAMICELEMENTS, [&]( CBaseDeviceContextRHI* InTaskDeviceContext )
+			{
+				SDG.dynamicMeshElements.Draw( InTaskDeviceContext, sceneViewRef );
+			}, bAllowParallel );
 		}
 
-		// Draw dynamic mesh builders
+		// Draw dynamic mesh builders. Their drawing policies are initialized on each draw, so they are recorded on the rendering thread
 #if WITH_EDITOR
 		if ( !SDG.dynamicMeshBuilders.empty() )
 		{
-			for ( auto it = SDG.dynamicMeshBuilders.begin(), itEnd = SDG.dynamicMeshBuilders.end(); it != itEnd; ++it )
+			commandListSet.Add( TEXT( "Dynamic mesh builders" ), DEC_DYNAMICELEMENTS, [&]( CBaseDeviceContextRHI* InTaskDeviceContext )
 			{
-				const SDynamicMeshBuilderElement& element = *it;
-				if ( element.dynamicMeshBuilder )
+				for ( auto it = SDG.dynamicMeshBuilders.begin(), itEnd = SDG.dynamicMeshBuilders.end(); it != itEnd; ++it )
 				{
-					element.dynamicMeshBuilder->Draw<CMeshDrawingPolicy>( InDeviceContext, element.localToWorldMatrix, element.material, *sceneView );
+					const SDynamicMeshBuilderElement& element = *it;
+					if ( element.dynamicMeshBuilder )
+					{
+						element.dynamicMeshBuilder->Draw<CMeshDrawingPolicy>( InTaskDeviceContext, element.localToWorldMatrix, element.material, sceneViewRef );
+					}
 				}
-			}
+			}, false );
 		}
 #endif // WITH_EDITOR
 	}
 
+	commandListSet.Dispatch();
 	return true;
 }
 
@@ -212,10 +277,10 @@ void CSceneRenderer::FinishRenderViewTarget( ViewportRHIParamRef_t InViewportRHI
 	check( screenVertexShader && screenPixelShader );
 	
 	GRHI->SetRenderTarget( immediateContext, InViewportRHI->GetSurface(), nullptr );
-	GRHI->SetDepthState( immediateContext, TStaticDepthStateRHI<false>::GetRHI() );
-	GRHI->SetRasterizerState( immediateContext, TStaticRasterizerStateRHI<>::GetRHI() );
-	GRHI->SetBlendState( immediateContext, TStaticBlendStateRHI<>::GetRHI() );
-	GRHI->SetBoundShaderState( immediateContext, GRHI->CreateBoundShaderState( TEXT( "FinishRenderViewTarget" ), GSimpleElementVertexDeclaration.GetVertexDeclarationRHI(), screenVertexShader->GetVertexShader(), screenPixelShader->GetPixelShader() ) );
+	immediateContext->SetDepthState( TStaticDepthStateRHI<false>::GetRHI() );
+	immediateContext->SetRasterizerState( TStaticRasterizerStateRHI<>::GetRHI() );
+	immediateContext->SetBlendState( TStaticBlendStateRHI<>::GetRHI() );
+	immediateContext->SetBoundShaderState( GRHI->CreateBoundShaderState( TEXT( "FinishRenderViewTarget" ), GSimpleElementVertexDeclaration.GetVertexDeclarationRHI(), screenVertexShader->GetVertexShader(), screenPixelShader->GetPixelShader() ) );
 
 	screenPixelShader->SetTexture( immediateContext, sceneColorTexture );
 	screenPixelShader->SetSamplerState( immediateContext, TStaticSamplerStateRHI<>::GetRHI() );
@@ -5,6 +5,7 @@
 #include "Logger/LoggerMacros.h"
 #include "RHI/BaseRHI.h"
 #include "Render/Shaders/Shader.h"
+#include "Render/VertexFactory/VertexFactory.h"
 
 /**
  * Initialize shader
@@ -98,6 +99,11 @@ CArchive& operator<<( CArchive& InArchive, CShader*& InValue )
 			{
 				InArchive << vertexFactoryHash;
 			}
+
+			if ( InArchive.Ver() < VER_StableHashes )
+			{
+				vertexFactoryHash = CVertexFactoryMetaType::SContainerVertexFactoryMetaType::Get()->ConvertLegacyHash( vertexFactoryHash, InArchive.Ver() < VER_HashUInt64 );
+			}
 		}
 		else
 		{
@@ -1,7 +1,8 @@
 #include "Render/Shaders/ShaderCache.h"
+#include "Render/VertexFactory/VertexFactory.h"
 #include "System/Archive.h"
 
-#define SHADER_CACHE_VERSION			4
+#define SHADER_CACHE_VERSION			5
 
 bool CShaderParameterMap::FindParameterAllocation( const tchar* InParameterName, uint32& OutBufferIndex, uint32& OutBaseIndex, uint32& OutSize, uint32& OutSamplerIndex ) const
 {
@@ -50,6 +51,11 @@ void CShaderCache::SShaderCacheItem::Serialize( CArchive& InArchive )
 		InArchive << vertexFactoryHash;
 	}
 
+	if ( InArchive.IsLoading() && InArchive.Ver() < VER_StableHashes )
+	{
+		vertexFactoryHash = CVertexFactoryMetaType::SContainerVertexFactoryMetaType::Get()->ConvertLegacyHash( vertexFactoryHash, InArchive.Ver() < VER_HashUInt64 );
+	}
+
 	InArchive << numInstructions;
 	InArchive << name;
 
@@ -99,6 +105,9 @@ void CShaderCache::Serialize( CArchive& InArchive )
 			item.Serialize( InArchive );
 			itemsMap[ item.vertexFactoryHash ].insert( item.name );
 		}
+
+		// Loading bound shader states of cooked maps
+		InArchive << boundShaderStates;
 	}
 	else if ( InArchive.IsSaving() )
 	{
@@ -111,5 +120,8 @@ void CShaderCache::Serialize( CArchive& InArchive )
 		{
 			items[ indexItem ].Serialize( InArchive );
 		}
+
+		// Save bound shader states of cooked maps
+		InArchive << boundShaderStates;
 	}
 }
\ No newline at end of file
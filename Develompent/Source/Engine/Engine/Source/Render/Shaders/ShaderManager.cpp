@@ -151,6 +151,9 @@ bool CShaderManager::LoadShaders( const tchar* InPathShaderCache )
 		}	
 	}
 
+	// Bound shader states of cooked maps are created at map load
+	boundShaderStates = shaderCache.GetBoundShaderStates();
+
 	LE_LOG( LT_Log, LC_Shader, TEXT( "Loaded %i shaders, %i legacy" ), numLoadedShaders, numLegacyShaders );
 	return true;
 }
@@ -225,5 +228,6 @@ void CShaderManager::Init()
 void CShaderManager::Shutdown()
 {
 	shaders.clear();
+	boundShaderStates.clear();
 	LE_LOG( LT_Log, LC_Shader, TEXT( "All shaders unloaded" ) );
 }
\ No newline at end of file
@@ -1,3 +1,5 @@
+#include <float.h>
+
 #include "Containers/String.h"
 #include "Logger/LoggerMacros.h"
 #include "System/Archive.h"
@@ -6,9 +8,31 @@
 #include "Render/SceneUtils.h"
 #include "Render/SceneHitProxyRendering.h"
 
+//
+// Definitions
+//
+
+/* Max index which can be stored in 16-bit index buffer, 0xFFFF is reserved as strip cut value */
+#define STATICMESH_MAX_INDEX16		0xFFFE
+
+/**
+ * @brief Create vertex factory for vertex format
+ * 
+ * @param InVertexFormat	Vertex format
+ * @return Return created vertex factory
+ */
+static FORCEINLINE CStaticMeshVertexFactory* CreateStaticMeshVertexFactory( EStaticMeshVertexFormat InVertexFormat )
+{
+	return InVertexFormat == SMVF_Float ? new CStaticMeshVertexFactory() : new CStaticMeshPackedVertexFactory( InVertexFormat );
+}
+
 CStaticMesh::CStaticMesh()
 	: CAsset( AT_StaticMesh )
-	, vertexFactory( new CStaticMeshVertexFactory() )
+	, vertexFactory( CreateStaticMeshVertexFactory( SMVF_Packed ) )
+	, vertexFormat( SMVF_Packed )
+	, indexStride( sizeof( uint32 ) )
+	, bOccluder( false )
+	, bDirtyPickBVH( true )
 {}
 
 CStaticMesh::~CStaticMesh()
@@ -36,24 +60,43 @@ void CStaticMesh::InitRHI()
 	uint32			numVerteces = ( uint32 )verteces.Num();
 	if ( numVerteces > 0 )
 	{
-		vertexBufferRHI = GRHI->CreateVertexBuffer( CString::Format( TEXT( "%s" ), GetAssetName().c_str() ).c_str(), sizeof( SStaticMeshVertexType ) * numVerteces, ( byte* )verteces.GetData(), RUF_Static );
+		// If vertex format is changed we need other vertex factory. Drawing policies which use old vertex factory are dirty, they will be relinked
+		if ( vertexFactory->GetVertexFormat() != vertexFormat )
+		{
+			vertexFactory = CreateStaticMeshVertexFactory( vertexFormat );
+		}
+
+		// Convert verteces to vertex format
+		uint32					stride = GetStaticMeshVertexStride( vertexFormat );
+		std::vector< byte >		packedVerteces;
+		byte*					vertexData = ( byte* )verteces.GetData();
+		if ( vertexFormat != SMVF_Float )
+		{
+			packedVerteces.resize( stride * numVerteces );
+			PackStaticMeshVerteces( vertexFormat, verteces.GetData(), numVerteces, packedVerteces.data() );
+			vertexData = packedVerteces.data();
+		}
+
+		vertexBufferRHI = GRHI->CreateVertexBuffer( CString::Format( TEXT( "%s" ), GetAssetName().c_str() ).c_str(), stride * numVerteces, vertexData, RUF_Static );
 
 		// Initialize vertex factory
-		vertexFactory->AddVertexStream( SVertexStream{ vertexBufferRHI, sizeof( SStaticMeshVertexType ) } );		// 0 stream slot
+		vertexFactory->AddVertexStream( SVertexStream{ vertexBufferRHI, stride } );		// 0 stream slot
 		vertexFactory->Init();
 	}
 
 	// Create index buffer
-	uint32			numIndeces = ( uint32 )indeces.Num();
+	uint32			numIndeces = GetNumIndeces();
 	if ( numIndeces > 0 )
 	{
-		indexBufferRHI = GRHI->CreateIndexBuffer( CString::Format( TEXT( "%s" ), GetAssetName().c_str() ).c_str(), sizeof( uint32 ), sizeof( uint32 ) * numIndeces, ( byte* )indeces.GetData(), RUF_Static );
+		byte*		indexData = indexStride == sizeof( uint16 ) ? ( byte* )indeces16.GetData() : ( byte* )indeces.GetData();
+		indexBufferRHI = GRHI->CreateIndexBuffer( CString::Format( TEXT( "%s" ), GetAssetName().c_str() ).c_str(), indexStride, indexStride * numIndeces, indexData, RUF_Static );
 	}
 
 	if ( !GIsEditor && !GIsCommandlet )
 	{
 		verteces.RemoveAllElements();
 		indeces.RemoveAllElements();
+		indeces16.RemoveAllElements();
 	}
 }
 
@@ -81,39 +124,257 @@ void CStaticMesh::Serialize( class CArchive& InArchive )
 		InArchive << tmpIndeces;
 
 		verteces = tmpVerteces;
-		indeces = tmpIndeces;
+		SetIndeces( tmpIndeces.data(), tmpIndeces.size() );
 		LE_LOG( LT_Warning, LC_Package, TEXT( "Deprecated package version, in future must be removed supports" ) );
 	}
-	else
+	else if ( InArchive.Ver() < VER_StaticMeshIndex16 )
 	{
 		InArchive << verteces;
 		InArchive << indeces;
+
+		// Old packages contain only 32-bit indeces, convert them to 16 bit if it possible
+		if ( InArchive.IsLoading() )
+		{
+			CBulkData< uint32 >		tmpIndeces = indeces;
+			SetIndeces( tmpIndeces.GetData(), tmpIndeces.Num() );
+		}
+	}
+	else
+	{
+		InArchive << verteces;
+		InArchive << indexStride;
+		if ( indexStride == sizeof( uint16 ) )
+		{
+			InArchive << indeces16;
+			indeces.RemoveAllElements();
+		}
+		else
+		{
+			check( indexStride == sizeof( uint32 ) );
+			InArchive << indeces;
+			indeces16.RemoveAllElements();
+		}
 	}
 
 	InArchive << surfaces;
 	InArchive << materials;
 
+	// Old packages contain meshes only in full precision
+	if ( InArchive.Ver() >= VER_StaticMeshVertexFormat )
+	{
+		uint32		tmpVertexFormat = vertexFormat;
+		InArchive << tmpVertexFormat;
+		vertexFormat = tmpVertexFormat < SMVF_Max ? ( EStaticMeshVertexFormat )tmpVertexFormat : SMVF_Float;
+	}
+	else if ( InArchive.IsLoading() )
+	{
+		vertexFormat = SMVF_Float;
+	}
+
+	// Old packages don't contain LODs
+	if ( InArchive.Ver() >= VER_StaticMeshLODs )
+	{
+		InArchive << lods;
+	}
+	else if ( InArchive.IsLoading() )
+	{
+		lods.clear();
+	}
+
+	// Old packages don't contain occluder flag
+	if ( InArchive.Ver() >= VER_StaticMeshOccluders )
+	{
+		InArchive << bOccluder;
+	}
+	else if ( InArchive.IsLoading() )
+	{
+		bOccluder = false;
+	}
+
 	if ( InArchive.IsLoading() )
 	{
+		// Bound box and occluder must be calculated before creating RHI resources, in game verteces are removed after it
+		CalcBoundBox();
+		BuildOccluder();
+		bDirtyPickBVH = true;
+
 		// Mark dirty all drawing policy links
 		MarkDirtyAllElementDrawingPolices();
 		BeginUpdateResource( this );
 	}
 }
 
-void CStaticMesh::SetData( const std::vector<SStaticMeshVertexType>& InVerteces, const std::vector<uint32>& InIndeces, const std::vector<SStaticMeshSurface>& InSurfaces, const std::vector< TAssetHandle<CMaterial> >& InMaterials )
+void CStaticMesh::SetData( const std::vector<SStaticMeshVertexType>& InVerteces, const std::vector<uint32>& InIndeces, const std::vector<SStaticMeshSurface>& InSurfaces, const std::vector< TAssetHandle<CMaterial> >& InMaterials, const std::vector< SStaticMeshLOD >& InLODs /* = std::vector< SStaticMeshLOD >() */ )
 {
 	// Copy new parameters of static mesh
 	verteces		= InVerteces;
-	indeces			= InIndeces;
 	surfaces		= InSurfaces;
 	materials		= InMaterials;
+	lods			= InLODs;
+	SetIndeces( InIndeces.data(), InIndeces.size() );
+	CalcBoundBox();
+	BuildOccluder();
+	bDirtyPickBVH = true;
 
 	// Mark dirty all drawing policy links
 	MarkDirtyAllElementDrawingPolices();
 	BeginUpdateResource( this );
 }
 
+void CStaticMesh::SetIndeces( const uint32* InIndeces, uint32 InNumIndeces )
+{
+	// Index buffer in 16 bit is used if all indeces fit into it
+	uint32		maxIndex = 0;
+	for ( uint32 index = 0; index < InNumIndeces; ++index )
+	{
+		maxIndex = Max( maxIndex, InIndeces[ index ] );
+	}
+
+	if ( maxIndex <= STATICMESH_MAX_INDEX16 )
+	{
+		indexStride = sizeof( uint16 );
+		indeces16.Resize( InNumIndeces );
+		for ( uint32 index = 0; index < InNumIndeces; ++index )
+		{
+			indeces16.GetElement( index ) = ( uint16 )InIndeces[ index ];
+		}
+		indeces.RemoveAllElements();
+	}
+	else
+	{
+		indexStride = sizeof( uint32 );
+		indeces.SetElements( InIndeces, InNumIndeces );
+		indeces16.RemoveAllElements();
+	}
+}
+
+void CStaticMesh::CalcBoundBox()
+{
+	uint32		numVerteces = ( uint32 )verteces.Num();
+	if ( numVerteces == 0 )
+	{
+		boundbox = CBox();
+		return;
+	}
+
+	Vector		boundMin( FLT_MAX, FLT_MAX, FLT_MAX );
+	Vector		boundMax( -FLT_MAX, -FLT_MAX, -FLT_MAX );
+	for ( uint32 index = 0; index < numVerteces; ++index )
+	{
+		const Vector4D&		position = verteces.GetElement( index ).position;
+		boundMin = Vector( Min( boundMin.x, position.x ), Min( boundMin.y, position.y ), Min( boundMin.z, position.z ) );
+		boundMax = Vector( Max( boundMax.x, position.x ), Max( boundMax.y, position.y ), Max( boundMax.z, position.z ) );
+	}
+	boundbox = CBox( boundMin, boundMax );
+}
+
+void CStaticMesh::BuildOccluder()
+{
+	occluderVerteces.clear();
+	occluderIndeces.clear();
+	if ( !bOccluder || verteces.Num() == 0 )
+	{
+		return;
+	}
+
+	// Occluder is the coarsest LOD, only positions of verteces used by it are kept
+	const std::vector< SStaticMeshSurface >&	lodSurfaces		= GetLODSurfaces( GetNumLODs() - 1 );
+	std::unordered_map< uint32, uint32 >		vertexRemap;
+	for ( uint32 surfaceIndex = 0, numSurfaces = lodSurfaces.size(); surfaceIndex < numSurfaces; ++surfaceIndex )
+	{
+		const SStaticMeshSurface&		surface = lodSurfaces[ surfaceIndex ];
+		for ( uint32 index = surface.firstIndex, count = surface.firstIndex + surface.numPrimitives * 3; index < count; ++index )
+		{
+			const uint32	vertexIndex		= surface.baseVertexIndex + GetIndex( index );
+			auto			itVertex		= vertexRemap.find( vertexIndex );
+			if ( itVertex == vertexRemap.end() )
+			{
+				itVertex = vertexRemap.insert( std::make_pair( vertexIndex, ( uint32 )occluderVerteces.size() ) ).first;
+				occluderVerteces.push_back( Vector( verteces.GetElement( vertexIndex ).position ) );
+			}
+			occluderIndeces.push_back( itVertex->second );
+		}
+	}
+}
+
+void CStaticMesh::BuildPickBVH() const
+{
+	bDirtyPickBVH = false;
+	pickTriangles.clear();
+	pickBVH.Clear();
+	if ( !CanRayCastTriangles() )
+	{
+		return;
+	}
+
+	// Gather triangles of LOD 0 and their bound boxes
+	const std::vector< SStaticMeshSurface >&	lodSurfaces = GetLODSurfaces( 0 );
+	std::vector< Vector >						triangles;
+	std::vector< CBox >							triangleBoxes;
+	triangles.reserve( GetNumPrimitives( 0 ) * 3 );
+	triangleBoxes.reserve( GetNumPrimitives( 0 ) );
+	for ( uint32 surfaceIndex = 0, numSurfaces = lodSurfaces.size(); surfaceIndex < numSurfaces; ++surfaceIndex )
+	{
+		const SStaticMeshSurface&		surface = lodSurfaces[ surfaceIndex ];
+		for ( uint32 index = surface.firstIndex, count = surface.firstIndex + surface.numPrimitives * 3; index < count; index += 3 )
+		{
+			const Vector	vertex0 = Vector( verteces.GetElement( surface.baseVertexIndex + GetIndex( index ) ).position );
+			const Vector	vertex1 = Vector( verteces.GetElement( surface.baseVertexIndex + GetIndex( index + 1 ) ).position );
+			const Vector	vertex2 = Vector( verteces.GetElement( surface.baseVertexIndex + GetIndex( index + 2 ) ).position );
+			triangles.push_back( vertex0 );
+			triangles.push_back( vertex1 );
+			triangles.push_back( vertex2 );
+			triangleBoxes.push_back( CBox( Vector( Min( vertex0.x, Min( vertex1.x, vertex2.x ) ), Min( vertex0.y, Min( vertex1.y, vertex2.y ) ), Min( vertex0.z, Min( vertex1.z, vertex2.z ) ) ),
+										   Vector( Max( vertex0.x, Max( vertex1.x, vertex2.x ) ), Max( vertex0.y, Max( vertex1.y, vertex2.y ) ), Max( vertex0.z, Max( vertex1.z, vertex2.z ) ) ) ) );
+		}
+	}
+
+	pickBVH.Build( triangleBoxes.data(), triangleBoxes.size() );
+	pickTriangles.swap( triangles );
+}
+
+bool CStaticMesh::RayCast( const Vector& InOrigin, const Vector& InDirection, float& InOutDistance ) const
+{
+	if ( bDirtyPickBVH )
+	{
+		BuildPickBVH();
+	}
+
+	return pickBVH.RayCast( InOrigin, InDirection, InOutDistance, [&]( uint32 InTriangleIndex, float& InOutItemDistance ) -> bool
+							{
+								float		distance = 0.f;
+								if ( CBVH::RayTriangleIntersect( InOrigin, InDirection, pickTriangles[ InTriangleIndex * 3 ], pickTriangles[ InTriangleIndex * 3 + 1 ], pickTriangles[ InTriangleIndex * 3 + 2 ], distance ) && distance < InOutItemDistance )
+								{
+									InOutItemDistance = distance;
+									return true;
+								}
+								return false;
+							} );
+}
+
+void CStaticMesh::SetOccluder( bool InIsOccluder )
+{
+	if ( bOccluder == InIsOccluder )
+	{
+		return;
+	}
+
+	bOccluder = InIsOccluder;
+	MarkDirty();
+	BuildOccluder();
+}
+
+uint32 CStaticMesh::GetNumPrimitives( uint32 InLODIndex /* = 0 */ ) const
+{
+	const std::vector< SStaticMeshSurface >&	lodSurfaces		= GetLODSurfaces( InLODIndex );
+	uint32										numPrimitives	= 0;
+	for ( uint32 index = 0, count = lodSurfaces.size(); index < count; ++index )
+	{
+		numPrimitives += lodSurfaces[ index ].numPrimitives;
+	}
+	return numPrimitives;
+}
+
 void CStaticMesh::SetMaterial( uint32 InMaterialIndex, const TAssetHandle<CMaterial>& InNewMaterial )
 {
 	if ( InMaterialIndex > materials.size() )
@@ -132,6 +393,38 @@ void CStaticMesh::SetMaterial( uint32 InMaterialIndex, const TAssetHandle<CMater
 	materials[ InMaterialIndex ] = InNewMaterial;
 }
 
+void CStaticMesh::SetVertexFormat( EStaticMeshVertexFormat InVertexFormat )
+{
+	check( InVertexFormat < SMVF_Max );
+	if ( vertexFormat == InVertexFormat )
+	{
+		return;
+	}
+
+	vertexFormat = InVertexFormat;
+	MarkDirty();
+
+	// Mark dirty all drawing policy links, vertex factory will be changed
+	MarkDirtyAllElementDrawingPolices();
+	BeginUpdateResource( this );
+}
+
+SStaticMeshVertexPrecision CStaticMesh::CalcVertexPrecision() const
+{
+	SStaticMeshVertexPrecision		precision;
+	uint32							numVerteces = ( uint32 )verteces.Num();
+	if ( numVerteces > 0 && vertexFormat != SMVF_Float )
+	{
+		std::vector< byte >		packedVerteces( GetStaticMeshVertexStride( vertexFormat ) * numVerteces );
+		PackStaticMeshVerteces( vertexFormat, verteces.GetData(), numVerteces, packedVerteces.data(), &precision );
+	}
+	else
+	{
+		appMemzero( &precision, sizeof( SStaticMeshVertexPrecision ) );
+	}
+	return precision;
+}
+
 void CStaticMesh::GetDependentAssets( SetDependentAssets_t& OutDependentAssets, EAssetType InFilter /* = AT_Unknown */ ) const
 {
 	// TODO BS yehor.pohuliaka - Need optimize it
@@ -246,44 +539,51 @@ TSharedPtr<CStaticMesh::SElementDrawingPolicyLink> CStaticMesh::MakeDrawingPolic
 	uint32									numOverrideMaterials	= InOverrideMaterials ? InOverrideMaterials->size() : 0;
 	element->overrideHash = InOverrideHash;
 
-	// Generate mesh batch for surface and add to new scene draw policy link
-	for ( uint32 indexSurface = 0, numSurfaces = ( uint32 )surfaces.size(); indexSurface < numSurfaces; ++indexSurface )
+	// Generate mesh batch for surfaces of each LOD and add to new scene draw policy link
+	for ( uint32 indexLOD = 0, numLODs = GetNumLODs(); indexLOD < numLODs; ++indexLOD )
 	{
-		const SStaticMeshSurface&		surface				= surfaces[ indexSurface ];
-		TAssetHandle<CMaterial>			material			= materials[ surface.materialID ];
+		const std::vector< SStaticMeshSurface >&	lodSurfaces = GetLODSurfaces( indexLOD );
+		element->lodMeshBatchLinks.push_back( element->meshBatchLinks.size() );
 
-		// If current material is override - use custom material
-		if ( indexSurface < numOverrideMaterials )
+		for ( uint32 indexSurface = 0, numSurfaces = ( uint32 )lodSurfaces.size(); indexSurface < numSurfaces; ++indexSurface )
 		{
-			TAssetHandle<CMaterial>			overrideMaterial = InOverrideMaterials->at( surface.materialID );
-			if ( overrideMaterial.IsValid() )
+			const SStaticMeshSurface&		surface				= lodSurfaces[ indexSurface ];
+			TAssetHandle<CMaterial>			material			= materials[ surface.materialID ];
+
+			// If current material is override - use custom material
+			if ( surface.materialID < numOverrideMaterials )
 			{
-				material = overrideMaterial;
+				TAssetHandle<CMaterial>			overrideMaterial = InOverrideMaterials->at( surface.materialID );
+				if ( overrideMaterial.IsValid() )
+				{
+					material = overrideMaterial;
+				}
 			}
-		}
 
-		// Generate mesh batch of surface
-		SMeshBatch					meshBatch;
-		meshBatch.baseVertexIndex	= surface.baseVertexIndex;
-		meshBatch.firstIndex		= surface.firstIndex;
-		meshBatch.numPrimitives		= surface.numPrimitives;
-		meshBatch.indexBufferRHI	= indexBufferRHI;
-		meshBatch.primitiveType		= PT_TriangleList;
-
-		// Make and add to scene new static mesh drawing policy link
-		const SMeshBatch*					meshBatchLink				= nullptr;
-		DrawingPolicyLinkRef_t				drawingPolicyLink			= ::MakeDrawingPolicyLink<DrawingPolicyLink_t>( vertexFactory, material, meshBatch, meshBatchLink, InSDG.staticMeshDrawList, DEC_STATIC_MESH );
-		element->drawingPolicyLinks.push_back( drawingPolicyLink );
-		element->meshBatchLinks.push_back( meshBatchLink );
-
-		// Make and add to scene new hit proxy drawing policy link
+			// Generate mesh batch of surface
+			SMeshBatch					meshBatch;
+			meshBatch.baseVertexIndex	= surface.baseVertexIndex;
+			meshBatch.firstIndex		= surface.firstIndex;
+			meshBatch.numPrimitives		= surface.numPrimitives;
+			meshBatch.indexBufferRHI	= indexBufferRHI;
+			meshBatch.primitiveType		= PT_TriangleList;
+
+			// Make and add to scene new static mesh drawing policy link
+			const SMeshBatch*					meshBatchLink				= nullptr;
+			DrawingPolicyLinkRef_t				drawingPolicyLink			= ::MakeDrawingPolicyLink<DrawingPolicyLink_t>( vertexFactory, material, meshBatch, meshBatchLink, InSDG.staticMeshDrawList, DEC_STATIC_MESH );
+			element->drawingPolicyLinks.push_back( drawingPolicyLink );
+			element->meshBatchLinks.push_back( meshBatchLink );
+
+			// Make and add to scene new hit proxy drawing policy link
 #if ENABLE_HITPROXY
-		HitProxyDrawingPolicyLinkRef_t		hitProxyDrawingPolicyLink	= ::MakeDrawingPolicyLink<HitProxyDrawingPolicyLink_t>( vertexFactory, material, meshBatch, meshBatchLink, InSDG.hitProxyLayers[ HPL_World ].hitProxyDrawList, DEC_STATIC_MESH );
-		element->hitProxyDrawingPolicyLinks.push_back( hitProxyDrawingPolicyLink );
-		element->meshBatchLinks.push_back( meshBatchLink );
+			HitProxyDrawingPolicyLinkRef_t		hitProxyDrawingPolicyLink	= ::MakeDrawingPolicyLink<HitProxyDrawingPolicyLink_t>( vertexFactory, material, meshBatch, meshBatchLink, InSDG.hitProxyLayers[ HPL_World ].hitProxyDrawList, DEC_STATIC_MESH );
+			element->hitProxyDrawingPolicyLinks.push_back( hitProxyDrawingPolicyLink );
+			element->meshBatchLinks.push_back( meshBatchLink );
 #endif // ENABLE_HITPROXY
+		}
 	}
 
+	element->lodMeshBatchLinks.push_back( element->meshBatchLinks.size() );
 	return element;
 }
 
@@ -7,6 +7,8 @@
 #include "Misc/EngineGlobals.h"
 #include "Render/Texture.h"
 #include "Render/RenderUtils.h"
+#include "Render/TextureMips.h"
+#include "Render/TextureStreaming.h"
 #include "RHI/BaseRHI.h"
 #include "RHI/BaseSurfaceRHI.h"
 
@@ -14,10 +16,14 @@ CTexture2D::CTexture2D()
 	: CAsset( AT_Texture2D )
 	, sizeX( 0 )
 	, sizeY( 0 )
+	, numMips( 1 )
+	, firstResidentMip( 0 )
+	, streamingIndex( INVALID_ID )
 	, pixelFormat( PF_Unknown )
 	, addressU( SAM_Wrap )
 	, addressV( SAM_Wrap )
 	, samplerFilter( SF_Point )
+	, compression( TC_None )
 {}
 
 CTexture2D::~CTexture2D()
@@ -25,27 +31,79 @@ CTexture2D::~CTexture2D()
 
 void CTexture2D::InitRHI()
 {
-	check( data.Num() > 0 );
-	texture = GRHI->CreateTexture2D( CString::Format( TEXT( "%s" ), GetAssetName().c_str() ).c_str(), sizeX, sizeY, pixelFormat, 1, 0, data.GetData() );
+	// Data contains only resident mips
+	const uint32		residentSizeX	= CalcMipSize( sizeX, firstResidentMip );
+	const uint32		residentSizeY	= CalcMipSize( sizeY, firstResidentMip );
+	const uint32		numResidentMips = GetNumResidentMips();
+	check( data.Num() >= CalcMipChainSize( pixelFormat, residentSizeX, residentSizeY, numResidentMips ) );
+	texture = GRHI->CreateTexture2D( CString::Format( TEXT( "%s" ), GetAssetName().c_str() ).c_str(), residentSizeX, residentSizeY, pixelFormat, numResidentMips, 0, data.GetData() );
 
 	if ( !GIsEditor && !GIsCommandlet )
 	{
 		data.RemoveAllElements();
 	}
+
+	if ( IsStreamable() )
+	{
+		GTextureStreamingManager->AddTexture( this );
+	}
 }
 
 void CTexture2D::ReleaseRHI()
 {
+	if ( streamingIndex != INVALID_ID )
+	{
+		GTextureStreamingManager->RemoveTexture( this );
+	}
 	texture.SafeRelease();
 }
 
-void CTexture2D::SetData( EPixelFormat InPixelFormat, uint32 InSizeX, uint32 InSizeY, const std::vector<byte>& InData )
+void CTexture2D::StreamMips( uint32 InFirstMip, const byte* InData /* = nullptr */ )
+{
+	check( IsInRenderingThread() && IsStreamable() && InFirstMip < numMips );
+	if ( InFirstMip == firstResidentMip || !texture )
+	{
+		return;
+	}
+
+	Texture2DRHIRef_t			newTexture		= GRHI->CreateTexture2D( CString::Format( TEXT( "%s" ), GetAssetName().c_str() ).c_str(), CalcMipSize( sizeX, InFirstMip ), CalcMipSize( sizeY, InFirstMip ), pixelFormat, numMips - InFirstMip, 0 );
+	CBaseDeviceContextRHI*		deviceContext	= GRHI->GetImmediateContext();
+
+	// Upload added mips, the rest of mips are shared with the old texture
+	if ( InFirstMip < firstResidentMip )
+	{
+		check( InData );
+		uint32		offset = 0;
+		for ( uint32 mipIndex = InFirstMip; mipIndex < firstResidentMip; ++mipIndex )
+		{
+			const uint32		mipSize = CalcMipChainSize( pixelFormat, CalcMipSize( sizeX, mipIndex ), CalcMipSize( sizeY, mipIndex ), 1 );
+			SLockedData			lockedData;
+			GRHI->LockTexture2D( deviceContext, newTexture, mipIndex - InFirstMip, true, lockedData );
+			memcpy( lockedData.data, InData + offset, mipSize );
+			GRHI->UnlockTexture2D( deviceContext, newTexture, mipIndex - InFirstMip, lockedData );
+			offset += mipSize;
+		}
+	}
+
+	GRHI->CopySharedMips( deviceContext, newTexture, texture );
+	texture				= newTexture;
+	firstResidentMip	= InFirstMip;
+}
+
+void CTexture2D::SetData( EPixelFormat InPixelFormat, uint32 InSizeX, uint32 InSizeY, const std::vector<byte>& InData, uint32 InNumMips /* = 1 */ )
 {
+	check( InNumMips > 0 && InNumMips <= CalcNumMips( InSizeX, InSizeY ) );
 	pixelFormat		= InPixelFormat;
 	sizeX			= InSizeX;
 	sizeY			= InSizeY;
+	numMips			= InNumMips;
 	data			= InData;
 
+	// New data contains all mips, so it isn't streamed from package
+	firstResidentMip	= 0;
+	streamingFilename.clear();
+	mipOffsets.clear();
+
 	MarkDirty();
 	BeginUpdateResource( this );
 }
@@ -54,6 +112,35 @@ void CTexture2D::Serialize( class CArchive& InArchive )
 {
 	CAsset::Serialize( InArchive );
 
+	// Since VER_TextureStreaming mips are stored after texture properties, so we know their layout before loading
+	if ( InArchive.Ver() >= VER_TextureStreaming )
+	{
+		InArchive << sizeX;
+		InArchive << sizeY;
+		InArchive << pixelFormat;
+		InArchive << addressU;
+		InArchive << addressV;
+		InArchive << samplerFilter;
+		InArchive << numMips;
+		InArchive << compression;
+		SerializeMips( InArchive );
+
+		// If we loading Texture2D - update render resource
+		if ( InArchive.IsLoading() )
+		{
+			BeginUpdateResource( this );
+		}
+		return;
+	}
+
+	// Old packages have all mips in one bulk data, so they can't be streamed
+	if ( InArchive.IsLoading() )
+	{
+		firstResidentMip = 0;
+		streamingFilename.clear();
+		mipOffsets.clear();
+	}
+
 	if ( InArchive.Ver() < VER_RemovedTFC )
 	{
 		std::wstring		textureCachePath;
@@ -82,9 +169,95 @@ void CTexture2D::Serialize( class CArchive& InArchive )
 	InArchive << addressV;
 	InArchive << samplerFilter;
 
+	if ( InArchive.Ver() >= VER_TextureMips )
+	{
+		InArchive << numMips;
+	}
+	else if ( InArchive.IsLoading() )
+	{
+		numMips = 1;
+	}
+
+	if ( InArchive.Ver() >= VER_TextureCompression )
+	{
+		InArchive << compression;
+	}
+	else if ( InArchive.IsLoading() )
+	{
+		compression = TC_None;
+	}
+
 	// If we loading Texture2D - update render resource
 	if ( InArchive.IsLoading() )
 	{
 		BeginUpdateResource( this );
 	}
+}
+
+void CTexture2D::SerializeMips( class CArchive& InArchive )
+{
+	// Table of mip offsets relative to the table, the last offset is the end of mips
+	const uint32			tableOffset = InArchive.Tell();
+	std::vector< uint32 >	offsets( numMips + 1, 0 );
+	for ( uint32 index = 0; index <= numMips; ++index )
+	{
+		InArchive << offsets[ index ];
+	}
+
+	if ( InArchive.IsSaving() )
+	{
+		check( firstResidentMip == 0 && data.Num() >= CalcMipChainSize( pixelFormat, sizeX, sizeY, numMips ) );
+		
+		// Each mip is compressed separately, so the streaming thread can load any of them
+		uint32		dataOffset = 0;
+		for ( uint32 mipIndex = 0; mipIndex < numMips; ++mipIndex )
+		{
+			uint32		mipSize = CalcMipChainSize( pixelFormat, CalcMipSize( sizeX, mipIndex ), CalcMipSize( sizeY, mipIndex ), 1 );
+			offsets[ mipIndex ] = InArchive.Tell() - tableOffset;
+			InArchive << mipSize;
+			InArchive.SerializeCompressed( data.GetData() + dataOffset, mipSize, CF_ZLIB );
+			dataOffset += mipSize;
+		}
+		offsets[ numMips ] = InArchive.Tell() - tableOffset;
+
+		// Update table of mip offsets
+		const uint32		endOffset = InArchive.Tell();
+		InArchive.Seek( tableOffset );
+		for ( uint32 index = 0; index <= numMips; ++index )
+		{
+			InArchive << offsets[ index ];
+		}
+		InArchive.Seek( endOffset );
+	}
+	else
+	{
+		// If texture streaming is enabled, only the tail of mip chain is loaded, other mips are streamed on demand
+		firstResidentMip = GTextureStreamingManager->GetFirstLoadedMip( sizeX, sizeY, numMips );
+		data.Resize( CalcMipChainSize( pixelFormat, CalcMipSize( sizeX, firstResidentMip ), CalcMipSize( sizeY, firstResidentMip ), numMips - firstResidentMip ) );
+
+		uint32		dataOffset = 0;
+		InArchive.Seek( tableOffset + offsets[ firstResidentMip ] );
+		for ( uint32 mipIndex = firstResidentMip; mipIndex < numMips; ++mipIndex )
+		{
+			uint32		mipSize = 0;
+			InArchive << mipSize;
+			check( dataOffset + mipSize <= data.Num() );
+			InArchive.SerializeCompressed( data.GetData() + dataOffset, mipSize, CF_ZLIB );
+			dataOffset += mipSize;
+		}
+		InArchive.Seek( tableOffset + offsets[ numMips ] );
+
+		// Remember where mips are placed for loading them by the streaming thread
+		mipOffsets.clear();
+		streamingFilename.clear();
+		if ( firstResidentMip > 0 )
+		{
+			streamingFilename = InArchive.GetPath();
+			mipOffsets.resize( numMips );
+			for ( uint32 mipIndex = 0; mipIndex < numMips; ++mipIndex )
+			{
+				mipOffsets[ mipIndex ] = tableOffset + offsets[ mipIndex ];
+			}
+		}
+	}
 }
\ No newline at end of file
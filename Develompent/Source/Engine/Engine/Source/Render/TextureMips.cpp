@@ -0,0 +1,212 @@
+#include <math.h>
+#include <emmintrin.h>
+
+#include "Misc/Template.h"
+#include "Render/RenderUtils.h"
+#include "Render/TextureMips.h"
+
+//
+// Definitions
+//
+
+/* Size of table for convert linear value to sRGB, 12 bits of precision is enough for 8 bit sRGB */
+#define LINEAR_TO_SRGB_TABLE_SIZE		4096
+
+/**
+ * Tables for convert texels between sRGB and linear space
+ */
+struct SColorSpaceTables
+{
+	/**
+	 * Constructor
+	 */
+	SColorSpaceTables()
+	{
+		for ( uint32 index = 0; index < 256; ++index )
+		{
+			const float		value = index / 255.f;
+			srgbToLinear[ index ] = value <= 0.04045f ? value / 12.92f : powf( ( value + 0.055f ) / 1.055f, 2.4f );
+		}
+
+		for ( uint32 index = 0; index < LINEAR_TO_SRGB_TABLE_SIZE; ++index )
+		{
+			const float		value	= index / ( float )( LINEAR_TO_SRGB_TABLE_SIZE - 1 );
+			const float		srgb	= value <= 0.0031308f ? value * 12.92f : 1.055f * powf( value, 1.f / 2.4f ) - 0.055f;
+			linearToSRGB[ index ] = ( byte )Clamp( ( int32 )( srgb * 255.f + 0.5f ), 0, 255 );
+		}
+	}
+
+	/**
+	 * Get tables
+	 * @return Return tables, they are initialized on first call
+	 */
+	static const SColorSpaceTables& Get()
+	{
+		static const SColorSpaceTables		tables;
+		return tables;
+	}
+
+	float		srgbToLinear[ 256 ];								/**< Table for convert 8 bit sRGB to linear value */
+	byte		linearToSRGB[ LINEAR_TO_SRGB_TABLE_SIZE ];			/**< Table for convert linear value to 8 bit sRGB */
+};
+
+/**
+ * Convert texels of the top mip to float RGBA
+ *
+ * @param InData		Texels in 8 bit RGBA
+ * @param InNumTexels	Number of texels
+ * @param InIsSRGB		Is color channels stored in sRGB space
+ * @param OutTexels		Output texels in float RGBA
+ */
+static void DecodeTexels( const byte* InData, uint32 InNumTexels, bool InIsSRGB, float* OutTexels )
+{
+	const SColorSpaceTables&		tables = SColorSpaceTables::Get();
+	for ( uint32 index = 0; index < InNumTexels; ++index, InData += 4, OutTexels += 4 )
+	{
+		if ( InIsSRGB )
+		{
+			OutTexels[ 0 ] = tables.srgbToLinear[ InData[ 0 ] ];
+			OutTexels[ 1 ] = tables.srgbToLinear[ InData[ 1 ] ];
+			OutTexels[ 2 ] = tables.srgbToLinear[ InData[ 2 ] ];
+		}
+		else
+		{
+			OutTexels[ 0 ] = InData[ 0 ] / 255.f;
+			OutTexels[ 1 ] = InData[ 1 ] / 255.f;
+			OutTexels[ 2 ] = InData[ 2 ] / 255.f;
+		}
+
+		// Alpha is always linear
+		OutTexels[ 3 ] = InData[ 3 ] / 255.f;
+	}
+}
+
+/**
+ * Convert float RGBA texels to 8 bit RGBA
+ *
+ * @param InTexels		Texels in float RGBA
+ * @param InNumTexels	Number of texels
+ * @param InIsSRGB		Is color channels need to store in sRGB space
+ * @param OutData		Output texels in 8 bit RGBA
+ */
+static void EncodeTexels( const float* InTexels, uint32 InNumTexels, bool InIsSRGB, byte* OutData )
+{
+	const SColorSpaceTables&		tables	= SColorSpaceTables::Get();
+	const __m128					zero	= _mm_setzero_ps();
+	const __m128					one		= _mm_set1_ps( 1.f );
+	const __m128					scale	= InIsSRGB ? _mm_setr_ps( LINEAR_TO_SRGB_TABLE_SIZE - 1, LINEAR_TO_SRGB_TABLE_SIZE - 1, LINEAR_TO_SRGB_TABLE_SIZE - 1, 255.f ) : _mm_set1_ps( 255.f );
+
+	for ( uint32 index = 0; index < InNumTexels; ++index, InTexels += 4, OutData += 4 )
+	{
+		// Clamp to [0;1] and scale to range of table, conversion to integer rounds to nearest
+		__m128		texel = _mm_min_ps( _mm_max_ps( _mm_loadu_ps( InTexels ), zero ), one );
+		__m128i		values = _mm_cvtps_epi32( _mm_mul_ps( texel, scale ) );
+
+		if ( InIsSRGB )
+		{
+			OutData[ 0 ] = tables.linearToSRGB[ _mm_cvtsi128_si32( values ) ];
+			OutData[ 1 ] = tables.linearToSRGB[ _mm_cvtsi128_si32( _mm_srli_si128( values, 4 ) ) ];
+			OutData[ 2 ] = tables.linearToSRGB[ _mm_cvtsi128_si32( _mm_srli_si128( values, 8 ) ) ];
+			OutData[ 3 ] = ( byte )_mm_cvtsi128_si32( _mm_srli_si128( values, 12 ) );
+		}
+		else
+		{
+			// Pack 32 bit integers to bytes, values already are in range [0;255]
+			values = _mm_packs_epi32( values, values );
+			values = _mm_packus_epi16( values, values );
+			*( uint32* )OutData = ( uint32 )_mm_cvtsi128_si32( values );
+		}
+	}
+}
+
+/**
+ * Downsample float RGBA texels by 2x2 box filter
+ * @note If size of source mip is odd, the last row or column is clamped
+ *
+ * @param InTexels		Texels of source mip
+ * @param InSizeX		Width of source mip
+ * @param InSizeY		Height of source mip
+ * @param OutTexels		Output texels of destination mip
+ */
+static void DownsampleTexels( const float* InTexels, uint32 InSizeX, uint32 InSizeY, float* OutTexels )
+{
+	const uint32		dstSizeX	= Max<uint32>( InSizeX >> 1, 1 );
+	const uint32		dstSizeY	= Max<uint32>( InSizeY >> 1, 1 );
+	const __m128		quarter		= _mm_set1_ps( 0.25f );
+
+	for ( uint32 y = 0; y < dstSizeY; ++y )
+	{
+		const float*	row0 = InTexels + ( Min( y * 2, InSizeY - 1 ) * InSizeX ) * 4;
+		const float*	row1 = InTexels + ( Min( y * 2 + 1, InSizeY - 1 ) * InSizeX ) * 4;
+		for ( uint32 x = 0; x < dstSizeX; ++x, OutTexels += 4 )
+		{
+			const uint32	x0 = Min( x * 2, InSizeX - 1 ) * 4;
+			const uint32	x1 = Min( x * 2 + 1, InSizeX - 1 ) * 4;
+			__m128			sum = _mm_add_ps( _mm_add_ps( _mm_loadu_ps( row0 + x0 ), _mm_loadu_ps( row0 + x1 ) ), _mm_add_ps( _mm_loadu_ps( row1 + x0 ), _mm_loadu_ps( row1 + x1 ) ) );
+			_mm_storeu_ps( OutTexels, _mm_mul_ps( sum, quarter ) );
+		}
+	}
+}
+
+uint32 CalcNumMips( uint32 InSizeX, uint32 InSizeY )
+{
+	uint32		numMips = 1;
+	uint32		size	= Max( InSizeX, InSizeY );
+	while ( size > 1 )
+	{
+		size >>= 1;
+		++numMips;
+	}
+	return numMips;
+}
+
+uint32 CalcMipChainSize( EPixelFormat InPixelFormat, uint32 InSizeX, uint32 InSizeY, uint32 InNumMips )
+{
+	const SPixelFormatInfo&		pixelFormatInfo = GPixelFormats[ InPixelFormat ];
+	uint32						size = 0;
+	for ( uint32 mipIndex = 0; mipIndex < InNumMips; ++mipIndex )
+	{
+		const uint32		mipSizeX = Max<uint32>( InSizeX >> mipIndex, pixelFormatInfo.blockSizeX );
+		const uint32		mipSizeY = Max<uint32>( InSizeY >> mipIndex, pixelFormatInfo.blockSizeY );
+		size += ( ( mipSizeX + pixelFormatInfo.blockSizeX - 1 ) / pixelFormatInfo.blockSizeX ) * ( ( mipSizeY + pixelFormatInfo.blockSizeY - 1 ) / pixelFormatInfo.blockSizeY ) * pixelFormatInfo.blockBytes;
+	}
+	return size;
+}
+
+uint32 GenerateMipChain( EPixelFormat InPixelFormat, uint32 InSizeX, uint32 InSizeY, const byte* InData, std::vector< byte >& OutData, bool InIsSRGB /* = true */ )
+{
+	check( InData && InSizeX > 0 && InSizeY > 0 );
+	const uint32		topMipSize = CalcMipChainSize( InPixelFormat, InSizeX, InSizeY, 1 );
+	if ( InPixelFormat != PF_A8R8G8B8 )
+	{
+		OutData.resize( topMipSize );
+		memcpy( OutData.data(), InData, topMipSize );
+		return 1;
+	}
+
+	const uint32		numMips = CalcNumMips( InSizeX, InSizeY );
+	OutData.resize( CalcMipChainSize( InPixelFormat, InSizeX, InSizeY, numMips ) );
+	memcpy( OutData.data(), InData, topMipSize );
+
+	// Filter all mip chain in float precision, each mip is quantized to 8 bit only on output
+	std::vector< float >		srcTexels( InSizeX * InSizeY * 4 );
+	std::vector< float >		dstTexels( Max<uint32>( InSizeX >> 1, 1 ) * Max<uint32>( InSizeY >> 1, 1 ) * 4 );
+	DecodeTexels( InData, InSizeX * InSizeY, InIsSRGB, srcTexels.data() );
+
+	uint32		offset	= topMipSize;
+	uint32		sizeX	= InSizeX;
+	uint32		sizeY	= InSizeY;
+	for ( uint32 mipIndex = 1; mipIndex < numMips; ++mipIndex )
+	{
+		DownsampleTexels( srcTexels.data(), sizeX, sizeY, dstTexels.data() );
+		sizeX = Max<uint32>( sizeX >> 1, 1 );
+		sizeY = Max<uint32>( sizeY >> 1, 1 );
+
+		EncodeTexels( dstTexels.data(), sizeX * sizeY, InIsSRGB, OutData.data() + offset );
+		offset += sizeX * sizeY * 4;
+		srcTexels.swap( dstTexels );
+	}
+
+	check( offset == OutData.size() );
+	return numMips;
+}
\ No newline at end of file
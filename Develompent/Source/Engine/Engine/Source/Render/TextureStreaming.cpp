@@ -0,0 +1,519 @@
+#include <math.h>
+
+#include "Math/Math.h"
+#include "Misc/CoreGlobals.h"
+#include "Misc/EngineGlobals.h"
+#include "Misc/Template.h"
+#include "Logger/LoggerMacros.h"
+#include "System/Archive.h"
+#include "System/BaseFileSystem.h"
+#include "System/Config.h"
+#include "Components/PrimitiveComponent.h"
+#include "Render/Material.h"
+#include "Render/Scene.h"
+#include "Render/RenderingThread.h"
+#include "Render/TextureMips.h"
+#include "Render/TextureStreaming.h"
+
+//
+// Definitions
+//
+
+/* Default memory budget for streaming textures, in megabytes */
+#define TEXTURESTREAMING_DEFAULT_POOL_SIZE				256
+
+/* Default size of mips which are always resident */
+#define TEXTURESTREAMING_DEFAULT_MIN_RESIDENT_MIP_SIZE	64
+
+/* Default delay in seconds before drop mips which aren't wanted anymore */
+#define TEXTURESTREAMING_DEFAULT_DROP_DELAY				5.f
+
+/**
+ * @ingroup Engine
+ * @brief The texture streaming thread runnable object
+ */
+class CTextureStreamingThread : public CRunnable
+{
+public:
+	/**
+	 * @brief Constructor
+	 * @param InManager		Texture streaming manager
+	 */
+	CTextureStreamingThread( CTextureStreamingManager* InManager )
+		: bStopping( false )
+		, manager( InManager )
+	{}
+
+	/**
+	 * @brief Initialize
+	 * @return True if initialization was successful, false otherwise
+	 */
+	virtual bool Init() override
+	{
+		return true;
+	}
+
+	/**
+	 * @brief Run
+	 * @return The exit code of the runnable object
+	 */
+	virtual uint32 Run() override
+	{
+		while ( !bStopping )
+		{
+			TextureMipsRequestRef_t		request = manager->PopRequest();
+			if ( !request )
+			{
+				manager->queueEvent->Wait();
+				continue;
+			}
+
+			request->Load();
+		}
+		return 0;
+	}
+
+	/**
+	 * @brief Stop
+	 */
+	virtual void Stop() override
+	{
+		bStopping = true;
+		manager->queueEvent->Trigger();
+	}
+
+	/**
+	 * @brief Exit
+	 */
+	virtual void Exit() override
+	{}
+
+private:
+	volatile bool					bStopping;		/**< Is thread stopping */
+	CTextureStreamingManager*		manager;		/**< Texture streaming manager */
+};
+
+void CTextureMipsRequest::Load()
+{
+	if ( bCanceled )
+	{
+		bCompleted = true;
+		return;
+	}
+
+	CArchive*		archive = GFileSystem->CreateFileReader( filename );
+	if ( !archive )
+	{
+		LE_LOG( LT_Warning, LC_Package, TEXT( "Failed to open package '%s' for streaming texture mips" ), filename.c_str() );
+		bFailed		= true;
+		bCompleted	= true;
+		return;
+	}
+
+	// Mips are placed in package one after another, but each of them is read by own offset
+	archive->SerializeHeader();
+	data.resize( CalcMipChainSize( pixelFormat, sizeX, sizeY, numMips ) );
+
+	uint32		dataOffset = 0;
+	for ( uint32 index = 0; index < numMips && !bCanceled; ++index )
+	{
+		uint32		mipSize = 0;
+		archive->Seek( mipOffsets[ index ] );
+		*archive << mipSize;
+		if ( dataOffset + mipSize > data.size() )
+		{
+			LE_LOG( LT_Warning, LC_Package, TEXT( "Mip %i in package '%s' is corrupted" ), firstMip + index, filename.c_str() );
+			bFailed = true;
+			break;
+		}
+
+		archive->SerializeCompressed( data.data() + dataOffset, mipSize, CF_ZLIB );
+		dataOffset += mipSize;
+	}
+
+	delete archive;
+	bCompleted = true;
+}
+
+CTextureStreamingManager::CTextureStreamingManager()
+	: bEnabled( false )
+	, budgetSize( ( uint64 )TEXTURESTREAMING_DEFAULT_POOL_SIZE * 1024 * 1024 )
+	, minResidentMipSize( TEXTURESTREAMING_DEFAULT_MIN_RESIDENT_MIP_SIZE )
+	, dropDelay( TEXTURESTREAMING_DEFAULT_DROP_DELAY )
+	, queueEvent( nullptr )
+	, thread( nullptr )
+	, threadRunnable( nullptr )
+{}
+
+CTextureStreamingManager::~CTextureStreamingManager()
+{
+	Shutdown();
+}
+
+void CTextureStreamingManager::Init()
+{
+	CConfigValue		configEnabled			= GConfig.GetValue( CT_Engine, TEXT( "Engine.TextureStreaming" ), TEXT( "Enabled" ) );
+	CConfigValue		configPoolSize			= GConfig.GetValue( CT_Engine, TEXT( "Engine.TextureStreaming" ), TEXT( "PoolSizeMB" ) );
+	CConfigValue		configMinResidentMip	= GConfig.GetValue( CT_Engine, TEXT( "Engine.TextureStreaming" ), TEXT( "MinResidentMipSize" ) );
+	CConfigValue		configDropDelay			= GConfig.GetValue( CT_Engine, TEXT( "Engine.TextureStreaming" ), TEXT( "DropDelay" ) );
+
+	bEnabled = configEnabled.IsValid() && configEnabled.GetBool();
+	if ( configPoolSize.IsValid() )
+	{
+		budgetSize = ( uint64 )Max( configPoolSize.GetInt(), 1 ) * 1024 * 1024;
+	}
+
+	if ( configMinResidentMip.IsValid() )
+	{
+		minResidentMipSize = Max( configMinResidentMip.GetInt(), 1 );
+	}
+
+	if ( configDropDelay.IsValid() )
+	{
+		dropDelay = Max( configDropDelay.GetNumber(), 0.f );
+	}
+
+	if ( !bEnabled )
+	{
+		LE_LOG( LT_Log, LC_Init, TEXT( "Texture streaming is disabled" ) );
+		return;
+	}
+
+	// Start the streaming thread
+	queueEvent		= GSynchronizeFactory->CreateSynchEvent( false, TEXT( "TextureStreamingQueue" ) );
+	threadRunnable	= new CTextureStreamingThread( this );
+	thread			= GThreadFactory->CreateThread( threadRunnable, TEXT( "TextureStreamingThread" ), 0, 0, 0, TP_BelowNormal );
+	check( queueEvent && thread );
+
+#if !SHIPPING_BUILD
+	stats.budgetSize = budgetSize;
+#endif // !SHIPPING_BUILD
+	LE_LOG( LT_Log, LC_Init, TEXT( "Texture streaming is enabled, pool size %llu MB, min resident mip size %i" ), budgetSize / ( 1024 * 1024 ), minResidentMipSize );
+}
+
+void CTextureStreamingManager::Shutdown()
+{
+	if ( thread )
+	{
+		threadRunnable->Stop();
+		thread->WaitForCompletion();
+		thread->Kill();
+
+		GThreadFactory->Destroy( thread );
+		delete threadRunnable;
+		thread			= nullptr;
+		threadRunnable	= nullptr;
+	}
+
+	if ( queueEvent )
+	{
+		GSynchronizeFactory->Destroy( queueEvent );
+		queueEvent = nullptr;
+	}
+
+	// Requests which weren't taken by the streaming thread will never be completed
+	CScopeLock		scopeLock( queueCriticalSection );
+	for ( uint32 index = 0, count = queue.size(); index < count; ++index )
+	{
+		queue[ index ]->bCanceled	= true;
+		queue[ index ]->bFailed		= true;
+		queue[ index ]->bCompleted	= true;
+	}
+	queue.clear();
+}
+
+void CTextureStreamingManager::Tick( float InDeltaSeconds )
+{
+	if ( !bEnabled )
+	{
+		return;
+	}
+
+	UNIQUE_RENDER_COMMAND_TWOPARAMETER( CUpdateTextureStreamingCommand,
+										CTextureStreamingManager*, manager, this,
+										float, deltaSeconds, InDeltaSeconds,
+										{
+											manager->UpdateStreaming( deltaSeconds );
+										} );
+}
+
+uint32 CTextureStreamingManager::GetFirstLoadedMip( uint32 InSizeX, uint32 InSizeY, uint32 InNumMips ) const
+{
+	if ( !bEnabled )
+	{
+		return 0;
+	}
+
+	// First mip which isn't bigger than min resident size, the smallest mip is always resident
+	uint32		firstMip = 0;
+	while ( firstMip + 1 < InNumMips && Max( CalcMipSize( InSizeX, firstMip ), CalcMipSize( InSizeY, firstMip ) ) > minResidentMipSize )
+	{
+		++firstMip;
+	}
+	return firstMip;
+}
+
+uint32 CTextureStreamingManager::CalcResidentSize( const CTexture2D* InTexture, uint32 InNumMips )
+{
+	const uint32		firstMip = InTexture->numMips - InNumMips;
+	return CalcMipChainSize( InTexture->pixelFormat, CalcMipSize( InTexture->sizeX, firstMip ), CalcMipSize( InTexture->sizeY, firstMip ), InNumMips );
+}
+
+void CTextureStreamingManager::AddTexture( CTexture2D* InTexture )
+{
+	check( IsInRenderingThread() && InTexture );
+	if ( !bEnabled || InTexture->streamingIndex != INVALID_ID )
+	{
+		return;
+	}
+
+	STextureState		state;
+	state.texture			= InTexture;
+	state.wantedMips		= InTexture->numMips - GetFirstLoadedMip( InTexture->sizeX, InTexture->sizeY, InTexture->numMips );
+	state.lastWantedMips	= state.wantedMips;
+	state.lastSeenTime		= 0.f;
+
+	InTexture->streamingIndex = textures.size();
+	textures.push_back( state );
+}
+
+void CTextureStreamingManager::RemoveTexture( CTexture2D* InTexture )
+{
+	check( IsInRenderingThread() && InTexture );
+	const uint32		index = InTexture->streamingIndex;
+	if ( index == INVALID_ID )
+	{
+		return;
+	}
+	check( index < textures.size() && textures[ index ].texture == InTexture );
+
+	// Loaded mips of released texture aren't needed anymore
+	if ( textures[ index ].request )
+	{
+		textures[ index ].request->bCanceled = true;
+	}
+
+	// Move the last texture to place of removed one
+	if ( index != textures.size() - 1 )
+	{
+		textures[ index ]							= textures.back();
+		textures[ index ].texture->streamingIndex	= index;
+	}
+	textures.pop_back();
+	InTexture->streamingIndex = INVALID_ID;
+}
+
+void CTextureStreamingManager::AddVisiblePrimitive( CPrimitiveComponent* InPrimitive, const CSceneView& InSceneView )
+{
+	check( IsInRenderingThread() && InPrimitive );
+	if ( !bEnabled || textures.empty() )
+	{
+		return;
+	}
+
+	// Projected size of bounding sphere in pixels, for orthographic projection W is 1
+	float				screenSize	= Max( InSceneView.GetSizeX(), InSceneView.GetSizeY() );
+	const CBox&			boundBox	= InPrimitive->GetBoundBox();
+	if ( boundBox.IsValid() )
+	{
+		const Matrix&		projectionMatrix	= InSceneView.GetProjectionMatrix();
+		const Vector		center				= ( boundBox.GetMin() + boundBox.GetMax() ) * 0.5f;
+		const float			radius				= SMath::LengthVector( boundBox.GetMax() - boundBox.GetMin() ) * 0.5f;
+		const float			w					= Max( InSceneView.WorldToScreen( center ).w, 0.0001f );
+		screenSize = radius * Max( fabsf( projectionMatrix[ 0 ][ 0 ] ) * InSceneView.GetSizeX(), fabsf( projectionMatrix[ 1 ][ 1 ] ) * InSceneView.GetSizeY() ) / w;
+	}
+
+	usedMaterials.clear();
+	InPrimitive->GetUsedMaterials( usedMaterials );
+	for ( uint32 materialIndex = 0, numMaterials = usedMaterials.size(); materialIndex < numMaterials; ++materialIndex )
+	{
+		TSharedPtr<CMaterial>		materialRef = usedMaterials[ materialIndex ].ToSharedPtr();
+		if ( !materialRef )
+		{
+			continue;
+		}
+
+		const auto&		textureParameters = materialRef->GetTextureParameters();
+		for ( auto itTexture = textureParameters.begin(), itTextureEnd = textureParameters.end(); itTexture != itTextureEnd; ++itTexture )
+		{
+			TSharedPtr<CTexture2D>		textureRef = itTexture->second.ToSharedPtr();
+			if ( !textureRef || textureRef->streamingIndex == INVALID_ID )
+			{
+				continue;
+			}
+
+			// Texture is mapped once on the primitive, so the wanted mip is the smallest one which isn't less than screen size
+			const uint32		textureSize = Max( textureRef->sizeX, textureRef->sizeY );
+			uint32				wantedMips	= textureRef->numMips;
+			while ( wantedMips > 1 && ( float )( textureSize >> ( textureRef->numMips - wantedMips + 1 ) ) >= screenSize )
+			{
+				--wantedMips;
+			}
+
+			STextureState&		state = textures[ textureRef->streamingIndex ];
+			state.wantedMips = Max( state.wantedMips, wantedMips );
+		}
+	}
+}
+
+void CTextureStreamingManager::UpdateStreaming( float InDeltaSeconds )
+{
+	check( IsInRenderingThread() );
+
+	// Finish loaded mips and update wanted mips, texture keeps mips which aren't wanted anymore until drop delay is expired
+	uint64		requestedSize		= 0;
+	uint32		numRequestedMips	= 0;
+	for ( uint32 index = 0, count = textures.size(); index < count; ++index )
+	{
+		STextureState&		state = textures[ index ];
+		if ( state.request && state.request->bCompleted )
+		{
+			FinishRequest( state );
+		}
+
+		if ( state.wantedMips >= state.lastWantedMips )
+		{
+			state.lastWantedMips	= state.wantedMips;
+			state.lastSeenTime		= 0.f;
+		}
+		else
+		{
+			state.lastSeenTime += InDeltaSeconds;
+			if ( state.lastSeenTime >= dropDelay )
+			{
+				state.lastWantedMips	= state.wantedMips;
+				state.lastSeenTime		= 0.f;
+			}
+		}
+
+		// Reset wanted mips for the next frame to mips which are always resident
+		CTexture2D*		texture = state.texture;
+		state.wantedMips	= texture->numMips - GetFirstLoadedMip( texture->sizeX, texture->sizeY, texture->numMips );
+		requestedSize		+= CalcResidentSize( texture, state.lastWantedMips );
+		numRequestedMips	+= state.lastWantedMips;
+	}
+
+	// If wanted mips don't fit into budget, drop the same number of top mips from all textures
+	uint32		mipBias		= 0;
+	uint64		targetSize	= requestedSize;
+	while ( targetSize > budgetSize )
+	{
+		bool		bCanDrop = false;
+		++mipBias;
+		targetSize = 0;
+		for ( uint32 index = 0, count = textures.size(); index < count; ++index )
+		{
+			const STextureState&	state		= textures[ index ];
+			const uint32			minMips		= state.wantedMips;
+			const uint32			targetMips	= state.lastWantedMips > minMips + mipBias ? state.lastWantedMips - mipBias : minMips;
+			bCanDrop	|= state.lastWantedMips > minMips + mipBias;
+			targetSize	+= CalcResidentSize( state.texture, targetMips );
+		}
+
+		// All textures have only mips which are always resident
+		if ( !bCanDrop )
+		{
+			break;
+		}
+	}
+
+	// Stream mips in and out
+	uint64		residentSize		= 0;
+	uint32		numResidentMips		= 0;
+	uint32		numPendingRequests	= 0;
+	for ( uint32 index = 0, count = textures.size(); index < count; ++index )
+	{
+		STextureState&		state			= textures[ index ];
+		CTexture2D*			texture			= state.texture;
+		const uint32		minMips			= state.wantedMips;
+		const uint32		targetMips		= state.lastWantedMips > minMips + mipBias ? state.lastWantedMips - mipBias : minMips;
+		const uint32		residentMips	= texture->GetNumResidentMips();
+
+		// Texture is changed only when there isn't pending request
+		if ( state.request )
+		{
+			++numPendingRequests;
+		}
+		else if ( targetMips > residentMips )
+		{
+			const uint32				firstMip	= texture->numMips - targetMips;
+			CTextureMipsRequest*		request		= new CTextureMipsRequest();
+			request->filename		= texture->streamingFilename;
+			request->pixelFormat	= texture->pixelFormat;
+			request->sizeX			= CalcMipSize( texture->sizeX, firstMip );
+			request->sizeY			= CalcMipSize( texture->sizeY, firstMip );
+			request->firstMip		= firstMip;
+			request->numMips		= texture->firstResidentMip - firstMip;
+			request->mipOffsets.assign( texture->mipOffsets.begin() + firstMip, texture->mipOffsets.begin() + texture->firstResidentMip );
+
+			state.request = request;
+			PushRequest( request );
+			++numPendingRequests;
+		}
+		else if ( targetMips < residentMips )
+		{
+			texture->StreamMips( texture->numMips - targetMips );
+#if !SHIPPING_BUILD
+			++stats.numStreamedOut;
+#endif // !SHIPPING_BUILD
+		}
+
+		residentSize	+= CalcResidentSize( texture, texture->GetNumResidentMips() );
+		numResidentMips += texture->GetNumResidentMips();
+	}
+
+#if !SHIPPING_BUILD
+	stats.numTextures			= textures.size();
+	stats.numResidentMips		= numResidentMips;
+	stats.numRequestedMips		= numRequestedMips;
+	stats.numPendingRequests	= numPendingRequests;
+	stats.mipBias				= mipBias;
+	stats.residentSize			= residentSize;
+	stats.requestedSize			= requestedSize;
+	stats.budgetSize			= budgetSize;
+#endif // !SHIPPING_BUILD
+}
+
+void CTextureStreamingManager::FinishRequest( STextureState& InState )
+{
+	TextureMipsRequestRef_t		request = InState.request;
+	CTexture2D*					texture = InState.texture;
+	InState.request = nullptr;
+
+	// Resident mips aren't changed while request is pending, so loaded mips are placed right above them
+	if ( request->bFailed || request->bCanceled )
+	{
+		return;
+	}
+	check( request->firstMip + request->numMips == texture->firstResidentMip );
+	texture->StreamMips( request->firstMip, request->data.data() );
+
+#if !SHIPPING_BUILD
+	++stats.numStreamedIn;
+	stats.totalLoadedSize += request->data.size();
+#endif // !SHIPPING_BUILD
+}
+
+void CTextureStreamingManager::PushRequest( CTextureMipsRequest* InRequest )
+{
+	check( thread );
+	{
+		CScopeLock		scopeLock( queueCriticalSection );
+		queue.push_back( InRequest );
+	}
+	queueEvent->Trigger();
+}
+
+TextureMipsRequestRef_t CTextureStreamingManager::PopRequest()
+{
+	CScopeLock		scopeLock( queueCriticalSection );
+	if ( queue.empty() )
+	{
+		return nullptr;
+	}
+
+	// Requests are loaded in order of adding
+	TextureMipsRequestRef_t		request = queue.front();
+	queue.erase( queue.begin() );
+	return request;
+}
\ No newline at end of file
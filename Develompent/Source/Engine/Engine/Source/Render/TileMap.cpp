@@ -0,0 +1,118 @@
+#include <float.h>
+#include <algorithm>
+
+#include "Misc/CoreGlobals.h"
+#include "Misc/EngineGlobals.h"
+#include "Misc/Template.h"
+#include "System/Archive.h"
+#include "RHI/BaseRHI.h"
+#include "Render/TileMap.h"
+
+CTileMapChunk::CTileMapChunk()
+	: vertexFactory( new CSpriteVertexFactory() )
+	, numTiles( 0 )
+{}
+
+void CTileMapChunk::Serialize( class CArchive& InArchive )
+{
+	InArchive << verteces;
+	InArchive << indeces;
+	InArchive << surfaces;
+	InArchive << numTiles;
+
+	Vector		boundMin = boundbox.GetMin();
+	Vector		boundMax = boundbox.GetMax();
+	InArchive << boundMin;
+	InArchive << boundMax;
+
+	if ( InArchive.IsLoading() )
+	{
+		boundbox = CBox( boundMin, boundMax );
+	}
+}
+
+void CTileMapChunk::SetTiles( const std::vector< STileMapTile >& InTiles, const Vector2D& InTileSize )
+{
+	// Sort tiles by material for draw each material in one call
+	std::vector< STileMapTile >		tiles = InTiles;
+	std::stable_sort( tiles.begin(), tiles.end(), []( const STileMapTile& InA, const STileMapTile& InB ) { return InA.materialIndex < InB.materialIndex; } );
+
+	numTiles = ( uint32 )tiles.size();
+	check( numTiles * 4 <= 0xFFFF );		// All verteces must be fit into 16-bit indeces
+
+	verteces.Resize( numTiles * 4 );
+	indeces.Resize( numTiles * 6 );
+	surfaces.clear();
+
+	Vector		boundMin( FLT_MAX, FLT_MAX, FLT_MAX );
+	Vector		boundMax( -FLT_MAX, -FLT_MAX, -FLT_MAX );
+	for ( uint32 index = 0; index < numTiles; ++index )
+	{
+		const STileMapTile&		tile		= tiles[ index ];
+		const RectFloat_t&		textureRect = tile.textureRect;
+		float					x0			= tile.x * InTileSize.x;
+		float					y0			= tile.y * InTileSize.y;
+		float					x1			= x0 + tile.size.x;
+		float					y1			= y0 + tile.size.y;
+		float					z			= tile.layer;
+		float					u0			= textureRect.left;
+		float					v0			= textureRect.top;
+		float					u1			= textureRect.left + textureRect.width;
+		float					v1			= textureRect.top + textureRect.height;
+
+		// Same layout as in GSpriteMesh, but with applied size of tile and texture rect
+		uint32		baseVertex = index * 4;
+		verteces.GetElement( baseVertex + 0 ) = SSpriteVertexType{ Vector4D( x0, y0, z, 1.f ), Vector2D( u0, v1 ), Vector4D( 0.f, 0.f, 0.f, 0.f ) };
+		verteces.GetElement( baseVertex + 1 ) = SSpriteVertexType{ Vector4D( x0, y1, z, 1.f ), Vector2D( u0, v0 ), Vector4D( 0.f, 1.f, 0.f, 0.f ) };
+		verteces.GetElement( baseVertex + 2 ) = SSpriteVertexType{ Vector4D( x1, y1, z, 1.f ), Vector2D( u1, v0 ), Vector4D( 1.f, 1.f, 0.f, 0.f ) };
+		verteces.GetElement( baseVertex + 3 ) = SSpriteVertexType{ Vector4D( x1, y0, z, 1.f ), Vector2D( u1, v1 ), Vector4D( 1.f, 0.f, 0.f, 0.f ) };
+
+		uint32		baseIndex = index * 6;
+		indeces.GetElement( baseIndex + 0 ) = ( uint16 )( baseVertex + 0 );
+		indeces.GetElement( baseIndex + 1 ) = ( uint16 )( baseVertex + 1 );
+		indeces.GetElement( baseIndex + 2 ) = ( uint16 )( baseVertex + 2 );
+		indeces.GetElement( baseIndex + 3 ) = ( uint16 )( baseVertex + 0 );
+		indeces.GetElement( baseIndex + 4 ) = ( uint16 )( baseVertex + 2 );
+		indeces.GetElement( baseIndex + 5 ) = ( uint16 )( baseVertex + 3 );
+
+		// Start new surface if material is changed
+		if ( surfaces.empty() || surfaces.back().materialIndex != tile.materialIndex )
+		{
+			surfaces.push_back( STileMapSurface{ tile.materialIndex, baseIndex, 0 } );
+		}
+		surfaces.back().numPrimitives += 2;
+
+		boundMin = Vector( Min( boundMin.x, x0 ), Min( boundMin.y, y0 ), Min( boundMin.z, z ) );
+		boundMax = Vector( Max( boundMax.x, x1 ), Max( boundMax.y, y1 ), Max( boundMax.z, z ) );
+	}
+
+	boundbox = numTiles > 0 ? CBox( boundMin, boundMax ) : CBox();
+}
+
+void CTileMapChunk::InitRHI()
+{
+	uint32		numVerteces = verteces.Num();
+	uint32		numIndeces	= indeces.Num();
+	if ( numVerteces > 0 && numIndeces > 0 )
+	{
+		vertexBufferRHI = GRHI->CreateVertexBuffer( TEXT( "TileMapChunk" ), sizeof( SSpriteVertexType ) * numVerteces, ( byte* )verteces.GetData(), RUF_Static );
+		indexBufferRHI	= GRHI->CreateIndexBuffer( TEXT( "TileMapChunk" ), sizeof( uint16 ), sizeof( uint16 ) * numIndeces, ( byte* )indeces.GetData(), RUF_Static );
+
+		// Initialize vertex factory
+		vertexFactory->AddVertexStream( SVertexStream{ vertexBufferRHI, sizeof( SSpriteVertexType ) } );		// 0 stream slot
+		vertexFactory->Init();
+	}
+
+	if ( !GIsEditor && !GIsCommandlet )
+	{
+		verteces.RemoveAllElements();
+		indeces.RemoveAllElements();
+	}
+}
+
+void CTileMapChunk::ReleaseRHI()
+{
+	vertexBufferRHI.SafeRelease();
+	indexBufferRHI.SafeRelease();
+	vertexFactory->ReleaseResource();
+}
\ No newline at end of file
@@ -11,8 +11,8 @@ void CSceneRenderer::RenderUI( class CBaseDeviceContextRHI* InDeviceContext )
 {
 	SCOPED_DRAW_EVENT( EventUI, DEC_CANVAS, TEXT( "UI" ) );
 	GSceneRenderTargets.BeginRenderingSceneColor( InDeviceContext );
-	GRHI->SetBlendState( InDeviceContext, TStaticBlendStateRHI<>::GetRHI() );
-	GRHI->SetDepthState( InDeviceContext, TStaticDepthStateRHI<true>::GetRHI() );
+	InDeviceContext->SetBlendState( TStaticBlendStateRHI<>::GetRHI() );
+	InDeviceContext->SetDepthState( TStaticDepthStateRHI<true>::GetRHI() );
 
 	// Render WorldEd background and foreground layer (only in editor)
 #if WITH_EDITOR
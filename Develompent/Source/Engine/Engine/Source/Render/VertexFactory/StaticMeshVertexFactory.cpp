@@ -3,33 +3,212 @@
 #include "Render/VertexFactory/GeneralVertexFactoryParams.h"
 
 IMPLEMENT_VERTEX_FACTORY_TYPE( CStaticMeshVertexFactory, TEXT( "StaticMeshVertexFactory.hlsl" ), false, 0 )
+IMPLEMENT_VERTEX_FACTORY_TYPE( CStaticMeshPackedVertexFactory, TEXT( "StaticMeshPackedVertexFactory.hlsl" ), false, 0 )
 
 //
 // GLOBALS
 //
 TGlobalResource< CStaticMeshVertexDeclaration >			GStaticMeshVertexDeclaration;
 
+/**
+ * @brief Pack normalized vector to 10:10:10:2
+ *
+ * @param InVector	Vector
+ * @param InW		Value of 2-bit W
+ * @return Return packed vector
+ */
+static FORCEINLINE uint32 PackUDec4N( const Vector& InVector, uint32 InW )
+{
+	float		length = SMath::LengthVector( InVector );
+	Vector		normal = length > 0.f ? InVector / length : Vector( 0.f, 0.f, 1.f );
+	uint32		x = ( uint32 )SMath::Round( SMath::Clamp( normal.x * 0.5f + 0.5f, 0.f, 1.f ) * 1023.f );
+	uint32		y = ( uint32 )SMath::Round( SMath::Clamp( normal.y * 0.5f + 0.5f, 0.f, 1.f ) * 1023.f );
+	uint32		z = ( uint32 )SMath::Round( SMath::Clamp( normal.z * 0.5f + 0.5f, 0.f, 1.f ) * 1023.f );
+	return x | ( y << 10 ) | ( z << 20 ) | ( ( InW & 3 ) << 30 );
+}
+
+/**
+ * @brief Unpack vector from 10:10:10:2 as it is done in shader
+ *
+ * @param InValue	Packed vector
+ * @return Return unpacked vector
+ */
+static FORCEINLINE Vector UnpackUDec4N( uint32 InValue )
+{
+	return Vector( ( InValue & 1023 ) / 1023.f, ( ( InValue >> 10 ) & 1023 ) / 1023.f, ( ( InValue >> 20 ) & 1023 ) / 1023.f ) * 2.f - 1.f;
+}
+
+/**
+ * @brief Calculate angle between directions
+ *
+ * @param InA	Direction A
+ * @param InB	Direction B
+ * @return Return angle in degrees
+ */
+static FORCEINLINE float CalcAngleError( const Vector& InA, const Vector& InB )
+{
+	float	lengthA = SMath::LengthVector( InA );
+	float	lengthB = SMath::LengthVector( InB );
+	if ( lengthA <= 0.f || lengthB <= 0.f )
+	{
+		return 0.f;
+	}
+	return SMath::RadiansToDegrees( SMath::ACos( SMath::Clamp( SMath::DotVector( InA, InB ) / ( lengthA * lengthB ), -1.f, 1.f ) ) );
+}
+
+uint32 GetStaticMeshVertexStride( EStaticMeshVertexFormat InVertexFormat )
+{
+	switch ( InVertexFormat )
+	{
+	case SMVF_Float:		return sizeof( SStaticMeshVertexType );
+	case SMVF_Packed:		return sizeof( SStaticMeshPackedVertexType );
+	case SMVF_PackedHalf:	return sizeof( SStaticMeshPackedHalfVertexType );
+	default:
+		checkMsg( false, TEXT( "Unknown static mesh vertex format 0x%X" ), InVertexFormat );
+		return 0;
+	}
+}
+
+const tchar* StaticMeshVertexFormatToText( EStaticMeshVertexFormat InVertexFormat )
+{
+	switch ( InVertexFormat )
+	{
+	case SMVF_Float:		return TEXT( "Float" );
+	case SMVF_Packed:		return TEXT( "Packed" );
+	case SMVF_PackedHalf:	return TEXT( "Packed Half" );
+	default:				return TEXT( "Unknown" );
+	}
+}
+
+void PackStaticMeshVerteces( EStaticMeshVertexFormat InVertexFormat, const SStaticMeshVertexType* InVerteces, uint32 InNumVerteces, byte* OutData, SStaticMeshVertexPrecision* OutPrecision /* = nullptr */ )
+{
+	check( InVerteces && OutData );
+	if ( OutPrecision )
+	{
+		appMemzero( OutPrecision, sizeof( SStaticMeshVertexPrecision ) );
+	}
+
+	// Full precision format doesn't need any conversion
+	if ( InVertexFormat == SMVF_Float )
+	{
+		memcpy( OutData, InVerteces, sizeof( SStaticMeshVertexType ) * InNumVerteces );
+		return;
+	}
+
+	check( InVertexFormat == SMVF_Packed || InVertexFormat == SMVF_PackedHalf );
+	for ( uint32 index = 0; index < InNumVerteces; ++index )
+	{
+		const SStaticMeshVertexType&	vertex		= InVerteces[ index ];
+		Vector							normal		= Vector( vertex.normal );
+		Vector							tangent		= Vector( vertex.tangent );
+
+		// Sign of binormal is needed for restore it in shader as cross( normal, tangent ) * sign
+		uint32		binormalSign	= SMath::DotVector( SMath::CrossVector( normal, tangent ), Vector( vertex.binormal ) ) >= 0.f ? 3 : 0;
+		uint32		packedNormal	= PackUDec4N( normal, 0 );
+		uint32		packedTangent	= PackUDec4N( tangent, binormalSign );
+		uint16		packedTexCoord[ 2 ] = { SMath::FloatToHalf( vertex.texCoord.x ), SMath::FloatToHalf( vertex.texCoord.y ) };
+		Vector		unpackedPosition;
+
+		if ( InVertexFormat == SMVF_Packed )
+		{
+			SStaticMeshPackedVertexType*	packedVertex = ( SStaticMeshPackedVertexType* )OutData + index;
+			packedVertex->position		= Vector( vertex.position );
+			packedVertex->normal		= packedNormal;
+			packedVertex->tangent		= packedTangent;
+			memcpy( packedVertex->texCoord, packedTexCoord, sizeof( packedTexCoord ) );
+			unpackedPosition			= packedVertex->position;
+		}
+		else
+		{
+			SStaticMeshPackedHalfVertexType*	packedVertex = ( SStaticMeshPackedHalfVertexType* )OutData + index;
+			packedVertex->position[ 0 ]		= SMath::FloatToHalf( vertex.position.x );
+			packedVertex->position[ 1 ]		= SMath::FloatToHalf( vertex.position.y );
+			packedVertex->position[ 2 ]		= SMath::FloatToHalf( vertex.position.z );
+			packedVertex->position[ 3 ]		= SMath::FloatToHalf( 1.f );
+			packedVertex->normal			= packedNormal;
+			packedVertex->tangent			= packedTangent;
+			memcpy( packedVertex->texCoord, packedTexCoord, sizeof( packedTexCoord ) );
+			unpackedPosition				= Vector( SMath::HalfToFloat( packedVertex->position[ 0 ] ), SMath::HalfToFloat( packedVertex->position[ 1 ] ), SMath::HalfToFloat( packedVertex->position[ 2 ] ) );
+		}
+
+		// Decode packed vertex back for calculate precision loss
+		if ( OutPrecision )
+		{
+			Vector2D	unpackedTexCoord( SMath::HalfToFloat( packedTexCoord[ 0 ] ), SMath::HalfToFloat( packedTexCoord[ 1 ] ) );
+			OutPrecision->maxPositionError	= Max( OutPrecision->maxPositionError, SMath::DistanceVector( unpackedPosition, Vector( vertex.position ) ) );
+			OutPrecision->maxNormalError	= Max( OutPrecision->maxNormalError, CalcAngleError( UnpackUDec4N( packedNormal ), normal ) );
+			OutPrecision->maxTangentError	= Max( OutPrecision->maxTangentError, CalcAngleError( UnpackUDec4N( packedTangent ), tangent ) );
+			OutPrecision->maxTexCoordError	= Max( OutPrecision->maxTexCoordError, Max( SMath::Abs( unpackedTexCoord.x - vertex.texCoord.x ), SMath::Abs( unpackedTexCoord.y - vertex.texCoord.y ) ) );
+		}
+	}
+}
+
 void CStaticMeshVertexDeclaration::InitRHI()
 {
-	VertexDeclarationElementList_t		vertexDeclElementList =
+	// Full precision verteces
 	{
-		SVertexElement( CStaticMeshVertexFactory::SSS_Main, sizeof( SStaticMeshVertexType ), STRUCT_OFFSET( SStaticMeshVertexType, position ),    VET_Float4, VEU_Position, 0 ),
-		SVertexElement( CStaticMeshVertexFactory::SSS_Main, sizeof( SStaticMeshVertexType ), STRUCT_OFFSET( SStaticMeshVertexType, texCoord ),    VET_Float2, VEU_TextureCoordinate, 0 ),
-		SVertexElement( CStaticMeshVertexFactory::SSS_Main, sizeof( SStaticMeshVertexType ), STRUCT_OFFSET( SStaticMeshVertexType, normal ),      VET_Float4, VEU_Normal, 0 ),
-		SVertexElement( CStaticMeshVertexFactory::SSS_Main, sizeof( SStaticMeshVertexType ), STRUCT_OFFSET( SStaticMeshVertexType, tangent ),     VET_Float4, VEU_Tangent, 0 ),
-		SVertexElement( CStaticMeshVertexFactory::SSS_Main, sizeof( SStaticMeshVertexType ), STRUCT_OFFSET( SStaticMeshVertexType, binormal ),    VET_Float4, VEU_Binormal, 0 )
-	};
-	vertexDeclarationRHI = GRHI->CreateVertexDeclaration( vertexDeclElementList );
+		VertexDeclarationElementList_t		vertexDeclElementList =
+		{
+			SVertexElement( CStaticMeshVertexFactory::SSS_Main, sizeof( SStaticMeshVertexType ), STRUCT_OFFSET( SStaticMeshVertexType, position ),    VET_Float4, VEU_Position, 0 ),
+			SVertexElement( CStaticMeshVertexFactory::SSS_Main, sizeof( SStaticMeshVertexType ), STRUCT_OFFSET( SStaticMeshVertexType, texCoord ),    VET_Float2, VEU_TextureCoordinate, 0 ),
+			SVertexElement( CStaticMeshVertexFactory::SSS_Main, sizeof( SStaticMeshVertexType ), STRUCT_OFFSET( SStaticMeshVertexType, normal ),      VET_Float4, VEU_Normal, 0 ),
+			SVertexElement( CStaticMeshVertexFactory::SSS_Main, sizeof( SStaticMeshVertexType ), STRUCT_OFFSET( SStaticMeshVertexType, tangent ),     VET_Float4, VEU_Tangent, 0 ),
+			SVertexElement( CStaticMeshVertexFactory::SSS_Main, sizeof( SStaticMeshVertexType ), STRUCT_OFFSET( SStaticMeshVertexType, binormal ),    VET_Float4, VEU_Binormal, 0 )
+		};
+		vertexDeclarationRHI[ SMVF_Float ] = GRHI->CreateVertexDeclaration( vertexDeclElementList );
+	}
+
+	// Packed verteces with float position
+	{
+		VertexDeclarationElementList_t		vertexDeclElementList =
+		{
+			SVertexElement( CStaticMeshVertexFactory::SSS_Main, sizeof( SStaticMeshPackedVertexType ), STRUCT_OFFSET( SStaticMeshPackedVertexType, position ),    VET_Float3, VEU_Position, 0 ),
+			SVertexElement( CStaticMeshVertexFactory::SSS_Main, sizeof( SStaticMeshPackedVertexType ), STRUCT_OFFSET( SStaticMeshPackedVertexType, texCoord ),    VET_Half2, VEU_TextureCoordinate, 0 ),
+			SVertexElement( CStaticMeshVertexFactory::SSS_Main, sizeof( SStaticMeshPackedVertexType ), STRUCT_OFFSET( SStaticMeshPackedVertexType, normal ),      VET_UDec4N, VEU_Normal, 0 ),
+			SVertexElement( CStaticMeshVertexFactory::SSS_Main, sizeof( SStaticMeshPackedVertexType ), STRUCT_OFFSET( SStaticMeshPackedVertexType, tangent ),     VET_UDec4N, VEU_Tangent, 0 )
+		};
+		vertexDeclarationRHI[ SMVF_Packed ] = GRHI->CreateVertexDeclaration( vertexDeclElementList );
+	}
+
+	// Packed verteces with half position
+	{
+		VertexDeclarationElementList_t		vertexDeclElementList =
+		{
+			SVertexElement( CStaticMeshVertexFactory::SSS_Main, sizeof( SStaticMeshPackedHalfVertexType ), STRUCT_OFFSET( SStaticMeshPackedHalfVertexType, position ),    VET_Half4, VEU_Position, 0 ),
+			SVertexElement( CStaticMeshVertexFactory::SSS_Main, sizeof( SStaticMeshPackedHalfVertexType ), STRUCT_OFFSET( SStaticMeshPackedHalfVertexType, texCoord ),    VET_Half2, VEU_TextureCoordinate, 0 ),
+			SVertexElement( CStaticMeshVertexFactory::SSS_Main, sizeof( SStaticMeshPackedHalfVertexType ), STRUCT_OFFSET( SStaticMeshPackedHalfVertexType, normal ),      VET_UDec4N, VEU_Normal, 0 ),
+			SVertexElement( CStaticMeshVertexFactory::SSS_Main, sizeof( SStaticMeshPackedHalfVertexType ), STRUCT_OFFSET( SStaticMeshPackedHalfVertexType, tangent ),     VET_UDec4N, VEU_Tangent, 0 )
+		};
+		vertexDeclarationRHI[ SMVF_PackedHalf ] = GRHI->CreateVertexDeclaration( vertexDeclElementList );
+	}
+
+	// Positions only, they are read from main stream. Position is the first member of each vertex type
+	{
+		const EVertexElementType	positionTypes[ SMVF_Max ] = { VET_Float4, VET_Float3, VET_Half4 };
+		for ( uint32 index = 0; index < SMVF_Max; ++index )
+		{
+			VertexDeclarationElementList_t		vertexDeclElementList =
+			{
+				SVertexElement( CStaticMeshVertexFactory::SSS_Main, GetStaticMeshVertexStride( ( EStaticMeshVertexFormat )index ), 0, positionTypes[ index ], VEU_Position, 0 )
+			};
+			positionOnlyVertexDeclarationRHI[ index ] = GRHI->CreateVertexDeclaration( vertexDeclElementList );
+		}
+	}
 }
 
 void CStaticMeshVertexDeclaration::ReleaseRHI()
 {
-    vertexDeclarationRHI.SafeRelease();
+	for ( uint32 index = 0; index < SMVF_Max; ++index )
+	{
+		vertexDeclarationRHI[ index ].SafeRelease();
+		positionOnlyVertexDeclarationRHI[ index ].SafeRelease();
+	}
 }
 
 void CStaticMeshVertexFactory::InitRHI()
 {
-	InitDeclaration( GStaticMeshVertexDeclaration.GetVertexDeclarationRHI() );
+	InitDeclaration( GStaticMeshVertexDeclaration.GetVertexDeclarationRHI( vertexFormat ) );
+	InitPositionOnlyDeclaration( GStaticMeshVertexDeclaration.GetPositionOnlyVertexDeclarationRHI( vertexFormat ) );
 }
 
 uint64 CStaticMeshVertexFactory::GetTypeHash() const
@@ -41,3 +220,13 @@ CVertexFactoryShaderParameters* CStaticMeshVertexFactory::ConstructShaderParamet
 {
     return InShaderFrequency == SF_Vertex ? new CGeneralVertexShaderParameters( staticType.SupportsInstancing() ) : nullptr;
 }
+
+uint64 CStaticMeshPackedVertexFactory::GetTypeHash() const
+{
+	return staticType.GetHash();
+}
+
+CVertexFactoryShaderParameters* CStaticMeshPackedVertexFactory::ConstructShaderParameters( EShaderFrequency InShaderFrequency )
+{
+	return InShaderFrequency == SF_Vertex ? new CGeneralVertexShaderParameters( staticType.SupportsInstancing() ) : nullptr;
+}
@@ -6,6 +6,8 @@
 #include "Render/Shaders/ShaderManager.h"
 #include "Render/VertexFactory/VertexFactory.h"
 
+CVertexDeclarationRegistry		GVertexDeclarationRegistry;
+
 CVertexFactoryMetaType::CVertexFactoryMetaType( const std::wstring& InFactoryName, const std::wstring& InFileName, bool InSupportsInstancing, uint32 InInstanceStreamIndex, ConstructParametersType InConstructParameters
 #if WITH_EDITOR
 												, ShouldCacheFn_t InShouldCacheFunc, ModifyCompilationEnvironmentFn_t InModifyCompilationEnvironmentFunc
@@ -36,7 +38,17 @@ CVertexFactory::~CVertexFactory()
 
 void CVertexFactory::ReleaseRHI()
 {
+	if ( declaration )
+	{
+		GVertexDeclarationRegistry.Remove( GetTypeHash(), false, declaration );
+	}
+	if ( positionOnlyDeclaration )
+	{
+		GVertexDeclarationRegistry.Remove( GetTypeHash(), true, positionOnlyDeclaration );
+	}
+
 	declaration.SafeRelease();
+	positionOnlyDeclaration.SafeRelease();
 	streams.clear();
 }
 
@@ -62,12 +74,85 @@ void CVertexFactory::SetShaderParameters( class CBaseDeviceContextRHI* InDeviceC
 void CVertexFactory::InitDeclaration( const VertexDeclarationElementList_t& InElements )
 {
 	declaration = GRHI->CreateVertexDeclaration( InElements );
+	GVertexDeclarationRegistry.Add( GetTypeHash(), false, declaration );
 }
 
 void CVertexFactory::InitDeclaration( const VertexDeclarationRHIParamRef_t InDeclaration )
 {
 	check( InDeclaration );
 	declaration = InDeclaration;
+	GVertexDeclarationRegistry.Add( GetTypeHash(), false, declaration );
+}
+
+void CVertexFactory::InitPositionOnlyDeclaration( const VertexDeclarationRHIParamRef_t InDeclaration )
+{
+	check( InDeclaration );
+	positionOnlyDeclaration = InDeclaration;
+	GVertexDeclarationRegistry.Add( GetTypeHash(), true, positionOnlyDeclaration );
+}
+
+void CVertexDeclarationRegistry::Add( uint64 InVertexFactoryHash, bool InIsPositionOnly, VertexDeclarationRHIParamRef_t InDeclaration )
+{
+	CScopeLock										scopeLock( criticalSection );
+	std::vector< SRegisteredDeclaration >&			typeDeclarations = declarations[ InIsPositionOnly ? 1 : 0 ][ InVertexFactoryHash ];
+	for ( uint32 index = 0, count = ( uint32 )typeDeclarations.size(); index < count; ++index )
+	{
+		if ( typeDeclarations[ index ].declaration == InDeclaration )
+		{
+			++typeDeclarations[ index ].numUsers;
+			return;
+		}
+	}
+	typeDeclarations.push_back( SRegisteredDeclaration{ InDeclaration, 1 } );
+}
+
+void CVertexDeclarationRegistry::Remove( uint64 InVertexFactoryHash, bool InIsPositionOnly, VertexDeclarationRHIParamRef_t InDeclaration )
+{
+	CScopeLock		scopeLock( criticalSection );
+	auto			itDeclarations = declarations[ InIsPositionOnly ? 1 : 0 ].find( InVertexFactoryHash );
+	if ( itDeclarations == declarations[ InIsPositionOnly ? 1 : 0 ].end() )
+	{
+		return;
+	}
+
+	std::vector< SRegisteredDeclaration >&		typeDeclarations = itDeclarations->second;
+	for ( uint32 index = 0, count = ( uint32 )typeDeclarations.size(); index < count; ++index )
+	{
+		if ( typeDeclarations[ index ].declaration == InDeclaration )
+		{
+			if ( --typeDeclarations[ index ].numUsers == 0 )
+			{
+				typeDeclarations.erase( typeDeclarations.begin() + index );
+			}
+			break;
+		}
+	}
+
+	if ( typeDeclarations.empty() )
+	{
+		declarations[ InIsPositionOnly ? 1 : 0 ].erase( itDeclarations );
+	}
+}
+
+void CVertexDeclarationRegistry::Get( uint64 InVertexFactoryHash, bool InIsPositionOnly, std::vector< VertexDeclarationRHIRef_t >& OutDeclarations ) const
+{
+	CScopeLock		scopeLock( criticalSection );
+	auto			itDeclarations = declarations[ InIsPositionOnly ? 1 : 0 ].find( InVertexFactoryHash );
+	if ( itDeclarations != declarations[ InIsPositionOnly ? 1 : 0 ].end() )
+	{
+		const std::vector< SRegisteredDeclaration >&	typeDeclarations = itDeclarations->second;
+		for ( uint32 index = 0, count = ( uint32 )typeDeclarations.size(); index < count; ++index )
+		{
+			OutDeclarations.push_back( typeDeclarations[ index ].declaration );
+		}
+	}
+}
+
+void CVertexDeclarationRegistry::RemoveAll()
+{
+	CScopeLock		scopeLock( criticalSection );
+	declarations[ 0 ].clear();
+	declarations[ 1 ].clear();
 }
 
 void CVertexFactory::Init()
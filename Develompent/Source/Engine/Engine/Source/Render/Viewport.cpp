@@ -7,6 +7,12 @@
 #include "Render/SceneRenderTargets.h"
 #include "Render/Scene.h"
 
+uint32 CViewportClient::AllocateViewKey()
+{
+	static uint32		nextViewKey = 0;
+	return ++nextViewKey;
+}
+
 CViewport::CViewport() 
 	: windowHandle( nullptr )
 	, viewportClient( nullptr )
@@ -0,0 +1,46 @@
+#include <emmintrin.h>
+
+#include "Misc/Misc.h"
+#include "Render/YUVConversion.h"
+
+void ConvertYUV420ToYUVA( const SYUV420Planes& InPlanes, uint32 InSizeX, uint32 InSizeY, byte* OutData, uint32 InPitch )
+{
+	check( InPlanes.y && InPlanes.u && InPlanes.v && OutData );
+	const __m128i		alpha = _mm_set1_epi8( ( char )0xFF );
+	for ( uint32 y = 0; y < InSizeY; ++y )
+	{
+		const byte*		srcY	= InPlanes.y + y * InPlanes.yStride;
+		const byte*		srcU	= InPlanes.u + ( y >> 1 ) * InPlanes.uvStride;
+		const byte*		srcV	= InPlanes.v + ( y >> 1 ) * InPlanes.uvStride;
+		byte*			dst		= OutData + y * InPitch;
+		uint32			x		= 0;
+
+		// Sixteen pixels at once, each chroma sample is duplicated and interleaved with luma and alpha
+		for ( ; x + 16 <= InSizeX; x += 16 )
+		{
+			const __m128i		lumas		= _mm_loadu_si128( ( const __m128i* )( srcY + x ) );
+			const __m128i		chromasU	= _mm_loadl_epi64( ( const __m128i* )( srcU + ( x >> 1 ) ) );
+			const __m128i		chromasV	= _mm_loadl_epi64( ( const __m128i* )( srcV + ( x >> 1 ) ) );
+			const __m128i		u			= _mm_unpacklo_epi8( chromasU, chromasU );
+			const __m128i		v			= _mm_unpacklo_epi8( chromasV, chromasV );
+			const __m128i		yuLow		= _mm_unpacklo_epi8( lumas, u );
+			const __m128i		yuHigh		= _mm_unpackhi_epi8( lumas, u );
+			const __m128i		vaLow		= _mm_unpacklo_epi8( v, alpha );
+			const __m128i		vaHigh		= _mm_unpackhi_epi8( v, alpha );
+
+			_mm_storeu_si128( ( __m128i* )( dst + x * 4 + 0 ), _mm_unpacklo_epi16( yuLow, vaLow ) );
+			_mm_storeu_si128( ( __m128i* )( dst + x * 4 + 16 ), _mm_unpackhi_epi16( yuLow, vaLow ) );
+			_mm_storeu_si128( ( __m128i* )( dst + x * 4 + 32 ), _mm_unpacklo_epi16( yuHigh, vaHigh ) );
+			_mm_storeu_si128( ( __m128i* )( dst + x * 4 + 48 ), _mm_unpackhi_epi16( yuHigh, vaHigh ) );
+		}
+
+		// Rest of pixels in row
+		for ( ; x < InSizeX; ++x )
+		{
+			dst[ x * 4 + 0 ] = srcY[ x ];
+			dst[ x * 4 + 1 ] = srcU[ x >> 1 ];
+			dst[ x * 4 + 2 ] = srcV[ x >> 1 ];
+			dst[ x * 4 + 3 ] = 255;
+		}
+	}
+}
\ No newline at end of file
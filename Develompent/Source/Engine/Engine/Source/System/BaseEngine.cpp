@@ -16,6 +16,7 @@
 #include "Render/Shaders/BasePassShader.h"
 #include "Render/Shaders/WireframeShader.h"
 #include "Render/RenderingThread.h"
+#include "Render/BoundShaderStateWarmup.h"
 #include "System/CameraManager.h"
 
 IMPLEMENT_CLASS( CBaseEngine )
@@ -198,5 +199,8 @@ bool CBaseEngine::LoadMap( const std::wstring& InMap, std::wstring& OutError )
 	
 	// Call garbage collector of unused packages and assets
 	GPackageManager->GarbageCollector();
+
+	// Create bound shader states used by map, so drawing policies don't create them on first draw
+	GBoundShaderStateWarmup.Start( InMap );
 	return true;
 }
@@ -1,10 +1,36 @@
+#include <time.h>
+
 #include "Logger/LoggerMacros.h"
+#include "Misc/CoreGlobals.h"
+#include "Misc/EngineGlobals.h"
+#include "Misc/Misc.h"
+#include "Containers/String.h"
+#include "Containers/StringConv.h"
+#include "System/Archive.h"
+#include "System/BaseFileSystem.h"
+#include "System/Package.h"
 #include "System/ConsoleSystem.h"
+#include "Render/DrawingPolicy.h"
+#include "Render/RenderingThread.h"
+#include "Render/TextureStreaming.h"
+#include "Render/OcclusionCulling.h"
+#include "Render/BoundShaderStateCache.h"
+#include "RHI/BaseRHI.h"
+#include "RHI/BaseDeviceContextRHI.h"
+#include "NullRHI.h"
 
 //
 // GLOBALS
 //
 CConCmd			CCmdHelp( TEXT( "help" ), TEXT( "Show help variables and comands" ), std::bind( &CConsoleSystem::CmdHelp, std::placeholders::_1 ) );
+CConCmd			CCmdNullRHIStats( TEXT( "nullrhistats" ), TEXT( "Show statistics of calls to null RHI (engine must be started with -nullrhi)" ), std::bind( &CConsoleSystem::CmdNullRHIStats, std::placeholders::_1 ) );
+CConCmd			CCmdMemReport( TEXT( "memreport" ), TEXT( "Show memory statistics by tags. Use '-csv' for dump it to file" ), std::bind( &CConsoleSystem::CmdMemReport, std::placeholders::_1 ) );
+CConCmd			CCmdDrawListStats( TEXT( "drawliststats" ), TEXT( "Show statistics of state changes in draw lists for the last rendered view" ), std::bind( &CConsoleSystem::CmdDrawListStats, std::placeholders::_1 ) );
+CConCmd			CCmdStateCacheStats( TEXT( "statecachestats" ), TEXT( "Show statistics of calls issued to RHI and filtered by state cache for the last rendered view" ), std::bind( &CConsoleSystem::CmdStateCacheStats, std::placeholders::_1 ) );
+CConCmd			CCmdRenderCmdStats( TEXT( "rendercmdstats" ), TEXT( "Show statistics of rendering command buffer" ), std::bind( &CConsoleSystem::CmdRenderCmdStats, std::placeholders::_1 ) );
+CConCmd			CCmdTextureStreamingStats( TEXT( "texturestreamingstats" ), TEXT( "Show statistics of texture streaming" ), std::bind( &CConsoleSystem::CmdTextureStreamingStats, std::placeholders::_1 ) );
+CConCmd			CCmdOcclusionStats( TEXT( "occlusionstats" ), TEXT( "Show statistics of software occlusion culling for the last built view" ), std::bind( &CConsoleSystem::CmdOcclusionStats, std::placeholders::_1 ) );
+CConCmd			CCmdBSSStats( TEXT( "bssstats" ), TEXT( "Show statistics of bound shader states warmed up at map load and created on first use since it" ), std::bind( &CConsoleSystem::CmdBSSStats, std::placeholders::_1 ) );
 
 bool CConsoleSystem::Exec( const std::wstring& InCommand )
 {
@@ -165,4 +191,201 @@ void CConsoleSystem::CmdHelp( const std::vector<std::wstring>& InArguments )
 			LE_LOG( LT_Log, LC_Console, TEXT( "%s : %s" ), cmd->GetName().c_str(), cmd->GetHelpText().c_str() );
 		}
 	}
+}
+
+void CConsoleSystem::CmdMemReport( const std::vector<std::wstring>& InArguments )
+{
+	bool		bDumpToCSV = false;
+	for ( uint32 index = 0, count = InArguments.size(); index < count; ++index )
+	{
+		if ( InArguments[index] == TEXT( "-csv" ) )
+		{
+			bDumpToCSV = true;
+		}
+	}
+
+#if !TRACK_MEMORY
+	LE_LOG( LT_Warning, LC_Console, TEXT( "Memory tracking is disabled in this build, rebuild with TRACK_MEMORY=1" ) );
+#endif // !TRACK_MEMORY
+
+	// Print memory statistics by tags
+	SMemoryTagStats		totalStats;
+	appMemzero( &totalStats, sizeof( SMemoryTagStats ) );
+
+	LE_LOG( LT_Log, LC_Console, TEXT( "" ) );
+	LE_LOG( LT_Log, LC_Console, TEXT( "** Memory report **" ) );
+	LE_LOG( LT_Log, LC_Console, TEXT( "%-16s %12s %12s %12s %14s" ), TEXT( "Tag" ), TEXT( "Current KB" ), TEXT( "Peak KB" ), TEXT( "Live allocs" ), TEXT( "Total allocs" ) );
+	for ( uint32 tag = 0; tag < MT_Count; ++tag )
+	{
+		SMemoryTagStats		stats = appGetMemoryTagStats( ( EMemoryTag )tag );
+		LE_LOG( LT_Log, LC_Console, TEXT( "%-16s %12.2f %12.2f %12lld %14lld" ), appGetMemoryTagName( ( EMemoryTag )tag ), stats.currentBytes / 1024.f, stats.peakBytes / 1024.f, stats.numAllocations, stats.totalAllocations );
+
+		totalStats.currentBytes		+= stats.currentBytes;
+		totalStats.peakBytes		+= stats.peakBytes;
+		totalStats.numAllocations	+= stats.numAllocations;
+		totalStats.totalAllocations	+= stats.totalAllocations;
+	}
+	LE_LOG( LT_Log, LC_Console, TEXT( "%-16s %12.2f %12.2f %12lld %14lld" ), TEXT( "Total" ), totalStats.currentBytes / 1024.f, totalStats.peakBytes / 1024.f, totalStats.numAllocations, totalStats.totalAllocations );
+	LE_LOG( LT_Log, LC_Console, TEXT( "Allocations in last frame: %llu" ), appGetMemoryFrameAllocations() );
+
+	// Print number of live assets
+	LE_LOG( LT_Log, LC_Console, TEXT( "" ) );
+	LE_LOG( LT_Log, LC_Console, TEXT( "** Live assets **" ) );
+	for ( uint32 type = AT_FirstType; type < AT_Count; ++type )
+	{
+		LE_LOG( LT_Log, LC_Console, TEXT( "%-16s %u" ), ConvertAssetTypeToText( ( EAssetType )type ).c_str(), CAsset::GetNumAssets( ( EAssetType )type ) );
+	}
+
+	// Dump memory statistics to CSV file
+	if ( bDumpToCSV )
+	{
+		time_t			timeNow = time( nullptr );
+		tm*				tmTimeNow = localtime( &timeNow );
+		std::wstring	csvFile = CString::Format( TEXT( "%s/Logs/MemReport-%i.%02i.%02i-%02i.%02i.%02i.csv" ), appGameDir().c_str(), 1900 + tmTimeNow->tm_year, 1 + tmTimeNow->tm_mon, tmTimeNow->tm_mday, tmTimeNow->tm_hour, tmTimeNow->tm_min, tmTimeNow->tm_sec );
+		CArchive*		archive = GFileSystem->CreateFileWriter( csvFile );
+		if ( !archive )
+		{
+			LE_LOG( LT_Error, LC_Console, TEXT( "Failed to create file '%s'" ), csvFile.c_str() );
+			return;
+		}
+
+		archive->SetType( AT_TextFile );
+		*archive << "Tag,CurrentBytes,PeakBytes,LiveAllocations,TotalAllocations,LiveAssets\n";
+		for ( uint32 tag = 0; tag < MT_Count; ++tag )
+		{
+			SMemoryTagStats		stats = appGetMemoryTagStats( ( EMemoryTag )tag );
+			uint32				numAssets = 0;
+			for ( uint32 type = AT_FirstType; type < AT_Count; ++type )
+			{
+				if ( appGetAssetMemoryTag( ( EAssetType )type ) == tag )
+				{
+					numAssets += CAsset::GetNumAssets( ( EAssetType )type );
+				}
+			}
+
+			*archive << TCHAR_TO_ANSI( CString::Format( TEXT( "%s,%lld,%lld,%lld,%lld,%u\n" ), appGetMemoryTagName( ( EMemoryTag )tag ), stats.currentBytes, stats.peakBytes, stats.numAllocations, stats.totalAllocations, numAssets ).c_str() );
+		}
+
+		delete archive;
+		LE_LOG( LT_Log, LC_Console, TEXT( "Memory report saved to '%s'" ), csvFile.c_str() );
+	}
+}
+
+void CConsoleSystem::CmdDrawListStats( const std::vector<std::wstring>& InArguments )
+{
+#if !SHIPPING_BUILD
+	// Statistics are updated by rendering thread, so copy them before print
+	SDrawListStats		stats = GDrawListStats;
+	LE_LOG( LT_Log, LC_Console, TEXT( "Drawing policies:            %i" ), stats.numDrawingPolicies );
+	LE_LOG( LT_Log, LC_Console, TEXT( "Sorts of draw lists:         %i" ), stats.numSorts );
+	LE_LOG( LT_Log, LC_Console, TEXT( "Bound shader state changes:  %i" ), stats.numBoundShaderStateChanges );
+	LE_LOG( LT_Log, LC_Console, TEXT( "Shader parameters changes:   %i" ), stats.numShaderParametersChanges );
+	LE_LOG( LT_Log, LC_Console, TEXT( "Vertex factory changes:      %i" ), stats.numVertexFactoryChanges );
+	LE_LOG( LT_Log, LC_Console, TEXT( "Rasterizer state changes:    %i" ), stats.numRasterizerStateChanges );
+	LE_LOG( LT_Log, LC_Console, TEXT( "Sorted instances:            %i" ), stats.numSortedInstances );
+	LE_LOG( LT_Log, LC_Console, TEXT( "Depth pre-pass policies:     %i" ), stats.numDepthPrepassDrawingPolicies );
+#else
+	LE_LOG( LT_Warning, LC_Console, TEXT( "Statistics of draw lists isn't available in shipping build" ) );
+#endif // !SHIPPING_BUILD
+}
+
+void CConsoleSystem::CmdNullRHIStats( const std::vector<std::wstring>& InArguments )
+{
+	if ( !GRHI || !GRHI->IsNullRHI() )
+	{
+		LE_LOG( LT_Warning, LC_Console, TEXT( "Null RHI isn't used, start engine with -nullrhi" ) );
+		return;
+	}
+
+	GNullRHIStats.Dump();
+}
+
+void CConsoleSystem::CmdStateCacheStats( const std::vector<std::wstring>& InArguments )
+{
+#if !SHIPPING_BUILD
+	CBaseDeviceContextRHI*		immediateContext = GRHI ? GRHI->GetImmediateContext() : nullptr;
+	if ( !immediateContext )
+	{
+		LE_LOG( LT_Warning, LC_Console, TEXT( "RHI isn't initialized" ) );
+		return;
+	}
+
+	// Statistics are updated by rendering thread, so copy them before print
+	SStateCacheStatsRHI		stats = immediateContext->GetStateCacheStats();
+	uint32					numIssued = 0;
+	uint32					numFiltered = 0;
+	LE_LOG( LT_Log, LC_Console, TEXT( "%-24s %10s %10s" ), TEXT( "State" ), TEXT( "Issued" ), TEXT( "Filtered" ) );
+	for ( uint32 index = 0; index < SCT_Num; ++index )
+	{
+		LE_LOG( LT_Log, LC_Console, TEXT( "%-24s %10i %10i" ), StateCacheTypeToText( ( EStateCacheTypeRHI )index ), stats.numIssued[ index ], stats.numFiltered[ index ] );
+		numIssued	+= stats.numIssued[ index ];
+		numFiltered	+= stats.numFiltered[ index ];
+	}
+	LE_LOG( LT_Log, LC_Console, TEXT( "%-24s %10i %10i" ), TEXT( "Total" ), numIssued, numFiltered );
+	LE_LOG( LT_Log, LC_Console, TEXT( "Filtered constant bytes: %llu" ), stats.numFilteredConstantBytes );
+#else
+	LE_LOG( LT_Warning, LC_Console, TEXT( "Statistics of state cache isn't available in shipping build" ) );
+#endif // !SHIPPING_BUILD
+}
+
+void CConsoleSystem::CmdRenderCmdStats( const std::vector<std::wstring>& InArguments )
+{
+	SCommandBufferStats		stats = GRenderCommandBuffer.GetStats();
+	LE_LOG( LT_Log, LC_Console, TEXT( "Bytes in last frame:         %llu" ), stats.lastFrameBytes );
+	LE_LOG( LT_Log, LC_Console, TEXT( "Peak bytes per frame:        %llu" ), stats.peakFrameBytes );
+	LE_LOG( LT_Log, LC_Console, TEXT( "Total bytes:                 %llu" ), stats.totalBytes );
+	LE_LOG( LT_Log, LC_Console, TEXT( "Peak occupancy:              %llu" ), stats.peakOccupancy );
+	LE_LOG( LT_Log, LC_Console, TEXT( "Allocated:                   %llu bytes in %i chunks" ), stats.allocatedBytes, stats.numChunks );
+	LE_LOG( LT_Log, LC_Console, TEXT( "Stall in last frame:         %.3f ms" ), stats.lastFrameStallSeconds * 1000.0 );
+	LE_LOG( LT_Log, LC_Console, TEXT( "Total stall:                 %.3f ms (%i stalls)" ), stats.totalStallSeconds * 1000.0, stats.numStalls );
+}
+
+void CConsoleSystem::CmdTextureStreamingStats( const std::vector<std::wstring>& InArguments )
+{
+#if !SHIPPING_BUILD
+	if ( !GTextureStreamingManager->IsEnabled() )
+	{
+		LE_LOG( LT_Warning, LC_Console, TEXT( "Texture streaming is disabled" ) );
+		return;
+	}
+
+	// Statistics are updated by rendering thread, so copy them before print
+	STextureStreamingStats		stats = GTextureStreamingManager->GetStats();
+	LE_LOG( LT_Log, LC_Console, TEXT( "Streaming textures:          %i" ), stats.numTextures );
+	LE_LOG( LT_Log, LC_Console, TEXT( "Resident mips:               %i (%.2f MB)" ), stats.numResidentMips, stats.residentSize / ( 1024.f * 1024.f ) );
+	LE_LOG( LT_Log, LC_Console, TEXT( "Requested mips:              %i (%.2f MB)" ), stats.numRequestedMips, stats.requestedSize / ( 1024.f * 1024.f ) );
+	LE_LOG( LT_Log, LC_Console, TEXT( "Budget:                      %.2f MB" ), stats.budgetSize / ( 1024.f * 1024.f ) );
+	LE_LOG( LT_Log, LC_Console, TEXT( "Budget pressure:             %.1f%% (mip bias %i)" ), stats.budgetSize > 0 ? stats.requestedSize * 100.f / stats.budgetSize : 0.f, stats.mipBias );
+	LE_LOG( LT_Log, LC_Console, TEXT( "Pending requests:            %i" ), stats.numPendingRequests );
+	LE_LOG( LT_Log, LC_Console, TEXT( "Streamed in/out:             %i/%i" ), stats.numStreamedIn, stats.numStreamedOut );
+	LE_LOG( LT_Log, LC_Console, TEXT( "Total loaded:                %.2f MB" ), stats.totalLoadedSize / ( 1024.f * 1024.f ) );
+#else
+	LE_LOG( LT_Warning, LC_Console, TEXT( "Statistics of texture streaming isn't available in shipping build" ) );
+#endif // !SHIPPING_BUILD
+}
+
+void CConsoleSystem::CmdOcclusionStats( const std::vector<std::wstring>& InArguments )
+{
+#if !SHIPPING_BUILD
+	// Statistics are updated by rendering thread, so copy them before print
+	SOcclusionStats		stats = GOcclusionStats;
+	LE_LOG( LT_Log, LC_Console, TEXT( "Occluders:                   %i (%i triangles)" ), stats.numOccluders, stats.numOccluderTriangles );
+	LE_LOG( LT_Log, LC_Console, TEXT( "Rasterized triangles:        %i" ), stats.numRasterizedTriangles );
+	LE_LOG( LT_Log, LC_Console, TEXT( "Rasterization time:          %.3f ms" ), stats.rasterizeTime * 1000.0 );
+	LE_LOG( LT_Log, LC_Console, TEXT( "Tested primitives:           %i" ), stats.numTested );
+	LE_LOG( LT_Log, LC_Console, TEXT( "Culled primitives:           %i (%.1f%%)" ), stats.numCulled, stats.numTested > 0 ? stats.numCulled * 100.f / stats.numTested : 0.f );
+#else
+	LE_LOG( LT_Warning, LC_Console, TEXT( "Statistics of occlusion culling isn't available in shipping build" ) );
+#endif // !SHIPPING_BUILD
+}
+
+void CConsoleSystem::CmdBSSStats( const std::vector<std::wstring>& InArguments )
+{
+#if !SHIPPING_BUILD
+	LE_LOG( LT_Log, LC_Console, TEXT( "Warmed up at map load:       %i" ), GBoundShaderStateStats.numWarmedUp );
+	LE_LOG( LT_Log, LC_Console, TEXT( "Not resolved items:          %i" ), GBoundShaderStateStats.numNotResolved );
+	LE_LOG( LT_Log, LC_Console, TEXT( "Created on first use:        %i" ), GBoundShaderStateStats.numFirstUseCreations );
+#else
+	LE_LOG( LT_Warning, LC_Console, TEXT( "Statistics of bound shader states isn't available in shipping build" ) );
+#endif // !SHIPPING_BUILD
 }
\ No newline at end of file
@@ -14,12 +14,82 @@
 #include "System/SplashScreen.h"
 #include "System/InputSystem.h"
 #include "Render/RenderingThread.h"
+#include "Render/YUVConversion.h"
 #include "RHI/BaseRHI.h"
+#include "RHI/BaseDeviceContextRHI.h"
 #include "RHI/StaticStatesRHI.h"
 #include "Core.h"
 
 IMPLEMENT_SHADER_TYPE(, CTheoraMoviePixelShader, TEXT( "TheoraPixelShader.hlsl" ), TEXT( "MainPS" ), SF_Pixel, true );
 
+/**
+ * @ingroup Engine
+ * @brief The Theora decoder thread runnable object
+ */
+class CTheoraDecoderThread : public CRunnable
+{
+public:
+	/**
+	 * @brief Constructor
+	 * @param InMoviePlayer		Movie player
+	 */
+	CTheoraDecoderThread( CFullScreenMovieTheora* InMoviePlayer )
+		: bStopping( false )
+		, workEvent( nullptr )
+		, moviePlayer( InMoviePlayer )
+	{}
+
+	/**
+	 * @brief Initialize
+	 * @return True if initialization was successful, false otherwise
+	 */
+	virtual bool Init() override
+	{
+		return true;
+	}
+
+	/**
+	 * @brief Run
+	 * @return The exit code of the runnable object
+	 */
+	virtual uint32 Run() override
+	{
+		while ( !bStopping )
+		{
+			moviePlayer->DecodeFrames();
+			workEvent->Wait();
+		}
+		return 0;
+	}
+
+	/**
+	 * @brief Stop
+	 */
+	virtual void Stop() override
+	{
+		bStopping = true;
+		workEvent->Trigger();
+	}
+
+	/**
+	 * @brief Exit
+	 */
+	virtual void Exit() override
+	{}
+
+	/**
+	 * @brief Wake up the thread for decode frames into free slots
+	 */
+	FORCEINLINE void WakeUp()
+	{
+		workEvent->Trigger();
+	}
+
+	volatile bool					bStopping;			/**< Is thread stopping */
+	CEvent*							workEvent;			/**< Event of freed slot of decoded frames */
+	CFullScreenMovieTheora*			moviePlayer;		/**< Movie player */
+};
+
 CTheoraMovieRenderClient::CTheoraMovieRenderClient( CFullScreenMovieTheora* InMoviePlayer )
 	: moviePlayer( InMoviePlayer )
 	, viewport( nullptr )
@@ -62,7 +132,8 @@ void CTheoraMovieRenderClient::DestroyViewport()
 
 void CTheoraMovieRenderClient::MovieInitRendering( uint32 InWidth, uint32 InHeight )
 {
-	textureFrame = GRHI->CreateTexture2D( TEXT( "TheoraYUVFrame" ), InWidth, InHeight, PF_A8R8G8B8, 1, TCF_None );
+	// Texture is dynamic, each frame is written with discard so driver gives new memory and doesn't wait GPU
+	textureFrame = GRHI->CreateTexture2D( TEXT( "TheoraYUVFrame" ), InWidth, InHeight, PF_A8R8G8B8, 1, TCF_Dynamic );
 }
 
 void CTheoraMovieRenderClient::MovieCleanupRendering()
@@ -70,28 +141,22 @@ void CTheoraMovieRenderClient::MovieCleanupRendering()
 	textureFrame.SafeRelease();
 }
 
-void CTheoraMovieRenderClient::CopyFrameToTexture( yuv_buffer* InYUVBuffer )
+void CTheoraMovieRenderClient::CopyFrameToTexture( const STheoraDecodedFrame& InFrame )
 {
 	check( textureFrame );
+
 	CBaseDeviceContextRHI*		deviceContext = GRHI->GetImmediateContext();
 	SLockedData					lockedData;
 	GRHI->LockTexture2D( deviceContext, textureFrame, 0, true, lockedData );
 
-	// Copy data from YUV444 buffer to texture
-	for ( uint32 y = 0; y < textureFrame->GetSizeY(); ++y )
-	{
-		for ( uint32 x = 0; x < textureFrame->GetSizeX(); ++x )
-		{
-			const uint32	offset	= x + y * textureFrame->GetSizeX();
-			const uint32	xx		= x >> 1;
-			const uint32	yy		= y >> 1;
-
-			lockedData.data[ offset * GPixelFormats[ PF_A8R8G8B8 ].blockBytes + 0 ]		= InYUVBuffer->y[ x + y * InYUVBuffer->y_stride ];
-			lockedData.data[ offset * GPixelFormats[ PF_A8R8G8B8 ].blockBytes + 1 ]		= InYUVBuffer->u[ xx + yy * InYUVBuffer->uv_stride ];
-			lockedData.data[ offset * GPixelFormats[ PF_A8R8G8B8 ].blockBytes + 2 ]		= InYUVBuffer->v[ xx + yy * InYUVBuffer->uv_stride ];
-			lockedData.data[ offset * GPixelFormats[ PF_A8R8G8B8 ].blockBytes + 3 ]		= 255;
-		}
-	}
+	// Convert YUV420 frame to YUV444 texels, conversion to RGB is done in pixel shader
+	SYUV420Planes				planes;
+	planes.y		= InFrame.y.data();
+	planes.u		= InFrame.u.data();
+	planes.v		= InFrame.v.data();
+	planes.yStride	= InFrame.yStride;
+	planes.uvStride	= InFrame.uvStride;
+	ConvertYUV420ToYUVA( planes, textureFrame->GetSizeX(), textureFrame->GetSizeY(), lockedData.data, lockedData.pitch );
 
 	GRHI->UnlockTexture2D( deviceContext, textureFrame, 0, lockedData );
 }
@@ -105,9 +170,9 @@ void CTheoraMovieRenderClient::Draw( CViewport* InViewport )
 	check( screenVertexShader && theoraMoviePixelShader );
 
 	GRHI->SetRenderTarget( immediateContext, viewportRHI->GetSurface(), nullptr );
-	GRHI->SetDepthState( immediateContext, TStaticDepthStateRHI<false>::GetRHI() );
-	GRHI->SetRasterizerState( immediateContext, TStaticRasterizerStateRHI<>::GetRHI() );
-	GRHI->SetBoundShaderState( immediateContext, GRHI->CreateBoundShaderState( TEXT( "TheoraMovieDrawBBS" ), GSimpleElementVertexDeclaration.GetVertexDeclarationRHI(), screenVertexShader->GetVertexShader(), theoraMoviePixelShader->GetPixelShader() ) );
+	immediateContext->SetDepthState( TStaticDepthStateRHI<false>::GetRHI() );
+	immediateContext->SetRasterizerState( TStaticRasterizerStateRHI<>::GetRHI() );
+	immediateContext->SetBoundShaderState( GRHI->CreateBoundShaderState( TEXT( "TheoraMovieDrawBBS" ), GSimpleElementVertexDeclaration.GetVertexDeclarationRHI(), screenVertexShader->GetVertexShader(), theoraMoviePixelShader->GetPixelShader() ) );
 
 	theoraMoviePixelShader->SetTexture( immediateContext, textureFrame );
 	theoraMoviePixelShader->SetSamplerState( immediateContext, TStaticSamplerStateRHI<SF_Bilinear>::GetRHI() );
@@ -171,6 +236,12 @@ CFullScreenMovieTheora::CFullScreenMovieTheora()
 	, beginPlaybackTime( 0.f )
 	, lastFrameTime( 0.f )
 	, startupSequenceStep( -1 )
+	, readFrameIndex( 0 )
+	, writeFrameIndex( 0 )
+	, numDecodedFrames( 0 )
+	, bEndOfStream( 0 )
+	, decoderRunnable( nullptr )
+	, decoderThread( nullptr )
 	, audioStreamSource( nullptr )
 	, arMovie( nullptr )
 	, movieFinishEvent( nullptr )
@@ -293,49 +364,152 @@ bool CFullScreenMovieTheora::ProcessNextStartupSequence()
 
 void CFullScreenMovieTheora::DecodeVideoFrame()
 {
-	// If the interval between the previous frame is less than the frame rate, then we do not decode the new one
+	// If the interval between the previous frame is less than the frame rate, then we do not upload the new one
 	double		currentTime = appSeconds();
 	if ( currentTime - lastFrameTime <= frameRate )
 	{
 		return;
 	}
 
-	// First of all - grab some data into ogg packet
-	while ( ogg_stream_packetout( &videoStream, &oggPacket ) <= 0 )
+	// Take decoded frames, frames which time is passed are dropped
+	while ( numDecodedFrames > 0 )
 	{
-		// If no data in video stream, grab some data
-		if ( !GrabBufferData() )
+		const STheoraDecodedFrame&		frame = decodedFrames[ readFrameIndex ];
+		const bool						bLate = currentTime - beginPlaybackTime > frame.time;
+		if ( !bLate )
+		{
+			// Copy YUV frame to texture
+			theoraRender->CopyFrameToTexture( frame );
+
+			// Remember time of last frame
+			lastFrameTime = currentTime;
+		}
+
+		// Give the slot back to decoder thread
+		readFrameIndex = ( readFrameIndex + 1 ) % THEORA_NUM_DECODED_FRAMES;
+		appInterlockedDecrement( &numDecodedFrames );
+		decoderRunnable->WakeUp();
+
+		if ( !bLate )
 		{
 			break;
 		}
-	
-		// Grab all decoded ogg pages into our video stream
-		while ( ogg_sync_pageout( &oggSyncState, &oggPage ) > 0 )
+	}
+
+	// If all frames are shown, we stop playing movie
+	if ( bEndOfStream && numDecodedFrames == 0 )
+	{
+		bStopped = true;
+	}
+}
+
+bool CFullScreenMovieTheora::DecodeNextFrame()
+{
+	while ( true )
+	{
+		// First of all - grab some data into ogg packet
+		while ( ogg_stream_packetout( &videoStream, &oggPacket ) <= 0 )
 		{
-			ogg_stream_pagein( &videoStream, &oggPage );
+			// If no data in video stream, grab some data. If end of file, there are no more frames
+			if ( !GrabBufferData() )
+			{
+				return false;
+			}
+
+			// Grab all decoded ogg pages into our video stream
+			while ( ogg_sync_pageout( &oggSyncState, &oggPage ) > 0 )
+			{
+				ogg_stream_pagein( &videoStream, &oggPage );
+			}
+		}
+
+		// Load packet into Theora decoder, broken packets are skipped
+		if ( !theora_decode_packetin( &theoraState, &oggPacket ) )
+		{
+			break;
 		}
 	}
 
-	// Load packet into Theora decoder if need
-	if ( !theora_decode_packetin( &theoraState, &oggPacket ) && currentTime - beginPlaybackTime <= theora_granule_time( &theoraState, theoraState.granulepos ) )
+	// If decoded ok - get YUV frame and copy it into free slot
+	theora_decode_YUVout( &theoraState, &yuvFrame );
+
+	STheoraDecodedFrame&		frame		= decodedFrames[ writeFrameIndex ];
+	const uint32				uvHeight	= ( frameHeight + 1 ) / 2;
+	frame.yStride	= frameWidth;
+	frame.uvStride	= ( frameWidth + 1 ) / 2;
+	frame.time		= theora_granule_time( &theoraState, theoraState.granulepos );
+	frame.y.resize( frame.yStride * frameHeight );
+	frame.u.resize( frame.uvStride * uvHeight );
+	frame.v.resize( frame.uvStride * uvHeight );
+
+	// Rows are copied one by one without padding of Theora buffer, its stride may be negative
+	for ( uint32 y = 0; y < frameHeight; ++y )
 	{
-		// If decoded ok - get YUV frame
-		theora_decode_YUVout( &theoraState, &yuvFrame );
-	
-		// Copy YUV frame to texture
-		theoraRender->CopyFrameToTexture( &yuvFrame );
+		memcpy( frame.y.data() + y * frame.yStride, yuvFrame.y + ( int32 )y * yuvFrame.y_stride, frame.yStride );
+	}
 
-		// Remember time of last frame
-		lastFrameTime = currentTime;
+	for ( uint32 y = 0; y < uvHeight; ++y )
+	{
+		memcpy( frame.u.data() + y * frame.uvStride, yuvFrame.u + ( int32 )y * yuvFrame.uv_stride, frame.uvStride );
+		memcpy( frame.v.data() + y * frame.uvStride, yuvFrame.v + ( int32 )y * yuvFrame.uv_stride, frame.uvStride );
 	}
+	return true;
+}
 
-	// If end of file, we stop playing movie
-	if ( arMovie->IsEndOfFile() )
+void CFullScreenMovieTheora::DecodeFrames()
+{
+	while ( !bEndOfStream && numDecodedFrames < THEORA_NUM_DECODED_FRAMES && !decoderRunnable->bStopping )
 	{
-		bStopped = true;
+		if ( !DecodeNextFrame() )
+		{
+			// Set after the last decoded frame is published, so rendering thread sees all frames before end of stream
+			appInterlockedExchange( &bEndOfStream, 1 );
+			break;
+		}
+
+		// Publish the frame to rendering thread
+		writeFrameIndex = ( writeFrameIndex + 1 ) % THEORA_NUM_DECODED_FRAMES;
+		appInterlockedIncrement( &numDecodedFrames );
 	}
 }
 
+void CFullScreenMovieTheora::StartDecoderThread()
+{
+	check( !decoderThread );
+	readFrameIndex		= 0;
+	writeFrameIndex		= 0;
+	numDecodedFrames	= 0;
+	bEndOfStream		= 0;
+
+	decoderRunnable = new CTheoraDecoderThread( this );
+	decoderRunnable->workEvent = GSynchronizeFactory->CreateSynchEvent( false );
+	check( decoderRunnable->workEvent );
+
+	decoderThread = GThreadFactory->CreateThread( decoderRunnable, TEXT( "TheoraDecoderThread" ), 0, 0, 0, TP_AboveNormal );
+	check( decoderThread );
+}
+
+void CFullScreenMovieTheora::StopDecoderThread()
+{
+	if ( !decoderThread )
+	{
+		return;
+	}
+
+	decoderRunnable->Stop();
+	decoderThread->WaitForCompletion();
+	decoderThread->Kill();
+
+	GThreadFactory->Destroy( decoderThread );
+	GSynchronizeFactory->Destroy( decoderRunnable->workEvent );
+	delete decoderRunnable;
+
+	decoderRunnable		= nullptr;
+	decoderThread		= nullptr;
+	numDecodedFrames	= 0;
+	bEndOfStream		= 0;
+}
+
 void CFullScreenMovieTheora::GameThreadPlayMovie( const std::wstring& InMovieFilename, bool InIsSkippable /*= false */, uint32 InStartFrame /*= 0*/ )
 {
 	// Check for movie already playing and exit out if so
@@ -665,6 +839,9 @@ bool CFullScreenMovieTheora::OpenStreamedMovie( const std::wstring& InMovieFilen
 		beginPlaybackTime	= appSeconds();
 		lastFrameTime		= 0;
 		bStopped			= false;
+
+		// Frames are decoded ahead in own thread, rendering thread only uploads them
+		StartDecoderThread();
 		return true;
 	}
 
@@ -682,6 +859,9 @@ void CFullScreenMovieTheora::CloseStreamedMovie()
 		return;
 	}
 
+	// Decoder thread must be stopped before clearing Theora structures
+	StopDecoderThread();
+
 	// Clear audio bank and streamed source
 	delete audioStreamSource;
 	audioBank			= nullptr;
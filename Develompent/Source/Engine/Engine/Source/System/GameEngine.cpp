@@ -8,6 +8,7 @@
 #include "System/World.h"
 #include "System/BaseFileSystem.h"
 #include "Render/RenderingThread.h"
+#include "Render/TextureStreaming.h"
 #include "Misc/EngineGlobals.h"
 #include "Misc/CoreGlobals.h"
 #include "RHI/BaseRHI.h"
@@ -25,6 +26,8 @@ CGameEngine::~CGameEngine()
 
 void CGameEngine::Init()
 {
+	// Texture streaming must be initialized before loading any texture
+	GTextureStreamingManager->Init();
 	Super::Init();
 
 	// Create window and viewport
@@ -43,6 +46,7 @@ void CGameEngine::Tick( float InDeltaSeconds )
 	Super::Tick( InDeltaSeconds );
 	GWorld->Tick( InDeltaSeconds );
 	viewport.Tick( InDeltaSeconds );
+	GTextureStreamingManager->Tick( InDeltaSeconds );
 
 	// Wait while render thread is rendering of the frame
 	FlushRenderingCommands();
@@ -54,6 +58,7 @@ void CGameEngine::Tick( float InDeltaSeconds )
 void CGameEngine::Shutdown()
 {
 	Super::Shutdown();
+	GTextureStreamingManager->Shutdown();
 
 	// Destroy viewport
 	viewport.Update( true, 0, 0, ( void* )nullptr );
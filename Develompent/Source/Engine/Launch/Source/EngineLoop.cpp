@@ -24,7 +24,10 @@
 #include "RHI/BaseViewportRHI.h"
 #include "RHI/BaseDeviceContextRHI.h"
 #include "RHI/BaseSurfaceRHI.h"
+#include "NullRHI.h"
 #include "Render/Shaders/ShaderManager.h"
+#include "Render/BoundShaderStateWarmup.h"
+#include "Render/VertexFactory/VertexFactory.h"
 #include "UIEngine.h"
 #include "Misc/UIGlobals.h"
 #include "EngineLoop.h"
@@ -217,6 +220,13 @@ int32 CEngineLoop::PreInit( const tchar* InCmdLine )
 
 	GWindow->Create( ANSI_TO_TCHAR( ENGINE_NAME " " ENGINE_VERSION_STRING ), 1, 1, SW_Default );
 	GScriptEngine->Init();
+
+	// Null RHI is used for run renderer without GPU, e.g. for benchmarks on build machines
+	if ( GCommandLine.HasParam( TEXT( "nullrhi" ) ) )
+	{
+		delete GRHI;
+		GRHI = new CNullRHI();
+	}
 	GRHI->Init( GIsEditor );
 
 	LE_LOG( LT_Log, LC_Init, TEXT( "User: %s//%s" ), appComputerName().c_str(), appUserName().c_str() );
@@ -394,6 +404,12 @@ void CEngineLoop::Tick()
 
 	// Reset input events after game frame
 	GInputSystem->ResetEvents();
+
+	// Finish frame for memory statistics
+	appMemoryEndFrame();
+
+	// Finish frame for statistics of rendering command buffer
+	GRenderCommandBuffer.EndFrame();
 }
 
 /**
@@ -413,6 +429,8 @@ void CEngineLoop::Exit()
 	GFullScreenMovie = nullptr;
 
 	GAudioEngine.Shutdown();
+	GBoundShaderStateWarmup.Shutdown();
+	GVertexDeclarationRegistry.RemoveAll();
 	GShaderManager->Shutdown();
 	GRHI->Destroy();
 
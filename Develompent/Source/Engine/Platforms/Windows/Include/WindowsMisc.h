@@ -26,4 +26,17 @@ FORCEINLINE double appSeconds()
 	return cycles.QuadPart * GSecondsPerCycle + 16777216.0;
 }
 
+
+/**
+ * @ingroup WindowsPlatform
+ * Get number of logical processors
+ * @return Return number of logical processors in the system
+ */
+FORCEINLINE uint32 appGetNumberOfProcessors()
+{
+	SYSTEM_INFO		systemInfo;
+	GetSystemInfo( &systemInfo );
+	return systemInfo.dwNumberOfProcessors;
+}
+
 #endif // !WINDOWSMISC_H
\ No newline at end of file
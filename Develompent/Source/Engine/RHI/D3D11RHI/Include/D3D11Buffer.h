@@ -9,16 +9,10 @@
 #ifndef D3D11BUFFERRHI_H
 #define D3D11BUFFERRHI_H
 
-#include <d3d11.h>
+#include <d3d11_1.h>
 
 #include "RHI/BaseBufferRHI.h"
 
-/**
- * @ingroup D3D11RHI
- * Size of the default constant buffer
- */
-#define MAX_GLOBAL_CONSTANT_BUFFER_SIZE		4096
-
 /**
  * @ingroup D3D11RHI
  * Enumeration of constant buffer slots
@@ -106,6 +100,64 @@ private:
 	ID3D11Buffer*			d3d11Buffer;		/**< Pointer to DirectX 11 buffer */
 };
 
+/**
+ * @ingroup D3D11RHI
+ * @brief Ring of shader constants in one large dynamic constant buffer
+ *
+ * Constants of all draws are written one after another by mapping without overwrite and bound by offset, so driver
+ * doesn't rename whole buffer on each commit. When the ring is full it is mapped with discard and writing begins from start
+ */
+class CD3D11ConstantBufferRing
+{
+public:
+	/**
+	 * Constructor
+	 * 
+	 * @param[in] InBufferName Buffer name
+	 */
+	CD3D11ConstantBufferRing( const tchar* InBufferName );
+
+	/**
+	 * Destructor
+	 */
+	~CD3D11ConstantBufferRing();
+
+	/**
+	 * Write constants into the ring
+	 * 
+	 * @param[in] InDeviceContext Device context
+	 * @param[in] InData Pointer to data
+	 * @param[in] InSize Size of data, it is aligned to RHI_CONSTANTBUFFER_RING_ALIGNMENT
+	 * @param[out] OutFirstConstant First constant of written range, it is used for bind the range
+	 * @param[out] OutNumConstants Number of constants in written range
+	 * @return Return TRUE if buffer was mapped with discard, in this case ranges written before are lost and need write them again
+	 */
+	bool Write( class CD3D11DeviceContext* InDeviceContext, const byte* InData, uint32 InSize, uint32& OutFirstConstant, uint32& OutNumConstants );
+
+	/**
+	 * Reset the ring, next write maps buffer with discard
+	 * @note Need call it when new command list begins in deferred context, the first map in command list must be with discard
+	 */
+	FORCEINLINE void Reset()
+	{
+		bNeedDiscard = true;
+	}
+
+	/**
+	 * @brief Get pointer to DirectX 11 buffer
+	 * @return Pointer to DirectX 11 buffer
+	 */
+	FORCEINLINE ID3D11Buffer* GetD3D11Buffer() const
+	{
+		return d3d11Buffer;
+	}
+
+private:
+	ID3D11Buffer*		d3d11Buffer;			/**< Pointer to DirectX 11 buffer */
+	uint32				offset;					/**< Offset of free space in buffer */
+	bool				bNeedDiscard;			/**< Is next map must be with discard */
+};
+
 /**
  * @ingroup D3D11RHI
  * @brief Class for work with DirectX 11 constant buffer
@@ -142,6 +194,34 @@ public:
 	 */
 	void CommitConstantsToDevice( class CD3D11DeviceContext* InDeviceContext );
 
+	/**
+	 * Write data to constant buffer ring
+	 * @note Written range covers all bytes which were updated since creating of buffer, so shader gets the same data as from own buffer
+	 * 
+	 * @param[in] InDeviceContext Device context
+	 * @param[in] InRing Constant buffer ring
+	 * @param[out] OutFirstConstant First constant of written range
+	 * @param[out] OutNumConstants Number of constants in written range
+	 * @param[out] OutIsRingDiscarded Set to TRUE if the ring was mapped with discard, isn't changed otherwise
+	 * @return Return TRUE if data was changed and written, else returning FALSE
+	 */
+	bool CommitConstantsToRing( class CD3D11DeviceContext* InDeviceContext, CD3D11ConstantBufferRing& InRing, uint32& OutFirstConstant, uint32& OutNumConstants, bool& OutIsRingDiscarded );
+
+	/**
+	 * Mark buffer as changed, it will be committed on next commit
+	 */
+	FORCEINLINE void MarkNeedCommit()
+	{
+		isNeedCommit = true;
+	}
+
+	/**
+	 * Copy data from another buffer, it will be flushed to GPU on next commit
+	 * 
+	 * @param[in] InSource Source buffer with the same size
+	 */
+	void CopyData( const CD3D11ConstantBuffer& InSource );
+
 	/**
 	 * Clear data
 	 */
@@ -162,6 +242,7 @@ private:
 	uint32				size;					/**< Size buffer */
 	byte*				shadowData;				/**< Local version of buffer, which is updated and uploaded to the GPU at once */
 	uint32				currentUpdateSize;		/**< Size to update buffer */
+	uint32				usedSize;				/**< Max size of updated data since creating of buffer */
 };
 
 #endif // !D3D11BUFFERRHI_H
\ No newline at end of file
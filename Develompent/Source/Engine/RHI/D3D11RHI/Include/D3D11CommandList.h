@@ -0,0 +1,65 @@
+/**
+ * @file
+ * @addtogroup D3D11RHI D3D11RHI
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef D3D11COMMANDLIST_H
+#define D3D11COMMANDLIST_H
+
+#include <d3d11.h>
+
+#include "RHI/BaseCommandListRHI.h"
+#include "D3D11DeviceContext.h"
+
+/**
+ * @ingroup D3D11RHI
+ * @brief Command list of DirectX 11, it is recorded by deferred context
+ */
+class CD3D11CommandListRHI : public CBaseCommandListRHI
+{
+public:
+	/**
+	 * @brief Constructor
+	 * @param InDeferredContext		Deferred context for recording, command list takes ownership of it
+	 */
+	CD3D11CommandListRHI( CD3D11DeviceContext* InDeferredContext );
+
+	/**
+	 * @brief Destructor
+	 */
+	virtual ~CD3D11CommandListRHI();
+
+	/**
+	 * @brief Is deferred command list
+	 * @return Return TRUE if commands are recorded for playback later, else returning FALSE if commands are executed directly
+	 */
+	virtual bool IsDeferred() const override;
+
+	/**
+	 * @brief Finish recording of commands to D3D11 command list
+	 */
+	void Finish();
+
+	/**
+	 * @brief Execute recorded commands on immediate context
+	 * @param InImmediateContext	Immediate context
+	 */
+	void Execute( CD3D11DeviceContext* InImmediateContext );
+
+	/**
+	 * @brief Get deferred context
+	 * @return Return deferred context
+	 */
+	FORCEINLINE CD3D11DeviceContext* GetD3D11DeferredContext() const
+	{
+		return ( CD3D11DeviceContext* )deviceContext;
+	}
+
+private:
+	ID3D11CommandList*		d3d11CommandList;		/**< D3D11 command list, it is valid between Finish and Execute */
+};
+
+#endif // !D3D11COMMANDLIST_H
\ No newline at end of file
@@ -9,13 +9,18 @@
 #ifndef D3D11DEVICECONTEXT_H
 #define D3D11DEVICECONTEXT_H
 
-#include <d3d11.h>
+#include <d3d11_1.h>
 
+#include "Misc/RefCountPtr.h"
 #include "RHI/BaseDeviceContextRHI.h"
+#include "D3D11State.h"
+#include "D3D11Buffer.h"
 
 /**
  * @ingroup D3D11RHI
  * @brief Class for work with DirectX 11 device context
+ *
+ * Each context owns its state cache, constant buffers and instance buffer, so deferred contexts can be recorded in parallel
 */
 class CD3D11DeviceContext : public CBaseDeviceContextRHI
 {
@@ -51,6 +56,26 @@ public:
 	 */
 	virtual void							ClearDepthStencil( SurfaceRHIParamRef_t InSurface, bool InIsClearDepth = true, bool InIsClearStencil = true, float InDepthValue = 1.f, uint8 InStencilValue = 0 ) override;
 
+	/**
+	 * @brief Bind constant buffers of context to shader stages
+	 * @note Need call it when state of D3D11 device context is reset (e.g. after finishing a command list). If constant buffer ring is used, shader constants are bound on next commit
+	 */
+	void									BindConstantBuffers();
+
+	/**
+	 * @brief Commit changed shader constants to device
+	 * @note If constant buffer ring is used, changed constants are written into the ring and bound by offset
+	 */
+	void									CommitConstants();
+
+	/**
+	 * @brief Inherit state from another context
+	 * Binds all state of InSourceContext, including render targets, viewport and global constants, to this context
+	 * 
+	 * @param[in] InSourceContext Source device context
+	 */
+	void									InheritState( const CD3D11DeviceContext& InSourceContext );
+
 	/**
 	 * @brief Get D3D11 device context
 	 * @return Pointer to D3D11 device context
@@ -60,8 +85,80 @@ public:
 		return d3d11DeviceContext;
 	}
 
+	/**
+	 * @brief Get DirectX state cache
+	 * @return Return DirectX state cache
+	 */
+	FORCEINLINE SD3D11StateCache&			GetStateCache()
+	{
+		return stateCache;
+	}
+
+	/**
+	 * @brief Get DirectX state cache
+	 * @return Return DirectX state cache
+	 */
+	FORCEINLINE const SD3D11StateCache&		GetStateCache() const
+	{
+		return stateCache;
+	}
+
+	/**
+	 * @brief Get global constant buffer
+	 * @return Return global constant buffer
+	 */
+	FORCEINLINE CD3D11ConstantBuffer*		GetGlobalConstantBuffer() const
+	{
+		return globalConstantBuffer;
+	}
+
+	/**
+	 * @brief Get constant buffer of vertex shader
+	 * 
+	 * @param[in] InBufferIndex Index of buffer
+	 * @return Return constant buffer of vertex shader, if it not exist returns NULL
+	 */
+	FORCEINLINE CD3D11ConstantBuffer*		GetVSConstantBuffer( uint32 InBufferIndex ) const
+	{
+		return vsConstantBuffers[ InBufferIndex ];
+	}
+
+	/**
+	 * @brief Get constant buffer of pixel shader
+	 * @return Return constant buffer of pixel shader
+	 */
+	FORCEINLINE CD3D11ConstantBuffer*		GetPSConstantBuffer() const
+	{
+		return psConstantBuffer;
+	}
+
+	/**
+	 * @brief Get instance buffer
+	 * @return Return reference to instance buffer
+	 */
+	FORCEINLINE TRefCountPtr< CD3D11VertexBufferRHI >& GetInstanceBuffer()
+	{
+		return instanceBuffer;
+	}
+
+	/**
+	 * @brief Get constant buffer ring
+	 * @return Return constant buffer ring, if it isn't supported returns NULL
+	 */
+	FORCEINLINE CD3D11ConstantBufferRing*	GetConstantBufferRing() const
+	{
+		return constantBufferRing;
+	}
+
 private:
-	ID3D11DeviceContext*			d3d11DeviceContext;			/**< D3D11 Device context */
+	ID3D11DeviceContext*					d3d11DeviceContext;					/**< D3D11 Device context */
+	ID3D11DeviceContext1*					d3d11DeviceContext1;				/**< D3D11.1 Device context for bind constant buffers by offset, it is NULL if constant buffer ring isn't used */
+	SD3D11StateCache						stateCache;							/**< DirectX 11 state cache */
+	CD3D11ConstantBuffer*					globalConstantBuffer;				/**< Global constant buffer */
+	CD3D11ConstantBuffer*					vsConstantBuffers[ SOB_Max ];		/**< Constant buffers for vertex shader */
+	CD3D11ConstantBuffer*					psConstantBuffer;					/**< Constant buffer for pixel shader */
+	TRefCountPtr< CD3D11VertexBufferRHI >	instanceBuffer;						/**< Instance buffer */
+	CD3D11ConstantBufferRing*				constantBufferRing;					/**< Ring for shader constants, it is NULL if isn't supported */
 };
 
 #endif // !D3D11DEVICECONTEXT_H
@@ -169,7 +169,7 @@ public:
 	 * @param[in] InGeometryShader Geometry shader
 	 * @return Pointer to bound shader state
 	 */
-	virtual BoundShaderStateRHIRef_t					CreateBoundShaderState( const tchar* InBoundShaderStateName, VertexDeclarationRHIRef_t InVertexDeclaration, VertexShaderRHIRef_t InVertexShader, PixelShaderRHIRef_t InPixelShader, HullShaderRHIRef_t InHullShader = nullptr, DomainShaderRHIRef_t InDomainShader = nullptr, GeometryShaderRHIRef_t InGeometryShader = nullptr ) override;
+	virtual BoundShaderStateRHIRef_t					CreateBoundShaderState( const tchar* InBoundShaderStateName, VertexDeclarationRHIRef_t InVertexDeclaration, VertexShaderRHIRef_t InVertexShader, PixelShaderRHIRef_t InPixelShader, HullShaderRHIRef_t InHullShader = nullptr, DomainShaderRHIRef_t InDomainShader = nullptr, GeometryShaderRHIRef_t InGeometryShader = nullptr, bool* OutIsCreated = nullptr ) override;
 
 	/**
 	 * @brief Create rasterizer state
@@ -255,6 +255,34 @@ public:
 	 */
 	virtual void									EndDrawingViewport( class CBaseDeviceContextRHI* InDeviceContext, class CBaseViewportRHI* InViewport, bool InIsPresent, bool InLockToVsync ) override;
 
+	/**
+	 * @brief Create command list
+	 * @return Return command list recorded by deferred context, if failed returns NULL
+	 */
+	virtual CommandListRHIRef_t						CreateCommandList() override;
+
+	/**
+	 * @brief Begin recording of command list
+	 *
+	 * @param[in] InImmediateContext Immediate device context
+	 * @param[in] InCommandList Command list
+	 */
+	virtual void									BeginCommandList( class CBaseDeviceContextRHI* InImmediateContext, CommandListRHIParamRef_t InCommandList ) override;
+
+	/**
+	 * @brief End recording of command list
+	 * @param[in] InCommandList Command list
+	 */
+	virtual void									EndCommandList( CommandListRHIParamRef_t InCommandList ) override;
+
+	/**
+	 * @brief Execute recorded command list on immediate context
+	 *
+	 * @param[in] InImmediateContext Immediate device context
+	 * @param[in] InCommandList Command list
+	 */
+	virtual void									ExecuteCommandList( class CBaseDeviceContextRHI* InImmediateContext, CommandListRHIParamRef_t InCommandList ) override;
+
 #if WITH_EDITOR
 	/**
 	 * @brief Compile shader
@@ -593,6 +621,15 @@ public:
 	 */
 	virtual void CopyToResolveTarget( class CBaseDeviceContextRHI* InDeviceContext, SurfaceRHIParamRef_t InSourceSurface, const SResolveParams& InResolveParams ) override;
 
+	/**
+	 * @brief Copies mips which are shared by two textures
+	 *
+	 * @param InDeviceContext		Device context
+	 * @param InDestTexture			Destination texture
+	 * @param InSourceTexture		Source texture
+	 */
+	virtual void CopySharedMips( class CBaseDeviceContextRHI* InDeviceContext, Texture2DRHIParamRef_t InDestTexture, Texture2DRHIParamRef_t InSourceTexture ) override;
+
 	/**
 	 * @brief Is initialized RHI
 	 * @return Return true if RHI is initialized, else false
@@ -651,34 +688,30 @@ public:
 	}
 
 	/**
-	 * @brief Get bound shader state history
-	 * @return Reference to bound shader state history
+	 * @brief Is shader constants committed through constant buffer ring
+	 * @return Return TRUE if driver supports binding of constant buffers by offset and mapping them without overwrite in all contexts
 	 */
-	FORCEINLINE CBoundShaderStateHistory&			GetBoundShaderStateHistory()
+	FORCEINLINE bool								IsConstantBufferRingSupported() const
 	{
-		return boundShaderStateHistory;
+		return bConstantBufferRing;
 	}
 
 	/**
-	 * @brief Get DirectX state cache
-	 * @return Return DirectX state cache
+	 * @brief Get bound shader state history
+	 * @return Reference to bound shader state history
 	 */
-	FORCEINLINE const SD3D11StateCache& GetStateCache() const
+	FORCEINLINE CBoundShaderStateHistory&			GetBoundShaderStateHistory()
 	{
-		return stateCache;
+		return boundShaderStateHistory;
 	}
 
 private:
 	bool										isInitialize;						/**< Is RHI is initialized */
-	class CD3D11ConstantBuffer*					globalConstantBuffer;				/**< Global constant buffer */
-	class CD3D11ConstantBuffer*					vsConstantBuffers[ SOB_Max ];		/**< Constant buffers for vertex shader */
-	class CD3D11ConstantBuffer*					psConstantBuffer;					/**< Constant buffer for pixel shader */
 	class CD3D11DeviceContext*					immediateContext;					/**< Immediate context */
 	CBoundShaderStateHistory					boundShaderStateHistory;			/**< History of using bound shader states */
-	SD3D11StateCache							stateCache;							/**< DirectX 11 state cache */
-	TRefCountPtr< CD3D11VertexBufferRHI >		instanceBuffer;						/**< Instance buffer */
 
 	D3D_FEATURE_LEVEL							d3dFeatureLevel;					/**< DirectX feature level */
+	bool										bConstantBufferRing;				/**< Is shader constants committed through constant buffer ring */
 	ID3D11Device*								d3d11Device;						/**< D3D11 Device */
 	IDXGIFactory*								dxgiFactory;						/**< DXGI factory */
 	IDXGIAdapter*								dxgiAdapter;						/**< DXGI adapter */
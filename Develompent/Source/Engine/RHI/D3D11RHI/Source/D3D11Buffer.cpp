@@ -147,7 +147,8 @@ CD3D11ConstantBuffer::CD3D11ConstantBuffer( uint32 InSize, const tchar* InBuffer
 	d3d11Buffer( nullptr ),
 	size( InSize ),
 	shadowData( nullptr ),
-	currentUpdateSize( 0 )
+	currentUpdateSize( 0 ),
+	usedSize( 0 )
 {
 	// Explicitly check that the size is nonzero before allowing create constant buffer to opaquely fail
 	check( size > 0 );
@@ -203,6 +204,7 @@ void CD3D11ConstantBuffer::Update( const byte* InData, uint32 InOffset, uint32 I
 {
 	memcpy( shadowData + InOffset, InData, InSize );
 	currentUpdateSize = Max( currentUpdateSize, ( uint32 )InOffset + InSize );
+	usedSize = Max( usedSize, currentUpdateSize );
 	isNeedCommit = true;
 }
 
@@ -231,6 +233,32 @@ void CD3D11ConstantBuffer::CommitConstantsToDevice( class CD3D11DeviceContext* I
 	currentUpdateSize = 0;
 }
 
+bool CD3D11ConstantBuffer::CommitConstantsToRing( class CD3D11DeviceContext* InDeviceContext, CD3D11ConstantBufferRing& InRing, uint32& OutFirstConstant, uint32& OutNumConstants, bool& OutIsRingDiscarded )
+{
+	if ( !isNeedCommit )
+	{
+		return false;
+	}
+
+	// Constants out of bound range are read as zero, it is the same as cleared bytes in shadow data
+	if ( InRing.Write( InDeviceContext, shadowData, Max( usedSize, ( uint32 )16 ), OutFirstConstant, OutNumConstants ) )
+	{
+		OutIsRingDiscarded = true;
+	}
+	isNeedCommit = false;
+	currentUpdateSize = 0;
+	return true;
+}
+
+void CD3D11ConstantBuffer::CopyData( const CD3D11ConstantBuffer& InSource )
+{
+	check( size == InSource.size );
+	memcpy( shadowData, InSource.shadowData, size );
+	isNeedCommit = true;
+	currentUpdateSize = size;
+	usedSize = size;
+}
+
 void CD3D11ConstantBuffer::Clear()
 {
 	if ( !shadowData )		return;
@@ -238,4 +266,77 @@ void CD3D11ConstantBuffer::Clear()
 	appMemzero( shadowData, size );
 	isNeedCommit = true;
 	currentUpdateSize = size;
+}
+
+// ------------------------------------
+// CONSTANT BUFFER RING
+// ------------------------------------
+
+CD3D11ConstantBufferRing::CD3D11ConstantBufferRing( const tchar* InBufferName ) :
+	d3d11Buffer( nullptr ),
+	offset( 0 ),
+	bNeedDiscard( true )
+{
+	D3D11_BUFFER_DESC			bufferDesc;
+	bufferDesc.ByteWidth			= RHI_CONSTANTBUFFER_RING_SIZE;
+	bufferDesc.Usage				= D3D11_USAGE_DYNAMIC;
+	bufferDesc.CPUAccessFlags		= D3D11_CPU_ACCESS_WRITE;
+	bufferDesc.BindFlags			= D3D11_BIND_CONSTANT_BUFFER;
+	bufferDesc.MiscFlags			= 0;
+	bufferDesc.StructureByteStride	= 0;
+
+	// Creating DirectX 11 constant buffer
+	ID3D11Device*		device = static_cast< CD3D11RHI* >( GRHI )->GetD3D11Device();
+
+#if DO_CHECK
+	HRESULT				result = device->CreateBuffer( &bufferDesc, nullptr, &d3d11Buffer );
+	check( result == S_OK );
+#else
+	device->CreateBuffer( &bufferDesc, nullptr, &d3d11Buffer );
+#endif // DO_CHECK
+
+#if !SHIPPING_BUILD
+	D3D11SetDebugName( d3d11Buffer, TCHAR_TO_ANSI( CString::Format( TEXT( "%s[CONSTANT_BUFFER_RING]" ), InBufferName ).c_str() ) );
+#endif // !SHIPPING_BUILD
+}
+
+CD3D11ConstantBufferRing::~CD3D11ConstantBufferRing()
+{
+	if ( d3d11Buffer )
+	{
+		d3d11Buffer->Release();
+	}
+}
+
+bool CD3D11ConstantBufferRing::Write( class CD3D11DeviceContext* InDeviceContext, const byte* InData, uint32 InSize, uint32& OutFirstConstant, uint32& OutNumConstants )
+{
+	check( InDeviceContext && InSize > 0 );
+	const uint32		alignedSize = Align( InSize, ( uint32 )RHI_CONSTANTBUFFER_RING_ALIGNMENT );
+	check( alignedSize <= RHI_CONSTANTBUFFER_RING_SIZE );
+
+	// If the ring is full, driver gives new memory for buffer and writing begins from start. GPU may still read the old one
+	if ( offset + alignedSize > RHI_CONSTANTBUFFER_RING_SIZE )
+	{
+		bNeedDiscard = true;
+	}
+
+	if ( bNeedDiscard )
+	{
+		offset = 0;
+	}
+
+	const bool						bDiscard = bNeedDiscard;
+	ID3D11DeviceContext*			d3d11DeviceContext = InDeviceContext->GetD3D11DeviceContext();
+	D3D11_MAPPED_SUBRESOURCE		d3d11Mapped;
+	d3d11DeviceContext->Map( d3d11Buffer, 0, bDiscard ? D3D11_MAP_WRITE_DISCARD : D3D11_MAP_WRITE_NO_OVERWRITE, 0, &d3d11Mapped );
+	memcpy( ( byte* )d3d11Mapped.pData + offset, InData, InSize );
+	appMemzero( ( byte* )d3d11Mapped.pData + offset + InSize, alignedSize - InSize );
+	d3d11DeviceContext->Unmap( d3d11Buffer, 0 );
+
+	// Offset and size of bound range are in constants of 16 bytes
+	OutFirstConstant	= offset / 16;
+	OutNumConstants		= alignedSize / 16;
+	offset				+= alignedSize;
+	bNeedDiscard		= false;
+	return bDiscard;
 }
\ No newline at end of file
@@ -0,0 +1,45 @@
+#include "Core.h"
+#include "D3D11CommandList.h"
+
+CD3D11CommandListRHI::CD3D11CommandListRHI( CD3D11DeviceContext* InDeferredContext )
+	: CBaseCommandListRHI( InDeferredContext )
+	, d3d11CommandList( nullptr )
+{
+	check( InDeferredContext );
+}
+
+CD3D11CommandListRHI::~CD3D11CommandListRHI()
+{
+	if ( d3d11CommandList )
+	{
+		d3d11CommandList->Release();
+		d3d11CommandList = nullptr;
+	}
+	delete deviceContext;
+}
+
+bool CD3D11CommandListRHI::IsDeferred() const
+{
+	return true;
+}
+
+void CD3D11CommandListRHI::Finish()
+{
+	check( !d3d11CommandList );
+	CD3D11DeviceContext*		deferredContext = GetD3D11DeferredContext();
+
+	// State of deferred context is reset to default after finishing, so state cache reset too
+	HRESULT		result = deferredContext->GetD3D11DeviceContext()->FinishCommandList( FALSE, &d3d11CommandList );
+	check( result == S_OK );
+	appMemzero( &deferredContext->GetStateCache(), sizeof( SD3D11StateCache ) );
+}
+
+void CD3D11CommandListRHI::Execute( CD3D11DeviceContext* InImmediateContext )
+{
+	check( InImmediateContext && d3d11CommandList );
+
+	// Restore state of immediate context after execution, so its state cache stays valid
+	InImmediateContext->GetD3D11DeviceContext()->ExecuteCommandList( d3d11CommandList, TRUE );
+	d3d11CommandList->Release();
+	d3d11CommandList = nullptr;
+}
\ No newline at end of file
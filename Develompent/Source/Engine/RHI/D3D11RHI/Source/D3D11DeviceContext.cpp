@@ -2,23 +2,226 @@
 #include "Math/Color.h"
 #include "D3D11DeviceContext.h"
 #include "D3D11Surface.h"
+#include "D3D11Buffer.h"
+#include "D3D11RHI.h"
 
 /**
  * Constructor
  */
 CD3D11DeviceContext::CD3D11DeviceContext( ID3D11DeviceContext* InD3D11DeviceContext ) :
-	d3d11DeviceContext( InD3D11DeviceContext )
-{}
+	d3d11DeviceContext( InD3D11DeviceContext ),
+	d3d11DeviceContext1( nullptr ),
+	globalConstantBuffer( nullptr ),
+	psConstantBuffer( nullptr ),
+	constantBufferRing( nullptr )
+{
+	appMemzero( &stateCache, sizeof( SD3D11StateCache ) );
+	appMemzero( vsConstantBuffers, sizeof( vsConstantBuffers ) );
+
+	// Shader constants of draws are written into one ring if D3D11.1 runtime is available
+	if ( static_cast< CD3D11RHI* >( GRHI )->IsConstantBufferRingSupported() && SUCCEEDED( d3d11DeviceContext->QueryInterface( __uuidof( ID3D11DeviceContext1 ), ( void** )&d3d11DeviceContext1 ) ) )
+	{
+		constantBufferRing = new CD3D11ConstantBufferRing( TEXT( "ShaderConstantBufferRing" ) );
+	}
+
+	// Create constant buffers for shaders
+	globalConstantBuffer						= new CD3D11ConstantBuffer( GConstantBufferSizes[ SOB_GlobalConstants ], TEXT( "GlobalConstantBuffer" ) );
+	vsConstantBuffers[ SOB_ShaderConstants ]	= new CD3D11ConstantBuffer( GConstantBufferSizes[ SOB_ShaderConstants ], TEXT( "ShaderConstantBuffer" ) );
+	psConstantBuffer							= new CD3D11ConstantBuffer( GConstantBufferSizes[ SOB_ShaderConstants ], TEXT( "ShaderConstantBuffer" ) );
+	BindConstantBuffers();
+}
 
 /**
  * Destructor
  */
 CD3D11DeviceContext::~CD3D11DeviceContext()
 {
+	for ( uint32 index = 0, num = ARRAY_COUNT( vsConstantBuffers ); index < num; ++index )
+	{
+		CD3D11ConstantBuffer*		constantBuffer = vsConstantBuffers[ index ];
+		if ( constantBuffer )
+		{
+			delete constantBuffer;
+		}
+	}
+
+	delete globalConstantBuffer;
+	delete psConstantBuffer;
+	instanceBuffer = nullptr;
+
+	if ( constantBufferRing )
+	{
+		delete constantBufferRing;
+		constantBufferRing = nullptr;
+	}
+
+	if ( d3d11DeviceContext1 )
+	{
+		d3d11DeviceContext1->Release();
+		d3d11DeviceContext1 = nullptr;
+	}
+
 	d3d11DeviceContext->Release();
 	d3d11DeviceContext = nullptr;
 }
 
+void CD3D11DeviceContext::BindConstantBuffers()
+{
+	// Global constant buffer
+	{
+		ID3D11Buffer*		d3d11GlobalConstantBuffer = globalConstantBuffer->GetD3D11Buffer();
+		d3d11DeviceContext->VSSetConstantBuffers( SOB_GlobalConstants, 1, &d3d11GlobalConstantBuffer );
+		d3d11DeviceContext->PSSetConstantBuffers( SOB_GlobalConstants, 1, &d3d11GlobalConstantBuffer );
+		d3d11DeviceContext->GSSetConstantBuffers( SOB_GlobalConstants, 1, &d3d11GlobalConstantBuffer );
+		d3d11DeviceContext->CSSetConstantBuffers( SOB_GlobalConstants, 1, &d3d11GlobalConstantBuffer );
+	}
+
+	// Shader constants are bound from the ring on next commit, the first write into the ring after reset of state must be with discard
+	if ( constantBufferRing )
+	{
+		constantBufferRing->Reset();
+		for ( uint32 index = 0, num = ARRAY_COUNT( vsConstantBuffers ); index < num; ++index )
+		{
+			if ( vsConstantBuffers[ index ] )
+			{
+				vsConstantBuffers[ index ]->MarkNeedCommit();
+			}
+		}
+		psConstantBuffer->MarkNeedCommit();
+		return;
+	}
+
+	// Vertex constant buffer
+	for ( uint32 index = 0, num = ARRAY_COUNT( vsConstantBuffers ); index < num; ++index )
+	{
+		CD3D11ConstantBuffer*		constantBuffer = vsConstantBuffers[ index ];
+		if ( constantBuffer )
+		{
+			ID3D11Buffer*		d3d11ConstantBuffer = constantBuffer->GetD3D11Buffer();
+			d3d11DeviceContext->VSSetConstantBuffers( index, 1, &d3d11ConstantBuffer );
+		}
+	}
+
+	// Pixel constant buffer
+	{
+		ID3D11Buffer*		d3d11ConstantBuffer = psConstantBuffer->GetD3D11Buffer();
+		d3d11DeviceContext->PSSetConstantBuffers( SOB_ShaderConstants, 1, &d3d11ConstantBuffer );
+	}
+}
+
+void CD3D11DeviceContext::CommitConstants()
+{
+	// Write changed constants into the ring and bind them by offset
+	if ( constantBufferRing )
+	{
+		ID3D11Buffer*		d3d11RingBuffer		= constantBufferRing->GetD3D11Buffer();
+		uint32				firstConstant		= 0;
+		uint32				numConstants		= 0;
+		bool				bRingDiscarded		= false;
+		for ( ;; )
+		{
+			for ( uint32 index = 0, num = ARRAY_COUNT( vsConstantBuffers ); index < num; ++index )
+			{
+				CD3D11ConstantBuffer*		constantBuffer = vsConstantBuffers[ index ];
+				if ( constantBuffer && constantBuffer->CommitConstantsToRing( this, *constantBufferRing, firstConstant, numConstants, bRingDiscarded ) )
+				{
+					d3d11DeviceContext1->VSSetConstantBuffers1( index, 1, &d3d11RingBuffer, &firstConstant, &numConstants );
+				}
+			}
+
+			if ( psConstantBuffer->CommitConstantsToRing( this, *constantBufferRing, firstConstant, numConstants, bRingDiscarded ) )
+			{
+				d3d11DeviceContext1->PSSetConstantBuffers1( SOB_ShaderConstants, 1, &d3d11RingBuffer, &firstConstant, &numConstants );
+			}
+
+			if ( !bRingDiscarded )
+			{
+				break;
+			}
+
+			// The ring was mapped with discard, so ranges of unchanged buffers bound before point to lost data.
+			// Write all bound buffers again, after discard the ring has space for all of them and second pass doesn't discard
+			for ( uint32 index = 0, num = ARRAY_COUNT( vsConstantBuffers ); index < num; ++index )
+			{
+				if ( vsConstantBuffers[ index ] )
+				{
+					vsConstantBuffers[ index ]->MarkNeedCommit();
+				}
+			}
+			psConstantBuffer->MarkNeedCommit();
+			bRingDiscarded = false;
+		}
+		return;
+	}
+
+	// Commit vertex shader constants
+	for ( uint32 index = 0, num = ARRAY_COUNT( vsConstantBuffers ); index < num; ++index )
+	{
+		CD3D11ConstantBuffer*		constantBuffer = vsConstantBuffers[ index ];
+		if ( constantBuffer )
+		{
+			constantBuffer->CommitConstantsToDevice( this );
+		}
+	}
+
+	// Commit pixel shader constants
+	psConstantBuffer->CommitConstantsToDevice( this );
+}
+
+void CD3D11DeviceContext::InheritState( const CD3D11DeviceContext& InSourceContext )
+{
+	const SD3D11StateCache&		sourceState = InSourceContext.GetStateCache();
+	BindConstantBuffers();
+
+	// Copy view parameters
+	globalConstantBuffer->CopyData( *InSourceContext.GetGlobalConstantBuffer() );
+	globalConstantBuffer->CommitConstantsToDevice( this );
+
+	// Output merger and rasterizer
+	float		blendFactor[ 4 ] = { 0.f, 0.f, 0.f, 0.f };
+	d3d11DeviceContext->OMSetRenderTargets( D3D11_SIMULTANEOUS_RENDER_TARGET_COUNT, sourceState.renderTargetViews, sourceState.depthStencilView );
+	d3d11DeviceContext->OMSetDepthStencilState( sourceState.depthStencilState, 0 );
+	d3d11DeviceContext->OMSetBlendState( sourceState.blendState, blendFactor, 0xFFFFFFFF );
+	d3d11DeviceContext->RSSetState( sourceState.rasterizerState );
+	if ( sourceState.viewport.Width > 0 && sourceState.viewport.Height > 0 )
+	{
+		d3d11DeviceContext->RSSetViewports( 1, &sourceState.viewport );
+	}
+
+	// Shaders
+	d3d11DeviceContext->IASetInputLayout( sourceState.inputLayout );
+	d3d11DeviceContext->VSSetShader( sourceState.vertexShader, nullptr, 0 );
+	d3d11DeviceContext->PSSetShader( sourceState.pixelShader, nullptr, 0 );
+	d3d11DeviceContext->GSSetShader( sourceState.geometryShader, nullptr, 0 );
+	d3d11DeviceContext->HSSetShader( sourceState.hullShader, nullptr, 0 );
+	d3d11DeviceContext->DSSetShader( sourceState.domainShader, nullptr, 0 );
+	d3d11DeviceContext->PSSetSamplers( 0, D3D11_COMMONSHADER_SAMPLER_SLOT_COUNT, sourceState.psSamplerStates );
+	d3d11DeviceContext->PSSetShaderResources( 0, D3D11_COMMONSHADER_INPUT_RESOURCE_SLOT_COUNT, sourceState.psShaderResourceViews );
+
+	// Input assembler
+	for ( uint32 index = 0; index < D3D11_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT; ++index )
+	{
+		const CD3D11StateVertexBuffer&		vertexBuffer = sourceState.vertexBuffers[ index ];
+		if ( vertexBuffer.vertexBuffer )
+		{
+			d3d11DeviceContext->IASetVertexBuffers( index, 1, &vertexBuffer.vertexBuffer, &vertexBuffer.stride, &vertexBuffer.offset );
+		}
+	}
+
+	if ( sourceState.indexBuffer.indexBuffer )
+	{
+		d3d11DeviceContext->IASetIndexBuffer( sourceState.indexBuffer.indexBuffer, sourceState.indexBuffer.format, sourceState.indexBuffer.offset );
+	}
+
+	if ( sourceState.primitiveTopology != D3D_PRIMITIVE_TOPOLOGY_UNDEFINED )
+	{
+		d3d11DeviceContext->IASetPrimitiveTopology( sourceState.primitiveTopology );
+	}
+
+	// Now state of this context is the same as in source
+	stateCache = sourceState;
+}
+
 /**
  * Clear surface
  */
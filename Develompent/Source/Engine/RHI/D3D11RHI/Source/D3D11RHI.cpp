@@ -2,6 +2,7 @@
 
 #include "Core.h"
 #include "Logger/LoggerMacros.h"
+#include "Misc/CommandLine.h"
 #include "Render/RenderResource.h"
 #include "Render/RenderUtils.h"
 #include "Render/GlobalConstantsHelper.h"
@@ -14,6 +15,7 @@
 #include "D3D11RHI.h"
 #include "D3D11Viewport.h"
 #include "D3D11DeviceContext.h"
+#include "D3D11CommandList.h"
 #include "D3D11Surface.h"
 #include "D3D11Shader.h"
 #include "D3D11Buffer.h"
@@ -192,9 +194,9 @@ void ResolveSurfaceUsingShader( CD3D11DeviceContext* InDeviceContextRHI, CD3D11S
 	d3d11DeviceContext->RSGetViewports( &numSavedViewports, &d3d11SavedViewport );
 
 	// No alpha blending, no depth tests or writes, no stencil tests or writes, no backface culling.
-	GRHI->SetBlendState( InDeviceContextRHI, TStaticBlendStateRHI<>::GetRHI() );
-	GRHI->SetStencilState( InDeviceContextRHI, TStaticStencilStateRHI<>::GetRHI() );
-	GRHI->SetRasterizerState( InDeviceContextRHI, TStaticRasterizerStateRHI<FM_Solid, CM_None>::GetRHI() );
+	InDeviceContextRHI->SetBlendState( TStaticBlendStateRHI<>::GetRHI() );
+	InDeviceContextRHI->SetStencilState( TStaticStencilStateRHI<>::GetRHI() );
+	InDeviceContextRHI->SetRasterizerState( TStaticRasterizerStateRHI<FM_Solid, CM_None>::GetRHI() );
 
 	// Determine if the entire destination surface is being resolved to.
 	// If the entire surface is being resolved to, then it means we can clear it and signal the driver that it can discard
@@ -209,7 +211,7 @@ void ResolveSurfaceUsingShader( CD3D11DeviceContext* InDeviceContextRHI, CD3D11S
 			d3d11DeviceContext->ClearDepthStencilView( d3d11DepthStencilView, D3D11_CLEAR_DEPTH | D3D11_CLEAR_STENCIL, 0, 0 );
 		}
 
-		GRHI->SetDepthState( InDeviceContextRHI, TStaticDepthStateRHI<true, CF_Always>::GetRHI() );
+		InDeviceContextRHI->SetDepthState( TStaticDepthStateRHI<true, CF_Always>::GetRHI() );
 
 		// Write to the dest surface as a depth-stencil target
 		ID3D11RenderTargetView*			nullRTV = nullptr;
@@ -224,7 +226,7 @@ void ResolveSurfaceUsingShader( CD3D11DeviceContext* InDeviceContextRHI, CD3D11S
 			d3d11DeviceContext->ClearRenderTargetView( d3d11RenderTargetView, ( float* ) &clearColor.ToNormalizedVector4D() );
 		}
 
-		GRHI->SetDepthState( InDeviceContextRHI, TStaticDepthStateRHI<false, CF_Always>::GetRHI() );
+		InDeviceContextRHI->SetDepthState( TStaticDepthStateRHI<false, CF_Always>::GetRHI() );
 
 		// Write to the dest surface as a render target.
 		d3d11DeviceContext->OMSetRenderTargets( 1, &d3d11RenderTargetView, nullptr );
@@ -261,7 +263,7 @@ void ResolveSurfaceUsingShader( CD3D11DeviceContext* InDeviceContextRHI, CD3D11S
 		resolveBoundShaderState = GRHI->CreateBoundShaderState( TEXT( "Resolve" ), GSimpleElementVertexDeclaration.GetVertexDeclarationRHI(), resolveVertexShader->GetVertexShader(), resolvePixelShader->GetPixelShader() );
 		check( resolveBoundShaderState );
 	}
-	GRHI->SetBoundShaderState( InDeviceContextRHI, resolveBoundShaderState );
+	InDeviceContextRHI->SetBoundShaderState( resolveBoundShaderState );
 
 	// Generate the vertices used
 	SSimpleElementVertexType	vertices[4];
@@ -317,12 +319,9 @@ static FORCEINLINE SResolveRect GetDefaultRect( const SResolveRect& InRect, uint
 CD3D11RHI::CD3D11RHI() 
 	: isInitialize( false )
 	, immediateContext( nullptr )
-	, globalConstantBuffer( nullptr )
-	, psConstantBuffer( nullptr )
+	, bConstantBufferRing( false )
 	, d3d11Device( nullptr )
-{
-	appMemzero( vsConstantBuffers, sizeof( vsConstantBuffers ) );
-}
+{}
 
 /**
  * Destructor
@@ -366,40 +365,16 @@ void CD3D11RHI::Init( bool InIsEditor )
 	result = D3D11CreateDevice( dxgiAdapter, driverType, nullptr, deviceFlags, &maxFeatureLevel, 1, D3D11_SDK_VERSION, &d3d11Device, &d3dFeatureLevel, &d3d11DeviceContext );
 	check( result == S_OK );
 
-	immediateContext = new CD3D11DeviceContext( d3d11DeviceContext );
-	
-	// Create constant buffers for shaders
-	// Global constant buffer
-	globalConstantBuffer = new class CD3D11ConstantBuffer( GConstantBufferSizes[ SOB_GlobalConstants ], TEXT( "GlobalConstantBuffer" ) );
-	{
-		ID3D11Buffer*		d3d11GlobalConstantBuffer = globalConstantBuffer->GetD3D11Buffer();
-		d3d11DeviceContext->VSSetConstantBuffers( SOB_GlobalConstants, 1, &d3d11GlobalConstantBuffer );
-		d3d11DeviceContext->PSSetConstantBuffers( SOB_GlobalConstants, 1, &d3d11GlobalConstantBuffer );
-		d3d11DeviceContext->GSSetConstantBuffers( SOB_GlobalConstants, 1, &d3d11GlobalConstantBuffer );
-		d3d11DeviceContext->CSSetConstantBuffers( SOB_GlobalConstants, 1, &d3d11GlobalConstantBuffer );
-	}
+	// Constant buffer ring needs D3D 11.1 runtime: binding of constant buffers by offset and mapping without overwrite in deferred contexts
+	D3D11_FEATURE_DATA_D3D11_OPTIONS	d3d11Options;
+	appMemzero( &d3d11Options, sizeof( D3D11_FEATURE_DATA_D3D11_OPTIONS ) );
+	bConstantBufferRing =	SUCCEEDED( d3d11Device->CheckFeatureSupport( D3D11_FEATURE_D3D11_OPTIONS, &d3d11Options, sizeof( D3D11_FEATURE_DATA_D3D11_OPTIONS ) ) ) &&
+							d3d11Options.ConstantBufferOffsetting && d3d11Options.MapNoOverwriteOnDynamicConstantBuffer &&
+							!GCommandLine.HasParam( TEXT( "noconstantbufferring" ) );
+	LE_LOG( LT_Log, LC_Init, TEXT( "Constant buffer ring: %s" ), bConstantBufferRing ? TEXT( "true" ) : TEXT( "false" ) );
 
-	// Vertex constant buffer
-	vsConstantBuffers[ SOB_ShaderConstants ] = new CD3D11ConstantBuffer( GConstantBufferSizes[ SOB_ShaderConstants ], TEXT( "ShaderConstantBuffer" ) );
-	vsConstantBuffers[ SOB_GlobalConstants ] = nullptr;
-	{
-		for ( uint32 index = 0, num = ARRAY_COUNT( vsConstantBuffers ); index < num; ++index )
-		{
-			CD3D11ConstantBuffer*		constantBuffer = vsConstantBuffers[ index ];
-			if ( constantBuffer )
-			{
-				ID3D11Buffer*		d3d11ConstantBuffer = constantBuffer->GetD3D11Buffer();
-				d3d11DeviceContext->VSSetConstantBuffers( SOB_ShaderConstants, 1, &d3d11ConstantBuffer );
-			}
-		}
-	}
-
-	// Pixel constant buffer
-	psConstantBuffer = new CD3D11ConstantBuffer( GConstantBufferSizes[ SOB_ShaderConstants ], TEXT( "ShaderConstantBuffer" ) );
-	{
-		ID3D11Buffer*		d3d11ConstantBuffer = psConstantBuffer->GetD3D11Buffer();
-		d3d11DeviceContext->PSSetConstantBuffers( SOB_ShaderConstants, 1, &d3d11ConstantBuffer );
-	}
+	// Immediate context creates and binds own constant buffers for shaders
+	immediateContext = new CD3D11DeviceContext( d3d11DeviceContext );
 
 	// Print info adapter
 	DXGI_ADAPTER_DESC				adapterDesc;
@@ -411,6 +386,12 @@ void CD3D11RHI::Init( bool InIsEditor )
 			adapterDesc.DedicatedSystemMemory / ( 1024 * 1024 ),
 			adapterDesc.SharedSystemMemory / ( 1024 * 1024 ) );
 
+	// Without driver support of command lists D3D11 runtime emulates them, it still works but parallel recording gives less profit
+	D3D11_FEATURE_DATA_THREADING	threadingCaps;
+	appMemzero( &threadingCaps, sizeof( D3D11_FEATURE_DATA_THREADING ) );
+	d3d11Device->CheckFeatureSupport( D3D11_FEATURE_THREADING, &threadingCaps, sizeof( D3D11_FEATURE_DATA_THREADING ) );
+	LE_LOG( LT_Log, LC_Init, TEXT( "Driver command lists: %s" ), threadingCaps.DriverCommandLists ? TEXT( "true" ) : TEXT( "false" ) );
+
 	// Initialize the platform pixel format map
 	INIT_FORMAT( PF_A8R8G8B8,				DXGI_FORMAT_R8G8B8A8_UNORM );	
 	INIT_FORMAT_FULL( PF_DepthStencil,		DXGI_FORMAT_R32G8X24_TYPELESS, 8 );
@@ -428,6 +409,14 @@ void CD3D11RHI::Init( bool InIsEditor )
 	INIT_FORMAT( PF_BC7,					DXGI_FORMAT_BC7_UNORM );
 
 	INIT_UNSUPPORTED_FORMAT( PF_Unknown );
+
+#if FRAME_CAPTURE_MARKERS
+	// Emit draw events only when GPU debugger is attached (e.g. RenderDoc, PIX) or it forced from command line,
+	// otherwise formatting of event names is wasted time
+	GEmitDrawEvents = D3DPERF_GetStatus() != 0 || GCommandLine.HasParam( TEXT( "emitdrawevents" ) );
+	LE_LOG( LT_Log, LC_Init, TEXT( "Emit draw events: %s" ), GEmitDrawEvents ? TEXT( "true" ) : TEXT( "false" ) );
+#endif // FRAME_CAPTURE_MARKERS
+
 	isInitialize = true;
 
 	// Initialize all global render resources
@@ -473,32 +462,16 @@ void CD3D11RHI::Destroy()
 		( *it )->ReleaseResource();
 	}
 
-	for ( uint32 index = 0, num = ARRAY_COUNT( vsConstantBuffers ); index < num; ++index )
-	{
-		CD3D11ConstantBuffer*		constantBuffer = vsConstantBuffers[ index ];
-		if ( constantBuffer )
-		{
-			delete constantBuffer;
-		}
-	}
-
-	delete globalConstantBuffer;
-	delete psConstantBuffer;
 	delete immediateContext;
 	d3d11Device->Release();
 	dxgiAdapter->Release();
 	dxgiFactory->Release();
 
 	isInitialize = false;
-	globalConstantBuffer = nullptr;
-	psConstantBuffer = nullptr;
 	immediateContext = nullptr;
 	d3d11Device = nullptr;
 	dxgiAdapter = nullptr;
 	dxgiFactory = nullptr;
-
-	appMemzero( &stateCache, sizeof( SD3D11StateCache ) );
-	appMemzero( vsConstantBuffers, sizeof( vsConstantBuffers ) );
 }
 
 /**
@@ -581,10 +554,16 @@ VertexDeclarationRHIRef_t CD3D11RHI::CreateVertexDeclaration( const VertexDeclar
 /**
  * Create bound shader state
  */
-BoundShaderStateRHIRef_t CD3D11RHI::CreateBoundShaderState( const tchar* InBoundShaderStateName, VertexDeclarationRHIRef_t InVertexDeclaration, VertexShaderRHIRef_t InVertexShader, PixelShaderRHIRef_t InPixelShader, HullShaderRHIRef_t InHullShader /*= nullptr*/, DomainShaderRHIRef_t InDomainShader /*= nullptr*/, GeometryShaderRHIRef_t InGeometryShader /*= nullptr*/ )
+BoundShaderStateRHIRef_t CD3D11RHI::CreateBoundShaderState( const tchar* InBoundShaderStateName, VertexDeclarationRHIRef_t InVertexDeclaration, VertexShaderRHIRef_t InVertexShader, PixelShaderRHIRef_t InPixelShader, HullShaderRHIRef_t InHullShader /*= nullptr*/, DomainShaderRHIRef_t InDomainShader /*= nullptr*/, GeometryShaderRHIRef_t InGeometryShader /*= nullptr*/, bool* OutIsCreated /*= nullptr*/ )
 {
 	CBoundShaderStateKey		key( InVertexDeclaration, InVertexShader, InPixelShader, InHullShader, InDomainShader, InGeometryShader );
+	CScopeLock					scopeLock( boundShaderStateHistory.GetCriticalSection() );
 	BoundShaderStateRHIRef_t		boundShaderStateRHI = boundShaderStateHistory.Find( key );
+	if ( OutIsCreated )
+	{
+		*OutIsCreated = !boundShaderStateRHI;
+	}
+
 	if ( !boundShaderStateRHI )
 	{
 		boundShaderStateRHI = new CD3D11BoundShaderStateRHI( InBoundShaderStateName, key, InVertexDeclaration, InVertexShader, InPixelShader, InHullShader, InDomainShader, InGeometryShader );
@@ -643,16 +622,17 @@ class CBaseDeviceContextRHI* CD3D11RHI::GetImmediateContext() const
 
 uint32 CD3D11RHI::GetViewportWidth() const
 {
-	return stateCache.viewport.Width;
+	return immediateContext->GetStateCache().viewport.Width;
 }
 
 uint32 CD3D11RHI::GetViewportHeight() const
 {
-	return stateCache.viewport.Height;
+	return immediateContext->GetStateCache().viewport.Height;
 }
 
 void CD3D11RHI::SetupInstancing( class CBaseDeviceContextRHI* InDeviceContext, uint32 InStreamIndex, void* InInstanceData, uint32 InInstanceStride, uint32 InInstanceSize, uint32 InNumInstances )
 {
+	TRefCountPtr< CD3D11VertexBufferRHI >&		instanceBuffer = ( ( CD3D11DeviceContext* )InDeviceContext )->GetInstanceBuffer();
 	if ( !instanceBuffer || instanceBuffer->GetSize() < InInstanceSize )
 	{
 		instanceBuffer = new CD3D11VertexBufferRHI( RUF_Dynamic, InInstanceSize, ( byte* )InInstanceData, TEXT( "Instance" ) );
@@ -673,6 +653,7 @@ void CD3D11RHI::SetupInstancing( class CBaseDeviceContextRHI* InDeviceContext, u
  */
 void CD3D11RHI::SetViewport( class CBaseDeviceContextRHI* InDeviceContext, uint32 InMinX, uint32 InMinY, float InMinZ, uint32 InMaxX, uint32 InMaxY, float InMaxZ )
 {
+	SD3D11StateCache&		stateCache = ( ( CD3D11DeviceContext* )InDeviceContext )->GetStateCache();
 	D3D11_VIEWPORT			d3d11Viewport = { ( float )InMinX, ( float )InMinY, ( float )InMaxX - InMinX, ( float )InMaxY - InMinY, ( float )InMinZ, InMaxZ };
 	if ( d3d11Viewport.Width > 0 && d3d11Viewport.Height > 0 && d3d11Viewport != stateCache.viewport )
 	{
@@ -687,6 +668,7 @@ void CD3D11RHI::SetViewport( class CBaseDeviceContextRHI* InDeviceContext, uint3
 void CD3D11RHI::SetBoundShaderState( class CBaseDeviceContextRHI* InDeviceContext, BoundShaderStateRHIParamRef_t InBoundShaderState )
 {
 	ID3D11DeviceContext*			d3d11DeviceContext = ( ( CD3D11DeviceContext* )InDeviceContext )->GetD3D11DeviceContext();
+	SD3D11StateCache&				stateCache = ( ( CD3D11DeviceContext* )InDeviceContext )->GetStateCache();
 	CD3D11BoundShaderStateRHI*		boundShaderState = ( CD3D11BoundShaderStateRHI* )InBoundShaderState;
 
 	// Bind input layout
@@ -761,6 +743,7 @@ void CD3D11RHI::SetBoundShaderState( class CBaseDeviceContextRHI* InDeviceContex
 void CD3D11RHI::SetStreamSource( class CBaseDeviceContextRHI* InDeviceContext, uint32 InStreamIndex, VertexBufferRHIParamRef_t InVertexBuffer, uint32 InStride, uint32 InOffset )
 {
 	ID3D11DeviceContext*			d3d11DeviceContext		= ( ( CD3D11DeviceContext* )InDeviceContext )->GetD3D11DeviceContext();
+	SD3D11StateCache&				stateCache = ( ( CD3D11DeviceContext* )InDeviceContext )->GetStateCache();
 	ID3D11Buffer*					d3d11Buffer				= InVertexBuffer ? ( ( CD3D11VertexBufferRHI* )InVertexBuffer )->GetD3D11Buffer() : nullptr;
 	CD3D11StateVertexBuffer			stateVertexBuffer		= { d3d11Buffer, InStride, InOffset };
 
@@ -777,6 +760,7 @@ void CD3D11RHI::SetStreamSource( class CBaseDeviceContextRHI* InDeviceContext, u
 void CD3D11RHI::SetRasterizerState( class CBaseDeviceContextRHI* InDeviceContext, RasterizerStateRHIParamRef_t InNewState )
 {
 	ID3D11DeviceContext*			d3d11DeviceContext		= ( ( CD3D11DeviceContext* )InDeviceContext )->GetD3D11DeviceContext();
+	SD3D11StateCache&				stateCache = ( ( CD3D11DeviceContext* )InDeviceContext )->GetStateCache();
 	ID3D11RasterizerState*			d3d11RasterizerState	= InNewState ? ( ( CD3D11RasterizerStateRHI* )InNewState )->GetResource() : nullptr;
 
 	if ( d3d11RasterizerState != stateCache.rasterizerState )
@@ -789,6 +773,7 @@ void CD3D11RHI::SetRasterizerState( class CBaseDeviceContextRHI* InDeviceContext
 void CD3D11RHI::SetSamplerState( class CBaseDeviceContextRHI* InDeviceContext, PixelShaderRHIParamRef_t InPixelShader, SamplerStateRHIParamRef_t InNewState, uint32 InStateIndex )
 {
 	ID3D11DeviceContext*			d3d11DeviceContext		= ( ( CD3D11DeviceContext* )InDeviceContext )->GetD3D11DeviceContext();
+	SD3D11StateCache&				stateCache = ( ( CD3D11DeviceContext* )InDeviceContext )->GetStateCache();
 	ID3D11SamplerState*				d3d11SamplerState		= InNewState ? ( ( CD3D11SamplerStateRHI* )InNewState )->GetResource() : nullptr;
 	
 	if ( d3d11SamplerState != stateCache.psSamplerStates[ InStateIndex ] )
@@ -801,6 +786,7 @@ void CD3D11RHI::SetSamplerState( class CBaseDeviceContextRHI* InDeviceContext, P
 void CD3D11RHI::SetTextureParameter( class CBaseDeviceContextRHI* InDeviceContext, PixelShaderRHIParamRef_t InPixelShader, TextureRHIParamRef_t InTexture, uint32 InTextureIndex )
 {
 	ID3D11DeviceContext*			d3d11DeviceContext = ( ( CD3D11DeviceContext* ) InDeviceContext )->GetD3D11DeviceContext();
+	SD3D11StateCache&				stateCache = ( ( CD3D11DeviceContext* )InDeviceContext )->GetStateCache();
 	ID3D11ShaderResourceView*		d3d11ShaderResourceView = InTexture ? ( ( CD3D11TextureRHI* )InTexture )->GetShaderResourceView() : nullptr;		// BS yehor.pohuliaka - Nullptr shader resource view is probably a code mistake
 
 	if ( d3d11ShaderResourceView != stateCache.psShaderResourceViews[ InTextureIndex ] )
@@ -817,23 +803,25 @@ void CD3D11RHI::SetViewParameters( class CBaseDeviceContextRHI* InDeviceContext,
 	SGlobalConstantBufferContents			globalContents;
 	SetGlobalConstants( globalContents, InSceneView, Vector4D( InSceneView.GetSizeX(), InSceneView.GetSizeY(), GSceneRenderTargets.GetBufferWidth(), GSceneRenderTargets.GetBufferHeight() ) );
 
-	globalConstantBuffer->Update( ( byte* ) &globalContents, 0, sizeof( globalContents ) );
-	globalConstantBuffer->CommitConstantsToDevice( ( CD3D11DeviceContext* )InDeviceContext );
+	CD3D11DeviceContext*		deviceContext = ( CD3D11DeviceContext* )InDeviceContext;
+	deviceContext->GetGlobalConstantBuffer()->Update( ( byte* ) &globalContents, 0, sizeof( globalContents ) );
+	deviceContext->GetGlobalConstantBuffer()->CommitConstantsToDevice( deviceContext );
 }
 
 void CD3D11RHI::SetVertexShaderParameter( class CBaseDeviceContextRHI* InDeviceContext, uint32 InBufferIndex, uint32 InBaseIndex, uint32 InNumBytes, const void* InNewValue )
 {
-	vsConstantBuffers[ InBufferIndex ]->Update( ( const byte* )InNewValue, InBaseIndex, InNumBytes );
+	( ( CD3D11DeviceContext* )InDeviceContext )->GetVSConstantBuffer( InBufferIndex )->Update( ( const byte* )InNewValue, InBaseIndex, InNumBytes );
 }
 
 void CD3D11RHI::SetPixelShaderParameter( class CBaseDeviceContextRHI* InDeviceContext, uint32 InBufferIndex, uint32 InBaseIndex, uint32 InNumBytes, const void* InNewValue )
 {
-	psConstantBuffer->Update( ( const byte* )InNewValue, InBaseIndex, InNumBytes );
+	( ( CD3D11DeviceContext* )InDeviceContext )->GetPSConstantBuffer()->Update( ( const byte* )InNewValue, InBaseIndex, InNumBytes );
 }
 
 void CD3D11RHI::SetDepthState( class CBaseDeviceContextRHI* InDeviceContext, DepthStateRHIParamRef_t InNewState )
 {
 	ID3D11DeviceContext*			d3d11DeviceContext	= ( ( CD3D11DeviceContext* )InDeviceContext )->GetD3D11DeviceContext();
+	SD3D11StateCache&				stateCache = ( ( CD3D11DeviceContext* )InDeviceContext )->GetStateCache();
 	ID3D11DepthStencilState*		d3d11DepthState		= InNewState ? ( ( CD3D11DepthStateRHI* )InNewState )->GetResource() : nullptr;
 
 	if ( d3d11DepthState != stateCache.depthStencilState )
@@ -850,6 +838,7 @@ void CD3D11RHI::SetDepthState( class CBaseDeviceContextRHI* InDeviceContext, Dep
 void CD3D11RHI::SetBlendState( class CBaseDeviceContextRHI* InDeviceContext, BlendStateRHIParamRef_t InNewState )
 {
 	ID3D11DeviceContext*			d3d11DeviceContext = ( ( CD3D11DeviceContext* )InDeviceContext )->GetD3D11DeviceContext();
+	SD3D11StateCache&				stateCache = ( ( CD3D11DeviceContext* )InDeviceContext )->GetStateCache();
 	ID3D11BlendState*				d3d11BlendState = InNewState ? ( ( CD3D11BlendStateRHI* )InNewState )->GetResource() : nullptr;
 
 	if ( d3d11BlendState != stateCache.blendState )
@@ -867,18 +856,7 @@ void CD3D11RHI::SetStencilState( class CBaseDeviceContextRHI* InDeviceContext, S
 
 void CD3D11RHI::CommitConstants( class CBaseDeviceContextRHI* InDeviceContext )
 {
-	// Commit vertex shader constants
-	for ( uint32 index = 0, num = ARRAY_COUNT( vsConstantBuffers ); index < num; ++index )
-	{
-		CD3D11ConstantBuffer*		constantBuffer = vsConstantBuffers[ index ];
-		if ( constantBuffer )
-		{
-			constantBuffer->CommitConstantsToDevice( ( CD3D11DeviceContext* )InDeviceContext );
-		}
-	}
-
-	// Commit pixel shader constants
-	psConstantBuffer->CommitConstantsToDevice( ( CD3D11DeviceContext* )InDeviceContext );
+	( ( CD3D11DeviceContext* )InDeviceContext )->CommitConstants();
 }
 
 /**
@@ -951,6 +929,7 @@ void CD3D11RHI::UnlockTexture2D( class CBaseDeviceContextRHI* InDeviceContext, T
 void CD3D11RHI::DrawPrimitive( class CBaseDeviceContextRHI* InDeviceContext, EPrimitiveType InPrimitiveType, uint32 InBaseVertexIndex, uint32 InNumPrimitives, uint32 InNumInstances /* = 1 */ )
 {
 	ID3D11DeviceContext*			d3d11DeviceContext = ( ( CD3D11DeviceContext* )InDeviceContext )->GetD3D11DeviceContext();
+	SD3D11StateCache&				stateCache = ( ( CD3D11DeviceContext* )InDeviceContext )->GetStateCache();
 	uint32							vertexCount = GetVertexCountForPrimitiveCount( InNumPrimitives, InPrimitiveType );
 
 	// Set primitive topology
@@ -978,6 +957,7 @@ void CD3D11RHI::DrawIndexedPrimitive( class CBaseDeviceContextRHI* InDeviceConte
 {
 	check( InIndexBuffer );
 	ID3D11DeviceContext*			d3d11DeviceContext = ( ( CD3D11DeviceContext* )InDeviceContext )->GetD3D11DeviceContext();
+	SD3D11StateCache&				stateCache = ( ( CD3D11DeviceContext* )InDeviceContext )->GetStateCache();
 	CD3D11IndexBufferRHI*			indexBuffer = ( CD3D11IndexBufferRHI* )InIndexBuffer;
 
 	// Bind index buffer
@@ -1109,6 +1089,25 @@ void CD3D11RHI::CopyToResolveTarget( class CBaseDeviceContextRHI* InDeviceContex
 	}
 }
 
+void CD3D11RHI::CopySharedMips( class CBaseDeviceContextRHI* InDeviceContext, Texture2DRHIParamRef_t InDestTexture, Texture2DRHIParamRef_t InSourceTexture )
+{
+	check( InDestTexture && InSourceTexture && InDestTexture->GetFormat() == InSourceTexture->GetFormat() );
+	ID3D11DeviceContext*	d3d11DeviceContext	= ( ( CD3D11DeviceContext* )InDeviceContext )->GetD3D11DeviceContext();
+	ID3D11Texture2D*		d3d11DestTexture	= ( ( CD3D11Texture2DRHI* )InDestTexture )->GetResource();
+	ID3D11Texture2D*		d3d11SourceTexture	= ( ( CD3D11Texture2DRHI* )InSourceTexture )->GetResource();
+
+	// Mip chains of both textures end on the same mip, so the shared mips are the last ones
+	const uint32			destNumMips			= InDestTexture->GetNumMips();
+	const uint32			sourceNumMips		= InSourceTexture->GetNumMips();
+	const uint32			numSharedMips		= Min( destNumMips, sourceNumMips );
+	for ( uint32 index = 0; index < numSharedMips; ++index )
+	{
+		const uint32		destMip		= destNumMips - numSharedMips + index;
+		const uint32		sourceMip	= sourceNumMips - numSharedMips + index;
+		d3d11DeviceContext->CopySubresourceRegion( d3d11DestTexture, D3D11CalcSubresource( destMip, 0, destNumMips ), 0, 0, 0, d3d11SourceTexture, D3D11CalcSubresource( sourceMip, 0, sourceNumMips ), nullptr );
+	}
+}
+
 /**
  * Begin drawing viewport
  */
@@ -1124,7 +1123,8 @@ void CD3D11RHI::BeginDrawingViewport( class CBaseDeviceContextRHI* InDeviceConte
 #endif // FRAME_CAPTURE_MARKERS
 
 	// Clear state cache
-	appMemzero( &stateCache, sizeof( SD3D11StateCache ) );
+	appMemzero( &deviceContext->GetStateCache(), sizeof( SD3D11StateCache ) );
+	InDeviceContext->InvalidateStateCache();
 
 	SetRenderTarget( InDeviceContext, viewport->GetSurface(), nullptr );
 	SetViewport( InDeviceContext, 0, 0, 0.f, viewport->GetWidth(), viewport->GetHeight(), 1.f );
@@ -1136,6 +1136,7 @@ void CD3D11RHI::SetRenderTarget( class CBaseDeviceContextRHI* InDeviceContext, S
 	CD3D11DeviceContext*			deviceContext				= ( CD3D11DeviceContext* )InDeviceContext;
 	CD3D11Surface*					renderTarget				= ( CD3D11Surface* )InNewRenderTarget;
 	CD3D11Surface*					depthStencilTarget			= ( CD3D11Surface* )InNewDepthStencilTarget;
+	SD3D11StateCache&				stateCache					= deviceContext->GetStateCache();
 
 	// Set render target
 	{
@@ -1156,6 +1157,7 @@ void CD3D11RHI::SetMRTRenderTarget( class CBaseDeviceContextRHI* InDeviceContext
 	check( InDeviceContext && InTargetIndex < D3D11_SIMULTANEOUS_RENDER_TARGET_COUNT );
 	CD3D11DeviceContext*	deviceContext	= ( CD3D11DeviceContext* )InDeviceContext;
 	CD3D11Surface*			renderTarget	= ( CD3D11Surface* )InNewRenderTarget;
+	SD3D11StateCache&		stateCache		= deviceContext->GetStateCache();
 
 	// Set render target
 	{
@@ -1185,6 +1187,39 @@ void CD3D11RHI::EndDrawingViewport( class CBaseDeviceContextRHI* InDeviceContext
 	}
 }
 
+CommandListRHIRef_t CD3D11RHI::CreateCommandList()
+{
+	ID3D11DeviceContext*		d3d11DeferredContext = nullptr;
+	HRESULT						result = d3d11Device->CreateDeferredContext( 0, &d3d11DeferredContext );
+	if ( FAILED( result ) )
+	{
+		LE_LOG( LT_Warning, LC_Dev, TEXT( "Failed to create D3D11 deferred context (0x%X)" ), result );
+		return nullptr;
+	}
+
+	return new CD3D11CommandListRHI( new CD3D11DeviceContext( d3d11DeferredContext ) );
+}
+
+void CD3D11RHI::BeginCommandList( class CBaseDeviceContextRHI* InImmediateContext, CommandListRHIParamRef_t InCommandList )
+{
+	check( InImmediateContext && InCommandList );
+	CD3D11DeviceContext*		deferredContext = ( ( CD3D11CommandListRHI* )InCommandList )->GetD3D11DeferredContext();
+	deferredContext->InheritState( *( CD3D11DeviceContext* )InImmediateContext );
+	deferredContext->InvalidateStateCache();
+}
+
+void CD3D11RHI::EndCommandList( CommandListRHIParamRef_t InCommandList )
+{
+	check( InCommandList );
+	( ( CD3D11CommandListRHI* )InCommandList )->Finish();
+}
+
+void CD3D11RHI::ExecuteCommandList( class CBaseDeviceContextRHI* InImmediateContext, CommandListRHIParamRef_t InCommandList )
+{
+	check( InImmediateContext && InCommandList );
+	( ( CD3D11CommandListRHI* )InCommandList )->Execute( ( CD3D11DeviceContext* )InImmediateContext );
+}
+
 #if WITH_EDITOR
 #include <d3dcompiler.h>
 #include <string>
@@ -160,6 +160,14 @@ CD3D11Texture2DRHI::CD3D11Texture2DRHI( const tchar* InDebugName, uint32 InSizeX
 	d3d11Texture2DDesc.CPUAccessFlags		= 0;
 	d3d11Texture2DDesc.MiscFlags			= 0;
 
+	// Dynamic texture is mapped with discard on each update, so driver doesn't wait GPU and copy is not needed
+	if ( InFlags & TCF_Dynamic )
+	{
+		checkMsg( InNumMips == 1 && !( InFlags & ( TCF_DepthStencil | TCF_ResolveTargetable ) ), TEXT( "Dynamic texture must have one mip and can't be render target" ) );
+		d3d11Texture2DDesc.Usage			= D3D11_USAGE_DYNAMIC;
+		d3d11Texture2DDesc.CPUAccessFlags	= D3D11_CPU_ACCESS_WRITE;
+	}
+
 	if ( InFlags & TCF_DepthStencil )
 	{
 		d3d11Texture2DDesc.BindFlags |= D3D11_BIND_DEPTH_STENCIL;
@@ -189,9 +197,9 @@ CD3D11Texture2DRHI::CD3D11Texture2DRHI( const tchar* InDebugName, uint32 InSizeX
 		for ( uint32 mipIndex = 0; mipIndex < numMips; ++mipIndex )
 		{
 			uint32		mipSizeX	= Max< uint32 >( InSizeX >> mipIndex, GPixelFormats[ InFormat ].blockSizeX );
-			uint32		pitch		= ( mipSizeX / GPixelFormats[ InFormat ].blockSizeX ) * GPixelFormats[ InFormat ].blockBytes;
+			uint32		pitch		= ( ( mipSizeX + GPixelFormats[ InFormat ].blockSizeX - 1 ) / GPixelFormats[ InFormat ].blockSizeX ) * GPixelFormats[ InFormat ].blockBytes;
 			uint32		mipSizeY	= Max< uint32 >( InSizeY >> mipIndex, GPixelFormats[ InFormat ].blockSizeY );
-			uint32		numRows		= mipSizeY / GPixelFormats[ InFormat ].blockSizeY;
+			uint32		numRows		= ( mipSizeY + GPixelFormats[ InFormat ].blockSizeY - 1 ) / GPixelFormats[ InFormat ].blockSizeY;
 
 			D3D11_SUBRESOURCE_DATA&		d3d11SubresourceData = subResourceData[ mipIndex ];
 			d3d11SubresourceData.pSysMem = data + offset;
@@ -304,7 +312,25 @@ void CD3D11Texture2DRHI::Lock( CBaseDeviceContextRHI* InDeviceContext, uint32 In
 	const uint32 numBlocksY			= ( mipSizeY + blockSizeY - 1 ) / blockSizeY;
 	const uint32 mipBytes			= numBlocksX * numBlocksY * blockBytes;
 
-	if ( InIsDataWrite && !( flags & TCF_Dynamic ) )
+	if ( InIsDataWrite && ( flags & TCF_Dynamic ) )
+	{
+		// Dynamic texture is mapped directly, old content is discarded and driver gives new memory for it
+		ID3D11DeviceContext*			d3d11DeviceContext = ( ( CD3D11DeviceContext* )InDeviceContext )->GetD3D11DeviceContext();
+		D3D11_MAPPED_SUBRESOURCE		d3d11MappedTexture2D;
+
+#if DO_CHECK
+		HRESULT							result = d3d11DeviceContext->Map( d3d11Texture2D, D3D11CalcSubresource( InMipIndex, 0, numMips ), D3D11_MAP_WRITE_DISCARD, 0, &d3d11MappedTexture2D );
+		check( result == S_OK );
+#else
+		d3d11DeviceContext->Map( d3d11Texture2D, D3D11CalcSubresource( InMipIndex, 0, numMips ), D3D11_MAP_WRITE_DISCARD, 0, &d3d11MappedTexture2D );
+#endif // DO_CHECK
+
+		OutLockedData.data = ( byte* )d3d11MappedTexture2D.pData;
+		OutLockedData.pitch = d3d11MappedTexture2D.RowPitch;
+		OutLockedData.size = mipBytes;
+		OutLockedData.isNeedFree = false;
+	}
+	else if ( InIsDataWrite )
 	{
 		// If we're writing to the texture, allocate a system memory buffer to receive the new contents.
 		OutLockedData.data = new byte[ mipBytes ];
@@ -345,7 +371,16 @@ void CD3D11Texture2DRHI::Lock( CBaseDeviceContextRHI* InDeviceContext, uint32 In
 
 void CD3D11Texture2DRHI::Unlock( CBaseDeviceContextRHI* InDeviceContext, uint32 InMipIndex, SLockedData& InLockedData, bool InDiscardUpdate /*= false*/ )
 {
-	bool			isNeedUpdate = ( !InLockedData.stagingResource.IsValid() || flags & TCF_Dynamic ) && !InDiscardUpdate;
+	if ( ( flags & TCF_Dynamic ) && !InLockedData.stagingResource.IsValid() )
+	{
+		// Dynamic texture was mapped directly in Lock
+		ID3D11DeviceContext*			d3d11DeviceContext = ( ( CD3D11DeviceContext* )InDeviceContext )->GetD3D11DeviceContext();
+		d3d11DeviceContext->Unmap( d3d11Texture2D, D3D11CalcSubresource( InMipIndex, 0, numMips ) );
+		InLockedData.data = nullptr;
+		return;
+	}
+
+	bool			isNeedUpdate = !InLockedData.stagingResource.IsValid() && !InDiscardUpdate;
 	if ( isNeedUpdate )
 	{
 		// Calculate the subresource index corresponding to the specified mip-map
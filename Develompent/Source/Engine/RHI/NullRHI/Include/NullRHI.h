@@ -0,0 +1,905 @@
+/**
+ * @file
+ * @addtogroup NullRHI NullRHI
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef NULLRHI_H
+#define NULLRHI_H
+
+#include "Misc/Types.h"
+#include "Misc/Misc.h"
+#include "Render/BoundShaderStateCache.h"
+#include "RHI/BaseRHI.h"
+#include "NullResources.h"
+
+/**
+ * @ingroup NullRHI
+ * @brief Enumeration of instrumented calls of null RHI
+ */
+enum ENullRHICall
+{
+	NRC_CreateViewport,				/**< CreateViewport */
+	NRC_CreateShader,				/**< CreateVertexShader, CreatePixelShader, etc */
+	NRC_CreateVertexBuffer,			/**< CreateVertexBuffer */
+	NRC_CreateIndexBuffer,			/**< CreateIndexBuffer */
+	NRC_CreateVertexDeclaration,	/**< CreateVertexDeclaration */
+	NRC_CreateBoundShaderState,		/**< CreateBoundShaderState */
+	NRC_CreateState,				/**< CreateRasterizerState, CreateSamplerState, etc */
+	NRC_CreateTexture2D,			/**< CreateTexture2D */
+	NRC_CreateTargetableSurface,	/**< CreateTargetableSurface */
+	NRC_BeginDrawingViewport,		/**< BeginDrawingViewport */
+	NRC_EndDrawingViewport,			/**< EndDrawingViewport */
+	NRC_DrawEvent,					/**< BeginDrawEvent and EndDrawEvent */
+	NRC_ClearSurface,				/**< ClearSurface and ClearDepthStencil */
+	NRC_SetupInstancing,			/**< SetupInstancing */
+	NRC_SetViewport,				/**< SetViewport */
+	NRC_SetBoundShaderState,		/**< SetBoundShaderState */
+	NRC_SetStreamSource,			/**< SetStreamSource */
+	NRC_SetRasterizerState,			/**< SetRasterizerState */
+	NRC_SetSamplerState,			/**< SetSamplerState */
+	NRC_SetTextureParameter,		/**< SetTextureParameter */
+	NRC_SetViewParameters,			/**< SetViewParameters */
+	NRC_SetRenderTarget,			/**< SetRenderTarget and SetMRTRenderTarget */
+	NRC_SetShaderParameter,			/**< SetVertexShaderParameter and SetPixelShaderParameter */
+	NRC_SetDepthState,				/**< SetDepthState */
+	NRC_SetBlendState,				/**< SetBlendState */
+	NRC_SetStencilState,			/**< SetStencilState */
+	NRC_CommitConstants,			/**< CommitConstants */
+	NRC_LockBuffer,					/**< LockVertexBuffer and LockIndexBuffer */
+	NRC_UnlockBuffer,				/**< UnlockVertexBuffer and UnlockIndexBuffer */
+	NRC_LockTexture2D,				/**< LockTexture2D */
+	NRC_UnlockTexture2D,			/**< UnlockTexture2D */
+	NRC_DrawPrimitive,				/**< DrawPrimitive and DrawPrimitiveUP */
+	NRC_DrawIndexedPrimitive,		/**< DrawIndexedPrimitive and DrawIndexedPrimitiveUP */
+	NRC_CopyToResolveTarget,		/**< CopyToResolveTarget */
+	NRC_CopySharedMips,				/**< CopySharedMips */
+	NRC_DrawImGUI,					/**< DrawImGUI */
+	NRC_Num							/**< Number of instrumented calls */
+};
+
+/**
+ * @ingroup NullRHI
+ * @brief Convert ENullRHICall to text
+ *
+ * @param InCall	Call
+ * @return Return name of call
+ */
+FORCEINLINE const tchar* NullRHICallToText( ENullRHICall InCall )
+{
+	switch ( InCall )
+	{
+	case NRC_CreateViewport:			return TEXT( "CreateViewport" );
+	case NRC_CreateShader:				return TEXT( "CreateShader" );
+	case NRC_CreateVertexBuffer:		return TEXT( "CreateVertexBuffer" );
+	case NRC_CreateIndexBuffer:			return TEXT( "CreateIndexBuffer" );
+	case NRC_CreateVertexDeclaration:	return TEXT( "CreateVertexDeclaration" );
+	case NRC_CreateBoundShaderState:	return TEXT( "CreateBoundShaderState" );
+	case NRC_CreateState:				return TEXT( "CreateState" );
+	case NRC_CreateTexture2D:			return TEXT( "CreateTexture2D" );
+	case NRC_CreateTargetableSurface:	return TEXT( "CreateTargetableSurface" );
+	case NRC_BeginDrawingViewport:		return TEXT( "BeginDrawingViewport" );
+	case NRC_EndDrawingViewport:		return TEXT( "EndDrawingViewport" );
+	case NRC_DrawEvent:					return TEXT( "DrawEvent" );
+	case NRC_ClearSurface:				return TEXT( "ClearSurface" );
+	case NRC_SetupInstancing:			return TEXT( "SetupInstancing" );
+	case NRC_SetViewport:				return TEXT( "SetViewport" );
+	case NRC_SetBoundShaderState:		return TEXT( "SetBoundShaderState" );
+	case NRC_SetStreamSource:			return TEXT( "SetStreamSource" );
+	case NRC_SetRasterizerState:		return TEXT( "SetRasterizerState" );
+	case NRC_SetSamplerState:			return TEXT( "SetSamplerState" );
+	case NRC_SetTextureParameter:		return TEXT( "SetTextureParameter" );
+	case NRC_SetViewParameters:			return TEXT( "SetViewParameters" );
+	case NRC_SetRenderTarget:			return TEXT( "SetRenderTarget" );
+	case NRC_SetShaderParameter:		return TEXT( "SetShaderParameter" );
+	case NRC_SetDepthState:				return TEXT( "SetDepthState" );
+	case NRC_SetBlendState:				return TEXT( "SetBlendState" );
+	case NRC_SetStencilState:			return TEXT( "SetStencilState" );
+	case NRC_CommitConstants:			return TEXT( "CommitConstants" );
+	case NRC_LockBuffer:				return TEXT( "LockBuffer" );
+	case NRC_UnlockBuffer:				return TEXT( "UnlockBuffer" );
+	case NRC_LockTexture2D:				return TEXT( "LockTexture2D" );
+	case NRC_UnlockTexture2D:			return TEXT( "UnlockTexture2D" );
+	case NRC_DrawPrimitive:				return TEXT( "DrawPrimitive" );
+	case NRC_DrawIndexedPrimitive:		return TEXT( "DrawIndexedPrimitive" );
+	case NRC_CopyToResolveTarget:		return TEXT( "CopyToResolveTarget" );
+	case NRC_CopySharedMips:			return TEXT( "CopySharedMips" );
+	case NRC_DrawImGUI:					return TEXT( "DrawImGUI" );
+	default:							return TEXT( "Unknown" );
+	}
+}
+
+/**
+ * @ingroup NullRHI
+ * @brief Statistics of null RHI for one frame
+ */
+struct SNullRHIFrameStats
+{
+	/**
+	 * @brief Constructor
+	 */
+	FORCEINLINE SNullRHIFrameStats()
+	{
+		Reset();
+	}
+
+	/**
+	 * @brief Reset statistics
+	 */
+	FORCEINLINE void Reset()
+	{
+		appMemzero( this, sizeof( SNullRHIFrameStats ) );
+	}
+
+	uint32		numCalls[ NRC_Num ];		/**< Number of calls */
+	uint32		numDrawCalls;				/**< Number of draw calls */
+	uint64		numPrimitives;				/**< Number of drawn primitives (with instances) */
+	uint32		numStateChanges;			/**< Number of state sets which changed state */
+	uint32		numRedundantStateSets;		/**< Number of state sets which set same state */
+	uint64		bytesUploaded;				/**< Bytes uploaded to buffers and textures */
+	uint64		bytesConstants;				/**< Bytes of shader parameters */
+	uint32		numConstantBufferCommits;	/**< Number of constant buffers committed to device */
+	uint64		bytesConstantsRing;			/**< Bytes of constants written into constant buffer ring (only used range of buffers) */
+	uint64		bytesConstantsRewrite;		/**< Bytes of constants written into constant buffer ring again after its discard (included in bytesConstantsRing) */
+	uint32		numConstantBufferRingDiscards;	/**< Number of constant buffer ring discards */
+	uint64		bytesConstantsFull;			/**< Bytes of constants uploaded without constant buffer ring (whole buffers) */
+};
+
+/**
+ * @ingroup NullRHI
+ * @brief Statistics of null RHI
+ */
+struct SNullRHIStats
+{
+	/**
+	 * @brief Constructor
+	 */
+	FORCEINLINE SNullRHIStats()
+	{
+		Reset();
+	}
+
+	/**
+	 * @brief Reset statistics
+	 */
+	FORCEINLINE void Reset()
+	{
+		appMemzero( numCalls, sizeof( numCalls ) );
+		appMemzero( callSeconds, sizeof( callSeconds ) );
+		currentFrame.Reset();
+		lastFrame.Reset();
+		numFrames		= 0;
+		bytesUploaded	= 0;
+	}
+
+	/**
+	 * @brief Add call
+	 *
+	 * @param InCall		Call
+	 * @param InSeconds		Time of call in seconds
+	 */
+	FORCEINLINE void AddCall( ENullRHICall InCall, double InSeconds )
+	{
+		++numCalls[ InCall ];
+		++currentFrame.numCalls[ InCall ];
+		callSeconds[ InCall ] += InSeconds;
+	}
+
+	/**
+	 * @brief Add uploaded bytes
+	 * @param InBytes	Number of bytes
+	 */
+	FORCEINLINE void AddUploadedBytes( uint64 InBytes )
+	{
+		bytesUploaded				+= InBytes;
+		currentFrame.bytesUploaded	+= InBytes;
+	}
+
+	/**
+	 * @brief End frame
+	 */
+	FORCEINLINE void EndFrame()
+	{
+		lastFrame = currentFrame;
+		currentFrame.Reset();
+		++numFrames;
+	}
+
+	/**
+	 * @brief Dump statistics to log
+	 */
+	void Dump() const;
+
+	uint64					numCalls[ NRC_Num ];		/**< Number of calls since start */
+	double					callSeconds[ NRC_Num ];		/**< Time of calls in seconds since start */
+	uint64					numFrames;					/**< Number of frames since start */
+	uint64					bytesUploaded;				/**< Bytes uploaded to buffers and textures since start */
+	SNullRHIFrameStats		currentFrame;				/**< Statistics of current frame */
+	SNullRHIFrameStats		lastFrame;					/**< Statistics of last finished frame */
+};
+
+/**
+ * @ingroup NullRHI
+ * @brief Statistics of null RHI, it is updated in rendering thread (see 'nullrhistats' console command)
+ */
+extern SNullRHIStats		GNullRHIStats;
+
+/**
+ * @ingroup NullRHI
+ * @brief Helper for count and time call of null RHI
+ */
+class CNullRHIScopedCall
+{
+public:
+	/**
+	 * @brief Constructor
+	 * @param InCall	Call
+	 */
+	FORCEINLINE CNullRHIScopedCall( ENullRHICall InCall )
+		: call( InCall )
+		, startTime( appSeconds() )
+	{}
+
+	/**
+	 * @brief Destructor
+	 */
+	FORCEINLINE ~CNullRHIScopedCall()
+	{
+		GNullRHIStats.AddCall( call, appSeconds() - startTime );
+	}
+
+private:
+	ENullRHICall	call;			/**< Call */
+	double			startTime;		/**< Start time of call */
+};
+
+/**
+ * @ingroup NullRHI
+ * @brief Macro for count and time call of null RHI
+ */
+#define NULLRHI_SCOPED_CALL( InCall )		CNullRHIScopedCall		nullRHIScopedCall( InCall )
+
+/**
+ * @ingroup NullRHI
+ * @brief RHI without GPU
+ *
+ * Implements whole interface of CBaseRHI, but nothing is rendered. Every call is counted and timed,
+ * also it tracks uploaded bytes and state changes per frame (see GNullRHIStats).
+ * It allows to run renderer headless (with command line param -nullrhi) and benchmark CPU side of rendering without GPU
+ */
+class CNullRHI : public CBaseRHI
+{
+public:
+	/**
+	 * @brief Constructor
+	 */
+	CNullRHI();
+
+	/**
+	 * @brief Destructor
+	 */
+	~CNullRHI();
+
+	/**
+	 * @brief Initialize RHI
+	 *
+	 * @param[in] InIsEditor Is current application editor
+	 */
+	virtual void									Init( bool InIsEditor ) override;
+
+	/**
+	 * @brief Destroy RHI
+	 */
+	virtual void									Destroy() override;
+
+	/**
+	 * @brief Create viewport
+	 *
+	 * @param[in] InWindowHandle OS handle on window
+	 * @param[in] InWidth Width of viewport
+	 * @param[in] InHeight Height of viewport
+	 * @return Pointer on viewport
+	 */
+	virtual ViewportRHIRef_t						CreateViewport( WindowHandle_t InWindowHandle, uint32 InWidth, uint32 InHeight ) override;
+
+	/**
+	 * @brief Create viewport
+	 *
+	 * @param InTargetSurface	Target surface to render
+	 * @param InWidth			Width of viewport
+	 * @param InHeight			Height of viewport
+	 * @return Pointer on viewport
+	 */
+	virtual ViewportRHIRef_t						CreateViewport( SurfaceRHIParamRef_t InSurfaceRHI, uint32 InWidth, uint32 InHeight ) override;
+
+	/**
+	 * @brief Create vertex shader
+	 *
+	 * @param[in] InShaderName Shader name
+	 * @param[in] InData Data to shader code
+	 * @param[in] InSize Size of data
+	 * @return Pointer to vertex shader
+	 */
+	virtual VertexShaderRHIRef_t					CreateVertexShader( const tchar* InShaderName, const byte* InData, uint32 InSize ) override;
+
+	/**
+	 * @brief Create hull shader
+	 *
+	 * @param[in] InShaderName Shader name
+	 * @param[in] InData Data to shader code
+	 * @param[in] InSize Size of data
+	 * @return Pointer to hull shader
+	 */
+	virtual HullShaderRHIRef_t						CreateHullShader( const tchar* InShaderName, const byte* InData, uint32 InSize ) override;
+
+	/**
+	 * @brief Create domain shader
+	 *
+	 * @param[in] InShaderName Shader name
+	 * @param[in] InData Data to shader code
+	 * @param[in] InSize Size of data
+	 * @return Pointer to domain shader
+	 */
+	virtual DomainShaderRHIRef_t					CreateDomainShader( const tchar* InShaderName, const byte* InData, uint32 InSize ) override;
+
+	/**
+	 * @brief Create pixel shader
+	 *
+	 * @param[in] InShaderName Shader name
+	 * @param[in] InData Data to shader code
+	 * @param[in] InSize Size of data
+	 * @return Pointer to pixel shader
+	 */
+	virtual PixelShaderRHIRef_t						CreatePixelShader( const tchar* InShaderName, const byte* InData, uint32 InSize ) override;
+
+	/**
+	 * @brief Create geometry shader
+	 *
+	 * @param[in] InShaderName Shader name
+	 * @param[in] InData Data to shader code
+	 * @param[in] InSize Size of data
+	 * @return Pointer to geometry shader
+	 */
+	virtual GeometryShaderRHIRef_t					CreateGeometryShader( const tchar* InShaderName, const byte* InData, uint32 InSize ) override;
+
+	/**
+	 * @brief Create vertex buffer
+	 *
+	 * @param[in] InBufferName Buffer name
+	 * @param[in] InSize Size buffer
+	 * @param[in] InData Pointer to data
+	 * @param[in] InUsage Usage flags
+	 * @return Pointer to vertex buffer
+	 */
+	virtual VertexBufferRHIRef_t					CreateVertexBuffer( const tchar* InBufferName, uint32 InSize, const byte* InData, uint32 InUsage ) override;
+
+	/**
+	 * @brief Create index buffer
+	 *
+	 * @param[in] InBufferName Buffer name
+	 * @param[in] InStride Stride of struct
+	 * @param[in] InSize Size buffer
+	 * @param[in] InData Pointer to data
+	 * @param[in] InUsage Usage flags
+	 * @return Pointer to index buffer
+	 */
+	virtual IndexBufferRHIRef_t						CreateIndexBuffer( const tchar* InBufferName, uint32 InStride, uint32 InSize, const byte* InData, uint32 InUsage ) override;
+
+	/**
+	 * @brief Create vertex declaration
+	 *
+	 * @param[in] InElementList Array of vertex elements
+	 * @return Pointer to vertex declaration
+	 */
+	virtual VertexDeclarationRHIRef_t				CreateVertexDeclaration( const VertexDeclarationElementList_t& InElementList ) override;
+
+	/**
+	 * @brief Create bound shader state
+	 *
+	 * @param[in] InBoundShaderStateName Bound shader state name for debug
+	 * @param[in] InVertexDeclaration Vertex declaration
+	 * @param[in] InVertexShader Vertex shader
+	 * @param[in] InPixelShader Pixel shader
+	 * @param[in] InHullShader Hull shader
+	 * @param[in] InDomainShader Domain shader
+	 * @param[in] InGeometryShader Geometry shader
+	 * @return Pointer to bound shader state
+	 */
+	virtual BoundShaderStateRHIRef_t				CreateBoundShaderState( const tchar* InBoundShaderStateName, VertexDeclarationRHIRef_t InVertexDeclaration, VertexShaderRHIRef_t InVertexShader, PixelShaderRHIRef_t InPixelShader, HullShaderRHIRef_t InHullShader = nullptr, DomainShaderRHIRef_t InDomainShader = nullptr, GeometryShaderRHIRef_t InGeometryShader = nullptr, bool* OutIsCreated = nullptr ) override;
+
+	/**
+	 * @brief Create rasterizer state
+	 *
+	 * @param[in] InInitializer Initializer of rasterizer state
+	 * @return Pointer to rasterizer state
+	 */
+	virtual RasterizerStateRHIRef_t					CreateRasterizerState( const SRasterizerStateInitializerRHI& InInitializer ) override;
+
+	/**
+	 * @brief Create sampler state
+	 *
+	 * @param[in] InInitializer Initializer of sampler state
+	 * @return Pointer to sampler state
+	 */
+	virtual SamplerStateRHIRef_t					CreateSamplerState( const SSamplerStateInitializerRHI& InInitializer ) override;
+
+	/**
+	 * @brief Create depth state
+	 *
+	 * @param InInitializer		Initializer of depth state
+	 * @return Pointer to depth state
+	 */
+	virtual DepthStateRHIRef_t						CreateDepthState( const SDepthStateInitializerRHI& InInitializer ) override;
+
+	/**
+	 * @brief Create blend state
+	 *
+	 * @param InInitializer		Initializer of blend state
+	 * @return Pointer to blend state
+	 */
+	virtual BlendStateRHIRef_t						CreateBlendState( const SBlendStateInitializerRHI& InInitializer ) override;
+
+	/**
+	 * @brief Create stencil state
+	 *
+	 * @param InInitializer		Initializer of stencil state
+	 * @return Pointer to stencil state
+	 */
+	virtual StencilStateRHIRef_t					CreateStencilState( const SStencilStateInitializerRHI& InInitializer ) override;
+
+	/**
+	 * @brief Create texture 2D
+	 *
+	 * @param[in] InDebugName Debug name
+	 * @param[in] InSizeX Width
+	 * @param[in] InSizeY Height
+	 * @param[in] InFormat Pixel format
+	 * @param[in] InNumMips Count mips
+	 * @param[in] InFlags Texture create flags (use ETextureCreateFlags)
+	 * @param[in] InData Pointer to data texture
+	 * @return Pointer to texture 2D
+	 */
+	virtual Texture2DRHIRef_t						CreateTexture2D( const tchar* InDebugName, uint32 InSizeX, uint32 InSizeY, EPixelFormat InFormat, uint32 InNumMips, uint32 InFlags, void* InData = nullptr ) override;
+
+	/**
+	 * @brief Create targetable surface
+	 *
+	 * @param[in] InDebugName Debug name
+	 * @param[in] InSizeX Width
+	 * @param[in] InSizeY Height
+	 * @param[in] InFormat Pixel format
+	 * @param[in] InResolveTargetTexture Resolve target texture
+	 * @param[in] InFlags Texture create flags (use ETextureCreateFlags)
+	 * @return Pointer to surface
+	 */
+	virtual SurfaceRHIRef_t							CreateTargetableSurface( const tchar* InDebugName, uint32 InSizeX, uint32 InSizeY, EPixelFormat InFormat, Texture2DRHIParamRef_t InResolveTargetTexture, uint32 InFlags ) override;
+
+	/**
+	 * @brief Begin drawing viewport
+	 *
+	 * @param[in] InDeviceContext Device context
+	 * @param[in] InViewport Viewport
+	 */
+	virtual void									BeginDrawingViewport( class CBaseDeviceContextRHI* InDeviceContext, class CBaseViewportRHI* InViewport ) override;
+
+	/**
+	 * @brief End drawing viewport, statistics of current frame are finished here
+	 *
+	 * @param[in] InDeviceContext Device context
+	 * @param[in] InViewport Viewport
+	 * @param[in] InIsPresent Whether to display the frame on the screen
+	 * @param[in] InLockToVsync Is it necessary to block for Vsync
+	 */
+	virtual void									EndDrawingViewport( class CBaseDeviceContextRHI* InDeviceContext, class CBaseViewportRHI* InViewport, bool InIsPresent, bool InLockToVsync ) override;
+
+	/**
+	 * @brief Create command list
+	 * @note Null RHI hasn't deferred contexts, so command list records directly to the immediate context
+	 *
+	 * @return Return command list
+	 */
+	virtual CommandListRHIRef_t						CreateCommandList() override;
+
+	/**
+	 * @brief Get shader platform
+	 * @return Return shader platform of cooked shaders which will be loaded
+	 */
+	virtual EShaderPlatform							GetShaderPlatform() const override;
+
+#if WITH_IMGUI
+	/**
+	 * @brief Draw ImGUI
+	 *
+	 * @param[in] InDeviceContext Device context
+	 * @param[in] InImGUIDrawData Pointer to draw data of ImGUI
+	 */
+	virtual void									DrawImGUI( class CBaseDeviceContextRHI* InDeviceContext, struct ImDrawData* InImGUIDrawData ) override;
+#endif // WITH_IMGUI
+
+	/**
+	 * @brief Begin draw event
+	 *
+	 * @param[in] InDeviceContext Device context
+	 * @param[in] InColor Color event
+	 * @param[in] InName Event name
+	 */
+	virtual void									BeginDrawEvent( class CBaseDeviceContextRHI* InDeviceContext, const CColor& InColor, const tchar* InName ) override;
+
+	/**
+	 * @brief End draw event
+	 *
+	 * @param[in] InDeviceContext Device context
+	 */
+	virtual void									EndDrawEvent( class CBaseDeviceContextRHI* InDeviceContext ) override;
+
+	/**
+	 * @brief Setup instancing
+	 *
+	 * @param[in] InDeviceContext Device context
+	 * @param[in] InStreamIndex Stream index
+	 * @param[in] InInstanceData Pointer to instance data
+	 * @param[in] InInstanceStride Instance stride
+	 * @param[in] InInstanceSize Instance size
+	 * @param[in] InNumInstances Number instances
+	 */
+	virtual void									SetupInstancing( class CBaseDeviceContextRHI* InDeviceContext, uint32 InStreamIndex, void* InInstanceData, uint32 InInstanceStride, uint32 InInstanceSize, uint32 InNumInstances ) override;
+
+	/**
+	 * @brief Set viewport
+	 *
+	 * @param[in] InDeviceContext Device context
+	 * @param[in] InMinX Min x
+	 * @param[in] InMinY Min y
+	 * @param[in] InMinZ Min z
+	 * @param[in] InMaxX Max x
+	 * @param[in] InMaxY Max y
+	 * @param[in] InMaxZ Max z
+	 */
+	virtual void									SetViewport( class CBaseDeviceContextRHI* InDeviceContext, uint32 InMinX, uint32 InMinY, float InMinZ, uint32 InMaxX, uint32 InMaxY, float InMaxZ ) override;
+
+	/**
+	 * @brief Set bound shader state
+	 *
+	 * @param[in] InDeviceContext Device context
+	 * @param[in] InBoundShaderState Bound shader state
+	 */
+	virtual void									SetBoundShaderState( class CBaseDeviceContextRHI* InDeviceContext, BoundShaderStateRHIParamRef_t InBoundShaderState ) override;
+
+	/**
+	 * @brief Set stream source
+	 *
+	 * @param[in] InDeviceContext Device context
+	 * @param[in] InStreamIndex Stream index
+	 * @param[in] InVertexBuffer Vertex buffer
+	 * @param[in] InStride Stride
+	 * @param[in] InOffset Offset
+	 */
+	virtual void									SetStreamSource( class CBaseDeviceContextRHI* InDeviceContext, uint32 InStreamIndex, VertexBufferRHIParamRef_t InVertexBuffer, uint32 InStride, uint32 InOffset ) override;
+
+	/**
+	 * @brief Set rasterizer state
+	 *
+	 * @param[in] InDeviceContext Device context
+	 * @param[in] InNewState New rasterizer state
+	 */
+	virtual void									SetRasterizerState( class CBaseDeviceContextRHI* InDeviceContext, RasterizerStateRHIParamRef_t InNewState ) override;
+
+	/**
+	 * @brief Set sampler state
+	 *
+	 * @param[in] InDeviceContext Device context
+	 * @param[in] InPixelShader Pixel shader
+	 * @param[in] InNewState New sampler state
+	 * @param[in] InStateIndex Slot for bind sampler
+	 */
+	virtual void									SetSamplerState( class CBaseDeviceContextRHI* InDeviceContext, PixelShaderRHIParamRef_t InPixelShader, SamplerStateRHIParamRef_t InNewState, uint32 InStateIndex ) override;
+
+	/**
+	 * @brief Set texture parameter
+	 *
+	 * @param[in] InDeviceContext Device context
+	 * @param[in] InPixelShader Pixel shader
+	 * @param[in] InTexture Texture
+	 * @param[in] InTextureIndex Slot for bind texture
+	 */
+	virtual void									SetTextureParameter( class CBaseDeviceContextRHI* InDeviceContext, PixelShaderRHIParamRef_t InPixelShader, TextureRHIParamRef_t InTexture, uint32 InTextureIndex ) override;
+
+	/**
+	 * @brief Set view parameters
+	 *
+	 * @param[in] InDeviceContext Device context
+	 * @param[in] InSceneView Scene view
+	 */
+	virtual void									SetViewParameters( class CBaseDeviceContextRHI* InDeviceContext, class CSceneView& InSceneView ) override;
+
+	/**
+	 * @brief Set render target
+	 *
+	 * @param[in] InDeviceContext Device context
+	 * @param[in] InNewRenderTarget New render target
+	 * @param[in] InNewDepthStencilTarget New depth stencil target
+	 */
+	virtual void									SetRenderTarget( class CBaseDeviceContextRHI* InDeviceContext, SurfaceRHIParamRef_t InNewRenderTarget, SurfaceRHIParamRef_t InNewDepthStencilTarget ) override;
+
+	/**
+	 * @brief Set MRT render target
+	 *
+	 * @param[in] InDeviceContext Device context
+	 * @param[in] InNewRenderTarget New render target
+	 * @param[in] InTargetIndex Target index
+	 */
+	virtual void									SetMRTRenderTarget( class CBaseDeviceContextRHI* InDeviceContext, SurfaceRHIParamRef_t InNewRenderTarget, uint32 InTargetIndex ) override;
+
+	/**
+	 * @brief Set vertex shader parameter
+	 *
+	 * @param[in] InDeviceContext Device context
+	 * @param[in] InBufferIndex Buffer index
+	 * @param[in] InBaseIndex Base index
+	 * @param[in] InNumBytes Number bytes
+	 * @param[in] InNewValue New value
+	 */
+	virtual void									SetVertexShaderParameter( class CBaseDeviceContextRHI* InDeviceContext, uint32 InBufferIndex, uint32 InBaseIndex, uint32 InNumBytes, const void* InNewValue ) override;
+
+	/**
+	 * @brief Set pixel shader parameter
+	 *
+	 * @param[in] InDeviceContext Device context
+	 * @param[in] InBufferIndex Buffer index
+	 * @param[in] InBaseIndex Base index
+	 * @param[in] InNumBytes Number bytes
+	 * @param[in] InNewValue New value
+	 */
+	virtual void									SetPixelShaderParameter( class CBaseDeviceContextRHI* InDeviceContext, uint32 InBufferIndex, uint32 InBaseIndex, uint32 InNumBytes, const void* InNewValue ) override;
+
+	/**
+	 * @brief Set depth state
+	 *
+	 * @param InDeviceContext	Device context
+	 * @param InNewState		New depth state
+	 */
+	virtual void									SetDepthState( class CBaseDeviceContextRHI* InDeviceContext, DepthStateRHIParamRef_t InNewState ) override;
+
+	/**
+	 * @brief Set blend state
+	 *
+	 * @param InDeviceContext	Device context
+	 * @param InNewState		New blend state
+	 */
+	virtual void									SetBlendState( class CBaseDeviceContextRHI* InDeviceContext, BlendStateRHIParamRef_t InNewState ) override;
+
+	/**
+	 * @brief Set stencil state
+	 *
+	 * @param InDeviceContext	Device context
+	 * @param InNewState		New stencil state
+	 */
+	virtual void									SetStencilState( class CBaseDeviceContextRHI* InDeviceContext, StencilStateRHIParamRef_t InNewState ) override;
+
+	/**
+	 * @brief Commit constants
+	 *
+	 * @param[in] InDeviceContext Device context
+	 */
+	virtual void									CommitConstants( class CBaseDeviceContextRHI* InDeviceContext ) override;
+
+	/**
+	 * @brief Lock vertex buffer
+	 *
+	 * @param[in] InDeviceContext Device context
+	 * @param[in] InVertexBuffer Pointer to vertex buffer
+	 * @param[in] InSize Size
+	 * @param[in] InOffset Offset
+	 * @param[out] OutLockedData Locked data
+	 */
+	virtual void									LockVertexBuffer( class CBaseDeviceContextRHI* InDeviceContext, const VertexBufferRHIRef_t InVertexBuffer, uint32 InSize, uint32 InOffset, SLockedData& OutLockedData ) override;
+
+	/**
+	 * @brief Unlock vertex buffer
+	 *
+	 * @param[in] InDeviceContext Device context
+	 * @param[in] InVertexBuffer Pointer to vertex buffer
+	 * @param[in] InLockedData Locked data
+	 */
+	virtual void									UnlockVertexBuffer( class CBaseDeviceContextRHI* InDeviceContext, const VertexBufferRHIRef_t InVertexBuffer, SLockedData& InLockedData ) override;
+
+	/**
+	 * @brief Lock index buffer
+	 *
+	 * @param[in] InDeviceContext Device context
+	 * @param[in] InIndexBuffer Pointer to index buffer
+	 * @param[in] InSize Size
+	 * @param[in] InOffset Offset
+	 * @param[out] OutLockedData Locked data
+	 */
+	virtual void									LockIndexBuffer( class CBaseDeviceContextRHI* InDeviceContext, const IndexBufferRHIRef_t InIndexBuffer, uint32 InSize, uint32 InOffset, SLockedData& OutLockedData ) override;
+
+	/**
+	 * @brief Unlock index buffer
+	 *
+	 * @param[in] InDeviceContext Device context
+	 * @param[in] InIndexBuffer Pointer to index buffer
+	 * @param[in] InLockedData Locked data
+	 */
+	virtual void									UnlockIndexBuffer( class CBaseDeviceContextRHI* InDeviceContext, const IndexBufferRHIRef_t InIndexBuffer, SLockedData& InLockedData ) override;
+
+	/**
+	 * @brief Lock texture 2D
+	 *
+	 * @param[in] InDeviceContext Device context
+	 * @param[in] InTexture Pointer to texture 2D
+	 * @param[in] InMipIndex Mip index
+	 * @param[in] InIsDataWrite Is data write
+	 * @param[out] OutLockedData Locked data
+	 * @param[in] InIsUseCPUShadow Is use CPU shadow
+	 */
+	virtual void									LockTexture2D( class CBaseDeviceContextRHI* InDeviceContext, Texture2DRHIParamRef_t InTexture, uint32 InMipIndex, bool InIsDataWrite, SLockedData& OutLockedData, bool InIsUseCPUShadow = false ) override;
+
+	/**
+	 * @brief Unlock texture 2D
+	 *
+	 * @param[in] InDeviceContext Device context
+	 * @param[in] InTexture Pointer to texture 2D
+	 * @param[in] InMipIndex Mip index
+	 * @param[in] InLockedData Locked data
+	 */
+	virtual void									UnlockTexture2D( class CBaseDeviceContextRHI* InDeviceContext, Texture2DRHIParamRef_t InTexture, uint32 InMipIndex, SLockedData& InLockedData ) override;
+
+	/**
+	 * @brief Draw primitive
+	 *
+	 * @param[in] InDeviceContext Device context
+	 * @param[in] InPrimitiveType Primitive type
+	 * @param[in] InBaseVertexIndex Base vertex index
+	 * @param[in] InNumPrimitives Number primitives for render
+	 * @param[in] InNumInstances Number instances of primitive
+	 */
+	virtual void									DrawPrimitive( class CBaseDeviceContextRHI* InDeviceContext, EPrimitiveType InPrimitiveType, uint32 InBaseVertexIndex, uint32 InNumPrimitives, uint32 InNumInstances = 1 ) override;
+
+	/**
+	 * @brief Draw indexed primitive
+	 *
+	 * @param[in] InDeviceContext Device context
+	 * @param[in] InIndexBuffer Index buffer
+	 * @param[in] InPrimitiveType Primitive type
+	 * @param[in] InBaseVertexIndex First vertex index
+	 * @param[in] InStartIndex Start index
+	 * @param[in] InNumPrimitives Number primitives for render
+	 * @param[in] InNumInstances Number instances of primitive
+	 */
+	virtual void									DrawIndexedPrimitive( class CBaseDeviceContextRHI* InDeviceContext, class CBaseIndexBufferRHI* InIndexBuffer, EPrimitiveType InPrimitiveType, uint32 InBaseVertexIndex, uint32 InStartIndex, uint32 InNumPrimitives, uint32 InNumInstances = 1 ) override;
+
+	/**
+	 * @brief Copy surface to resolve target
+	 *
+	 * @param InDeviceContext		Device context
+	 * @param InSourceSurface		Source surface
+	 * @param InResolveParams		Resolve params
+	 */
+	virtual void									CopyToResolveTarget( class CBaseDeviceContextRHI* InDeviceContext, SurfaceRHIParamRef_t InSourceSurface, const SResolveParams& InResolveParams ) override;
+
+	/**
+	 * @brief Copies mips which are shared by two textures
+	 *
+	 * @param InDeviceContext		Device context
+	 * @param InDestTexture			Destination texture
+	 * @param InSourceTexture		Source texture
+	 */
+	virtual void									CopySharedMips( class CBaseDeviceContextRHI* InDeviceContext, Texture2DRHIParamRef_t InDestTexture, Texture2DRHIParamRef_t InSourceTexture ) override;
+
+	/**
+	 * @brief Draw primitive with data from user pointer
+	 *
+	 * @param InDeviceContext		Device context
+	 * @param InPrimitiveType		Primitive type
+	 * @param InBaseVertexIndex		Base vertex index
+	 * @param InNumPrimitives		Number primitives for render
+	 * @param InVertexData			Pointer to vertex data
+	 * @param InVertexDataStride	Stride of vertex
+	 * @param InNumInstances		Number instances of primitive
+	 */
+	virtual void									DrawPrimitiveUP( class CBaseDeviceContextRHI* InDeviceContext, EPrimitiveType InPrimitiveType, uint32 InBaseVertexIndex, uint32 InNumPrimitives, const void* InVertexData, uint32 InVertexDataStride, uint32 InNumInstances = 1 ) override;
+
+	/**
+	 * @brief Draw indexed primitive with data from user pointer
+	 *
+	 * @param InDeviceContext		Device context
+	 * @param InPrimitiveType		Primitive type
+	 * @param InBaseVertexIndex		Base vertex index
+	 * @param InNumPrimitives		Number primitives for render
+	 * @param InNumVertices			Number of vertices
+	 * @param InIndexData			Pointer to index data
+	 * @param InIndexDataStride		Stride of index
+	 * @param InVertexData			Pointer to vertex data
+	 * @param InVertexDataStride	Stride of vertex
+	 * @param InNumInstances		Number instances of primitive
+	 */
+	virtual void									DrawIndexedPrimitiveUP( class CBaseDeviceContextRHI* InDeviceContext, EPrimitiveType InPrimitiveType, uint32 InBaseVertexIndex, uint32 InNumPrimitives, uint32 InNumVertices, const void* InIndexData, uint32 InIndexDataStride, const void* InVertexData, uint32 InVertexDataStride, uint32 InNumInstances = 1 ) override;
+
+	/**
+	 * @brief Is initialized RHI
+	 * @return Return true if RHI is initialized, else false
+	 */
+	virtual bool									IsInitialize() const override;
+
+	/**
+	 * @brief Get RHI name
+	 * @return Return RHI name
+	 */
+	virtual const tchar*							GetRHIName() const override;
+
+	/**
+	 * @brief Is null RHI
+	 * @return Always return true
+	 */
+	virtual bool									IsNullRHI() const override;
+
+	/**
+	 * @brief Get device context
+	 * @return Return pointer to device context
+	 */
+	virtual class CBaseDeviceContextRHI*			GetImmediateContext() const override;
+
+	/**
+	 * @brief Get viewport width
+	 * @return Return width of current viewport
+	 */
+	virtual uint32									GetViewportWidth() const override;
+
+	/**
+	 * @brief Get viewport height
+	 * @return Return height of current viewport
+	 */
+	virtual uint32									GetViewportHeight() const override;
+
+	/**
+	 * @brief Get history of bound shader states
+	 * @return Return history of bound shader states
+	 */
+	FORCEINLINE CBoundShaderStateHistory& GetBoundShaderStateHistory()
+	{
+		return boundShaderStateHistory;
+	}
+
+private:
+	/**
+	 * @brief Update state in cache and count state change
+	 *
+	 * @param InOutCachedState	State in cache
+	 * @param InNewState		New state
+	 */
+	template< typename TStateType >
+	FORCEINLINE void UpdateState( TStateType& InOutCachedState, const TStateType& InNewState )
+	{
+		if ( InOutCachedState == InNewState )
+		{
+			++GNullRHIStats.currentFrame.numRedundantStateSets;
+		}
+		else
+		{
+			InOutCachedState = InNewState;
+			++GNullRHIStats.currentFrame.numStateChanges;
+		}
+	}
+
+	/**
+	 * @brief Count draw call
+	 *
+	 * @param InNumPrimitives	Number of primitives
+	 * @param InNumInstances	Number of instances
+	 */
+	FORCEINLINE void AddDrawCall( uint32 InNumPrimitives, uint32 InNumInstances )
+	{
+		++GNullRHIStats.currentFrame.numDrawCalls;
+		GNullRHIStats.currentFrame.numPrimitives += ( uint64 )InNumPrimitives * InNumInstances;
+	}
+
+	bool							isInitialize;			/**< Is RHI initialized */
+	CNullDeviceContextRHI*			immediateContext;		/**< Immediate device context */
+	SNullStateCache::SViewport		viewport;				/**< Current viewport */
+	CBoundShaderStateHistory		boundShaderStateHistory;	/**< History of using bound shader states */
+};
+
+#endif // !NULLRHI_H
\ No newline at end of file
@@ -0,0 +1,449 @@
+/**
+ * @file
+ * @addtogroup NullRHI NullRHI
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef NULLRESOURCES_H
+#define NULLRESOURCES_H
+
+#include <vector>
+
+#include "Core.h"
+#include "Misc/Types.h"
+#include "RHI/BaseRHI.h"
+#include "RHI/BaseBufferRHI.h"
+#include "RHI/BaseShaderRHI.h"
+#include "RHI/BaseSurfaceRHI.h"
+#include "RHI/BaseViewportRHI.h"
+#include "RHI/BaseDeviceContextRHI.h"
+
+/**
+ * @ingroup NullRHI
+ * @brief Max number of vertex streams tracked by state cache of null RHI
+ */
+#define NULLRHI_MAX_STREAMS			16
+
+/**
+ * @ingroup NullRHI
+ * @brief Max number of texture and sampler slots tracked by state cache of null RHI
+ */
+#define NULLRHI_MAX_TEXTURES		16
+
+/**
+ * @ingroup NullRHI
+ * @brief Shader constant buffer emulated by null RHI
+ *
+ * Data isn't stored, only used range and changes are tracked for statistics of constant uploads
+ */
+struct SNullConstantBuffer
+{
+	/**
+	 * @brief Constructor
+	 */
+	FORCEINLINE SNullConstantBuffer()
+		: usedSize( 0 )
+		, bDirty( false )
+	{}
+
+	/**
+	 * @brief Update constants
+	 *
+	 * @param InBaseIndex	Offset of constants in bytes
+	 * @param InNumBytes	Number of bytes
+	 */
+	FORCEINLINE void Update( uint32 InBaseIndex, uint32 InNumBytes )
+	{
+		usedSize	= Max( usedSize, InBaseIndex + InNumBytes );
+		bDirty		= true;
+	}
+
+	uint32		usedSize;		/**< Max size of updated data since creating of buffer */
+	bool		bDirty;			/**< Is buffer changed since last commit */
+};
+
+/**
+ * @ingroup NullRHI
+ * @brief Constant buffer ring emulated by null RHI
+ *
+ * Only offset is tracked to find out when the ring is discarded like in D3D11 RHI
+ */
+struct SNullConstantBufferRing
+{
+	/**
+	 * @brief Constructor
+	 */
+	FORCEINLINE SNullConstantBufferRing()
+		: offset( 0 )
+		, bNeedDiscard( true )
+	{}
+
+	/**
+	 * @brief Allocate range in the ring
+	 *
+	 * @param InSize	Size of range, must be aligned to RHI_CONSTANTBUFFER_RING_ALIGNMENT
+	 * @return Return true if the ring was discarded, in this case ranges allocated before are lost
+	 */
+	FORCEINLINE bool Allocate( uint32 InSize )
+	{
+		check( InSize <= RHI_CONSTANTBUFFER_RING_SIZE );
+		if ( bNeedDiscard || offset + InSize > RHI_CONSTANTBUFFER_RING_SIZE )
+		{
+			offset			= InSize;
+			bNeedDiscard	= false;
+			return true;
+		}
+
+		offset += InSize;
+		return false;
+	}
+
+	uint32		offset;			/**< Current offset in the ring */
+	bool		bNeedDiscard;	/**< Is need discard the ring on next allocation */
+};
+
+/**
+ * @ingroup NullRHI
+ * @brief Vertex buffer of null RHI
+ *
+ * Memory for lock is allocated on first lock and stays alive until buffer is destroyed,
+ * so dynamic buffers don't allocate memory every frame
+ */
+class CNullVertexBufferRHI : public CBaseVertexBufferRHI
+{
+public:
+	/**
+	 * @brief Constructor
+	 *
+	 * @param InUsage	Usage flags
+	 * @param InSize	Size of buffer
+	 */
+	CNullVertexBufferRHI( uint32 InUsage, uint32 InSize )
+		: CBaseVertexBufferRHI( InUsage, InSize )
+	{}
+
+	/**
+	 * @brief Get memory for lock
+	 * @return Return pointer to memory of buffer
+	 */
+	FORCEINLINE byte* GetLockMemory()
+	{
+		if ( lockMemory.empty() )
+		{
+			lockMemory.resize( GetSize() );
+		}
+		return lockMemory.data();
+	}
+
+private:
+	std::vector< byte >		lockMemory;		/**< Memory for lock */
+};
+
+/**
+ * @ingroup NullRHI
+ * @brief Index buffer of null RHI
+ */
+class CNullIndexBufferRHI : public CBaseIndexBufferRHI
+{
+public:
+	/**
+	 * @brief Constructor
+	 *
+	 * @param InUsage	Usage flags
+	 * @param InStride	Stride of index
+	 * @param InSize	Size of buffer
+	 */
+	CNullIndexBufferRHI( uint32 InUsage, uint32 InStride, uint32 InSize )
+		: CBaseIndexBufferRHI( InUsage, InStride, InSize )
+		, bufferSize( InSize )
+	{}
+
+	/**
+	 * @brief Get memory for lock
+	 * @return Return pointer to memory of buffer
+	 */
+	FORCEINLINE byte* GetLockMemory()
+	{
+		if ( lockMemory.empty() )
+		{
+			lockMemory.resize( bufferSize );
+		}
+		return lockMemory.data();
+	}
+
+private:
+	uint32					bufferSize;		/**< Size of buffer */
+	std::vector< byte >		lockMemory;		/**< Memory for lock */
+};
+
+/**
+ * @ingroup NullRHI
+ * @brief Bound shader state of null RHI
+ */
+class CNullBoundShaderStateRHI : public CBaseBoundShaderStateRHI
+{
+public:
+	/**
+	 * @brief Constructor
+	 *
+	 * @param InKey					Bound shader state key
+	 * @param InVertexDeclaration	Vertex declaration
+	 * @param InVertexShader		Vertex shader
+	 * @param InPixelShader			Pixel shader
+	 * @param InHullShader			Hull shader
+	 * @param InDomainShader		Domain shader
+	 * @param InGeometryShader		Geometry shader
+	 */
+	CNullBoundShaderStateRHI( const CBoundShaderStateKey& InKey, VertexDeclarationRHIRef_t InVertexDeclaration, VertexShaderRHIRef_t InVertexShader, PixelShaderRHIRef_t InPixelShader, HullShaderRHIRef_t InHullShader, DomainShaderRHIRef_t InDomainShader, GeometryShaderRHIRef_t InGeometryShader )
+		: CBaseBoundShaderStateRHI( InKey, InVertexDeclaration, InVertexShader, InPixelShader, InHullShader, InDomainShader, InGeometryShader )
+	{}
+
+	/**
+	 * @brief Destructor
+	 */
+	virtual ~CNullBoundShaderStateRHI();
+};
+
+/**
+ * @ingroup NullRHI
+ * @brief Viewport of null RHI
+ */
+class CNullViewportRHI : public CBaseViewportRHI
+{
+public:
+	/**
+	 * @brief Constructor
+	 *
+	 * @param InWindowHandle	OS handle on window
+	 * @param InSurface			Surface of viewport
+	 * @param InWidth			Width of viewport
+	 * @param InHeight			Height of viewport
+	 */
+	CNullViewportRHI( WindowHandle_t InWindowHandle, SurfaceRHIParamRef_t InSurface, uint32 InWidth, uint32 InHeight )
+		: windowHandle( InWindowHandle )
+		, surface( InSurface )
+		, width( InWidth )
+		, height( InHeight )
+	{}
+
+	/**
+	 * @brief Present viewport
+	 * @param InLockToVsync Is need lock to vsync
+	 */
+	virtual void Present( bool InLockToVsync ) override
+	{}
+
+	/**
+	 * @brief Resize viewport
+	 *
+	 * @param InWidth	New width
+	 * @param InHeight	New height
+	 */
+	virtual void Resize( uint32 InWidth, uint32 InHeight ) override
+	{
+		width	= InWidth;
+		height	= InHeight;
+	}
+
+	/**
+	 * @brief Set surface
+	 * @param InSurfaceRHI	Surface
+	 */
+	virtual void SetSurface( SurfaceRHIParamRef_t InSurfaceRHI ) override
+	{
+		surface = InSurfaceRHI;
+	}
+
+	/**
+	 * @brief Get width
+	 * @return Return width of viewport
+	 */
+	virtual uint32 GetWidth() const override
+	{
+		return width;
+	}
+
+	/**
+	 * @brief Get height
+	 * @return Return height of viewport
+	 */
+	virtual uint32 GetHeight() const override
+	{
+		return height;
+	}
+
+	/**
+	 * @brief Get surface
+	 * @return Return surface of viewport
+	 */
+	virtual SurfaceRHIRef_t GetSurface() const override
+	{
+		return surface;
+	}
+
+	/**
+	 * @brief Get window handle
+	 * @return Return OS handle on window
+	 */
+	virtual WindowHandle_t GetWindowHandle() const override
+	{
+		return windowHandle;
+	}
+
+private:
+	WindowHandle_t		windowHandle;	/**< OS handle on window */
+	SurfaceRHIRef_t		surface;		/**< Surface of viewport */
+	uint32				width;			/**< Width of viewport */
+	uint32				height;			/**< Height of viewport */
+};
+
+/**
+ * @ingroup NullRHI
+ * @brief State which set in device context of null RHI
+ *
+ * It is used only for detect redundant state changes, pointers are never dereferenced
+ */
+struct SNullStateCache
+{
+	/**
+	 * @brief Stream source
+	 */
+	struct SStreamSource
+	{
+		VertexBufferRHIParamRef_t		vertexBuffer;	/**< Vertex buffer */
+		uint32							stride;			/**< Stride */
+		uint32							offset;			/**< Offset */
+
+		/**
+		 * @brief Overload operator '=='
+		 */
+		FORCEINLINE bool operator==( const SStreamSource& InOther ) const
+		{
+			return vertexBuffer == InOther.vertexBuffer && stride == InOther.stride && offset == InOther.offset;
+		}
+	};
+
+	/**
+	 * @brief Viewport rect
+	 */
+	struct SViewport
+	{
+		uint32		minX;		/**< Min X */
+		uint32		minY;		/**< Min Y */
+		float		minZ;		/**< Min Z */
+		uint32		maxX;		/**< Max X */
+		uint32		maxY;		/**< Max Y */
+		float		maxZ;		/**< Max Z */
+
+		/**
+		 * @brief Overload operator '=='
+		 */
+		FORCEINLINE bool operator==( const SViewport& InOther ) const
+		{
+			return minX == InOther.minX && minY == InOther.minY && minZ == InOther.minZ && maxX == InOther.maxX && maxY == InOther.maxY && maxZ == InOther.maxZ;
+		}
+	};
+
+	/**
+	 * @brief Constructor
+	 */
+	FORCEINLINE SNullStateCache()
+	{
+		Reset();
+	}
+
+	/**
+	 * @brief Reset state cache
+	 */
+	FORCEINLINE void Reset()
+	{
+		appMemzero( this, sizeof( SNullStateCache ) );
+	}
+
+	BoundShaderStateRHIParamRef_t	boundShaderState;						/**< Bound shader state */
+	RasterizerStateRHIParamRef_t	rasterizerState;						/**< Rasterizer state */
+	DepthStateRHIParamRef_t			depthState;								/**< Depth state */
+	BlendStateRHIParamRef_t			blendState;								/**< Blend state */
+	StencilStateRHIParamRef_t		stencilState;							/**< Stencil state */
+	SurfaceRHIParamRef_t			renderTarget;							/**< Render target */
+	SurfaceRHIParamRef_t			depthStencilTarget;						/**< Depth stencil target */
+	SViewport						viewport;								/**< Viewport */
+	SStreamSource					streamSources[ NULLRHI_MAX_STREAMS ];	/**< Stream sources */
+	TextureRHIParamRef_t			textures[ NULLRHI_MAX_TEXTURES ];		/**< Textures of pixel shader */
+	SamplerStateRHIParamRef_t		samplerStates[ NULLRHI_MAX_TEXTURES ];	/**< Sampler states of pixel shader */
+	EPrimitiveType					primitiveType;							/**< Primitive type of last draw */
+	IndexBufferRHIParamRef_t		indexBuffer;							/**< Index buffer of last draw */
+};
+
+/**
+ * @ingroup NullRHI
+ * @brief Device context of null RHI
+ */
+class CNullDeviceContextRHI : public CBaseDeviceContextRHI
+{
+public:
+	/**
+	 * @brief Clear surface
+	 *
+	 * @param InSurface		Surface for clear
+	 * @param InColor		Color for clearing render target
+	 */
+	virtual void ClearSurface( SurfaceRHIParamRef_t InSurface, const class CColor& InColor ) override;
+
+	/**
+	 * @brief Clear depth stencil
+	 *
+	 * @param InSurface			Surface for clear
+	 * @param InIsClearDepth	Is need clear depth
+	 * @param InIsClearStencil	Is need clear stencil
+	 * @param InDepthValue		Depth value
+	 * @param InStencilValue	Stencil value
+	 */
+	virtual void ClearDepthStencil( SurfaceRHIParamRef_t InSurface, bool InIsClearDepth = true, bool InIsClearStencil = true, float InDepthValue = 1.f, uint8 InStencilValue = 0 ) override;
+
+	/**
+	 * @brief Get state cache
+	 * @return Return state cache
+	 */
+	FORCEINLINE SNullStateCache& GetStateCache()
+	{
+		return stateCache;
+	}
+
+	/**
+	 * @brief Get vertex shader constant buffer
+	 * @return Return vertex shader constant buffer
+	 */
+	FORCEINLINE SNullConstantBuffer& GetVertexConstantBuffer()
+	{
+		return vsConstantBuffer;
+	}
+
+	/**
+	 * @brief Get pixel shader constant buffer
+	 * @return Return pixel shader constant buffer
+	 */
+	FORCEINLINE SNullConstantBuffer& GetPixelConstantBuffer()
+	{
+		return psConstantBuffer;
+	}
+
+	/**
+	 * @brief Get constant buffer ring
+	 * @return Return constant buffer ring
+	 */
+	FORCEINLINE SNullConstantBufferRing& GetConstantBufferRing()
+	{
+		return constantBufferRing;
+	}
+
+private:
+	SNullStateCache			stateCache;				/**< State cache */
+	SNullConstantBuffer		vsConstantBuffer;		/**< Vertex shader constant buffer */
+	SNullConstantBuffer		psConstantBuffer;		/**< Pixel shader constant buffer */
+	SNullConstantBufferRing	constantBufferRing;		/**< Emulated constant buffer ring */
+};
+
+#endif // !NULLRESOURCES_H
\ No newline at end of file
@@ -0,0 +1,625 @@
+#include "Core.h"
+#include "Misc/EngineGlobals.h"
+#include "Logger/LoggerMacros.h"
+#include "Misc/Template.h"
+#include "Render/RenderResource.h"
+#include "Render/RenderUtils.h"
+#include "RHI/BaseShaderRHI.h"
+#include "RHI/BaseStateRHI.h"
+#include "NullRHI.h"
+
+SNullRHIStats		GNullRHIStats;
+
+/**
+ * Get size of mip in bytes
+ */
+static FORCEINLINE uint32 GetMipBytes( EPixelFormat InFormat, uint32 InSizeX, uint32 InSizeY, uint32 InMipIndex )
+{
+	const SPixelFormatInfo&		formatInfo = GPixelFormats[ InFormat ];
+	if ( formatInfo.blockSizeX == 0 || formatInfo.blockSizeY == 0 )
+	{
+		return 0;
+	}
+
+	const uint32		mipSizeX	= Max( InSizeX >> InMipIndex, formatInfo.blockSizeX );
+	const uint32		mipSizeY	= Max( InSizeY >> InMipIndex, formatInfo.blockSizeY );
+	const uint32		numBlocksX	= ( mipSizeX + formatInfo.blockSizeX - 1 ) / formatInfo.blockSizeX;
+	const uint32		numBlocksY	= ( mipSizeY + formatInfo.blockSizeY - 1 ) / formatInfo.blockSizeY;
+	return numBlocksX * numBlocksY * formatInfo.blockBytes;
+}
+
+void SNullRHIStats::Dump() const
+{
+	LE_LOG( LT_Log, LC_RHI, TEXT( "Null RHI statistics for %llu frames" ), numFrames );
+	LE_LOG( LT_Log, LC_RHI, TEXT( "%-28s %12s %12s %12s %14s" ), TEXT( "Call" ), TEXT( "Calls" ), TEXT( "Total (ms)" ), TEXT( "Avg (ns)" ), TEXT( "Last frame" ) );
+	for ( uint32 index = 0; index < NRC_Num; ++index )
+	{
+		if ( numCalls[ index ] == 0 )
+		{
+			continue;
+		}
+
+		LE_LOG( LT_Log, LC_RHI, TEXT( "%-28s %12llu %12.3f %12.1f %14u" ),
+				NullRHICallToText( ( ENullRHICall )index ),
+				numCalls[ index ],
+				callSeconds[ index ] * 1000.0,
+				callSeconds[ index ] * 1000000000.0 / numCalls[ index ],
+				lastFrame.numCalls[ index ] );
+	}
+
+	LE_LOG( LT_Log, LC_RHI, TEXT( "Bytes uploaded:              %llu" ), bytesUploaded );
+	LE_LOG( LT_Log, LC_RHI, TEXT( "Last frame draw calls:       %u" ), lastFrame.numDrawCalls );
+	LE_LOG( LT_Log, LC_RHI, TEXT( "Last frame primitives:       %llu" ), lastFrame.numPrimitives );
+	LE_LOG( LT_Log, LC_RHI, TEXT( "Last frame state changes:    %u" ), lastFrame.numStateChanges );
+	LE_LOG( LT_Log, LC_RHI, TEXT( "Last frame redundant sets:   %u" ), lastFrame.numRedundantStateSets );
+	LE_LOG( LT_Log, LC_RHI, TEXT( "Last frame bytes uploaded:   %llu" ), lastFrame.bytesUploaded );
+	LE_LOG( LT_Log, LC_RHI, TEXT( "Last frame constant bytes:   %llu" ), lastFrame.bytesConstants );
+	LE_LOG( LT_Log, LC_RHI, TEXT( "Last frame constant commits: %u" ), lastFrame.numConstantBufferCommits );
+	LE_LOG( LT_Log, LC_RHI, TEXT( "Last frame CB ring bytes:    %llu" ), lastFrame.bytesConstantsRing );
+	LE_LOG( LT_Log, LC_RHI, TEXT( "Last frame CB ring rewrites: %llu" ), lastFrame.bytesConstantsRewrite );
+	LE_LOG( LT_Log, LC_RHI, TEXT( "Last frame CB ring discards: %u" ), lastFrame.numConstantBufferRingDiscards );
+	LE_LOG( LT_Log, LC_RHI, TEXT( "Last frame full CB bytes:    %llu" ), lastFrame.bytesConstantsFull );
+}
+
+CNullBoundShaderStateRHI::~CNullBoundShaderStateRHI()
+{
+	( ( CNullRHI* )GRHI )->GetBoundShaderStateHistory().Remove( key );
+}
+
+void CNullDeviceContextRHI::ClearSurface( SurfaceRHIParamRef_t InSurface, const class CColor& InColor )
+{
+	NULLRHI_SCOPED_CALL( NRC_ClearSurface );
+}
+
+void CNullDeviceContextRHI::ClearDepthStencil( SurfaceRHIParamRef_t InSurface, bool InIsClearDepth /* = true */, bool InIsClearStencil /* = true */, float InDepthValue /* = 1.f */, uint8 InStencilValue /* = 0 */ )
+{
+	NULLRHI_SCOPED_CALL( NRC_ClearSurface );
+}
+
+CNullRHI::CNullRHI()
+	: isInitialize( false )
+	, immediateContext( nullptr )
+{
+	appMemzero( &viewport, sizeof( viewport ) );
+}
+
+CNullRHI::~CNullRHI()
+{
+	Destroy();
+}
+
+void CNullRHI::Init( bool InIsEditor )
+{
+	if ( IsInitialize() )			return;
+
+	immediateContext = new CNullDeviceContextRHI();
+
+	// All pixel formats are supported, nothing is created on GPU
+	for ( uint32 index = PF_Unknown + 1; index < PF_Max; ++index )
+	{
+		GPixelFormats[ index ].supported = true;
+	}
+
+	GNullRHIStats.Reset();
+	LE_LOG( LT_Log, LC_Init, TEXT( "Null RHI is used, nothing will be rendered" ) );
+
+	isInitialize = true;
+
+	// Initialize all global render resources
+	std::set< CRenderResource* >&			globalResourceList = CRenderResource::GetResourceList();
+	for ( auto it = globalResourceList.begin(), itEnd = globalResourceList.end(); it != itEnd; ++it )
+	{
+		( *it )->InitResource();
+	}
+}
+
+void CNullRHI::Destroy()
+{
+	if ( !isInitialize )		return;
+
+	// Release all global render resources
+	std::set< CRenderResource* >		globalResourceList = CRenderResource::GetResourceList();
+	for ( auto it = globalResourceList.begin(), itEnd = globalResourceList.end(); it != itEnd; ++it )
+	{
+		( *it )->ReleaseResource();
+	}
+
+	GNullRHIStats.Dump();
+
+	delete immediateContext;
+	immediateContext	= nullptr;
+	isInitialize		= false;
+}
+
+ViewportRHIRef_t CNullRHI::CreateViewport( WindowHandle_t InWindowHandle, uint32 InWidth, uint32 InHeight )
+{
+	NULLRHI_SCOPED_CALL( NRC_CreateViewport );
+	return new CNullViewportRHI( InWindowHandle, new CBaseSurfaceRHI(), InWidth, InHeight );
+}
+
+ViewportRHIRef_t CNullRHI::CreateViewport( SurfaceRHIParamRef_t InSurfaceRHI, uint32 InWidth, uint32 InHeight )
+{
+	NULLRHI_SCOPED_CALL( NRC_CreateViewport );
+	return new CNullViewportRHI( nullptr, InSurfaceRHI, InWidth, InHeight );
+}
+
+VertexShaderRHIRef_t CNullRHI::CreateVertexShader( const tchar* InShaderName, const byte* InData, uint32 InSize )
+{
+	NULLRHI_SCOPED_CALL( NRC_CreateShader );
+	return new CBaseShaderRHI( SF_Vertex, InShaderName );
+}
+
+HullShaderRHIRef_t CNullRHI::CreateHullShader( const tchar* InShaderName, const byte* InData, uint32 InSize )
+{
+	NULLRHI_SCOPED_CALL( NRC_CreateShader );
+	return new CBaseShaderRHI( SF_Hull, InShaderName );
+}
+
+DomainShaderRHIRef_t CNullRHI::CreateDomainShader( const tchar* InShaderName, const byte* InData, uint32 InSize )
+{
+	NULLRHI_SCOPED_CALL( NRC_CreateShader );
+	return new CBaseShaderRHI( SF_Domain, InShaderName );
+}
+
+PixelShaderRHIRef_t CNullRHI::CreatePixelShader( const tchar* InShaderName, const byte* InData, uint32 InSize )
+{
+	NULLRHI_SCOPED_CALL( NRC_CreateShader );
+	return new CBaseShaderRHI( SF_Pixel, InShaderName );
+}
+
+GeometryShaderRHIRef_t CNullRHI::CreateGeometryShader( const tchar* InShaderName, const byte* InData, uint32 InSize )
+{
+	NULLRHI_SCOPED_CALL( NRC_CreateShader );
+	return new CBaseShaderRHI( SF_Geometry, InShaderName );
+}
+
+VertexBufferRHIRef_t CNullRHI::CreateVertexBuffer( const tchar* InBufferName, uint32 InSize, const byte* InData, uint32 InUsage )
+{
+	NULLRHI_SCOPED_CALL( NRC_CreateVertexBuffer );
+	if ( InData )
+	{
+		GNullRHIStats.AddUploadedBytes( InSize );
+	}
+	return new CNullVertexBufferRHI( InUsage, InSize );
+}
+
+IndexBufferRHIRef_t CNullRHI::CreateIndexBuffer( const tchar* InBufferName, uint32 InStride, uint32 InSize, const byte* InData, uint32 InUsage )
+{
+	NULLRHI_SCOPED_CALL( NRC_CreateIndexBuffer );
+	if ( InData )
+	{
+		GNullRHIStats.AddUploadedBytes( InSize );
+	}
+	return new CNullIndexBufferRHI( InUsage, InStride, InSize );
+}
+
+VertexDeclarationRHIRef_t CNullRHI::CreateVertexDeclaration( const VertexDeclarationElementList_t& InElementList )
+{
+	NULLRHI_SCOPED_CALL( NRC_CreateVertexDeclaration );
+	return new CBaseVertexDeclarationRHI( InElementList );
+}
+
+BoundShaderStateRHIRef_t CNullRHI::CreateBoundShaderState( const tchar* InBoundShaderStateName, VertexDeclarationRHIRef_t InVertexDeclaration, VertexShaderRHIRef_t InVertexShader, PixelShaderRHIRef_t InPixelShader, HullShaderRHIRef_t InHullShader /* = nullptr */, DomainShaderRHIRef_t InDomainShader /* = nullptr */, GeometryShaderRHIRef_t InGeometryShader /* = nullptr */, bool* OutIsCreated /* = nullptr */ )
+{
+	NULLRHI_SCOPED_CALL( NRC_CreateBoundShaderState );
+	CBoundShaderStateKey			key( InVertexDeclaration, InVertexShader, InPixelShader, InHullShader, InDomainShader, InGeometryShader );
+	CScopeLock						scopeLock( boundShaderStateHistory.GetCriticalSection() );
+	BoundShaderStateRHIRef_t		boundShaderStateRHI = boundShaderStateHistory.Find( key );
+	if ( OutIsCreated )
+	{
+		*OutIsCreated = !boundShaderStateRHI;
+	}
+
+	if ( !boundShaderStateRHI )
+	{
+		boundShaderStateRHI = new CNullBoundShaderStateRHI( key, InVertexDeclaration, InVertexShader, InPixelShader, InHullShader, InDomainShader, InGeometryShader );
+		boundShaderStateHistory.Add( key, boundShaderStateRHI );
+	}
+
+	return boundShaderStateRHI;
+}
+
+RasterizerStateRHIRef_t CNullRHI::CreateRasterizerState( const SRasterizerStateInitializerRHI& InInitializer )
+{
+	NULLRHI_SCOPED_CALL( NRC_CreateState );
+	return new CBaseRasterizerStateRHI( InInitializer );
+}
+
+SamplerStateRHIRef_t CNullRHI::CreateSamplerState( const SSamplerStateInitializerRHI& InInitializer )
+{
+	NULLRHI_SCOPED_CALL( NRC_CreateState );
+	return new CBaseSamplerStateRHI();
+}
+
+DepthStateRHIRef_t CNullRHI::CreateDepthState( const SDepthStateInitializerRHI& InInitializer )
+{
+	NULLRHI_SCOPED_CALL( NRC_CreateState );
+	return new CBaseDepthStateRHI();
+}
+
+BlendStateRHIRef_t CNullRHI::CreateBlendState( const SBlendStateInitializerRHI& InInitializer )
+{
+	NULLRHI_SCOPED_CALL( NRC_CreateState );
+	return new CBaseBlendStateRHI();
+}
+
+StencilStateRHIRef_t CNullRHI::CreateStencilState( const SStencilStateInitializerRHI& InInitializer )
+{
+	NULLRHI_SCOPED_CALL( NRC_CreateState );
+	return new CBaseStencilStateRHI();
+}
+
+Texture2DRHIRef_t CNullRHI::CreateTexture2D( const tchar* InDebugName, uint32 InSizeX, uint32 InSizeY, EPixelFormat InFormat, uint32 InNumMips, uint32 InFlags, void* InData /* = nullptr */ )
+{
+	NULLRHI_SCOPED_CALL( NRC_CreateTexture2D );
+	if ( InData )
+	{
+		GNullRHIStats.AddUploadedBytes( GetMipBytes( InFormat, InSizeX, InSizeY, 0 ) );
+	}
+	return new CBaseTextureRHI( InSizeX, InSizeY, InNumMips, InFormat, InFlags );
+}
+
+SurfaceRHIRef_t CNullRHI::CreateTargetableSurface( const tchar* InDebugName, uint32 InSizeX, uint32 InSizeY, EPixelFormat InFormat, Texture2DRHIParamRef_t InResolveTargetTexture, uint32 InFlags )
+{
+	NULLRHI_SCOPED_CALL( NRC_CreateTargetableSurface );
+	return new CBaseSurfaceRHI();
+}
+
+void CNullRHI::BeginDrawingViewport( class CBaseDeviceContextRHI* InDeviceContext, class CBaseViewportRHI* InViewport )
+{
+	check( InDeviceContext && InViewport );
+	NULLRHI_SCOPED_CALL( NRC_BeginDrawingViewport );
+
+	// Clear state cache
+	( ( CNullDeviceContextRHI* )InDeviceContext )->GetStateCache().Reset();
+	InDeviceContext->InvalidateStateCache();
+
+	SetRenderTarget( InDeviceContext, InViewport->GetSurface(), nullptr );
+	SetViewport( InDeviceContext, 0, 0, 0.f, InViewport->GetWidth(), InViewport->GetHeight(), 1.f );
+}
+
+void CNullRHI::EndDrawingViewport( class CBaseDeviceContextRHI* InDeviceContext, class CBaseViewportRHI* InViewport, bool InIsPresent, bool InLockToVsync )
+{
+	check( InViewport );
+	{
+		NULLRHI_SCOPED_CALL( NRC_EndDrawingViewport );
+		if ( InIsPresent )
+		{
+			InViewport->Present( InLockToVsync );
+		}
+	}
+
+	GNullRHIStats.EndFrame();
+}
+
+CommandListRHIRef_t CNullRHI::CreateCommandList()
+{
+	return new CBaseCommandListRHI( immediateContext );
+}
+
+EShaderPlatform CNullRHI::GetShaderPlatform() const
+{
+	// Shaders isn't compiled by null RHI, so we use cooked shaders of PC
+	return SP_PCD3D_SM5;
+}
+
+#if WITH_IMGUI
+void CNullRHI::DrawImGUI( class CBaseDeviceContextRHI* InDeviceContext, struct ImDrawData* InImGUIDrawData )
+{
+	NULLRHI_SCOPED_CALL( NRC_DrawImGUI );
+}
+#endif // WITH_IMGUI
+
+void CNullRHI::BeginDrawEvent( class CBaseDeviceContextRHI* InDeviceContext, const CColor& InColor, const tchar* InName )
+{
+	NULLRHI_SCOPED_CALL( NRC_DrawEvent );
+}
+
+void CNullRHI::EndDrawEvent( class CBaseDeviceContextRHI* InDeviceContext )
+{
+	NULLRHI_SCOPED_CALL( NRC_DrawEvent );
+}
+
+void CNullRHI::SetupInstancing( class CBaseDeviceContextRHI* InDeviceContext, uint32 InStreamIndex, void* InInstanceData, uint32 InInstanceStride, uint32 InInstanceSize, uint32 InNumInstances )
+{
+	NULLRHI_SCOPED_CALL( NRC_SetupInstancing );
+	GNullRHIStats.AddUploadedBytes( InInstanceSize );
+}
+
+void CNullRHI::SetViewport( class CBaseDeviceContextRHI* InDeviceContext, uint32 InMinX, uint32 InMinY, float InMinZ, uint32 InMaxX, uint32 InMaxY, float InMaxZ )
+{
+	NULLRHI_SCOPED_CALL( NRC_SetViewport );
+	SNullStateCache&		stateCache = ( ( CNullDeviceContextRHI* )InDeviceContext )->GetStateCache();
+
+	viewport = { InMinX, InMinY, InMinZ, InMaxX, InMaxY, InMaxZ };
+	UpdateState( stateCache.viewport, viewport );
+}
+
+void CNullRHI::SetBoundShaderState( class CBaseDeviceContextRHI* InDeviceContext, BoundShaderStateRHIParamRef_t InBoundShaderState )
+{
+	NULLRHI_SCOPED_CALL( NRC_SetBoundShaderState );
+	UpdateState( ( ( CNullDeviceContextRHI* )InDeviceContext )->GetStateCache().boundShaderState, InBoundShaderState );
+}
+
+void CNullRHI::SetStreamSource( class CBaseDeviceContextRHI* InDeviceContext, uint32 InStreamIndex, VertexBufferRHIParamRef_t InVertexBuffer, uint32 InStride, uint32 InOffset )
+{
+	check( InStreamIndex < NULLRHI_MAX_STREAMS );
+	NULLRHI_SCOPED_CALL( NRC_SetStreamSource );
+
+	SNullStateCache::SStreamSource		streamSource = { InVertexBuffer, InStride, InOffset };
+	UpdateState( ( ( CNullDeviceContextRHI* )InDeviceContext )->GetStateCache().streamSources[ InStreamIndex ], streamSource );
+}
+
+void CNullRHI::SetRasterizerState( class CBaseDeviceContextRHI* InDeviceContext, RasterizerStateRHIParamRef_t InNewState )
+{
+	NULLRHI_SCOPED_CALL( NRC_SetRasterizerState );
+	UpdateState( ( ( CNullDeviceContextRHI* )InDeviceContext )->GetStateCache().rasterizerState, InNewState );
+}
+
+void CNullRHI::SetSamplerState( class CBaseDeviceContextRHI* InDeviceContext, PixelShaderRHIParamRef_t InPixelShader, SamplerStateRHIParamRef_t InNewState, uint32 InStateIndex )
+{
+	check( InStateIndex < NULLRHI_MAX_TEXTURES );
+	NULLRHI_SCOPED_CALL( NRC_SetSamplerState );
+	UpdateState( ( ( CNullDeviceContextRHI* )InDeviceContext )->GetStateCache().samplerStates[ InStateIndex ], InNewState );
+}
+
+void CNullRHI::SetTextureParameter( class CBaseDeviceContextRHI* InDeviceContext, PixelShaderRHIParamRef_t InPixelShader, TextureRHIParamRef_t InTexture, uint32 InTextureIndex )
+{
+	check( InTextureIndex < NULLRHI_MAX_TEXTURES );
+	NULLRHI_SCOPED_CALL( NRC_SetTextureParameter );
+	UpdateState( ( ( CNullDeviceContextRHI* )InDeviceContext )->GetStateCache().textures[ InTextureIndex ], InTexture );
+}
+
+void CNullRHI::SetViewParameters( class CBaseDeviceContextRHI* InDeviceContext, class CSceneView& InSceneView )
+{
+	NULLRHI_SCOPED_CALL( NRC_SetViewParameters );
+}
+
+void CNullRHI::SetRenderTarget( class CBaseDeviceContextRHI* InDeviceContext, SurfaceRHIParamRef_t InNewRenderTarget, SurfaceRHIParamRef_t InNewDepthStencilTarget )
+{
+	NULLRHI_SCOPED_CALL( NRC_SetRenderTarget );
+	SNullStateCache&		stateCache = ( ( CNullDeviceContextRHI* )InDeviceContext )->GetStateCache();
+
+	UpdateState( stateCache.renderTarget, InNewRenderTarget );
+	UpdateState( stateCache.depthStencilTarget, InNewDepthStencilTarget );
+}
+
+void CNullRHI::SetMRTRenderTarget( class CBaseDeviceContextRHI* InDeviceContext, SurfaceRHIParamRef_t InNewRenderTarget, uint32 InTargetIndex )
+{
+	NULLRHI_SCOPED_CALL( NRC_SetRenderTarget );
+	if ( InTargetIndex == 0 )
+	{
+		UpdateState( ( ( CNullDeviceContextRHI* )InDeviceContext )->GetStateCache().renderTarget, InNewRenderTarget );
+	}
+}
+
+void CNullRHI::SetVertexShaderParameter( class CBaseDeviceContextRHI* InDeviceContext, uint32 InBufferIndex, uint32 InBaseIndex, uint32 InNumBytes, const void* InNewValue )
+{
+	NULLRHI_SCOPED_CALL( NRC_SetShaderParameter );
+	GNullRHIStats.currentFrame.bytesConstants += InNumBytes;
+	( ( CNullDeviceContextRHI* )InDeviceContext )->GetVertexConstantBuffer().Update( InBaseIndex, InNumBytes );
+}
+
+void CNullRHI::SetPixelShaderParameter( class CBaseDeviceContextRHI* InDeviceContext, uint32 InBufferIndex, uint32 InBaseIndex, uint32 InNumBytes, const void* InNewValue )
+{
+	NULLRHI_SCOPED_CALL( NRC_SetShaderParameter );
+	GNullRHIStats.currentFrame.bytesConstants += InNumBytes;
+	( ( CNullDeviceContextRHI* )InDeviceContext )->GetPixelConstantBuffer().Update( InBaseIndex, InNumBytes );
+}
+
+void CNullRHI::SetDepthState( class CBaseDeviceContextRHI* InDeviceContext, DepthStateRHIParamRef_t InNewState )
+{
+	NULLRHI_SCOPED_CALL( NRC_SetDepthState );
+	UpdateState( ( ( CNullDeviceContextRHI* )InDeviceContext )->GetStateCache().depthState, InNewState );
+}
+
+void CNullRHI::SetBlendState( class CBaseDeviceContextRHI* InDeviceContext, BlendStateRHIParamRef_t InNewState )
+{
+	NULLRHI_SCOPED_CALL( NRC_SetBlendState );
+	UpdateState( ( ( CNullDeviceContextRHI* )InDeviceContext )->GetStateCache().blendState, InNewState );
+}
+
+void CNullRHI::SetStencilState( class CBaseDeviceContextRHI* InDeviceContext, StencilStateRHIParamRef_t InNewState )
+{
+	NULLRHI_SCOPED_CALL( NRC_SetStencilState );
+	UpdateState( ( ( CNullDeviceContextRHI* )InDeviceContext )->GetStateCache().stencilState, InNewState );
+}
+
+void CNullRHI::CommitConstants( class CBaseDeviceContextRHI* InDeviceContext )
+{
+	NULLRHI_SCOPED_CALL( NRC_CommitConstants );
+
+	// Emulate commit of changed buffers, with the ring only used range is written, without it whole buffer is uploaded
+	CNullDeviceContextRHI*		deviceContext = ( CNullDeviceContextRHI* )InDeviceContext;
+	SNullConstantBufferRing&	constantBufferRing = deviceContext->GetConstantBufferRing();
+	SNullConstantBuffer*		constantBuffers[] = { &deviceContext->GetVertexConstantBuffer(), &deviceContext->GetPixelConstantBuffer() };
+	bool						bRewrite = false;
+	for ( ;; )
+	{
+		bool		bRingDiscarded = false;
+		for ( uint32 index = 0; index < ARRAY_COUNT( constantBuffers ); ++index )
+		{
+			SNullConstantBuffer*	constantBuffer = constantBuffers[ index ];
+			if ( !constantBuffer->bDirty )
+			{
+				continue;
+			}
+
+			const uint32			ringSize = Align( Max( constantBuffer->usedSize, ( uint32 )16 ), ( uint32 )RHI_CONSTANTBUFFER_RING_ALIGNMENT );
+			bRingDiscarded |= constantBufferRing.Allocate( ringSize );
+			GNullRHIStats.currentFrame.bytesConstantsRing += ringSize;
+			if ( bRewrite )
+			{
+				GNullRHIStats.currentFrame.bytesConstantsRewrite += ringSize;
+			}
+			else
+			{
+				++GNullRHIStats.currentFrame.numConstantBufferCommits;
+				GNullRHIStats.currentFrame.bytesConstantsFull += MAX_GLOBAL_CONSTANT_BUFFER_SIZE;
+			}
+			constantBuffer->bDirty = false;
+		}
+
+		if ( !bRingDiscarded )
+		{
+			break;
+		}
+
+		// The same as in D3D11 RHI, after discard all bound buffers are written into the ring again
+		++GNullRHIStats.currentFrame.numConstantBufferRingDiscards;
+		for ( uint32 index = 0; index < ARRAY_COUNT( constantBuffers ); ++index )
+		{
+			constantBuffers[ index ]->bDirty = true;
+		}
+		bRewrite = true;
+	}
+}
+
+void CNullRHI::LockVertexBuffer( class CBaseDeviceContextRHI* InDeviceContext, const VertexBufferRHIRef_t InVertexBuffer, uint32 InSize, uint32 InOffset, SLockedData& OutLockedData )
+{
+	check( OutLockedData.data == nullptr && InOffset < InSize );
+	NULLRHI_SCOPED_CALL( NRC_LockBuffer );
+
+	OutLockedData.data			= ( ( CNullVertexBufferRHI* )InVertexBuffer.GetPtr() )->GetLockMemory() + InOffset;
+	OutLockedData.size			= InSize - InOffset;
+	OutLockedData.pitch			= InSize;
+	OutLockedData.isNeedFree	= false;
+}
+
+void CNullRHI::UnlockVertexBuffer( class CBaseDeviceContextRHI* InDeviceContext, const VertexBufferRHIRef_t InVertexBuffer, SLockedData& InLockedData )
+{
+	check( InLockedData.data );
+	NULLRHI_SCOPED_CALL( NRC_UnlockBuffer );
+
+	GNullRHIStats.AddUploadedBytes( InLockedData.size );
+	InLockedData.data = nullptr;
+}
+
+void CNullRHI::LockIndexBuffer( class CBaseDeviceContextRHI* InDeviceContext, const IndexBufferRHIRef_t InIndexBuffer, uint32 InSize, uint32 InOffset, SLockedData& OutLockedData )
+{
+	check( OutLockedData.data == nullptr && InOffset < InSize );
+	NULLRHI_SCOPED_CALL( NRC_LockBuffer );
+
+	OutLockedData.data			= ( ( CNullIndexBufferRHI* )InIndexBuffer.GetPtr() )->GetLockMemory() + InOffset;
+	OutLockedData.size			= InSize - InOffset;
+	OutLockedData.pitch			= InSize;
+	OutLockedData.isNeedFree	= false;
+}
+
+void CNullRHI::UnlockIndexBuffer( class CBaseDeviceContextRHI* InDeviceContext, const IndexBufferRHIRef_t InIndexBuffer, SLockedData& InLockedData )
+{
+	check( InLockedData.data );
+	NULLRHI_SCOPED_CALL( NRC_UnlockBuffer );
+
+	GNullRHIStats.AddUploadedBytes( InLockedData.size );
+	InLockedData.data = nullptr;
+}
+
+void CNullRHI::LockTexture2D( class CBaseDeviceContextRHI* InDeviceContext, Texture2DRHIParamRef_t InTexture, uint32 InMipIndex, bool InIsDataWrite, SLockedData& OutLockedData, bool InIsUseCPUShadow /* = false */ )
+{
+	check( OutLockedData.data == nullptr && InTexture );
+	NULLRHI_SCOPED_CALL( NRC_LockTexture2D );
+
+	const SPixelFormatInfo&		formatInfo	= GPixelFormats[ InTexture->GetFormat() ];
+	const uint32				mipBytes	= GetMipBytes( InTexture->GetFormat(), InTexture->GetSizeX(), InTexture->GetSizeY(), InMipIndex );
+	const uint32				mipSizeX	= Max( InTexture->GetSizeX() >> InMipIndex, formatInfo.blockSizeX );
+
+	OutLockedData.data			= new byte[ mipBytes ];
+	OutLockedData.size			= mipBytes;
+	OutLockedData.pitch			= formatInfo.blockSizeX > 0 ? ( mipSizeX + formatInfo.blockSizeX - 1 ) / formatInfo.blockSizeX * formatInfo.blockBytes : 0;
+	OutLockedData.isNeedFree	= true;
+
+	// Content of texture isn't stored, so we count data as uploaded only when it is written
+	if ( InIsDataWrite )
+	{
+		GNullRHIStats.AddUploadedBytes( mipBytes );
+	}
+}
+
+void CNullRHI::UnlockTexture2D( class CBaseDeviceContextRHI* InDeviceContext, Texture2DRHIParamRef_t InTexture, uint32 InMipIndex, SLockedData& InLockedData )
+{
+	NULLRHI_SCOPED_CALL( NRC_UnlockTexture2D );
+}
+
+void CNullRHI::DrawPrimitive( class CBaseDeviceContextRHI* InDeviceContext, EPrimitiveType InPrimitiveType, uint32 InBaseVertexIndex, uint32 InNumPrimitives, uint32 InNumInstances /* = 1 */ )
+{
+	NULLRHI_SCOPED_CALL( NRC_DrawPrimitive );
+	UpdateState( ( ( CNullDeviceContextRHI* )InDeviceContext )->GetStateCache().primitiveType, InPrimitiveType );
+	AddDrawCall( InNumPrimitives, InNumInstances );
+}
+
+void CNullRHI::DrawIndexedPrimitive( class CBaseDeviceContextRHI* InDeviceContext, class CBaseIndexBufferRHI* InIndexBuffer, EPrimitiveType InPrimitiveType, uint32 InBaseVertexIndex, uint32 InStartIndex, uint32 InNumPrimitives, uint32 InNumInstances /* = 1 */ )
+{
+	check( InIndexBuffer );
+	NULLRHI_SCOPED_CALL( NRC_DrawIndexedPrimitive );
+
+	SNullStateCache&		stateCache = ( ( CNullDeviceContextRHI* )InDeviceContext )->GetStateCache();
+	UpdateState( stateCache.indexBuffer, ( IndexBufferRHIParamRef_t )InIndexBuffer );
+	UpdateState( stateCache.primitiveType, InPrimitiveType );
+	AddDrawCall( InNumPrimitives, InNumInstances );
+}
+
+void CNullRHI::CopyToResolveTarget( class CBaseDeviceContextRHI* InDeviceContext, SurfaceRHIParamRef_t InSourceSurface, const SResolveParams& InResolveParams )
+{
+	NULLRHI_SCOPED_CALL( NRC_CopyToResolveTarget );
+}
+
+void CNullRHI::CopySharedMips( class CBaseDeviceContextRHI* InDeviceContext, Texture2DRHIParamRef_t InDestTexture, Texture2DRHIParamRef_t InSourceTexture )
+{
+	check( InDestTexture && InSourceTexture && InDestTexture->GetFormat() == InSourceTexture->GetFormat() );
+	NULLRHI_SCOPED_CALL( NRC_CopySharedMips );
+}
+
+void CNullRHI::DrawPrimitiveUP( class CBaseDeviceContextRHI* InDeviceContext, EPrimitiveType InPrimitiveType, uint32 InBaseVertexIndex, uint32 InNumPrimitives, const void* InVertexData, uint32 InVertexDataStride, uint32 InNumInstances /* = 1 */ )
+{
+	NULLRHI_SCOPED_CALL( NRC_DrawPrimitive );
+
+	// User data is copied to dynamic buffer, also it changes stream source and primitive type
+	SNullStateCache&		stateCache = ( ( CNullDeviceContextRHI* )InDeviceContext )->GetStateCache();
+	stateCache.streamSources[ 0 ].vertexBuffer = nullptr;
+	UpdateState( stateCache.primitiveType, InPrimitiveType );
+	AddDrawCall( InNumPrimitives, InNumInstances );
+}
+
+void CNullRHI::DrawIndexedPrimitiveUP( class CBaseDeviceContextRHI* InDeviceContext, EPrimitiveType InPrimitiveType, uint32 InBaseVertexIndex, uint32 InNumPrimitives, uint32 InNumVertices, const void* InIndexData, uint32 InIndexDataStride, const void* InVertexData, uint32 InVertexDataStride, uint32 InNumInstances /* = 1 */ )
+{
+	NULLRHI_SCOPED_CALL( NRC_DrawIndexedPrimitive );
+	GNullRHIStats.AddUploadedBytes( InNumVertices * InVertexDataStride );
+
+	// User data is copied to dynamic buffers, also it changes stream source, index buffer and primitive type
+	SNullStateCache&		stateCache = ( ( CNullDeviceContextRHI* )InDeviceContext )->GetStateCache();
+	stateCache.streamSources[ 0 ].vertexBuffer	= nullptr;
+	stateCache.indexBuffer						= nullptr;
+	UpdateState( stateCache.primitiveType, InPrimitiveType );
+	AddDrawCall( InNumPrimitives, InNumInstances );
+}
+
+bool CNullRHI::IsInitialize() const
+{
+	return isInitialize;
+}
+
+const tchar* CNullRHI::GetRHIName() const
+{
+	return TEXT( "NullRHI" );
+}
+
+bool CNullRHI::IsNullRHI() const
+{
+	return true;
+}
+
+class CBaseDeviceContextRHI* CNullRHI::GetImmediateContext() const
+{
+	return immediateContext;
+}
+
+uint32 CNullRHI::GetViewportWidth() const
+{
+	return viewport.maxX - viewport.minX;
+}
+
+uint32 CNullRHI::GetViewportHeight() const
+{
+	return viewport.maxY - viewport.minY;
+}
\ No newline at end of file
@@ -0,0 +1,110 @@
+/**
+ * @file
+ * @addtogroup WorldEd World editor
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef BENCHMARKCOMMANDLET_H
+#define BENCHMARKCOMMANDLET_H
+
+#include "Commandlets/BaseCommandlet.h"
+
+/**
+ * @ingroup WorldEd
+ * Commandlet for run micro benchmarks of core systems
+ * 
+ * Usage: -commandlet benchmark [-delegates] [-hash] [-drawlists] [-mips] [-bc] [-mesh] [-tilemap] [-lod] [-lights] [-occlusion] [-overdraw] [-picking] [-yuv]
+ * If not specified any benchmark, all of them will be executed
+ */
+class CBenchmarkCommandlet : public CBaseCommandlet
+{
+	DECLARE_CLASS( CBenchmarkCommandlet, CBaseCommandlet )
+
+public:
+	/**
+	 * Main method of execute commandlet
+	 *
+	 * @param InCommandLine		Command line
+	 * @return Return TRUE if commandlet executed is seccussed, otherwise will return FALSE
+	 */
+	virtual bool Main( const CCommandLine& InCommandLine ) override;
+
+private:
+	/**
+	 * Benchmark selected by command line parameter
+	 */
+	struct SBenchmarkInfo
+	{
+		const tchar*		param;								/**< Command line parameter which selects benchmark */
+		void				( CBenchmarkCommandlet::*function )();	/**< Function of benchmark */
+	};
+
+	/**
+	 * Benchmark of multicast delegates, compare TMulticastDelegate with std::list<std::function>
+	 */
+	void BenchmarkDelegates();
+
+	/**
+	 * Benchmark of memory hashing, compare appMemFastHash with legacy byte-at-a-time hash
+	 */
+	void BenchmarkHash();
+
+	/**
+	 * Benchmark of draw lists of scene, count state changes per frame and measure draw time with and without sort of drawing policies
+	 */
+	void BenchmarkDrawLists();
+
+	/**
+	 * Benchmark of mip chain generation, measure throughput of GenerateMipChain in sRGB and linear space
+	 */
+	void BenchmarkMips();
+
+	/**
+	 * Benchmark of texture block compression, measure encode speed and PSNR of BC1, BC3, BC5 and BC7
+	 */
+	void BenchmarkBlockCompression();
+
+	/**
+	 * Benchmark of mesh optimization, simulate vertex cache and report ACMR/ATVR before and after optimization
+	 */
+	void BenchmarkMeshOptimization();
+
+	/**
+	 * Benchmark of tile map, compare spawn, load and frame times of one sprite actor per tile with chunked tile map
+	 */
+	void BenchmarkTileMap();
+
+	/**
+	 * Benchmark of static mesh LODs, report generation time, triangles of selected LOD versus distance to camera and LOD switches of two views
+	 */
+	void BenchmarkStaticMeshLODs();
+
+	/**
+	 * Benchmark of light clustering, report culled lights, lights per cluster and build time of light clusters for 100 to 10000 lights
+	 */
+	void BenchmarkLightClustering();
+
+	/**
+	 * Benchmark of software occlusion culling, report rasterization time of occluders, test time and culled objects behind rows of buildings
+	 */
+	void BenchmarkOcclusionCulling();
+
+	/**
+	 * Benchmark of overdraw, report shaded pixels of CPU rasterized instances without sorting, with front to back sorting and with depth pre-pass
+	 */
+	void BenchmarkOverdraw();
+
+	/**
+	 * Benchmark of picking, compare ray casts against BVH of scene and triangles of meshes with brute force test of all triangles
+	 */
+	void BenchmarkPicking();
+
+	/**
+	 * Benchmark of conversion of movie frames from YUV420 to texture, compare SSE2 conversion with scalar per pixel loop at 1080p and 4K
+	 */
+	void BenchmarkYUVConversion();
+};
+
+#endif // !BENCHMARKCOMMANDLET_H
\ No newline at end of file
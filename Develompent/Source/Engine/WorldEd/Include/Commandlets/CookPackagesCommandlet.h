@@ -334,6 +334,18 @@ private:
 	 */
 	bool LoadTMXTilests( const tmx::Map& InTMXMap, std::vector< STMXTileset >& OutTilesets );
 
+	/**
+	 * @brief Pack textures of tilesets into atlases
+	 *
+	 * Tilesets with materials which differ only by diffuse texture are packed into one atlas with a new material,
+	 * their material and texture rects are replaced to atlas
+	 *
+	 * @param InMapInfo Info about map
+	 * @param InOutTilesets Array of tilesets
+	 * @return Return true if seccussed, else returning false
+	 */
+	bool BuildTilesetAtlases( const SResourceInfo& InMapInfo, std::vector< STMXTileset >& InOutTilesets );
+
 	/**
 	 * @brief Spawn tiles in world
 	 * 
@@ -350,6 +362,13 @@ private:
 	 */
 	void SpawnActorsInWorld( const tmx::Map& InTMXMap, const std::vector< STMXTileset >& InTileset );
 
+	/**
+	 * @brief Record bound shader states used by actors in world into shader cache
+	 * 
+	 * @param InMapName Name of cooked map
+	 */
+	void RecordBoundShaderStates( const std::wstring& InMapName );
+
 	/**
 	 * Find tileset by ID tile
 	 *
@@ -477,6 +496,9 @@ private:
 	CShaderCache											shaderCache;			/**< Cooked shader cache */
 	EShaderPlatform											cookedShaderPlatform;	/**< Cooked shader platform */
 	EPlatformType											cookedPlatform;			/**< Cooked platform */
+	ETextureCompression										textureCompression;		/**< Compression of cooked textures */
+	bool													bAtlasTilesets;			/**< Is need pack tilesets of map into atlases */
+	uint32													atlasPadding;			/**< Padding around each tileset in atlas */
 };
 
 #endif // !COOKPACKAGESCOMMANDLET_H
\ No newline at end of file
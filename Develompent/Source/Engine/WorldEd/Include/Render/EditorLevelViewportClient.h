@@ -119,6 +119,17 @@ public:
 	 */
 	Vector WorldToScreen( const Vector& InWorldPoint, uint32 InViewportSizeX, uint32 InViewportSizeY );
 
+	/**
+	 * @brief Get actor under screen point
+	 * @note Ray is casted on CPU against BVH of scene and triangles of static meshes, so it doesn't render hit proxies
+	 *
+	 * @param InScreenPoint		Screen point
+	 * @param InViewportSizeX	Viewport size by X
+	 * @param InViewportSizeY	Viewport size by Y
+	 * @return Return the closest actor under screen point, if not found returns NULL
+	 */
+	ActorRef_t PickActor( const Vector2D& InScreenPoint, uint32 InViewportSizeX, uint32 InViewportSizeY );
+
 	/**
 	 * @brief Get viewport type
 	 * @return Return viewport type
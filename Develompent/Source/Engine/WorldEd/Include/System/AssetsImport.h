@@ -49,6 +49,24 @@ public:
 	 */
 	static bool Reimport( const TSharedPtr<CAsset>& InTexture2D, std::wstring& OutError );
 
+	/**
+	 * @brief Show import settings
+	 *
+	 * @param InOwner			Owner ImGUI layer
+	 * @param InEvent			Synchronize event, need trigger it when dialog is closed
+	 * @param OutResult			Result
+	 */
+	static void ShowImportSettings( class CImGUILayer* InOwner, class CEvent* InEvent, CAssetFactory::EResultShowImportSettings& OutResult );
+
+	/**
+	 * @brief Set import settings
+	 * @param InImportSettings		New import settings
+	 */
+	FORCEINLINE static void SetImportSettings( const CTexture2DImportSettingsDialog::SImportSettings& InImportSettings )
+	{
+		importSettings = InImportSettings;
+	}
+
 	/**
 	 * @brief Get supported texture extensions
 	 * @return Return list of supported texture extensions
@@ -70,6 +88,9 @@ public:
 		};
 		return supportedExtensions;
 	}
+
+private:
+	static CTexture2DImportSettingsDialog::SImportSettings		importSettings;		/**< Import settings */
 };
 
 /**
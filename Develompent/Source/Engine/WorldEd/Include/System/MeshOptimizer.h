@@ -0,0 +1,146 @@
+/**
+ * @file
+ * @addtogroup WorldEd WorldEd
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef MESHOPTIMIZER_H
+#define MESHOPTIMIZER_H
+
+#include <vector>
+
+#include "Misc/Types.h"
+#include "Render/StaticMesh.h"
+#include "Render/VertexFactory/StaticMeshVertexFactory.h"
+
+/**
+ * @ingroup WorldEd
+ * @brief Size of post-transform vertex cache used by simulator and optimizer
+ */
+#define MESHOPTIMIZER_CACHE_SIZE		16
+
+/**
+ * @ingroup WorldEd
+ * @brief Threshold of ACMR which the overdraw optimizer may lose for reduce overdraw
+ */
+#define MESHOPTIMIZER_OVERDRAW_THRESHOLD	1.05f
+
+/**
+ * @ingroup WorldEd
+ * @brief Default number of generated LODs of static mesh, including LOD 0
+ */
+#define MESHOPTIMIZER_NUM_LODS			4
+
+/**
+ * @ingroup WorldEd
+ * @brief Ratio of triangles and screen size of each LOD to previous one
+ */
+#define MESHOPTIMIZER_LOD_REDUCTION		0.5f
+
+/**
+ * @ingroup WorldEd
+ * @brief Statistics of post-transform vertex cache
+ */
+struct SVertexCacheStats
+{
+	uint32		numTransformed;		/**< Number of transformed vertices (cache misses) */
+	float		acmr;				/**< Average cache miss ratio, transformed vertices per triangle. Ideal is 0.5 */
+	float		atvr;				/**< Average transformed vertex ratio, transformed vertices per unique vertex. Ideal is 1.0 */
+};
+
+/**
+ * @ingroup WorldEd
+ * @brief Simulate FIFO post-transform vertex cache
+ *
+ * @param InIndeces			Indices of triangle list
+ * @param InNumIndeces		Number of indices
+ * @param InNumVerteces		Number of vertices
+ * @param InCacheSize		Size of cache
+ * @return Return statistics of vertex cache
+ */
+SVertexCacheStats AnalyzeVertexCache( const uint32* InIndeces, uint32 InNumIndeces, uint32 InNumVerteces, uint32 InCacheSize = MESHOPTIMIZER_CACHE_SIZE );
+
+/**
+ * @ingroup WorldEd
+ * @brief Reorder triangles for post-transform vertex cache
+ * @note Based on linear-speed vertex cache optimization by Tom Forsyth
+ *
+ * @param InOutIndeces		Indices of triangle list
+ * @param InNumIndeces		Number of indices
+ * @param InNumVerteces		Number of vertices
+ */
+void OptimizeVertexCache( uint32* InOutIndeces, uint32 InNumIndeces, uint32 InNumVerteces );
+
+/**
+ * @ingroup WorldEd
+ * @brief Reorder clusters of triangles for reduce overdraw
+ *
+ * Triangle list is split into clusters on vertex cache flushes, clusters are sorted from outer to inner of the mesh,
+ * so triangles which occlude others are drawn first. Must be called after OptimizeVertexCache
+ *
+ * @param InVerteces		Vertices
+ * @param InOutIndeces		Indices of triangle list
+ * @param InNumIndeces		Number of indices
+ * @param InNumVerteces		Number of vertices
+ * @param InThreshold		Max ratio of ACMR after and before. If it is exceeded the order isn't changed
+ */
+void OptimizeOverdraw( const SStaticMeshVertexType* InVerteces, uint32* InOutIndeces, uint32 InNumIndeces, uint32 InNumVerteces, float InThreshold = MESHOPTIMIZER_OVERDRAW_THRESHOLD );
+
+/**
+ * @ingroup WorldEd
+ * @brief Reorder vertices in order of first use by indices for pre-transform cache, unused vertices are removed
+ *
+ * @param InOutVerteces		Vertices
+ * @param InOutIndeces		Indices, they are remapped to new vertices
+ * @return Return number of removed vertices
+ */
+uint32 OptimizeVertexFetch( std::vector< SStaticMeshVertexType >& InOutVerteces, std::vector< uint32 >& InOutIndeces );
+
+/**
+ * @ingroup WorldEd
+ * @brief Optimize static mesh for GPU
+ *
+ * Each surface is optimized for vertex cache and overdraw, after that vertices of all surfaces are reordered for vertex fetch.
+ * Base vertex index of surfaces is applied to indices
+ *
+ * @param InOutVerteces		Vertices
+ * @param InOutIndeces		Indices
+ * @param InOutSurfaces		Surfaces
+ */
+void OptimizeStaticMesh( std::vector< SStaticMeshVertexType >& InOutVerteces, std::vector< uint32 >& InOutIndeces, std::vector< SStaticMeshSurface >& InOutSurfaces );
+
+/**
+ * @ingroup WorldEd
+ * @brief Simplify triangle list by collapsing edges with the smallest quadric error
+ *
+ * Vertices aren't moved or created, the collapsed vertex is replaced by the other end of the edge, so the result uses
+ * the same vertex buffer. Vertices on open borders and on seams (vertices with the same position) are locked,
+ * collapses which flip triangles are rejected
+ *
+ * @param InVerteces		Vertices
+ * @param InNumVerteces		Number of vertices
+ * @param InIndeces			Indices of triangle list
+ * @param InNumIndeces		Number of indices
+ * @param InTargetNumIndeces	Wanted number of indices, the result may have more if there are no valid collapses
+ * @param OutIndeces		Output indices of simplified triangle list
+ */
+void SimplifyMesh( const SStaticMeshVertexType* InVerteces, uint32 InNumVerteces, const uint32* InIndeces, uint32 InNumIndeces, uint32 InTargetNumIndeces, std::vector< uint32 >& OutIndeces );
+
+/**
+ * @ingroup WorldEd
+ * @brief Generate LODs of static mesh
+ *
+ * Each LOD has MESHOPTIMIZER_LOD_REDUCTION of triangles and screen size of previous one, its indices are added to the end of InOutIndeces.
+ * Generation is stopped when LOD can't be reduced enough. Must be called after OptimizeStaticMesh
+ *
+ * @param InVerteces		Vertices
+ * @param InOutIndeces		Indices
+ * @param InSurfaces		Surfaces of LOD 0
+ * @param OutLODs			Output array of LODs after LOD 0
+ * @param InNumLODs			Max number of LODs, including LOD 0
+ */
+void GenerateStaticMeshLODs( const std::vector< SStaticMeshVertexType >& InVerteces, std::vector< uint32 >& InOutIndeces, const std::vector< SStaticMeshSurface >& InSurfaces, std::vector< SStaticMeshLOD >& OutLODs, uint32 InNumLODs = MESHOPTIMIZER_NUM_LODS );
+
+#endif // !MESHOPTIMIZER_H
\ No newline at end of file
@@ -0,0 +1,145 @@
+/**
+ * @file
+ * @addtogroup WorldEd WorldEd
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef TEXTUREATLAS_H
+#define TEXTUREATLAS_H
+
+#include <vector>
+
+#include "Misc/Types.h"
+#include "Math/Rect.h"
+
+/**
+ * @ingroup WorldEd
+ * @brief Max size of texture atlas by each axis
+ */
+#define TEXTUREATLAS_MAX_SIZE			4096
+
+/**
+ * @ingroup WorldEd
+ * @brief Default padding around each image in texture atlas
+ */
+#define TEXTUREATLAS_DEFAULT_PADDING	4
+
+/**
+ * @ingroup WorldEd
+ * @brief Builder of texture atlas
+ *
+ * Packs images into one texture with size in power of two. Each image is surrounded by padding which is filled by
+ * repeating the edge texels of the image, so filtering and first mips don't bleed texels of neighbors.
+ * Images are placed by 4x4 blocks for avoid mixing of neighbors in block compression
+ */
+class CTextureAtlasBuilder
+{
+public:
+	/**
+	 * @brief Constructor
+	 *
+	 * @param InMaxSize		Max size of atlas by each axis
+	 * @param InPadding		Padding around each image in texels
+	 */
+	CTextureAtlasBuilder( uint32 InMaxSize = TEXTUREATLAS_MAX_SIZE, uint32 InPadding = TEXTUREATLAS_DEFAULT_PADDING );
+
+	/**
+	 * @brief Add image to atlas
+	 *
+	 * @param InSizeX		Width of image
+	 * @param InSizeY		Height of image
+	 * @param InData		Data of image in PF_A8R8G8B8, it must be valid until Build is called
+	 * @return Return index of image in atlas
+	 */
+	uint32 AddImage( uint32 InSizeX, uint32 InSizeY, const byte* InData );
+
+	/**
+	 * @brief Pack all added images and build atlas
+	 * @return Return TRUE if all images are fit into the atlas, else returning FALSE
+	 */
+	bool Build();
+
+	/**
+	 * @brief Convert texture rect of image to texture rect in atlas
+	 *
+	 * @param InIndex		Index of image
+	 * @param InRect		Texture rect in image in range from 0 to 1
+	 * @return Return texture rect in atlas in range from 0 to 1
+	 */
+	RectFloat_t TransformRect( uint32 InIndex, const RectFloat_t& InRect ) const;
+
+	/**
+	 * @brief Get width of atlas
+	 * @return Return width of atlas
+	 */
+	FORCEINLINE uint32 GetSizeX() const
+	{
+		return sizeX;
+	}
+
+	/**
+	 * @brief Get height of atlas
+	 * @return Return height of atlas
+	 */
+	FORCEINLINE uint32 GetSizeY() const
+	{
+		return sizeY;
+	}
+
+	/**
+	 * @brief Get data of atlas
+	 * @return Return data of atlas in PF_A8R8G8B8
+	 */
+	FORCEINLINE const std::vector< byte >& GetData() const
+	{
+		return data;
+	}
+
+	/**
+	 * @brief Get number of images
+	 * @return Return number of images in atlas
+	 */
+	FORCEINLINE uint32 GetNumImages() const
+	{
+		return images.size();
+	}
+
+	/**
+	 * @brief Get occupancy of atlas
+	 * @return Return ratio of texels of images to all texels in atlas
+	 */
+	float GetOccupancy() const;
+
+private:
+	/**
+	 * @brief Image in atlas
+	 */
+	struct SImage
+	{
+		uint32			sizeX;		/**< Width of image */
+		uint32			sizeY;		/**< Height of image */
+		const byte*		data;		/**< Data of image */
+		uint32			x;			/**< Offset by X in atlas, without padding */
+		uint32			y;			/**< Offset by Y in atlas, without padding */
+	};
+
+	/**
+	 * @brief Try to pack all images into atlas with size
+	 *
+	 * @param InSizeX		Width of atlas
+	 * @param InSizeY		Height of atlas
+	 * @return Return TRUE if all images are packed, else returning FALSE
+	 */
+	bool Pack( uint32 InSizeX, uint32 InSizeY );
+
+	uint32						maxSize;	/**< Max size of atlas by each axis */
+	uint32						padding;	/**< Padding around each image */
+	uint32						sizeX;		/**< Width of atlas */
+	uint32						sizeY;		/**< Height of atlas */
+	std::vector< SImage >		images;		/**< Array of images */
+	std::vector< byte >			data;		/**< Data of atlas in PF_A8R8G8B8 */
+};
+
+#endif // !TEXTUREATLAS_H
\ No newline at end of file
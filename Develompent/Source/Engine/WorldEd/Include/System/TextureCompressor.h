@@ -0,0 +1,74 @@
+/**
+ * @file
+ * @addtogroup WorldEd WorldEd
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef TEXTURECOMPRESSOR_H
+#define TEXTURECOMPRESSOR_H
+
+#include <vector>
+
+#include "Misc/Types.h"
+#include "RHI/BaseSurfaceRHI.h"
+#include "Render/Texture.h"
+
+/**
+ * @ingroup WorldEd
+ * @brief Get pixel format of texture after compression
+ *
+ * @param InCompression		Compression settings
+ * @param InSizeX			Width of top mip
+ * @param InSizeY			Height of top mip
+ * @param InData			Data of top mip in PF_A8R8G8B8, used by TC_Default for detect alpha
+ * @return Return block compressed pixel format. If the texture can't be compressed returns PF_A8R8G8B8
+ */
+EPixelFormat GetCompressedPixelFormat( ETextureCompression InCompression, uint32 InSizeX, uint32 InSizeY, const byte* InData );
+
+/**
+ * @ingroup WorldEd
+ * @brief Compress mip chain to block compressed pixel format
+ *
+ * Supported BC1, BC3, BC5 and BC7. Blocks are encoded in parallel on all cores, mips smaller than a block are padded by
+ * repeating the edge texels
+ *
+ * @param InPixelFormat		Block compressed pixel format
+ * @param InSizeX			Width of top mip
+ * @param InSizeY			Height of top mip
+ * @param InNumMips			Number of mips
+ * @param InData			Data of mip chain in PF_A8R8G8B8
+ * @param OutData			Output data of mip chain in InPixelFormat
+ * @return Return TRUE if mip chain is compressed, else returning FALSE
+ */
+bool CompressMipChain( EPixelFormat InPixelFormat, uint32 InSizeX, uint32 InSizeY, uint32 InNumMips, const byte* InData, std::vector< byte >& OutData );
+
+/**
+ * @ingroup WorldEd
+ * @brief Compress mip chain of a texture by compression settings
+ *
+ * @param InCompression		Compression settings
+ * @param InSizeX			Width of top mip
+ * @param InSizeY			Height of top mip
+ * @param InNumMips			Number of mips
+ * @param InData			Data of mip chain in PF_A8R8G8B8
+ * @param OutData			Output data of mip chain
+ * @return Return pixel format of OutData. If the texture isn't compressed, InData is copied and returns PF_A8R8G8B8
+ */
+EPixelFormat CompressTexture( ETextureCompression InCompression, uint32 InSizeX, uint32 InSizeY, uint32 InNumMips, const std::vector< byte >& InData, std::vector< byte >& OutData );
+
+/**
+ * @ingroup WorldEd
+ * @brief Decompress one mip from block compressed pixel format to PF_A8R8G8B8
+ * @note For BC7 supported only mode 6 which written by CompressMipChain. Used for measure quality of compression
+ *
+ * @param InPixelFormat		Block compressed pixel format
+ * @param InSizeX			Width of mip
+ * @param InSizeY			Height of mip
+ * @param InData			Data of mip in InPixelFormat
+ * @param OutData			Output texels in PF_A8R8G8B8, must be InSizeX * InSizeY * 4 bytes
+ */
+void DecompressMip( EPixelFormat InPixelFormat, uint32 InSizeX, uint32 InSizeY, const byte* InData, byte* OutData );
+
+#endif // !TEXTURECOMPRESSOR_H
\ No newline at end of file
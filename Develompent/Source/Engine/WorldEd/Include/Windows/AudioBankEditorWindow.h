@@ -76,8 +76,8 @@ private:
 	SAudioBankInfo											audioBankInfo;			/**< Audio bank info */
 	AudioBankHandle_t										audioBankHandle;		/**< Audio bank handle */
 	class CAudioComponent*									audioComponent;			/**< Audio component */
-	SEditorDelegates::COnAssetsCanDelete::DelegateType_t*	assetsCanDeleteHandle;	/**< Handle delegate of assets can delete */
-	SEditorDelegates::COnAssetsReloaded::DelegateType_t*	assetsReloadedHandle;	/**< Handle delegate of reloaded assets */
+	CDelegateHandle											assetsCanDeleteHandle;	/**< Handle delegate of assets can delete */
+	CDelegateHandle											assetsReloadedHandle;	/**< Handle delegate of reloaded assets */
 };
 
 #endif // !AUDIOBANKEDITORWINDOW_H
\ No newline at end of file
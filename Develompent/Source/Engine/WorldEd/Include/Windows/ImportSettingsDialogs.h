@@ -12,6 +12,7 @@
 #include "ImGUI/ImGUIEngine.h"
 #include "System/Delegate.h"
 #include "System/Package.h"
+#include "Render/Texture.h"
 
 /**
  * @ingroup WorldEd
@@ -83,4 +84,56 @@ private:
 	mutable COnResume		onResume;		/**< Delegates of resume */
 };
 
+/**
+ * @ingroup WorldEd
+ * @brief Dialog of import settings a texture 2D
+ */
+class CTexture2DImportSettingsDialog : public CImGUIPopup
+{
+public:
+	/**
+	 * @brief Struct with import settings
+	 */
+	struct SImportSettings
+	{
+		/**
+		 * @brief Constructor
+		 */
+		SImportSettings()
+			: compression( TC_Default )
+		{}
+
+		ETextureCompression		compression;		/**< Compression settings */
+	};
+
+	/**
+	 * @brief Delegate of resume, called when pressed button 'Import', 'Import All or 'Cancel'
+	 */
+	DECLARE_MULTICAST_DELEGATE( COnResume, CAssetFactory::EResultShowImportSettings /*InResult*/, const SImportSettings& /*InImportSettings*/ );
+
+	/**
+	 * @brief Constructor
+	 */
+	CTexture2DImportSettingsDialog();
+
+	/**
+	 * @brief Get delegate of resume
+	 * @return Return delegate of resume
+	 */
+	FORCEINLINE COnResume& OnResume() const
+	{
+		return onResume;
+	}
+
+protected:
+	/**
+	 * @brief Method tick interface of a layer
+	 */
+	virtual void OnTick() override;
+
+private:
+	SImportSettings			importSettings;	/**< Import settings */
+	mutable COnResume		onResume;		/**< Delegates of resume */
+};
+
 #endif // !IMPORTSETTINGSDIALOGS_H
\ No newline at end of file
@@ -96,8 +96,8 @@ private:
 	CViewportWidget											viewportWidget;			/**< Viewport widget */
 	class CMaterialPreviewViewportClient*					viewportClient;			/**< Viewport client */
 	std::vector<SSelectAssetHandle>							selectAssetWidgets;		/**< Array of select asset widgets */
-	SEditorDelegates::COnAssetsCanDelete::DelegateType_t*	assetsCanDeleteHandle;	/**< Handle delegate of assets can delete */
-	SEditorDelegates::COnAssetsReloaded::DelegateType_t*	assetsReloadedHandle;	/**< Handle delegate of reloaded assets */
+	CDelegateHandle											assetsCanDeleteHandle;	/**< Handle delegate of assets can delete */
+	CDelegateHandle											assetsReloadedHandle;	/**< Handle delegate of reloaded assets */
 };
 
 #endif // !MATERIALEDITORWINDOW_H
\ No newline at end of file
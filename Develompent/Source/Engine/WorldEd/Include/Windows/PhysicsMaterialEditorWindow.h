@@ -58,7 +58,7 @@ private:
 	void OnAssetsReloaded( const std::vector<TSharedPtr<CAsset>>& InAssets );
 
 	TSharedPtr<CPhysicsMaterial>							physMaterial;			/**< Physics material */
-	SEditorDelegates::COnAssetsCanDelete::DelegateType_t*	assetsCanDeleteHandle;	/**< Handle delegate of assets can delete */
+	CDelegateHandle											assetsCanDeleteHandle;	/**< Handle delegate of assets can delete */
 };
 
 
@@ -110,8 +110,9 @@ private:
 	CViewportWidget											viewportWidget;			/**< Viewport widget */
 	class CStaticMeshPreviewViewportClient*					viewportClient;			/**< Viewport client */
 	std::vector<SSelectAssetHandle>							selectAssetWidgets;		/**< Array of select asset widgets */
-	SEditorDelegates::COnAssetsCanDelete::DelegateType_t*	assetsCanDeleteHandle;	/**< Handle delegate of assets can delete */
-	SEditorDelegates::COnAssetsReloaded::DelegateType_t*	assetsReloadedHandle;	/**< Handle delegate of reloaded assets */
+	SStaticMeshVertexPrecision								vertexPrecision;		/**< Precision loss of verteces in current vertex format */
+	CDelegateHandle											assetsCanDeleteHandle;	/**< Handle delegate of assets can delete */
+	CDelegateHandle											assetsReloadedHandle;	/**< Handle delegate of reloaded assets */
 };
 
 #endif // !STATICMESHEDITORWINDOW_H
\ No newline at end of file
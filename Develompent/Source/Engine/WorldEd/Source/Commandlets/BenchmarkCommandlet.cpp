@@ -0,0 +1,1387 @@
+#include <math.h>
+#include <algorithm>
+#include <functional>
+#include <list>
+#include <vector>
+
+#include "Misc/Class.h"
+#include "Misc/Misc.h"
+#include "Misc/Template.h"
+#include "Misc/CoreGlobals.h"
+#include "Misc/EngineGlobals.h"
+#include "Logger/LoggerMacros.h"
+#include "System/Delegate.h"
+#include "System/ThreadingBase.h"
+#include "System/BaseFileSystem.h"
+#include "System/Archive.h"
+#include "System/World.h"
+#include "System/BaseEngine.h"
+#include "Render/Scene.h"
+#include "Render/RenderingThread.h"
+#include "Render/Viewport.h"
+#include "Actors/Sprite.h"
+#include "Actors/TileMap.h"
+#include "Actors/StaticMesh.h"
+#include "Render/RenderUtils.h"
+#include "Render/TextureMips.h"
+#include "Render/LightClustering.h"
+#include "Render/OcclusionCulling.h"
+#include "Render/YUVConversion.h"
+#include "System/TextureCompressor.h"
+#include "System/MeshOptimizer.h"
+#include "Commandlets/BenchmarkCommandlet.h"
+
+IMPLEMENT_CLASS( CBenchmarkCommandlet )
+
+/**
+ * Number of handlers in benchmark of delegates
+ */
+#define BENCHMARK_DELEGATES_NUM_HANDLERS		8
+
+/**
+ * Number of broadcasts in benchmark of delegates
+ */
+#define BENCHMARK_DELEGATES_NUM_BROADCASTS		1000000
+
+/**
+ * Number of add/remove iterations in benchmark of delegates
+ */
+#define BENCHMARK_DELEGATES_NUM_ADDREMOVE		100000
+
+/**
+ * Number of bytes hashed for each size of key in benchmark of hashing
+ */
+#define BENCHMARK_HASH_TOTAL_BYTES				( 256 * 1024 * 1024 )
+
+/**
+ * Size of grid of static meshes in benchmark of draw lists
+ */
+#define BENCHMARK_DRAWLISTS_GRID_SIZE			64
+#define BENCHMARK_DRAWLISTS_NUM_ACTORS			( BENCHMARK_DRAWLISTS_GRID_SIZE * BENCHMARK_DRAWLISTS_GRID_SIZE )
+
+/**
+ * Number of meshes (vertex factories) and materials in benchmark of draw lists
+ */
+#define BENCHMARK_DRAWLISTS_NUM_MESHES			256
+#define BENCHMARK_DRAWLISTS_NUM_MATERIALS		128
+
+/**
+ * Number of frames in benchmark of draw lists
+ */
+#define BENCHMARK_DRAWLISTS_NUM_FRAMES			100
+
+/**
+ * Size of top mip in benchmark of mip chain generation
+ */
+#define BENCHMARK_MIPS_TEXTURE_SIZE				2048
+
+/**
+ * Number of generated mip chains in benchmark of mip chain generation
+ */
+#define BENCHMARK_MIPS_NUM_ITERATIONS			8
+
+/**
+ * Size of texture in benchmark of block compression
+ */
+#define BENCHMARK_BC_TEXTURE_SIZE				1024
+
+/**
+ * Number of compressed textures for each format in benchmark of block compression
+ */
+#define BENCHMARK_BC_NUM_ITERATIONS				4
+
+/**
+ * Number of segments of sphere in benchmark of mesh optimization
+ */
+#define BENCHMARK_MESH_NUM_SEGMENTS				256
+
+/**
+ * Size of map in tiles and number of layers in benchmark of tile map
+ */
+#define BENCHMARK_TILEMAP_SIZE					256
+#define BENCHMARK_TILEMAP_NUM_LAYERS			3
+
+/**
+ * Size of tile in benchmark of tile map
+ */
+#define BENCHMARK_TILEMAP_TILE_SIZE				32.f
+
+/**
+ * Number of rendered frames in benchmark of tile map
+ */
+#define BENCHMARK_TILEMAP_NUM_FRAMES			50
+
+/**
+ * Number of segments of sphere in benchmark of static mesh LODs
+ */
+#define BENCHMARK_LOD_NUM_SEGMENTS				128
+
+/**
+ * Distances from camera to center of sphere in benchmark of static mesh LODs, radius of sphere is 1
+ */
+#define BENCHMARK_LOD_MIN_DISTANCE				1.5f
+#define BENCHMARK_LOD_MAX_DISTANCE				64.f
+
+/**
+ * Step of distance and amplitude of camera shake in sweep of benchmark of static mesh LODs
+ */
+#define BENCHMARK_LOD_SWEEP_STEP				1.02f
+#define BENCHMARK_LOD_SWEEP_SHAKE				1.05f
+
+/**
+ * Min and max number of lights in benchmark of light clustering, number of lights is multiplied by 10 in each case
+ */
+#define BENCHMARK_LIGHTS_MIN_NUM				100
+#define BENCHMARK_LIGHTS_MAX_NUM				10000
+
+/**
+ * Size of cube around camera where lights are placed in benchmark of light clustering
+ */
+#define BENCHMARK_LIGHTS_AREA_SIZE				200.f
+
+/**
+ * Min and max radius of lights in benchmark of light clustering
+ */
+#define BENCHMARK_LIGHTS_MIN_RADIUS				1.f
+#define BENCHMARK_LIGHTS_MAX_RADIUS				8.f
+
+/**
+ * Number of builds of light clusters for average time in benchmark of light clustering
+ */
+#define BENCHMARK_LIGHTS_NUM_ITERATIONS			100
+
+/**
+ * Number of rows of buildings and buildings in each row in benchmark of occlusion culling
+ */
+#define BENCHMARK_OCCLUSION_NUM_ROWS			10
+#define BENCHMARK_OCCLUSION_NUM_BUILDINGS		16
+
+/**
+ * Distance between rows and between buildings in row, size of building and its height in benchmark of occlusion culling
+ */
+#define BENCHMARK_OCCLUSION_ROW_STEP			20.f
+#define BENCHMARK_OCCLUSION_BUILDING_STEP		12.f
+#define BENCHMARK_OCCLUSION_BUILDING_SIZE		10.f
+#define BENCHMARK_OCCLUSION_BUILDING_HEIGHT		20.f
+
+/**
+ * Number of objects placed between buildings and their size in benchmark of occlusion culling
+ */
+#define BENCHMARK_OCCLUSION_NUM_OBJECTS			10000
+#define BENCHMARK_OCCLUSION_OBJECT_SIZE			1.f
+
+/**
+ * Number of frames for average time in benchmark of occlusion culling
+ */
+#define BENCHMARK_OCCLUSION_NUM_ITERATIONS		100
+
+/**
+ * Number of instances, their size and depth of area with instances in benchmark of overdraw
+ */
+#define BENCHMARK_OVERDRAW_NUM_INSTANCES		5000
+#define BENCHMARK_OVERDRAW_INSTANCE_SIZE		2.f
+#define BENCHMARK_OVERDRAW_AREA_DEPTH			100.f
+
+/**
+ * Size of depth buffer in benchmark of overdraw
+ */
+#define BENCHMARK_OVERDRAW_BUFFER_SIZE_X		320
+#define BENCHMARK_OVERDRAW_BUFFER_SIZE_Y		180
+
+/**
+ * Number of sorts for average time in benchmark of overdraw
+ */
+#define BENCHMARK_OVERDRAW_NUM_ITERATIONS		100
+
+/**
+ * Size of grid of spheres and distance between them in benchmark of picking
+ */
+#define BENCHMARK_PICKING_GRID_SIZE				24
+#define BENCHMARK_PICKING_GRID_STEP				3.f
+
+/**
+ * Number of segments of each sphere in benchmark of picking
+ */
+#define BENCHMARK_PICKING_NUM_SEGMENTS			24
+
+/**
+ * Number of rays in benchmark of picking
+ */
+#define BENCHMARK_PICKING_NUM_RAYS				256
+
+/**
+ * Number of converted frames for average time in benchmark of YUV conversion
+ */
+#define BENCHMARK_YUV_NUM_FRAMES				30
+
+/**
+ * Generate UV sphere with radius 1, triangles are in order of rows like most of exporters write grids
+ *
+ * @param InNumSegments		Number of segments by each axis
+ * @param OutVerteces		Output vertices
+ * @param OutIndeces		Output indices
+ */
+static void GenerateBenchmarkSphere( uint32 InNumSegments, std::vector<SStaticMeshVertexType>& OutVerteces, std::vector<uint32>& OutIndeces )
+{
+	OutVerteces.resize( ( InNumSegments + 1 ) * ( InNumSegments + 1 ) );
+	OutIndeces.clear();
+	appMemzero( OutVerteces.data(), sizeof( SStaticMeshVertexType ) * OutVerteces.size() );
+	for ( uint32 y = 0; y <= InNumSegments; ++y )
+	{
+		for ( uint32 x = 0; x <= InNumSegments; ++x )
+		{
+			const float		theta	= ( float )( x * 2.0 * PI / InNumSegments );
+			const float		phi		= ( float )( y * PI / InNumSegments );
+			OutVerteces[ y * ( InNumSegments + 1 ) + x ].position = Vector4D( sinf( phi ) * cosf( theta ), sinf( phi ) * sinf( theta ), cosf( phi ), 1.f );
+		}
+	}
+
+	for ( uint32 y = 0; y < InNumSegments; ++y )
+	{
+		for ( uint32 x = 0; x < InNumSegments; ++x )
+		{
+			const uint32		index		= y * ( InNumSegments + 1 ) + x;
+			const uint32		quad[]		= { index, index + 1, index + InNumSegments + 1, index + 1, index + InNumSegments + 2, index + InNumSegments + 1 };
+			OutIndeces.insert( OutIndeces.end(), quad, quad + ARRAY_COUNT( quad ) );
+		}
+	}
+}
+
+/**
+ * Multicast delegate based on std::list<std::function>, it is baseline for compare with TMulticastDelegate
+ */
+template< typename... TParamTypes >
+class TListMulticastDelegate
+{
+public:
+	typedef std::function<void( TParamTypes... )>		DelegateType_t;
+
+	FORCEINLINE DelegateType_t* Add( const DelegateType_t& InDelegate )
+	{
+		CScopeLock		scopeLock( criticalSection );
+		delegates.push_back( InDelegate );
+		return &delegates.back();
+	}
+
+	FORCEINLINE void Remove( DelegateType_t*& InDelegate )
+	{
+		CScopeLock		scopeLock( criticalSection );
+		for ( auto itDelegate = delegates.begin(), itDelegateEnd = delegates.end(); itDelegate != itDelegateEnd; ++itDelegate )
+		{
+			if ( &( *itDelegate ) == InDelegate )
+			{
+				delegates.erase( itDelegate );
+				InDelegate = nullptr;
+				return;
+			}
+		}
+	}
+
+	FORCEINLINE void Broadcast( TParamTypes... InParams ) const
+	{
+		CScopeLock		scopeLock( criticalSection );
+		for ( auto itDelegate = delegates.begin(), itDelegateEnd = delegates.end(); itDelegate != itDelegateEnd; ++itDelegate )
+		{
+			( *itDelegate )( InParams... );
+		}
+	}
+
+private:
+	std::list< DelegateType_t >		delegates;
+	mutable CCriticalSection		criticalSection;
+};
+
+/**
+ * Frame in benchmark of draw lists
+ */
+struct SBenchmarkDrawListFrame
+{
+	double				drawTime;		/**< Time of draw static mesh draw list */
+	SDrawListStats		stats;			/**< Statistics of draw lists */
+};
+
+/**
+ * Receiver of delegates in benchmark
+ */
+struct SBenchmarkReceiver
+{
+	/**
+	 * Constructor
+	 */
+	SBenchmarkReceiver()
+		: sum( 0 )
+	{}
+
+	/**
+	 * Handler of delegate
+	 * @param InValue	Value
+	 */
+	void OnEvent( uint32 InValue )
+	{
+		sum += InValue;
+	}
+
+	uint64		sum;		/**< Sum of received values */
+};
+
+bool CBenchmarkCommandlet::Main( const CCommandLine& InCommandLine )
+{
+	// Benchmarks selected by command line parameters, if no one is selected all of them are run
+	static const SBenchmarkInfo		benchmarks[] =
+	{
+		{ TEXT( "delegates" ),	&CBenchmarkCommandlet::BenchmarkDelegates },
+		{ TEXT( "hash" ),		&CBenchmarkCommandlet::BenchmarkHash },
+		{ TEXT( "drawlists" ),	&CBenchmarkCommandlet::BenchmarkDrawLists },
+		{ TEXT( "mips" ),		&CBenchmarkCommandlet::BenchmarkMips },
+		{ TEXT( "bc" ),			&CBenchmarkCommandlet::BenchmarkBlockCompression },
+		{ TEXT( "mesh" ),		&CBenchmarkCommandlet::BenchmarkMeshOptimization },
+		{ TEXT( "tilemap" ),	&CBenchmarkCommandlet::BenchmarkTileMap },
+		{ TEXT( "lod" ),		&CBenchmarkCommandlet::BenchmarkStaticMeshLODs },
+		{ TEXT( "lights" ),		&CBenchmarkCommandlet::BenchmarkLightClustering },
+		{ TEXT( "occlusion" ),	&CBenchmarkCommandlet::BenchmarkOcclusionCulling },
+		{ TEXT( "overdraw" ),	&CBenchmarkCommandlet::BenchmarkOverdraw },
+		{ TEXT( "picking" ),	&CBenchmarkCommandlet::BenchmarkPicking },
+		{ TEXT( "yuv" ),		&CBenchmarkCommandlet::BenchmarkYUVConversion }
+	};
+
+	bool		bRunAll = true;
+	for ( uint32 index = 0; index < ARRAY_COUNT( benchmarks ); ++index )
+	{
+		if ( InCommandLine.HasParam( benchmarks[ index ].param ) )
+		{
+			bRunAll = false;
+			break;
+		}
+	}
+
+	for ( uint32 index = 0; index < ARRAY_COUNT( benchmarks ); ++index )
+	{
+		if ( bRunAll || InCommandLine.HasParam( benchmarks[ index ].param ) )
+		{
+			( this->*benchmarks[ index ].function )();
+		}
+	}
+
+	return true;
+}
+
+void CBenchmarkCommandlet::BenchmarkDelegates()
+{
+	LE_LOG( LT_Log, LC_Commandlet, TEXT( "Benchmark of delegates: %i handlers, %i broadcasts, %i add/remove" ), BENCHMARK_DELEGATES_NUM_HANDLERS, BENCHMARK_DELEGATES_NUM_BROADCASTS, BENCHMARK_DELEGATES_NUM_ADDREMOVE );
+
+	SBenchmarkReceiver		receivers[ BENCHMARK_DELEGATES_NUM_HANDLERS ];
+
+	// Baseline: std::list<std::function>
+	double		listBroadcastTime = 0.0;
+	double		listAddRemoveTime = 0.0;
+	{
+		TListMulticastDelegate<uint32>					delegate;
+		TListMulticastDelegate<uint32>::DelegateType_t*	handles[ BENCHMARK_DELEGATES_NUM_HANDLERS ];
+		for ( uint32 index = 0; index < BENCHMARK_DELEGATES_NUM_HANDLERS; ++index )
+		{
+			handles[ index ] = delegate.Add( std::bind( &SBenchmarkReceiver::OnEvent, &receivers[ index ], std::placeholders::_1 ) );
+		}
+
+		double		startTime = appSeconds();
+		for ( uint32 index = 0; index < BENCHMARK_DELEGATES_NUM_BROADCASTS; ++index )
+		{
+			delegate.Broadcast( index );
+		}
+		listBroadcastTime = appSeconds() - startTime;
+
+		startTime = appSeconds();
+		for ( uint32 index = 0; index < BENCHMARK_DELEGATES_NUM_ADDREMOVE; ++index )
+		{
+			TListMulticastDelegate<uint32>::DelegateType_t*		handle = delegate.Add( std::bind( &SBenchmarkReceiver::OnEvent, &receivers[ 0 ], std::placeholders::_1 ) );
+			delegate.Remove( handle );
+		}
+		listAddRemoveTime = appSeconds() - startTime;
+
+		for ( uint32 index = 0; index < BENCHMARK_DELEGATES_NUM_HANDLERS; ++index )
+		{
+			delegate.Remove( handles[ index ] );
+		}
+	}
+
+	// TMulticastDelegate
+	double		inlineBroadcastTime = 0.0;
+	double		inlineAddRemoveTime = 0.0;
+	{
+		TMulticastDelegate<uint32>		delegate;
+		CDelegateHandle					handles[ BENCHMARK_DELEGATES_NUM_HANDLERS ];
+		for ( uint32 index = 0; index < BENCHMARK_DELEGATES_NUM_HANDLERS; ++index )
+		{
+			handles[ index ] = delegate.Add( std::bind( &SBenchmarkReceiver::OnEvent, &receivers[ index ], std::placeholders::_1 ) );
+		}
+
+		double		startTime = appSeconds();
+		for ( uint32 index = 0; index < BENCHMARK_DELEGATES_NUM_BROADCASTS; ++index )
+		{
+			delegate.Broadcast( index );
+		}
+		inlineBroadcastTime = appSeconds() - startTime;
+
+		startTime = appSeconds();
+		for ( uint32 index = 0; index < BENCHMARK_DELEGATES_NUM_ADDREMOVE; ++index )
+		{
+			CDelegateHandle		handle = delegate.Add( std::bind( &SBenchmarkReceiver::OnEvent, &receivers[ 0 ], std::placeholders::_1 ) );
+			delegate.Remove( handle );
+		}
+		inlineAddRemoveTime = appSeconds() - startTime;
+
+		for ( uint32 index = 0; index < BENCHMARK_DELEGATES_NUM_HANDLERS; ++index )
+		{
+			delegate.Remove( handles[ index ] );
+		}
+	}
+
+	// Use result of handlers, so compiler can't throw away broadcasts
+	uint64		checksum = 0;
+	for ( uint32 index = 0; index < BENCHMARK_DELEGATES_NUM_HANDLERS; ++index )
+	{
+		checksum += receivers[ index ].sum;
+	}
+
+	LE_LOG( LT_Log, LC_Commandlet, TEXT( "std::list<std::function>: broadcast %.2f ms, add/remove %.2f ms" ), listBroadcastTime * 1000.0, listAddRemoveTime * 1000.0 );
+	LE_LOG( LT_Log, LC_Commandlet, TEXT( "TMulticastDelegate:       broadcast %.2f ms, add/remove %.2f ms" ), inlineBroadcastTime * 1000.0, inlineAddRemoveTime * 1000.0 );
+	LE_LOG( LT_Log, LC_Commandlet, TEXT( "Speedup: broadcast x%.2f, add/remove x%.2f (checksum %llu)" ), listBroadcastTime / Max( inlineBroadcastTime, 0.000001 ), listAddRemoveTime / Max( inlineAddRemoveTime, 0.000001 ), checksum );
+}
+
+void CBenchmarkCommandlet::BenchmarkHash()
+{
+	// Sizes of keys: pointer, small struct, typical name in UTF-16, path, big buffer
+	const uint32		keySizes[] = { 8, 24, 64, 256, 64 * 1024 };
+	LE_LOG( LT_Log, LC_Commandlet, TEXT( "Benchmark of hashing: %i MB for each size of key" ), BENCHMARK_HASH_TOTAL_BYTES / ( 1024 * 1024 ) );
+
+	std::vector<byte>	data( keySizes[ ARRAY_COUNT( keySizes ) - 1 ] );
+	for ( uint32 index = 0, count = ( uint32 )data.size(); index < count; ++index )
+	{
+		data[ index ] = ( byte )( index * 2654435761U >> 24 );
+	}
+
+	uint64		checksum = 0;
+	for ( uint32 indexSize = 0; indexSize < ARRAY_COUNT( keySizes ); ++indexSize )
+	{
+		uint32		keySize		= keySizes[ indexSize ];
+		uint32		numKeys		= BENCHMARK_HASH_TOTAL_BYTES / keySize;
+
+		// Legacy byte-at-a-time hash
+		double		startTime = appSeconds();
+		for ( uint32 index = 0; index < numKeys; ++index )
+		{
+			checksum += appMemFastHashLegacy( data.data(), keySize, index );
+		}
+		double		legacyTime = appSeconds() - startTime;
+
+		// Word-at-a-time hash
+		startTime = appSeconds();
+		for ( uint32 index = 0; index < numKeys; ++index )
+		{
+			checksum += appMemFastHash( data.data(), keySize, index );
+		}
+		double		fastTime = appSeconds() - startTime;
+
+		double		totalMB = BENCHMARK_HASH_TOTAL_BYTES / ( 1024.0 * 1024.0 );
+		LE_LOG( LT_Log, LC_Commandlet, TEXT( "Key %6i bytes: legacy %8.2f MB/s, appMemFastHash %8.2f MB/s, speedup x%.2f" ), keySize, totalMB / Max( legacyTime, 0.000001 ), totalMB / Max( fastTime, 0.000001 ), legacyTime / Max( fastTime, 0.000001 ) );
+	}
+
+	LE_LOG( LT_Log, LC_Commandlet, TEXT( "Checksum of hashes %llu" ), checksum );
+}
+
+void CBenchmarkCommandlet::BenchmarkDrawLists()
+{
+	LE_LOG( LT_Log, LC_Commandlet, TEXT( "Benchmark of draw lists: %i static meshes with %i meshes and %i materials, %i frames" ), BENCHMARK_DRAWLISTS_NUM_ACTORS, BENCHMARK_DRAWLISTS_NUM_MESHES, BENCHMARK_DRAWLISTS_NUM_MATERIALS, BENCHMARK_DRAWLISTS_NUM_FRAMES );
+
+	// Each mesh has own vertex factory and each material is separate state for drawing policy
+	std::vector<SStaticMeshVertexType>		verteces;
+	std::vector<uint32>						indeces;
+	std::vector<SStaticMeshSurface>			surfaces( 1 );
+	GenerateBenchmarkSphere( 4, verteces, indeces );
+	appMemzero( surfaces.data(), sizeof( SStaticMeshSurface ) );
+	surfaces[ 0 ].numPrimitives = indeces.size() / 3;
+
+	std::vector< TSharedPtr<CStaticMesh> >		staticMeshes( BENCHMARK_DRAWLISTS_NUM_MESHES );
+	for ( uint32 index = 0; index < BENCHMARK_DRAWLISTS_NUM_MESHES; ++index )
+	{
+		staticMeshes[ index ] = MakeSharedPtr<CStaticMesh>();
+		staticMeshes[ index ]->SetAssetName( CString::Format( TEXT( "BenchmarkMesh%i" ), index ) );
+		staticMeshes[ index ]->SetData( verteces, indeces, surfaces, std::vector< TAssetHandle<CMaterial> >{ GEngine->GetDefaultMaterial() } );
+	}
+
+	std::vector< TSharedPtr<CMaterial> >		materials( BENCHMARK_DRAWLISTS_NUM_MATERIALS );
+	for ( uint32 index = 0; index < BENCHMARK_DRAWLISTS_NUM_MATERIALS; ++index )
+	{
+		materials[ index ] = MakeSharedPtr<CMaterial>();
+		materials[ index ]->SetAssetName( CString::Format( TEXT( "BenchmarkMaterial%i" ), index ) );
+	}
+
+	// Spawn grid of static meshes with pseudo random meshes and materials, like order of std::unordered_set by hash
+	GWorld->CleanupWorld();
+	std::vector<AStaticMesh*>		staticMeshActors( BENCHMARK_DRAWLISTS_NUM_ACTORS );
+	uint32							seed = 1;
+	auto							random = [&]( uint32 InMax ) -> uint32
+	{
+		seed = seed * 1664525U + 1013904223U;
+		return ( seed >> 8 ) % InMax;
+	};
+
+	for ( uint32 index = 0; index < BENCHMARK_DRAWLISTS_NUM_ACTORS; ++index )
+	{
+		AStaticMesh*		staticMeshActor = GWorld->SpawnActor< AStaticMesh >( Vector( ( index % BENCHMARK_DRAWLISTS_GRID_SIZE ) * 3.f, 0.f, ( index / BENCHMARK_DRAWLISTS_GRID_SIZE ) * 3.f ) );
+		staticMeshActor->SetStaticMesh( staticMeshes[ random( BENCHMARK_DRAWLISTS_NUM_MESHES ) ]->GetAssetHandle() );
+		staticMeshActor->GetStaticMeshComponent()->SetMaterial( 0, materials[ random( BENCHMARK_DRAWLISTS_NUM_MATERIALS ) ]->GetAssetHandle() );
+		staticMeshActors[ index ] = staticMeshActor;
+	}
+	FlushRenderingCommands();
+
+	// Camera sees the whole grid
+	CScene*				scene				= ( CScene* )GWorld->GetScene();
+	const float			areaSize			= BENCHMARK_DRAWLISTS_GRID_SIZE * 3.f;
+	const Vector		cameraLocation( areaSize * 0.5f, areaSize, -areaSize * 0.5f );
+	const Matrix		projectionMatrix	= glm::perspective( SMath::DegreesToRadians( 90.f ), 1280.f / 720.f, 0.01f, 1000.f );
+	CSceneView			sceneView( cameraLocation, projectionMatrix, glm::lookAt( cameraLocation, Vector( areaSize * 0.5f, 0.f, areaSize * 0.5f ), SMath::vectorUp ), 1280.f, 720.f, CColor::black, SHOW_DefaultGame );
+
+	// Each odd frame one static mesh gets new material, so its drawing policy is relinked and the draw list is sorted again.
+	// The first frame links all drawing policies and isn't measured
+	std::vector< TSharedPtr<CMaterial> >		relinkMaterials;
+	SBenchmarkDrawListFrame						frame;
+	SDrawListStats								unsortedFrameStats;
+	double										sortedDrawTime		= 0.0;
+	double										unsortedDrawTime	= 0.0;
+	uint32										numSortedFrames		= 0;
+	for ( uint32 index = 0; index <= BENCHMARK_DRAWLISTS_NUM_FRAMES; ++index )
+	{
+		if ( index > 0 && index % 2 == 1 )
+		{
+			TSharedPtr<CMaterial>		material = MakeSharedPtr<CMaterial>();
+			material->SetAssetName( CString::Format( TEXT( "BenchmarkRelinkMaterial%i" ), index ) );
+			relinkMaterials.push_back( material );
+			staticMeshActors[ random( BENCHMARK_DRAWLISTS_NUM_ACTORS ) ]->GetStaticMeshComponent()->SetMaterial( 0, material->GetAssetHandle() );
+		}
+
+		GWorld->Tick( 1.f / 60.f );
+		scene->BuildView( sceneView );
+		UNIQUE_RENDER_COMMAND_THREEPARAMETER( CBenchmarkDrawListCommand,
+											  CScene*, scene, scene,
+											  const CSceneView*, sceneView, &sceneView,
+											  SBenchmarkDrawListFrame*, frame, &frame,
+											  {
+												  GDrawListStats.Reset();
+												  const double		startTime = appSeconds();
+												  scene->GetSDG( SDG_World ).staticMeshDrawList.Draw( GRHI->GetImmediateContext(), *sceneView );
+												  frame->drawTime	= appSeconds() - startTime;
+												  frame->stats		= GDrawListStats;
+											  } );
+		FlushRenderingCommands();
+		scene->ClearView();
+
+		if ( index == 0 )
+		{
+			continue;
+		}
+
+		if ( frame.stats.numSorts > 0 )
+		{
+			sortedDrawTime += frame.drawTime;
+			++numSortedFrames;
+		}
+		else
+		{
+			unsortedDrawTime	+= frame.drawTime;
+			unsortedFrameStats	= frame.stats;
+		}
+	}
+
+	const uint32	numUnsortedFrames = BENCHMARK_DRAWLISTS_NUM_FRAMES - numSortedFrames;
+	LE_LOG( LT_Log, LC_Commandlet, TEXT( "Drawing policies: %i, state changes per frame: %i vertex factories, %i bound shader states, %i shader parameters" ), 
+			unsortedFrameStats.numDrawingPolicies, unsortedFrameStats.numVertexFactoryChanges, unsortedFrameStats.numBoundShaderStateChanges, unsortedFrameStats.numShaderParametersChanges );
+	LE_LOG( LT_Log, LC_Commandlet, TEXT( "Draw time: %.3f ms with sort of drawing policies (%i frames), %.3f ms without it (%i frames)" ), 
+			numSortedFrames > 0 ? sortedDrawTime * 1000.0 / numSortedFrames : 0.0, numSortedFrames, numUnsortedFrames > 0 ? unsortedDrawTime * 1000.0 / numUnsortedFrames : 0.0, numUnsortedFrames );
+
+	GWorld->CleanupWorld();
+	FlushRenderingCommands();
+}
+
+void CBenchmarkCommandlet::BenchmarkMips()
+{
+	LE_LOG( LT_Log, LC_Commandlet, TEXT( "Benchmark of mip chain generation: %ix%i texture, %i iterations" ), BENCHMARK_MIPS_TEXTURE_SIZE, BENCHMARK_MIPS_TEXTURE_SIZE, BENCHMARK_MIPS_NUM_ITERATIONS );
+
+	// Generate noise texture
+	std::vector<byte>		data( BENCHMARK_MIPS_TEXTURE_SIZE * BENCHMARK_MIPS_TEXTURE_SIZE * 4 );
+	uint32					seed = 1;
+	for ( uint32 index = 0, count = ( uint32 )data.size(); index < count; ++index )
+	{
+		seed = seed * 1664525U + 1013904223U;
+		data[ index ] = ( byte )( seed >> 24 );
+	}
+
+	const bool				srgbModes[] = { true, false };
+	std::vector<byte>		mipChain;
+	uint32					numMips = 0;
+	for ( uint32 indexMode = 0; indexMode < ARRAY_COUNT( srgbModes ); ++indexMode )
+	{
+		double		startTime = appSeconds();
+		for ( uint32 index = 0; index < BENCHMARK_MIPS_NUM_ITERATIONS; ++index )
+		{
+			numMips = GenerateMipChain( PF_A8R8G8B8, BENCHMARK_MIPS_TEXTURE_SIZE, BENCHMARK_MIPS_TEXTURE_SIZE, data.data(), mipChain, srgbModes[ indexMode ] );
+		}
+		double		time = ( appSeconds() - startTime ) / BENCHMARK_MIPS_NUM_ITERATIONS;
+
+		double		megaPixels = ( ( double )BENCHMARK_MIPS_TEXTURE_SIZE * BENCHMARK_MIPS_TEXTURE_SIZE ) / ( 1000.0 * 1000.0 );
+		LE_LOG( LT_Log, LC_Commandlet, TEXT( "%s: %i mips, %.2f ms per texture, %.2f MPixels/s of top mip" ), srgbModes[ indexMode ] ? TEXT( "sRGB" ) : TEXT( "Linear" ), numMips, time * 1000.0, megaPixels / Max( time, 0.000001 ) );
+	}
+}
+
+void CBenchmarkCommandlet::BenchmarkBlockCompression()
+{
+	LE_LOG( LT_Log, LC_Commandlet, TEXT( "Benchmark of texture block compression: %ix%i texture, %i iterations, %i threads" ), BENCHMARK_BC_TEXTURE_SIZE, BENCHMARK_BC_TEXTURE_SIZE, BENCHMARK_BC_NUM_ITERATIONS, appGetNumberOfProcessors() );
+
+	// Generate texture with smooth gradients and a bit of noise, pure noise isn't typical content for block compression
+	std::vector<byte>		data( BENCHMARK_BC_TEXTURE_SIZE * BENCHMARK_BC_TEXTURE_SIZE * 4 );
+	uint32					seed = 1;
+	for ( uint32 y = 0; y < BENCHMARK_BC_TEXTURE_SIZE; ++y )
+	{
+		for ( uint32 x = 0; x < BENCHMARK_BC_TEXTURE_SIZE; ++x )
+		{
+			byte*		texel = &data[ ( y * BENCHMARK_BC_TEXTURE_SIZE + x ) * 4 ];
+			seed = seed * 1664525U + 1013904223U;
+
+			const int32		noise = ( int32 )( seed >> 28 ) - 8;
+			texel[ 0 ] = ( byte )Clamp<int32>( ( int32 )( 128.f + 100.f * sinf( x * 0.02f ) * cosf( y * 0.03f ) ) + noise, 0, 255 );
+			texel[ 1 ] = ( byte )Clamp<int32>( ( int32 )( ( x + y ) * 255 / ( BENCHMARK_BC_TEXTURE_SIZE * 2 ) ) + noise, 0, 255 );
+			texel[ 2 ] = ( byte )Clamp<int32>( ( int32 )( ( ( x / 64 ) ^ ( y / 64 ) ) & 1 ? 200 : 40 ) + noise, 0, 255 );
+			texel[ 3 ] = ( byte )( y * 255 / BENCHMARK_BC_TEXTURE_SIZE );
+		}
+	}
+
+	const EPixelFormat		pixelFormats[] = { PF_BC1, PF_BC3, PF_BC5, PF_BC7 };
+	const uint32			numChannels[] = { 3, 4, 2, 4 };
+	std::vector<byte>		compressedData;
+	std::vector<byte>		decompressedData( data.size() );
+	for ( uint32 indexFormat = 0; indexFormat < ARRAY_COUNT( pixelFormats ); ++indexFormat )
+	{
+		double		startTime = appSeconds();
+		for ( uint32 index = 0; index < BENCHMARK_BC_NUM_ITERATIONS; ++index )
+		{
+			CompressMipChain( pixelFormats[ indexFormat ], BENCHMARK_BC_TEXTURE_SIZE, BENCHMARK_BC_TEXTURE_SIZE, 1, data.data(), compressedData );
+		}
+		double		time = ( appSeconds() - startTime ) / BENCHMARK_BC_NUM_ITERATIONS;
+
+		// PSNR is calculated only by channels which stored in format
+		DecompressMip( pixelFormats[ indexFormat ], BENCHMARK_BC_TEXTURE_SIZE, BENCHMARK_BC_TEXTURE_SIZE, compressedData.data(), decompressedData.data() );
+		double		squaredError = 0.0;
+		for ( uint32 index = 0, count = BENCHMARK_BC_TEXTURE_SIZE * BENCHMARK_BC_TEXTURE_SIZE; index < count; ++index )
+		{
+			for ( uint32 channel = 0; channel < numChannels[ indexFormat ]; ++channel )
+			{
+				const double	delta = ( double )data[ index * 4 + channel ] - decompressedData[ index * 4 + channel ];
+				squaredError += delta * delta;
+			}
+		}
+
+		double		meanSquaredError	= squaredError / ( ( double )BENCHMARK_BC_TEXTURE_SIZE * BENCHMARK_BC_TEXTURE_SIZE * numChannels[ indexFormat ] );
+		double		psnr				= meanSquaredError > 0.0 ? 10.0 * log10( 255.0 * 255.0 / meanSquaredError ) : 99.0;
+		double		megaPixels			= ( ( double )BENCHMARK_BC_TEXTURE_SIZE * BENCHMARK_BC_TEXTURE_SIZE ) / ( 1000.0 * 1000.0 );
+		LE_LOG( LT_Log, LC_Commandlet, TEXT( "%s: %.2f ms per texture, %.2f MPixels/s, PSNR %.2f dB, %.2f Kb" ), GPixelFormats[ pixelFormats[ indexFormat ] ].name, time * 1000.0, megaPixels / Max( time, 0.000001 ), psnr, compressedData.size() / 1024.f );
+	}
+}
+
+void CBenchmarkCommandlet::BenchmarkMeshOptimization()
+{
+	LE_LOG( LT_Log, LC_Commandlet, TEXT( "Benchmark of mesh optimization: sphere with %ix%i segments, cache size %i" ), BENCHMARK_MESH_NUM_SEGMENTS, BENCHMARK_MESH_NUM_SEGMENTS, MESHOPTIMIZER_CACHE_SIZE );
+
+	// Generate UV sphere
+	std::vector<SStaticMeshVertexType>		verteces;
+	std::vector<uint32>						indeces;
+	GenerateBenchmarkSphere( BENCHMARK_MESH_NUM_SEGMENTS, verteces, indeces );
+
+	// The same mesh with shuffled triangles, it is the worst case for vertex cache
+	std::vector<uint32>		shuffledIndeces( indeces.size() );
+	{
+		const uint32			numTriangles = indeces.size() / 3;
+		std::vector<uint32>		triangles( numTriangles );
+		uint32					seed = 1;
+		for ( uint32 index = 0; index < numTriangles; ++index )
+		{
+			triangles[ index ] = index;
+		}
+
+		for ( uint32 index = numTriangles - 1; index > 0; --index )
+		{
+			seed = seed * 1664525U + 1013904223U;
+			Swap( triangles[ index ], triangles[ seed % ( index + 1 ) ] );
+		}
+
+		for ( uint32 index = 0; index < numTriangles; ++index )
+		{
+			memcpy( &shuffledIndeces[ index * 3 ], &indeces[ triangles[ index ] * 3 ], sizeof( uint32 ) * 3 );
+		}
+	}
+
+	const tchar*					layoutNames[] = { TEXT( "Grid order" ), TEXT( "Shuffled" ) };
+	const std::vector<uint32>*		layouts[] = { &indeces, &shuffledIndeces };
+	for ( uint32 indexLayout = 0; indexLayout < ARRAY_COUNT( layouts ); ++indexLayout )
+	{
+		std::vector<SStaticMeshVertexType>		optimizedVerteces = verteces;
+		std::vector<uint32>						optimizedIndeces = *layouts[ indexLayout ];
+		std::vector<SStaticMeshSurface>			surfaces( 1 );
+		appMemzero( surfaces.data(), sizeof( SStaticMeshSurface ) );
+		surfaces[ 0 ].numPrimitives = optimizedIndeces.size() / 3;
+
+		const SVertexCacheStats		statsBefore = AnalyzeVertexCache( optimizedIndeces.data(), optimizedIndeces.size(), optimizedVerteces.size() );
+		double						startTime	= appSeconds();
+		OptimizeStaticMesh( optimizedVerteces, optimizedIndeces, surfaces );
+		double						time		= appSeconds() - startTime;
+		const SVertexCacheStats		statsAfter	= AnalyzeVertexCache( optimizedIndeces.data(), optimizedIndeces.size(), optimizedVerteces.size() );
+
+		LE_LOG( LT_Log, LC_Commandlet, TEXT( "%s: ACMR %.3f -> %.3f, ATVR %.3f -> %.3f, %.2f ms for %i triangles" ), layoutNames[ indexLayout ], statsBefore.acmr, statsAfter.acmr, statsBefore.atvr, statsAfter.atvr, time * 1000.0, optimizedIndeces.size() / 3 );
+	}
+}
+
+void CBenchmarkCommandlet::BenchmarkTileMap()
+{
+	LE_LOG( LT_Log, LC_Commandlet, TEXT( "Benchmark of tile map: %ix%i tiles, %i layers, %i frames" ), BENCHMARK_TILEMAP_SIZE, BENCHMARK_TILEMAP_SIZE, BENCHMARK_TILEMAP_NUM_LAYERS, BENCHMARK_TILEMAP_NUM_FRAMES );
+
+	// Generate tiles, each tile takes 1/16 of texture
+	TAssetHandle<CMaterial>			material = GEngine->GetDefaultMaterial();
+	std::vector<STileMapTile>		tiles;
+	for ( uint32 layer = 0; layer < BENCHMARK_TILEMAP_NUM_LAYERS; ++layer )
+	{
+		for ( uint32 y = 0; y < BENCHMARK_TILEMAP_SIZE; ++y )
+		{
+			for ( uint32 x = 0; x < BENCHMARK_TILEMAP_SIZE; ++x )
+			{
+				const uint32	tileID = ( x + y * 7 + layer * 3 ) % 16;
+				tiles.push_back( STileMapTile{ x, y, layer, 0, Vector2D( BENCHMARK_TILEMAP_TILE_SIZE, BENCHMARK_TILEMAP_TILE_SIZE ), RectFloat_t{ ( tileID % 4 ) / 4.f, ( tileID / 4 ) / 4.f, 0.25f, 0.25f } } );
+			}
+		}
+	}
+
+	// Camera looks at center of map and sees about quarter of it
+	const float			mapSize			= BENCHMARK_TILEMAP_SIZE * BENCHMARK_TILEMAP_TILE_SIZE;
+	const float			halfViewSize	= mapSize / 4.f;
+	const Vector		cameraLocation( mapSize / 2.f, mapSize / 2.f, 100.f );
+	const Matrix		projectionMatrix	= glm::ortho( -halfViewSize, halfViewSize, -halfViewSize, halfViewSize, 0.1f, 1000.f );
+	const Matrix		viewMatrix			= glm::lookAt( cameraLocation, cameraLocation - SMath::vectorForward, SMath::vectorUp );
+	CSceneView			sceneView( cameraLocation, projectionMatrix, viewMatrix, 1280.f, 720.f, CColor::black, SHOW_DefaultGame );
+	const std::wstring	mapPath = GCookedDir + PATH_SEPARATOR + TEXT( "BenchmarkTileMap.map" );
+
+	const tchar*		pathNames[] = { TEXT( "Sprite per tile" ), TEXT( "Chunked tile map" ) };
+	for ( uint32 indexPath = 0; indexPath < ARRAY_COUNT( pathNames ); ++indexPath )
+	{
+		// Spawn tiles
+		GWorld->CleanupWorld();
+		double		startTime = appSeconds();
+		if ( indexPath == 0 )
+		{
+			for ( uint32 index = 0, count = tiles.size(); index < count; ++index )
+			{
+				const STileMapTile&		tile				= tiles[ index ];
+				ASprite*				sprite				= GWorld->SpawnActor< ASprite >( Vector( tile.x * BENCHMARK_TILEMAP_TILE_SIZE, tile.y * BENCHMARK_TILEMAP_TILE_SIZE, tile.layer ) );
+				CSpriteComponent*		spriteComponent		= sprite->GetSpriteComponent();
+				spriteComponent->SetType( ST_Static );
+				spriteComponent->SetMaterial( material );
+				spriteComponent->SetSpriteSize( tile.size );
+				spriteComponent->SetTextureRect( tile.textureRect );
+				sprite->SetStatic( true );
+			}
+		}
+		else
+		{
+			ATileMap*		tileMap = GWorld->SpawnActor< ATileMap >( Vector( 0.f, 0.f, 0.f ) );
+			tileMap->GetTileMapComponent()->SetTiles( tiles, std::vector< TAssetHandle<CMaterial> >{ material }, Vector2D( BENCHMARK_TILEMAP_TILE_SIZE, BENCHMARK_TILEMAP_TILE_SIZE ) );
+			tileMap->SetStatic( true );
+		}
+		FlushRenderingCommands();
+		double		spawnTime = appSeconds() - startTime;
+
+		// Save and load world
+		{
+			CArchive*		archive = GFileSystem->CreateFileWriter( mapPath, AW_NoFail );
+			archive->SetType( AT_World );
+			archive->SerializeHeader();
+			GWorld->Serialize( *archive );
+			delete archive;
+		}
+
+		uint32		fileSize = 0;
+		startTime = appSeconds();
+		{
+			CArchive*		archive = GFileSystem->CreateFileReader( mapPath, AR_NoFail );
+			fileSize = archive->GetSize();
+			archive->SerializeHeader();
+			GWorld->Serialize( *archive );
+			delete archive;
+		}
+		FlushRenderingCommands();
+		double		loadTime = appSeconds() - startTime;
+
+		// Build frames, the first frame isn't measured because it links drawing policies
+		CBaseScene*		scene = GWorld->GetScene();
+		GWorld->Tick( 0.f );
+		scene->BuildView( sceneView );
+		scene->ClearView();
+
+		startTime = appSeconds();
+		for ( uint32 index = 0; index < BENCHMARK_TILEMAP_NUM_FRAMES; ++index )
+		{
+			GWorld->Tick( 1.f / 60.f );
+			scene->BuildView( sceneView );
+			scene->ClearView();
+		}
+		double		frameTime = ( appSeconds() - startTime ) / BENCHMARK_TILEMAP_NUM_FRAMES;
+
+		LE_LOG( LT_Log, LC_Commandlet, TEXT( "%s: %i actors, spawn %.2f ms, load %.2f ms, frame %.3f ms, %.2f Kb on disk" ), pathNames[ indexPath ], GWorld->GetNumActors(), spawnTime * 1000.0, loadTime * 1000.0, frameTime * 1000.0, fileSize / 1024.f );
+	}
+
+	GWorld->CleanupWorld();
+	FlushRenderingCommands();
+	GFileSystem->Delete( mapPath );
+}
+void CBenchmarkCommandlet::BenchmarkStaticMeshLODs()
+{
+	LE_LOG( LT_Log, LC_Commandlet, TEXT( "Benchmark of static mesh LODs: sphere with %ix%i segments, up to %i LODs" ), BENCHMARK_LOD_NUM_SEGMENTS, BENCHMARK_LOD_NUM_SEGMENTS, MESHOPTIMIZER_NUM_LODS );
+
+	// Generate sphere and its LODs
+	std::vector<SStaticMeshVertexType>		verteces;
+	std::vector<uint32>						indeces;
+	std::vector<SStaticMeshSurface>			surfaces( 1 );
+	std::vector<SStaticMeshLOD>				lods;
+	GenerateBenchmarkSphere( BENCHMARK_LOD_NUM_SEGMENTS, verteces, indeces );
+	appMemzero( surfaces.data(), sizeof( SStaticMeshSurface ) );
+	surfaces[ 0 ].numPrimitives = indeces.size() / 3;
+	OptimizeStaticMesh( verteces, indeces, surfaces );
+
+	double		startTime = appSeconds();
+	GenerateStaticMeshLODs( verteces, indeces, surfaces, lods );
+	double		time = appSeconds() - startTime;
+
+	TSharedPtr<CStaticMesh>		staticMesh = MakeSharedPtr<CStaticMesh>();
+	staticMesh->SetAssetName( TEXT( "BenchmarkSphere" ) );
+	staticMesh->SetData( verteces, indeces, surfaces, std::vector< TAssetHandle<CMaterial> >{ GEngine->GetDefaultMaterial() }, lods );
+	LE_LOG( LT_Log, LC_Commandlet, TEXT( "Generated %i LODs in %.2f ms" ), staticMesh->GetNumLODs(), time * 1000.0 );
+	for ( uint32 index = 0, count = staticMesh->GetNumLODs(); index < count; ++index )
+	{
+		LE_LOG( LT_Log, LC_Commandlet, TEXT( "LOD %i: %i triangles, screen size %.3f" ), index, staticMesh->GetNumPrimitives( index ), staticMesh->GetLODScreenSize( index ) );
+	}
+
+	// Spawn sphere in the world
+	GWorld->CleanupWorld();
+	AStaticMesh*		staticMeshActor = GWorld->SpawnActor< AStaticMesh >( Vector( 0.f, 0.f, 0.f ) );
+	staticMeshActor->SetStaticMesh( staticMesh->GetAssetHandle() );
+	FlushRenderingCommands();
+
+	CBaseScene*			scene				= GWorld->GetScene();
+	const Matrix		projectionMatrix	= glm::perspective( SMath::DegreesToRadians( 90.f ), 1280.f / 720.f, 0.01f, 1000.f );
+	const uint32		viewKey				= CViewportClient::AllocateViewKey();
+	const uint32		farViewKey			= CViewportClient::AllocateViewKey();
+	auto				renderAtDistance	= [&]( float InDistance, uint32 InViewKey ) -> uint32
+	{
+		const Vector		cameraLocation( 0.f, 0.f, InDistance );
+		CSceneView			sceneView( cameraLocation, projectionMatrix, glm::lookAt( cameraLocation, Vector( 0.f, 0.f, 0.f ), SMath::vectorUp ), 1280.f, 720.f, CColor::black, SHOW_DefaultGame, InViewKey );
+		GWorld->Tick( 1.f / 60.f );
+		scene->BuildView( sceneView );
+		scene->ClearView();
+		return staticMeshActor->GetStaticMeshComponent()->GetLastLOD( InViewKey );
+	};
+
+	// Triangles of selected LOD versus distance
+	for ( float distance = BENCHMARK_LOD_MIN_DISTANCE; distance <= BENCHMARK_LOD_MAX_DISTANCE; distance *= 2.f )
+	{
+		const uint32		lodIndex = renderAtDistance( distance, viewKey );
+		LE_LOG( LT_Log, LC_Commandlet, TEXT( "Distance %.1f: LOD %i, %i triangles (%.1f%% of LOD 0)" ), distance, lodIndex, staticMesh->GetNumPrimitives( lodIndex ), staticMesh->GetNumPrimitives( lodIndex ) * 100.f / staticMesh->GetNumPrimitives( 0 ) );
+	}
+
+	// Camera moves away and back with shake, hysteresis must keep number of LOD switches close to minimum.
+	// Second view is rendered far from sphere between frames, it must not switch LOD of the first view
+	uint32		numSwitches		= 0;
+	uint32		numFarSwitches	= 0;
+	uint64		numTriangles	= 0;
+	uint64		numTrianglesLOD0 = 0;
+	uint32		prevLOD			= renderAtDistance( BENCHMARK_LOD_MIN_DISTANCE, viewKey );
+	uint32		prevFarLOD		= renderAtDistance( BENCHMARK_LOD_MAX_DISTANCE, farViewKey );
+	for ( uint32 pass = 0; pass < 2; ++pass )
+	{
+		for ( float step = BENCHMARK_LOD_MIN_DISTANCE; step <= BENCHMARK_LOD_MAX_DISTANCE; step *= BENCHMARK_LOD_SWEEP_STEP )
+		{
+			const float		distance = pass == 0 ? step : BENCHMARK_LOD_MIN_DISTANCE * BENCHMARK_LOD_MAX_DISTANCE / step;
+			for ( uint32 shake = 0; shake < 2; ++shake )
+			{
+				const uint32		lodIndex	= renderAtDistance( shake == 0 ? distance : distance * BENCHMARK_LOD_SWEEP_SHAKE, viewKey );
+				const uint32		farLODIndex	= renderAtDistance( BENCHMARK_LOD_MAX_DISTANCE, farViewKey );
+				numFarSwitches		+= farLODIndex != prevFarLOD ? 1 : 0;
+				prevFarLOD			= farLODIndex;
+				numSwitches			+= lodIndex != prevLOD ? 1 : 0;
+				numTriangles		+= staticMesh->GetNumPrimitives( lodIndex );
+				numTrianglesLOD0	+= staticMesh->GetNumPrimitives( 0 );
+				prevLOD				= lodIndex;
+			}
+		}
+	}
+
+	LE_LOG( LT_Log, LC_Commandlet, TEXT( "Sweep with camera shake: %i LOD switches (minimum %i), %.1f%% of triangles of LOD 0" ), numSwitches, ( staticMesh->GetNumLODs() - 1 ) * 2, numTriangles * 100.0 / numTrianglesLOD0 );
+	LE_LOG( LT_Log, LC_Commandlet, TEXT( "Second view at distance %.1f: %i LOD switches (expected 0)" ), BENCHMARK_LOD_MAX_DISTANCE, numFarSwitches );
+
+	GWorld->CleanupWorld();
+	FlushRenderingCommands();
+}
+
+void CBenchmarkCommandlet::BenchmarkLightClustering()
+{
+	LE_LOG( LT_Log, LC_Commandlet, TEXT( "Benchmark of light clustering: %ix%ix%i clusters, %i iterations" ), LIGHTCLUSTER_GRID_SIZE_X, LIGHTCLUSTER_GRID_SIZE_Y, LIGHTCLUSTER_GRID_SIZE_Z, BENCHMARK_LIGHTS_NUM_ITERATIONS );
+
+	const Vector		cameraLocation( 0.f, 0.f, 0.f );
+	const Matrix		projectionMatrix	= glm::perspective( SMath::DegreesToRadians( 90.f ), 1280.f / 720.f, 0.01f, 1000.f );
+	CSceneView			sceneView( cameraLocation, projectionMatrix, glm::lookAt( cameraLocation, SMath::vectorForward, SMath::vectorUp ), 1280.f, 720.f, CColor::black, SHOW_DefaultGame );
+	for ( uint32 numLights = BENCHMARK_LIGHTS_MIN_NUM; numLights <= BENCHMARK_LIGHTS_MAX_NUM; numLights *= 10 )
+	{
+		// Scatter lights in pseudo random order around camera
+		std::vector<Vector4D>		lightSpheres( numLights );
+		uint32						seed = 1;
+		auto						random = [&]() -> float
+		{
+			seed = seed * 1664525U + 1013904223U;
+			return ( seed >> 8 ) / ( float )( 1 << 24 );
+		};
+
+		for ( uint32 index = 0; index < numLights; ++index )
+		{
+			lightSpheres[ index ] = Vector4D( ( random() - 0.5f ) * BENCHMARK_LIGHTS_AREA_SIZE, ( random() - 0.5f ) * BENCHMARK_LIGHTS_AREA_SIZE, ( random() - 0.5f ) * BENCHMARK_LIGHTS_AREA_SIZE, BENCHMARK_LIGHTS_MIN_RADIUS + random() * ( BENCHMARK_LIGHTS_MAX_RADIUS - BENCHMARK_LIGHTS_MIN_RADIUS ) );
+		}
+
+		// Frustum culling of lights like in CScene::BuildView, the grid is built only here for compare cost of binning
+		const CFrustum&			frustum = sceneView.GetFrustum();
+		uint32					numInFrustum = 0;
+		double					startTime = appSeconds();
+		for ( uint32 iteration = 0; iteration < BENCHMARK_LIGHTS_NUM_ITERATIONS; ++iteration )
+		{
+			numInFrustum = 0;
+			for ( uint32 index = 0; index < numLights; ++index )
+			{
+				if ( frustum.IsIn( Vector( lightSpheres[ index ] ), lightSpheres[ index ].w ) )
+				{
+					++numInFrustum;
+				}
+			}
+		}
+		const double			frustumTime = ( appSeconds() - startTime ) / BENCHMARK_LIGHTS_NUM_ITERATIONS;
+
+		CLightClusterGrid		lightClusterGrid;
+		startTime = appSeconds();
+		for ( uint32 iteration = 0; iteration < BENCHMARK_LIGHTS_NUM_ITERATIONS; ++iteration )
+		{
+			lightClusterGrid.Build( sceneView, lightSpheres.data(), numLights );
+		}
+		double					time = ( appSeconds() - startTime ) / BENCHMARK_LIGHTS_NUM_ITERATIONS;
+
+		uint32		maxLightsInCluster = 0;
+		for ( uint32 z = 0; z < LIGHTCLUSTER_GRID_SIZE_Z; ++z )
+		{
+			for ( uint32 y = 0; y < LIGHTCLUSTER_GRID_SIZE_Y; ++y )
+			{
+				for ( uint32 x = 0; x < LIGHTCLUSTER_GRID_SIZE_X; ++x )
+				{
+					maxLightsInCluster = Max( maxLightsInCluster, lightClusterGrid.GetCluster( x, y, z ).numLights );
+				}
+			}
+		}
+
+		const uint32		numOccupiedClusters = lightClusterGrid.GetNumOccupiedClusters();
+		LE_LOG( LT_Log, LC_Commandlet, TEXT( "%i lights: %i in frustum, %.3f ms" ), numLights, numInFrustum, frustumTime * 1000.0 );
+		LE_LOG( LT_Log, LC_Commandlet, TEXT( "%i lights: %i visible (%.1f%%), %i occupied clusters, %.2f lights per occupied cluster (max %i), %.3f ms" ), numLights, ( uint32 )lightClusterGrid.GetVisibleLights().size(), lightClusterGrid.GetVisibleLights().size() * 100.f / numLights, numOccupiedClusters, numOccupiedClusters > 0 ? lightClusterGrid.GetLightIndices().size() / ( float )numOccupiedClusters : 0.f, maxLightsInCluster, time * 1000.0 );
+	}
+}
+
+void CBenchmarkCommandlet::BenchmarkOcclusionCulling()
+{
+	LE_LOG( LT_Log, LC_Commandlet, TEXT( "Benchmark of occlusion culling: %i rows of %i buildings, %i objects, %ix%i occlusion buffer, %i iterations" ), BENCHMARK_OCCLUSION_NUM_ROWS, BENCHMARK_OCCLUSION_NUM_BUILDINGS, BENCHMARK_OCCLUSION_NUM_OBJECTS, OCCLUSION_BUFFER_SIZE_X, OCCLUSION_BUFFER_SIZE_Y, BENCHMARK_OCCLUSION_NUM_ITERATIONS );
+
+	// Unit cube is mesh of each building
+	Vector		cubeVerteces[ 8 ];
+	for ( uint32 index = 0; index < 8; ++index )
+	{
+		cubeVerteces[ index ] = Vector( index & 1 ? 0.5f : -0.5f, index & 2 ? 1.f : 0.f, index & 4 ? 0.5f : -0.5f );
+	}
+
+	const uint32	cubeFaces[ 6 ][ 4 ] = { { 0, 1, 3, 2 }, { 4, 6, 7, 5 }, { 0, 4, 5, 1 }, { 2, 3, 7, 6 }, { 0, 2, 6, 4 }, { 1, 5, 7, 3 } };
+	uint32			cubeIndeces[ 36 ];
+	for ( uint32 index = 0; index < 6; ++index )
+	{
+		const uint32	quad[ 6 ] = { 0, 1, 2, 0, 2, 3 };
+		for ( uint32 corner = 0; corner < 6; ++corner )
+		{
+			cubeIndeces[ index * 6 + corner ] = cubeFaces[ index ][ quad[ corner ] ];
+		}
+	}
+
+	// Rows of buildings in front of camera, there are gaps between buildings
+	std::vector<Matrix>		buildings;
+	for ( uint32 row = 0; row < BENCHMARK_OCCLUSION_NUM_ROWS; ++row )
+	{
+		for ( uint32 column = 0; column < BENCHMARK_OCCLUSION_NUM_BUILDINGS; ++column )
+		{
+			const Vector	location( ( column - BENCHMARK_OCCLUSION_NUM_BUILDINGS * 0.5f + 0.5f ) * BENCHMARK_OCCLUSION_BUILDING_STEP, 0.f, ( row + 1 ) * BENCHMARK_OCCLUSION_ROW_STEP );
+			buildings.push_back( glm::scale( glm::translate( SMath::matrixIdentity, location ), Vector( BENCHMARK_OCCLUSION_BUILDING_SIZE, BENCHMARK_OCCLUSION_BUILDING_HEIGHT, BENCHMARK_OCCLUSION_BUILDING_SIZE ) ) );
+		}
+	}
+
+	// Scatter objects on the ground in pseudo random order
+	std::vector<CBox>		objects( BENCHMARK_OCCLUSION_NUM_OBJECTS );
+	uint32					seed = 1;
+	auto					random = [&]() -> float
+	{
+		seed = seed * 1664525U + 1013904223U;
+		return ( seed >> 8 ) / ( float )( 1 << 24 );
+	};
+
+	const float		areaSizeX = BENCHMARK_OCCLUSION_NUM_BUILDINGS * BENCHMARK_OCCLUSION_BUILDING_STEP;
+	const float		areaSizeZ = ( BENCHMARK_OCCLUSION_NUM_ROWS + 1 ) * BENCHMARK_OCCLUSION_ROW_STEP;
+	for ( uint32 index = 0; index < BENCHMARK_OCCLUSION_NUM_OBJECTS; ++index )
+	{
+		const Vector	location( ( random() - 0.5f ) * areaSizeX, 0.f, random() * areaSizeZ );
+		objects[ index ] = CBox( location, location + Vector( BENCHMARK_OCCLUSION_OBJECT_SIZE, BENCHMARK_OCCLUSION_OBJECT_SIZE, BENCHMARK_OCCLUSION_OBJECT_SIZE ) );
+	}
+
+	// Camera is at height of human and looks along rows
+	const Vector		cameraLocation( 0.f, 2.f, 0.f );
+	const Matrix		projectionMatrix	= glm::perspective( SMath::DegreesToRadians( 90.f ), 1280.f / 720.f, 0.1f, 1000.f );
+	CSceneView			sceneView( cameraLocation, projectionMatrix, glm::lookAt( cameraLocation, cameraLocation + SMath::vectorForward, SMath::vectorUp ), 1280.f, 720.f, CColor::black, SHOW_DefaultGame );
+	COcclusionBuffer	occlusionBuffer;
+	uint32				numInFrustum	= 0;
+	uint32				numVisible		= 0;
+	double				rasterizeTime	= 0.0;
+	double				testTime		= 0.0;
+	for ( uint32 iteration = 0; iteration < BENCHMARK_OCCLUSION_NUM_ITERATIONS; ++iteration )
+	{
+		occlusionBuffer.Begin( sceneView );
+		for ( uint32 index = 0, count = buildings.size(); index < count; ++index )
+		{
+			occlusionBuffer.AddOccluder( cubeVerteces, cubeIndeces, ARRAY_COUNT( cubeIndeces ), buildings[ index ] );
+		}
+		occlusionBuffer.Rasterize();
+		rasterizeTime += occlusionBuffer.GetStats().rasterizeTime;
+
+		numInFrustum	= 0;
+		numVisible		= 0;
+		double		startTime = appSeconds();
+		for ( uint32 index = 0; index < BENCHMARK_OCCLUSION_NUM_OBJECTS; ++index )
+		{
+			if ( sceneView.GetFrustum().IsIn( objects[ index ] ) )
+			{
+				++numInFrustum;
+				if ( occlusionBuffer.IsVisible( objects[ index ] ) )
+				{
+					++numVisible;
+				}
+			}
+		}
+		testTime += appSeconds() - startTime;
+	}
+
+	const SOcclusionStats&		stats = occlusionBuffer.GetStats();
+	LE_LOG( LT_Log, LC_Commandlet, TEXT( "Occluders: %i (%i triangles, %i rasterized), rasterization %.3f ms" ), stats.numOccluders, stats.numOccluderTriangles, stats.numRasterizedTriangles, rasterizeTime * 1000.0 / BENCHMARK_OCCLUSION_NUM_ITERATIONS );
+	LE_LOG( LT_Log, LC_Commandlet, TEXT( "Objects: %i in frustum, %i culled by occlusion (%.1f%%), frustum and occlusion tests %.3f ms" ), numInFrustum, numInFrustum - numVisible, numInFrustum > 0 ? ( numInFrustum - numVisible ) * 100.f / numInFrustum : 0.f, testTime * 1000.0 / BENCHMARK_OCCLUSION_NUM_ITERATIONS );
+}
+
+void CBenchmarkCommandlet::BenchmarkOverdraw()
+{
+	LE_LOG( LT_Log, LC_Commandlet, TEXT( "Benchmark of overdraw: %i instances, %ix%i depth buffer, %i iterations" ), BENCHMARK_OVERDRAW_NUM_INSTANCES, BENCHMARK_OVERDRAW_BUFFER_SIZE_X, BENCHMARK_OVERDRAW_BUFFER_SIZE_Y, BENCHMARK_OVERDRAW_NUM_ITERATIONS );
+
+	// Null RHI doesn't rasterize, so instances are rasterized on CPU as screen aligned quads with constant depth
+	const Vector		cameraLocation( 0.f, 0.f, 0.f );
+	const Matrix		projectionMatrix	= glm::perspective( SMath::DegreesToRadians( 90.f ), 1280.f / 720.f, 0.1f, 1000.f );
+	CSceneView			sceneView( cameraLocation, projectionMatrix, glm::lookAt( cameraLocation, cameraLocation + SMath::vectorForward, SMath::vectorUp ), 1280.f, 720.f, CColor::black, SHOW_DefaultGame );
+
+	// Scatter instances in view frustum in pseudo random order, like order of instances added by primitives
+	std::vector<SMeshInstance>		instances( BENCHMARK_OVERDRAW_NUM_INSTANCES );
+	uint32							seed = 1;
+	auto							random = [&]() -> float
+	{
+		seed = seed * 1664525U + 1013904223U;
+		return ( seed >> 8 ) / ( float )( 1 << 24 );
+	};
+
+	for ( uint32 index = 0; index < BENCHMARK_OVERDRAW_NUM_INSTANCES; ++index )
+	{
+		const float		depth = 1.f + random() * BENCHMARK_OVERDRAW_AREA_DEPTH;
+		const Vector	location( ( random() - 0.5f ) * depth * 2.f, ( random() - 0.5f ) * depth * 1.f, depth );
+		instances[ index ].transformMatrix	= glm::translate( SMath::matrixIdentity, location );
+#if WITH_EDITOR
+		instances[ index ].bSelected		= false;
+#endif // WITH_EDITOR
+	}
+
+	// Rasterize instances in their order, return number of shaded pixels. If InIsDepthEqual is TRUE, depth buffer
+	// is filled by depth pre-pass and only pixels with equal depth are shaded
+	std::vector<float>		depthBuffer( BENCHMARK_OVERDRAW_BUFFER_SIZE_X * BENCHMARK_OVERDRAW_BUFFER_SIZE_Y );
+	auto					rasterize = [&]( const std::vector<SMeshInstance>& InInstances, bool InIsDepthEqual ) -> uint32
+	{
+		uint32		numShaded = 0;
+		for ( uint32 index = 0, count = ( uint32 )InInstances.size(); index < count; ++index )
+		{
+			const Vector4D		clipPosition	= sceneView.WorldToScreen( Vector( InInstances[ index ].transformMatrix[ 3 ] ) );
+			if ( clipPosition.w <= 0.f )
+			{
+				continue;
+			}
+
+			const float			centerX			= ( clipPosition.x / clipPosition.w * 0.5f + 0.5f ) * BENCHMARK_OVERDRAW_BUFFER_SIZE_X;
+			const float			centerY			= ( clipPosition.y / clipPosition.w * 0.5f + 0.5f ) * BENCHMARK_OVERDRAW_BUFFER_SIZE_Y;
+			const float			extentX			= BENCHMARK_OVERDRAW_INSTANCE_SIZE * 0.25f * projectionMatrix[ 0 ][ 0 ] / clipPosition.w * BENCHMARK_OVERDRAW_BUFFER_SIZE_X;
+			const float			extentY			= BENCHMARK_OVERDRAW_INSTANCE_SIZE * 0.25f * projectionMatrix[ 1 ][ 1 ] / clipPosition.w * BENCHMARK_OVERDRAW_BUFFER_SIZE_Y;
+			const int32			minX			= Max<int32>( ( int32 )( centerX - extentX ), 0 );
+			const int32			maxX			= Min<int32>( ( int32 )( centerX + extentX ), BENCHMARK_OVERDRAW_BUFFER_SIZE_X - 1 );
+			const int32			minY			= Max<int32>( ( int32 )( centerY - extentY ), 0 );
+			const int32			maxY			= Min<int32>( ( int32 )( centerY + extentY ), BENCHMARK_OVERDRAW_BUFFER_SIZE_Y - 1 );
+			for ( int32 y = minY; y <= maxY; ++y )
+			{
+				float*		depthRow = &depthBuffer[ y * BENCHMARK_OVERDRAW_BUFFER_SIZE_X ];
+				for ( int32 x = minX; x <= maxX; ++x )
+				{
+					if ( InIsDepthEqual ? clipPosition.w == depthRow[ x ] : clipPosition.w < depthRow[ x ] )
+					{
+						depthRow[ x ] = clipPosition.w;
+						++numShaded;
+					}
+				}
+			}
+		}
+		return numShaded;
+	};
+
+	auto		clearDepthBuffer = [&]()
+	{
+		std::fill( depthBuffer.begin(), depthBuffer.end(), FLT_MAX );
+	};
+
+	// Unsorted instances
+	clearDepthBuffer();
+	const uint32	numUnsortedShaded = rasterize( instances, false );
+	uint32			numCovered = 0;
+	for ( uint32 index = 0, count = ( uint32 )depthBuffer.size(); index < count; ++index )
+	{
+		numCovered += depthBuffer[ index ] != FLT_MAX ? 1 : 0;
+	}
+
+	// Instances sorted by draw list
+	typedef CMeshDrawList<CMeshDrawingPolicy>		BenchmarkDrawList_t;
+	BenchmarkDrawList_t								drawList;
+	BenchmarkDrawList_t::DrawingPolicyLinkRef_t		drawingPolicyLink = new BenchmarkDrawList_t::SDrawingPolicyLink();
+	SMeshBatch										meshBatch;
+	meshBatch.primitiveType = PT_TriangleList;
+	const SMeshBatch&								meshBatchLink = *drawingPolicyLink->meshBatchList.insert( meshBatch ).first;
+	drawList.AddItem( drawingPolicyLink );
+
+	double		sortTime = 0.0;
+	for ( uint32 iteration = 0; iteration < BENCHMARK_OVERDRAW_NUM_ITERATIONS; ++iteration )
+	{
+		meshBatchLink.instances		= instances;
+		meshBatchLink.numInstances	= ( uint32 )instances.size();
+
+		double		startTime = appSeconds();
+		drawList.SortInstances( cameraLocation );
+		sortTime += appSeconds() - startTime;
+	}
+
+	clearDepthBuffer();
+	const uint32	numSortedShaded = rasterize( meshBatchLink.instances, false );
+
+	// Depth pre-pass, after it each covered pixel is shaded once
+	clearDepthBuffer();
+	rasterize( meshBatchLink.instances, false );
+	const uint32	numPrepassShaded = rasterize( meshBatchLink.instances, true );
+
+	LE_LOG( LT_Log, LC_Commandlet, TEXT( "Covered pixels: %i (%.1f%% of buffer)" ), numCovered, numCovered * 100.f / depthBuffer.size() );
+	LE_LOG( LT_Log, LC_Commandlet, TEXT( "Shaded pixels: unsorted %i (overdraw x%.2f), sorted front to back %i (overdraw x%.2f), with depth pre-pass %i (overdraw x%.2f)" ), 
+			numUnsortedShaded, ( float )numUnsortedShaded / Max<uint32>( numCovered, 1 ), 
+			numSortedShaded, ( float )numSortedShaded / Max<uint32>( numCovered, 1 ), 
+			numPrepassShaded, ( float )numPrepassShaded / Max<uint32>( numCovered, 1 ) );
+	LE_LOG( LT_Log, LC_Commandlet, TEXT( "Sort time of instances: %.3f ms" ), sortTime * 1000.0 / BENCHMARK_OVERDRAW_NUM_ITERATIONS );
+}
+void CBenchmarkCommandlet::BenchmarkPicking()
+{
+	LE_LOG( LT_Log, LC_Commandlet, TEXT( "Benchmark of picking: %ix%i spheres with %ix%i segments, %i rays" ), BENCHMARK_PICKING_GRID_SIZE, BENCHMARK_PICKING_GRID_SIZE, BENCHMARK_PICKING_NUM_SEGMENTS, BENCHMARK_PICKING_NUM_SEGMENTS, BENCHMARK_PICKING_NUM_RAYS );
+
+	// Generate sphere
+	std::vector<SStaticMeshVertexType>		verteces;
+	std::vector<uint32>						indeces;
+	std::vector<SStaticMeshSurface>			surfaces( 1 );
+	GenerateBenchmarkSphere( BENCHMARK_PICKING_NUM_SEGMENTS, verteces, indeces );
+	appMemzero( surfaces.data(), sizeof( SStaticMeshSurface ) );
+	surfaces[ 0 ].numPrimitives = indeces.size() / 3;
+
+	TSharedPtr<CStaticMesh>		staticMesh = MakeSharedPtr<CStaticMesh>();
+	staticMesh->SetAssetName( TEXT( "BenchmarkSphere" ) );
+	staticMesh->SetData( verteces, indeces, surfaces, std::vector< TAssetHandle<CMaterial> >{ GEngine->GetDefaultMaterial() } );
+
+	// Spawn grid of spheres on the ground
+	GWorld->CleanupWorld();
+	std::vector<AStaticMesh*>		staticMeshActors;
+	for ( uint32 row = 0; row < BENCHMARK_PICKING_GRID_SIZE; ++row )
+	{
+		for ( uint32 column = 0; column < BENCHMARK_PICKING_GRID_SIZE; ++column )
+		{
+			AStaticMesh*		staticMeshActor = GWorld->SpawnActor< AStaticMesh >( Vector( column * BENCHMARK_PICKING_GRID_STEP, 0.f, row * BENCHMARK_PICKING_GRID_STEP ) );
+			staticMeshActor->SetStaticMesh( staticMesh->GetAssetHandle() );
+			staticMeshActors.push_back( staticMeshActor );
+		}
+	}
+	FlushRenderingCommands();
+
+	// Bound boxes of primitives are updated by building view
+	CBaseScene*			scene				= GWorld->GetScene();
+	const float			areaSize			= BENCHMARK_PICKING_GRID_SIZE * BENCHMARK_PICKING_GRID_STEP;
+	const Vector		cameraLocation( areaSize * 0.5f, areaSize, -areaSize * 0.5f );
+	const Matrix		projectionMatrix	= glm::perspective( SMath::DegreesToRadians( 90.f ), 1280.f / 720.f, 0.01f, 1000.f );
+	CSceneView			sceneView( cameraLocation, projectionMatrix, glm::lookAt( cameraLocation, Vector( areaSize * 0.5f, 0.f, areaSize * 0.5f ), SMath::vectorUp ), 1280.f, 720.f, CColor::black, SHOW_DefaultGame );
+	GWorld->Tick( 1.f / 60.f );
+	scene->BuildView( sceneView );
+	scene->ClearView();
+
+	// Rays from camera to pseudo random points on the ground
+	std::vector<Vector>		rayDirections( BENCHMARK_PICKING_NUM_RAYS );
+	uint32					seed = 1;
+	auto					random = [&]() -> float
+	{
+		seed = seed * 1664525U + 1013904223U;
+		return ( seed >> 8 ) / ( float )( 1 << 24 );
+	};
+
+	for ( uint32 index = 0; index < BENCHMARK_PICKING_NUM_RAYS; ++index )
+	{
+		rayDirections[ index ] = SMath::NormalizeVector( Vector( random() * areaSize, 0.f, random() * areaSize ) - cameraLocation );
+	}
+
+	// The first ray cast builds BVH of scene and BVH of sphere
+	SRayCastResult		rayCastResult;
+	double				startTime = appSeconds();
+	scene->RayCast( cameraLocation, rayDirections[ 0 ], rayCastResult );
+	double				buildTime = appSeconds() - startTime;
+
+	std::vector<CPrimitiveComponent*>		bvhHits( BENCHMARK_PICKING_NUM_RAYS );
+	startTime = appSeconds();
+	for ( uint32 index = 0; index < BENCHMARK_PICKING_NUM_RAYS; ++index )
+	{
+		bvhHits[ index ] = scene->RayCast( cameraLocation, rayDirections[ index ], rayCastResult ) ? rayCastResult.primitive : nullptr;
+	}
+	double				bvhTime = appSeconds() - startTime;
+
+	// Brute force test of all triangles of all spheres
+	std::vector<CPrimitiveComponent*>		bruteForceHits( BENCHMARK_PICKING_NUM_RAYS );
+	startTime = appSeconds();
+	for ( uint32 index = 0; index < BENCHMARK_PICKING_NUM_RAYS; ++index )
+	{
+		float		closestDistance = FLT_MAX;
+		bruteForceHits[ index ] = nullptr;
+		for ( uint32 actorIndex = 0, numActors = staticMeshActors.size(); actorIndex < numActors; ++actorIndex )
+		{
+			CStaticMeshComponent*	staticMeshComponent = staticMeshActors[ actorIndex ]->GetStaticMeshComponent();
+			const Matrix			worldToLocal		= SMath::InverseMatrix( staticMeshComponent->GetComponentTransform().ToMatrix() );
+			const Vector			localOrigin			= Vector( worldToLocal * Vector4D( cameraLocation, 1.f ) );
+			const Vector			localDirection		= Vector( worldToLocal * Vector4D( rayDirections[ index ], 0.f ) );
+			for ( uint32 triangleIndex = 0, numIndeces = indeces.size(); triangleIndex < numIndeces; triangleIndex += 3 )
+			{
+				float		distance = 0.f;
+				if ( CBVH::RayTriangleIntersect( localOrigin, localDirection, Vector( verteces[ indeces[ triangleIndex ] ].position ), Vector( verteces[ indeces[ triangleIndex + 1 ] ].position ), Vector( verteces[ indeces[ triangleIndex + 2 ] ].position ), distance ) && distance < closestDistance )
+				{
+					closestDistance				= distance;
+					bruteForceHits[ index ]		= staticMeshComponent;
+				}
+			}
+		}
+	}
+	double				bruteForceTime = appSeconds() - startTime;
+
+	uint32		numHits			= 0;
+	uint32		numMismatches	= 0;
+	for ( uint32 index = 0; index < BENCHMARK_PICKING_NUM_RAYS; ++index )
+	{
+		numHits			+= bvhHits[ index ] ? 1 : 0;
+		numMismatches	+= bvhHits[ index ] != bruteForceHits[ index ] ? 1 : 0;
+	}
+
+	LE_LOG( LT_Log, LC_Commandlet, TEXT( "BVH build (first ray cast): %.3f ms" ), buildTime * 1000.0 );
+	LE_LOG( LT_Log, LC_Commandlet, TEXT( "BVH: %.4f ms per ray, brute force: %.4f ms per ray (%.1fx)" ), bvhTime * 1000.0 / BENCHMARK_PICKING_NUM_RAYS, bruteForceTime * 1000.0 / BENCHMARK_PICKING_NUM_RAYS, bvhTime > 0.0 ? bruteForceTime / bvhTime : 0.0 );
+	LE_LOG( LT_Log, LC_Commandlet, TEXT( "Hits: %i of %i rays, %i mismatches with brute force" ), numHits, BENCHMARK_PICKING_NUM_RAYS, numMismatches );
+
+	GWorld->CleanupWorld();
+	FlushRenderingCommands();
+}
+
+void CBenchmarkCommandlet::BenchmarkYUVConversion()
+{
+	LE_LOG( LT_Log, LC_Commandlet, TEXT( "Benchmark of YUV420 to texture conversion: %i frames" ), BENCHMARK_YUV_NUM_FRAMES );
+
+	const uint32		frameSizes[][ 2 ] = { { 1920, 1080 }, { 3840, 2160 } };
+	for ( uint32 indexSize = 0; indexSize < ARRAY_COUNT( frameSizes ); ++indexSize )
+	{
+		const uint32		sizeX		= frameSizes[ indexSize ][ 0 ];
+		const uint32		sizeY		= frameSizes[ indexSize ][ 1 ];
+		const uint32		uvSizeX		= ( sizeX + 1 ) / 2;
+		const uint32		uvSizeY		= ( sizeY + 1 ) / 2;
+
+		// Generate noise planes
+		std::vector<byte>	planeY( sizeX * sizeY );
+		std::vector<byte>	planeU( uvSizeX * uvSizeY );
+		std::vector<byte>	planeV( uvSizeX * uvSizeY );
+		uint32				seed = 1;
+		for ( uint32 index = 0, count = ( uint32 )planeY.size(); index < count; ++index )
+		{
+			seed = seed * 1664525U + 1013904223U;
+			planeY[ index ] = ( byte )( seed >> 24 );
+		}
+
+		for ( uint32 index = 0, count = ( uint32 )planeU.size(); index < count; ++index )
+		{
+			seed = seed * 1664525U + 1013904223U;
+			planeU[ index ] = ( byte )( seed >> 24 );
+			planeV[ index ] = ( byte )( seed >> 16 );
+		}
+
+		// Scalar per pixel loop, it is the same as conversion in Theora movie player before SSE2
+		std::vector<byte>	scalarTexels( sizeX * sizeY * 4 );
+		double				startTime = appSeconds();
+		for ( uint32 frame = 0; frame < BENCHMARK_YUV_NUM_FRAMES; ++frame )
+		{
+			for ( uint32 y = 0; y < sizeY; ++y )
+			{
+				for ( uint32 x = 0; x < sizeX; ++x )
+				{
+					const uint32	offset	= x + y * sizeX;
+					const uint32	xx		= x >> 1;
+					const uint32	yy		= y >> 1;
+
+					scalarTexels[ offset * GPixelFormats[ PF_A8R8G8B8 ].blockBytes + 0 ]	= planeY[ x + y * sizeX ];
+					scalarTexels[ offset * GPixelFormats[ PF_A8R8G8B8 ].blockBytes + 1 ]	= planeU[ xx + yy * uvSizeX ];
+					scalarTexels[ offset * GPixelFormats[ PF_A8R8G8B8 ].blockBytes + 2 ]	= planeV[ xx + yy * uvSizeX ];
+					scalarTexels[ offset * GPixelFormats[ PF_A8R8G8B8 ].blockBytes + 3 ]	= 255;
+				}
+			}
+		}
+		double				scalarTime = ( appSeconds() - startTime ) / BENCHMARK_YUV_NUM_FRAMES;
+
+		// SSE2 conversion
+		SYUV420Planes		planes;
+		planes.y		= planeY.data();
+		planes.u		= planeU.data();
+		planes.v		= planeV.data();
+		planes.yStride	= sizeX;
+		planes.uvStride	= uvSizeX;
+
+		std::vector<byte>	simdTexels( sizeX * sizeY * 4 );
+		startTime = appSeconds();
+		for ( uint32 frame = 0; frame < BENCHMARK_YUV_NUM_FRAMES; ++frame )
+		{
+			ConvertYUV420ToYUVA( planes, sizeX, sizeY, simdTexels.data(), sizeX * 4 );
+		}
+		double				simdTime = ( appSeconds() - startTime ) / BENCHMARK_YUV_NUM_FRAMES;
+
+		const bool			bMatch = memcmp( scalarTexels.data(), simdTexels.data(), simdTexels.size() ) == 0;
+		LE_LOG( LT_Log, LC_Commandlet, TEXT( "%ix%i: scalar %.2f ms (%.1f FPS), SSE2 %.2f ms (%.1f FPS), %.1fx, results %s" ),
+				sizeX, sizeY,
+				scalarTime * 1000.0, 1.0 / Max( scalarTime, 0.000001 ),
+				simdTime * 1000.0, 1.0 / Max( simdTime, 0.000001 ),
+				simdTime > 0.0 ? scalarTime / simdTime : 0.0,
+				bMatch ? TEXT( "match" ) : TEXT( "mismatch" ) );
+	}
+}
\ No newline at end of file
@@ -3,6 +3,8 @@
 #include <tmxlite/TileLayer.hpp>
 #include <tmxlite/Object.hpp>
 #include <vector>
+#include <set>
+#include <tuple>
 
 #include "Commandlets/CookPackagesCommandlet.h"
 #include "Containers/StringConv.h"
@@ -19,14 +21,19 @@
 #include "System/AudioBuffer.h"
 #include "Logger/LoggerMacros.h"
 #include "Render/Shaders/ShaderCompiler.h"
+#include "Render/TextureMips.h"
+#include "System/TextureCompressor.h"
+#include "System/TextureAtlas.h"
 
 // Actors
 #include "Actors/PlayerStart.h"
-#include "Actors/Sprite.h"
+#include "Actors/TileMap.h"
+#include "Components/PrimitiveComponent.h"
 
 // Vertex factories
 #include "Render/VertexFactory/StaticMeshVertexFactory.h"
 #include "Render/VertexFactory/SpriteVertexFactory.h"
+#include "Render/Shaders/DepthOnlyShader.h"
 
 IMPLEMENT_CLASS( CCookPackagesCommandlet )
 
@@ -69,6 +76,9 @@ FORCEINLINE std::wstring TMXPropertyTypeToText( tmx::Property::Type InTmxPropert
 CCookPackagesCommandlet::CCookPackagesCommandlet()
 	: cookedShaderPlatform( SP_Unknown )
 	, cookedPlatform( PLATFORM_Unknown )
+	, textureCompression( TC_Default )
+	, bAtlasTilesets( true )
+	, atlasPadding( TEXTUREATLAS_DEFAULT_PADDING )
 {}
 
 /**
@@ -97,6 +107,13 @@ bool CCookPackagesCommandlet::CookMap( const SResourceInfo& InMapInfo )
 		return false;
 	}
 
+	// Pack tilesets into atlases
+	if ( bAtlasTilesets && !BuildTilesetAtlases( InMapInfo, tilesets ) )
+	{
+		appErrorf( TEXT( "Failed building atlases of TMX tilesets" ) );
+		return false;
+	}
+
 	// Clear world for spawn new actors
 	GWorld->CleanupWorld();
 
@@ -106,8 +123,12 @@ bool CCookPackagesCommandlet::CookMap( const SResourceInfo& InMapInfo )
 	// Spawn actors
 	SpawnActorsInWorld( tmxMap, tilesets );
 
+	// Record bound shader states for create them at map load
+	const std::wstring		mapName = CString::Format( TEXT( "%s.%s" ), InMapInfo.filename.c_str(), extensionInfo.map.c_str() );
+	RecordBoundShaderStates( mapName );
+
 	// Serialize world to HDD
-	CArchive*		archive = GFileSystem->CreateFileWriter( CString::Format( TEXT( "%s") PATH_SEPARATOR TEXT( "%s.%s" ), GCookedDir.c_str(), InMapInfo.filename.c_str(), extensionInfo.map.c_str() ), AW_NoFail );
+	CArchive*		archive = GFileSystem->CreateFileWriter( GCookedDir + PATH_SEPARATOR + mapName, AW_NoFail );
 	archive->SetType( AT_World );
 	archive->SerializeHeader();
 	GWorld->Serialize( *archive );
@@ -115,6 +136,65 @@ bool CCookPackagesCommandlet::CookMap( const SResourceInfo& InMapInfo )
 	return true;
 }
 
+void CCookPackagesCommandlet::RecordBoundShaderStates( const std::wstring& InMapName )
+{
+	// Shader cache stores bound shader states by vertex factory types, because vertex declarations are created at runtime
+	std::vector< TAssetHandle<CMaterial> >		usedMaterials;
+	std::vector< uint64 >						vertexFactoryHashes;
+	for ( uint32 indexActor = 0, countActors = GWorld->GetNumActors(); indexActor < countActors; ++indexActor )
+	{
+		const std::vector< ActorComponentRef_t >&		components = GWorld->GetActor( indexActor )->GetComponents();
+		for ( uint32 indexComponent = 0, countComponents = ( uint32 )components.size(); indexComponent < countComponents; ++indexComponent )
+		{
+			CPrimitiveComponent*		primitiveComponent = components[ indexComponent ]->Cast< CPrimitiveComponent >();
+			if ( primitiveComponent )
+			{
+				primitiveComponent->GetUsedMaterials( usedMaterials );
+			}
+		}
+	}
+
+	for ( uint32 indexMaterial = 0, countMaterials = ( uint32 )usedMaterials.size(); indexMaterial < countMaterials; ++indexMaterial )
+	{
+		TSharedPtr<CMaterial>		materialRef = usedMaterials[ indexMaterial ].ToSharedPtr();
+		if ( !materialRef )
+		{
+			continue;
+		}
+
+		CShaderCache::SBoundShaderStateItem		item;
+		item.vertexShaderName	= materialRef->GetShaderType( SF_Vertex )->GetName();
+		item.pixelShaderName	= materialRef->GetShaderType( SF_Pixel )->GetName();
+		item.bPositionOnly		= false;
+
+		// Depth only pass draws only opaque not masked materials (see CDepthOnlyDrawingPolicy)
+		const bool		bDepthOnly = !materialRef->IsMasked() && !materialRef->IsWireframe();
+
+		vertexFactoryHashes.clear();
+		materialRef->GetUsedVertexFactoryHashes( vertexFactoryHashes );
+		for ( uint32 indexVF = 0, countVFs = ( uint32 )vertexFactoryHashes.size(); indexVF < countVFs; ++indexVF )
+		{
+			item.vertexFactoryHash = vertexFactoryHashes[ indexVF ];
+			if ( shaderCache.IsExist( item.vertexShaderName, item.vertexFactoryHash ) && shaderCache.IsExist( item.pixelShaderName, item.vertexFactoryHash ) )
+			{
+				shaderCache.AddBoundShaderState( InMapName, item );
+			}
+
+			if ( bDepthOnly && shaderCache.IsExist( CDepthOnlyVertexShader::staticType.GetName(), item.vertexFactoryHash ) )
+			{
+				CShaderCache::SBoundShaderStateItem		depthOnlyItem;
+				depthOnlyItem.vertexFactoryHash		= item.vertexFactoryHash;
+				depthOnlyItem.vertexShaderName		= CDepthOnlyVertexShader::staticType.GetName();
+				depthOnlyItem.bPositionOnly			= true;
+				shaderCache.AddBoundShaderState( InMapName, depthOnlyItem );
+			}
+		}
+	}
+
+	auto		itBoundShaderStates = shaderCache.GetBoundShaderStates().find( InMapName );
+	LE_LOG( LT_Log, LC_Commandlet, TEXT( "Recorded %i bound shader states used by map '%s'" ), itBoundShaderStates != shaderCache.GetBoundShaderStates().end() ? ( uint32 )itBoundShaderStates->second.size() : 0, InMapName.c_str() );
+}
+
 bool CCookPackagesCommandlet::LoadTMXTilests( const tmx::Map& InTMXMap, std::vector<STMXTileset>& OutTilesets )
 {
 	const std::vector< tmx::Tileset >&		tmxTilesets		= InTMXMap.getTilesets();
@@ -191,6 +271,181 @@ bool CCookPackagesCommandlet::LoadTMXTilests( const tmx::Map& InTMXMap, std::vec
 	return true;
 }
 
+/**
+ * Is materials can be merged into one with atlas of diffuse textures
+ *
+ * @param InA	First material
+ * @param InB	Second material
+ * @return Return true if materials differ only by diffuse texture, else returning false
+ */
+static bool IsCompatibleMaterialsForAtlas( const TSharedPtr<CMaterial>& InA, const TSharedPtr<CMaterial>& InB )
+{
+	if ( InA->IsTwoSided() != InB->IsTwoSided() || InA->IsWireframe() != InB->IsWireframe() || InA->IsMasked() != InB->IsMasked() || InA->GetUsageFlags() != InB->GetUsageFlags() ||
+		 InA->GetScalarParameters() != InB->GetScalarParameters() || InA->GetVectorParameters() != InB->GetVectorParameters() )
+	{
+		return false;
+	}
+
+	const auto&		textureParametersA = InA->GetTextureParameters();
+	const auto&		textureParametersB = InB->GetTextureParameters();
+	if ( textureParametersA.size() != textureParametersB.size() )
+	{
+		return false;
+	}
+
+	for ( auto itA = textureParametersA.begin(), itAEnd = textureParametersA.end(); itA != itAEnd; ++itA )
+	{
+		auto		itB = textureParametersB.find( itA->first );
+		if ( itB == textureParametersB.end() || ( !( itA->first == CMaterial::diffuseTextureParamName ) && !( itA->second == itB->second ) ) )
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool CCookPackagesCommandlet::BuildTilesetAtlases( const SResourceInfo& InMapInfo, std::vector<STMXTileset>& InOutTilesets )
+{
+	/**
+	 * Group of tilesets packed into one atlas
+	 */
+	struct SAtlasGroup
+	{
+		TSharedPtr<CMaterial>		material;		/**< Material of the first tileset in group */
+		std::vector<uint32>			tilesets;		/**< Indeces of tilesets */
+		std::vector<byte*>			images;			/**< Images of diffuse textures */
+		std::vector<tmx::Vector2u>	imageSizes;		/**< Sizes of images */
+	};
+
+	// Group tilesets by compatible materials, tilesets without source image of diffuse texture aren't packed
+	std::vector<SAtlasGroup>		groups;
+	for ( uint32 indexTileset = 0, countTilesets = InOutTilesets.size(); indexTileset < countTilesets; ++indexTileset )
+	{
+		TSharedPtr<CMaterial>		materialRef = InOutTilesets[ indexTileset ].material.ToSharedPtr();
+		TAssetHandle<CTexture2D>	diffuseTexture;
+		if ( !materialRef || !materialRef->GetTextureParameterValue( CMaterial::diffuseTextureParamName, diffuseTexture ) || !diffuseTexture.IsAssetValid() )
+		{
+			continue;
+		}
+
+		int				numComponents	= 0;
+		tmx::Vector2u	imageSize;
+		byte*			image			= ( byte* )stbi_load( TCHAR_TO_ANSI( diffuseTexture.ToSharedPtr()->GetAssetSourceFile().c_str() ), ( int* ) &imageSize.x, ( int* ) &imageSize.y, &numComponents, 4 );
+		if ( !image )
+		{
+			LE_LOG( LT_Warning, LC_Commandlet, TEXT( "Tileset with material '%s' not packed into atlas, source image of diffuse texture not found" ), materialRef->GetAssetName().c_str() );
+			continue;
+		}
+
+		SAtlasGroup*	group = nullptr;
+		for ( uint32 indexGroup = 0, countGroups = groups.size(); indexGroup < countGroups; ++indexGroup )
+		{
+			if ( IsCompatibleMaterialsForAtlas( groups[ indexGroup ].material, materialRef ) )
+			{
+				group = &groups[ indexGroup ];
+				break;
+			}
+		}
+
+		if ( !group )
+		{
+			groups.push_back( SAtlasGroup{ materialRef } );
+			group = &groups.back();
+		}
+
+		group->tilesets.push_back( indexTileset );
+		group->images.push_back( image );
+		group->imageSizes.push_back( imageSize );
+	}
+
+	// Build atlas for each group with more than one tileset
+	SResourceInfo		atlasInfo		= InMapInfo;
+	uint32				numAtlases		= 0;
+	atlasInfo.packageName				= InMapInfo.filename + TEXT( "_Atlases" );
+	for ( uint32 indexGroup = 0, countGroups = groups.size(); indexGroup < countGroups; ++indexGroup )
+	{
+		SAtlasGroup&			group = groups[ indexGroup ];
+		CTextureAtlasBuilder	atlasBuilder( TEXTUREATLAS_MAX_SIZE, atlasPadding );
+		for ( uint32 index = 0, count = group.images.size(); index < count; ++index )
+		{
+			atlasBuilder.AddImage( group.imageSizes[ index ].x, group.imageSizes[ index ].y, group.images[ index ] );
+		}
+
+		if ( group.tilesets.size() > 1 && atlasBuilder.Build() )
+		{
+			// Create texture of atlas
+			TSharedPtr<CTexture2D>		texture2DRef = MakeSharedPtr<CTexture2D>();
+			texture2DRef->SetAssetName( CString::Format( TEXT( "%s_Atlas%i" ), InMapInfo.filename.c_str(), numAtlases ) );
+			texture2DRef->SetCompression( textureCompression );
+			{
+				std::vector< byte >		mipChain;
+				std::vector< byte >		tempData;
+				uint32					numMips		= GenerateMipChain( PF_A8R8G8B8, atlasBuilder.GetSizeX(), atlasBuilder.GetSizeY(), atlasBuilder.GetData().data(), mipChain );
+				EPixelFormat			pixelFormat = CompressTexture( texture2DRef->GetCompression(), atlasBuilder.GetSizeX(), atlasBuilder.GetSizeY(), numMips, mipChain, tempData );
+				texture2DRef->SetData( pixelFormat, atlasBuilder.GetSizeX(), atlasBuilder.GetSizeY(), tempData, numMips );
+			}
+
+			TAssetHandle<CTexture2D>	atlasTexture = TAssetHandle<CTexture2D>( texture2DRef, MakeSharedPtr<SAssetReference>( AT_Texture2D, texture2DRef->GetGUID() ) );
+			if ( !SaveToPackage( atlasInfo, atlasTexture ) )
+			{
+				return false;
+			}
+
+			// Create material of atlas, it is copy of the first material with diffuse texture of atlas
+			TSharedPtr<CMaterial>		materialRef = MakeSharedPtr<CMaterial>();
+			materialRef->SetAssetName( CString::Format( TEXT( "%s_AtlasMaterial%i" ), InMapInfo.filename.c_str(), numAtlases ) );
+			materialRef->SetTwoSided( group.material->IsTwoSided() );
+			materialRef->SetWireframe( group.material->IsWireframe() );
+			materialRef->SetMasked( group.material->IsMasked() );
+			materialRef->SetUsageFlags( group.material->GetUsageFlags() );
+			for ( auto it = group.material->GetScalarParameters().begin(), itEnd = group.material->GetScalarParameters().end(); it != itEnd; ++it )
+			{
+				materialRef->SetScalarParameterValue( it->first, it->second );
+			}
+			for ( auto it = group.material->GetVectorParameters().begin(), itEnd = group.material->GetVectorParameters().end(); it != itEnd; ++it )
+			{
+				materialRef->SetVectorParameterValue( it->first, it->second );
+			}
+			for ( auto it = group.material->GetTextureParameters().begin(), itEnd = group.material->GetTextureParameters().end(); it != itEnd; ++it )
+			{
+				materialRef->SetTextureParameterValue( it->first, it->first == CMaterial::diffuseTextureParamName ? atlasTexture : it->second );
+			}
+
+			TAssetHandle<CMaterial>		atlasMaterial = TAssetHandle<CMaterial>( materialRef, MakeSharedPtr<SAssetReference>( AT_Material, materialRef->GetGUID() ) );
+			if ( !SaveToPackage( atlasInfo, atlasMaterial ) )
+			{
+				return false;
+			}
+
+			// Replace material and texture rects of tilesets
+			for ( uint32 index = 0, count = group.tilesets.size(); index < count; ++index )
+			{
+				STMXTileset&		tileset = InOutTilesets[ group.tilesets[ index ] ];
+				tileset.material	= atlasMaterial;
+				for ( uint32 indexRect = 0, countRects = tileset.textureRects.size(); indexRect < countRects; ++indexRect )
+				{
+					tileset.textureRects[ indexRect ] = atlasBuilder.TransformRect( index, tileset.textureRects[ indexRect ] );
+				}
+			}
+
+			LE_LOG( LT_Log, LC_Commandlet, TEXT( "Atlas '%s': %i tilesets, %ix%i, occupancy %.1f%%" ), texture2DRef->GetAssetName().c_str(), group.tilesets.size(), atlasBuilder.GetSizeX(), atlasBuilder.GetSizeY(), atlasBuilder.GetOccupancy() * 100.f );
+			++numAtlases;
+		}
+		else if ( group.tilesets.size() > 1 )
+		{
+			LE_LOG( LT_Warning, LC_Commandlet, TEXT( "%i tilesets with material '%s' not packed, they don't fit into atlas %ix%i" ), group.tilesets.size(), group.material->GetAssetName().c_str(), TEXTUREATLAS_MAX_SIZE, TEXTUREATLAS_MAX_SIZE );
+		}
+
+		for ( uint32 index = 0, count = group.images.size(); index < count; ++index )
+		{
+			stbi_image_free( group.images[ index ] );
+		}
+	}
+
+	return true;
+}
+
 bool CCookPackagesCommandlet::FindTileset( const std::vector<STMXTileset>& InTilesets, uint32 InIDTile, STMXTileset& OutTileset, RectFloat_t& OutTextureRect ) const
 {
 	for ( uint32 indexTileset = 0, countTilesets = InTilesets.size(); indexTileset < countTilesets; ++indexTileset )
@@ -214,6 +469,31 @@ void CCookPackagesCommandlet::SpawnTilesInWorld( const tmx::Map& InTMXMap, const
 	const std::vector< tmx::Layer::Ptr >&		tmxLayers	= InTMXMap.getLayers();
 	const tmx::Vector2u&						mapSize		= InTMXMap.getTileCount();
 	const tmx::Vector2u&						mapTileSize = InTMXMap.getTileSize();
+
+	// Tilesets packed into one atlas share material in tile map
+	std::vector< TAssetHandle<CMaterial> >		materials;
+	std::vector< uint32 >						tilesetMaterials;
+	for ( uint32 indexTileset = 0, countTilesets = InTilesets.size(); indexTileset < countTilesets; ++indexTileset )
+	{
+		uint32		materialIndex = 0;
+		while ( materialIndex < materials.size() && !( materials[ materialIndex ] == InTilesets[ indexTileset ].material ) )
+		{
+			++materialIndex;
+		}
+
+		if ( materialIndex == materials.size() )
+		{
+			materials.push_back( InTilesets[ indexTileset ].material );
+		}
+		tilesetMaterials.push_back( materialIndex );
+	}
+
+	// Surfaces of chunks for report of draw calls, by tilesets (each tileset has own material without atlases) and by materials
+	typedef std::tuple< uint32, uint32, uint32, uint32 >		ChunkSurfaceKey_t;
+	std::set< ChunkSurfaceKey_t >								tilesetSurfaces;
+	std::set< ChunkSurfaceKey_t >								materialSurfaces;
+
+	std::vector< STileMapTile >		tiles;
 	for ( uint32 indexLayer = 0, countLayers = tmxLayers.size(); indexLayer < countLayers; ++indexLayer )
 	{
 		if ( tmxLayers[ indexLayer ]->getType() == tmx::Layer::Type::Tile )
@@ -234,14 +514,16 @@ void CCookPackagesCommandlet::SpawnTilesInWorld( const tmx::Map& InTMXMap, const
 					bool			result = FindTileset( InTilesets, tile.ID, tileset, textureRect );
 					checkMsg( result, TEXT( "Not founded tileset for tile with ID %i" ), tile.ID );
 
-					ASprite*			sprite				= GWorld->SpawnActor< ASprite >( Vector( x * mapTileSize.x, y * mapTileSize.y, indexLayer ) );					
-					CSpriteComponent*	spriteComponent		= sprite->GetSpriteComponent();
-					spriteComponent->SetType( ST_Static );
-					spriteComponent->SetMaterial( tileset.material );
-					spriteComponent->SetSpriteSize( Vector2D( tileset.tileSize.x, tileset.tileSize.y ) );
-					spriteComponent->SetTextureRect( textureRect );
-					sprite->SetName( TEXT( "ASprite_Tile" ) );
-					sprite->SetStatic( true );
+					uint32			tilesetIndex = 0;
+					while ( InTilesets[ tilesetIndex ].firstGID != tileset.firstGID )
+					{
+						++tilesetIndex;
+					}
+
+					const uint32	materialIndex = tilesetMaterials[ tilesetIndex ];
+					tiles.push_back( STileMapTile{ ( uint32 )x, ( uint32 )y, indexLayer, materialIndex, Vector2D( tileset.tileSize.x, tileset.tileSize.y ), textureRect } );
+					tilesetSurfaces.insert( ChunkSurfaceKey_t( indexLayer, y / TILEMAP_CHUNK_SIZE, x / TILEMAP_CHUNK_SIZE, tilesetIndex ) );
+					materialSurfaces.insert( ChunkSurfaceKey_t( indexLayer, y / TILEMAP_CHUNK_SIZE, x / TILEMAP_CHUNK_SIZE, materialIndex ) );
 				}
 
 				++x;
@@ -253,6 +535,17 @@ void CCookPackagesCommandlet::SpawnTilesInWorld( const tmx::Map& InTMXMap, const
 			}
 		}
 	}
+
+	// All tiles are placed into one tile map, it splits them into chunks with prebuilt geometry
+	if ( !tiles.empty() )
+	{
+		ATileMap*		tileMap = GWorld->SpawnActor< ATileMap >( Vector( 0.f, 0.f, 0.f ) );
+		tileMap->GetTileMapComponent()->SetTiles( tiles, materials, Vector2D( mapTileSize.x, mapTileSize.y ) );
+		tileMap->SetName( TEXT( "ATileMap_Tiles" ) );
+		tileMap->SetStatic( true );
+		LE_LOG( LT_Log, LC_Commandlet, TEXT( "Spawned tile map with %i tiles in %i chunks" ), tiles.size(), tileMap->GetTileMapComponent()->GetNumChunks() );
+		LE_LOG( LT_Log, LC_Commandlet, TEXT( "Tile map uses %i materials for %i tilesets, draw calls of all chunks %i -> %i" ), materials.size(), InTilesets.size(), tilesetSurfaces.size(), materialSurfaces.size() );
+	}
 }
 
 void CCookPackagesCommandlet::SpawnActorsInWorld( const tmx::Map& InTMXMap, const std::vector<STMXTileset>& InTileset )
@@ -442,6 +735,10 @@ bool CCookPackagesCommandlet::CookMaterial( const SResourceInfo& InMaterialInfo,
 	bool				bIsTwoSided				= lmtMaterial.GetValue( TEXT( "Material" ), TEXT( "IsTwoSided" ) ).GetBool();
 	bool				bIsWireframe			= lmtMaterial.GetValue( TEXT( "Material" ), TEXT( "IsWireframe" ) ).GetBool();
 
+	// Material without IsMasked is masked, because base pass discards pixels by alpha of diffuse texture
+	CConfigValue		configVarIsMasked		= lmtMaterial.GetValue( TEXT( "Material" ), TEXT( "IsMasked" ) );
+	bool				bIsMasked				= !configVarIsMasked.IsValid() || configVarIsMasked.GetBool();
+
 	// Getting usage flags
 	uint32						usageFlags = MU_AllMeshes;
 	std::vector< uint64 >		usedVertexFectories;
@@ -462,6 +759,7 @@ bool CCookPackagesCommandlet::CookMaterial( const SResourceInfo& InMaterialInfo,
 			{
 				usageFlags |= MU_StaticMesh;
 				usedVertexFectories.push_back( CStaticMeshVertexFactory::staticType.GetHash() );
+				usedVertexFectories.push_back( CStaticMeshPackedVertexFactory::staticType.GetHash() );
 			}
 
 			if ( bSprite )
@@ -588,6 +886,7 @@ bool CCookPackagesCommandlet::CookMaterial( const SResourceInfo& InMaterialInfo,
 	materialRef->SetAssetName( InMaterialInfo.filename );
 	materialRef->SetTwoSided( bIsTwoSided );
 	materialRef->SetWireframe( bIsWireframe );
+	materialRef->SetMasked( bIsMasked );
 	materialRef->SetUsageFlags( usageFlags );
 
 	// Set scalar parameters
@@ -650,11 +949,13 @@ TSharedPtr<CTexture2D> CCookPackagesCommandlet::ConvertTexture2D( const std::wst
 	TSharedPtr<CTexture2D>		texture2DRef = MakeSharedPtr<CTexture2D>();
 	texture2DRef->SetAssetName( filename );
 	texture2DRef->SetAssetSourceFile( InPath );
+	texture2DRef->SetCompression( textureCompression );
 	{
+		std::vector< byte >		mipChain;
 		std::vector< byte >		tempData;
-		tempData.resize( sizeX * sizeY * GPixelFormats[ PF_A8R8G8B8 ].blockBytes );
-		memcpy( tempData.data(), data, tempData.size() );
-		texture2DRef->SetData( PF_A8R8G8B8, sizeX, sizeY, tempData );
+		uint32					numMips		= GenerateMipChain( PF_A8R8G8B8, sizeX, sizeY, ( byte* )data, mipChain );
+		EPixelFormat			pixelFormat = CompressTexture( texture2DRef->GetCompression(), sizeX, sizeY, numMips, mipChain, tempData );
+		texture2DRef->SetData( pixelFormat, sizeX, sizeY, tempData, numMips );
 	}
 
 	// Clean up all data
@@ -1059,6 +1360,42 @@ bool CCookPackagesCommandlet::Main( const CCommandLine& InCommandLine )
 		}
 	}
 
+	// Getting compression of cooked textures
+	{
+		static const tchar*		textureCompressionNames[] = { TEXT( "None" ), TEXT( "Default" ), TEXT( "BC1" ), TEXT( "BC3" ), TEXT( "BC5" ), TEXT( "BC7" ) };
+		static_assert( ARRAY_COUNT( textureCompressionNames ) == TC_Max, "Need full init textureCompressionNames array" );
+
+		std::wstring			compression = GConfig.GetValue( CT_Editor, TEXT( "Editor.CookPackages" ), TEXT( "TextureCompression" ) ).GetString();
+		for ( uint32 index = 0; index < TC_Max; ++index )
+		{
+			if ( compression == textureCompressionNames[ index ] )
+			{
+				textureCompression = ( ETextureCompression )index;
+				break;
+			}
+		}
+	}
+
+	// Getting settings of tileset atlases
+	{
+		CConfigValue		configAtlasTilesets = GConfig.GetValue( CT_Editor, TEXT( "Editor.CookPackages" ), TEXT( "AtlasTilesets" ) );
+		if ( configAtlasTilesets.IsValid() )
+		{
+			bAtlasTilesets = configAtlasTilesets.GetBool();
+		}
+
+		CConfigValue		configAtlasPadding = GConfig.GetValue( CT_Editor, TEXT( "Editor.CookPackages" ), TEXT( "AtlasPadding" ) );
+		if ( configAtlasPadding.IsValid() )
+		{
+			atlasPadding = configAtlasPadding.GetNumber();
+		}
+
+		if ( InCommandLine.HasParam( TEXT( "noatlas" ) ) )
+		{
+			bAtlasTilesets = false;
+		}
+	}
+
 	// Clear table of content and if cooked dir already created remove it
 	GTableOfContents.Clear();
 	if ( GFileSystem->IsExistFile( GCookedDir, true ) )
@@ -13,6 +13,7 @@
 #include "System/BaseEngine.h"
 #include "Containers/StringConv.h"
 #include "Render/StaticMesh.h"
+#include "System/MeshOptimizer.h"
 #include "Commandlets/ImportMeshCommandlet.h"
 
 IMPLEMENT_CLASS( CImportMeshCommandlet )
@@ -187,10 +188,30 @@ TSharedPtr<CStaticMesh> CImportMeshCommandlet::ConvertStaticMesh( const std::wst
 		surfaces.push_back( surface );
 	}
 
+	// Optimize mesh for vertex cache, overdraw and vertex fetch
+	const SVertexCacheStats		statsBefore = AnalyzeVertexCache( indeces.data(), indeces.size(), verteces.size() );
+	OptimizeStaticMesh( verteces, indeces, surfaces );
+	const SVertexCacheStats		statsAfter	= AnalyzeVertexCache( indeces.data(), indeces.size(), verteces.size() );
+	LE_LOG( LT_Log, LC_Commandlet, TEXT( "Optimized mesh: ACMR %.3f -> %.3f, ATVR %.3f -> %.3f" ), statsBefore.acmr, statsAfter.acmr, statsBefore.atvr, statsAfter.atvr );
+
+	// Generate LODs
+	std::vector<SStaticMeshLOD>		lods;
+	GenerateStaticMeshLODs( verteces, indeces, surfaces, lods );
+
 	// Serialize static mesh in archive
 	TSharedPtr<CStaticMesh>		staticMeshRef = MakeSharedPtr<CStaticMesh>();
 	staticMeshRef->SetAssetName( InAssetName );
-	staticMeshRef->SetData( verteces, indeces, surfaces, materials );
+	staticMeshRef->SetData( verteces, indeces, surfaces, materials, lods );
+	for ( uint32 index = 0, count = staticMeshRef->GetNumLODs(); index < count; ++index )
+	{
+		LE_LOG( LT_Log, LC_Commandlet, TEXT( "LOD %i: %i triangles, screen size %.3f" ), index, staticMeshRef->GetNumPrimitives( index ), staticMeshRef->GetLODScreenSize( index ) );
+	}
+
+	// Report precision loss of packed verteces
+	const SStaticMeshVertexPrecision	precision = staticMeshRef->CalcVertexPrecision();
+	LE_LOG( LT_Log, LC_Commandlet, TEXT( "Vertex format %s: %i bytes per vertex (%i in float), max error: position %f, normal %.3f deg, tangent %.3f deg, UV %f" ),
+			StaticMeshVertexFormatToText( staticMeshRef->GetVertexFormat() ), GetStaticMeshVertexStride( staticMeshRef->GetVertexFormat() ), sizeof( SStaticMeshVertexType ),
+			precision.maxPositionError, precision.maxNormalError, precision.maxTangentError, precision.maxTexCoordError );
 
 	// Clean up all data
 	aiImport.FreeScene();
@@ -294,6 +294,28 @@ Vector CEditorLevelViewportClient::WorldToScreen( const Vector& InWorldPoint, ui
 	return result;
 }
 
+ActorRef_t CEditorLevelViewportClient::PickActor( const Vector2D& InScreenPoint, uint32 InViewportSizeX, uint32 InViewportSizeY )
+{
+	Vector			worldOrigin;
+	Vector			worldDirection;
+	CSceneView*		sceneView = CalcSceneView( InViewportSizeX, InViewportSizeY );
+	sceneView->ScreenToWorld( InScreenPoint, worldOrigin, worldDirection );
+	delete sceneView;
+
+	// In ortho viewports the ray starts at plane of camera, move it back for hit actors behind it
+	if ( viewportType != LVT_Perspective )
+	{
+		worldOrigin -= worldDirection * ( float )HALF_WORLD_MAX;
+	}
+
+	SRayCastResult		rayCastResult;
+	if ( !GWorld->GetScene()->RayCast( worldOrigin, worldDirection, rayCastResult ) )
+	{
+		return nullptr;
+	}
+	return rayCastResult.primitive->GetOwner();
+}
+
 void CEditorLevelViewportClient::ProcessEvent( struct SWindowEvent& InWindowEvent )
 {
 	// We ignore events when bIgnoreInput is TRUE or when ImGUI layer is unhovered
@@ -550,7 +572,7 @@ CSceneView* CEditorLevelViewportClient::CalcSceneView( uint32 InSizeX, uint32 In
 
 	viewMatrix = glm::lookAt( viewLocation, viewLocation + targetDirection, axisUp );
 
-	CSceneView*		sceneView = new CSceneView( viewLocation, projectionMatrix, viewMatrix, InSizeX, InSizeY, GetBackgroundColor(), showFlags );
+	CSceneView*		sceneView = new CSceneView( viewLocation, projectionMatrix, viewMatrix, InSizeX, InSizeY, GetBackgroundColor(), showFlags, GetViewKey() );
 	return sceneView;
 }
 
@@ -41,16 +41,16 @@ void CTexturePreviewViewportClient::Draw_RenderThread( ViewportRHIRef_t InViewpo
 	// Draw quad with texture
 	if ( InTexture2D )
 	{
-		SCOPED_DRAW_EVENT( EventDrawPreviewTexture, DEC_SCENE_ITEMS, CString::Format( TEXT( "Preview %s" ), InTexture2D->GetAssetName().c_str() ).c_str() );
+		SCOPED_DRAW_EVENTF( EventDrawPreviewTexture, DEC_SCENE_ITEMS, TEXT( "Preview %s" ), InTexture2D->GetAssetName().c_str() );
 
 		Texture2DRHIRef_t							texture2DRHI				= InTexture2D->GetTexture2DRHI();
 		CScreenVertexShader<SVST_Fullscreen>*		screenVertexShader			= GShaderManager->FindInstance< CScreenVertexShader<SVST_Fullscreen>, CSimpleElementVertexFactory >();
 		CTexturePreviewPixelShader*					texturePreviewPixelShader	= GShaderManager->FindInstance< CTexturePreviewPixelShader, CSimpleElementVertexFactory >();
 		check( screenVertexShader && texturePreviewPixelShader );
 
-		GRHI->SetDepthState( immediateContext, TStaticDepthStateRHI<false>::GetRHI() );
-		GRHI->SetRasterizerState( immediateContext, TStaticRasterizerStateRHI<>::GetRHI() );
-		GRHI->SetBoundShaderState( immediateContext, GRHI->CreateBoundShaderState( TEXT( "PreviewTexture" ), GSimpleElementVertexDeclaration.GetVertexDeclarationRHI(), screenVertexShader->GetVertexShader(), texturePreviewPixelShader->GetPixelShader() ) );
+		immediateContext->SetDepthState( TStaticDepthStateRHI<false>::GetRHI() );
+		immediateContext->SetRasterizerState( TStaticRasterizerStateRHI<>::GetRHI() );
+		immediateContext->SetBoundShaderState( GRHI->CreateBoundShaderState( TEXT( "PreviewTexture" ), GSimpleElementVertexDeclaration.GetVertexDeclarationRHI(), screenVertexShader->GetVertexShader(), texturePreviewPixelShader->GetPixelShader() ) );
 
 		texturePreviewPixelShader->SetTexture( immediateContext, texture2DRHI );
 		texturePreviewPixelShader->SetSamplerState( immediateContext, GRHI->CreateSamplerState( InTexture2D->GetSamplerStateInitialiser() ) );
@@ -10,9 +10,13 @@
 #include "System/AssetsImport.h"
 #include "System/BaseFileSystem.h"
 #include "Render/RenderUtils.h"
+#include "Render/TextureMips.h"
+#include "System/TextureCompressor.h"
+#include "System/MeshOptimizer.h"
 #include "WorldEd.h"
 
 CStaticMeshImportSettingsDialog::SImportSettings		CStaticMeshImporter::importSettings;
+CTexture2DImportSettingsDialog::SImportSettings			CTexture2DImporter::importSettings;
 
 bool CTexture2DImporter::Import( const std::wstring& InPath, std::vector<TSharedPtr<CAsset>>& OutResult, std::wstring& OutError )
 {
@@ -36,6 +40,7 @@ bool CTexture2DImporter::Import( const std::wstring& InPath, std::vector<TShared
 	TSharedPtr<CTexture2D>		texture2DRef = MakeSharedPtr<CTexture2D>();
 	texture2DRef->SetAssetName( filename );
 	texture2DRef->SetAssetSourceFile( InPath );
+	texture2DRef->SetCompression( importSettings.compression );
 	
 	if ( Reimport( texture2DRef, OutError ) )
 	{
@@ -69,11 +74,12 @@ bool CTexture2DImporter::Reimport( const TSharedPtr<CAsset>& InTexture2D, std::w
 		return false;
 	}
 
-	// Set new data in texture
+	// Set new data with full mip chain in texture, it is compressed by settings of the texture
+	std::vector<byte>		mipChain;
 	std::vector<byte>		tempData;
-	tempData.resize( sizeX * sizeY * GPixelFormats[PF_A8R8G8B8].blockBytes );
-	memcpy( tempData.data(), data, tempData.size() );
-	texture2D->SetData( PF_A8R8G8B8, sizeX, sizeY, tempData );
+	uint32					numMips		= GenerateMipChain( PF_A8R8G8B8, sizeX, sizeY, ( byte* )data, mipChain );
+	EPixelFormat			pixelFormat = CompressTexture( texture2D->GetCompression(), sizeX, sizeY, numMips, mipChain, tempData );
+	texture2D->SetData( pixelFormat, sizeX, sizeY, tempData, numMips );
 
 	// Clean up all data
 	stbi_image_free( data );
@@ -85,6 +91,23 @@ bool CTexture2DImporter::Reimport( const TSharedPtr<CAsset>& InTexture2D, std::w
 	return true;
 }
 
+void CTexture2DImporter::ShowImportSettings( class CImGUILayer* InOwner, class CEvent* InEvent, CAssetFactory::EResultShowImportSettings& OutResult )
+{
+	check( InOwner && InEvent );
+	TSharedPtr<CTexture2DImportSettingsDialog>			popup = InOwner->OpenPopup<CTexture2DImportSettingsDialog>();
+	popup->OnResume().Add( [&]( CAssetFactory::EResultShowImportSettings InResult, const CTexture2DImportSettingsDialog::SImportSettings& InImportSettings )
+						   {
+							   if ( InResult != CAssetFactory::RSIS_Cancel )
+							   {
+								   importSettings = InImportSettings;
+							   }
+
+							   OutResult = InResult;
+							   InEvent->Trigger();
+						   } );
+	InEvent->Wait();
+}
+
 //
 // AUDIO BANK
 //
@@ -195,10 +218,14 @@ bool CStaticMeshImporter::Import( const std::wstring& InPath, std::vector<TShare
 			surfaces.push_back( surface );
 		}
 
+		std::vector<SStaticMeshLOD>		lods;
+		OptimizeStaticMesh( verteces, indeces, surfaces );
+		GenerateStaticMeshLODs( verteces, indeces, surfaces, lods );
+
 		TSharedPtr<CStaticMesh>		staticMesh = MakeSharedPtr<CStaticMesh>();
 		staticMesh->SetAssetName( CFilename( InPath ).GetBaseFilename() );
 		staticMesh->SetAssetSourceFile( InPath );
-		staticMesh->SetData( verteces, indeces, surfaces, materials );
+		staticMesh->SetData( verteces, indeces, surfaces, materials, lods );
 		OutResult.push_back( staticMesh );
 	}
 	// Otherwise import separated meshes
@@ -206,16 +233,19 @@ bool CStaticMeshImporter::Import( const std::wstring& InPath, std::vector<TShare
 	{
 		for ( uint32 index = 0, count = meshes.size(); index < count; ++index )
 		{
-			const SMeshData&			meshData	= meshes[index];
+			SMeshData&					meshData	= meshes[index];
 			TSharedPtr<CStaticMesh>		staticMesh	= MakeSharedPtr<CStaticMesh>();
 			staticMesh->SetAssetName( meshData.name );
 			staticMesh->SetAssetSourceFile( InPath + TEXT( "?" ) + meshData.name );
 
 			std::vector<SStaticMeshSurface>			surfaces;
 			std::vector<TAssetHandle<CMaterial>>	materials;
+			std::vector<SStaticMeshLOD>				lods;
 			surfaces.push_back( meshData.surface );
 			materials.push_back( meshData.material );
-			staticMesh->SetData( meshData.verteces, meshData.indeces, surfaces, materials );
+			OptimizeStaticMesh( meshData.verteces, meshData.indeces, surfaces );
+			GenerateStaticMeshLODs( meshData.verteces, meshData.indeces, surfaces, lods );
+			staticMesh->SetData( meshData.verteces, meshData.indeces, surfaces, materials, lods );
 			OutResult.push_back( staticMesh );
 		}
 	}
@@ -254,12 +284,15 @@ bool CStaticMeshImporter::Reimport( const TSharedPtr<CAsset>& InStaticMesh, std:
 
 	check( meshes.size() == 1 );		// We support reimport only one mesh
 	
-	const SMeshData&						meshData = meshes[0];
+	SMeshData&								meshData = meshes[0];
 	std::vector<SStaticMeshSurface>			surfaces;
 	std::vector<TAssetHandle<CMaterial>>	materials;
+	std::vector<SStaticMeshLOD>				lods;
 	surfaces.push_back( meshData.surface );
 	materials.push_back( meshData.material );
-	staticMesh->SetData( meshData.verteces, meshData.indeces, surfaces, materials );
+	OptimizeStaticMesh( meshData.verteces, meshData.indeces, surfaces );
+	GenerateStaticMeshLODs( meshData.verteces, meshData.indeces, surfaces, lods );
+	staticMesh->SetData( meshData.verteces, meshData.indeces, surfaces, materials, lods );
 
 	// Broadcast event of reimport/reloaded asset
 	std::vector< TSharedPtr<CAsset> >		reimportedAssets{ staticMesh };
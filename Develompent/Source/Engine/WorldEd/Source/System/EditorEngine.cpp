@@ -60,7 +60,7 @@ void CEditorEngine::Init()
 	GActorFactory.Register( AT_AudioBank,	&AAudio::SpawnActorAsset );
 
 	// Register importers of assets
-	GAssetFactory.RegisterImporter( &CTexture2DImporter::Import, &CTexture2DImporter::Reimport, nullptr, CTexture2DImporter::GetSupportedExtensions(), AT_Texture2D );
+	GAssetFactory.RegisterImporter( &CTexture2DImporter::Import, &CTexture2DImporter::Reimport, &CTexture2DImporter::ShowImportSettings, CTexture2DImporter::GetSupportedExtensions(), AT_Texture2D );
 	GAssetFactory.RegisterImporter( &CAudioBankImporter::Import, &CAudioBankImporter::Reimport, nullptr, CAudioBankImporter::GetSupportedExtensions(), AT_AudioBank );
 	GAssetFactory.RegisterImporter( &CStaticMeshImporter::Import, &CStaticMeshImporter::Reimport, &CStaticMeshImporter::ShowImportSettings, CStaticMeshImporter::GetSupportedExtensions(), AT_StaticMesh );
 
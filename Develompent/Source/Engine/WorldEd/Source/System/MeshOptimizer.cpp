@@ -0,0 +1,808 @@
+#include <math.h>
+#include <algorithm>
+#include <unordered_map>
+
+#include "Core.h"
+#include "Math/Math.h"
+#include "Misc/Template.h"
+#include "System/MeshOptimizer.h"
+
+//
+// Definitions
+//
+
+/* Size of LRU cache modeled by vertex cache optimizer */
+#define FORSYTH_CACHE_SIZE				32
+
+/* Max number of live triangles of vertex which has own score, vertices with more triangles get the same score */
+#define FORSYTH_MAX_VALENCE				32
+
+/* Min number of triangles in cluster of overdraw optimizer */
+#define OVERDRAW_MIN_CLUSTER_SIZE		32
+
+/* Max number of passes of mesh simplifier, each pass collapses only independent edges */
+#define SIMPLIFY_MAX_PASSES				64
+
+/* Min cosine of angle between normals of triangle before and after edge collapse */
+#define SIMPLIFY_MIN_NORMAL_COS			0.25f
+
+/* Min ratio of triangles which LOD must remove from previous one, else generation of LODs is stopped */
+#define LOD_MIN_REDUCTION				0.1f
+
+/**
+ * Tables of vertex scores for vertex cache optimizer
+ */
+struct SForsythScoreTables
+{
+	/**
+	 * Constructor
+	 */
+	SForsythScoreTables()
+	{
+		// The last three used vertices have fixed score, so it doesn't matter in which order triangle were added
+		for ( uint32 index = 0; index < FORSYTH_CACHE_SIZE; ++index )
+		{
+			cacheScore[ index ] = index < 3 ? 0.75f : powf( 1.f - ( index - 3 ) / ( float )( FORSYTH_CACHE_SIZE - 3 ), 1.5f );
+		}
+
+		// Boost vertices with few triangles left, so lone triangles aren't left behind
+		valenceScore[ 0 ] = 0.f;
+		for ( uint32 index = 1; index <= FORSYTH_MAX_VALENCE; ++index )
+		{
+			valenceScore[ index ] = 2.f / sqrtf( ( float )index );
+		}
+	}
+
+	/**
+	 * Get tables
+	 * @return Return tables, they are initialized on first call
+	 */
+	static const SForsythScoreTables& Get()
+	{
+		static const SForsythScoreTables		tables;
+		return tables;
+	}
+
+	/**
+	 * Calculate score of vertex
+	 *
+	 * @param InCachePosition		Position in cache, if vertex isn't in cache must be INVALID_ID
+	 * @param InNumLiveTriangles	Number of not emitted triangles of vertex
+	 * @return Return score of vertex
+	 */
+	FORCEINLINE float GetScore( uint32 InCachePosition, uint32 InNumLiveTriangles ) const
+	{
+		if ( InNumLiveTriangles == 0 )
+		{
+			return -1.f;
+		}
+
+		return ( InCachePosition < FORSYTH_CACHE_SIZE ? cacheScore[ InCachePosition ] : 0.f ) + valenceScore[ Min<uint32>( InNumLiveTriangles, FORSYTH_MAX_VALENCE ) ];
+	}
+
+	float		cacheScore[ FORSYTH_CACHE_SIZE ];			/**< Score by position in cache */
+	float		valenceScore[ FORSYTH_MAX_VALENCE + 1 ];	/**< Score by number of live triangles */
+};
+
+/**
+ * Cluster of triangles for overdraw optimizer
+ */
+struct SOverdrawCluster
+{
+	uint32		firstTriangle;		/**< First triangle */
+	uint32		numTriangles;		/**< Number of triangles */
+	float		sortKey;			/**< Distance from center of mesh along normal of cluster */
+};
+
+/**
+ * Quadric of squared distances to planes, it is symmetric 4x4 matrix
+ */
+struct SQuadric
+{
+	/**
+	 * Constructor
+	 */
+	SQuadric()
+	{
+		memset( m, 0, sizeof( m ) );
+	}
+
+	/**
+	 * Add plane to quadric
+	 *
+	 * @param InNormal		Normal of plane
+	 * @param InDistance	Distance of plane
+	 * @param InWeight		Weight of plane
+	 */
+	FORCEINLINE void AddPlane( const Vector& InNormal, float InDistance, float InWeight )
+	{
+		const double		a = InNormal.x, b = InNormal.y, c = InNormal.z, d = InDistance;
+		m[ 0 ] += InWeight * a * a;		m[ 1 ] += InWeight * a * b;		m[ 2 ] += InWeight * a * c;		m[ 3 ] += InWeight * a * d;
+		m[ 4 ] += InWeight * b * b;		m[ 5 ] += InWeight * b * c;		m[ 6 ] += InWeight * b * d;
+		m[ 7 ] += InWeight * c * c;		m[ 8 ] += InWeight * c * d;
+		m[ 9 ] += InWeight * d * d;
+	}
+
+	/**
+	 * Add other quadric
+	 */
+	FORCEINLINE void operator+=( const SQuadric& InOther )
+	{
+		for ( uint32 index = 0; index < ARRAY_COUNT( m ); ++index )
+		{
+			m[ index ] += InOther.m[ index ];
+		}
+	}
+
+	/**
+	 * Calculate error in point
+	 *
+	 * @param InPoint	Point
+	 * @return Return sum of weighted squared distances from point to planes
+	 */
+	FORCEINLINE double Evaluate( const Vector& InPoint ) const
+	{
+		const double		x = InPoint.x, y = InPoint.y, z = InPoint.z;
+		return m[ 0 ] * x * x + 2.0 * m[ 1 ] * x * y + 2.0 * m[ 2 ] * x * z + 2.0 * m[ 3 ] * x
+			 + m[ 4 ] * y * y + 2.0 * m[ 5 ] * y * z + 2.0 * m[ 6 ] * y
+			 + m[ 7 ] * z * z + 2.0 * m[ 8 ] * z
+			 + m[ 9 ];
+	}
+
+	double		m[ 10 ];		/**< Upper triangle of matrix */
+};
+
+/**
+ * Candidate of edge collapse for mesh simplifier
+ */
+struct SEdgeCollapse
+{
+	uint32		from;		/**< Removed vertex */
+	uint32		to;			/**< Vertex which replaces removed one */
+	double		cost;		/**< Error of collapse */
+};
+
+/**
+ * Is collapse of edge flips any triangle around removed vertex
+ *
+ * @param InVerteces			Vertices
+ * @param InIndeces				Indices of triangle list
+ * @param InAdjacency			Triangles of each vertex
+ * @param InAdjacencyOffsets	Offsets of triangles of each vertex in InAdjacency
+ * @param InFrom				Removed vertex
+ * @param InTo					Vertex which replaces removed one
+ * @return Return TRUE if any triangle which remains after collapse is flipped or became degenerate
+ */
+static bool IsCollapseFlipping( const SStaticMeshVertexType* InVerteces, const uint32* InIndeces, const std::vector< uint32 >& InAdjacency, const std::vector< uint32 >& InAdjacencyOffsets, uint32 InFrom, uint32 InTo )
+{
+	const Vector		newPosition = Vector( InVerteces[ InTo ].position );
+	for ( uint32 index = InAdjacencyOffsets[ InFrom ], end = InAdjacencyOffsets[ InFrom + 1 ]; index < end; ++index )
+	{
+		// Triangles of the edge are removed by collapse
+		const uint32*		triangle = InIndeces + InAdjacency[ index ] * 3;
+		if ( triangle[ 0 ] == InTo || triangle[ 1 ] == InTo || triangle[ 2 ] == InTo )
+		{
+			continue;
+		}
+
+		Vector		oldPositions[ 3 ];
+		Vector		newPositions[ 3 ];
+		for ( uint32 corner = 0; corner < 3; ++corner )
+		{
+			oldPositions[ corner ] = Vector( InVerteces[ triangle[ corner ] ].position );
+			newPositions[ corner ] = triangle[ corner ] == InFrom ? newPosition : oldPositions[ corner ];
+		}
+
+		// Degenerate triangle hasn't orientation, so it can't be flipped. Large rotation is rejected too, else
+		// a few collapses in a row can flip triangle step by step
+		const Vector		oldNormal	= SMath::CrossVector( oldPositions[ 1 ] - oldPositions[ 0 ], oldPositions[ 2 ] - oldPositions[ 0 ] );
+		const Vector		newNormal	= SMath::CrossVector( newPositions[ 1 ] - newPositions[ 0 ], newPositions[ 2 ] - newPositions[ 0 ] );
+		const float			oldLength	= SMath::LengthVector( oldNormal );
+		if ( oldLength > 0.f && SMath::DotVector( oldNormal, newNormal ) <= SIMPLIFY_MIN_NORMAL_COS * oldLength * SMath::LengthVector( newNormal ) )
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+SVertexCacheStats AnalyzeVertexCache( const uint32* InIndeces, uint32 InNumIndeces, uint32 InNumVerteces, uint32 InCacheSize /* = MESHOPTIMIZER_CACHE_SIZE */ )
+{
+	SVertexCacheStats		stats;
+	appMemzero( &stats, sizeof( SVertexCacheStats ) );
+	if ( InNumIndeces < 3 || InNumVerteces == 0 )
+	{
+		return stats;
+	}
+
+	// Vertex is in FIFO cache if it was added less than InCacheSize misses ago
+	std::vector< uint32 >		cacheTimestamps( InNumVerteces, 0 );
+	std::vector< bool >			usedVerteces( InNumVerteces, false );
+	uint32						timestamp		= InCacheSize + 1;
+	uint32						numUsedVerteces	= 0;
+	for ( uint32 index = 0; index < InNumIndeces; ++index )
+	{
+		const uint32		vertexIndex = InIndeces[ index ];
+		check( vertexIndex < InNumVerteces );
+		if ( timestamp - cacheTimestamps[ vertexIndex ] > InCacheSize )
+		{
+			cacheTimestamps[ vertexIndex ] = timestamp++;
+			++stats.numTransformed;
+		}
+
+		if ( !usedVerteces[ vertexIndex ] )
+		{
+			usedVerteces[ vertexIndex ] = true;
+			++numUsedVerteces;
+		}
+	}
+
+	stats.acmr = stats.numTransformed / ( float )( InNumIndeces / 3 );
+	stats.atvr = stats.numTransformed / ( float )numUsedVerteces;
+	return stats;
+}
+
+void OptimizeVertexCache( uint32* InOutIndeces, uint32 InNumIndeces, uint32 InNumVerteces )
+{
+	check( InNumIndeces % 3 == 0 );
+	const uint32		numTriangles = InNumIndeces / 3;
+	if ( numTriangles < 2 )
+	{
+		return;
+	}
+
+	// Build lists of triangles used by each vertex
+	std::vector< uint32 >		numLiveTriangles( InNumVerteces, 0 );
+	std::vector< uint32 >		adjacencyOffsets( InNumVerteces + 1, 0 );
+	std::vector< uint32 >		adjacency( InNumIndeces );
+	for ( uint32 index = 0; index < InNumIndeces; ++index )
+	{
+		check( InOutIndeces[ index ] < InNumVerteces );
+		++numLiveTriangles[ InOutIndeces[ index ] ];
+	}
+
+	for ( uint32 index = 0; index < InNumVerteces; ++index )
+	{
+		adjacencyOffsets[ index + 1 ] = adjacencyOffsets[ index ] + numLiveTriangles[ index ];
+	}
+
+	{
+		std::vector< uint32 >		cursors( adjacencyOffsets.begin(), adjacencyOffsets.end() - 1 );
+		for ( uint32 index = 0; index < InNumIndeces; ++index )
+		{
+			adjacency[ cursors[ InOutIndeces[ index ] ]++ ] = index / 3;
+		}
+	}
+
+	// Initial scores
+	const SForsythScoreTables&		tables = SForsythScoreTables::Get();
+	std::vector< uint32 >			cachePositions( InNumVerteces, INVALID_ID );
+	std::vector< float >			vertexScores( InNumVerteces );
+	std::vector< float >			triangleScores( numTriangles );
+	std::vector< bool >				emittedTriangles( numTriangles, false );
+	for ( uint32 index = 0; index < InNumVerteces; ++index )
+	{
+		vertexScores[ index ] = tables.GetScore( INVALID_ID, numLiveTriangles[ index ] );
+	}
+
+	uint32		bestTriangle	= 0;
+	float		bestScore		= -1.f;
+	for ( uint32 index = 0; index < numTriangles; ++index )
+	{
+		const uint32*	triangle = InOutIndeces + index * 3;
+		triangleScores[ index ] = vertexScores[ triangle[ 0 ] ] + vertexScores[ triangle[ 1 ] ] + vertexScores[ triangle[ 2 ] ];
+		if ( triangleScores[ index ] > bestScore )
+		{
+			bestScore		= triangleScores[ index ];
+			bestTriangle	= index;
+		}
+	}
+
+	// Emit triangles greedily by best score, only triangles of vertices in cache are candidates
+	std::vector< uint32 >		outIndeces( InNumIndeces );
+	uint32						cache[ FORSYTH_CACHE_SIZE + 3 ];
+	uint32						newCache[ FORSYTH_CACHE_SIZE + 3 ];
+	uint32						cacheCount	= 0;
+	uint32						inputCursor = 0;
+	for ( uint32 outTriangle = 0; outTriangle < numTriangles; ++outTriangle )
+	{
+		// Cache doesn't have candidates, take the next not emitted triangle
+		if ( bestTriangle == INVALID_ID )
+		{
+			while ( emittedTriangles[ inputCursor ] )
+			{
+				++inputCursor;
+			}
+			bestTriangle = inputCursor;
+		}
+
+		const uint32*		triangle = InOutIndeces + bestTriangle * 3;
+		memcpy( &outIndeces[ outTriangle * 3 ], triangle, sizeof( uint32 ) * 3 );
+		emittedTriangles[ bestTriangle ] = true;
+
+		// Remove the triangle from lists of live triangles
+		for ( uint32 corner = 0; corner < 3; ++corner )
+		{
+			const uint32		vertexIndex			= triangle[ corner ];
+			uint32*				triangles			= &adjacency[ adjacencyOffsets[ vertexIndex ] ];
+			uint32&				numVertexTriangles	= numLiveTriangles[ vertexIndex ];
+			for ( uint32 index = 0; index < numVertexTriangles; ++index )
+			{
+				if ( triangles[ index ] == bestTriangle )
+				{
+					Swap( triangles[ index ], triangles[ numVertexTriangles - 1 ] );
+					--numVertexTriangles;
+					break;
+				}
+			}
+		}
+
+		// Vertices of the triangle move to head of LRU cache
+		uint32		newCacheCount = 0;
+		newCache[ newCacheCount++ ] = triangle[ 0 ];
+		newCache[ newCacheCount++ ] = triangle[ 1 ];
+		newCache[ newCacheCount++ ] = triangle[ 2 ];
+		for ( uint32 index = 0; index < cacheCount; ++index )
+		{
+			const uint32		vertexIndex = cache[ index ];
+			if ( vertexIndex != triangle[ 0 ] && vertexIndex != triangle[ 1 ] && vertexIndex != triangle[ 2 ] )
+			{
+				newCache[ newCacheCount++ ] = vertexIndex;
+			}
+		}
+
+		// Update scores of vertices in cache and pushed out of it, but only triangles in cache are candidates
+		for ( uint32 index = 0; index < newCacheCount; ++index )
+		{
+			const uint32		vertexIndex = newCache[ index ];
+			cachePositions[ vertexIndex ]	= index < FORSYTH_CACHE_SIZE ? index : INVALID_ID;
+			vertexScores[ vertexIndex ]		= tables.GetScore( cachePositions[ vertexIndex ], numLiveTriangles[ vertexIndex ] );
+		}
+
+		bestTriangle	= INVALID_ID;
+		bestScore		= -1.f;
+		for ( uint32 index = 0; index < newCacheCount; ++index )
+		{
+			const uint32		vertexIndex = newCache[ index ];
+			const uint32*		triangles	= &adjacency[ adjacencyOffsets[ vertexIndex ] ];
+			for ( uint32 indexTriangle = 0, count = numLiveTriangles[ vertexIndex ]; indexTriangle < count; ++indexTriangle )
+			{
+				const uint32		triangleIndex	= triangles[ indexTriangle ];
+				const uint32*		liveTriangle	= InOutIndeces + triangleIndex * 3;
+				triangleScores[ triangleIndex ]		= vertexScores[ liveTriangle[ 0 ] ] + vertexScores[ liveTriangle[ 1 ] ] + vertexScores[ liveTriangle[ 2 ] ];
+				if ( index < FORSYTH_CACHE_SIZE && triangleScores[ triangleIndex ] > bestScore )
+				{
+					bestScore		= triangleScores[ triangleIndex ];
+					bestTriangle	= triangleIndex;
+				}
+			}
+		}
+
+		cacheCount = Min<uint32>( newCacheCount, FORSYTH_CACHE_SIZE );
+		memcpy( cache, newCache, sizeof( uint32 ) * cacheCount );
+	}
+
+	memcpy( InOutIndeces, outIndeces.data(), sizeof( uint32 ) * InNumIndeces );
+}
+
+void OptimizeOverdraw( const SStaticMeshVertexType* InVerteces, uint32* InOutIndeces, uint32 InNumIndeces, uint32 InNumVerteces, float InThreshold /* = MESHOPTIMIZER_OVERDRAW_THRESHOLD */ )
+{
+	check( InVerteces && InNumIndeces % 3 == 0 );
+	const uint32		numTriangles = InNumIndeces / 3;
+	if ( numTriangles < OVERDRAW_MIN_CLUSTER_SIZE * 2 )
+	{
+		return;
+	}
+
+	// Split triangles into clusters. Hard boundary is where all vertices of triangle miss the cache, so order of clusters
+	// doesn't change ACMR. Soft boundary is where at least two vertices miss and the cluster has good enough ACMR
+	const SVertexCacheStats				statsBefore		= AnalyzeVertexCache( InOutIndeces, InNumIndeces, InNumVerteces );
+	const float							maxClusterACMR	= statsBefore.acmr * InThreshold;
+	std::vector< SOverdrawCluster >		clusters;
+	std::vector< uint32 >				cacheTimestamps( InNumVerteces, 0 );
+	uint32								timestamp			= MESHOPTIMIZER_CACHE_SIZE + 1;
+	uint32								clusterMisses		= 0;
+	for ( uint32 index = 0; index < numTriangles; ++index )
+	{
+		uint32		numMisses = 0;
+		for ( uint32 corner = 0; corner < 3; ++corner )
+		{
+			const uint32		vertexIndex = InOutIndeces[ index * 3 + corner ];
+			if ( timestamp - cacheTimestamps[ vertexIndex ] > MESHOPTIMIZER_CACHE_SIZE )
+			{
+				cacheTimestamps[ vertexIndex ] = timestamp++;
+				++numMisses;
+			}
+		}
+
+		const uint32		clusterSize = clusters.empty() ? 0 : index - clusters.back().firstTriangle;
+		const bool			bHardBoundary = numMisses == 3;
+		const bool			bSoftBoundary = numMisses >= 2 && clusterSize >= OVERDRAW_MIN_CLUSTER_SIZE && clusterMisses <= maxClusterACMR * clusterSize;
+		if ( clusters.empty() || ( ( bHardBoundary || bSoftBoundary ) && clusterSize >= OVERDRAW_MIN_CLUSTER_SIZE ) )
+		{
+			SOverdrawCluster		cluster;
+			cluster.firstTriangle	= index;
+			cluster.numTriangles	= 0;
+			cluster.sortKey			= 0.f;
+			clusters.push_back( cluster );
+			clusterMisses = 0;
+		}
+
+		++clusters.back().numTriangles;
+		clusterMisses += numMisses;
+	}
+
+	if ( clusters.size() < 2 )
+	{
+		return;
+	}
+
+	// Calculate area weighted centroid and normal of each cluster
+	std::vector< Vector >		clusterCentroids( clusters.size(), Vector( 0.f, 0.f, 0.f ) );
+	std::vector< Vector >		clusterNormals( clusters.size(), Vector( 0.f, 0.f, 0.f ) );
+	Vector						meshCentroid( 0.f, 0.f, 0.f );
+	float						meshArea = 0.f;
+	for ( uint32 indexCluster = 0, numClusters = clusters.size(); indexCluster < numClusters; ++indexCluster )
+	{
+		const SOverdrawCluster&		cluster		= clusters[ indexCluster ];
+		float						clusterArea = 0.f;
+		for ( uint32 index = cluster.firstTriangle, end = cluster.firstTriangle + cluster.numTriangles; index < end; ++index )
+		{
+			const Vector		p0		= Vector( InVerteces[ InOutIndeces[ index * 3 + 0 ] ].position );
+			const Vector		p1		= Vector( InVerteces[ InOutIndeces[ index * 3 + 1 ] ].position );
+			const Vector		p2		= Vector( InVerteces[ InOutIndeces[ index * 3 + 2 ] ].position );
+			const Vector		normal	= SMath::CrossVector( p1 - p0, p2 - p0 );
+			const float			area	= SMath::LengthVector( normal );
+
+			clusterCentroids[ indexCluster ]	+= ( p0 + p1 + p2 ) * ( area / 3.f );
+			clusterNormals[ indexCluster ]		+= normal;
+			clusterArea							+= area;
+		}
+
+		meshCentroid	+= clusterCentroids[ indexCluster ];
+		meshArea		+= clusterArea;
+		clusterCentroids[ indexCluster ] /= Max( clusterArea, 1e-8f );
+	}
+	meshCentroid /= Max( meshArea, 1e-8f );
+
+	// Clusters which face outward are drawn first, they occlude clusters inside of the mesh
+	for ( uint32 indexCluster = 0, numClusters = clusters.size(); indexCluster < numClusters; ++indexCluster )
+	{
+		const float		normalLength = SMath::LengthVector( clusterNormals[ indexCluster ] );
+		clusters[ indexCluster ].sortKey = normalLength > 1e-8f ? SMath::DotVector( clusterCentroids[ indexCluster ] - meshCentroid, clusterNormals[ indexCluster ] ) / normalLength : 0.f;
+	}
+
+	std::stable_sort( clusters.begin(), clusters.end(), []( const SOverdrawCluster& InA, const SOverdrawCluster& InB )
+					  {
+						  return InA.sortKey > InB.sortKey;
+					  } );
+
+	std::vector< uint32 >		outIndeces;
+	outIndeces.reserve( InNumIndeces );
+	for ( uint32 indexCluster = 0, numClusters = clusters.size(); indexCluster < numClusters; ++indexCluster )
+	{
+		const SOverdrawCluster&		cluster = clusters[ indexCluster ];
+		outIndeces.insert( outIndeces.end(), InOutIndeces + cluster.firstTriangle * 3, InOutIndeces + ( cluster.firstTriangle + cluster.numTriangles ) * 3 );
+	}
+
+	// Don't lose vertex cache efficiency more than threshold
+	const SVertexCacheStats		statsAfter = AnalyzeVertexCache( outIndeces.data(), InNumIndeces, InNumVerteces );
+	if ( statsAfter.acmr <= maxClusterACMR )
+	{
+		memcpy( InOutIndeces, outIndeces.data(), sizeof( uint32 ) * InNumIndeces );
+	}
+}
+
+uint32 OptimizeVertexFetch( std::vector< SStaticMeshVertexType >& InOutVerteces, std::vector< uint32 >& InOutIndeces )
+{
+	std::vector< uint32 >					remap( InOutVerteces.size(), INVALID_ID );
+	std::vector< SStaticMeshVertexType >	verteces;
+	verteces.reserve( InOutVerteces.size() );
+	for ( uint32 index = 0, count = InOutIndeces.size(); index < count; ++index )
+	{
+		uint32&		vertexIndex = InOutIndeces[ index ];
+		check( vertexIndex < InOutVerteces.size() );
+		if ( remap[ vertexIndex ] == INVALID_ID )
+		{
+			remap[ vertexIndex ] = verteces.size();
+			verteces.push_back( InOutVerteces[ vertexIndex ] );
+		}
+		vertexIndex = remap[ vertexIndex ];
+	}
+
+	const uint32		numRemoved = InOutVerteces.size() - verteces.size();
+	InOutVerteces.swap( verteces );
+	return numRemoved;
+}
+
+void OptimizeStaticMesh( std::vector< SStaticMeshVertexType >& InOutVerteces, std::vector< uint32 >& InOutIndeces, std::vector< SStaticMeshSurface >& InOutSurfaces )
+{
+	if ( InOutVerteces.empty() || InOutIndeces.empty() )
+	{
+		return;
+	}
+
+	// Triangles are reordered only inside of own surface
+	for ( uint32 index = 0, count = InOutSurfaces.size(); index < count; ++index )
+	{
+		SStaticMeshSurface&		surface		= InOutSurfaces[ index ];
+		uint32*					indeces		= InOutIndeces.data() + surface.firstIndex;
+		const uint32			numIndeces	= surface.numPrimitives * 3;
+		check( surface.firstIndex + numIndeces <= InOutIndeces.size() );
+
+		// Vertex fetch optimization is made for whole vertex buffer, so indices must be absolute
+		if ( surface.baseVertexIndex != 0 )
+		{
+			for ( uint32 indexVertex = 0; indexVertex < numIndeces; ++indexVertex )
+			{
+				indeces[ indexVertex ] += surface.baseVertexIndex;
+			}
+			surface.baseVertexIndex = 0;
+		}
+
+		OptimizeVertexCache( indeces, numIndeces, InOutVerteces.size() );
+		OptimizeOverdraw( InOutVerteces.data(), indeces, numIndeces, InOutVerteces.size() );
+	}
+
+	OptimizeVertexFetch( InOutVerteces, InOutIndeces );
+}
+void SimplifyMesh( const SStaticMeshVertexType* InVerteces, uint32 InNumVerteces, const uint32* InIndeces, uint32 InNumIndeces, uint32 InTargetNumIndeces, std::vector< uint32 >& OutIndeces )
+{
+	check( InVerteces && InNumIndeces % 3 == 0 );
+	OutIndeces.assign( InIndeces, InIndeces + InNumIndeces );
+	if ( InNumIndeces <= InTargetNumIndeces )
+	{
+		return;
+	}
+
+	// Vertices with the same position share one quadric. Such vertices are on seam of attributes, so they are locked
+	std::vector< uint32 >		positionIDs( InNumVerteces );
+	std::vector< bool >			lockedVerteces( InNumVerteces, false );
+	{
+		auto						lessPosition = [&]( uint32 InA, uint32 InB ) -> bool
+		{
+			const Vector4D&		a = InVerteces[ InA ].position;
+			const Vector4D&		b = InVerteces[ InB ].position;
+			if ( a.x != b.x )
+			{
+				return a.x < b.x;
+			}
+			return a.y != b.y ? a.y < b.y : a.z < b.z;
+		};
+
+		std::vector< uint32 >		sortedVerteces( InNumVerteces );
+		for ( uint32 index = 0; index < InNumVerteces; ++index )
+		{
+			sortedVerteces[ index ] = index;
+		}
+		std::sort( sortedVerteces.begin(), sortedVerteces.end(), lessPosition );
+
+		for ( uint32 first = 0, last = 0; first < InNumVerteces; first = last )
+		{
+			last = first + 1;
+			while ( last < InNumVerteces && !lessPosition( sortedVerteces[ first ], sortedVerteces[ last ] ) )
+			{
+				++last;
+			}
+
+			for ( uint32 index = first; index < last; ++index )
+			{
+				positionIDs[ sortedVerteces[ index ] ]		= sortedVerteces[ first ];
+				lockedVerteces[ sortedVerteces[ index ] ]	= last - first > 1;
+			}
+		}
+	}
+
+	// Edges which are used by one triangle are on open border, their vertices are locked
+	{
+		std::unordered_map< uint64, uint32 >		edgeCounts;
+		for ( uint32 pass = 0; pass < 2; ++pass )
+		{
+			for ( uint32 index = 0; index < InNumIndeces; ++index )
+			{
+				const uint32		v0		= OutIndeces[ index ];
+				const uint32		v1		= OutIndeces[ index - index % 3 + ( index + 1 ) % 3 ];
+				const uint32		p0		= positionIDs[ v0 ];
+				const uint32		p1		= positionIDs[ v1 ];
+				const uint64		edgeKey	= ( ( uint64 )Min( p0, p1 ) << 32 ) | Max( p0, p1 );
+				if ( pass == 0 )
+				{
+					++edgeCounts[ edgeKey ];
+				}
+				else if ( edgeCounts[ edgeKey ] == 1 )
+				{
+					lockedVerteces[ v0 ] = true;
+					lockedVerteces[ v1 ] = true;
+				}
+			}
+		}
+	}
+
+	// Quadric of each vertex is sum of planes of its triangles weighted by area
+	std::vector< SQuadric >		quadrics( InNumVerteces );
+	for ( uint32 index = 0; index < InNumIndeces; index += 3 )
+	{
+		const Vector		p0		= Vector( InVerteces[ OutIndeces[ index + 0 ] ].position );
+		const Vector		p1		= Vector( InVerteces[ OutIndeces[ index + 1 ] ].position );
+		const Vector		p2		= Vector( InVerteces[ OutIndeces[ index + 2 ] ].position );
+		const Vector		normal	= SMath::CrossVector( p1 - p0, p2 - p0 );
+		const float			length	= SMath::LengthVector( normal );
+		if ( length <= 0.f )
+		{
+			continue;
+		}
+
+		const Vector		unitNormal = normal / length;
+		for ( uint32 corner = 0; corner < 3; ++corner )
+		{
+			quadrics[ positionIDs[ OutIndeces[ index + corner ] ] ].AddPlane( unitNormal, -SMath::DotVector( unitNormal, p0 ), length * 0.5f );
+		}
+	}
+
+	// Each pass collapses the cheapest edges, a vertex is changed only by one collapse per pass
+	std::vector< uint32 >			remap( InNumVerteces );
+	std::vector< bool >				touchedVerteces;
+	std::vector< uint32 >			adjacencyOffsets;
+	std::vector< uint32 >			adjacency;
+	std::vector< SEdgeCollapse >	collapses;
+	for ( uint32 pass = 0; pass < SIMPLIFY_MAX_PASSES && OutIndeces.size() > InTargetNumIndeces; ++pass )
+	{
+		const uint32		numIndeces = OutIndeces.size();
+
+		// Build lists of triangles used by each vertex
+		adjacencyOffsets.assign( InNumVerteces + 1, 0 );
+		adjacency.resize( numIndeces );
+		for ( uint32 index = 0; index < numIndeces; ++index )
+		{
+			++adjacencyOffsets[ OutIndeces[ index ] + 1 ];
+		}
+
+		for ( uint32 index = 0; index < InNumVerteces; ++index )
+		{
+			adjacencyOffsets[ index + 1 ] += adjacencyOffsets[ index ];
+		}
+
+		{
+			std::vector< uint32 >		cursors( adjacencyOffsets.begin(), adjacencyOffsets.end() - 1 );
+			for ( uint32 index = 0; index < numIndeces; ++index )
+			{
+				adjacency[ cursors[ OutIndeces[ index ] ]++ ] = index / 3;
+			}
+		}
+
+		// Collect candidates in both directions of each edge, removed vertex must be free
+		collapses.clear();
+		for ( uint32 index = 0; index < numIndeces; ++index )
+		{
+			const uint32		v0 = OutIndeces[ index ];
+			const uint32		v1 = OutIndeces[ index - index % 3 + ( index + 1 ) % 3 ];
+			const double		error0 = quadrics[ positionIDs[ v0 ] ].Evaluate( Vector( InVerteces[ v1 ].position ) );
+			const double		error1 = quadrics[ positionIDs[ v1 ] ].Evaluate( Vector( InVerteces[ v0 ].position ) );
+			if ( !lockedVerteces[ v0 ] )
+			{
+				collapses.push_back( SEdgeCollapse{ v0, v1, error0 + quadrics[ positionIDs[ v1 ] ].Evaluate( Vector( InVerteces[ v1 ].position ) ) } );
+			}
+
+			if ( !lockedVerteces[ v1 ] )
+			{
+				collapses.push_back( SEdgeCollapse{ v1, v0, error1 + quadrics[ positionIDs[ v0 ] ].Evaluate( Vector( InVerteces[ v0 ].position ) ) } );
+			}
+		}
+
+		std::sort( collapses.begin(), collapses.end(), []( const SEdgeCollapse& InA, const SEdgeCollapse& InB )
+				   {
+					   return InA.cost < InB.cost;
+				   } );
+
+		// Each collapse of interior edge removes two triangles
+		const uint32		maxCollapses	= ( numIndeces - InTargetNumIndeces ) / 6 + 1;
+		uint32				numCollapses	= 0;
+		touchedVerteces.assign( InNumVerteces, false );
+		for ( uint32 index = 0; index < InNumVerteces; ++index )
+		{
+			remap[ index ] = index;
+		}
+
+		for ( uint32 index = 0, count = collapses.size(); index < count && numCollapses < maxCollapses; ++index )
+		{
+			const SEdgeCollapse&		collapse = collapses[ index ];
+			if ( touchedVerteces[ collapse.from ] || touchedVerteces[ collapse.to ] || IsCollapseFlipping( InVerteces, OutIndeces.data(), adjacency, adjacencyOffsets, collapse.from, collapse.to ) )
+			{
+				continue;
+			}
+
+			// Neighbors are touched too, so triangles around removed vertex aren't changed by other collapses in this pass
+			for ( uint32 indexTriangle = adjacencyOffsets[ collapse.from ], end = adjacencyOffsets[ collapse.from + 1 ]; indexTriangle < end; ++indexTriangle )
+			{
+				const uint32*		triangle = OutIndeces.data() + adjacency[ indexTriangle ] * 3;
+				touchedVerteces[ triangle[ 0 ] ] = true;
+				touchedVerteces[ triangle[ 1 ] ] = true;
+				touchedVerteces[ triangle[ 2 ] ] = true;
+			}
+
+			touchedVerteces[ collapse.to ]			= true;
+			remap[ collapse.from ]					= collapse.to;
+			quadrics[ positionIDs[ collapse.to ] ]	+= quadrics[ positionIDs[ collapse.from ] ];
+			++numCollapses;
+		}
+
+		if ( numCollapses == 0 )
+		{
+			break;
+		}
+
+		// Apply collapses and remove degenerate triangles
+		uint32		numOutIndeces = 0;
+		for ( uint32 index = 0; index < numIndeces; index += 3 )
+		{
+			const uint32		v0 = remap[ OutIndeces[ index + 0 ] ];
+			const uint32		v1 = remap[ OutIndeces[ index + 1 ] ];
+			const uint32		v2 = remap[ OutIndeces[ index + 2 ] ];
+			if ( v0 == v1 || v1 == v2 || v0 == v2 )
+			{
+				continue;
+			}
+
+			OutIndeces[ numOutIndeces++ ] = v0;
+			OutIndeces[ numOutIndeces++ ] = v1;
+			OutIndeces[ numOutIndeces++ ] = v2;
+		}
+		OutIndeces.resize( numOutIndeces );
+	}
+}
+
+void GenerateStaticMeshLODs( const std::vector< SStaticMeshVertexType >& InVerteces, std::vector< uint32 >& InOutIndeces, const std::vector< SStaticMeshSurface >& InSurfaces, std::vector< SStaticMeshLOD >& OutLODs, uint32 InNumLODs /* = MESHOPTIMIZER_NUM_LODS */ )
+{
+	OutLODs.clear();
+	if ( InVerteces.empty() || InOutIndeces.empty() )
+	{
+		return;
+	}
+
+	// Each LOD is simplified from previous one
+	std::vector< SStaticMeshSurface >		prevSurfaces		= InSurfaces;
+	uint32									prevNumPrimitives	= 0;
+	std::vector< uint32 >					simplifiedIndeces;
+	for ( uint32 index = 0, count = InSurfaces.size(); index < count; ++index )
+	{
+		prevNumPrimitives += InSurfaces[ index ].numPrimitives;
+	}
+
+	for ( uint32 lodIndex = 1; lodIndex < InNumLODs; ++lodIndex )
+	{
+		SStaticMeshLOD		lod;
+		uint32				numPrimitives	= 0;
+		const uint32		firstLODIndex	= InOutIndeces.size();
+		lod.screenSize = powf( MESHOPTIMIZER_LOD_REDUCTION, ( float )lodIndex );
+
+		for ( uint32 indexSurface = 0, numSurfaces = prevSurfaces.size(); indexSurface < numSurfaces; ++indexSurface )
+		{
+			// Indices of surfaces must be absolute, OptimizeStaticMesh makes it
+			const SStaticMeshSurface&		prevSurface = prevSurfaces[ indexSurface ];
+			check( prevSurface.baseVertexIndex == 0 && prevSurface.firstIndex + prevSurface.numPrimitives * 3 <= InOutIndeces.size() );
+
+			SimplifyMesh( InVerteces.data(), InVerteces.size(), InOutIndeces.data() + prevSurface.firstIndex, prevSurface.numPrimitives * 3, ( uint32 )( prevSurface.numPrimitives * MESHOPTIMIZER_LOD_REDUCTION ) * 3, simplifiedIndeces );
+			if ( simplifiedIndeces.empty() )
+			{
+				continue;
+			}
+
+			OptimizeVertexCache( simplifiedIndeces.data(), simplifiedIndeces.size(), InVerteces.size() );
+			lod.surfaces.push_back( SStaticMeshSurface{ prevSurface.materialID, 0, ( uint32 )InOutIndeces.size(), ( uint32 )simplifiedIndeces.size() / 3 } );
+			InOutIndeces.insert( InOutIndeces.end(), simplifiedIndeces.begin(), simplifiedIndeces.end() );
+			numPrimitives += lod.surfaces.back().numPrimitives;
+		}
+
+		// Locked borders and seams can prevent simplification, such LOD only wastes memory
+		if ( numPrimitives == 0 || numPrimitives > prevNumPrimitives * ( 1.f - LOD_MIN_REDUCTION ) )
+		{
+			InOutIndeces.resize( firstLODIndex );
+			break;
+		}
+
+		OutLODs.push_back( lod );
+		prevSurfaces		= lod.surfaces;
+		prevNumPrimitives	= numPrimitives;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,163 @@
+#include <string.h>
+
+#define STBRP_STATIC
+#define STB_RECT_PACK_IMPLEMENTATION
+#include "ImGUI/imstb_rectpack.h"
+
+#include "Misc/Template.h"
+#include "System/TextureAtlas.h"
+
+//
+// Definitions
+//
+
+/* Alignment of images in atlas, it is size of block in block compression */
+#define TEXTUREATLAS_ALIGNMENT			4
+
+/* Min size of atlas by each axis */
+#define TEXTUREATLAS_MIN_SIZE			4
+
+CTextureAtlasBuilder::CTextureAtlasBuilder( uint32 InMaxSize /* = TEXTUREATLAS_MAX_SIZE */, uint32 InPadding /* = TEXTUREATLAS_DEFAULT_PADDING */ )
+	: maxSize( InMaxSize )
+	, padding( InPadding )
+	, sizeX( 0 )
+	, sizeY( 0 )
+{}
+
+uint32 CTextureAtlasBuilder::AddImage( uint32 InSizeX, uint32 InSizeY, const byte* InData )
+{
+	check( InSizeX > 0 && InSizeY > 0 && InData );
+	images.push_back( SImage{ InSizeX, InSizeY, InData, 0, 0 } );
+	return images.size() - 1;
+}
+
+bool CTextureAtlasBuilder::Build()
+{
+	if ( images.empty() )
+	{
+		return false;
+	}
+
+	// Getting min size of atlas
+	uint64		totalArea	= 0;
+	uint32		minSizeX	= TEXTUREATLAS_MIN_SIZE;
+	uint32		minSizeY	= TEXTUREATLAS_MIN_SIZE;
+	for ( uint32 index = 0, count = images.size(); index < count; ++index )
+	{
+		const SImage&	image		= images[ index ];
+		const uint32	paddedSizeX	= Align( image.sizeX + padding * 2, TEXTUREATLAS_ALIGNMENT );
+		const uint32	paddedSizeY	= Align( image.sizeY + padding * 2, TEXTUREATLAS_ALIGNMENT );
+		totalArea	+= ( uint64 )paddedSizeX * paddedSizeY;
+		while ( minSizeX < paddedSizeX )
+		{
+			minSizeX *= 2;
+		}
+		while ( minSizeY < paddedSizeY )
+		{
+			minSizeY *= 2;
+		}
+	}
+
+	// Grow size of atlas by power of two until all images are packed, the atlas is kept close to square
+	uint32		atlasSizeX = Max( minSizeX, minSizeY );
+	uint32		atlasSizeY = minSizeY;
+	while ( atlasSizeX <= maxSize && atlasSizeY <= maxSize )
+	{
+		if ( ( uint64 )atlasSizeX * atlasSizeY >= totalArea && Pack( atlasSizeX, atlasSizeY ) )
+		{
+			break;
+		}
+
+		if ( atlasSizeY < atlasSizeX )
+		{
+			atlasSizeY *= 2;
+		}
+		else
+		{
+			atlasSizeX *= 2;
+		}
+	}
+
+	if ( atlasSizeX > maxSize || atlasSizeY > maxSize )
+	{
+		return false;
+	}
+
+	// Copy images to atlas, padding is filled by edge texels of image
+	sizeX	= atlasSizeX;
+	sizeY	= atlasSizeY;
+	data.resize( sizeX * sizeY * 4 );
+	memset( data.data(), 0, data.size() );
+	for ( uint32 index = 0, count = images.size(); index < count; ++index )
+	{
+		const SImage&	image		= images[ index ];
+		const uint32	paddedSizeX	= Align( image.sizeX + padding * 2, TEXTUREATLAS_ALIGNMENT );
+		const uint32	paddedSizeY	= Align( image.sizeY + padding * 2, TEXTUREATLAS_ALIGNMENT );
+		for ( uint32 y = 0; y < paddedSizeY; ++y )
+		{
+			const uint32	srcY	= Clamp<int32>( ( int32 )y - ( int32 )padding, 0, image.sizeY - 1 );
+			byte*			dst		= &data[ ( ( image.y - padding + y ) * sizeX + image.x - padding ) * 4 ];
+			for ( uint32 x = 0; x < paddedSizeX; ++x )
+			{
+				const uint32	srcX = Clamp<int32>( ( int32 )x - ( int32 )padding, 0, image.sizeX - 1 );
+				memcpy( dst + x * 4, &image.data[ ( srcY * image.sizeX + srcX ) * 4 ], 4 );
+			}
+		}
+	}
+
+	return true;
+}
+
+bool CTextureAtlasBuilder::Pack( uint32 InSizeX, uint32 InSizeY )
+{
+	std::vector< stbrp_rect >		rects( images.size() );
+	std::vector< stbrp_node >		nodes( InSizeX );
+	for ( uint32 index = 0, count = images.size(); index < count; ++index )
+	{
+		stbrp_rect&		rect = rects[ index ];
+		memset( &rect, 0, sizeof( stbrp_rect ) );
+		rect.id	= index;
+		rect.w	= Align( images[ index ].sizeX + padding * 2, TEXTUREATLAS_ALIGNMENT );
+		rect.h	= Align( images[ index ].sizeY + padding * 2, TEXTUREATLAS_ALIGNMENT );
+	}
+
+	stbrp_context		context;
+	stbrp_init_target( &context, InSizeX, InSizeY, nodes.data(), nodes.size() );
+	if ( !stbrp_pack_rects( &context, rects.data(), rects.size() ) )
+	{
+		return false;
+	}
+
+	for ( uint32 index = 0, count = rects.size(); index < count; ++index )
+	{
+		SImage&		image = images[ rects[ index ].id ];
+		image.x		= rects[ index ].x + padding;
+		image.y		= rects[ index ].y + padding;
+	}
+	return true;
+}
+
+RectFloat_t CTextureAtlasBuilder::TransformRect( uint32 InIndex, const RectFloat_t& InRect ) const
+{
+	check( InIndex < images.size() && sizeX > 0 && sizeY > 0 );
+	const SImage&		image = images[ InIndex ];
+	return RectFloat_t( ( image.x + InRect.left * image.sizeX ) / sizeX,
+						( image.y + InRect.top * image.sizeY ) / sizeY,
+						InRect.width * image.sizeX / sizeX,
+						InRect.height * image.sizeY / sizeY );
+}
+
+float CTextureAtlasBuilder::GetOccupancy() const
+{
+	if ( sizeX == 0 || sizeY == 0 )
+	{
+		return 0.f;
+	}
+
+	uint64		usedArea = 0;
+	for ( uint32 index = 0, count = images.size(); index < count; ++index )
+	{
+		usedArea += ( uint64 )images[ index ].sizeX * images[ index ].sizeY;
+	}
+	return ( float )( ( double )usedArea / ( ( double )sizeX * sizeY ) );
+}
\ No newline at end of file
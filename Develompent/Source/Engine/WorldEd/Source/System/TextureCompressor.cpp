@@ -0,0 +1,764 @@
+#include <math.h>
+#include <float.h>
+#include <string.h>
+#include <emmintrin.h>
+
+#define STB_DXT_IMPLEMENTATION
+#include <stb_dxt.h>
+
+#include "Misc/Misc.h"
+#include "Misc/Template.h"
+#include "Logger/LoggerMacros.h"
+#include "System/ThreadingBase.h"
+#include "Render/RenderUtils.h"
+#include "Render/TextureMips.h"
+#include "System/TextureCompressor.h"
+
+//
+// Definitions
+//
+
+/* Max number of threads for compress one texture */
+#define TEXTURECOMPRESSOR_MAX_THREADS				16
+
+/* Min number of blocks per thread, small mip chains are compressed on the calling thread only */
+#define TEXTURECOMPRESSOR_MIN_BLOCKS_PER_THREAD		1024
+
+/* Number of passes of BC7 encoder, each next pass refits endpoints to indices of the previous one by least squares */
+#define BC7_NUM_PASSES								3
+
+/* Weights of 4 bit indices in BC7 */
+static const uint32		GBC7Weights[ 16 ] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+/**
+ * Row of blocks for compress
+ */
+struct SCompressRow
+{
+	const byte*		srcData;		/**< Texels of mip in PF_A8R8G8B8 */
+	byte*			dstData;		/**< Output blocks of the row */
+	uint32			sizeX;			/**< Width of mip */
+	uint32			sizeY;			/**< Height of mip */
+	uint32			blockY;			/**< Index of the row */
+};
+
+/**
+ * Job for compress mip chain, rows of blocks are taken by threads one by one
+ */
+struct SCompressJob
+{
+	EPixelFormat					pixelFormat;	/**< Block compressed pixel format */
+	std::vector< SCompressRow >		rows;			/**< Rows of blocks of all mips */
+	volatile int32					nextRow;		/**< Index of next not taken row */
+};
+
+/**
+ * Dot product of four components
+ *
+ * @param InA	First vector
+ * @param InB	Second vector
+ * @return Return dot product
+ */
+static FORCEINLINE float DotProduct4( __m128 InA, __m128 InB )
+{
+	__m128		mul = _mm_mul_ps( InA, InB );
+	mul = _mm_add_ps( mul, _mm_shuffle_ps( mul, mul, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+	mul = _mm_add_ss( mul, _mm_movehl_ps( mul, mul ) );
+	return _mm_cvtss_f32( mul );
+}
+
+/**
+ * Write bits to block
+ *
+ * @param InOutBlock	Block
+ * @param InOutBitPos	Position of first bit, it is moved to the end of written bits
+ * @param InValue		Value
+ * @param InNumBits		Number of bits in value
+ */
+static FORCEINLINE void WriteBits( byte* InOutBlock, uint32& InOutBitPos, uint32 InValue, uint32 InNumBits )
+{
+	for ( uint32 index = 0; index < InNumBits; ++index, ++InOutBitPos )
+	{
+		InOutBlock[ InOutBitPos >> 3 ] |= ( ( InValue >> index ) & 1 ) << ( InOutBitPos & 7 );
+	}
+}
+
+/**
+ * Read bits from block
+ *
+ * @param InBlock		Block
+ * @param InOutBitPos	Position of first bit, it is moved to the end of read bits
+ * @param InNumBits		Number of bits in value
+ * @return Return value
+ */
+static FORCEINLINE uint32 ReadBits( const byte* InBlock, uint32& InOutBitPos, uint32 InNumBits )
+{
+	uint32		value = 0;
+	for ( uint32 index = 0; index < InNumBits; ++index, ++InOutBitPos )
+	{
+		value |= ( ( InBlock[ InOutBitPos >> 3 ] >> ( InOutBitPos & 7 ) ) & 1 ) << index;
+	}
+	return value;
+}
+
+/**
+ * Quantize endpoint of BC7 mode 6 to 7 bits per channel with p-bit
+ *
+ * @param InEndpoint		Endpoint in range [0;255]
+ * @param OutEndpoint		Output quantized endpoint in 8 bits, the lowest bit is p-bit
+ */
+static void QuantizeBC7Endpoint( __m128 InEndpoint, uint32* OutEndpoint )
+{
+	const __m128		zero		= _mm_setzero_ps();
+	const __m128		maxValue	= _mm_set1_ps( 127.f );
+	const __m128		half		= _mm_set1_ps( 0.5f );
+	float				bestError	= FLT_MAX;
+
+	for ( uint32 pBit = 0; pBit < 2; ++pBit )
+	{
+		const __m128	pBitValue	= _mm_set1_ps( ( float )pBit );
+		__m128i			quantized	= _mm_cvtps_epi32( _mm_min_ps( _mm_max_ps( _mm_mul_ps( _mm_sub_ps( InEndpoint, pBitValue ), half ), zero ), maxValue ) );
+		__m128i			endpoint	= _mm_or_si128( _mm_slli_epi32( quantized, 1 ), _mm_set1_epi32( pBit ) );
+		__m128			delta		= _mm_sub_ps( _mm_cvtepi32_ps( endpoint ), InEndpoint );
+		const float		error		= DotProduct4( delta, delta );
+		if ( error < bestError )
+		{
+			bestError = error;
+			_mm_storeu_si128( ( __m128i* )OutEndpoint, endpoint );
+		}
+	}
+}
+
+/**
+ * Find the best indices of texels for BC7 mode 6 endpoints
+ *
+ * @param InTexels			Texels of block
+ * @param InEndpoints		Quantized endpoints
+ * @param OutIndices		Output indices of texels
+ * @return Return squared error of block
+ */
+static float FindBC7Indices( const __m128* InTexels, const uint32 InEndpoints[ 2 ][ 4 ], uint32* OutIndices )
+{
+	// Palette is stored by channels, so four entries are compared with texel at once
+	__m128		palette[ 4 ][ 4 ];
+	for ( uint32 channel = 0; channel < 4; ++channel )
+	{
+		float		values[ 16 ];
+		for ( uint32 index = 0; index < 16; ++index )
+		{
+			values[ index ] = ( float )( ( ( 64 - GBC7Weights[ index ] ) * InEndpoints[ 0 ][ channel ] + GBC7Weights[ index ] * InEndpoints[ 1 ][ channel ] + 32 ) >> 6 );
+		}
+
+		for ( uint32 index = 0; index < 4; ++index )
+		{
+			palette[ channel ][ index ] = _mm_loadu_ps( values + index * 4 );
+		}
+	}
+
+	float		totalError = 0.f;
+	for ( uint32 texelIndex = 0; texelIndex < 16; ++texelIndex )
+	{
+		const __m128	texel = InTexels[ texelIndex ];
+		const __m128	r = _mm_shuffle_ps( texel, texel, _MM_SHUFFLE( 0, 0, 0, 0 ) );
+		const __m128	g = _mm_shuffle_ps( texel, texel, _MM_SHUFFLE( 1, 1, 1, 1 ) );
+		const __m128	b = _mm_shuffle_ps( texel, texel, _MM_SHUFFLE( 2, 2, 2, 2 ) );
+		const __m128	a = _mm_shuffle_ps( texel, texel, _MM_SHUFFLE( 3, 3, 3, 3 ) );
+
+		__m128			errors[ 4 ];
+		for ( uint32 index = 0; index < 4; ++index )
+		{
+			const __m128	dr = _mm_sub_ps( palette[ 0 ][ index ], r );
+			const __m128	dg = _mm_sub_ps( palette[ 1 ][ index ], g );
+			const __m128	db = _mm_sub_ps( palette[ 2 ][ index ], b );
+			const __m128	da = _mm_sub_ps( palette[ 3 ][ index ], a );
+			errors[ index ] = _mm_add_ps( _mm_add_ps( _mm_mul_ps( dr, dr ), _mm_mul_ps( dg, dg ) ), _mm_add_ps( _mm_mul_ps( db, db ), _mm_mul_ps( da, da ) ) );
+		}
+
+		// Broadcast the minimal error to all lanes and find the first entry with it
+		__m128			minError = _mm_min_ps( _mm_min_ps( errors[ 0 ], errors[ 1 ] ), _mm_min_ps( errors[ 2 ], errors[ 3 ] ) );
+		minError = _mm_min_ps( minError, _mm_shuffle_ps( minError, minError, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+		minError = _mm_min_ps( minError, _mm_shuffle_ps( minError, minError, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+
+		uint32			mask =	_mm_movemask_ps( _mm_cmpeq_ps( errors[ 0 ], minError ) ) |
+								( _mm_movemask_ps( _mm_cmpeq_ps( errors[ 1 ], minError ) ) << 4 ) |
+								( _mm_movemask_ps( _mm_cmpeq_ps( errors[ 2 ], minError ) ) << 8 ) |
+								( _mm_movemask_ps( _mm_cmpeq_ps( errors[ 3 ], minError ) ) << 12 );
+		uint32			bestIndex = 0;
+		while ( !( mask & 1 ) )
+		{
+			mask >>= 1;
+			++bestIndex;
+		}
+
+		OutIndices[ texelIndex ] = bestIndex;
+		totalError += _mm_cvtss_f32( minError );
+	}
+	return totalError;
+}
+
+/**
+ * Encode block to BC7 in mode 6 (one subset, RGBA endpoints with p-bits and 4 bit indices)
+ *
+ * @param InTexels		Texels of block in PF_A8R8G8B8
+ * @param OutBlock		Output block
+ */
+static void EncodeBC7Block( const byte* InTexels, byte* OutBlock )
+{
+	__m128		texels[ 16 ];
+	__m128		mean		= _mm_setzero_ps();
+	__m128		minValue	= _mm_set1_ps( 255.f );
+	__m128		maxValue	= _mm_setzero_ps();
+	for ( uint32 index = 0; index < 16; ++index, InTexels += 4 )
+	{
+		texels[ index ] = _mm_cvtepi32_ps( _mm_setr_epi32( InTexels[ 0 ], InTexels[ 1 ], InTexels[ 2 ], InTexels[ 3 ] ) );
+		mean			= _mm_add_ps( mean, texels[ index ] );
+		minValue		= _mm_min_ps( minValue, texels[ index ] );
+		maxValue		= _mm_max_ps( maxValue, texels[ index ] );
+	}
+	mean = _mm_mul_ps( mean, _mm_set1_ps( 1.f / 16.f ) );
+
+	// Find principal axis of texels by power iteration, it starts from diagonal of bounding box
+	__m128		axis = _mm_sub_ps( maxValue, minValue );
+	for ( uint32 iteration = 0; iteration < 4; ++iteration )
+	{
+		__m128		newAxis = _mm_setzero_ps();
+		for ( uint32 index = 0; index < 16; ++index )
+		{
+			const __m128	delta = _mm_sub_ps( texels[ index ], mean );
+			newAxis = _mm_add_ps( newAxis, _mm_mul_ps( delta, _mm_set1_ps( DotProduct4( delta, axis ) ) ) );
+		}
+
+		const float		length = DotProduct4( newAxis, newAxis );
+		if ( length < 1e-6f )
+		{
+			break;
+		}
+		axis = _mm_mul_ps( newAxis, _mm_set1_ps( 1.f / sqrtf( length ) ) );
+	}
+
+	const float		axisLength = DotProduct4( axis, axis );
+	if ( axisLength > 1e-6f )
+	{
+		axis = _mm_mul_ps( axis, _mm_set1_ps( 1.f / sqrtf( axisLength ) ) );
+	}
+
+	// Endpoints are extremes of texels projected to the axis
+	float		minT = 0.f;
+	float		maxT = 0.f;
+	for ( uint32 index = 0; index < 16; ++index )
+	{
+		const float		t = DotProduct4( _mm_sub_ps( texels[ index ], mean ), axis );
+		minT = Min( minT, t );
+		maxT = Max( maxT, t );
+	}
+
+	__m128		endpoints[ 2 ] = { _mm_add_ps( mean, _mm_mul_ps( axis, _mm_set1_ps( minT ) ) ), _mm_add_ps( mean, _mm_mul_ps( axis, _mm_set1_ps( maxT ) ) ) };
+	uint32		bestEndpoints[ 2 ][ 4 ];
+	uint32		bestIndices[ 16 ];
+	float		bestError = FLT_MAX;
+
+	for ( uint32 pass = 0; pass < BC7_NUM_PASSES; ++pass )
+	{
+		uint32		quantized[ 2 ][ 4 ];
+		uint32		indices[ 16 ];
+		QuantizeBC7Endpoint( endpoints[ 0 ], quantized[ 0 ] );
+		QuantizeBC7Endpoint( endpoints[ 1 ], quantized[ 1 ] );
+
+		const float		error = FindBC7Indices( texels, quantized, indices );
+		if ( error < bestError )
+		{
+			bestError = error;
+			memcpy( bestEndpoints, quantized, sizeof( bestEndpoints ) );
+			memcpy( bestIndices, indices, sizeof( bestIndices ) );
+		}
+
+		if ( bestError == 0.f || pass + 1 == BC7_NUM_PASSES )
+		{
+			break;
+		}
+
+		// Refit endpoints to indices by least squares
+		float		a = 0.f;
+		float		b = 0.f;
+		float		c = 0.f;
+		__m128		x0 = _mm_setzero_ps();
+		__m128		x1 = _mm_setzero_ps();
+		for ( uint32 index = 0; index < 16; ++index )
+		{
+			const float		weight = GBC7Weights[ indices[ index ] ] / 64.f;
+			a	+= ( 1.f - weight ) * ( 1.f - weight );
+			b	+= ( 1.f - weight ) * weight;
+			c	+= weight * weight;
+			x0	= _mm_add_ps( x0, _mm_mul_ps( texels[ index ], _mm_set1_ps( 1.f - weight ) ) );
+			x1	= _mm_add_ps( x1, _mm_mul_ps( texels[ index ], _mm_set1_ps( weight ) ) );
+		}
+
+		const float		determinant = a * c - b * b;
+		if ( fabsf( determinant ) < 1e-6f )
+		{
+			break;
+		}
+
+		const __m128	invDeterminant = _mm_set1_ps( 1.f / determinant );
+		endpoints[ 0 ] = _mm_mul_ps( _mm_sub_ps( _mm_mul_ps( x0, _mm_set1_ps( c ) ), _mm_mul_ps( x1, _mm_set1_ps( b ) ) ), invDeterminant );
+		endpoints[ 1 ] = _mm_mul_ps( _mm_sub_ps( _mm_mul_ps( x1, _mm_set1_ps( a ) ), _mm_mul_ps( x0, _mm_set1_ps( b ) ) ), invDeterminant );
+	}
+
+	// The highest bit of the first index is implicit zero, so swap endpoints if it is set
+	if ( bestIndices[ 0 ] >= 8 )
+	{
+		for ( uint32 channel = 0; channel < 4; ++channel )
+		{
+			Swap( bestEndpoints[ 0 ][ channel ], bestEndpoints[ 1 ][ channel ] );
+		}
+
+		for ( uint32 index = 0; index < 16; ++index )
+		{
+			bestIndices[ index ] = 15 - bestIndices[ index ];
+		}
+	}
+
+	memset( OutBlock, 0, 16 );
+	uint32		bitPos = 0;
+	WriteBits( OutBlock, bitPos, 1 << 6, 7 );
+	for ( uint32 channel = 0; channel < 4; ++channel )
+	{
+		WriteBits( OutBlock, bitPos, bestEndpoints[ 0 ][ channel ] >> 1, 7 );
+		WriteBits( OutBlock, bitPos, bestEndpoints[ 1 ][ channel ] >> 1, 7 );
+	}
+	WriteBits( OutBlock, bitPos, bestEndpoints[ 0 ][ 0 ] & 1, 1 );
+	WriteBits( OutBlock, bitPos, bestEndpoints[ 1 ][ 0 ] & 1, 1 );
+
+	WriteBits( OutBlock, bitPos, bestIndices[ 0 ], 3 );
+	for ( uint32 index = 1; index < 16; ++index )
+	{
+		WriteBits( OutBlock, bitPos, bestIndices[ index ], 4 );
+	}
+	check( bitPos == 128 );
+}
+
+/**
+ * Decode BC7 block in mode 6
+ *
+ * @param InBlock		Block
+ * @param OutTexels		Output texels in PF_A8R8G8B8. If block isn't in mode 6 it is decoded to black
+ */
+static void DecodeBC7Block( const byte* InBlock, byte* OutTexels )
+{
+	if ( ( InBlock[ 0 ] & 0x7F ) != 0x40 )
+	{
+		memset( OutTexels, 0, 16 * 4 );
+		return;
+	}
+
+	uint32		bitPos = 7;
+	uint32		endpoints[ 2 ][ 4 ];
+	for ( uint32 channel = 0; channel < 4; ++channel )
+	{
+		endpoints[ 0 ][ channel ] = ReadBits( InBlock, bitPos, 7 ) << 1;
+		endpoints[ 1 ][ channel ] = ReadBits( InBlock, bitPos, 7 ) << 1;
+	}
+
+	const uint32	pBit0 = ReadBits( InBlock, bitPos, 1 );
+	const uint32	pBit1 = ReadBits( InBlock, bitPos, 1 );
+	for ( uint32 channel = 0; channel < 4; ++channel )
+	{
+		endpoints[ 0 ][ channel ] |= pBit0;
+		endpoints[ 1 ][ channel ] |= pBit1;
+	}
+
+	for ( uint32 index = 0; index < 16; ++index, OutTexels += 4 )
+	{
+		const uint32	weight = GBC7Weights[ ReadBits( InBlock, bitPos, index == 0 ? 3 : 4 ) ];
+		for ( uint32 channel = 0; channel < 4; ++channel )
+		{
+			OutTexels[ channel ] = ( byte )( ( ( 64 - weight ) * endpoints[ 0 ][ channel ] + weight * endpoints[ 1 ][ channel ] + 32 ) >> 6 );
+		}
+	}
+}
+
+/**
+ * Decode colors of BC1 block
+ *
+ * @param InBlock			Block
+ * @param InIsAllowAlpha	Is allowed mode with 1 bit alpha. In BC3 colors are always decoded in four colors mode
+ * @param OutTexels			Output texels in PF_A8R8G8B8
+ */
+static void DecodeBC1Block( const byte* InBlock, bool InIsAllowAlpha, byte* OutTexels )
+{
+	const uint32	colors[ 2 ]		= { ( uint32 )( InBlock[ 0 ] | ( InBlock[ 1 ] << 8 ) ), ( uint32 )( InBlock[ 2 ] | ( InBlock[ 3 ] << 8 ) ) };
+	byte			palette[ 4 ][ 4 ];
+	for ( uint32 index = 0; index < 2; ++index )
+	{
+		const uint32	r = ( colors[ index ] >> 11 ) & 0x1F;
+		const uint32	g = ( colors[ index ] >> 5 ) & 0x3F;
+		const uint32	b = colors[ index ] & 0x1F;
+		palette[ index ][ 0 ] = ( byte )( ( r << 3 ) | ( r >> 2 ) );
+		palette[ index ][ 1 ] = ( byte )( ( g << 2 ) | ( g >> 4 ) );
+		palette[ index ][ 2 ] = ( byte )( ( b << 3 ) | ( b >> 2 ) );
+		palette[ index ][ 3 ] = 255;
+	}
+
+	for ( uint32 channel = 0; channel < 3; ++channel )
+	{
+		if ( colors[ 0 ] > colors[ 1 ] || !InIsAllowAlpha )
+		{
+			palette[ 2 ][ channel ] = ( byte )( ( 2 * palette[ 0 ][ channel ] + palette[ 1 ][ channel ] ) / 3 );
+			palette[ 3 ][ channel ] = ( byte )( ( palette[ 0 ][ channel ] + 2 * palette[ 1 ][ channel ] ) / 3 );
+		}
+		else
+		{
+			palette[ 2 ][ channel ] = ( byte )( ( palette[ 0 ][ channel ] + palette[ 1 ][ channel ] ) / 2 );
+			palette[ 3 ][ channel ] = 0;
+		}
+	}
+	palette[ 2 ][ 3 ] = 255;
+	palette[ 3 ][ 3 ] = colors[ 0 ] > colors[ 1 ] || !InIsAllowAlpha ? 255 : 0;
+
+	const uint32	indices = InBlock[ 4 ] | ( InBlock[ 5 ] << 8 ) | ( InBlock[ 6 ] << 16 ) | ( ( uint32 )InBlock[ 7 ] << 24 );
+	for ( uint32 index = 0; index < 16; ++index, OutTexels += 4 )
+	{
+		memcpy( OutTexels, palette[ ( indices >> ( index * 2 ) ) & 3 ], 4 );
+	}
+}
+
+/**
+ * Decode one channel of BC4 block
+ *
+ * @param InBlock		Block
+ * @param InChannel		Channel of texels for output
+ * @param OutTexels		Output texels in PF_A8R8G8B8, other channels isn't changed
+ */
+static void DecodeBC4Block( const byte* InBlock, uint32 InChannel, byte* OutTexels )
+{
+	uint32		palette[ 8 ] = { InBlock[ 0 ], InBlock[ 1 ] };
+	if ( palette[ 0 ] > palette[ 1 ] )
+	{
+		for ( uint32 index = 2; index < 8; ++index )
+		{
+			palette[ index ] = ( ( 8 - index ) * palette[ 0 ] + ( index - 1 ) * palette[ 1 ] ) / 7;
+		}
+	}
+	else
+	{
+		for ( uint32 index = 2; index < 6; ++index )
+		{
+			palette[ index ] = ( ( 6 - index ) * palette[ 0 ] + ( index - 1 ) * palette[ 1 ] ) / 5;
+		}
+		palette[ 6 ] = 0;
+		palette[ 7 ] = 255;
+	}
+
+	uint64		indices = 0;
+	for ( uint32 index = 0; index < 6; ++index )
+	{
+		indices |= ( uint64 )InBlock[ 2 + index ] << ( index * 8 );
+	}
+
+	for ( uint32 index = 0; index < 16; ++index, OutTexels += 4 )
+	{
+		OutTexels[ InChannel ] = ( byte )palette[ ( indices >> ( index * 3 ) ) & 7 ];
+	}
+}
+
+/**
+ * Load block of texels from mip, texels outside of mip are clamped to the edge
+ *
+ * @param InData		Texels of mip in PF_A8R8G8B8
+ * @param InSizeX		Width of mip
+ * @param InSizeY		Height of mip
+ * @param InBlockX		Block index by X
+ * @param InBlockY		Block index by Y
+ * @param OutTexels		Output 4x4 texels
+ */
+static FORCEINLINE void LoadBlock( const byte* InData, uint32 InSizeX, uint32 InSizeY, uint32 InBlockX, uint32 InBlockY, byte* OutTexels )
+{
+	for ( uint32 y = 0; y < 4; ++y )
+	{
+		const byte*		row = InData + Min( InBlockY * 4 + y, InSizeY - 1 ) * InSizeX * 4;
+		for ( uint32 x = 0; x < 4; ++x, OutTexels += 4 )
+		{
+			memcpy( OutTexels, row + Min( InBlockX * 4 + x, InSizeX - 1 ) * 4, 4 );
+		}
+	}
+}
+
+/**
+ * Compress block
+ *
+ * @param InPixelFormat		Block compressed pixel format
+ * @param InTexels			4x4 texels in PF_A8R8G8B8
+ * @param OutBlock			Output block
+ */
+static void CompressBlock( EPixelFormat InPixelFormat, byte* InTexels, byte* OutBlock )
+{
+	switch ( InPixelFormat )
+	{
+	case PF_BC1:
+		// stb_dxt expects constant alpha when alpha isn't stored
+		for ( uint32 index = 0; index < 16; ++index )
+		{
+			InTexels[ index * 4 + 3 ] = 255;
+		}
+		stb_compress_dxt_block( OutBlock, InTexels, 0, STB_DXT_HIGHQUAL );
+		break;
+
+	case PF_BC3:
+		stb_compress_dxt_block( OutBlock, InTexels, 1, STB_DXT_HIGHQUAL );
+		break;
+
+	case PF_BC5:
+	{
+		byte		texelsRG[ 16 * 2 ];
+		for ( uint32 index = 0; index < 16; ++index )
+		{
+			texelsRG[ index * 2 ]		= InTexels[ index * 4 ];
+			texelsRG[ index * 2 + 1 ]	= InTexels[ index * 4 + 1 ];
+		}
+		stb_compress_bc5_block( OutBlock, texelsRG );
+		break;
+	}
+
+	case PF_BC7:
+		EncodeBC7Block( InTexels, OutBlock );
+		break;
+
+	default:
+		checkMsg( false, TEXT( "Unsupported pixel format %s for compress" ), GPixelFormats[ InPixelFormat ].name );
+		break;
+	}
+}
+
+/**
+ * Compress rows of job while there are not taken rows
+ * @param InJob		Job
+ */
+static void CompressRows( SCompressJob& InJob )
+{
+	const uint32		blockBytes = GPixelFormats[ InJob.pixelFormat ].blockBytes;
+	byte				texels[ 16 * 4 ];
+	while ( true )
+	{
+		const int32		rowIndex = appInterlockedIncrement( &InJob.nextRow ) - 1;
+		if ( rowIndex >= ( int32 )InJob.rows.size() )
+		{
+			break;
+		}
+
+		const SCompressRow&		row = InJob.rows[ rowIndex ];
+		byte*					block = row.dstData;
+		for ( uint32 blockX = 0, numBlocksX = ( row.sizeX + 3 ) / 4; blockX < numBlocksX; ++blockX, block += blockBytes )
+		{
+			LoadBlock( row.srcData, row.sizeX, row.sizeY, blockX, row.blockY, texels );
+			CompressBlock( InJob.pixelFormat, texels, block );
+		}
+	}
+}
+
+/**
+ * @ingroup WorldEd
+ * @brief Thread for compress rows of blocks
+ */
+class CTextureCompressorThread : public CRunnable
+{
+public:
+	/**
+	 * @brief Constructor
+	 * @param InJob		Job
+	 */
+	CTextureCompressorThread( SCompressJob& InJob )
+		: job( InJob )
+	{}
+
+	/**
+	 * @brief Initialize
+	 * @return True if initialization was successful, false otherwise
+	 */
+	virtual bool Init() override
+	{
+		return true;
+	}
+
+	/**
+	 * @brief Run
+	 * @return The exit code of the runnable object
+	 */
+	virtual uint32 Run() override
+	{
+		CompressRows( job );
+		return 0;
+	}
+
+	/**
+	 * @brief Stop
+	 */
+	virtual void Stop() override
+	{}
+
+	/**
+	 * @brief Exit
+	 */
+	virtual void Exit() override
+	{}
+
+private:
+	SCompressJob&		job;		/**< Job */
+};
+
+EPixelFormat GetCompressedPixelFormat( ETextureCompression InCompression, uint32 InSizeX, uint32 InSizeY, const byte* InData )
+{
+	// D3D11 requires size of the top mip in block compressed formats to be multiple of 4
+	if ( InCompression == TC_None || ( InSizeX % 4 ) != 0 || ( InSizeY % 4 ) != 0 )
+	{
+		return PF_A8R8G8B8;
+	}
+
+	switch ( InCompression )
+	{
+	case TC_Default:
+		for ( uint32 index = 0, count = InSizeX * InSizeY; index < count; ++index )
+		{
+			if ( InData[ index * 4 + 3 ] != 255 )
+			{
+				return PF_BC3;
+			}
+		}
+		return PF_BC1;
+
+	case TC_BC1:	return PF_BC1;
+	case TC_BC3:	return PF_BC3;
+	case TC_BC5:	return PF_BC5;
+	case TC_BC7:	return PF_BC7;
+	default:		return PF_A8R8G8B8;
+	}
+}
+
+bool CompressMipChain( EPixelFormat InPixelFormat, uint32 InSizeX, uint32 InSizeY, uint32 InNumMips, const byte* InData, std::vector< byte >& OutData )
+{
+	if ( InPixelFormat != PF_BC1 && InPixelFormat != PF_BC3 && InPixelFormat != PF_BC5 && InPixelFormat != PF_BC7 )
+	{
+		return false;
+	}
+
+	check( InData && InSizeX > 0 && InSizeY > 0 && InNumMips > 0 );
+	OutData.resize( CalcMipChainSize( InPixelFormat, InSizeX, InSizeY, InNumMips ) );
+
+	// Split all mips to rows of blocks
+	SCompressJob		job;
+	const uint32		blockBytes	= GPixelFormats[ InPixelFormat ].blockBytes;
+	const byte*			srcData		= InData;
+	byte*				dstData		= OutData.data();
+	uint32				numBlocks	= 0;
+	job.pixelFormat		= InPixelFormat;
+	job.nextRow			= 0;
+
+	for ( uint32 mipIndex = 0; mipIndex < InNumMips; ++mipIndex )
+	{
+		const uint32	sizeX		= Max<uint32>( InSizeX >> mipIndex, 1 );
+		const uint32	sizeY		= Max<uint32>( InSizeY >> mipIndex, 1 );
+		const uint32	numBlocksX	= ( sizeX + 3 ) / 4;
+		const uint32	numBlocksY	= ( sizeY + 3 ) / 4;
+		for ( uint32 blockY = 0; blockY < numBlocksY; ++blockY, dstData += numBlocksX * blockBytes )
+		{
+			job.rows.push_back( SCompressRow{ srcData, dstData, sizeX, sizeY, blockY } );
+		}
+
+		numBlocks	+= numBlocksX * numBlocksY;
+		srcData		+= sizeX * sizeY * 4;
+	}
+	check( dstData == OutData.data() + OutData.size() );
+
+	// Start worker threads, the calling thread compresses rows too
+	const uint32						numThreads = Min<uint32>( Min<uint32>( appGetNumberOfProcessors(), TEXTURECOMPRESSOR_MAX_THREADS ), Max<uint32>( numBlocks / TEXTURECOMPRESSOR_MIN_BLOCKS_PER_THREAD, 1 ) );
+	std::vector< CRunnableThread* >		threads;
+	std::vector< CRunnable* >			runnables;
+	for ( uint32 index = 1; index < numThreads; ++index )
+	{
+		CRunnable*			runnable	= new CTextureCompressorThread( job );
+		CRunnableThread*	thread		= GThreadFactory->CreateThread( runnable, TEXT( "TextureCompressorThread" ) );
+		if ( !thread )
+		{
+			delete runnable;
+			break;
+		}
+
+		runnables.push_back( runnable );
+		threads.push_back( thread );
+	}
+
+	CompressRows( job );
+	for ( uint32 index = 0, count = threads.size(); index < count; ++index )
+	{
+		threads[ index ]->WaitForCompletion();
+		GThreadFactory->Destroy( threads[ index ] );
+		delete runnables[ index ];
+	}
+	return true;
+}
+
+EPixelFormat CompressTexture( ETextureCompression InCompression, uint32 InSizeX, uint32 InSizeY, uint32 InNumMips, const std::vector< byte >& InData, std::vector< byte >& OutData )
+{
+	const EPixelFormat		pixelFormat = GetCompressedPixelFormat( InCompression, InSizeX, InSizeY, InData.data() );
+	if ( pixelFormat == PF_A8R8G8B8 || !CompressMipChain( pixelFormat, InSizeX, InSizeY, InNumMips, InData.data(), OutData ) )
+	{
+		if ( InCompression != TC_None )
+		{
+			LE_LOG( LT_Warning, LC_Editor, TEXT( "Texture %ix%i can't be compressed, size must be multiple of 4. Texture is stored without compression" ), InSizeX, InSizeY );
+		}
+
+		OutData = InData;
+		return PF_A8R8G8B8;
+	}
+	return pixelFormat;
+}
+
+void DecompressMip( EPixelFormat InPixelFormat, uint32 InSizeX, uint32 InSizeY, const byte* InData, byte* OutData )
+{
+	check( InData && OutData );
+	const uint32		blockBytes = GPixelFormats[ InPixelFormat ].blockBytes;
+	byte				texels[ 16 * 4 ];
+	for ( uint32 blockY = 0, numBlocksY = ( InSizeY + 3 ) / 4; blockY < numBlocksY; ++blockY )
+	{
+		for ( uint32 blockX = 0, numBlocksX = ( InSizeX + 3 ) / 4; blockX < numBlocksX; ++blockX, InData += blockBytes )
+		{
+			switch ( InPixelFormat )
+			{
+			case PF_BC1:
+				DecodeBC1Block( InData, true, texels );
+				break;
+
+			case PF_BC3:
+				DecodeBC1Block( InData + 8, false, texels );
+				DecodeBC4Block( InData, 3, texels );
+				break;
+
+			case PF_BC5:
+				memset( texels, 0, sizeof( texels ) );
+				DecodeBC4Block( InData, 0, texels );
+				DecodeBC4Block( InData + 8, 1, texels );
+				for ( uint32 index = 0; index < 16; ++index )
+				{
+					texels[ index * 4 + 3 ] = 255;
+				}
+				break;
+
+			case PF_BC7:
+				DecodeBC7Block( InData, texels );
+				break;
+
+			default:
+				checkMsg( false, TEXT( "Unsupported pixel format %s for decompress" ), GPixelFormats[ InPixelFormat ].name );
+				return;
+			}
+
+			// Store texels inside of mip
+			for ( uint32 y = 0; y < 4 && blockY * 4 + y < InSizeY; ++y )
+			{
+				for ( uint32 x = 0; x < 4 && blockX * 4 + x < InSizeX; ++x )
+				{
+					memcpy( OutData + ( ( blockY * 4 + y ) * InSizeX + blockX * 4 + x ) * 4, texels + ( y * 4 + x ) * 4, 4 );
+				}
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -13,6 +13,18 @@ static const achar* GAxisUpNames[] =
 };
 static_assert( ARRAY_COUNT( GAxisUpNames ) == CStaticMeshImportSettingsDialog::AU_Num, "Need full init GAxisUpNames array" );
 
+/** Table names of texture compression settings */
+static const achar* GTextureCompressionNames[] =
+{
+	"None",					// TC_None
+	"Default (BC1/BC3)",	// TC_Default
+	"BC1",					// TC_BC1
+	"BC3",					// TC_BC3
+	"BC5 (Normal Map)",		// TC_BC5
+	"BC7"					// TC_BC7
+};
+static_assert( ARRAY_COUNT( GTextureCompressionNames ) == TC_Max, "Need full init GTextureCompressionNames array" );
+
 CStaticMeshImportSettingsDialog::CStaticMeshImportSettingsDialog()
 	: CImGUIPopup( TEXT( "Static Mesh Import Settings" ) )
 {
@@ -86,6 +98,72 @@ void CStaticMeshImportSettingsDialog::OnTick()
 		bNeedClose = true;
 	}
 
+	if ( bNeedClose )
+	{
+		Close();
+	}
+}
+
+CTexture2DImportSettingsDialog::CTexture2DImportSettingsDialog()
+	: CImGUIPopup( TEXT( "Texture Import Settings" ) )
+{
+	SetSize( Vector2D( 125.f, 700.f ) );
+}
+
+void CTexture2DImportSettingsDialog::OnTick()
+{
+	// Texture section
+	if ( ImGui::CollapsingHeader( "Texture", ImGuiTreeNodeFlags_DefaultOpen ) )
+	{
+		ImGui::Columns( 2, 0, false );
+
+		// Compression
+		{
+			ImGui::Text( "Compression:" );
+			if ( ImGui::IsItemHovered( ImGuiHoveredFlags_AllowWhenDisabled ) )
+			{
+				ImGui::SetTooltip( "Block compression of texture. Default selects BC1 for opaque textures and BC3 for textures with alpha" );
+			}
+
+			ImGui::NextColumn();
+			int32	compression = importSettings.compression;
+			if ( ImGui::Combo( "##Compression", &compression, GTextureCompressionNames, ARRAY_COUNT( GTextureCompressionNames ) ) )
+			{
+				importSettings.compression = ( ETextureCompression )compression;
+			}
+		}
+		ImGui::EndColumns();
+	}
+
+	// Draw buttons
+	ImGui::NewLine();
+	ImGui::Separator();
+
+	// Import asset
+	bool				bNeedClose = false;
+	const ImVec2		buttonSize( 120.f, 0.f );
+	if ( ImGui::Button( "Import", buttonSize ) )
+	{
+		onResume.Broadcast( CAssetFactory::RSIS_Import, importSettings );
+		bNeedClose = true;
+	}
+
+	// Import all assets
+	ImGui::SameLine();
+	if ( ImGui::Button( "Import All", buttonSize ) )
+	{
+		onResume.Broadcast( CAssetFactory::RSIS_ImportAll, importSettings );
+		bNeedClose = true;
+	}
+
+	// Cancel
+	ImGui::SameLine();
+	if ( ImGui::Button( "Cancel", buttonSize ) )
+	{
+		onResume.Broadcast( CAssetFactory::RSIS_Cancel, importSettings );
+		bNeedClose = true;
+	}
+
 	if ( bNeedClose )
 	{
 		Close();
@@ -274,20 +274,11 @@ void CLevelViewportWindow::ProcessEvent( struct SWindowEvent& InWindowEvent )
 		{
 			// If pressed left mouse button, we try select actor in world
 		case SWindowEvent::T_MouseReleased:
-#if ENABLE_HITPROXY
 			if ( !bGuizmoUsing && InWindowEvent.events.mouseButton.code == BC_MouseLeft )
 			{
-				// Update hit proxies id in all actors
-				GWorld->UpdateHitProxiesId();
-
-				// Render hit proxies to render target
-				viewportClient.DrawHitProxies( const_cast< CViewport* >( &viewportWidget.GetViewport() ) );
-
-				// Wait until we rendering scene
-				FlushRenderingCommands();
-
+				// Pick actor by ray cast on CPU, it doesn't wait rendering thread
 				Vector2D		cursorPosition( ImGui::GetMousePos().x - viewportScreenPos.x, ImGui::GetMousePos().y - viewportScreenPos.y );
-				CHitProxyId		hitProxyId = viewportClient.GetHitProxyId( cursorPosition.x, cursorPosition.y );
+				ActorRef_t		actor = viewportClient.PickActor( cursorPosition, viewportWidget.GetSize().x, viewportWidget.GetSize().y );
 				bool			bControlDown = GInputSystem->IsKeyDown( BC_KeyLControl ) || GInputSystem->IsKeyDown( BC_KeyRControl );
 
 				if ( !bControlDown )
@@ -295,11 +286,8 @@ void CLevelViewportWindow::ProcessEvent( struct SWindowEvent& InWindowEvent )
 					GWorld->UnselectAllActors();
 				}
 
-				if ( hitProxyId.IsValid() )
+				if ( actor )
 				{
-					uint32			index = hitProxyId.GetIndex();
-					ActorRef_t		actor = GWorld->GetActor( index > 0 ? index - 1 : index );
-
 					if ( bControlDown && actor->IsSelected() )
 					{
 						GWorld->UnselectActor( actor );
@@ -312,7 +300,6 @@ void CLevelViewportWindow::ProcessEvent( struct SWindowEvent& InWindowEvent )
 					}
 				}
 			}
-#endif // ENABLE_HITPROXY
 			break;
 
 			// If pressed 'Escape' we unselect all actors
@@ -121,6 +121,13 @@ void CMaterialEditorWindow::OnTick()
 		{
 			material->SetWireframe( bIsWireframe );
 		}
+
+		// Is masked
+		bool bIsMasked			= material->IsMasked();
+		if ( ImGui::Checkbox( "Is Masked", &bIsMasked ) )
+		{
+			material->SetMasked( bIsMasked );
+		}
 	}
 
 	// Usage
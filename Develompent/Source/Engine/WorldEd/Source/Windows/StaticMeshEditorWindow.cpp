@@ -15,6 +15,15 @@ static const tchar* GStaticMeshEditorIconPaths[] =
 };
 static_assert( ARRAY_COUNT( GStaticMeshEditorIconPaths ) == CStaticMeshEditorWindow::IT_Num, "Need full init GStaticMeshEditorIconPaths array" );
 
+/** Table names of static mesh vertex formats */
+static const achar*		GStaticMeshVertexFormatNames[] =
+{
+	"Float (72 bytes)",			// SMVF_Float
+	"Packed (24 bytes)",		// SMVF_Packed
+	"Packed Half (20 bytes)"	// SMVF_PackedHalf
+};
+static_assert( ARRAY_COUNT( GStaticMeshVertexFormatNames ) == SMVF_Max, "Need full init GStaticMeshVertexFormatNames array" );
+
 /** Macro size button in menu bar */
 #define  STATICMESHEDITOR_MENUBAR_BUTTONSIZE	ImVec2( 16.f, 16.f )
 
@@ -112,6 +121,8 @@ void CStaticMeshEditorWindow::UpdateAssetInfo()
 
 		selectAssetHandle.asset = materialRef;
 	}
+
+	vertexPrecision = staticMesh->CalcVertexPrecision();
 }
 
 void CStaticMeshEditorWindow::OnTick()
@@ -156,13 +167,81 @@ void CStaticMeshEditorWindow::OnTick()
 		// Draw texture format
 		ImGui::Text( "Triangles:" );
 		ImGui::TableNextColumn();
-		ImGui::Text( std::to_string( staticMesh->GetIndeces().Num() / 3 ).c_str() );
+		ImGui::Text( std::to_string( staticMesh->GetNumPrimitives() ).c_str() );
+		ImGui::TableNextColumn();
+
+		// LODs
+		ImGui::Text( "LODs:" );
+		ImGui::TableNextColumn();
+		{
+			std::wstring		lodInfo = CString::Format( TEXT( "%i" ), staticMesh->GetNumLODs() );
+			for ( uint32 index = 1, count = staticMesh->GetNumLODs(); index < count; ++index )
+			{
+				lodInfo += CString::Format( index > 1 ? TEXT( ", %i" ) : TEXT( " (%i" ), staticMesh->GetNumPrimitives( index ) );
+			}
+
+			if ( staticMesh->GetNumLODs() > 1 )
+			{
+				lodInfo += TEXT( " triangles)" );
+			}
+			ImGui::Text( TCHAR_TO_ANSI( lodInfo.c_str() ) );
+		}
+		ImGui::TableNextColumn();
+
+		// Index format
+		ImGui::Text( "Index Format:" );
+		ImGui::TableNextColumn();
+		ImGui::Text( staticMesh->GetIndexStride() == sizeof( uint16 ) ? "16 bit" : "32 bit" );
+		ImGui::TableNextColumn();
+
+		// Occluder
+		ImGui::Text( "Occluder:" );
+		ImGui::TableNextColumn();
+		{
+			bool	bOccluder = staticMesh->IsOccluder();
+			if ( ImGui::Checkbox( "##CheckboxOccluder", &bOccluder ) )
+			{
+				staticMesh->SetOccluder( bOccluder );
+			}
+			if ( ImGui::IsItemHovered() )
+			{
+				ImGui::SetTooltip( "Mesh hides other primitives in software occlusion culling, it is rasterized by the coarsest LOD" );
+			}
+		}
 		ImGui::TableNextColumn();
 
 		// Resource size
 		ImGui::Text( "Resource Size:" );
 		ImGui::TableNextColumn();
-		ImGui::Text( TCHAR_TO_ANSI( CString::Format( TEXT( "%.2f Kb" ), ( staticMesh->GetVerteces().Num() * sizeof( SStaticMeshVertexType ) + staticMesh->GetIndeces().Num() * sizeof( uint32 ) ) / 1024.f ).c_str() ) );
+		ImGui::Text( TCHAR_TO_ANSI( CString::Format( TEXT( "%.2f Kb" ), ( staticMesh->GetVerteces().Num() * GetStaticMeshVertexStride( staticMesh->GetVertexFormat() ) + staticMesh->GetNumIndeces() * staticMesh->GetIndexStride() ) / 1024.f ).c_str() ) );
+		ImGui::TableNextColumn();
+
+		// Vertex format
+		ImGui::Text( "Vertex Format:" );
+		ImGui::TableNextColumn();
+
+		int32	vertexFormat = staticMesh->GetVertexFormat();
+		if ( ImGui::Combo( "##ComboVertexFormat", &vertexFormat, GStaticMeshVertexFormatNames, ARRAY_COUNT( GStaticMeshVertexFormatNames ) ) )
+		{
+			staticMesh->SetVertexFormat( ( EStaticMeshVertexFormat )vertexFormat );
+			vertexPrecision = staticMesh->CalcVertexPrecision();
+		}
+		ImGui::TableNextColumn();
+
+		// Precision loss of vertex format
+		ImGui::Text( "Max Position Error:" );
+		ImGui::TableNextColumn();
+		ImGui::Text( TCHAR_TO_ANSI( CString::Format( TEXT( "%f" ), vertexPrecision.maxPositionError ).c_str() ) );
+		ImGui::TableNextColumn();
+
+		ImGui::Text( "Max Normal Error:" );
+		ImGui::TableNextColumn();
+		ImGui::Text( TCHAR_TO_ANSI( CString::Format( TEXT( "%.3f deg (tangent %.3f deg)" ), vertexPrecision.maxNormalError, vertexPrecision.maxTangentError ).c_str() ) );
+		ImGui::TableNextColumn();
+
+		ImGui::Text( "Max UV Error:" );
+		ImGui::TableNextColumn();
+		ImGui::Text( TCHAR_TO_ANSI( CString::Format( TEXT( "%f" ), vertexPrecision.maxTexCoordError ).c_str() ) );
 		ImGui::EndTable();
 	}
 
@@ -4,6 +4,7 @@
 #include "Misc/UIGlobals.h"
 #include "Windows/TextureEditorWindow.h"
 #include "Render/TexturePreviewViewportClient.h"
+#include "Render/TextureMips.h"
 #include "Windows/FileDialog.h"
 #include "System/AssetsImport.h"
 #include "Windows/DialogWindow.h"
@@ -30,6 +31,18 @@ static const achar*		GSamplerFilterNames[] =
 };
 static_assert( ARRAY_COUNT( GSamplerFilterNames ) == SF_Max, "Need full init GSamplerFilterNames array" );
 
+/** Table names of texture compression settings */
+static const achar*		GTextureCompressionNames[] =
+{
+	"None",					// TC_None
+	"Default (BC1/BC3)",	// TC_Default
+	"BC1",					// TC_BC1
+	"BC3",					// TC_BC3
+	"BC5 (Normal Map)",		// TC_BC5
+	"BC7"					// TC_BC7
+};
+static_assert( ARRAY_COUNT( GTextureCompressionNames ) == TC_Max, "Need full init GTextureCompressionNames array" );
+
 /** Table pathes to icons */
 static const tchar*		GTextureEditorIconPaths[] =
 {
@@ -248,10 +261,32 @@ void CTextureEditorWindow::OnTick()
 		ImGui::Text( TCHAR_TO_ANSI( pixelFormatInfo.name ) );
 		ImGui::TableNextColumn();
 
+		// Compression, texture is reimported with new settings
+		ImGui::Text( "Compression:" );
+		ImGui::TableNextColumn();
+
+		int32	compression = texture2D->GetCompression();
+		if ( ImGui::Combo( "##ComboCompression", &compression, GTextureCompressionNames, ARRAY_COUNT( GTextureCompressionNames ) ) )
+		{
+			std::wstring		errorMsg;
+			texture2D->SetCompression( ( ETextureCompression )compression );
+			if ( !GAssetFactory.Reimport( texture2D, errorMsg ) )
+			{
+				OpenPopup<CDialogWindow>( TEXT( "Error" ), CString::Format( TEXT( "The texture 2D not reimported.\n\nMessage: %s" ), errorMsg.c_str() ), CDialogWindow::BT_Ok );
+			}
+		}
+		ImGui::TableNextColumn();
+
+		// Number of mips
+		ImGui::Text( "Mips:" );
+		ImGui::TableNextColumn();
+		ImGui::Text( TCHAR_TO_ANSI( CString::Format( TEXT( "%i" ), texture2D->GetNumMips() ).c_str() ) );
+		ImGui::TableNextColumn();
+
 		// Resource size
 		ImGui::Text( "Resource Size:" );
 		ImGui::TableNextColumn();
-		ImGui::Text( TCHAR_TO_ANSI( CString::Format( TEXT( "%.2f Kb" ), ( pixelFormatInfo.blockBytes * sizeX * sizeY ) / 1024.f ).c_str() ) );
+		ImGui::Text( TCHAR_TO_ANSI( CString::Format( TEXT( "%.2f Kb" ), CalcMipChainSize( texture2D->GetPixelFormat(), sizeX, sizeY, texture2D->GetNumMips() ) / 1024.f ).c_str() ) );
 		ImGui::EndTable();
 	}
 
@@ -0,0 +1,15 @@
+/**
+ * DepthOnlyShaders.hlsl: Vertex shader code for depth only render.
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#include "Common.hlsl"
+#include "VertexFactory.hlsl"
+
+// Position is calculated by the same expression as in base pass, so base pass gets the same depth
+void MainVS( in FVertexFactoryInput In, out float4 OutPosition : SV_POSITION )
+{
+	OutPosition		= MulMatrix( viewProjectionMatrix, VertexFactory_GetWorldPosition( In ) );
+}
\ No newline at end of file
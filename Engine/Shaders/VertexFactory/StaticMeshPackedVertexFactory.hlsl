@@ -0,0 +1,66 @@
+#ifndef VERTEXFACTORY_H
+#define VERTEXFACTORY_H 0
+
+#include "Common.hlsl"
+#include "VertexFactory/VertexFactoryCommon.hlsl"
+
+struct FVertexFactoryInput
+{
+	float4 		position		: POSITION;		// W is filled by 1 for float3 position
+#if !POSITION_ONLY
+	float2 		texCoord0		: TEXCOORD0;
+	float4		normal			: NORMAL0;		// 10:10:10:2 UNORM, unpacked in VertexFactory_GetLocalNormal
+	float4		tangent			: TANGENT0;		// 10:10:10:2 UNORM, W is sign of binormal
+#endif // !POSITION_ONLY
+};
+
+float4 VertexFactory_GetLocalPosition( FVertexFactoryInput InInput )
+{
+	return InInput.position;
+}
+
+// Depth only shaders get position only vertex declaration of main stream
+#if !POSITION_ONLY
+float4 VertexFactory_GetLocalNormal( FVertexFactoryInput InInput )
+{
+	return float4( InInput.normal.xyz * 2.f - 1.f, 0.f );
+}
+#endif // !POSITION_ONLY
+
+float4 VertexFactory_GetWorldPosition( FVertexFactoryInput InInput )
+{
+	return MulMatrix( localToWorldMatrix, VertexFactory_GetLocalPosition( InInput ) );
+}
+
+#if !POSITION_ONLY
+float4 VertexFactory_GetWorldNormal( FVertexFactoryInput InInput )
+{
+	return MulMatrix( localToWorldMatrix, VertexFactory_GetLocalNormal( InInput ) );
+}
+
+float2 VertexFactory_GetTexCoord( FVertexFactoryInput InInput, uint InTexCoordIndex )
+{
+	return float2( InInput.texCoord0.x, -InInput.texCoord0.y );
+}
+
+float4 VertexFactory_GetColor( FVertexFactoryInput InInput, uint InColorIndex )
+{
+	return float4( 1.f, 1.f, 1.f, 1.f );
+}
+#endif // !POSITION_ONLY
+
+#if ENABLE_HITPROXY
+float4 VertexFactory_GetHitProxyId( FVertexFactoryInput InInput )
+{
+	return hitProxyId;
+}
+#endif // ENABLE_HITPROXY
+
+#if WITH_EDITOR
+float4 VertexFactory_GetColorOverlay( FVertexFactoryInput InInput )
+{
+	return colorOverlay;
+}
+#endif // WITH_EDITOR
+
+#endif // !VERTEXFACTORY_H
\ No newline at end of file
@@ -7,10 +7,12 @@
 struct FVertexFactoryInput
 {
 	float4 		position		: POSITION;
+#if !POSITION_ONLY
 	float2 		texCoord0		: TEXCOORD0;
 	float4		normal			: NORMAL0;
 	float4		tangent			: TANGENT0;
 	float4		binormal		: BINORMAL0;
+#endif // !POSITION_ONLY
 };
 
 float4 VertexFactory_GetLocalPosition( FVertexFactoryInput InInput )
@@ -18,16 +20,20 @@ float4 VertexFactory_GetLocalPosition( FVertexFactoryInput InInput )
 	return InInput.position;
 }
 
+// Depth only shaders get position only vertex declaration of main stream
+#if !POSITION_ONLY
 float4 VertexFactory_GetLocalNormal( FVertexFactoryInput InInput )
 {
 	return InInput.normal;
 }
+#endif // !POSITION_ONLY
 
 float4 VertexFactory_GetWorldPosition( FVertexFactoryInput InInput )
 {
 	return MulMatrix( localToWorldMatrix, VertexFactory_GetLocalPosition( InInput ) );
 }
 
+#if !POSITION_ONLY
 float4 VertexFactory_GetWorldNormal( FVertexFactoryInput InInput )
 {
 	return MulMatrix( localToWorldMatrix, VertexFactory_GetLocalNormal( InInput ) );
@@ -42,6 +48,7 @@ float4 VertexFactory_GetColor( FVertexFactoryInput InInput, uint InColorIndex )
 {
 	return float4( 1.f, 1.f, 1.f, 1.f );
 }
+#endif // !POSITION_ONLY
 
 #if ENABLE_HITPROXY
 float4 VertexFactory_GetHitProxyId( FVertexFactoryInput InInput )